@@ -0,0 +1,118 @@
+/**
+ * @file archivo_memoria.c
+ * @brief Implementación del acceso a archivos en memoria con `mmap` (o `fread` en Windows) y de la escritura durable.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#define _POSIX_C_SOURCE 200809L // mmap, posix_madvise y fsync con -std=c99
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "archivo_memoria.h"
+
+/**
+ * @brief Abre un archivo y lo deja accesible en memoria.
+ * @param nombreArchivo Nombre del archivo.
+ * @param archivo Resultado.
+ * @return `true` si el archivo quedó accesible, `false` en caso contrario.
+ */
+bool abrirArchivoEnMemoria(const char *nombreArchivo, ArchivoEnMemoria *archivo) {
+    archivo->datos = NULL;
+    archivo->tamano = 0;
+#ifdef _WIN32
+    FILE *f = fopen(nombreArchivo, "rb");
+    if (!f) return false;
+    long tamano = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    unsigned char *datos = tamano > 0 ? (unsigned char *)malloc((size_t)tamano) : NULL;
+    bool correcto = datos && fseek(f, 0, SEEK_SET) == 0 && fread(datos, 1, (size_t)tamano, f) == (size_t)tamano;
+    fclose(f);
+    if (!correcto) {
+        free(datos);
+        return false;
+    }
+    archivo->datos = datos;
+    archivo->tamano = (size_t)tamano;
+    return true;
+#else
+    int fd = open(nombreArchivo, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // El mapeo sigue siendo válido después de cerrar el descriptor
+    if (mapa == MAP_FAILED) return false;
+    posix_madvise(mapa, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+    archivo->datos = (const unsigned char *)mapa;
+    archivo->tamano = (size_t)info.st_size;
+    return true;
+#endif
+}
+
+/**
+ * @brief Libera el bloque de memoria de un archivo abierto con `abrirArchivoEnMemoria`.
+ * @param archivo Archivo a cerrar.
+ */
+void cerrarArchivoEnMemoria(ArchivoEnMemoria *archivo) {
+#ifdef _WIN32
+    free((void *)archivo->datos);
+#else
+    if (archivo->datos) munmap((void *)archivo->datos, archivo->tamano);
+#endif
+    archivo->datos = NULL;
+    archivo->tamano = 0;
+}
+
+/**
+ * @brief Vacía el buffer de `stdio` y espera a que el contenido del archivo llegue al disco.
+ * @param archivo Archivo abierto para escritura.
+ * @return `true` si los datos quedaron en disco, `false` en caso contrario.
+ */
+bool sincronizarArchivo(FILE *archivo) {
+    if (fflush(archivo) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(archivo)) == 0;
+#else
+    return fsync(fileno(archivo)) == 0;
+#endif
+}
+
+/**
+ * @brief Renombra `origen` sobre `destino`, reemplazándolo, y sincroniza el directorio.
+ * @param origen Archivo ya escrito y sincronizado.
+ * @param destino Archivo a reemplazar.
+ * @return `true` si el reemplazo quedó en disco, `false` en caso contrario.
+ */
+bool reemplazarArchivo(const char *origen, const char *destino) {
+#ifdef _WIN32
+    return MoveFileExA(origen, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(origen, destino) != 0) return false;
+
+    // El nombre nuevo solo es durable cuando se sincroniza el directorio que lo contiene
+    char directorio[512] = ".";
+    const char *barra = strrchr(destino, '/');
+    if (barra) {
+        size_t longitud = barra == destino ? 1 : (size_t)(barra - destino);
+        if (longitud >= sizeof(directorio)) return false;
+        memcpy(directorio, destino, longitud);
+        directorio[longitud] = '\0';
+    }
+    int fd = open(directorio, O_RDONLY);
+    if (fd < 0) return false;
+    bool correcto = fsync(fd) == 0;
+    close(fd);
+    return correcto;
+#endif
+}
@@ -0,0 +1,64 @@
+/**
+ * @file archivo_memoria.h
+ * @brief Acceso de solo lectura a un archivo completo como un bloque de memoria.
+ *
+ * Lo usan los cargadores (snapshot binario y YAML) para recorrer el archivo con
+ * punteros en lugar de leerlo por partes con `fread` o `fgets`. También incluye las
+ * dos operaciones que necesita la escritura durable de la bitácora y los snapshots:
+ * forzar los datos al disco y reemplazar un archivo por otro de forma atómica.
+ */
+
+#ifndef ARCHIVO_MEMORIA_H
+#define ARCHIVO_MEMORIA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Contenido de un archivo accesible como un bloque de memoria de solo lectura.
+ */
+typedef struct {
+    const unsigned char *datos; ///< Inicio del contenido.
+    size_t tamano;              ///< Tamaño del contenido en bytes.
+} ArchivoEnMemoria;
+
+/**
+ * @brief Abre un archivo y lo deja accesible en memoria.
+ *
+ * En sistemas POSIX el archivo se mapea con `mmap` (las páginas se leen bajo demanda);
+ * en Windows se lee completo a un bloque reservado con `malloc`. Un archivo vacío
+ * se considera un error.
+ *
+ * @param nombreArchivo Nombre del archivo.
+ * @param archivo Resultado.
+ * @return `true` si el archivo quedó accesible, `false` en caso contrario.
+ */
+bool abrirArchivoEnMemoria(const char *nombreArchivo, ArchivoEnMemoria *archivo);
+
+/**
+ * @brief Libera el bloque de memoria de un archivo abierto con `abrirArchivoEnMemoria`.
+ * @param archivo Archivo a cerrar.
+ */
+void cerrarArchivoEnMemoria(ArchivoEnMemoria *archivo);
+
+/**
+ * @brief Vacía el buffer de `stdio` y espera a que el contenido del archivo llegue al disco.
+ * @param archivo Archivo abierto para escritura.
+ * @return `true` si los datos quedaron en disco, `false` en caso contrario.
+ */
+bool sincronizarArchivo(FILE *archivo);
+
+/**
+ * @brief Renombra `origen` sobre `destino`, reemplazándolo, y sincroniza el directorio.
+ *
+ * Si el programa se interrumpe, `destino` queda con el contenido anterior o con el
+ * nuevo completo, nunca a medias.
+ *
+ * @param origen Archivo ya escrito y sincronizado.
+ * @param destino Archivo a reemplazar.
+ * @return `true` si el reemplazo quedó en disco, `false` en caso contrario.
+ */
+bool reemplazarArchivo(const char *origen, const char *destino);
+
+#endif // ARCHIVO_MEMORIA_H
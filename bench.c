@@ -0,0 +1,2463 @@
+/**
+ * @file bench.c
+ * @brief Benchmarks del sistema de gestión de pedidos.
+ *
+ * Se compila como un ejecutable aparte (sin main.c). Uso:
+ *
+ *     bench serializacion [numPedidos]
+ *     bench snapshot [numPedidos]
+ *     bench deserializacion [numPedidos]
+ *     bench bitacora [numPedidos]
+ *     bench delta [numPedidos]
+ *     bench menus [numMenus]
+ *     bench fondo [numPedidos]
+ *     bench integridad [numPedidos]
+ *     bench importacion [numPedidos]
+ *     bench servidor [numPedidos] [conexiones] [profundidad]
+ *     bench tareas [numPedidos]
+ *     bench cocina [numPedidos] [microsPorMenu]
+ *     bench tablas [tamanoMaximo] [repeticiones] [archivo.csv]
+ *     bench comparar base.csv nuevo.csv
+ *     bench generacion [numPedidos]
+ *     bench totales [numPedidos]
+ *     bench reportes [numPedidos]
+ *     bench fechas [numFechas]
+ *     bench cadenas [numClientes]
+ *     bench indice [tamanoMaximo]
+ *
+ * La prueba de serialización llena las tablas con datos sintéticos y mide:
+ *  - el formateo con el escritor por buffer hacia un sumidero nulo (solo CPU),
+ *  - el mismo volumen formateado con `fprintf` campo por campo (referencia),
+ *  - la escritura cruda de esos bytes al disco (solo E/S),
+ *  - `serializarDatos` completo hacia un archivo real,
+ *  - el formateo paralelo con 1, 2, 4, ... hilos del pool hasta `omp_get_max_threads()`.
+ * Si el formateo es más rápido que la escritura cruda, guardar está limitado por E/S.
+ *
+ * La prueba de snapshot mide guardar y cargar el snapshot binario (el tiempo de
+ * reinicio) y comprueba que las tablas cargadas producen el mismo YAML.
+ *
+ * La prueba de deserialización mide la carga del YAML generado con el lector
+ * secuencial y con el lector por fragmentos con 2, 4, ... hilos, y hace la misma
+ * comprobación.
+ *
+ * La prueba de bitácora mide cuánto cuesta registrar los cambios con group commit
+ * frente a confirmar cada cambio por separado, y el tiempo de recuperación al iniciar.
+ *
+ * La prueba de snapshot incremental compara guardar todo contra guardar solo los
+ * pedidos que cambiaron (0.1 %, 1 % y 10 %), y comprueba que la base más sus deltas
+ * producen el mismo YAML.
+ *
+ * La prueba de menús compara el YAML completo (cada menú repite sus alimentos) con el
+ * normalizado (solo IDs) en menús de 50 alimentos: tamaño, tiempo de guardado y de carga.
+ *
+ * La prueba de guardado en segundo plano mide la pausa al iniciar el guardado, cuántas
+ * actualizaciones se atienden mientras se escribe y la memoria adicional que usa.
+ *
+ * La prueba de integridad mide la carga del snapshot (sin validar registro por
+ * registro) y la verificación de referencias posterior con 1, 2, 4, ... hilos, y
+ * comprueba que la verificación encuentra referencias rotas a propósito.
+ *
+ * La prueba de importación escribe los pedidos en CSV y en JSON Lines (más unas líneas
+ * inválidas), los importa a la tabla vacía y mide registros por segundo, los rechazos
+ * y que los pedidos importados producen el mismo YAML.
+ *
+ * La prueba del servidor lo inicia en un proceso hijo sobre un socket Unix y lo carga
+ * desde varias conexiones con 80 % de búsquedas de pedidos, 10 % de actualizaciones y
+ * 10 % de altas; mide peticiones por segundo y la latencia (p50, p99) sin pipelining
+ * (una petición en vuelo por conexión) y con `profundidad` peticiones en vuelo.
+ *
+ * La prueba del pool de tareas ordena pedidos con quicksortPedidosParallel con 1, 2,
+ * 4, ... hilos y mide cuánto cuesta lanzar y esperar una tarea vacía.
+ *
+ * La prueba de la cocina recibe pedidos nuevos desde dos hilos de recepción, que los
+ * agregan y los encolan, mientras 1, 2, 4, ... cocineros los pasan a "Completado"; mide
+ * pedidos por segundo, la espera en la cola y su profundidad máxima.
+ *
+ * La prueba de tablas mide cada operación de las cuatro tablas (insertar, buscar con
+ * acierto y con fallo, actualizar, contar, copiar, ordenar, búsqueda binaria y eliminar)
+ * con 1e3, 1e4, ... registros, varias repeticiones por tamaño, y escribe ns por operación
+ * con su desviación en un CSV. `comparar` contrasta ese CSV con el de otra corrida.
+ *
+ * La prueba de generación mide `generarDatos` con 1, 2, 4, ... hilos contra la inserción
+ * registro por registro, y comprueba con una huella que todos los hilos generan lo mismo.
+ *
+ * La prueba de totales calcula el total de cada pedido recorriendo sus menús y alimentos
+ * y lo compara con la caché de totales (ver totales_pedidos.h) en frío y con los totales
+ * guardados; después cambia el precio de algunos alimentos y mide cuántos pedidos se
+ * invalidan y cuánto cuesta recalcularlos, comprobando siempre el resultado.
+ *
+ * La prueba de reportes calcula los reportes de ventas (ver reportes_ventas.h) con 1, 2,
+ * 4, ... hilos, los compara con una pasada secuencial que busca cada menú y alimento en
+ * las tablas, y mide cuánto tarda guardarlos en CSV.
+ *
+ * La prueba de fechas mide leer y escribir "AAAA-MM-DD" con fechas.h contra `sscanf` y
+ * `snprintf`, y filtrar las fechas de un año comparando el texto contra comparar el
+ * número de día; comprueba que ambos caminos dan lo mismo.
+ *
+ * La prueba de cadenas compara la memoria de los clientes con nombres internados (ver
+ * cadenas_internadas.h) contra un arreglo fijo de 50 bytes, con nombres únicos y con
+ * nombres repetidos, y mide comparar nombres por Cadena contra `strcmp`. Después
+ * renombra a todos los clientes varias veces con nombres que nunca se repiten y
+ * comprueba que la arena deja de crecer después de la primera ronda.
+ *
+ * La prueba del índice compara el índice de IDs que guarda cada tabla (ver
+ * indice_busqueda.h) con rearmarlo en cada búsqueda y con la búsqueda binaria sobre el
+ * snapshot ordenado, con 1e6 a 1e7 claves.
+ */
+
+#ifdef __linux__
+#define _POSIX_C_SOURCE 200809L // fork y sockets con -std=c99
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+
+#include "hash_alimentos.h"
+#include "hash_menus.h"
+#include "hash_clientes.h"
+#include "hash_pedidos.h"
+#include "serializar_datos.h"
+#include "deserializar_datos.h"
+#include "snapshot_binario.h"
+#include "bitacora.h"
+#include "snapshot_delta.h"
+#include "guardado_segundo_plano.h"
+#include "integridad_referencial.h"
+#include "importacion.h"
+#include "servidor.h"
+#include "tareas.h"
+#include "cocina.h"
+#include "datos_aleatorios.h"
+#include "totales_pedidos.h"
+#include "reportes_ventas.h"
+#include "fechas.h"
+#include "cadenas_internadas.h"
+#include "contabilidad_memoria.h"
+#include "mensajes.h"
+
+#ifdef _WIN32
+#define SUMIDERO_NULO "NUL"
+#else
+#define SUMIDERO_NULO "/dev/null"
+#endif
+
+/// Archivo temporal que usan las pruebas de escritura a disco.
+#define ARCHIVO_BENCH "bench_salida.yaml"
+
+/// Snapshot binario temporal de la prueba de snapshot.
+#define SNAPSHOT_BENCH "bench_snapshot.bin"
+
+/// Nombre base de los archivos temporales de la prueba de bitácora.
+#define BITACORA_BENCH "bench_bitacora"
+
+/// Snapshot base temporal de la prueba de snapshot incremental.
+#define DELTA_BENCH "bench_delta.bin"
+
+/// Socket temporal de la prueba del servidor.
+#define SOCKET_BENCH "bench_servidor.sock"
+
+/**
+ * @brief Generador congruencial simple y determinista para los datos de prueba.
+ */
+static unsigned int semillaBench = 12345u;
+
+static unsigned int aleatorioBench(void) {
+    semillaBench = semillaBench * 1103515245u + 12345u;
+    return semillaBench >> 8;
+}
+
+/**
+ * @brief Llena las tablas con datos sintéticos de IDs consecutivos.
+ * @param numPedidos Número de pedidos; las demás tablas se escalan a partir de él.
+ */
+static void llenarTablas(HashTable *alimentos, ClientesHashTable *clientes, MenuHashTable *menus,
+                         PedidosHashTable *pedidos, int numPedidos) {
+    int numAlimentos = 1000;
+    int numClientes = numPedidos / 10 + 1;
+    int numMenus = numPedidos / 100 + 1;
+    char nombre[50], telefono[15];
+
+    for (int i = 1; i <= numAlimentos; i++) {
+        sprintf(nombre, "Alimento%d", i);
+        insertarAlimento(alimentos, i, nombre, (aleatorioBench() % 10000) / 100.0f, "Si");
+    }
+    for (int i = 1; i <= numClientes; i++) {
+        sprintf(nombre, "Cliente%d", i);
+        sprintf(telefono, "55%06u", aleatorioBench() % 1000000);
+        agregarCliente(clientes, i, nombre, telefono);
+    }
+    for (int i = 1; i <= numMenus; i++) {
+        int ids[3], n = (int)(aleatorioBench() % 3) + 1;
+        for (int j = 0; j < n; j++) ids[j] = (int)(aleatorioBench() % numAlimentos) + 1;
+        int mes = (int)(aleatorioBench() % 12) + 1, dia = (int)(aleatorioBench() % 28) + 1;
+        agregarMenu(menus, i, fechaDeCivil(2024, mes, dia), ids, n, alimentos);
+    }
+    static const char *estados[] = { "Pendiente", "En Proceso", "Completado" };
+    for (int i = 1; i <= numPedidos; i++) {
+        int ids[3], n = (int)(aleatorioBench() % 3) + 1;
+        for (int j = 0; j < n; j++) ids[j] = (int)(aleatorioBench() % numMenus) + 1;
+        int mes = (int)(aleatorioBench() % 12) + 1, dia = (int)(aleatorioBench() % 28) + 1;
+        agregarPedido(pedidos, menus, clientes, i, (int)(aleatorioBench() % numClientes) + 1,
+                      fechaDeCivil(2024, mes, dia), ids, n, estados[aleatorioBench() % 3]);
+    }
+}
+
+/**
+ * @brief Escribe los pedidos con `fprintf` campo por campo, como lo hacía la versión original.
+ * @param archivo Archivo destino.
+ * @param tabla Tabla de pedidos.
+ */
+static void guardarPedidosConFprintf(FILE *archivo, PedidosHashTable *tabla) {
+    char textoFecha[FECHA_TEXTO];
+    fprintf(archivo, "pedidos:\n");
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        Pedido *actual = tabla->directo[i];
+        if (!actual) continue;
+        fprintf(archivo, "  - id: %d\n", actual->idPedido);
+        fprintf(archivo, "    cliente_id: %d\n", actual->idCliente);
+        fprintf(archivo, "    fecha: \"%s\"\n", formatearFecha(actual->fecha, textoFecha));
+        fprintf(archivo, "    estado: \"%s\"\n", actual->estado);
+        fprintf(archivo, "    menus: [");
+        for (int j = 0; j < actual->numMenus; j++) {
+            fprintf(archivo, "%d", actual->menus[j]);
+            if (j < actual->numMenus - 1) fprintf(archivo, ", ");
+        }
+        fprintf(archivo, "]\n");
+    }
+}
+
+/**
+ * @brief Obtiene el tamaño en bytes de un archivo.
+ * @param nombre Ruta del archivo.
+ * @return Tamaño en bytes, o -1 si no se pudo abrir.
+ */
+static long long tamanoArchivo(const char *nombre) {
+    FILE *f = fopen(nombre, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long long tam = ftell(f);
+    fclose(f);
+    return tam;
+}
+
+/**
+ * @brief Escribe `bytes` bytes a disco en bloques de 1 MiB con `fwrite`.
+ * @param bytes Número de bytes a escribir.
+ * @return Segundos transcurridos.
+ */
+static double escribirCrudo(long long bytes) {
+    static char bloque[1 << 20];
+    memset(bloque, 'x', sizeof(bloque));
+    double inicio = omp_get_wtime();
+    FILE *f = fopen(ARCHIVO_BENCH, "wb");
+    if (!f) return 0.0;
+    while (bytes > 0) {
+        size_t n = bytes < (long long)sizeof(bloque) ? (size_t)bytes : sizeof(bloque);
+        fwrite(bloque, 1, n, f);
+        bytes -= (long long)n;
+    }
+    fclose(f);
+    return omp_get_wtime() - inicio;
+}
+
+/**
+ * @brief Benchmark de throughput de `serializarDatos`.
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchSerializacion(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+
+    double inicio = omp_get_wtime();
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    printf("Tablas llenas (%d pedidos) en %.2f s\n", numPedidos, omp_get_wtime() - inicio);
+
+    // Tamaño real del YAML para convertir tiempos en MB/s
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+    long long bytes = tamanoArchivo(ARCHIVO_BENCH);
+    double mb = bytes / (1024.0 * 1024.0);
+
+    inicio = omp_get_wtime();
+    serializarDatos(SUMIDERO_NULO, alimentos, clientes, menus, pedidos);
+    double tFormateo = omp_get_wtime() - inicio;
+
+    FILE *nulo = fopen(SUMIDERO_NULO, "w");
+    inicio = omp_get_wtime();
+    if (nulo) {
+        guardarPedidosConFprintf(nulo, pedidos);
+        fclose(nulo);
+    }
+    double tFprintf = omp_get_wtime() - inicio;
+
+    double tCrudo = escribirCrudo(bytes);
+
+    inicio = omp_get_wtime();
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+    double tCompleto = omp_get_wtime() - inicio;
+
+    printf("\n%-44s %10s %10s\n", "Prueba", "Segundos", "MB/s");
+    printf("%-44s %10.3f %10.1f\n", "Formateo con buffer (sumidero nulo)", tFormateo, mb / tFormateo);
+    printf("%-44s %10.3f %10s\n", "Pedidos con fprintf (sumidero nulo)", tFprintf, "-");
+    printf("%-44s %10.3f %10.1f\n", "Escritura cruda del mismo volumen", tCrudo, mb / tCrudo);
+    printf("%-44s %10.3f %10.1f\n", "serializarDatos a disco", tCompleto, mb / tCompleto);
+    printf("\nArchivo: %.1f MB. Formateo/E-S cruda: %.2fx (>1 significa limitado por E/S).\n",
+           mb, tCrudo / tFormateo);
+
+    // Escalamiento del formateo paralelo con el número de hilos
+    int maxHilos = omp_get_max_threads();
+    printf("\n%-10s %10s %10s %10s\n", "Hilos", "Segundos", "MB/s", "Speedup");
+    double tUnHilo = 0.0;
+    for (int hilos = 1; ; hilos *= 2) {
+        if (hilos > maxHilos) hilos = maxHilos;
+        iniciarPoolTareas(hilos);
+        inicio = omp_get_wtime();
+        serializarDatos(SUMIDERO_NULO, alimentos, clientes, menus, pedidos);
+        double t = omp_get_wtime() - inicio;
+        if (hilos == 1) tUnHilo = t;
+        printf("%-10d %10.3f %10.1f %9.2fx\n", hilos, t, mb / t, tUnHilo / t);
+        if (hilos == maxHilos) break;
+    }
+    iniciarPoolTareas(maxHilos);
+
+    remove(ARCHIVO_BENCH);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Compara el contenido de dos archivos.
+ * @return `true` si ambos existen y son idénticos.
+ */
+static bool archivosIguales(const char *nombreA, const char *nombreB) {
+    FILE *a = fopen(nombreA, "rb");
+    FILE *b = fopen(nombreB, "rb");
+    bool iguales = a && b;
+    static char bloqueA[1 << 16], bloqueB[1 << 16];
+    while (iguales) {
+        size_t leidosA = fread(bloqueA, 1, sizeof(bloqueA), a);
+        size_t leidosB = fread(bloqueB, 1, sizeof(bloqueB), b);
+        iguales = leidosA == leidosB && memcmp(bloqueA, bloqueB, leidosA) == 0;
+        if (leidosA == 0) break;
+    }
+    if (a) fclose(a);
+    if (b) fclose(b);
+    return iguales;
+}
+
+/**
+ * @brief Benchmark de guardado y carga del snapshot binario.
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchSnapshot(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+
+    double inicio = omp_get_wtime();
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    printf("Tablas llenas (%d pedidos) en %.2f s\n", numPedidos, omp_get_wtime() - inicio);
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+
+    inicio = omp_get_wtime();
+    bool guardado = guardarSnapshotBinario(SNAPSHOT_BENCH, alimentos, clientes, menus, pedidos);
+    double tGuardar = omp_get_wtime() - inicio;
+    double mb = tamanoArchivo(SNAPSHOT_BENCH) / (1024.0 * 1024.0);
+
+    // Cargar sobre tablas con datos: la carga debe reemplazarlos
+    inicio = omp_get_wtime();
+    bool cargado = guardado && cargarSnapshotBinario(SNAPSHOT_BENCH, alimentos, clientes, menus, pedidos);
+    double tCargar = omp_get_wtime() - inicio;
+
+    serializarDatos("bench_recargado.yaml", alimentos, clientes, menus, pedidos);
+    bool iguales = cargado && archivosIguales(ARCHIVO_BENCH, "bench_recargado.yaml");
+
+    printf("\n%-44s %10s %10s\n", "Prueba", "Segundos", "MB/s");
+    printf("%-44s %10.3f %10.1f\n", "Guardar snapshot binario", tGuardar, mb / tGuardar);
+    printf("%-44s %10.3f %10.1f\n", "Cargar snapshot binario (mmap)", tCargar, mb / tCargar);
+    printf("\nSnapshot: %.1f MB. YAML antes y después de cargar: %s\n", mb, iguales ? "idéntico" : "DIFERENTE");
+
+    remove(ARCHIVO_BENCH);
+    remove("bench_recargado.yaml");
+    remove(SNAPSHOT_BENCH);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Mide la carga del YAML generado por `serializarDatos` con 1, 2, 4, ... hilos.
+ *
+ * Con 1 hilo se usa el lector secuencial de una sola pasada; con más, la lectura
+ * por fragmentos en paralelo. Antes de cada carga se vacían las tablas para no
+ * tener dos copias de los datos en memoria, y después de cada una se comprueba
+ * que el YAML vuelve a generarse idéntico.
+ *
+ * El lector secuencial reserva un nodo a la vez con `malloc` y aquí reutiliza la
+ * memoria que se acaba de liberar; el lector por fragmentos pide un bloque nuevo
+ * y paga sus fallos de página, como ocurriría al arrancar el programa.
+ *
+ * Al final carga el BaseDeDatos.yaml del repositorio (con valores entre comillas, como
+ * `disponible: "Si"`) con los dos lectores, para que un cambio de formato que lo rechace
+ * no pase inadvertido.
+ *
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchDeserializacion(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+
+    double inicio = omp_get_wtime();
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    printf("Tablas llenas (%d pedidos) en %.2f s\n", numPedidos, omp_get_wtime() - inicio);
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+    double mb = tamanoArchivo(ARCHIVO_BENCH) / (1024.0 * 1024.0);
+    printf("YAML: %.1f MB\n", mb);
+
+    int maxHilos = omp_get_max_threads();
+    printf("\n%-10s %10s %10s %10s %10s\n", "Hilos", "Segundos", "MB/s", "Speedup", "Idéntico");
+    double tUnHilo = 0.0;
+    for (int hilos = 1; ; hilos *= 2) {
+        if (hilos > maxHilos) hilos = maxHilos;
+        vaciarTablaPedidos(pedidos);
+        vaciarTablaMenus(menus);
+        vaciarTablaClientes(clientes);
+        vaciarTablaAlimentos(alimentos);
+
+        inicio = omp_get_wtime();
+        bool cargado = deserializarDatosConHilos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos, hilos);
+        double t = omp_get_wtime() - inicio;
+        if (hilos == 1) tUnHilo = t;
+
+        serializarDatos("bench_recargado.yaml", alimentos, clientes, menus, pedidos);
+        bool iguales = cargado && archivosIguales(ARCHIVO_BENCH, "bench_recargado.yaml");
+        printf("%-10d %10.3f %10.1f %9.2fx %10s\n", hilos, t, mb / t, tUnHilo / t, iguales ? "si" : "NO");
+        if (hilos == maxHilos) break;
+    }
+
+    printf("\n%-10s %10s %10s %10s %10s\n", "Hilos", "Alimentos", "Clientes", "Menús", "Pedidos");
+    for (int hilos = 1; ; hilos = maxHilos) {
+        vaciarTablaPedidos(pedidos);
+        vaciarTablaMenus(menus);
+        vaciarTablaClientes(clientes);
+        vaciarTablaAlimentos(alimentos);
+        if (deserializarDatosConHilos("BaseDeDatos.yaml", alimentos, clientes, menus, pedidos, hilos)) {
+            printf("%-10d %10d %10d %10d %10d\n", hilos, obtenerNumeroDeAlimentos(alimentos),
+                   obtenerNumeroDeClientes(clientes), obtenerNumeroDeMenus(menus), obtenerNumeroDePedidos(pedidos));
+        } else {
+            printf("%-10d BaseDeDatos.yaml NO se pudo cargar\n", hilos);
+        }
+        if (hilos == maxHilos) break;
+    }
+
+    remove(ARCHIVO_BENCH);
+    remove("bench_recargado.yaml");
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Borra el snapshot y las bitácoras de la prueba de bitácora.
+ */
+static void borrarArchivosBitacora(void) {
+    remove(BITACORA_BENCH ".snap");
+    remove(BITACORA_BENCH ".bitacora");
+    remove(BITACORA_BENCH ".bitacora.anterior");
+}
+
+/**
+ * @brief Benchmark de la bitácora: costo de registrar cambios y tiempo de recuperación.
+ *
+ * Llena las tablas sin bitácora (referencia) y con bitácora confirmando solo al final,
+ * de modo que el escritor junta los cambios en lotes con un `fsync` cada uno. Después
+ * actualiza pedidos confirmando cada cambio (un `fsync` por cambio). Al final cierra
+ * la bitácora, recupera los datos en tablas nuevas y comprueba que el YAML es idéntico.
+ *
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchBitacora(int numPedidos) {
+    long long numCambios = 1000 + (numPedidos / 10 + 1) + (numPedidos / 100 + 1) + (long long)numPedidos;
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+
+    double inicio = omp_get_wtime();
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    double tSinBitacora = omp_get_wtime() - inicio;
+    vaciarTablaPedidos(pedidos);
+    vaciarTablaMenus(menus);
+    vaciarTablaClientes(clientes);
+    vaciarTablaAlimentos(alimentos);
+
+    borrarArchivosBitacora();
+    semillaBench = 12345u;
+    if (!iniciarBitacora(BITACORA_BENCH, alimentos, clientes, menus, pedidos)) {
+        printf("No se pudo iniciar la bitácora.\n");
+        return;
+    }
+    inicio = omp_get_wtime();
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    bool confirmado = confirmarBitacora();
+    double tGrupo = omp_get_wtime() - inicio;
+
+    int numUnoPorUno = numPedidos < 2000 ? numPedidos : 2000;
+    inicio = omp_get_wtime();
+    for (int i = 1; i <= numUnoPorUno; i++) {
+        actualizarPedido(pedidos, i, "Completado");
+        confirmado = confirmarBitacora() && confirmado;
+    }
+    double tUnoPorUno = omp_get_wtime() - inicio;
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+    cerrarBitacora();
+
+    HashTable *alimentosRec = crearTablaHash();
+    ClientesHashTable *clientesRec = crearTablaClientes();
+    MenuHashTable *menusRec = crearTablaMenus();
+    PedidosHashTable *pedidosRec = crearTablaPedidos();
+    inicio = omp_get_wtime();
+    bool recuperado = iniciarBitacora(BITACORA_BENCH, alimentosRec, clientesRec, menusRec, pedidosRec);
+    double tRecuperar = omp_get_wtime() - inicio;
+    cerrarBitacora();
+    serializarDatos("bench_recargado.yaml", alimentosRec, clientesRec, menusRec, pedidosRec);
+    bool iguales = confirmado && recuperado && archivosIguales(ARCHIVO_BENCH, "bench_recargado.yaml");
+
+    printf("\n%-52s %10s %12s\n", "Prueba", "Segundos", "Cambios/s");
+    printf("%-52s %10.3f %12.0f\n", "Llenar tablas sin bitácora (referencia)", tSinBitacora, numCambios / tSinBitacora);
+    printf("%-52s %10.3f %12.0f\n", "Llenar tablas con bitácora (group commit)", tGrupo, numCambios / tGrupo);
+    printf("%-52s %10.3f %12.0f\n", "Actualizar confirmando cada cambio", tUnoPorUno, numUnoPorUno / tUnoPorUno);
+    printf("%-52s %10.3f\n", "Recuperar (snapshot + bitácora)", tRecuperar);
+    printf("\nYAML antes y después de recuperar: %s\n", iguales ? "idéntico" : "DIFERENTE");
+
+    remove(ARCHIVO_BENCH);
+    remove("bench_recargado.yaml");
+    borrarArchivosBitacora();
+    liberarTablaPedidos(pedidosRec);
+    liberarTablaMenus(menusRec);
+    liberarTablaClientes(clientesRec);
+    liberarTabla(alimentosRec);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Borra la base y los deltas de la prueba de snapshot incremental.
+ */
+static void borrarArchivosDelta(void) {
+    char nombre[64];
+    remove(DELTA_BENCH);
+    for (int i = 1; i <= SNAPSHOT_DELTAS_POR_BASE; i++) {
+        snprintf(nombre, sizeof(nombre), "%s.delta.%d", DELTA_BENCH, i);
+        remove(nombre);
+    }
+}
+
+/**
+ * @brief Benchmark del snapshot incremental: guardado completo frente a guardar solo los cambios.
+ *
+ * Guarda la base, y después actualiza el 0.1 %, el 1 % y el 10 % de los pedidos (y
+ * elimina algunos) guardando un delta tras cada ronda. Como referencia mide un snapshot
+ * binario completo de las mismas tablas. Al final carga la base con sus deltas en
+ * tablas nuevas y comprueba que el YAML es idéntico.
+ *
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchDelta(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    borrarArchivosDelta();
+
+    double inicio = omp_get_wtime();
+    bool correcto = guardarSnapshotDelta(DELTA_BENCH, alimentos, clientes, menus, pedidos);
+    double tBase = omp_get_wtime() - inicio;
+    long long bytesBase = tamanoArchivo(DELTA_BENCH);
+
+    printf("\n%-44s %10s %10s %14s\n", "Prueba", "Cambios", "Segundos", "Bytes");
+    printf("%-44s %10d %10.3f %14lld\n", "Guardar base (todas las tablas)", numPedidos, tBase, bytesBase);
+
+    static const char *estados[] = { "Pendiente", "En Proceso", "Completado" };
+    static const double fracciones[] = { 0.001, 0.01, 0.1 };
+    for (int f = 0; f < 3; f++) {
+        int numCambios = (int)(numPedidos * fracciones[f]) + 1;
+        for (int i = 0; i < numCambios; i++) {
+            int id = (int)(aleatorioBench() % numPedidos) + 1;
+            if (i % 100 == 99) {
+                eliminarPedido(pedidos, id);
+            } else {
+                actualizarPedido(pedidos, id, estados[aleatorioBench() % 3]);
+            }
+        }
+        char nombreDelta[64], prueba[64];
+        snprintf(nombreDelta, sizeof(nombreDelta), "%s.delta.%d", DELTA_BENCH, f + 1);
+        snprintf(prueba, sizeof(prueba), "Guardar delta (%.1f %% de los pedidos)", fracciones[f] * 100);
+        inicio = omp_get_wtime();
+        correcto = guardarSnapshotDelta(DELTA_BENCH, alimentos, clientes, menus, pedidos) && correcto;
+        double tDelta = omp_get_wtime() - inicio;
+        printf("%-44s %10d %10.3f %14lld\n", prueba, numCambios, tDelta, tamanoArchivo(nombreDelta));
+    }
+
+    inicio = omp_get_wtime();
+    correcto = guardarSnapshotBinario(SNAPSHOT_BENCH, alimentos, clientes, menus, pedidos) && correcto;
+    double tCompleto = omp_get_wtime() - inicio;
+    printf("%-44s %10d %10.3f %14lld\n", "Snapshot binario completo (referencia)", pedidos->numPedidos, tCompleto,
+           tamanoArchivo(SNAPSHOT_BENCH));
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+
+    HashTable *alimentosRec = crearTablaHash();
+    ClientesHashTable *clientesRec = crearTablaClientes();
+    MenuHashTable *menusRec = crearTablaMenus();
+    PedidosHashTable *pedidosRec = crearTablaPedidos();
+    inicio = omp_get_wtime();
+    correcto = cargarSnapshotDelta(DELTA_BENCH, alimentosRec, clientesRec, menusRec, pedidosRec) && correcto;
+    double tCargar = omp_get_wtime() - inicio;
+    printf("%-44s %10s %10.3f\n", "Cargar base y 3 deltas", "", tCargar);
+    serializarDatos("bench_recargado.yaml", alimentosRec, clientesRec, menusRec, pedidosRec);
+    bool iguales = correcto && archivosIguales(ARCHIVO_BENCH, "bench_recargado.yaml");
+    printf("\nYAML antes y después de cargar la cadena: %s\n", iguales ? "idéntico" : "DIFERENTE");
+
+    remove(ARCHIVO_BENCH);
+    remove("bench_recargado.yaml");
+    remove(SNAPSHOT_BENCH);
+    borrarArchivosDelta();
+    liberarTablaPedidos(pedidosRec);
+    liberarTablaMenus(menusRec);
+    liberarTablaClientes(clientesRec);
+    liberarTabla(alimentosRec);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Benchmark del YAML normalizado frente al completo con menús grandes.
+ *
+ * Genera `numMenus` menús de 50 alimentos cada uno, guarda los dos formatos y los
+ * carga. El archivo normalizado cargado se vuelve a guardar en formato completo para
+ * comprobar que los datos son idénticos.
+ *
+ * @param numMenus Número de menús a generar.
+ */
+static void benchMenus(int numMenus) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    int numAlimentos = 1000;
+    char nombre[50];
+    semillaBench = 12345u;
+    for (int i = 1; i <= numAlimentos; i++) {
+        sprintf(nombre, "Alimento%d", i);
+        insertarAlimento(alimentos, i, nombre, (aleatorioBench() % 10000) / 100.0f, "Si");
+    }
+    for (int i = 1; i <= numMenus; i++) {
+        int ids[50];
+        for (int j = 0; j < 50; j++) ids[j] = (int)(aleatorioBench() % numAlimentos) + 1;
+        agregarMenu(menus, i, fechaDeCivil(2024, 6, 15), ids, 50, alimentos);
+    }
+
+    double inicio = omp_get_wtime();
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+    double tGuardarCompleto = omp_get_wtime() - inicio;
+    inicio = omp_get_wtime();
+    serializarDatosNormalizados("bench_normalizado.yaml", alimentos, clientes, menus, pedidos);
+    double tGuardarNormalizado = omp_get_wtime() - inicio;
+    long long bytesCompleto = tamanoArchivo(ARCHIVO_BENCH);
+    long long bytesNormalizado = tamanoArchivo("bench_normalizado.yaml");
+
+    HashTable *alimentosRec = crearTablaHash();
+    ClientesHashTable *clientesRec = crearTablaClientes();
+    MenuHashTable *menusRec = crearTablaMenus();
+    PedidosHashTable *pedidosRec = crearTablaPedidos();
+    inicio = omp_get_wtime();
+    bool correcto = deserializarDatos(ARCHIVO_BENCH, alimentosRec, clientesRec, menusRec, pedidosRec);
+    double tCargarCompleto = omp_get_wtime() - inicio;
+    inicio = omp_get_wtime();
+    correcto = deserializarDatos("bench_normalizado.yaml", alimentosRec, clientesRec, menusRec, pedidosRec) && correcto;
+    double tCargarNormalizado = omp_get_wtime() - inicio;
+    serializarDatos("bench_recargado.yaml", alimentosRec, clientesRec, menusRec, pedidosRec);
+    bool iguales = correcto && archivosIguales(ARCHIVO_BENCH, "bench_recargado.yaml");
+
+    printf("\n%d menús de 50 alimentos\n", numMenus);
+    printf("\n%-28s %14s %12s %12s\n", "Formato", "Bytes", "Guardar (s)", "Cargar (s)");
+    printf("%-28s %14lld %12.3f %12.3f\n", "YAML completo", bytesCompleto, tGuardarCompleto, tCargarCompleto);
+    printf("%-28s %14lld %12.3f %12.3f\n", "YAML normalizado", bytesNormalizado, tGuardarNormalizado, tCargarNormalizado);
+    printf("\nTamaño normalizado/completo: %.2f. Datos cargados del normalizado: %s\n",
+           (double)bytesNormalizado / bytesCompleto, iguales ? "idénticos" : "DIFERENTES");
+
+    remove(ARCHIVO_BENCH);
+    remove("bench_normalizado.yaml");
+    remove("bench_recargado.yaml");
+    liberarTablaPedidos(pedidosRec);
+    liberarTablaMenus(menusRec);
+    liberarTablaClientes(clientesRec);
+    liberarTabla(alimentosRec);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Benchmark del guardado en segundo plano frente al guardado en primer plano.
+ *
+ * Guarda en primer plano (la pausa es todo el guardado) y luego en segundo plano,
+ * actualizando pedidos sin parar hasta que termina. Como la vista se tomó antes de
+ * las actualizaciones, los dos archivos deben ser idénticos.
+ *
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchFondo(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+
+    double inicio = omp_get_wtime();
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+    double tPrimerPlano = omp_get_wtime() - inicio;
+
+    static const char *estados[] = { "Pendiente", "En Proceso", "Completado" };
+    ResultadoGuardado resultado;
+    long long actualizaciones = 0;
+    double pausa = 0.0;
+    inicio = omp_get_wtime();
+    bool iniciado = iniciarGuardadoSegundoPlano("bench_fondo.yaml", alimentos, clientes, menus, pedidos, &pausa);
+    while (iniciado && !revisarGuardadoSegundoPlano(false, &resultado)) {
+        for (int i = 0; i < 1000; i++) {
+            actualizarPedido(pedidos, (int)(aleatorioBench() % numPedidos) + 1, estados[aleatorioBench() % 3]);
+        }
+        actualizaciones += 1000;
+    }
+    double tSegundoPlano = omp_get_wtime() - inicio;
+    bool iguales = iniciado && resultado.correcto && archivosIguales(ARCHIVO_BENCH, "bench_fondo.yaml");
+
+    printf("\n%-44s %14s %14s\n", "Prueba", "Pausa (µs)", "Total (s)");
+    printf("%-44s %14.0f %14.3f\n", "Guardado en primer plano", tPrimerPlano * 1e6, tPrimerPlano);
+    printf("%-44s %14.0f %14.3f\n", "Guardado en segundo plano (fork)", pausa * 1e6, tSegundoPlano);
+    printf("\nActualizaciones atendidas durante el guardado: %lld (%.0f por segundo)\n", actualizaciones,
+           actualizaciones / tSegundoPlano);
+    printf("Memoria adicional del hijo: %.1f MB\n", iniciado ? resultado.memoriaAdicional / (1024.0 * 1024.0) : 0.0);
+    printf("Archivo del segundo plano igual al de primer plano: %s\n", iguales ? "sí" : "NO");
+
+    remove(ARCHIVO_BENCH);
+    remove("bench_fondo.yaml");
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Mide la carga masiva del snapshot y la verificación de integridad que la sigue.
+ *
+ * Después retira (sin cascada) algunos alimentos, clientes y menús referenciados para
+ * comprobar que la verificación los encuentra e imprime su reporte.
+ *
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchIntegridad(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    guardarSnapshotBinario(SNAPSHOT_BENCH, alimentos, clientes, menus, pedidos);
+
+    double inicio = omp_get_wtime();
+    bool cargado = cargarSnapshotBinario(SNAPSHOT_BENCH, alimentos, clientes, menus, pedidos);
+    printf("Carga del snapshot sin validar: %.3f s\n", omp_get_wtime() - inicio);
+
+    ReporteIntegridad reporte;
+    int maxHilos = omp_get_max_threads();
+    printf("\n%-10s %12s %12s %10s %12s\n", "Hilos", "Segundos", "Refs/s (M)", "Speedup", "Rotas");
+    double tUnHilo = 0.0;
+    for (int hilos = 1; cargado; hilos *= 2) {
+        if (hilos > maxHilos) hilos = maxHilos;
+        iniciarPoolTareas(hilos);
+        validarIntegridad(alimentos, clientes, menus, pedidos, &reporte);
+        if (hilos == 1) tUnHilo = reporte.segundos;
+        // Cada pedido referencia un cliente y sus menús; cada menú, sus alimentos
+        double referencias = 0.0;
+        for (int i = 1; i <= numPedidos; i++) referencias += 1 + buscarPedido(pedidos, i)->numMenus;
+        for (int i = 1; i <= numPedidos / 100 + 1; i++) referencias += buscarMenuPorID(menus, i)->numAlimentos;
+        printf("%-10d %12.4f %12.1f %9.2fx %12lld\n", hilos, reporte.segundos, referencias / reporte.segundos / 1e6,
+               tUnHilo / reporte.segundos,
+               reporte.alimentosFaltantes + reporte.clientesFaltantes + reporte.menusFaltantes);
+        if (hilos == maxHilos) break;
+    }
+    iniciarPoolTareas(maxHilos);
+
+    for (int i = 1; i <= 3; i++) retirarAlimento(alimentos, i);
+    for (int i = 1; i <= 10; i++) retirarCliente(clientes, i);
+    for (int i = 1; i <= 5; i++) retirarMenu(menus, i);
+    bool valido = validarIntegridad(alimentos, clientes, menus, pedidos, &reporte);
+    printf("\nDespués de retirar 3 alimentos, 10 clientes y 5 menús: %s\n",
+           valido ? "NO se encontraron referencias rotas" : "referencias rotas encontradas");
+    imprimirReporteIntegridad(&reporte);
+
+    remove(SNAPSHOT_BENCH);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Escribe los pedidos de la tabla en CSV o JSON Lines, más tres líneas que se deben rechazar.
+ * @param nombre Archivo destino.
+ * @param pedidos Tabla de pedidos con IDs consecutivos desde 1.
+ * @param numPedidos Número de pedidos.
+ * @param json `true` para JSON Lines, `false` para CSV con encabezado.
+ */
+static void escribirPedidosImportables(const char *nombre, PedidosHashTable *pedidos, int numPedidos, bool json) {
+    FILE *archivo = fopen(nombre, "w");
+    if (!archivo) return;
+    char textoFecha[FECHA_TEXTO];
+    if (!json) fprintf(archivo, "id,cliente_id,fecha,estado,menus\n");
+    for (int i = 1; i <= numPedidos; i++) {
+        Pedido *pedido = buscarPedido(pedidos, i);
+        if (json) {
+            fprintf(archivo, "{\"id\": %d, \"cliente_id\": %d, \"fecha\": \"%s\", \"estado\": \"%s\", \"menus\": [",
+                    pedido->idPedido, pedido->idCliente, formatearFecha(pedido->fecha, textoFecha), pedido->estado);
+        } else {
+            fprintf(archivo, "%d,%d,%s,%s,", pedido->idPedido, pedido->idCliente, formatearFecha(pedido->fecha, textoFecha),
+                    pedido->estado);
+        }
+        for (int j = 0; j < pedido->numMenus; j++) {
+            fprintf(archivo, j == 0 ? "%d" : (json ? ", %d" : ";%d"), pedido->menus[j]);
+        }
+        fprintf(archivo, json ? "]}\n" : "\n");
+    }
+    // Formato inválido, pedido duplicado y cliente inexistente
+    if (json) {
+        fprintf(archivo, "{\"id\": %d, \"cliente_id\": 1,\n", numPedidos + 1);
+        fprintf(archivo, "{\"id\": 1, \"cliente_id\": 1, \"fecha\": \"2024-01-01\", \"estado\": \"Pendiente\", \"menus\": [1]}\n");
+        fprintf(archivo, "{\"id\": %d, \"cliente_id\": %d, \"fecha\": \"2024-01-01\", \"estado\": \"Pendiente\", \"menus\": [1]}\n",
+                numPedidos + 2, numPedidos + 5);
+    } else {
+        fprintf(archivo, "%d,1,2024-01-01\n", numPedidos + 1);
+        fprintf(archivo, "1,1,2024-01-01,Pendiente,1\n");
+        fprintf(archivo, "%d,%d,2024-01-01,Pendiente,1\n", numPedidos + 2, numPedidos + 5);
+    }
+    fclose(archivo);
+}
+
+/**
+ * @brief Huella FNV-1a de un bloque de bytes, acumulada sobre `huella`.
+ */
+static unsigned long long acumularHuella(unsigned long long huella, const void *datos, size_t tamano) {
+    const unsigned char *bytes = (const unsigned char *)datos;
+    for (size_t i = 0; i < tamano; i++) {
+        huella = (huella ^ bytes[i]) * 1099511628211ULL;
+    }
+    return huella;
+}
+
+/**
+ * @brief Huella del contenido de las cuatro tablas, recorriendo los IDs 1..N de cada una.
+ *
+ * Solo toma los campos con datos (no los punteros ni el relleno de las cadenas), así que
+ * dos generaciones iguales dan la misma huella sin importar dónde quedaron los nodos.
+ */
+static unsigned long long huellaTablas(HashTable *alimentos, ClientesHashTable *clientes, MenuHashTable *menus,
+                                       PedidosHashTable *pedidos) {
+    unsigned long long huella = 14695981039346656037ULL;
+    for (int i = 1; i <= obtenerNumeroDeAlimentos(alimentos); i++) {
+        Alimento *a = buscarAlimento(alimentos, i);
+        huella = acumularHuella(huella, textoCadena(a->nombre), strlen(textoCadena(a->nombre)));
+        huella = acumularHuella(huella, &a->precio, sizeof(a->precio));
+        huella = acumularHuella(huella, &a->disponible, sizeof(a->disponible));
+    }
+    for (int i = 1; i <= obtenerNumeroDeClientes(clientes); i++) {
+        Cliente *c = buscarCliente(clientes, i);
+        huella = acumularHuella(huella, c->telefono, strlen(c->telefono));
+    }
+    for (int i = 1; i <= obtenerNumeroDeMenus(menus); i++) {
+        Menu *m = buscarMenuPorID(menus, i);
+        huella = acumularHuella(huella, &m->fecha, sizeof(m->fecha));
+        huella = acumularHuella(huella, m->alimentos, (size_t)m->numAlimentos * sizeof(int));
+    }
+    for (int i = 1; i <= obtenerNumeroDePedidos(pedidos); i++) {
+        Pedido *p = buscarPedido(pedidos, i);
+        huella = acumularHuella(huella, &p->idCliente, sizeof(p->idCliente));
+        huella = acumularHuella(huella, &p->fecha, sizeof(p->fecha));
+        huella = acumularHuella(huella, p->estado, strlen(p->estado));
+        huella = acumularHuella(huella, p->menus, (size_t)p->numMenus * sizeof(int));
+    }
+    return huella;
+}
+
+/**
+ * @brief Mide `generarDatos` con 1, 2, 4, ... hilos y comprueba que todos generan lo mismo.
+ *
+ * Como referencia, mide también llenarTablas, que agrega cada registro con las
+ * funciones de la tabla (validando sus referencias) en un solo hilo.
+ *
+ * @param numPedidos Número de pedidos a generar; las demás tablas se escalan como en llenarTablas.
+ */
+static void benchGeneracion(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    int numClientes = numPedidos / 10 + 1, numMenus = numPedidos / 100 + 1;
+
+    semillaBench = 12345u;
+    double inicio = omp_get_wtime();
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    double tInsercion = omp_get_wtime() - inicio;
+    printf("Inserción validada, registro por registro (referencia): %.3f s, %.2f M pedidos/s\n", tInsercion,
+           numPedidos / tInsercion / 1e6);
+
+    int maxHilos = omp_get_max_threads();
+    unsigned long long huellaUnHilo = 0;
+    bool iguales = true;
+    double tUnHilo = 0.0;
+    printf("\n%-10s %12s %14s %10s %20s\n", "Hilos", "Segundos", "Pedidos/s (M)", "Speedup", "Huella");
+    for (int hilos = 1; ; hilos *= 2) {
+        if (hilos > maxHilos) hilos = maxHilos;
+        iniciarPoolTareas(hilos);
+        inicio = omp_get_wtime();
+        bool generado = generarDatos(alimentos, menus, clientes, pedidos, 1000, numClientes, numMenus, numPedidos,
+                                     GENERACION_SEMILLA_POR_OMISION);
+        double segundos = omp_get_wtime() - inicio;
+        if (!generado) break;
+        unsigned long long huella = huellaTablas(alimentos, clientes, menus, pedidos);
+        if (hilos == 1) {
+            tUnHilo = segundos;
+            huellaUnHilo = huella;
+        }
+        iguales = iguales && huella == huellaUnHilo;
+        printf("%-10d %12.3f %14.2f %9.2fx %20llx\n", hilos, segundos, numPedidos / segundos / 1e6,
+               tUnHilo / segundos, huella);
+        if (hilos == maxHilos) break;
+    }
+    iniciarPoolTareas(maxHilos);
+    printf("\nDatos idénticos con todos los números de hilos: %s\n", iguales ? "Sí" : "NO");
+
+    generarDatos(alimentos, menus, clientes, pedidos, 1000, numClientes, numMenus, numPedidos,
+                 GENERACION_SEMILLA_POR_OMISION + 1);
+    printf("Con otra semilla la huella cambia: %s\n",
+           huellaTablas(alimentos, clientes, menus, pedidos) != huellaUnHilo ? "Sí" : "NO");
+
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Suma los precios de los alimentos de los menús de un pedido, sin caché.
+ */
+static double totalPedidoDirecto(HashTable *alimentos, MenuHashTable *menus, const Pedido *pedido) {
+    double total = 0.0;
+    for (int i = 0; i < pedido->numMenus; i++) {
+        Menu *menu = buscarMenuPorID(menus, pedido->menus[i]);
+        double totalMenu = 0.0;
+        for (int j = 0; menu && j < menu->numAlimentos; j++) {
+            Alimento *alimento = buscarAlimento(alimentos, menu->alimentos[j]);
+            if (alimento) totalMenu += alimento->precio;
+        }
+        total += totalMenu;
+    }
+    return total;
+}
+
+/**
+ * @brief Calcula el total de todos los pedidos con la caché y cuenta los que no coinciden con el cálculo directo.
+ * @return Segundos que tomó la pasada (sin contar la comprobación).
+ */
+static double pasadaTotales(HashTable *alimentos, MenuHashTable *menus, PedidosHashTable *pedidos, int numPedidos,
+                            double *totales, long long *distintos) {
+    double inicio = omp_get_wtime();
+    for (int i = 1; i <= numPedidos; i++) calcularTotalPedido(i, &totales[i]);
+    double segundos = omp_get_wtime() - inicio;
+    for (int i = 1; i <= numPedidos; i++) {
+        if (totales[i] != totalPedidoDirecto(alimentos, menus, buscarPedido(pedidos, i))) (*distintos)++;
+    }
+    return segundos;
+}
+
+/**
+ * @brief Compara el total de cada pedido calculado sin caché, con la caché en frío y con los totales guardados.
+ *
+ * Después cambia el precio de 1, 10 y 100 alimentos y recalcula todos los pedidos: solo
+ * los que incluyen esos alimentos se recorren de nuevo.
+ *
+ * @param numPedidos Número de pedidos; las demás tablas se escalan como en llenarTablas.
+ */
+static void benchTotales(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    usarTablasTotales(alimentos, menus, pedidos);
+    double *totales = (double *)malloc(((size_t)numPedidos + 1) * sizeof(double));
+
+    double inicio = omp_get_wtime();
+    for (int i = 1; i <= numPedidos; i++) {
+        totales[i] = totalPedidoDirecto(alimentos, menus, buscarPedido(pedidos, i));
+    }
+    double tDirecto = omp_get_wtime() - inicio;
+    long long distintos = 0;
+    double tFrio = pasadaTotales(alimentos, menus, pedidos, numPedidos, totales, &distintos);
+    double tGuardado = pasadaTotales(alimentos, menus, pedidos, numPedidos, totales, &distintos);
+
+    printf("%-36s %12s %14s\n", "Pasada", "Segundos", "ns por pedido");
+    printf("%-36s %12.4f %14.1f\n", "Sin caché (menús → alimentos)", tDirecto, tDirecto * 1e9 / numPedidos);
+    printf("%-36s %12.4f %14.1f\n", "Caché en frío", tFrio, tFrio * 1e9 / numPedidos);
+    printf("%-36s %12.4f %14.1f\n", "Totales guardados", tGuardado, tGuardado * 1e9 / numPedidos);
+
+    printf("\n%-14s %20s %12s %14s\n", "Precios", "Pedidos invalidados", "Segundos", "ns por pedido");
+    for (int cambios = 1; cambios <= 100; cambios *= 10) {
+        MetricasTotales antes, despues;
+        leerMetricasTotales(&antes);
+        for (int c = 0; c < cambios; c++) {
+            Alimento *alimento = buscarAlimento(alimentos, (int)(aleatorioBench() % 1000) + 1);
+            actualizarAlimento(alimentos, alimento->id, textoCadena(alimento->nombre), alimento->precio + 1.0f, "Si");
+        }
+        leerMetricasTotales(&despues);
+        double segundos = pasadaTotales(alimentos, menus, pedidos, numPedidos, totales, &distintos);
+        printf("%-14d %20lld %12.4f %14.1f\n", cambios, despues.pedidosInvalidados - antes.pedidosInvalidados,
+               segundos, segundos * 1e9 / numPedidos);
+    }
+    printf("\nTotales distintos del cálculo directo: %lld\n", distintos);
+    imprimirMetricasTotales();
+
+    free(totales);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Compara una fila de un reporte con los valores esperados.
+ * @return `true` si pedidos y unidades son iguales y los ingresos difieren solo por redondeo.
+ */
+static bool filaIgual(const FilaReporteVentas *fila, long long pedidos, long long unidades, double ingresos) {
+    return fila->pedidos == pedidos && fila->unidades == unidades &&
+           fabs(fila->ingresos - ingresos) <= 1e-9 * fabs(ingresos) + 1e-6;
+}
+
+/**
+ * @brief Mide los reportes de ventas con 1, 2, 4, ... hilos y los compara con una pasada secuencial.
+ *
+ * La pasada de referencia busca cada menú y alimento en las tablas (sin el arreglo de
+ * totales) y acumula por cliente, por día de 2024 (las fechas de llenarTablas) y por
+ * menú; luego se comparan todas las filas de esos reportes y los totales.
+ *
+ * @param numPedidos Número de pedidos; las demás tablas se escalan como en llenarTablas.
+ */
+static void benchReportes(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    int numClientes = numPedidos / 10 + 1, numMenus = numPedidos / 100 + 1;
+
+    // Referencia secuencial: ingresos y pedidos por cliente, por día y unidades por menú
+    double *ingresosCliente = (double *)calloc((size_t)numClientes + 1, sizeof(double));
+    long long *pedidosCliente = (long long *)calloc((size_t)numClientes + 1, sizeof(long long));
+    long long *unidadesMenu = (long long *)calloc((size_t)numMenus + 1, sizeof(long long));
+    double ingresosDia[366] = {0}, ingresosTotales = 0.0;
+    long long pedidosDia[366] = {0};
+    Fecha enero2024 = fechaDeCivil(2024, 1, 1);
+    double inicio = omp_get_wtime();
+    for (int i = 1; i <= numPedidos; i++) {
+        Pedido *pedido = buscarPedido(pedidos, i);
+        double total = totalPedidoDirecto(alimentos, menus, pedido);
+        for (int j = 0; j < pedido->numMenus; j++) unidadesMenu[pedido->menus[j]]++;
+        ingresosCliente[pedido->idCliente] += total;
+        pedidosCliente[pedido->idCliente]++;
+        int dia = pedido->fecha - enero2024;
+        ingresosDia[dia] += total;
+        pedidosDia[dia]++;
+        ingresosTotales += total;
+    }
+    double tReferencia = omp_get_wtime() - inicio;
+
+    ReporteVentas reporte;
+    int maxHilos = omp_get_max_threads();
+    printf("%-10s %12s %14s %10s\n", "Hilos", "Segundos", "Pedidos/s (M)", "Speedup");
+    printf("%-10s %12.4f %14.1f %10s\n", "Secuencial", tReferencia, numPedidos / tReferencia / 1e6, "-");
+    double tUnHilo = 0.0;
+    bool calculado = false;
+    for (int hilos = 1;; hilos *= 2) {
+        if (hilos > maxHilos) hilos = maxHilos;
+        iniciarPoolTareas(hilos);
+        if (calculado) liberarReportesVentas(&reporte);
+        calculado = calcularReportesVentas(alimentos, clientes, menus, pedidos, &reporte);
+        if (!calculado) break;
+        if (hilos == 1) tUnHilo = reporte.segundos;
+        printf("%-10d %12.4f %14.1f %9.2fx\n", hilos, reporte.segundos, numPedidos / reporte.segundos / 1e6,
+               tUnHilo / reporte.segundos);
+        if (hilos == maxHilos) break;
+    }
+    iniciarPoolTareas(maxHilos);
+
+    long long distintas = 0;
+    if (calculado) {
+        if (reporte.pedidos != numPedidos || fabs(reporte.ingresos - ingresosTotales) > 1e-9 * ingresosTotales) distintas++;
+        for (int i = 0; i < reporte.numFilas[REPORTE_CLIENTES]; i++) {
+            const FilaReporteVentas *fila = &reporte.filas[REPORTE_CLIENTES][i];
+            if (!filaIgual(fila, pedidosCliente[fila->clave], fila->unidades, ingresosCliente[fila->clave])) distintas++;
+        }
+        for (int i = 0; i < reporte.numFilas[REPORTE_DIAS]; i++) {
+            const FilaReporteVentas *fila = &reporte.filas[REPORTE_DIAS][i];
+            int dia = fila->clave - enero2024;
+            if (dia < 0 || dia >= 366 || !filaIgual(fila, pedidosDia[dia], fila->unidades, ingresosDia[dia])) distintas++;
+        }
+        for (int i = 0; i < reporte.numFilas[REPORTE_MENUS]; i++) {
+            const FilaReporteVentas *fila = &reporte.filas[REPORTE_MENUS][i];
+            if (fila->unidades != unidadesMenu[fila->clave]) distintas++;
+        }
+
+        inicio = omp_get_wtime();
+        bool guardado = guardarReportesVentas(&reporte, "bench_reportes.csv");
+        double tCSV = omp_get_wtime() - inicio;
+        printf("\nGuardar en CSV: %.3f s (%s)\n", tCSV, guardado ? "bench_reportes.csv" : "error");
+        printf("Filas: %d días, %d alimentos, %d menús, %d clientes, %d estados\n", reporte.numFilas[REPORTE_DIAS],
+               reporte.numFilas[REPORTE_ALIMENTOS], reporte.numFilas[REPORTE_MENUS],
+               reporte.numFilas[REPORTE_CLIENTES], reporte.numFilas[REPORTE_ESTADOS]);
+        printf("Filas distintas de la referencia: %lld\n", distintas);
+        imprimirReportesVentas(&reporte, 5);
+        liberarReportesVentas(&reporte);
+        remove("bench_reportes.csv");
+    }
+
+    free(unidadesMenu);
+    free(pedidosCliente);
+    free(ingresosCliente);
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Días de un mes, para la lectura de referencia con `sscanf`.
+ */
+static int diasDelMes(int anio, int mes) {
+    static const int dias[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool bisiesto = anio % 4 == 0 && (anio % 100 != 0 || anio % 400 == 0);
+    return dias[mes - 1] + (mes == 2 && bisiesto);
+}
+
+/**
+ * @brief Mide leer, escribir y filtrar fechas con fechas.h contra el texto "AAAA-MM-DD".
+ *
+ * Las fechas se eligen al azar entre 1970 y 2099. La lectura de referencia usa `sscanf`
+ * y valida el mes y el día; la escritura de referencia, `snprintf`. El filtro cuenta las
+ * fechas de 2024 con dos `strcmp` sobre el texto y con dos comparaciones de enteros.
+ *
+ * @param numFechas Número de fechas.
+ */
+static void benchFechas(int numFechas) {
+    char (*textos)[FECHA_TEXTO] = malloc((size_t)numFechas * sizeof(*textos));
+    Fecha *fechas = (Fecha *)malloc((size_t)numFechas * sizeof(Fecha));
+    Fecha *referencia = (Fecha *)malloc((size_t)numFechas * sizeof(Fecha));
+    if (!textos || !fechas || !referencia) {
+        printf("Error: sin memoria para %d fechas\n", numFechas);
+        free(textos);
+        free(fechas);
+        free(referencia);
+        return;
+    }
+    semillaBench = 12345u;
+    Fecha primera = fechaDeCivil(1970, 1, 1), ultima = fechaDeCivil(2099, 12, 31);
+    for (int i = 0; i < numFechas; i++) {
+        formatearFecha(primera + (Fecha)(aleatorioBench() % (unsigned)(ultima - primera + 1)), textos[i]);
+    }
+
+    long long invalidas = 0, distintas = 0;
+    double inicio = omp_get_wtime();
+    for (int i = 0; i < numFechas; i++) {
+        if (!leerFecha(textos[i], FECHA_TEXTO - 1, &fechas[i])) invalidas++;
+    }
+    double tLeer = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    for (int i = 0; i < numFechas; i++) {
+        int anio, mes, dia;
+        if (sscanf(textos[i], "%4d-%2d-%2d", &anio, &mes, &dia) != 3 || mes < 1 || mes > 12 || dia < 1 ||
+            dia > diasDelMes(anio, mes)) {
+            invalidas++;
+            continue;
+        }
+        referencia[i] = fechaDeCivil(anio, mes, dia);
+    }
+    double tSscanf = omp_get_wtime() - inicio;
+    for (int i = 0; i < numFechas; i++) distintas += fechas[i] != referencia[i];
+
+    char texto[32];
+    unsigned suma = 0;
+    inicio = omp_get_wtime();
+    for (int i = 0; i < numFechas; i++) suma += (unsigned char)formatearFecha(fechas[i], texto)[9];
+    double tEscribir = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    for (int i = 0; i < numFechas; i++) {
+        int anio, mes, dia;
+        civilDeFecha(fechas[i], &anio, &mes, &dia);
+        snprintf(texto, sizeof(texto), "%04d-%02d-%02d", anio, mes, dia);
+        suma += (unsigned char)texto[9];
+    }
+    double tSnprintf = omp_get_wtime() - inicio;
+    for (int i = 0; i < numFechas; i++) distintas += strcmp(formatearFecha(fechas[i], texto), textos[i]) != 0;
+
+    long long enRangoTexto = 0, enRangoFecha = 0;
+    inicio = omp_get_wtime();
+    for (int i = 0; i < numFechas; i++) {
+        enRangoTexto += strcmp(textos[i], "2024-01-01") >= 0 && strcmp(textos[i], "2024-12-31") <= 0;
+    }
+    double tFiltroTexto = omp_get_wtime() - inicio;
+
+    Fecha desde = fechaDeCivil(2024, 1, 1), hasta = fechaDeCivil(2024, 12, 31);
+    inicio = omp_get_wtime();
+    for (int i = 0; i < numFechas; i++) enRangoFecha += fechas[i] >= desde && fechas[i] <= hasta;
+    double tFiltroFecha = omp_get_wtime() - inicio;
+
+    printf("%-36s %10s %12s\n", "Operación", "Segundos", "ns/fecha");
+    printf("%-36s %10.4f %12.2f\n", "Leer con leerFecha", tLeer, tLeer * 1e9 / numFechas);
+    printf("%-36s %10.4f %12.2f\n", "Leer con sscanf (referencia)", tSscanf, tSscanf * 1e9 / numFechas);
+    printf("%-36s %10.4f %12.2f\n", "Escribir con formatearFecha", tEscribir, tEscribir * 1e9 / numFechas);
+    printf("%-36s %10.4f %12.2f\n", "Escribir con snprintf (referencia)", tSnprintf, tSnprintf * 1e9 / numFechas);
+    printf("%-36s %10.4f %12.2f\n", "Filtrar 2024 comparando texto", tFiltroTexto, tFiltroTexto * 1e9 / numFechas);
+    printf("%-36s %10.4f %12.2f\n", "Filtrar 2024 comparando días", tFiltroFecha, tFiltroFecha * 1e9 / numFechas);
+    printf("\nFechas de 2024: %lld (texto) / %lld (días)\n", enRangoTexto, enRangoFecha);
+    printf("Inválidas: %lld, distintas de la referencia: %lld (suma de control %u)\n", invalidas,
+           distintas + (enRangoTexto != enRangoFecha), suma);
+
+    free(referencia);
+    free(fechas);
+    free(textos);
+}
+
+/**
+ * @brief Cliente con el diseño anterior (nombre en un arreglo fijo), para comparar.
+ */
+typedef struct ClienteFijo {
+    int idCliente;
+    char nombre[50];
+    char telefono[15];
+    struct ClienteFijo *next;
+} ClienteFijo;
+
+/// Nombres y apellidos con que se arman los nombres repetidos de la prueba de cadenas.
+static const char *const nombresPilaBench[20] = {
+    "María", "José", "Guadalupe", "Juan", "Ana", "Luis", "Rosa", "Carlos", "Laura", "Jorge",
+    "Elena", "Miguel", "Sofía", "Pedro", "Carmen", "Javier", "Lucía", "Fernando", "Isabel", "Ricardo"
+};
+static const char *const apellidosBench[20] = {
+    "Hernández", "García", "Martínez", "López", "González", "Pérez", "Rodríguez", "Sánchez", "Ramírez", "Cruz",
+    "Flores", "Gómez", "Morales", "Vázquez", "Reyes", "Jiménez", "Torres", "Díaz", "Gutiérrez", "Ruiz"
+};
+
+/**
+ * @brief Agrega `numClientes` clientes a una tabla nueva y compara su memoria con el diseño fijo.
+ *
+ * La memoria de las cadenas es la que crece la arena durante la prueba (los textos que ya
+ * estaban internados no cuentan). El diseño fijo se estima con la misma tabla y nodos de
+ * `sizeof(ClienteFijo)`.
+ *
+ * @param descripcion Nombre del caso.
+ * @param numClientes Número de clientes.
+ * @param repetidos `true` para nombres de un conjunto pequeño, `false` para "ClienteN".
+ * @return Tabla llena (se libera con liberarTablaClientes).
+ */
+static ClientesHashTable *llenarClientesCadenas(const char *descripcion, int numClientes, bool repetidos) {
+    ClientesHashTable *tabla = crearTablaClientes();
+    if (!tabla) return NULL;
+    ContadoresMemoria antes[NUM_SUBSISTEMAS_MEMORIA], despues[NUM_SUBSISTEMAS_MEMORIA];
+    MetricasCadenas cadenasAntes, cadenasDespues;
+    leerContadoresMemoria(antes);
+    leerMetricasCadenas(&cadenasAntes);
+
+    char nombre[64], telefono[16];
+    double inicio = omp_get_wtime();
+    for (int i = 1; i <= numClientes; i++) {
+        if (repetidos) {
+            snprintf(nombre, sizeof(nombre), "%s %s %s", nombresPilaBench[aleatorioBench() % 20],
+                     apellidosBench[aleatorioBench() % 20], apellidosBench[aleatorioBench() % 20]);
+        } else {
+            snprintf(nombre, sizeof(nombre), "Cliente%d", i);
+        }
+        snprintf(telefono, sizeof(telefono), "55%08u", aleatorioBench() % 100000000u);
+        agregarCliente(tabla, i, nombre, telefono);
+    }
+    double segundos = omp_get_wtime() - inicio;
+
+    leerContadoresMemoria(despues);
+    leerMetricasCadenas(&cadenasDespues);
+    long long bytesTabla = despues[MEMORIA_CLIENTES].bytesVivos - antes[MEMORIA_CLIENTES].bytesVivos;
+    long long bytesCadenas = despues[MEMORIA_CADENAS].bytesVivos - antes[MEMORIA_CADENAS].bytesVivos;
+    long long bytesFijo = bytesTabla + (long long)numClientes * (long long)(sizeof(ClienteFijo) - sizeof(Cliente));
+    long long bytesNuevo = bytesTabla + bytesCadenas;
+    long long nuevas = cadenasDespues.cadenas - cadenasAntes.cadenas;
+    long long internados = cadenasDespues.internados - cadenasAntes.internados;
+
+    printf("\n--- %s ---\n", descripcion);
+    printf("Clientes agregados en %.3f s (%.1f ns por cliente)\n", segundos, segundos * 1e9 / numClientes);
+    printf("Textos distintos nuevos: %lld de %lld internados\n", nuevas, internados);
+    printf("%-34s %16s %12s\n", "Diseño", "Bytes", "B/cliente");
+    printf("%-34s %16lld %12.1f\n", "Arreglos fijos (estimado)", bytesFijo, (double)bytesFijo / numClientes);
+    printf("%-34s %16lld %12.1f\n", "Cadenas internadas (tabla)", bytesTabla, (double)bytesTabla / numClientes);
+    printf("%-34s %16lld %12.1f\n", "Cadenas internadas (arena+índice)", bytesCadenas,
+           (double)bytesCadenas / numClientes);
+    printf("%-34s %16lld %12.1f\n", "Cadenas internadas (total)", bytesNuevo, (double)bytesNuevo / numClientes);
+    printf("Ahorro: %lld B (%.1f%%)\n", bytesFijo - bytesNuevo,
+           bytesFijo > 0 ? 100.0 * (double)(bytesFijo - bytesNuevo) / (double)bytesFijo : 0.0);
+    return tabla;
+}
+
+/**
+ * @brief Renombra a todos los clientes en varias rondas y muestra cuánto crece la arena.
+ *
+ * Cada ronda da a cada cliente un nombre que no se había usado ("RenombradoN.R"), como
+ * un servidor que recibe actualizaciones sin fin. Los nombres anteriores se quedan sin
+ * referencias y la ronda siguiente ocupa su espacio, así que la arena solo debe crecer
+ * en la primera ronda (cuando los nombres nuevos conviven con los "ClienteN") y
+ * después quedarse casi igual. Al final comprueba que cada cliente tiene su último nombre.
+ *
+ * @param tabla Tabla con los clientes 1..numClientes.
+ * @param numClientes Número de clientes.
+ */
+static void renombrarClientesCadenas(ClientesHashTable *tabla, int numClientes) {
+    const int rondas = 5;
+    MetricasCadenas metricas;
+    leerMetricasCadenas(&metricas);
+    printf("\n--- Renombrar %d clientes en %d rondas (nombres que no se repiten) ---\n", numClientes, rondas);
+    printf("%-8s %10s %14s %14s %14s %14s %12s\n", "Ronda", "Segundos", "Textos", "B texto", "B libres",
+           "B arena", "Reutilizados");
+    printf("%-8s %10s %14lld %14lld %14lld %14lld %12lld\n", "antes", "-", metricas.cadenas, metricas.bytesTexto,
+           metricas.bytesLibres, metricas.bytesArena, metricas.reutilizadas);
+    char nombre[64], telefono[15];
+    long long arenaPrimera = 0;
+    for (int r = 1; r <= rondas; r++) {
+        double inicio = omp_get_wtime();
+        for (int i = 1; i <= numClientes; i++) {
+            snprintf(nombre, sizeof(nombre), "Renombrado%d.%d", i, r);
+            strcpy(telefono, buscarCliente(tabla, i)->telefono);
+            actualizarCliente(tabla, i, nombre, telefono);
+        }
+        double segundos = omp_get_wtime() - inicio;
+        leerMetricasCadenas(&metricas);
+        if (r == 1) arenaPrimera = metricas.bytesArena;
+        printf("%-8d %10.3f %14lld %14lld %14lld %14lld %12lld\n", r, segundos, metricas.cadenas,
+               metricas.bytesTexto, metricas.bytesLibres, metricas.bytesArena, metricas.reutilizadas);
+    }
+    // Los espacios reutilizados no deben haber pisado el nombre de ningún cliente
+    int distintos = 0;
+    for (int i = 1; i <= numClientes; i++) {
+        snprintf(nombre, sizeof(nombre), "Renombrado%d.%d", i, rondas);
+        distintos += strcmp(textoCadena(buscarCliente(tabla, i)->nombre), nombre) != 0;
+    }
+    printf("Nombres distintos al esperado: %d%s\n", distintos, distintos == 0 ? "" : "  <-- DISTINTOS");
+    double crecimiento = arenaPrimera > 0 ? 100.0 * (double)(metricas.bytesArena - arenaPrimera) / (double)arenaPrimera
+                                          : 0.0;
+    printf("Crecimiento de la arena después de la primera ronda: %lld B (%.1f%%)%s\n",
+           metricas.bytesArena - arenaPrimera, crecimiento, crecimiento < 10.0 ? "" : "  <-- CRECE");
+}
+
+/**
+ * @brief Mide la memoria de los clientes con cadenas internadas y cuánto cuesta comparar nombres.
+ *
+ * Llena una tabla con nombres únicos ("ClienteN") y otra con nombres armados de 20
+ * nombres y 20 apellidos (8000 combinaciones), y compara cada una con el diseño de
+ * arreglos fijos. Después cuenta los clientes que se llaman igual que uno elegido,
+ * comparando Cadenas y, como referencia, con `strcmp` sobre copias en arreglos fijos,
+ * y renombra a los clientes de nombres únicos (ver renombrarClientesCadenas).
+ *
+ * @param numClientes Número de clientes de cada tabla.
+ */
+static void benchCadenas(int numClientes) {
+    printf("sizeof(Cliente) = %zu B, sizeof(ClienteFijo) = %zu B\n", sizeof(Cliente), sizeof(ClienteFijo));
+    semillaBench = 12345u;
+    ClientesHashTable *unicos = llenarClientesCadenas("Nombres únicos", numClientes, false);
+    ClientesHashTable *repetidos = llenarClientesCadenas("Nombres repetidos", numClientes, true);
+    Cadena *cadenas = (Cadena *)malloc((size_t)numClientes * sizeof(Cadena));
+    char (*fijos)[50] = malloc((size_t)numClientes * sizeof(*fijos));
+    if (!unicos || !repetidos || !cadenas || !fijos) {
+        printf("Error: sin memoria para %d clientes\n", numClientes);
+        if (unicos) liberarTablaClientes(unicos);
+        if (repetidos) liberarTablaClientes(repetidos);
+        free(cadenas);
+        free(fijos);
+        return;
+    }
+    for (int i = 0; i < numClientes; i++) {
+        Cliente *cliente = buscarCliente(repetidos, i + 1);
+        cadenas[i] = cliente->nombre;
+        snprintf(fijos[i], sizeof(fijos[i]), "%s", textoCadena(cliente->nombre));
+    }
+
+    const int rondas = 20;
+    long long igualesCadena = 0, igualesTexto = 0;
+    double inicio = omp_get_wtime();
+    for (int r = 0; r < rondas; r++) {
+        Cadena objetivo = cadenas[(r * 7919) % numClientes];
+        for (int i = 0; i < numClientes; i++) igualesCadena += cadenas[i] == objetivo;
+    }
+    double tCadena = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    for (int r = 0; r < rondas; r++) {
+        const char *objetivo = fijos[(r * 7919) % numClientes];
+        for (int i = 0; i < numClientes; i++) igualesTexto += strcmp(fijos[i], objetivo) == 0;
+    }
+    double tTexto = omp_get_wtime() - inicio;
+
+    long long comparaciones = (long long)rondas * numClientes;
+    printf("\n--- Comparar nombres (%lld comparaciones) ---\n", comparaciones);
+    printf("%-34s %10s %12s\n", "Comparación", "Segundos", "ns/compar.");
+    printf("%-34s %10.4f %12.2f\n", "Cadena == Cadena", tCadena, tCadena * 1e9 / comparaciones);
+    printf("%-34s %10.4f %12.2f\n", "strcmp (referencia)", tTexto, tTexto * 1e9 / comparaciones);
+    printf("\nIguales: %lld (Cadenas) / %lld (strcmp)%s\n", igualesCadena, igualesTexto,
+           igualesCadena == igualesTexto ? "" : "  <-- DISTINTOS");
+
+    renombrarClientesCadenas(unicos, numClientes);
+
+    free(fijos);
+    free(cadenas);
+    liberarTablaClientes(repetidos);
+    liberarTablaClientes(unicos);
+}
+
+/**
+ * @brief Mide la importación de pedidos desde CSV y JSON Lines.
+ *
+ * Los alimentos, clientes y menús se quedan en las tablas; solo se vacían los pedidos
+ * antes de cada importación.
+ *
+ * @param numPedidos Número de pedidos a generar.
+ */
+static void benchImportacion(int numPedidos) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    serializarDatos(ARCHIVO_BENCH, alimentos, clientes, menus, pedidos);
+    escribirPedidosImportables("bench_pedidos.csv", pedidos, numPedidos, false);
+    escribirPedidosImportables("bench_pedidos.jsonl", pedidos, numPedidos, true);
+
+    static const char *const archivos[] = { "bench_pedidos.csv", "bench_pedidos.jsonl" };
+    printf("\n%-22s %10s %10s %14s %10s %10s %10s\n", "Archivo", "MB", "Segundos", "Registros/s", "Importados",
+           "Rechazos", "Idéntico");
+    for (int i = 0; i < 2; i++) {
+        vaciarTablaPedidos(pedidos);
+        ResultadoImportacion resultado;
+        bool importado = importarArchivo(archivos[i], IMPORTAR_PEDIDOS, alimentos, clientes, menus, pedidos, &resultado);
+        serializarDatos("bench_importado.yaml", alimentos, clientes, menus, pedidos);
+        bool iguales = importado && archivosIguales(ARCHIVO_BENCH, "bench_importado.yaml");
+        printf("%-22s %10.1f %10.3f %14.0f %10lld %10lld %10s\n", archivos[i],
+               tamanoArchivo(archivos[i]) / (1024.0 * 1024.0), resultado.segundos,
+               resultado.registros / resultado.segundos, resultado.importados, resultado.rechazados,
+               iguales ? "si" : "NO");
+        if (i == 1) imprimirResultadoImportacion(archivos[i], &resultado);
+    }
+
+    remove(ARCHIVO_BENCH);
+    remove("bench_importado.yaml");
+    remove("bench_pedidos.csv");
+    remove("bench_pedidos.jsonl");
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/// Archivo CSV por omisión de la prueba de operaciones por tabla.
+#define CSV_TABLAS_BENCH "bench_tablas.csv"
+
+/**
+ * @brief Operaciones que mide `bench tablas`, en el orden en que se ejecutan.
+ */
+typedef enum {
+    OP_INSERTAR,
+    OP_BUSCAR_ACIERTO,
+    OP_BUSCAR_FALLO,
+    OP_ACTUALIZAR,
+    OP_CONTAR,
+    OP_COPIAR,
+    OP_ORDENAR,
+    OP_BUSQUEDA_BINARIA,
+    OP_ELIMINAR,
+    NUM_OPERACIONES_BENCH
+} OperacionBench;
+
+/// Nombre de cada operación en la tabla y en el CSV, en el orden de OperacionBench.
+static const char *const nombresOperacionBench[NUM_OPERACIONES_BENCH] = {
+    "insertar", "buscar_acierto", "buscar_fallo", "actualizar", "contar", "copiar", "ordenar",
+    "busqueda_binaria", "eliminar"
+};
+
+/**
+ * @brief Operaciones de una tabla vistas de forma uniforme por la prueba.
+ *
+ * Cada función adapta la de la tabla; la llamada indirecta cuesta unos pocos ns por
+ * operación y es igual para todas las tablas.
+ */
+typedef struct {
+    const char *nombre;
+    size_t tamanoRegistro;                           ///< Tamaño del registro en el arreglo copiado.
+    void *(*crear)(void);
+    void (*liberar)(void *tabla);
+    bool (*insertar)(void *tabla, int id);
+    bool (*buscar)(void *tabla, int id);
+    bool (*actualizar)(void *tabla, int id);
+    bool (*eliminar)(void *tabla, int id);
+    int (*contar)(void *tabla);
+    void (*copiar)(void *tabla, void *arreglo);
+    void (*ordenar)(void *arreglo, int n);
+    int (*buscarEnArreglo)(void *arreglo, int n, int id);
+} TablaBench;
+
+/// Tablas a las que se refieren los menús y pedidos de la prueba (se llenan una vez).
+static HashTable *alimentosReferencia;
+static ClientesHashTable *clientesReferencia;
+static MenuHashTable *menusReferencia;
+
+/// Alimentos, clientes y menús de referencia.
+#define REFERENCIAS_BENCH 50
+
+/// Destino de los resultados que el compilador no debe descartar.
+static volatile long long sumideroBench;
+
+static void *crearAlimentosBench(void) { return crearTablaHash(); }
+static void liberarAlimentosBench(void *tabla) { liberarTabla(tabla); }
+// Los alimentos se ordenan por precio: con precio = ID la búsqueda binaria por ID sigue siendo válida
+static bool insertarAlimentoBench(void *tabla, int id) { return insertarAlimento(tabla, id, "Alimento", (float)id, "Si"); }
+static bool buscarAlimentoBench(void *tabla, int id) { return buscarAlimento(tabla, id) != NULL; }
+static bool actualizarAlimentoBench(void *tabla, int id) { return actualizarAlimento(tabla, id, "Alimento2", (float)id, "No"); }
+static bool eliminarAlimentoBench(void *tabla, int id) { return eliminarAlimento(tabla, id); }
+static int contarAlimentosBench(void *tabla) { return obtenerNumeroDeAlimentos(tabla); }
+static void copiarAlimentosBench(void *tabla, void *arreglo) { copiarAlimentosDesdeTabla(tabla, arreglo); }
+static void ordenarAlimentosBench(void *arreglo, int n) { quicksortAlimentosParallel(arreglo, 0, n - 1); }
+static int buscarAlimentoEnArregloBench(void *arreglo, int n, int id) { return busquedaBinariaAlimentosParallel(arreglo, n, id); }
+
+static void *crearClientesBench(void) { return crearTablaClientes(); }
+static void liberarClientesBench(void *tabla) { liberarTablaClientes(tabla); }
+static bool insertarClienteBench(void *tabla, int id) { return agregarCliente(tabla, id, "Cliente", "5512345678"); }
+static bool buscarClienteBench(void *tabla, int id) { return buscarCliente(tabla, id) != NULL; }
+static bool actualizarClienteBench(void *tabla, int id) { return actualizarCliente(tabla, id, "Cliente2", "5587654321"); }
+static bool eliminarClienteBench(void *tabla, int id) { return eliminarCliente(tabla, id); }
+static int contarClientesBench(void *tabla) { return obtenerNumeroDeClientes(tabla); }
+static void copiarClientesBench(void *tabla, void *arreglo) { copiarClientesDesdeTabla(tabla, arreglo); }
+static void ordenarClientesBench(void *arreglo, int n) { quicksortClientesParallel(arreglo, 0, n - 1); }
+static int buscarClienteEnArregloBench(void *arreglo, int n, int id) { return busquedaBinariaClientesParallel(arreglo, n, id); }
+
+static void *crearMenusBench(void) { return crearTablaMenus(); }
+static void liberarMenusBench(void *tabla) { liberarTablaMenus(tabla); }
+static bool insertarMenuBench(void *tabla, int id) {
+    int alimentos[3] = { id % REFERENCIAS_BENCH + 1, (id + 1) % REFERENCIAS_BENCH + 1, (id + 2) % REFERENCIAS_BENCH + 1 };
+    return agregarMenu(tabla, id, fechaDeCivil(2024, 6, 1), alimentos, 3, alimentosReferencia);
+}
+static bool buscarMenuBench(void *tabla, int id) { return buscarMenuPorID(tabla, id) != NULL; }
+static bool actualizarMenuBench(void *tabla, int id) {
+    int alimentos[2] = { id % REFERENCIAS_BENCH + 1, (id + 7) % REFERENCIAS_BENCH + 1 };
+    return actualizarMenu(tabla, id, fechaDeCivil(2024, 7, 1), alimentos, 2);
+}
+static bool eliminarMenuBench(void *tabla, int id) { return eliminarMenu(tabla, id); }
+static int contarMenusBench(void *tabla) { return obtenerNumeroDeMenus(tabla); }
+static void copiarMenusBench(void *tabla, void *arreglo) { copiarMenusDesdeTabla(tabla, arreglo); }
+static void ordenarMenusBench(void *arreglo, int n) { quicksortMenusParallel(arreglo, 0, n - 1); }
+static int buscarMenuEnArregloBench(void *arreglo, int n, int id) { return busquedaBinariaMenusParallel(arreglo, n, id); }
+
+static void *crearPedidosBench(void) { return crearTablaPedidos(); }
+static void liberarPedidosBench(void *tabla) { liberarTablaPedidos(tabla); }
+static bool insertarPedidoBench(void *tabla, int id) {
+    int menus[2] = { id % REFERENCIAS_BENCH + 1, (id + 1) % REFERENCIAS_BENCH + 1 };
+    return agregarPedido(tabla, menusReferencia, clientesReferencia, id, id % REFERENCIAS_BENCH + 1, fechaDeCivil(2024, 6, 1),
+                         menus, 2, "Pendiente");
+}
+static bool buscarPedidoBench(void *tabla, int id) { return buscarPedido(tabla, id) != NULL; }
+static bool actualizarPedidoBench(void *tabla, int id) { return actualizarPedido(tabla, id, "En Proceso"); }
+static bool eliminarPedidoBench(void *tabla, int id) { return eliminarPedido(tabla, id); }
+static int contarPedidosBench(void *tabla) { return obtenerNumeroDePedidos(tabla); }
+static void copiarPedidosBench(void *tabla, void *arreglo) { copiarPedidosDesdeTabla(tabla, arreglo); }
+static void ordenarPedidosBench(void *arreglo, int n) { quicksortPedidosParallel(arreglo, 0, n - 1); }
+static int buscarPedidoEnArregloBench(void *arreglo, int n, int id) { return busquedaBinariaPedidosParallel(arreglo, n, id); }
+
+/// Las cuatro tablas que recorre la prueba.
+static const TablaBench tablasBench[] = {
+    { "alimentos", sizeof(Alimento), crearAlimentosBench, liberarAlimentosBench, insertarAlimentoBench,
+      buscarAlimentoBench, actualizarAlimentoBench, eliminarAlimentoBench, contarAlimentosBench,
+      copiarAlimentosBench, ordenarAlimentosBench, buscarAlimentoEnArregloBench },
+    { "clientes", sizeof(Cliente), crearClientesBench, liberarClientesBench, insertarClienteBench,
+      buscarClienteBench, actualizarClienteBench, eliminarClienteBench, contarClientesBench,
+      copiarClientesBench, ordenarClientesBench, buscarClienteEnArregloBench },
+    { "menus", sizeof(Menu), crearMenusBench, liberarMenusBench, insertarMenuBench,
+      buscarMenuBench, actualizarMenuBench, eliminarMenuBench, contarMenusBench,
+      copiarMenusBench, ordenarMenusBench, buscarMenuEnArregloBench },
+    { "pedidos", sizeof(Pedido), crearPedidosBench, liberarPedidosBench, insertarPedidoBench,
+      buscarPedidoBench, actualizarPedidoBench, eliminarPedidoBench, contarPedidosBench,
+      copiarPedidosBench, ordenarPedidosBench, buscarPedidoEnArregloBench },
+};
+
+/**
+ * @brief Número aleatorio en [0, limite) con más bits que aleatorioBench.
+ */
+static int aleatorioHastaBench(int limite) {
+    unsigned long long valor = ((unsigned long long)aleatorioBench() << 24) ^ aleatorioBench();
+    return (int)(valor % (unsigned long long)limite);
+}
+
+/**
+ * @brief Revuelve un arreglo de registros de `tamano` bytes (Fisher-Yates).
+ */
+static void revolverBench(char *registros, int n, size_t tamano, char *temporal) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = aleatorioHastaBench(i + 1);
+        memcpy(temporal, registros + (size_t)i * tamano, tamano);
+        memcpy(registros + (size_t)i * tamano, registros + (size_t)j * tamano, tamano);
+        memcpy(registros + (size_t)j * tamano, temporal, tamano);
+    }
+}
+
+/**
+ * @brief Ejecuta una vez todas las operaciones sobre una tabla de `n` registros.
+ * @param tabla Operaciones de la tabla.
+ * @param n Registros.
+ * @param ids IDs 1..n en orden aleatorio.
+ * @param ns Nanosegundos por operación de cada OperacionBench (de salida).
+ * @return `false` si alguna operación no dio el resultado esperado o faltó memoria.
+ */
+static bool medirTablaBench(const TablaBench *tabla, int n, const int *ids, double ns[NUM_OPERACIONES_BENCH]) {
+    void *datos = tabla->crear();
+    char *arreglo = malloc((size_t)n * tabla->tamanoRegistro);
+    char *temporal = malloc(tabla->tamanoRegistro);
+    if (!datos || !arreglo || !temporal) {
+        if (datos) tabla->liberar(datos);
+        free(arreglo);
+        free(temporal);
+        return false;
+    }
+    long long correctas[NUM_OPERACIONES_BENCH] = { 0 };
+    double inicio;
+
+    inicio = omp_get_wtime();
+    for (int i = 0; i < n; i++) correctas[OP_INSERTAR] += tabla->insertar(datos, ids[i]);
+    ns[OP_INSERTAR] = (omp_get_wtime() - inicio) * 1e9 / n;
+
+    inicio = omp_get_wtime();
+    for (int i = n - 1; i >= 0; i--) correctas[OP_BUSCAR_ACIERTO] += tabla->buscar(datos, ids[i]);
+    ns[OP_BUSCAR_ACIERTO] = (omp_get_wtime() - inicio) * 1e9 / n;
+
+    inicio = omp_get_wtime();
+    for (int i = 0; i < n; i++) correctas[OP_BUSCAR_FALLO] += !tabla->buscar(datos, n + ids[i]);
+    ns[OP_BUSCAR_FALLO] = (omp_get_wtime() - inicio) * 1e9 / n;
+
+    inicio = omp_get_wtime();
+    for (int i = 0; i < n; i++) correctas[OP_ACTUALIZAR] += tabla->actualizar(datos, ids[i]);
+    ns[OP_ACTUALIZAR] = (omp_get_wtime() - inicio) * 1e9 / n;
+
+    long long suma = 0;
+    inicio = omp_get_wtime();
+    for (int i = 0; i < n; i++) suma += tabla->contar(datos);
+    ns[OP_CONTAR] = (omp_get_wtime() - inicio) * 1e9 / n;
+    correctas[OP_CONTAR] = suma == (long long)n * n ? n : 0;
+
+    inicio = omp_get_wtime();
+    tabla->copiar(datos, arreglo);
+    ns[OP_COPIAR] = (omp_get_wtime() - inicio) * 1e9 / n;
+    correctas[OP_COPIAR] = n;
+
+    revolverBench(arreglo, n, tabla->tamanoRegistro, temporal); // La copia sale casi ordenada del arreglo directo
+    inicio = omp_get_wtime();
+    tabla->ordenar(arreglo, n);
+    ns[OP_ORDENAR] = (omp_get_wtime() - inicio) * 1e9 / n;
+    correctas[OP_ORDENAR] = n;
+
+    inicio = omp_get_wtime();
+    for (int i = 0; i < n; i++) {
+        int posicion = tabla->buscarEnArreglo(arreglo, n, ids[i]);
+        correctas[OP_BUSQUEDA_BINARIA] += posicion == ids[i] - 1; // Ordenado, el ID k queda en k - 1
+    }
+    ns[OP_BUSQUEDA_BINARIA] = (omp_get_wtime() - inicio) * 1e9 / n;
+
+    inicio = omp_get_wtime();
+    for (int i = 0; i < n; i++) correctas[OP_ELIMINAR] += tabla->eliminar(datos, ids[i]);
+    ns[OP_ELIMINAR] = (omp_get_wtime() - inicio) * 1e9 / n;
+
+    sumideroBench += suma;
+    tabla->liberar(datos);
+    free(arreglo);
+    free(temporal);
+
+    bool correcto = true;
+    for (int i = 0; i < NUM_OPERACIONES_BENCH; i++) {
+        if (correctas[i] != n) {
+            printf("Error: %s %s con %d registros: %lld de %d operaciones dieron el resultado esperado.\n",
+                   tabla->nombre, nombresOperacionBench[i], n, correctas[i], n);
+            correcto = false;
+        }
+    }
+    return correcto;
+}
+
+/**
+ * @brief Mide insertar, buscar (acierto y fallo), actualizar, contar, copiar, ordenar,
+ * búsqueda binaria y eliminar en las cuatro tablas, con 1e3, 1e4, ... registros.
+ *
+ * Cada tamaño se repite `repeticiones` veces con tablas nuevas; se informa el promedio
+ * de ns por operación, la desviación estándar, el mínimo y el máximo, en consola y en CSV.
+ *
+ * @param tamanoMaximo Mayor número de registros (1e7 necesita varios GB para los pedidos).
+ * @param repeticiones Corridas por tamaño.
+ * @param nombreCsv Archivo CSV de resultados.
+ */
+static void benchTablas(int tamanoMaximo, int repeticiones, const char *nombreCsv) {
+    FILE *csv = fopen(nombreCsv, "w");
+    if (!csv) {
+        printf("Error: No se pudo crear '%s'.\n", nombreCsv);
+        return;
+    }
+    fprintf(csv, "tabla,operacion,tamano,repeticiones,ns_por_op,desviacion_ns,min_ns,max_ns\n");
+
+    alimentosReferencia = crearTablaHash();
+    clientesReferencia = crearTablaClientes();
+    menusReferencia = crearTablaMenus();
+    for (int i = 1; i <= REFERENCIAS_BENCH; i++) {
+        insertarAlimento(alimentosReferencia, i, "Alimento", 10.0f, "Si");
+        agregarCliente(clientesReferencia, i, "Cliente", "5512345678");
+        int alimentos[1] = { i };
+        agregarMenu(menusReferencia, i, fechaDeCivil(2024, 6, 1), alimentos, 1, alimentosReferencia);
+    }
+
+    double (*muestras)[NUM_OPERACIONES_BENCH] = malloc((size_t)repeticiones * sizeof(*muestras));
+    for (int t = 0; t < (int)(sizeof(tablasBench) / sizeof(tablasBench[0])) && muestras; t++) {
+        const TablaBench *tabla = &tablasBench[t];
+        printf("\n--- %s ---\n%-18s %10s %12s %12s %12s %12s\n", tabla->nombre, "Operación", "Registros",
+               "ns/op", "Desv. (ns)", "Mín. (ns)", "Máx. (ns)");
+        for (long long n = 1000; n <= tamanoMaximo; n *= 10) {
+            int *ids = malloc((size_t)n * sizeof(int));
+            if (!ids) break;
+            for (int i = 0; i < n; i++) ids[i] = i + 1;
+            bool correcto = true;
+            for (int r = 0; r < repeticiones && correcto; r++) {
+                semillaBench = 12345u + (unsigned int)r; // Cada repetición con otro orden, reproducible
+                for (int i = (int)n - 1; i > 0; i--) {
+                    int j = aleatorioHastaBench(i + 1), temporal = ids[i];
+                    ids[i] = ids[j];
+                    ids[j] = temporal;
+                }
+                correcto = medirTablaBench(tabla, (int)n, ids, muestras[r]);
+            }
+            free(ids);
+            if (!correcto) break;
+
+            for (int op = 0; op < NUM_OPERACIONES_BENCH; op++) {
+                double suma = 0.0, minimo = muestras[0][op], maximo = muestras[0][op];
+                for (int r = 0; r < repeticiones; r++) {
+                    suma += muestras[r][op];
+                    if (muestras[r][op] < minimo) minimo = muestras[r][op];
+                    if (muestras[r][op] > maximo) maximo = muestras[r][op];
+                }
+                double promedio = suma / repeticiones, varianza = 0.0;
+                for (int r = 0; r < repeticiones; r++) {
+                    varianza += (muestras[r][op] - promedio) * (muestras[r][op] - promedio);
+                }
+                double desviacion = repeticiones > 1 ? sqrt(varianza / (repeticiones - 1)) : 0.0;
+                printf("%-18s %10lld %12.1f %12.1f %12.1f %12.1f\n", nombresOperacionBench[op], n, promedio,
+                       desviacion, minimo, maximo);
+                fprintf(csv, "%s,%s,%lld,%d,%.2f,%.2f,%.2f,%.2f\n", tabla->nombre, nombresOperacionBench[op], n,
+                        repeticiones, promedio, desviacion, minimo, maximo);
+            }
+            fflush(csv);
+        }
+    }
+
+    free(muestras);
+    liberarTablaMenus(menusReferencia);
+    liberarTablaClientes(clientesReferencia);
+    liberarTabla(alimentosReferencia);
+    fclose(csv);
+    printf("\nResultados en '%s'.\n", nombreCsv);
+}
+
+/**
+ * @brief Resultado de una operación leído del CSV de `bench tablas`.
+ */
+typedef struct {
+    char tabla[32];
+    char operacion[32];
+    int tamano;
+    double ns;
+    double desviacion;
+} FilaTablasBench;
+
+/**
+ * @brief Lee las filas de un CSV de `bench tablas`.
+ * @param nombre Archivo.
+ * @param numFilas Filas leídas (de salida).
+ * @return Arreglo de filas (liberar con `free`), o NULL si no se pudo leer.
+ */
+static FilaTablasBench *leerCsvTablasBench(const char *nombre, int *numFilas) {
+    FILE *archivo = fopen(nombre, "r");
+    if (!archivo) {
+        printf("Error: No se pudo abrir '%s'.\n", nombre);
+        return NULL;
+    }
+    int capacidad = 64;
+    FilaTablasBench *filas = malloc((size_t)capacidad * sizeof(FilaTablasBench));
+    char linea[256];
+    *numFilas = 0;
+    while (filas && fgets(linea, sizeof(linea), archivo)) {
+        FilaTablasBench fila;
+        int repeticiones;
+        if (sscanf(linea, "%31[^,],%31[^,],%d,%d,%lf,%lf", fila.tabla, fila.operacion, &fila.tamano, &repeticiones,
+                   &fila.ns, &fila.desviacion) != 6) continue; // Encabezado o línea incompleta
+        if (*numFilas == capacidad) {
+            capacidad *= 2;
+            FilaTablasBench *nuevas = realloc(filas, (size_t)capacidad * sizeof(FilaTablasBench));
+            if (!nuevas) {
+                free(filas);
+                filas = NULL;
+                break;
+            }
+            filas = nuevas;
+        }
+        filas[(*numFilas)++] = fila;
+    }
+    fclose(archivo);
+    return filas;
+}
+
+/**
+ * @brief Compara dos CSV de `bench tablas` (una línea base contra una corrida nueva).
+ *
+ * Un cambio se marca como significativo si la diferencia supera dos veces la desviación
+ * combinada de ambas corridas.
+ *
+ * @param nombreBase CSV de referencia.
+ * @param nombreNuevo CSV a comparar.
+ */
+static void compararTablasBench(const char *nombreBase, const char *nombreNuevo) {
+    int numBase, numNuevo;
+    FilaTablasBench *base = leerCsvTablasBench(nombreBase, &numBase);
+    FilaTablasBench *nuevo = base ? leerCsvTablasBench(nombreNuevo, &numNuevo) : NULL;
+    if (!base || !nuevo) {
+        free(base);
+        return;
+    }
+
+    printf("%-10s %-18s %10s %12s %12s %9s\n", "Tabla", "Operación", "Registros", "Base (ns)", "Nuevo (ns)", "Cambio");
+    int mejoras = 0, regresiones = 0;
+    for (int i = 0; i < numNuevo; i++) {
+        const FilaTablasBench *fila = &nuevo[i];
+        const FilaTablasBench *referencia = NULL;
+        for (int j = 0; j < numBase && !referencia; j++) {
+            if (base[j].tamano == fila->tamano && strcmp(base[j].tabla, fila->tabla) == 0 &&
+                strcmp(base[j].operacion, fila->operacion) == 0) referencia = &base[j];
+        }
+        if (!referencia || referencia->ns <= 0.0) continue;
+        double cambio = (fila->ns - referencia->ns) / referencia->ns * 100.0;
+        double ruido = 2.0 * sqrt(referencia->desviacion * referencia->desviacion + fila->desviacion * fila->desviacion);
+        bool significativo = fabs(fila->ns - referencia->ns) > ruido;
+        if (significativo && cambio < 0) mejoras++;
+        if (significativo && cambio > 0) regresiones++;
+        printf("%-10s %-18s %10d %12.1f %12.1f %+8.1f%%%s\n", fila->tabla, fila->operacion, fila->tamano,
+               referencia->ns, fila->ns, cambio, significativo ? (cambio < 0 ? "  mejor" : "  PEOR") : "");
+    }
+    printf("\n%d mejoras y %d regresiones fuera del ruido (2 desviaciones).\n", mejoras, regresiones);
+    free(base);
+    free(nuevo);
+}
+
+/// Hilos de recepción que agregan y encolan pedidos en la prueba de la cocina.
+#define PRODUCTORES_BENCH 2
+
+/**
+ * @brief Mide el índice de IDs guardado en la tabla contra reconstruirlo y contra la búsqueda binaria.
+ *
+ * Para cada tamaño (1e6, 2e6, 5e6 y 1e7, sin pasar de `tamanoMaximo`) llena una tabla de
+ * clientes con IDs impares y mide:
+ *  - lo que costaba cada búsqueda cuando el índice se armaba en cada consulta (copiar,
+ *    ordenar con quicksortClientesParallel y construir el índice),
+ *  - construir una vez el índice que queda en la tabla (indiceIdsClientes),
+ *  - una consulta por cota inferior con ese índice y con busquedaBinariaClientesParallel
+ *    sobre el snapshot ordenado, con la mitad de los IDs buscados ausentes.
+ * Comprueba que ambas búsquedas dan el mismo cliente (o el siguiente ID mayor) y que
+ * actualizar un cliente invalida el índice guardado.
+ *
+ * @param tamanoMaximo Número máximo de clientes.
+ */
+static void benchIndice(int tamanoMaximo) {
+    const int numConsultas = 1000000;
+    int *consultas = (int *)malloc((size_t)numConsultas * sizeof(int));
+    printf("%-10s %14s %14s %14s %14s %12s\n", "Claves", "Rearmar (ms)", "Índice (ms)", "Índice (ns)",
+           "Binaria (ns)", "Distintos");
+    static const int tamanos[] = { 1000000, 2000000, 5000000, 10000000 };
+    for (int t = 0; t < (int)(sizeof(tamanos) / sizeof(tamanos[0])); t++) {
+        int numClientes = tamanos[t] < tamanoMaximo ? tamanos[t] : tamanoMaximo;
+        ClientesHashTable *clientes = crearTablaClientes();
+        char nombre[50];
+        for (int i = 0; i < numClientes; i++) {
+            sprintf(nombre, "Cliente%d", i);
+            agregarCliente(clientes, 2 * i + 1, nombre, "5550000000");
+        }
+        semillaBench = 12345u;
+        for (int i = 0; i < numConsultas; i++) {
+            consultas[i] = (int)((((unsigned long long)aleatorioBench() << 24) | aleatorioBench()) % (2ULL * numClientes + 1));
+        }
+
+        // Lo que hacía cada búsqueda antes de guardar el índice en la tabla
+        double inicio = omp_get_wtime();
+        Cliente *snapshot = (Cliente *)malloc((size_t)numClientes * sizeof(Cliente));
+        copiarClientesDesdeTabla(clientes, snapshot);
+        quicksortClientesParallel(snapshot, 0, numClientes - 1);
+        int *ids = (int *)malloc((size_t)numClientes * sizeof(int));
+        for (int i = 0; i < numClientes; i++) ids[i] = snapshot[i].idCliente;
+        IndiceBusqueda *rearmado = crearIndiceBusqueda(ids, numClientes);
+        double tRearmar = omp_get_wtime() - inicio;
+        liberarIndiceBusqueda(rearmado);
+        free(ids);
+
+        inicio = omp_get_wtime();
+        IndiceBusqueda *indice = indiceIdsClientes(clientes);
+        double tIndice = omp_get_wtime() - inicio;
+
+        long long suma = 0;
+        inicio = omp_get_wtime();
+        for (int i = 0; i < numConsultas; i++) {
+            int encontrada;
+            suma += indiceSiguienteClave(indice, consultas[i], &encontrada) ? encontrada : -1;
+        }
+        double tConsultaIndice = omp_get_wtime() - inicio;
+
+        inicio = omp_get_wtime();
+        for (int i = 0; i < numConsultas; i++) {
+            suma += busquedaBinariaClientesParallel(snapshot, numClientes, consultas[i]);
+        }
+        double tConsultaBinaria = omp_get_wtime() - inicio;
+
+        // Un ID buscado que existe está en la posición (ID - 1) / 2 del snapshot; si no existe, el siguiente es ID + 1
+        long long distintos = 0;
+        for (int i = 0; i < numConsultas; i++) {
+            int encontrada, posicion = busquedaBinariaClientesParallel(snapshot, numClientes, consultas[i]);
+            int esperada = posicion >= 0 ? snapshot[posicion].idCliente : consultas[i] + 1;
+            if (esperada > 2 * numClientes - 1) {
+                if (indiceSiguienteClave(indice, consultas[i], &encontrada)) distintos++;
+            } else if (!indiceSiguienteClave(indice, consultas[i], &encontrada) || encontrada != esperada) {
+                distintos++;
+            }
+        }
+        printf("%-10d %14.1f %14.1f %14.1f %14.1f %12lld\n", numClientes, tRearmar * 1e3, tIndice * 1e3,
+               tConsultaIndice * 1e9 / numConsultas, tConsultaBinaria * 1e9 / numConsultas, distintos);
+        sumideroBench += suma;
+
+        actualizarCliente(clientes, 1, "Cliente0", "5550000001");
+        if (clientes->indiceIds) printf("Error: el índice sigue guardado después de actualizar un cliente.\n");
+
+        free(snapshot);
+        liberarTablaClientes(clientes);
+        if (numClientes == tamanoMaximo) break;
+    }
+    printf("\nRearmar: copiar, ordenar y construir el índice en cada búsqueda (como antes).\n");
+    printf("Índice (ms): construir una vez el índice que queda en la tabla.\n");
+    free(consultas);
+}
+
+/**
+ * @brief Mide el despacho de pedidos nuevos a la cocina con 1, 2, 4, ... cocineros.
+ * @param numPedidos Pedidos que se reciben en cada corrida.
+ * @param microsPorMenu Tiempo de preparación simulado por menú.
+ */
+static void benchCocina(int numPedidos, int microsPorMenu) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+    int numClientes = numPedidos / 10 + 1, numMenus = numPedidos / 100 + 1;
+
+    // Los pendientes que dejó llenarTablas se completan antes de medir
+    iniciarCocina(pedidos, 1, 0);
+    detenerCocina(NULL);
+
+    printf("%-10s %10s %12s %14s %14s %12s %10s %12s\n", "Cocineros", "Segundos", "Pedidos/s", "Espera (µs)",
+           "Máxima (µs)", "Prof. máx.", "Llena", "Completos");
+    int maxCocineros = omp_get_max_threads() > 8 ? omp_get_max_threads() : 8;
+    for (int cocineros = 1, corrida = 1; cocineros <= maxCocineros; cocineros *= 2, corrida++) {
+        if (!iniciarCocina(pedidos, cocineros, microsPorMenu)) break;
+        int base = numPedidos * corrida; // IDs nuevos en cada corrida
+        double inicio = omp_get_wtime();
+        #pragma omp parallel num_threads(PRODUCTORES_BENCH)
+        {
+            int yo = omp_get_thread_num(), productores = omp_get_num_threads();
+            for (int i = yo; i < numPedidos; i += productores) {
+                int idPedido = base + i + 1, menusPedido[1] = { i % numMenus + 1 };
+                bloquearTablasCocina();
+                bool agregado = agregarPedido(pedidos, menus, clientes, idPedido, i % numClientes + 1, fechaDeCivil(2024, 6, 1),
+                                              menusPedido, 1, "Pendiente");
+                desbloquearTablasCocina();
+                while (agregado && !encolarPedidoCocina(idPedido)); // Con la cola llena, la recepción espera
+            }
+        }
+        MetricasCocina metricas;
+        detenerCocina(&metricas);
+        double t = omp_get_wtime() - inicio;
+        printf("%-10d %10.3f %12.0f %14.1f %14.1f %12d %10lld %12s\n", cocineros, t, numPedidos / t,
+               metricas.esperaPromedio * 1e6, metricas.esperaMaxima * 1e6, metricas.profundidadMaxima,
+               metricas.rechazados, metricas.completados == numPedidos ? "si" : "NO");
+    }
+
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+/**
+ * @brief Tarea que no hace nada, para medir el costo de lanzar y esperar.
+ */
+static void tareaVaciaBench(void *argumento) {
+    (void)argumento;
+}
+
+/**
+ * @brief Mide el ordenamiento de pedidos con el pool de tareas y el costo de una tarea.
+ * @param numPedidos Número de pedidos a ordenar.
+ */
+static void benchTareas(int numPedidos) {
+    Pedido *arreglo = calloc((size_t)numPedidos, sizeof(Pedido));
+    if (!arreglo) {
+        printf("Error: No hay memoria para %d pedidos.\n", numPedidos);
+        return;
+    }
+
+    int maxHilos = omp_get_max_threads();
+    printf("%-10s %10s %12s %10s %10s\n", "Hilos", "Segundos", "Pedidos/s", "Speedup", "Ordenado");
+    double tUnHilo = 0.0;
+    for (int hilos = 1; ; hilos *= 2) {
+        if (hilos > maxHilos) hilos = maxHilos;
+        iniciarPoolTareas(hilos);
+        semillaBench = 12345u; // Mismo desorden en cada corrida
+        for (int i = 0; i < numPedidos; i++) arreglo[i].idPedido = (int)aleatorioBench();
+        double inicio = omp_get_wtime();
+        quicksortPedidosParallel(arreglo, 0, numPedidos - 1);
+        double t = omp_get_wtime() - inicio;
+        bool ordenado = true;
+        for (int i = 1; i < numPedidos && ordenado; i++) ordenado = arreglo[i - 1].idPedido <= arreglo[i].idPedido;
+        if (hilos == 1) tUnHilo = t;
+        printf("%-10d %10.3f %12.0f %9.2fx %10s\n", hilos, t, numPedidos / t, tUnHilo / t, ordenado ? "si" : "NO");
+        if (hilos == maxHilos) break;
+    }
+
+    // Tandas de 64 tareas lanzadas y esperadas desde el hilo principal
+    enum { TANDA = 64, TANDAS = 4096 };
+    Tarea tareas[TANDA];
+    double inicio = omp_get_wtime();
+    for (int t = 0; t < TANDAS; t++) {
+        for (int i = 0; i < TANDA; i++) lanzarTarea(&tareas[i], tareaVaciaBench, NULL);
+        for (int i = 0; i < TANDA; i++) esperarTarea(&tareas[i]);
+    }
+    double tTareas = omp_get_wtime() - inicio;
+    printf("\nLanzar y esperar una tarea vacía (%d hilos): %.0f ns\n", hilosPoolTareas(),
+           tTareas / ((double)TANDA * TANDAS) * 1e9);
+
+    free(arreglo);
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Conexión del generador de carga, con las peticiones en vuelo en orden de envío.
+ */
+typedef struct {
+    int descriptor;
+    char entrada[65536];      ///< Respuestas recibidas sin procesar.
+    size_t longitudEntrada;
+    double *envios;           ///< Instante de envío de cada petición en vuelo (anillo de `profundidad`).
+    int primero;              ///< Petición en vuelo más antigua.
+    int enVuelo;
+    int lineasDatos;          ///< Líneas de datos que faltan de la respuesta actual.
+    bool exito;               ///< La respuesta actual empezó con OK.
+} ConexionBench;
+
+/**
+ * @brief Compara dos latencias para `qsort`.
+ */
+static int compararLatencias(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Conecta al socket del servidor, esperando a que el hijo empiece a escuchar.
+ * @return El descriptor, o -1 si el servidor no respondió en 10 s.
+ */
+static int conectarBench(void) {
+    struct sockaddr_un direccion = { .sun_family = AF_UNIX };
+    strcpy(direccion.sun_path, SOCKET_BENCH);
+    for (int intento = 0; intento < 1000; intento++) {
+        int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (descriptor >= 0 && connect(descriptor, (struct sockaddr *)&direccion, sizeof(direccion)) == 0) {
+            return descriptor;
+        }
+        if (descriptor >= 0) close(descriptor);
+        struct timespec espera = { 0, 10000000L };
+        nanosleep(&espera, NULL);
+    }
+    return -1;
+}
+
+/**
+ * @brief Envía peticiones hasta tener `profundidad` en vuelo o agotar las del escenario.
+ */
+static bool llenarConexionBench(ConexionBench *conexion, int profundidad, long long *restantes, int numPedidos,
+                                int *siguienteId) {
+    static const char *estados[] = { "Pendiente", "\"En Proceso\"", "Completado" };
+    char peticiones[256 * 80];
+    size_t longitud = 0;
+    double ahora = omp_get_wtime();
+    while (conexion->enVuelo < profundidad && *restantes > 0 && longitud + 80 < sizeof(peticiones)) {
+        unsigned int tipo = aleatorioBench() % 10;
+        int id = (int)(aleatorioBench() % (unsigned int)numPedidos) + 1;
+        if (tipo < 8) {
+            longitud += (size_t)sprintf(peticiones + longitud, "buscar pedido %d\n", id);
+        } else if (tipo == 8) {
+            longitud += (size_t)sprintf(peticiones + longitud, "actualizar pedido %d %s\n", id,
+                                        estados[aleatorioBench() % 3]);
+        } else {
+            longitud += (size_t)sprintf(peticiones + longitud, "agregar pedido %d %d 2024-05-01 Pendiente 1\n",
+                                        (*siguienteId)++, (int)(aleatorioBench() % (unsigned int)(numPedidos / 10 + 1)) + 1);
+        }
+        conexion->envios[(conexion->primero + conexion->enVuelo) % profundidad] = ahora;
+        conexion->enVuelo++;
+        (*restantes)--;
+    }
+    for (size_t enviado = 0; enviado < longitud;) {
+        ssize_t n = send(conexion->descriptor, peticiones + enviado, longitud - enviado, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        enviado += (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Lee las respuestas disponibles y anota la latencia de cada una.
+ * @return `false` si el servidor cerró la conexión.
+ */
+static bool leerRespuestasBench(ConexionBench *conexion, int profundidad, double *latencias, long long *numLatencias,
+                                long long *errores) {
+    ssize_t n = recv(conexion->descriptor, conexion->entrada + conexion->longitudEntrada,
+                     sizeof(conexion->entrada) - conexion->longitudEntrada, 0);
+    if (n <= 0) return n < 0 && errno == EINTR;
+    conexion->longitudEntrada += (size_t)n;
+    double ahora = omp_get_wtime();
+
+    char *inicio = conexion->entrada, *finDatos = conexion->entrada + conexion->longitudEntrada, *fin;
+    while ((fin = memchr(inicio, '\n', (size_t)(finDatos - inicio))) != NULL) {
+        if (conexion->lineasDatos > 0) {
+            conexion->lineasDatos--;
+        } else {
+            conexion->exito = strncmp(inicio, "OK ", 3) == 0;
+            if (strncmp(inicio, "OK ", 3) != 0 && strncmp(inicio, "NO_ENCONTRADO ", 14) != 0) (*errores)++;
+            char *espacio = memchr(inicio, ' ', (size_t)(fin - inicio));
+            conexion->lineasDatos = espacio ? atoi(espacio + 1) : 0;
+        }
+        if (conexion->lineasDatos == 0) {
+            latencias[(*numLatencias)++] = ahora - conexion->envios[conexion->primero];
+            conexion->primero = (conexion->primero + 1) % profundidad;
+            conexion->enVuelo--;
+        }
+        inicio = fin + 1;
+    }
+    conexion->longitudEntrada = (size_t)(finDatos - inicio);
+    memmove(conexion->entrada, inicio, conexion->longitudEntrada);
+    return true;
+}
+
+/**
+ * @brief Carga el servidor con `numPeticiones` peticiones repartidas entre las conexiones.
+ */
+static void cargarServidorBench(int numPedidos, int numConexiones, int profundidad, long long numPeticiones,
+                                int *siguienteId) {
+    ConexionBench *conexiones = calloc((size_t)numConexiones, sizeof(ConexionBench));
+    double *latencias = malloc((size_t)numPeticiones * sizeof(double));
+    int epoll = epoll_create1(0);
+    long long restantes = numPeticiones, numLatencias = 0, errores = 0;
+    bool correcto = conexiones && latencias && epoll >= 0;
+
+    for (int i = 0; correcto && i < numConexiones; i++) {
+        conexiones[i].descriptor = conectarBench();
+        conexiones[i].envios = malloc((size_t)profundidad * sizeof(double));
+        struct epoll_event evento = { .events = EPOLLIN, .data.ptr = &conexiones[i] };
+        correcto = conexiones[i].descriptor >= 0 && conexiones[i].envios &&
+                   epoll_ctl(epoll, EPOLL_CTL_ADD, conexiones[i].descriptor, &evento) == 0;
+    }
+
+    double inicio = omp_get_wtime();
+    for (int i = 0; correcto && i < numConexiones; i++) {
+        correcto = llenarConexionBench(&conexiones[i], profundidad, &restantes, numPedidos, siguienteId);
+    }
+    struct epoll_event eventos[64];
+    while (correcto && numLatencias < numPeticiones) {
+        int listos = epoll_wait(epoll, eventos, 64, 10000);
+        if (listos <= 0) {
+            correcto = listos < 0 && errno == EINTR;
+            continue;
+        }
+        for (int i = 0; correcto && i < listos; i++) {
+            ConexionBench *conexion = eventos[i].data.ptr;
+            correcto = leerRespuestasBench(conexion, profundidad, latencias, &numLatencias, &errores) &&
+                       llenarConexionBench(conexion, profundidad, &restantes, numPedidos, siguienteId);
+        }
+    }
+    double segundos = omp_get_wtime() - inicio;
+
+    if (correcto) {
+        qsort(latencias, (size_t)numLatencias, sizeof(double), compararLatencias);
+        printf("%10d %12d %12lld %14.0f %10.1f %10.1f %10.1f %10.1f %8lld\n", numConexiones, profundidad, numLatencias,
+               numLatencias / segundos, latencias[numLatencias / 2] * 1e6, latencias[numLatencias * 99 / 100] * 1e6,
+               latencias[numLatencias * 999 / 1000] * 1e6, latencias[numLatencias - 1] * 1e6, errores);
+    } else {
+        printf("Error: Se perdió la conexión con el servidor.\n");
+    }
+
+    for (int i = 0; conexiones && i < numConexiones; i++) {
+        if (conexiones[i].descriptor > 0) close(conexiones[i].descriptor);
+        free(conexiones[i].envios);
+    }
+    if (epoll >= 0) close(epoll);
+    free(conexiones);
+    free(latencias);
+}
+
+/**
+ * @brief Benchmark del servidor: peticiones por segundo y latencia con y sin pipelining.
+ * @param numPedidos Número de pedidos precargados (y de peticiones por escenario).
+ * @param numConexiones Conexiones simultáneas.
+ * @param profundidad Peticiones en vuelo por conexión en el escenario con pipelining.
+ */
+static void benchServidor(int numPedidos, int numConexiones, int profundidad) {
+    HashTable *alimentos = crearTablaHash();
+    ClientesHashTable *clientes = crearTablaClientes();
+    MenuHashTable *menus = crearTablaMenus();
+    PedidosHashTable *pedidos = crearTablaPedidos();
+    semillaBench = 12345u;
+    llenarTablas(alimentos, clientes, menus, pedidos, numPedidos);
+
+    fflush(stdout);
+    pid_t hijo = fork();
+    if (hijo == 0) { // El hijo atiende con su copia de las tablas
+        bool correcto = ejecutarServidor("unix:" SOCKET_BENCH, false, alimentos, clientes, menus, pedidos, NULL);
+        _exit(correcto ? 0 : 1);
+    }
+    if (hijo < 0) {
+        printf("Error: No se pudo iniciar el proceso del servidor.\n");
+    } else {
+        int siguienteId = numPedidos + 1;
+        printf("\n%10s %12s %12s %14s %10s %10s %10s %10s %8s\n", "Conexiones", "Profundidad", "Peticiones",
+               "Peticiones/s", "p50 (µs)", "p99 (µs)", "p99.9 (µs)", "Máx (µs)", "Errores");
+        cargarServidorBench(numPedidos, numConexiones, 1, numPedidos, &siguienteId);
+        cargarServidorBench(numPedidos, numConexiones, profundidad, numPedidos, &siguienteId);
+
+        int descriptor = conectarBench();
+        if (descriptor >= 0) {
+            send(descriptor, "apagar\n", 7, MSG_NOSIGNAL);
+            char respuesta[16];
+            recv(descriptor, respuesta, sizeof(respuesta), 0);
+            close(descriptor);
+        } else {
+            kill(hijo, SIGTERM);
+        }
+        waitpid(hijo, NULL, 0);
+    }
+
+    liberarTablaPedidos(pedidos);
+    liberarTablaMenus(menus);
+    liberarTablaClientes(clientes);
+    liberarTabla(alimentos);
+}
+
+#endif
+
+/**
+ * @brief Punto de entrada de los benchmarks.
+ * @return 0 si el benchmark se ejecutó, 1 si los argumentos no son válidos.
+ */
+int main(int argc, char *argv[]) {
+    mensajesActivos = false;
+
+    if (argc >= 2 && strcmp(argv[1], "serializacion") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchSerializacion(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "snapshot") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchSnapshot(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "deserializacion") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchDeserializacion(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "bitacora") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchBitacora(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "delta") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchDelta(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "menus") == 0) {
+        int numMenus = argc >= 3 ? atoi(argv[2]) : 100000;
+        benchMenus(numMenus > 0 ? numMenus : 100000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "fondo") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchFondo(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "integridad") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchIntegridad(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "importacion") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchImportacion(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "tareas") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchTareas(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "tablas") == 0) {
+        int tamanoMaximo = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int repeticiones = argc >= 4 ? atoi(argv[3]) : 5;
+        benchTablas(tamanoMaximo >= 1000 ? tamanoMaximo : 1000000, repeticiones > 0 ? repeticiones : 5,
+                    argc >= 5 ? argv[4] : CSV_TABLAS_BENCH);
+        return 0;
+    }
+
+    if (argc >= 4 && strcmp(argv[1], "comparar") == 0) {
+        compararTablasBench(argv[2], argv[3]);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "generacion") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchGeneracion(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "totales") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchTotales(numPedidos > 0 ? numPedidos : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "reportes") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 10000000;
+        benchReportes(numPedidos > 0 ? numPedidos : 10000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "fechas") == 0) {
+        int numFechas = argc >= 3 ? atoi(argv[2]) : 10000000;
+        benchFechas(numFechas > 0 ? numFechas : 10000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "cadenas") == 0) {
+        int numClientes = argc >= 3 ? atoi(argv[2]) : 1000000;
+        benchCadenas(numClientes > 0 ? numClientes : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "indice") == 0) {
+        int tamanoMaximo = argc >= 3 ? atoi(argv[2]) : 10000000;
+        benchIndice(tamanoMaximo > 0 ? tamanoMaximo : 10000000);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "cocina") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 200000;
+        int microsPorMenu = argc >= 4 ? atoi(argv[3]) : 0;
+        benchCocina(numPedidos > 0 ? numPedidos : 200000, microsPorMenu > 0 ? microsPorMenu : 0);
+        return 0;
+    }
+
+#ifdef __linux__
+    if (argc >= 2 && strcmp(argv[1], "servidor") == 0) {
+        int numPedidos = argc >= 3 ? atoi(argv[2]) : 200000;
+        int numConexiones = argc >= 4 ? atoi(argv[3]) : 8;
+        int profundidad = argc >= 5 ? atoi(argv[4]) : 32;
+        benchServidor(numPedidos > 0 ? numPedidos : 200000, numConexiones > 0 ? numConexiones : 8,
+                      profundidad > 0 ? profundidad : 32);
+        return 0;
+    }
+#endif
+
+    printf("Uso: %s serializacion|snapshot|deserializacion|bitacora|delta|fondo|integridad|importacion|tareas [numPedidos]\n", argv[0]);
+    printf("     %s menus [numMenus]\n", argv[0]);
+    printf("     %s servidor [numPedidos] [conexiones] [profundidad]\n", argv[0]);
+    printf("     %s cocina [numPedidos] [microsPorMenu]\n", argv[0]);
+    printf("     %s tablas [tamanoMaximo] [repeticiones] [archivo.csv]\n", argv[0]);
+    printf("     %s comparar base.csv nuevo.csv\n", argv[0]);
+    printf("     %s generacion [numPedidos]\n", argv[0]);
+    printf("     %s totales [numPedidos]\n", argv[0]);
+    printf("     %s reportes [numPedidos]\n", argv[0]);
+    printf("     %s fechas [numFechas]\n", argv[0]);
+    printf("     %s cadenas [numClientes]\n", argv[0]);
+    printf("     %s indice [tamanoMaximo]\n", argv[0]);
+    return 1;
+}
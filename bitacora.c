@@ -0,0 +1,531 @@
+/**
+ * @file bitacora.c
+ * @brief Implementación de la bitácora de cambios con group commit, recuperación y compactación en segundo plano.
+ */
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#define _POSIX_C_SOURCE 200809L // truncate con -std=c99
+#include <unistd.h>
+#endif
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitacora.h"
+#include "snapshot_binario.h"
+#include "archivo_memoria.h"
+#include "mutaciones.h"
+#include "codificacion_mutaciones.h"
+
+/// Bytes pendientes a partir de los cuales las operaciones esperan a que el escritor los tome.
+#define BITACORA_LIMITE_PENDIENTE (8u << 20)
+
+/**
+ * @brief Estado de la bitácora activa.
+ *
+ * `candado` protege el buffer pendiente, los contadores y las banderas; el archivo
+ * activo solo lo usa el hilo escritor mientras la bitácora está abierta.
+ */
+static struct {
+    bool activa;                  ///< `true` entre `iniciarBitacora` y `cerrarBitacora`.
+    char nombreSnapshot[512];     ///< `<base>.snap`.
+    char nombreActiva[512];       ///< `<base>.bitacora`.
+    char nombreAnterior[512];     ///< `<base>.bitacora.anterior`.
+    TablasMutacion tablas;        ///< Tablas en uso.
+    FILE *archivo;                ///< Bitácora activa.
+    uint64_t generacion;          ///< Generación de la bitácora activa.
+    uint64_t tamanoArchivo;       ///< Bytes escritos en la bitácora activa.
+    pthread_t escritor;           ///< Hilo que escribe y sincroniza los lotes.
+    pthread_mutex_t candado;
+    pthread_cond_t hayPendientes; ///< Avisa al escritor que hay registros por escribir.
+    pthread_cond_t avance;        ///< Avisa que un lote se tomó o quedó en disco.
+    char *pendiente;              ///< Registros anotados que el escritor aún no toma.
+    size_t usados;                ///< Bytes usados de `pendiente`.
+    size_t capacidad;             ///< Capacidad de `pendiente`.
+    uint64_t anotados;            ///< Bytes anotados desde que se abrió la bitácora.
+    uint64_t durables;            ///< Bytes anotados que ya están en disco.
+    bool terminar;                ///< Pide al escritor que termine cuando no queden pendientes.
+    bool error;                   ///< Hubo un error de escritura; ya no se registra nada.
+    bool hayAnterior;             ///< Existe una bitácora anterior sin compactar.
+    uint64_t generacionAnterior;  ///< Generación de la bitácora anterior.
+    bool compactorIniciado;       ///< Hay un hilo compactor que todavía no se unió.
+    pthread_t compactor;          ///< Hilo que construye el snapshot nuevo.
+} bitacora = { .candado = PTHREAD_MUTEX_INITIALIZER, .hayPendientes = PTHREAD_COND_INITIALIZER,
+               .avance = PTHREAD_COND_INITIALIZER };
+
+/**
+ * @brief Obtiene el tamaño de un archivo.
+ * @param nombreArchivo Nombre del archivo.
+ * @return Tamaño en bytes, o -1 si no existe o no se puede abrir.
+ */
+static long long tamanoEnDisco(const char *nombreArchivo) {
+    FILE *archivo = fopen(nombreArchivo, "rb");
+    if (!archivo) return -1;
+    long long tamano = fseek(archivo, 0, SEEK_END) == 0 ? (long long)ftell(archivo) : -1;
+    fclose(archivo);
+    return tamano;
+}
+
+/**
+ * @brief Reproduce una bitácora sobre las tablas.
+ *
+ * Si la generación de la bitácora es menor que `generacionMinima`, sus cambios ya están
+ * en el snapshot y no se aplica nada.
+ *
+ * @param nombreArchivo Nombre de la bitácora.
+ * @param tablas Tablas destino.
+ * @param generacionMinima Generación del snapshot cargado.
+ * @param generacion Generación de la bitácora (de salida).
+ * @param aplicados Número de cambios aplicados (de salida).
+ * @param longitudValida Bytes desde el inicio hasta el final del último cambio válido (de salida).
+ * @return `true` si se leyó la bitácora, `false` si no es válida o no hubo memoria.
+ */
+static bool reproducirBitacora(const char *nombreArchivo, const TablasMutacion *tablas, uint64_t generacionMinima,
+                               uint64_t *generacion, uint64_t *aplicados, uint64_t *longitudValida) {
+    ArchivoEnMemoria archivo;
+    if (!abrirArchivoEnMemoria(nombreArchivo, &archivo)) {
+        printf("\nError: No se pudo abrir la bitácora '%s'.\n", nombreArchivo);
+        return false;
+    }
+    const EncabezadoBitacora *encabezado = (const EncabezadoBitacora *)archivo.datos;
+    if (archivo.tamano < sizeof(EncabezadoBitacora) || memcmp(encabezado->magia, BITACORA_MAGIA, sizeof(encabezado->magia)) != 0 ||
+        encabezado->version != BITACORA_VERSION || encabezado->marcaOrden != SNAPSHOT_MARCA_ORDEN) {
+        printf("\nError: '%s' no es una bitácora válida de esta versión.\n", nombreArchivo);
+        cerrarArchivoEnMemoria(&archivo);
+        return false;
+    }
+
+    *generacion = encabezado->generacion;
+    *aplicados = 0;
+    size_t posicion = sizeof(EncabezadoBitacora);
+    bool correcto = true;
+    if (encabezado->generacion >= generacionMinima) {
+        size_t longitud;
+        while ((longitud = leerMutacion(archivo.datos + posicion, archivo.tamano - posicion)) > 0) {
+            if (!aplicarMutacion(tablas, archivo.datos + posicion)) {
+                printf("\nError: No hay memoria suficiente para reproducir la bitácora '%s'.\n", nombreArchivo);
+                correcto = false;
+                break;
+            }
+            (*aplicados)++;
+            posicion += longitud;
+        }
+        // Si quedaron bytes, la última escritura se interrumpió: lo que sigue se descarta
+    }
+    *longitudValida = posicion;
+    cerrarArchivoEnMemoria(&archivo);
+    return correcto;
+}
+
+/**
+ * @brief Corta un archivo a una longitud.
+ * @param nombreArchivo Nombre del archivo.
+ * @param longitud Nueva longitud.
+ * @return `true` si se cortó, `false` en caso contrario.
+ */
+static bool truncarArchivo(const char *nombreArchivo, uint64_t longitud) {
+#ifdef _WIN32
+    FILE *archivo = fopen(nombreArchivo, "r+b");
+    if (!archivo) return false;
+    bool correcto = _chsize_s(_fileno(archivo), (long long)longitud) == 0 && sincronizarArchivo(archivo);
+    fclose(archivo);
+    return correcto;
+#else
+    return truncate(nombreArchivo, (off_t)longitud) == 0;
+#endif
+}
+
+/**
+ * @brief Crea una bitácora vacía, reemplazando de forma atómica la que hubiera con ese nombre.
+ * @param nombreArchivo Nombre de la bitácora.
+ * @param generacion Generación que se anota en el encabezado.
+ * @return Archivo abierto para agregar cambios, o `NULL` en caso de error.
+ */
+static FILE *crearBitacora(const char *nombreArchivo, uint64_t generacion) {
+    char temporal[520];
+    snprintf(temporal, sizeof(temporal), "%s.tmp", nombreArchivo);
+    FILE *archivo = fopen(temporal, "wb");
+    if (!archivo) return NULL;
+
+    EncabezadoBitacora encabezado;
+    memset(&encabezado, 0, sizeof(encabezado));
+    memcpy(encabezado.magia, BITACORA_MAGIA, sizeof(encabezado.magia));
+    encabezado.version = BITACORA_VERSION;
+    encabezado.marcaOrden = SNAPSHOT_MARCA_ORDEN;
+    encabezado.generacion = generacion;
+    bool correcto = fwrite(&encabezado, sizeof(encabezado), 1, archivo) == 1 && sincronizarArchivo(archivo);
+    if (fclose(archivo) != 0 || !correcto || !reemplazarArchivo(temporal, nombreArchivo)) {
+        remove(temporal);
+        return NULL;
+    }
+    archivo = fopen(nombreArchivo, "ab");
+    if (archivo) setvbuf(archivo, NULL, _IONBF, 0); // Los lotes ya llegan armados
+    return archivo;
+}
+
+/**
+ * @brief Construye el snapshot siguiente a partir del snapshot en disco y la bitácora anterior.
+ *
+ * Trabaja sobre tablas propias, así que las tablas en uso se siguen modificando mientras
+ * tanto. Si termina bien, la bitácora anterior se borra.
+ *
+ * @param argumento No se usa.
+ * @return Siempre `NULL`.
+ */
+static void *hiloCompactor(void *argumento) {
+    (void)argumento;
+    TablasMutacion tablas = { crearTablaHash(), crearTablaClientes(), crearTablaMenus(), crearTablaPedidos() };
+    uint64_t generacionSnapshot = 0, generacion, aplicados, longitudValida;
+    bool correcto = (tamanoEnDisco(bitacora.nombreSnapshot) < 0 ||
+                     cargarSnapshotBinarioGeneracion(bitacora.nombreSnapshot, tablas.alimentos, tablas.clientes,
+                                                     tablas.menus, tablas.pedidos, &generacionSnapshot)) &&
+                    reproducirBitacora(bitacora.nombreAnterior, &tablas, generacionSnapshot, &generacion, &aplicados, &longitudValida) &&
+                    guardarSnapshotBinarioGeneracion(bitacora.nombreSnapshot, tablas.alimentos, tablas.clientes,
+                                                     tablas.menus, tablas.pedidos, bitacora.generacionAnterior + 1);
+    liberarTabla(tablas.alimentos);
+    liberarTablaClientes(tablas.clientes);
+    liberarTablaMenus(tablas.menus);
+    liberarTablaPedidos(tablas.pedidos);
+
+    if (correcto) {
+        remove(bitacora.nombreAnterior);
+    } else {
+        printf("\nError: No se pudo compactar la bitácora '%s'; se reintentará al iniciar el programa.\n", bitacora.nombreAnterior);
+    }
+    pthread_mutex_lock(&bitacora.candado);
+    bitacora.hayAnterior = !correcto;
+    pthread_mutex_unlock(&bitacora.candado);
+    return NULL;
+}
+
+/**
+ * @brief Lanza el hilo compactor para la bitácora anterior.
+ *
+ * Debe llamarse con `candado` tomado (o antes de iniciar el escritor).
+ */
+static void lanzarCompactor(void) {
+    if (bitacora.compactorIniciado) {
+        pthread_join(bitacora.compactor, NULL);
+        bitacora.compactorIniciado = false;
+    }
+    bitacora.compactorIniciado = pthread_create(&bitacora.compactor, NULL, hiloCompactor, NULL) == 0;
+}
+
+/**
+ * @brief Cierra la bitácora activa, la convierte en la anterior y abre una nueva con la generación siguiente.
+ *
+ * La llama el hilo escritor con `candado` tomado, entre dos lotes.
+ *
+ * @return `true` si hay una bitácora activa nueva, `false` si hubo un error.
+ */
+static bool rotarBitacora(void) {
+    if (fclose(bitacora.archivo) != 0 || !reemplazarArchivo(bitacora.nombreActiva, bitacora.nombreAnterior)) {
+        bitacora.archivo = fopen(bitacora.nombreActiva, "ab");
+        if (bitacora.archivo) setvbuf(bitacora.archivo, NULL, _IONBF, 0);
+        return bitacora.archivo != NULL;
+    }
+    bitacora.hayAnterior = true;
+    bitacora.generacionAnterior = bitacora.generacion;
+    bitacora.archivo = crearBitacora(bitacora.nombreActiva, bitacora.generacion + 1);
+    if (!bitacora.archivo) return false;
+    bitacora.generacion++;
+    bitacora.tamanoArchivo = sizeof(EncabezadoBitacora);
+    lanzarCompactor();
+    return true;
+}
+
+/**
+ * @brief Escribe los lotes de cambios pendientes, cada uno con un solo `fsync`.
+ *
+ * Mientras se escribe y sincroniza un lote, las operaciones siguen anotando cambios en
+ * el otro buffer; al terminar se toma todo lo acumulado como el lote siguiente.
+ *
+ * @param argumento No se usa.
+ * @return Siempre `NULL`.
+ */
+static void *hiloEscritor(void *argumento) {
+    (void)argumento;
+    char *lote = NULL;
+    size_t capacidadLote = 0;
+
+    pthread_mutex_lock(&bitacora.candado);
+    while (true) {
+        while (bitacora.usados == 0 && !bitacora.terminar) {
+            pthread_cond_wait(&bitacora.hayPendientes, &bitacora.candado);
+        }
+        if (bitacora.usados == 0) break;
+
+        // Intercambiar los buffers: el pendiente pasa a ser el lote y se sigue anotando en el otro
+        char *pendiente = bitacora.pendiente;
+        size_t usados = bitacora.usados, capacidad = bitacora.capacidad;
+        bitacora.pendiente = lote;
+        bitacora.capacidad = capacidadLote;
+        bitacora.usados = 0;
+        lote = pendiente;
+        capacidadLote = capacidad;
+        pthread_cond_broadcast(&bitacora.avance);
+        bool fallo = bitacora.error;
+        pthread_mutex_unlock(&bitacora.candado);
+
+        bool correcto = !fallo && fwrite(lote, 1, usados, bitacora.archivo) == usados && sincronizarArchivo(bitacora.archivo);
+
+        pthread_mutex_lock(&bitacora.candado);
+        if (correcto) {
+            bitacora.durables += usados;
+            bitacora.tamanoArchivo += usados;
+            if (bitacora.tamanoArchivo >= BITACORA_TAMANO_COMPACTACION && !bitacora.hayAnterior) {
+                correcto = rotarBitacora();
+            }
+        }
+        if (!correcto && !bitacora.error) {
+            bitacora.error = true;
+            printf("\nError: No se pudo escribir en la bitácora '%s'; los cambios siguientes no se guardarán.\n", bitacora.nombreActiva);
+        }
+        pthread_cond_broadcast(&bitacora.avance);
+    }
+    pthread_mutex_unlock(&bitacora.candado);
+    free(lote);
+    return NULL;
+}
+
+/**
+ * @brief Anota un cambio para el siguiente lote (observador de mutaciones.h).
+ *
+ * No espera a que el cambio llegue al disco; para eso está `confirmarBitacora`. Solo
+ * espera si el buffer pendiente superó BITACORA_LIMITE_PENDIENTE.
+ *
+ * @param tipo Tipo de cambio.
+ * @param nodo Nodo con el contenido nuevo, o `NULL` al quitar.
+ * @param id ID del registro afectado.
+ */
+static void anotarMutacion(TipoMutacion tipo, const void *nodo, int id) {
+    uint32_t espacio[(TAMANO_MAXIMO_MUTACION + 3) / 4]; // Alineado para los registros
+    size_t longitud = codificarMutacion(tipo, nodo, id, (unsigned char *)espacio);
+
+    pthread_mutex_lock(&bitacora.candado);
+    while (bitacora.usados >= BITACORA_LIMITE_PENDIENTE && !bitacora.error) {
+        pthread_cond_wait(&bitacora.avance, &bitacora.candado);
+    }
+    if (!bitacora.error && bitacora.usados + longitud > bitacora.capacidad) {
+        size_t capacidad = bitacora.capacidad ? bitacora.capacidad * 2 : 64 * 1024;
+        char *pendiente = (char *)realloc(bitacora.pendiente, capacidad);
+        if (pendiente) {
+            bitacora.pendiente = pendiente;
+            bitacora.capacidad = capacidad;
+        } else {
+            bitacora.error = true;
+            printf("\nError: No hay memoria para la bitácora; los cambios siguientes no se guardarán.\n");
+        }
+    }
+    if (!bitacora.error) {
+        memcpy(bitacora.pendiente + bitacora.usados, espacio, longitud);
+        bitacora.usados += longitud;
+        bitacora.anotados += longitud;
+        pthread_cond_signal(&bitacora.hayPendientes);
+    }
+    pthread_mutex_unlock(&bitacora.candado);
+}
+
+/**
+ * @brief Empieza a registrar cambios en un archivo de bitácora ya abierto.
+ * @param archivo Bitácora activa, abierta para agregar.
+ * @param generacion Generación de la bitácora.
+ * @param tamanoArchivo Bytes que ya tiene la bitácora.
+ * @return `true` si el hilo escritor quedó en marcha.
+ */
+static bool arrancarBitacora(FILE *archivo, uint64_t generacion, uint64_t tamanoArchivo) {
+    bitacora.archivo = archivo;
+    bitacora.generacion = generacion;
+    bitacora.tamanoArchivo = tamanoArchivo;
+    bitacora.anotados = bitacora.durables = 0;
+    bitacora.usados = 0;
+    bitacora.terminar = bitacora.error = false;
+    if (pthread_create(&bitacora.escritor, NULL, hiloEscritor, NULL) != 0) {
+        fclose(archivo);
+        return false;
+    }
+    bitacora.activa = true;
+    observadorMutaciones = anotarMutacion;
+    return true;
+}
+
+/**
+ * @brief Recupera los datos guardados y empieza a registrar los cambios en la bitácora.
+ * @param nombreBase Nombre base de los archivos.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si la bitácora quedó activa, `false` en caso contrario.
+ */
+bool iniciarBitacora(const char *nombreBase, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                     MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    if (bitacora.activa) return true;
+    if (strlen(nombreBase) + sizeof(".bitacora.anterior") > sizeof(bitacora.nombreAnterior)) {
+        printf("\nError: El nombre base '%s' es demasiado largo.\n", nombreBase);
+        return false;
+    }
+    snprintf(bitacora.nombreSnapshot, sizeof(bitacora.nombreSnapshot), "%s.snap", nombreBase);
+    snprintf(bitacora.nombreActiva, sizeof(bitacora.nombreActiva), "%s.bitacora", nombreBase);
+    snprintf(bitacora.nombreAnterior, sizeof(bitacora.nombreAnterior), "%s.bitacora.anterior", nombreBase);
+    TablasMutacion tablas = { tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos };
+    bitacora.tablas = tablas;
+    prepararCodificacionMutaciones();
+
+    // 1. Snapshot: ya incluye las bitácoras con generación menor que la suya
+    uint64_t generacionSnapshot = 0, recuperados = 0;
+    if (tamanoEnDisco(bitacora.nombreSnapshot) >= 0 &&
+        !cargarSnapshotBinarioGeneracion(bitacora.nombreSnapshot, tablaAlimentos, tablaClientes, tablaMenus,
+                                         tablaPedidos, &generacionSnapshot)) {
+        return false;
+    }
+
+    // 2. Bitácora anterior: quedó sin compactar si el programa terminó durante la compactación
+    uint64_t generacion, aplicados, longitudValida;
+    bitacora.hayAnterior = false;
+    if (tamanoEnDisco(bitacora.nombreAnterior) >= 0) {
+        if (!reproducirBitacora(bitacora.nombreAnterior, &tablas, generacionSnapshot, &generacion, &aplicados, &longitudValida)) {
+            return false;
+        }
+        if (generacion < generacionSnapshot) {
+            remove(bitacora.nombreAnterior);
+        } else {
+            bitacora.hayAnterior = true;
+            bitacora.generacionAnterior = generacion;
+            recuperados += aplicados;
+        }
+    }
+
+    // 3. Bitácora activa: se descarta su final incompleto y se sigue escribiendo en ella
+    uint64_t generacionActiva = bitacora.hayAnterior ? bitacora.generacionAnterior + 1 : generacionSnapshot;
+    long long tamano = tamanoEnDisco(bitacora.nombreActiva);
+    FILE *archivo = NULL;
+    uint64_t tamanoActiva = sizeof(EncabezadoBitacora);
+    if (tamano >= (long long)sizeof(EncabezadoBitacora)) {
+        if (!reproducirBitacora(bitacora.nombreActiva, &tablas, generacionSnapshot, &generacion, &aplicados, &longitudValida)) {
+            return false;
+        }
+        if (generacion >= generacionSnapshot) {
+            recuperados += aplicados;
+            if (longitudValida < (uint64_t)tamano) {
+                printf("\nAdvertencia: Se descartaron %llu bytes incompletos al final de la bitácora '%s'.\n",
+                       (unsigned long long)((uint64_t)tamano - longitudValida), bitacora.nombreActiva);
+                if (!truncarArchivo(bitacora.nombreActiva, longitudValida)) {
+                    printf("\nError: No se pudo recortar la bitácora '%s'.\n", bitacora.nombreActiva);
+                    return false;
+                }
+            }
+            archivo = fopen(bitacora.nombreActiva, "ab");
+            if (archivo) setvbuf(archivo, NULL, _IONBF, 0);
+            generacionActiva = generacion;
+            tamanoActiva = longitudValida;
+        }
+    }
+    if (!archivo) {
+        archivo = crearBitacora(bitacora.nombreActiva, generacionActiva); // Sin bitácora, vacía u obsoleta
+    }
+    if (!archivo) {
+        printf("\nError: No se pudo abrir la bitácora '%s' para escritura.\n", bitacora.nombreActiva);
+        return false;
+    }
+
+    if (generacionSnapshot > 0 || recuperados > 0) {
+        printf("\nDatos recuperados: %d alimentos, %d clientes, %d menús y %d pedidos (%llu cambios de la bitácora).\n",
+               tablaAlimentos->numAlimentos, tablaClientes->numClientes, tablaMenus->numMenus, tablaPedidos->numPedidos,
+               (unsigned long long)recuperados);
+    }
+    if (!arrancarBitacora(archivo, generacionActiva, tamanoActiva)) {
+        printf("\nError: No se pudo iniciar el hilo de escritura de la bitácora.\n");
+        return false;
+    }
+    if (bitacora.hayAnterior) {
+        pthread_mutex_lock(&bitacora.candado);
+        lanzarCompactor();
+        pthread_mutex_unlock(&bitacora.candado);
+    }
+    return true;
+}
+
+/**
+ * @brief Espera a que todos los cambios registrados hasta ahora estén en disco.
+ * @return `true` si quedaron en disco (o la bitácora no está activa), `false` si hubo un error de escritura.
+ */
+bool confirmarBitacora(void) {
+    if (!bitacora.activa) return true;
+    pthread_mutex_lock(&bitacora.candado);
+    uint64_t objetivo = bitacora.anotados;
+    while (bitacora.durables < objetivo && !bitacora.error) {
+        pthread_cond_wait(&bitacora.avance, &bitacora.candado);
+    }
+    bool correcto = !bitacora.error;
+    pthread_mutex_unlock(&bitacora.candado);
+    return correcto;
+}
+
+/**
+ * @brief Detiene el escritor (después de escribir lo pendiente) y el compactor.
+ */
+static void detenerBitacora(void) {
+    observadorMutaciones = NULL;
+    pthread_mutex_lock(&bitacora.candado);
+    bitacora.terminar = true;
+    pthread_cond_signal(&bitacora.hayPendientes);
+    pthread_mutex_unlock(&bitacora.candado);
+    pthread_join(bitacora.escritor, NULL);
+    if (bitacora.archivo) fclose(bitacora.archivo);
+    bitacora.archivo = NULL;
+    if (bitacora.compactorIniciado) {
+        pthread_join(bitacora.compactor, NULL);
+        bitacora.compactorIniciado = false;
+    }
+    free(bitacora.pendiente);
+    bitacora.pendiente = NULL;
+    bitacora.capacidad = 0;
+    bitacora.activa = false;
+}
+
+/**
+ * @brief Guarda el contenido actual de las tablas como snapshot y empieza una bitácora vacía.
+ * @return `true` si el snapshot quedó guardado, `false` en caso contrario.
+ */
+bool puntoDeControlBitacora(void) {
+    if (!bitacora.activa) return true;
+    detenerBitacora();
+    uint64_t generacion = bitacora.generacion, tamanoArchivo = bitacora.tamanoArchivo;
+
+    // El snapshot nuevo incluye la bitácora activa, así que recibe la generación siguiente
+    TablasMutacion *tablas = &bitacora.tablas;
+    bool guardado = guardarSnapshotBinarioGeneracion(bitacora.nombreSnapshot, tablas->alimentos, tablas->clientes,
+                                                     tablas->menus, tablas->pedidos, generacion + 1);
+    FILE *archivo;
+    if (guardado) {
+        remove(bitacora.nombreAnterior);
+        bitacora.hayAnterior = false;
+        generacion++;
+        tamanoArchivo = sizeof(EncabezadoBitacora);
+        archivo = crearBitacora(bitacora.nombreActiva, generacion);
+    } else {
+        archivo = fopen(bitacora.nombreActiva, "ab");
+        if (archivo) setvbuf(archivo, NULL, _IONBF, 0);
+    }
+    if (!archivo || !arrancarBitacora(archivo, generacion, tamanoArchivo)) {
+        printf("\nError: No se pudo reabrir la bitácora '%s'; los cambios siguientes no se guardarán.\n", bitacora.nombreActiva);
+        return false;
+    }
+    if (bitacora.hayAnterior) {
+        pthread_mutex_lock(&bitacora.candado);
+        lanzarCompactor();
+        pthread_mutex_unlock(&bitacora.candado);
+    }
+    return guardado;
+}
+
+/**
+ * @brief Lleva al disco los cambios pendientes, espera a la compactación en curso y deja de registrar.
+ */
+void cerrarBitacora(void) {
+    if (bitacora.activa) detenerBitacora();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file bitacora.h
+ * @brief Bitácora de cambios (write-ahead log) para no perder lo hecho entre dos guardados.
+ *
+ * Cada agregar, actualizar o eliminar exitoso (ver mutaciones.h) se añade como un
+ * registro binario al final de la bitácora. Un hilo escritor toma de una vez todos los
+ * registros pendientes y los lleva al disco con un solo `fsync` (group commit): mientras
+ * sincroniza un lote se acumula el siguiente, así que muchas operaciones comparten el
+ * costo de una sincronización.
+ *
+ * Archivos usados, todos con el mismo nombre base:
+ *
+ *     <base>.snap               snapshot binario (ver snapshot_binario.h)
+ *     <base>.bitacora           bitácora activa
+ *     <base>.bitacora.anterior  bitácora cerrada que se está compactando
+ *
+ * Cada bitácora anota una generación en su encabezado y el snapshot de generación G
+ * ya incluye todas las bitácoras con generación menor que G. Al iniciar se carga el
+ * snapshot y se reproducen en orden las bitácoras con generación G o mayor.
+ *
+ * Cuando la bitácora activa supera BITACORA_TAMANO_COMPACTACION, pasa a ser la anterior,
+ * se abre una nueva con la generación siguiente y un hilo aparte construye el snapshot
+ * nuevo a partir del snapshot y la bitácora anteriores, sin tocar las tablas en uso.
+ *
+ * Formato de la bitácora (enteros en el orden de bytes de la máquina que la generó):
+ *
+ *     EncabezadoBitacora
+ *     EncabezadoMutacion + contenido
+ *     EncabezadoMutacion + contenido
+ *     ...
+ *
+ * Los cambios se codifican como se describe en codificacion_mutaciones.h. Lo que sigue al
+ * primer registro incompleto o con suma de verificación incorrecta (una escritura
+ * interrumpida) se descarta.
+ */
+
+#ifndef BITACORA_H
+#define BITACORA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Firma de los primeros 8 bytes de la bitácora.
+#define BITACORA_MAGIA "EDAIIBIT"
+
+/// Versión actual del formato; las bitácoras con otra versión se rechazan.
+#define BITACORA_VERSION 2
+
+/// Tamaño de la bitácora activa a partir del cual se compacta en un snapshot nuevo.
+#define BITACORA_TAMANO_COMPACTACION (64u << 20)
+
+/**
+ * @brief Encabezado al inicio de la bitácora.
+ */
+typedef struct {
+    char magia[8];        ///< BITACORA_MAGIA (sin terminador).
+    uint32_t version;     ///< BITACORA_VERSION.
+    uint32_t marcaOrden;  ///< SNAPSHOT_MARCA_ORDEN.
+    uint64_t generacion;  ///< Generación de la bitácora.
+} EncabezadoBitacora;
+
+/**
+ * @brief Recupera los datos guardados y empieza a registrar los cambios en la bitácora.
+ *
+ * Carga `<base>.snap` (si existe) en las tablas, que deben estar vacías, reproduce las
+ * bitácoras pendientes y descarta el final incompleto de la activa. Si la recuperación
+ * falla, las tablas pueden quedar con datos parciales y no se registra nada.
+ *
+ * @param nombreBase Nombre base de los archivos.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si la bitácora quedó activa, `false` en caso contrario.
+ */
+bool iniciarBitacora(const char *nombreBase, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                     MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Espera a que todos los cambios registrados hasta ahora estén en disco.
+ * @return `true` si quedaron en disco (o la bitácora no está activa), `false` si hubo un error de escritura.
+ */
+bool confirmarBitacora(void);
+
+/**
+ * @brief Guarda el contenido actual de las tablas como snapshot y empieza una bitácora vacía.
+ *
+ * Se usa después de reemplazar todas las tablas (por ejemplo, al cargar un archivo),
+ * porque esa carga no pasa por la bitácora.
+ *
+ * @return `true` si el snapshot quedó guardado, `false` en caso contrario.
+ */
+bool puntoDeControlBitacora(void);
+
+/**
+ * @brief Lleva al disco los cambios pendientes, espera a la compactación en curso y deja de registrar.
+ */
+void cerrarBitacora(void);
+
+#endif // BITACORA_H
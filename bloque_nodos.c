@@ -0,0 +1,75 @@
+/**
+ * @file bloque_nodos.c
+ * @brief Reserva y liberación del bloque de nodos de una tabla.
+ */
+
+#ifndef _WIN32
+#define _DEFAULT_SOURCE // mmap anónimo y MADV_HUGEPAGE con -std=c99
+#include <sys/mman.h>
+#endif
+
+#include "bloque_nodos.h"
+
+/**
+ * @brief Deja el bloque vacío e indica cómo se cuentan los nodos de la tabla.
+ * @param bloque Bloque de la tabla.
+ * @param subsistema Subsistema de la tabla.
+ * @param tamanoNodo Tamaño de cada nodo.
+ */
+void iniciarBloqueNodos(BloqueNodos *bloque, SubsistemaMemoria subsistema, size_t tamanoNodo) {
+    bloque->inicio = NULL;
+    bloque->tamano = 0;
+    bloque->subsistema = subsistema;
+    bloque->tamanoNodo = tamanoNodo;
+}
+
+/**
+ * @brief Reserva un bloque para `numNodos` nodos de `tamanoNodo` bytes.
+ * @param bloque Bloque de la tabla (debe estar vacío).
+ * @param numNodos Número de nodos.
+ * @param tamanoNodo Tamaño de cada nodo.
+ * @return Puntero al primer nodo, o `NULL` si la tabla ya tenía bloque o no hubo memoria.
+ */
+void *reservarBloqueNodos(BloqueNodos *bloque, size_t numNodos, size_t tamanoNodo) {
+    if (bloque->inicio || numNodos == 0 || tamanoNodo > (size_t)-1 / numNodos) {
+        return NULL;
+    }
+    size_t tamano = numNodos * tamanoNodo;
+#ifdef _WIN32
+    char *inicio = (char *)malloc(tamano);
+#else
+    char *inicio = (char *)mmap(NULL, tamano, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((void *)inicio == MAP_FAILED) {
+        inicio = NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    if (inicio) {
+        madvise(inicio, tamano, MADV_HUGEPAGE); // Solo una sugerencia: si falla, se usan páginas normales
+    }
+#endif
+#endif
+    if (!inicio) {
+        return NULL;
+    }
+    bloque->inicio = inicio;
+    bloque->tamano = tamano;
+    contarReserva(bloque->subsistema, tamano);
+    return inicio;
+}
+
+/**
+ * @brief Devuelve la memoria del bloque; los nodos que estaban en él dejan de ser válidos.
+ * @param bloque Bloque de la tabla.
+ */
+void liberarBloqueNodos(BloqueNodos *bloque) {
+    if (bloque->inicio) {
+#ifdef _WIN32
+        free(bloque->inicio);
+#else
+        munmap(bloque->inicio, bloque->tamano);
+#endif
+        contarLiberacion(bloque->subsistema, bloque->tamano);
+    }
+    bloque->inicio = NULL;
+    bloque->tamano = 0;
+}
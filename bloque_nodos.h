@@ -0,0 +1,96 @@
+/**
+ * @file bloque_nodos.h
+ * @brief Bloque único de memoria para crear muchos nodos de una tabla de una sola vez.
+ *
+ * Al restaurar un snapshot se conocen de antemano cuántos registros tiene cada tabla,
+ * así que en lugar de un `malloc` por nodo se reserva un solo bloque y los nodos se
+ * toman de él. Los nodos del bloque no se liberan uno por uno: `liberarNodo` los
+ * ignora y la memoria se devuelve completa al vaciar la tabla.
+ *
+ * El bloque también sabe a qué subsistema y con qué tamaño se cuentan los nodos de la
+ * tabla (ver contabilidad_memoria.h): el bloque se cuenta completo al reservarlo, y los
+ * nodos sueltos, al enlazarlos (`adoptarNodo`) y al liberarlos (`liberarNodo`).
+ */
+
+#ifndef BLOQUE_NODOS_H
+#define BLOQUE_NODOS_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "contabilidad_memoria.h"
+
+/**
+ * @brief Región de memoria de la que se tomaron nodos de una tabla.
+ */
+typedef struct {
+    char *inicio;   ///< Primer byte del bloque, o `NULL` si la tabla no tiene bloque.
+    size_t tamano;  ///< Tamaño reservado en bytes.
+    SubsistemaMemoria subsistema; ///< Subsistema al que se cuentan el bloque y los nodos sueltos.
+    size_t tamanoNodo;            ///< Tamaño de cada nodo de la tabla.
+} BloqueNodos;
+
+/**
+ * @brief Deja el bloque vacío e indica cómo se cuentan los nodos de la tabla.
+ * @param bloque Bloque de la tabla.
+ * @param subsistema Subsistema de la tabla.
+ * @param tamanoNodo Tamaño de cada nodo.
+ */
+void iniciarBloqueNodos(BloqueNodos *bloque, SubsistemaMemoria subsistema, size_t tamanoNodo);
+
+/**
+ * @brief Reserva un bloque para `numNodos` nodos de `tamanoNodo` bytes.
+ *
+ * En Linux el bloque se pide con páginas grandes, lo que reduce el costo de los
+ * fallos de página al llenarlo. Solo puede haber un bloque por tabla.
+ *
+ * @param bloque Bloque de la tabla (debe estar vacío).
+ * @param numNodos Número de nodos.
+ * @param tamanoNodo Tamaño de cada nodo.
+ * @return Puntero al primer nodo, o `NULL` si la tabla ya tenía bloque o no hubo memoria.
+ */
+void *reservarBloqueNodos(BloqueNodos *bloque, size_t numNodos, size_t tamanoNodo);
+
+/**
+ * @brief Devuelve la memoria del bloque; los nodos que estaban en él dejan de ser válidos.
+ * @param bloque Bloque de la tabla.
+ */
+void liberarBloqueNodos(BloqueNodos *bloque);
+
+/**
+ * @brief Indica si un nodo pertenece al bloque.
+ * @param bloque Bloque de la tabla.
+ * @param nodo Nodo a verificar.
+ * @return `true` si el nodo está dentro del bloque.
+ */
+static inline bool nodoEnBloque(const BloqueNodos *bloque, const void *nodo) {
+    const char *p = (const char *)nodo;
+    return bloque->inicio && p >= bloque->inicio && p < bloque->inicio + bloque->tamano;
+}
+
+/**
+ * @brief Cuenta un nodo reservado con `malloc` que la tabla acaba de enlazar.
+ *
+ * Los nodos del bloque ya se contaron al reservarlo.
+ *
+ * @param bloque Bloque de la tabla.
+ * @param nodo Nodo enlazado.
+ */
+static inline void adoptarNodo(const BloqueNodos *bloque, const void *nodo) {
+    if (!nodoEnBloque(bloque, nodo)) {
+        contarReserva(bloque->subsistema, bloque->tamanoNodo);
+    }
+}
+
+/**
+ * @brief Libera un nodo con `free`, salvo que pertenezca al bloque de la tabla.
+ * @param bloque Bloque de la tabla.
+ * @param nodo Nodo a liberar (puede ser `NULL`).
+ */
+static inline void liberarNodo(const BloqueNodos *bloque, void *nodo) {
+    if (nodo && !nodoEnBloque(bloque, nodo)) {
+        contarLiberacion(bloque->subsistema, bloque->tamanoNodo);
+        free(nodo);
+    }
+}
+
+#endif // BLOQUE_NODOS_H
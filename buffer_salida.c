@@ -0,0 +1,240 @@
+/**
+ * @file buffer_salida.c
+ * @brief Implementación del buffer de salida y del formateo manual de números.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // fileno y writev con -std=c99
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "buffer_salida.h"
+
+/// Máximo de buffers que se entregan en una sola llamada a `writev` (menor que IOV_MAX en cualquier sistema).
+#define VECTORES_POR_ESCRITURA 64
+
+/// Pares de dígitos "00".."99" para convertir enteros de dos en dos.
+static const char DIGITOS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * @brief Inicializa un buffer de salida.
+ * @param buffer Buffer a inicializar.
+ * @param destino Archivo destino, o `NULL` para acumular todo en memoria.
+ * @param capacidad Capacidad inicial en bytes.
+ * @return `true` si se reservó la memoria, `false` en caso contrario.
+ */
+bool iniciarBufferSalida(BufferSalida *buffer, FILE *destino, size_t capacidad) {
+    if (capacidad < 64) capacidad = 64;
+    buffer->datos = (char *)malloc(capacidad);
+    buffer->longitud = 0;
+    buffer->capacidad = buffer->datos ? capacidad : 0;
+    buffer->destino = destino;
+    buffer->error = (buffer->datos == NULL);
+    return !buffer->error;
+}
+
+/**
+ * @brief Escribe en el archivo destino el contenido acumulado.
+ * @param buffer Buffer de salida.
+ * @return `true` si la escritura fue correcta (o no hay destino), `false` en caso contrario.
+ */
+bool vaciarBufferSalida(BufferSalida *buffer) {
+    if (!buffer->destino || buffer->longitud == 0) {
+        return !buffer->error;
+    }
+    if (fwrite(buffer->datos, 1, buffer->longitud, buffer->destino) != buffer->longitud) {
+        buffer->error = true;
+    }
+    buffer->longitud = 0;
+    return !buffer->error;
+}
+
+/**
+ * @brief Garantiza espacio para `longitud` bytes más, vaciando o ampliando el buffer.
+ * @param buffer Buffer de salida.
+ * @param longitud Bytes que se van a escribir.
+ * @return `true` si hay espacio disponible, `false` si ocurrió un error.
+ */
+bool reservarEnBufferSalida(BufferSalida *buffer, size_t longitud) {
+    if (buffer->error) return false;
+    if (buffer->capacidad - buffer->longitud >= longitud) return true;
+
+    if (buffer->destino) {
+        vaciarBufferSalida(buffer);
+        if (buffer->error) return false;
+        if (buffer->capacidad >= longitud) return true;
+    }
+
+    size_t capacidad = buffer->capacidad ? buffer->capacidad : 64;
+    while (capacidad - buffer->longitud < longitud) capacidad *= 2;
+    char *datos = (char *)realloc(buffer->datos, capacidad);
+    if (!datos) {
+        buffer->error = true;
+        return false;
+    }
+    buffer->datos = datos;
+    buffer->capacidad = capacidad;
+    return true;
+}
+
+/**
+ * @brief Vacía el buffer y libera su memoria.
+ * @param buffer Buffer de salida.
+ * @return `true` si no hubo errores durante la vida del buffer, `false` en caso contrario.
+ */
+bool liberarBufferSalida(BufferSalida *buffer) {
+    vaciarBufferSalida(buffer);
+    free(buffer->datos);
+    buffer->datos = NULL;
+    buffer->longitud = 0;
+    buffer->capacidad = 0;
+    return !buffer->error;
+}
+
+/**
+ * @brief Escribe un entero sin signo en decimal.
+ * @param buffer Buffer de salida.
+ * @param valor Entero a escribir.
+ */
+static void escribirSinSigno(BufferSalida *buffer, unsigned long long valor) {
+    char tmp[24];
+    char *fin = tmp + sizeof(tmp);
+    char *p = fin;
+
+    while (valor >= 100) {
+        unsigned int par = (unsigned int)(valor % 100) * 2;
+        valor /= 100;
+        *--p = DIGITOS[par + 1];
+        *--p = DIGITOS[par];
+    }
+    if (valor >= 10) {
+        unsigned int par = (unsigned int)valor * 2;
+        *--p = DIGITOS[par + 1];
+        *--p = DIGITOS[par];
+    } else {
+        *--p = (char)('0' + valor);
+    }
+    bufferEscribir(buffer, p, (size_t)(fin - p));
+}
+
+/**
+ * @brief Escribe un entero en decimal, equivalente a `%lld`.
+ * @param buffer Buffer de salida.
+ * @param valor Entero a escribir.
+ */
+void bufferEscribirEntero(BufferSalida *buffer, long long valor) {
+    if (valor < 0) {
+        bufferEscribirLiteral(buffer, "-");
+        escribirSinSigno(buffer, 0ULL - (unsigned long long)valor);
+    } else {
+        escribirSinSigno(buffer, (unsigned long long)valor);
+    }
+}
+
+/**
+ * @brief Escribe un número con dos decimales, equivalente a `%.2f`.
+ *
+ * Un `float` tiene 24 bits de mantisa, así que `valor * 100` es exacto en `double`
+ * y basta con redondear ese producto al entero par más cercano.
+ *
+ * @param buffer Buffer de salida.
+ * @param valor Número a escribir.
+ */
+void bufferEscribirDecimal2(BufferSalida *buffer, float valor) {
+    double v = valor;
+    if (!(v > -1e13 && v < 1e13)) { // NaN, infinito o magnitudes enormes: caso raro, se delega
+        char tmp[64];
+        int n = snprintf(tmp, sizeof(tmp), "%.2f", valor);
+        if (n > 0) bufferEscribir(buffer, tmp, (size_t)n < sizeof(tmp) ? (size_t)n : sizeof(tmp) - 1);
+        return;
+    }
+
+    if (signbit(v)) {
+        bufferEscribirLiteral(buffer, "-");
+        v = -v;
+    }
+
+    double centesimos = v * 100.0;
+    unsigned long long entero = (unsigned long long)centesimos;
+    double fraccion = centesimos - (double)entero;
+    if (fraccion > 0.5 || (fraccion == 0.5 && (entero & 1))) {
+        entero++;
+    }
+
+    escribirSinSigno(buffer, entero / 100);
+    unsigned int par = (unsigned int)(entero % 100) * 2;
+    char decimales[3] = { '.', DIGITOS[par], DIGITOS[par + 1] };
+    bufferEscribir(buffer, decimales, sizeof(decimales));
+}
+
+/**
+ * @brief Escribe en orden el contenido de varios buffers en memoria.
+ *
+ * En sistemas POSIX los buffers se entregan al kernel con `writev`, sin copiarlos
+ * a un bloque intermedio; las escrituras parciales se reanudan donde quedaron.
+ * En Windows se escriben uno tras otro con `fwrite`.
+ *
+ * @param archivo Archivo destino, abierto para escritura.
+ * @param buffers Buffers (sin destino) con el texto a escribir.
+ * @param numBuffers Número de buffers.
+ * @return `true` si se escribieron todos los bytes, `false` en caso contrario.
+ */
+bool escribirBuffersEnOrden(FILE *archivo, const BufferSalida *buffers, int numBuffers) {
+#ifdef _WIN32
+    for (int i = 0; i < numBuffers; i++) {
+        if (fwrite(buffers[i].datos, 1, buffers[i].longitud, archivo) != buffers[i].longitud) {
+            return false;
+        }
+    }
+    return true;
+#else
+    if (fflush(archivo) != 0) return false;
+    int fd = fileno(archivo);
+    struct iovec vectores[VECTORES_POR_ESCRITURA];
+    int actual = 0;          // Primer buffer con bytes pendientes
+    size_t yaEscritos = 0;   // Bytes del buffer actual que ya se escribieron
+
+    while (actual < numBuffers) {
+        int numVectores = 0;
+        for (int i = actual; i < numBuffers && numVectores < VECTORES_POR_ESCRITURA; i++) {
+            size_t desde = (i == actual) ? yaEscritos : 0;
+            if (buffers[i].longitud > desde) {
+                vectores[numVectores].iov_base = buffers[i].datos + desde;
+                vectores[numVectores].iov_len = buffers[i].longitud - desde;
+                numVectores++;
+            }
+        }
+        if (numVectores == 0) break; // Solo quedaban buffers vacíos
+
+        ssize_t escritos = writev(fd, vectores, numVectores);
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos <= 0) return false;
+
+        // Avanzar sobre los buffers que quedaron completos
+        size_t restantes = (size_t)escritos;
+        while (actual < numBuffers && restantes >= buffers[actual].longitud - yaEscritos) {
+            restantes -= buffers[actual].longitud - yaEscritos;
+            yaEscritos = 0;
+            actual++;
+        }
+        yaEscritos += restantes;
+    }
+    return true;
+#endif
+}
@@ -0,0 +1,120 @@
+/**
+ * @file buffer_salida.h
+ * @brief Buffer de salida para escribir texto sin `printf`: enteros y decimales se formatean a mano.
+ *
+ * El buffer acumula el texto en memoria y lo escribe al archivo en bloques grandes.
+ * Si no tiene archivo destino, crece según haga falta y conserva todo el texto
+ * en memoria (útil para formatear secciones por separado y escribirlas después).
+ */
+
+#ifndef BUFFER_SALIDA_H
+#define BUFFER_SALIDA_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+/// Tamaño por defecto del bloque que se escribe al archivo de una sola vez (1 MiB).
+#define BUFFER_SALIDA_TAMANO (1 << 20)
+
+/**
+ * @brief Buffer de salida con destino opcional.
+ */
+typedef struct {
+    char *datos;        ///< Texto acumulado.
+    size_t longitud;    ///< Bytes ocupados.
+    size_t capacidad;   ///< Bytes reservados.
+    FILE *destino;      ///< Archivo al que se vacía el buffer, o `NULL` para acumular en memoria.
+    bool error;         ///< `true` si falló una escritura o una reserva de memoria.
+} BufferSalida;
+
+/**
+ * @brief Inicializa un buffer de salida.
+ * @param buffer Buffer a inicializar.
+ * @param destino Archivo destino, o `NULL` para acumular todo en memoria.
+ * @param capacidad Capacidad inicial en bytes.
+ * @return `true` si se reservó la memoria, `false` en caso contrario.
+ */
+bool iniciarBufferSalida(BufferSalida *buffer, FILE *destino, size_t capacidad);
+
+/**
+ * @brief Garantiza espacio para `longitud` bytes más, vaciando o ampliando el buffer.
+ * @param buffer Buffer de salida.
+ * @param longitud Bytes que se van a escribir.
+ * @return `true` si hay espacio disponible, `false` si ocurrió un error.
+ */
+bool reservarEnBufferSalida(BufferSalida *buffer, size_t longitud);
+
+/**
+ * @brief Escribe en el archivo destino el contenido acumulado.
+ * @param buffer Buffer de salida.
+ * @return `true` si la escritura fue correcta (o no hay destino), `false` en caso contrario.
+ */
+bool vaciarBufferSalida(BufferSalida *buffer);
+
+/**
+ * @brief Vacía el buffer y libera su memoria.
+ * @param buffer Buffer de salida.
+ * @return `true` si no hubo errores durante la vida del buffer, `false` en caso contrario.
+ */
+bool liberarBufferSalida(BufferSalida *buffer);
+
+/**
+ * @brief Escribe en orden el contenido de varios buffers en memoria.
+ *
+ * Pensada para texto formateado en paralelo: cada hilo llena su propio buffer
+ * y después todos se escriben de una vez respetando el orden del arreglo.
+ *
+ * @param archivo Archivo destino, abierto para escritura.
+ * @param buffers Buffers (sin destino) con el texto a escribir.
+ * @param numBuffers Número de buffers.
+ * @return `true` si se escribieron todos los bytes, `false` en caso contrario.
+ */
+bool escribirBuffersEnOrden(FILE *archivo, const BufferSalida *buffers, int numBuffers);
+
+/**
+ * @brief Escribe un entero en decimal, equivalente a `%lld`.
+ * @param buffer Buffer de salida.
+ * @param valor Entero a escribir.
+ */
+void bufferEscribirEntero(BufferSalida *buffer, long long valor);
+
+/**
+ * @brief Escribe un número con dos decimales, equivalente a `%.2f`.
+ *
+ * El redondeo es al par más cercano sobre el valor binario exacto, igual que `printf`.
+ *
+ * @param buffer Buffer de salida.
+ * @param valor Número a escribir.
+ */
+void bufferEscribirDecimal2(BufferSalida *buffer, float valor);
+
+/**
+ * @brief Copia bytes al buffer.
+ * @param buffer Buffer de salida.
+ * @param texto Bytes a copiar.
+ * @param longitud Número de bytes.
+ */
+static inline void bufferEscribir(BufferSalida *buffer, const char *texto, size_t longitud) {
+    if (buffer->capacidad - buffer->longitud < longitud && !reservarEnBufferSalida(buffer, longitud)) {
+        return;
+    }
+    memcpy(buffer->datos + buffer->longitud, texto, longitud);
+    buffer->longitud += longitud;
+}
+
+/**
+ * @brief Copia una cadena terminada en '\0' al buffer.
+ * @param buffer Buffer de salida.
+ * @param texto Cadena a copiar.
+ */
+static inline void bufferEscribirCadena(BufferSalida *buffer, const char *texto) {
+    bufferEscribir(buffer, texto, strlen(texto));
+}
+
+/**
+ * @brief Copia una cadena literal al buffer; la longitud se calcula en compilación.
+ */
+#define bufferEscribirLiteral(buffer, literal) bufferEscribir((buffer), (literal), sizeof(literal) - 1)
+
+#endif // BUFFER_SALIDA_H
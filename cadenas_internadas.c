@@ -0,0 +1,370 @@
+/**
+ * @file cadenas_internadas.c
+ * @brief Implementación de la arena y la tabla de cadenas internadas.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cadenas_internadas.h"
+#include "contabilidad_memoria.h"
+
+/// Bits del hash que eligen la parte de la tabla.
+#define BITS_PARTES 6
+
+/// Partes de la tabla, cada una con su candado.
+#define NUM_PARTES (1 << BITS_PARTES)
+
+/// Ranuras con que empieza la tabla de una parte (potencia de 2).
+#define RANURAS_INICIALES 16
+
+/// Bytes del primer bloque de cada parte; cada bloque nuevo duplica el anterior hasta CADENAS_TAMANO_BLOQUE.
+#define BLOQUE_INICIAL 1024
+
+/// Espacios de hasta estos bytes tienen su tamaño exacto; los mayores se redondean a una potencia de 2.
+#define ESPACIO_EXACTO 64
+
+/// Listas de libres de una parte: una por tamaño exacto (1 a 64) y una por potencia de 2 (128 a 64 KB).
+#define NUM_LISTAS_LIBRES (ESPACIO_EXACTO + CADENAS_BITS_DESPLAZAMIENTO - 6)
+
+/// Texto del bloque 0: la Cadena 0 es el texto vacío.
+static char textoVacio[1] = "";
+
+/// Bloques de la arena; el 0 solo guarda el texto vacío.
+char *bloquesCadenas[CADENAS_MAX_BLOQUES] = { textoVacio };
+
+/// Bloques tomados (el 0 cuenta); se reparten con una suma atómica.
+static uint32_t bloquesTomados = 1;
+
+/**
+ * @brief Ranura de la tabla de una parte.
+ */
+typedef struct {
+    Cadena cadena;         ///< Texto de la ranura (CADENA_VACIA si está libre).
+    uint32_t hash;         ///< 32 bits bajos del hash, para comparar el texto solo si coinciden.
+    uint32_t referencias;  ///< Referencias tomadas con internarCadena y no soltadas.
+} RanuraCadena;
+
+/**
+ * @brief Una parte de la tabla: candado, ranuras y bloque de la arena donde agrega textos.
+ */
+typedef struct {
+    pthread_mutex_t candado;
+    RanuraCadena *ranuras;   ///< Direccionamiento abierto con sondeo lineal.
+    uint32_t capacidad;      ///< Ranuras (potencia de 2; 0 antes del primer texto).
+    uint32_t numCadenas;     ///< Ranuras ocupadas.
+    uint32_t bloque;         ///< Bloque actual de la parte (0: ninguno todavía).
+    uint32_t tamanoBloque;   ///< Bytes del bloque actual.
+    uint32_t usados;         ///< Bytes usados del bloque actual.
+    /// Primer espacio libre de cada tamaño; cada espacio guarda en sus 4 primeros bytes el siguiente.
+    Cadena libres[NUM_LISTAS_LIBRES];
+    long long bytesTexto;
+    long long bytesLibres;
+    long long bytesArena;
+    long long internados;
+    long long aciertos;
+    long long liberadas;
+    long long reutilizadas;
+} ParteCadenas;
+
+/// Partes de la tabla de cadenas.
+static ParteCadenas partes[NUM_PARTES];
+
+/// Inicializa los candados de las partes la primera vez que se usan.
+static pthread_once_t partesIniciadas = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Inicializa el candado de cada parte.
+ */
+static void iniciarPartes(void) {
+    for (int i = 0; i < NUM_PARTES; i++) pthread_mutex_init(&partes[i].candado, NULL);
+}
+
+/**
+ * @brief Hash FNV-1a de 64 bits de un texto.
+ */
+static uint64_t hashTexto(const char *texto, size_t longitud) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < longitud; i++) {
+        hash ^= (unsigned char)texto[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Indica si una cadena guardada es igual a un texto.
+ *
+ * strncmp se detiene en el '\0' de la cadena guardada, así que no lee fuera de su bloque.
+ */
+static bool cadenaIgual(Cadena cadena, const char *texto, size_t longitud) {
+    const char *guardado = textoCadena(cadena);
+    return strncmp(guardado, texto, longitud) == 0 && guardado[longitud] == '\0';
+}
+
+/**
+ * @brief Bytes del espacio de la arena que ocupa un texto.
+ *
+ * Todo espacio mide al menos lo que una Cadena, para poder enlazarlo en su lista de
+ * libres cuando se libere; los textos largos (raros: los nombres miden menos de 50
+ * bytes) se redondean a una potencia de 2 para que basten pocas listas.
+ */
+static uint32_t bytesEspacio(size_t longitud) {
+    uint32_t bytes = (uint32_t)longitud + 1;
+    if (bytes < sizeof(Cadena)) return sizeof(Cadena);
+    if (bytes <= ESPACIO_EXACTO) return bytes;
+    uint32_t potencia = ESPACIO_EXACTO * 2;
+    while (potencia < bytes) potencia *= 2;
+    return potencia;
+}
+
+/**
+ * @brief Lista de libres de los espacios de `bytes` (un valor devuelto por bytesEspacio).
+ */
+static int listaLibres(uint32_t bytes) {
+    if (bytes <= ESPACIO_EXACTO) return (int)bytes - 1;
+    int lista = ESPACIO_EXACTO;
+    for (uint32_t potencia = ESPACIO_EXACTO * 2; potencia < bytes; potencia *= 2) lista++;
+    return lista;
+}
+
+/**
+ * @brief Dirección del texto de una Cadena, para escribir en su espacio.
+ */
+static char *espacioCadena(Cadena cadena) {
+    return bloquesCadenas[cadena >> CADENAS_BITS_DESPLAZAMIENTO] + (cadena & (CADENAS_TAMANO_BLOQUE - 1));
+}
+
+/**
+ * @brief Duplica las ranuras de una parte y reubica sus cadenas.
+ * @return `true` si se amplió, `false` si no hubo memoria (la parte queda igual).
+ */
+static bool ampliarParte(ParteCadenas *parte) {
+    uint32_t capacidad = parte->capacidad ? parte->capacidad * 2 : RANURAS_INICIALES;
+    RanuraCadena *ranuras = (RanuraCadena *)calloc(capacidad, sizeof(RanuraCadena));
+    if (!ranuras) return false;
+    contarReserva(MEMORIA_CADENAS, capacidad * sizeof(RanuraCadena));
+    uint32_t mascara = capacidad - 1;
+    for (uint32_t i = 0; i < parte->capacidad; i++) {
+        RanuraCadena ranura = parte->ranuras[i];
+        if (ranura.cadena == CADENA_VACIA) continue;
+        uint32_t j = ranura.hash & mascara;
+        while (ranuras[j].cadena != CADENA_VACIA) j = (j + 1) & mascara;
+        ranuras[j] = ranura;
+    }
+    if (parte->ranuras) contarLiberacion(MEMORIA_CADENAS, parte->capacidad * sizeof(RanuraCadena));
+    free(parte->ranuras);
+    parte->ranuras = ranuras;
+    parte->capacidad = capacidad;
+    return true;
+}
+
+/**
+ * @brief Quita una ranura de la tabla de una parte.
+ *
+ * Con sondeo lineal no basta con vaciar la ranura: las cadenas que siguen en la misma
+ * racha se recorren hacia atrás para que su búsqueda no se corte en el hueco.
+ */
+static void quitarRanura(ParteCadenas *parte, uint32_t hueco) {
+    uint32_t mascara = parte->capacidad - 1;
+    for (uint32_t i = (hueco + 1) & mascara; parte->ranuras[i].cadena != CADENA_VACIA; i = (i + 1) & mascara) {
+        uint32_t inicio = parte->ranuras[i].hash & mascara;
+        // Se mueve si su ranura de inicio no está entre el hueco y ella
+        if (((i - inicio) & mascara) >= ((i - hueco) & mascara)) {
+            parte->ranuras[hueco] = parte->ranuras[i];
+            hueco = i;
+        }
+    }
+    parte->ranuras[hueco].cadena = CADENA_VACIA;
+    parte->ranuras[hueco].referencias = 0;
+    parte->numCadenas--;
+}
+
+/**
+ * @brief Copia un texto, con su '\0', a un espacio libre de su tamaño o al bloque actual de
+ *        la parte (o a uno nuevo si no cabe).
+ *
+ * Los bloques de una parte empiezan pequeños y duplican su tamaño, para que las partes
+ * con pocos textos no reserven un bloque completo cada una.
+ *
+ * @return `true` si se copió, `false` si no quedan bloques o no hubo memoria.
+ */
+static bool guardarEnArena(ParteCadenas *parte, const char *texto, size_t longitud, Cadena *cadena) {
+    uint32_t bytes = bytesEspacio(longitud);
+    Cadena *libre = &parte->libres[listaLibres(bytes)];
+    if (*libre != CADENA_VACIA) {
+        *cadena = *libre;
+        char *destino = espacioCadena(*libre);
+        memcpy(libre, destino, sizeof(Cadena));
+        memcpy(destino, texto, longitud);
+        destino[longitud] = '\0';
+        parte->bytesLibres -= (long long)longitud + 1;
+        parte->bytesTexto += (long long)longitud + 1;
+        parte->reutilizadas++;
+        return true;
+    }
+    if (parte->bloque == 0 || parte->usados + bytes > parte->tamanoBloque) {
+        // Lo que sobra del bloque anterior queda sin usar
+        size_t tamano = parte->bloque ? (size_t)parte->tamanoBloque * 2 : BLOQUE_INICIAL;
+        while (tamano < bytes) tamano *= 2;
+        if (tamano > CADENAS_TAMANO_BLOQUE) tamano = CADENAS_TAMANO_BLOQUE;
+        uint32_t bloque = __atomic_fetch_add(&bloquesTomados, 1, __ATOMIC_RELAXED);
+        if (bloque >= CADENAS_MAX_BLOQUES) return false;
+        char *memoria = (char *)malloc(tamano);
+        if (!memoria) return false;
+        contarReserva(MEMORIA_CADENAS, tamano);
+        // Otros hilos leen este bloque solo después de recibir una Cadena que lo nombra,
+        // y la reciben a través del candado de la parte o del de las tablas
+        bloquesCadenas[bloque] = memoria;
+        parte->bloque = bloque;
+        parte->tamanoBloque = (uint32_t)tamano;
+        parte->usados = 0;
+        parte->bytesArena += (long long)tamano;
+    }
+    char *destino = bloquesCadenas[parte->bloque] + parte->usados;
+    memcpy(destino, texto, longitud);
+    destino[longitud] = '\0';
+    *cadena = (parte->bloque << CADENAS_BITS_DESPLAZAMIENTO) | parte->usados;
+    parte->usados += bytes;
+    parte->bytesTexto += (long long)longitud + 1;
+    // El relleno del espacio cuenta como libre: al liberar el texto se suma el resto
+    parte->bytesLibres += (long long)bytes - (long long)longitud - 1;
+    return true;
+}
+
+/**
+ * @brief Interna un texto: devuelve la Cadena que ya tenía o lo guarda en la arena.
+ *
+ * Se puede llamar desde varios hilos a la vez. Si se internó, el llamador recibe una
+ * referencia y debe devolverla con soltarCadena.
+ *
+ * @param texto Texto (no necesita terminar en '\0' ni contener '\0').
+ * @param longitud Bytes del texto.
+ * @param cadena Cadena del texto (de salida; CADENA_VACIA si falla).
+ * @return `true` si se internó, `false` si el texto no cabe en un bloque o no hubo memoria.
+ */
+bool internarCadena(const char *texto, size_t longitud, Cadena *cadena) {
+    *cadena = CADENA_VACIA;
+    if (longitud == 0) return true;
+    if (longitud >= CADENAS_TAMANO_BLOQUE) {
+        printf("\nError: Texto de %zu bytes demasiado largo para internarlo.\n", longitud);
+        return false;
+    }
+    pthread_once(&partesIniciadas, iniciarPartes);
+    uint64_t hash = hashTexto(texto, longitud);
+    ParteCadenas *parte = &partes[hash >> (64 - BITS_PARTES)];
+    uint32_t hashRanura = (uint32_t)hash;
+
+    pthread_mutex_lock(&parte->candado);
+    parte->internados++;
+    // Se amplía antes de buscar para que la ranura libre encontrada siga valiendo al insertar
+    if ((parte->numCadenas + 1) * 4ULL > parte->capacidad * 3ULL && !ampliarParte(parte)) {
+        pthread_mutex_unlock(&parte->candado);
+        printf("\nError: No hay memoria para internar el texto.\n");
+        return false;
+    }
+    uint32_t mascara = parte->capacidad - 1;
+    uint32_t i = hashRanura & mascara;
+    for (; parte->ranuras[i].cadena != CADENA_VACIA; i = (i + 1) & mascara) {
+        RanuraCadena *ranura = &parte->ranuras[i];
+        if (ranura->hash == hashRanura && cadenaIgual(ranura->cadena, texto, longitud)) {
+            parte->aciertos++;
+            ranura->referencias++;
+            *cadena = ranura->cadena;
+            pthread_mutex_unlock(&parte->candado);
+            return true;
+        }
+    }
+    bool guardado = guardarEnArena(parte, texto, longitud, cadena);
+    if (guardado) {
+        parte->ranuras[i].cadena = *cadena;
+        parte->ranuras[i].hash = hashRanura;
+        parte->ranuras[i].referencias = 1;
+        parte->numCadenas++;
+    }
+    pthread_mutex_unlock(&parte->candado);
+    if (!guardado) printf("\nError: No hay memoria para internar el texto.\n");
+    return guardado;
+}
+
+/**
+ * @brief Interna un texto terminado en '\0' (ver internarCadena).
+ * @param texto Texto a internar.
+ * @param cadena Cadena del texto (de salida).
+ * @return `true` si se internó.
+ */
+bool internarTexto(const char *texto, Cadena *cadena) {
+    return internarCadena(texto, strlen(texto), cadena);
+}
+
+/**
+ * @brief Interna el texto de un arreglo de tamaño fijo, hasta su primer '\0' o su final.
+ * @param arreglo Arreglo con el texto.
+ * @param tamano Tamaño del arreglo.
+ * @param cadena Cadena del texto (de salida).
+ * @return `true` si se internó.
+ */
+bool internarArreglo(const char *arreglo, size_t tamano, Cadena *cadena) {
+    const char *fin = (const char *)memchr(arreglo, '\0', tamano);
+    return internarCadena(arreglo, fin ? (size_t)(fin - arreglo) : tamano, cadena);
+}
+
+/**
+ * @brief Devuelve una referencia tomada al internar; sin referencias, el texto se libera.
+ *
+ * El espacio liberado se enlaza en la lista de libres de su tamaño, en la misma parte:
+ * el siguiente texto de ese tamaño que se guarde en la parte lo ocupa.
+ *
+ * @param cadena Cadena que se deja de usar.
+ */
+void soltarCadena(Cadena cadena) {
+    if (cadena == CADENA_VACIA) return;
+    // Quien suelta tiene una referencia: el texto no cambia mientras se calcula su hash
+    const char *texto = textoCadena(cadena);
+    size_t longitud = strlen(texto);
+    uint64_t hash = hashTexto(texto, longitud);
+    ParteCadenas *parte = &partes[hash >> (64 - BITS_PARTES)];
+
+    pthread_mutex_lock(&parte->candado);
+    uint32_t mascara = parte->capacidad - 1;
+    for (uint32_t i = (uint32_t)hash & mascara; parte->ranuras[i].cadena != CADENA_VACIA; i = (i + 1) & mascara) {
+        RanuraCadena *ranura = &parte->ranuras[i];
+        if (ranura->cadena != cadena) continue;
+        if (--ranura->referencias == 0) {
+            quitarRanura(parte, i);
+            uint32_t bytes = bytesEspacio(longitud);
+            Cadena *libre = &parte->libres[listaLibres(bytes)];
+            memcpy(espacioCadena(cadena), libre, sizeof(Cadena));
+            *libre = cadena;
+            parte->bytesTexto -= (long long)longitud + 1;
+            parte->bytesLibres += (long long)longitud + 1;
+            parte->liberadas++;
+        }
+        break;
+    }
+    pthread_mutex_unlock(&parte->candado);
+}
+
+/**
+ * @brief Copia los contadores de las cadenas internadas.
+ * @param metricas Resultado (de salida).
+ */
+void leerMetricasCadenas(MetricasCadenas *metricas) {
+    memset(metricas, 0, sizeof(*metricas));
+    pthread_once(&partesIniciadas, iniciarPartes);
+    for (int i = 0; i < NUM_PARTES; i++) {
+        ParteCadenas *parte = &partes[i];
+        pthread_mutex_lock(&parte->candado);
+        metricas->cadenas += parte->numCadenas;
+        metricas->bytesTexto += parte->bytesTexto;
+        metricas->bytesLibres += parte->bytesLibres;
+        metricas->bytesArena += parte->bytesArena;
+        metricas->bytesIndice += (long long)parte->capacidad * (long long)sizeof(RanuraCadena);
+        metricas->internados += parte->internados;
+        metricas->aciertos += parte->aciertos;
+        metricas->liberadas += parte->liberadas;
+        metricas->reutilizadas += parte->reutilizadas;
+        pthread_mutex_unlock(&parte->candado);
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file cadenas_internadas.h
+ * @brief Cadenas internadas: cada texto distinto se guarda una sola vez y se nombra con un entero de 4 bytes.
+ *
+ * Los nombres de alimentos y clientes se guardan como Cadena, un identificador de
+ * 32 bits en vez de un arreglo fijo de 50 bytes. El texto vive en
+ * una arena de bloques de hasta 64 KB que nunca se mueven: el identificador es el número
+ * de bloque en los 16 bits altos y la posición dentro del bloque en los 16 bajos, de modo
+ * que textoCadena es una suma sin búsqueda ni candado.
+ *
+ * Al internar un texto se busca primero en una tabla de hash repartida en partes, cada
+ * una con su candado y su bloque de arena, para que la carga y la generación paralelas
+ * no compitan por el mismo candado. Dos textos iguales reciben la misma Cadena: dentro
+ * del programa, comparar nombres es comparar enteros, y los nombres repetidos ocupan
+ * una sola copia.
+ *
+ * Cada Cadena lleva la cuenta de sus referencias: internar un texto toma una y
+ * soltarCadena la devuelve. Los registros de las tablas son los dueños de sus
+ * referencias (las sueltan al retirarse, al vaciar la tabla o al cambiar de nombre);
+ * las copias temporales de un registro no toman ninguna. Cuando un texto se queda sin
+ * referencias, su espacio pasa a una lista de libres de su parte y tamaño, y el próximo
+ * texto de ese tamaño que caiga en la parte lo reutiliza. Así la arena crece con los
+ * textos vivos a la vez (más lo que las listas de libres de cada parte no alcanzan a
+ * repartir), no con las actualizaciones: un servidor que renombra clientes una y otra
+ * vez no la hace crecer sin límite. La arena no se devuelve al sistema; su memoria se
+ * cuenta en MEMORIA_CADENAS.
+ */
+
+#ifndef CADENAS_INTERNADAS_H
+#define CADENAS_INTERNADAS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Identificador de un texto internado.
+typedef uint32_t Cadena;
+
+/// Cadena del texto vacío; es la que tiene un registro recién creado con memset.
+#define CADENA_VACIA 0
+
+/// Bits de la posición dentro del bloque.
+#define CADENAS_BITS_DESPLAZAMIENTO 16
+
+/// Bytes máximos de un bloque de la arena; un texto, con su '\0', debe caber en uno.
+#define CADENAS_TAMANO_BLOQUE (1u << CADENAS_BITS_DESPLAZAMIENTO)
+
+/// Bloques que puede tener la arena (4 GB de texto).
+#define CADENAS_MAX_BLOQUES (1u << (32 - CADENAS_BITS_DESPLAZAMIENTO))
+
+/// Bloques de la arena; el 0 solo guarda el texto vacío. Solo para textoCadena.
+extern char *bloquesCadenas[CADENAS_MAX_BLOQUES];
+
+/**
+ * @brief Contadores de las cadenas internadas desde el inicio del programa.
+ */
+typedef struct {
+    long long cadenas;      ///< Textos distintos con referencias (sin contar el vacío).
+    long long bytesTexto;   ///< Bytes de esos textos, con su '\0'.
+    long long bytesLibres;  ///< Bytes de la arena en las listas de libres o de relleno de un espacio.
+    long long bytesArena;   ///< Bytes de los bloques de la arena.
+    long long bytesIndice;  ///< Bytes de las tablas de búsqueda.
+    long long internados;   ///< Llamadas a internarCadena con un texto no vacío.
+    long long aciertos;     ///< De ellas, las que encontraron el texto ya guardado.
+    long long liberadas;    ///< Textos que se quedaron sin referencias.
+    long long reutilizadas; ///< Textos nuevos guardados en el espacio de uno liberado.
+} MetricasCadenas;
+
+/**
+ * @brief Texto de una cadena internada.
+ *
+ * El texto es válido mientras alguien tenga una referencia a la Cadena y no debe modificarse.
+ *
+ * @param cadena Cadena obtenida con internarCadena (o CADENA_VACIA).
+ * @return Texto terminado en '\0'.
+ */
+static inline const char *textoCadena(Cadena cadena) {
+    return bloquesCadenas[cadena >> CADENAS_BITS_DESPLAZAMIENTO] + (cadena & (CADENAS_TAMANO_BLOQUE - 1));
+}
+
+/**
+ * @brief Interna un texto: devuelve la Cadena que ya tenía o lo guarda en la arena.
+ *
+ * Se puede llamar desde varios hilos a la vez. Si se internó, el llamador recibe una
+ * referencia y debe devolverla con soltarCadena cuando deje de usar la Cadena.
+ *
+ * @param texto Texto (no necesita terminar en '\0' ni contener '\0').
+ * @param longitud Bytes del texto.
+ * @param cadena Cadena del texto (de salida; CADENA_VACIA si falla).
+ * @return `true` si se internó, `false` si el texto no cabe en un bloque o no hubo memoria.
+ */
+bool internarCadena(const char *texto, size_t longitud, Cadena *cadena);
+
+/**
+ * @brief Interna un texto terminado en '\0' (ver internarCadena).
+ * @param texto Texto a internar.
+ * @param cadena Cadena del texto (de salida).
+ * @return `true` si se internó.
+ */
+bool internarTexto(const char *texto, Cadena *cadena);
+
+/**
+ * @brief Interna el texto de un arreglo de tamaño fijo, hasta su primer '\0' o su final.
+ *
+ * Es la forma de leer los nombres de los registros binarios (snapshots, bitácora).
+ *
+ * @param arreglo Arreglo con el texto.
+ * @param tamano Tamaño del arreglo.
+ * @param cadena Cadena del texto (de salida).
+ * @return `true` si se internó.
+ */
+bool internarArreglo(const char *arreglo, size_t tamano, Cadena *cadena);
+
+/**
+ * @brief Devuelve una referencia tomada al internar; sin referencias, el texto se libera.
+ *
+ * Se puede llamar desde varios hilos a la vez. No hace nada con CADENA_VACIA.
+ *
+ * @param cadena Cadena que se deja de usar.
+ */
+void soltarCadena(Cadena cadena);
+
+/**
+ * @brief Copia los contadores de las cadenas internadas.
+ * @param metricas Resultado (de salida).
+ */
+void leerMetricasCadenas(MetricasCadenas *metricas);
+
+#endif // CADENAS_INTERNADAS_H
@@ -0,0 +1,120 @@
+/**
+ * @file cambios_pendientes.c
+ * @brief Implementación del registro de IDs modificados o eliminados.
+ */
+
+#include <stdlib.h>
+#include "cambios_pendientes.h"
+#include "contabilidad_memoria.h"
+
+/// Capacidad inicial del registro (potencia de 2).
+#define CAMBIOS_CAPACIDAD_INICIAL 64
+
+/**
+ * @brief Mezcla los bits del ID para repartir los IDs consecutivos en las ranuras.
+ * @param id ID del registro.
+ * @return Valor de dispersión.
+ */
+static unsigned int dispersarId(int id) {
+    unsigned int x = (unsigned int)id;
+    x ^= x >> 16;
+    x *= 0x45D9F3Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Busca la ranura de un ID, o la ranura libre donde iría.
+ * @param ranuras Arreglo de ranuras.
+ * @param capacidad Número de ranuras (potencia de 2).
+ * @param id ID buscado.
+ * @return Ranura del ID o ranura libre.
+ */
+static Cambio *ubicarCambio(Cambio *ranuras, int capacidad, int id) {
+    unsigned int mascara = (unsigned int)capacidad - 1;
+    unsigned int i = dispersarId(id) & mascara;
+    while (ranuras[i].estado != CAMBIO_LIBRE && ranuras[i].id != id) {
+        i = (i + 1) & mascara;
+    }
+    return &ranuras[i];
+}
+
+/**
+ * @brief Duplica la capacidad del registro (o la crea) y recoloca los IDs anotados.
+ * @param cambios Registro de la tabla.
+ * @return `true` si se amplió, `false` si no hubo memoria.
+ */
+static bool ampliarCambios(CambiosPendientes *cambios) {
+    int capacidad = cambios->capacidad ? cambios->capacidad * 2 : CAMBIOS_CAPACIDAD_INICIAL;
+    Cambio *ranuras = (Cambio *)calloc((size_t)capacidad, sizeof(Cambio));
+    if (!ranuras) {
+        return false;
+    }
+    contarReserva(MEMORIA_CAMBIOS, (size_t)capacidad * sizeof(Cambio));
+    for (int i = 0; i < cambios->capacidad; i++) {
+        if (cambios->ranuras[i].estado != CAMBIO_LIBRE) {
+            *ubicarCambio(ranuras, capacidad, cambios->ranuras[i].id) = cambios->ranuras[i];
+        }
+    }
+    if (cambios->ranuras) contarLiberacion(MEMORIA_CAMBIOS, (size_t)cambios->capacidad * sizeof(Cambio));
+    free(cambios->ranuras);
+    cambios->ranuras = ranuras;
+    cambios->capacidad = capacidad;
+    return true;
+}
+
+/**
+ * @brief Deja el registro vacío y pide un guardado completo.
+ * @param cambios Registro a iniciar.
+ */
+void iniciarCambios(CambiosPendientes *cambios) {
+    cambios->ranuras = NULL;
+    cambios->capacidad = 0;
+    cambios->numCambios = 0;
+    cambios->requiereBase = true;
+}
+
+/**
+ * @brief Anota el estado más reciente de un ID.
+ * @param cambios Registro de la tabla.
+ * @param id ID del registro cambiado.
+ * @param estado CAMBIO_SUCIO o CAMBIO_ELIMINADO.
+ */
+void marcarCambio(CambiosPendientes *cambios, int id, EstadoCambio estado) {
+    if (cambios->requiereBase) {
+        return; // El próximo guardado es completo: no hace falta anotar IDs
+    }
+    // Se amplía al llegar a 3/4 de ocupación para que el sondeo siga siendo corto
+    if ((cambios->numCambios + 1) * 4 > cambios->capacidad * 3 && !ampliarCambios(cambios)) {
+        liberarCambios(cambios);
+        cambios->requiereBase = true;
+        return;
+    }
+    Cambio *cambio = ubicarCambio(cambios->ranuras, cambios->capacidad, id);
+    if (cambio->estado == CAMBIO_LIBRE) {
+        cambio->id = id;
+        cambios->numCambios++;
+    }
+    cambio->estado = estado;
+}
+
+/**
+ * @brief Olvida los cambios anotados después de guardarlos.
+ * @param cambios Registro de la tabla.
+ */
+void limpiarCambios(CambiosPendientes *cambios) {
+    liberarCambios(cambios);
+    cambios->requiereBase = false;
+}
+
+/**
+ * @brief Libera la memoria del registro.
+ * @param cambios Registro de la tabla.
+ */
+void liberarCambios(CambiosPendientes *cambios) {
+    if (cambios->ranuras) contarLiberacion(MEMORIA_CAMBIOS, (size_t)cambios->capacidad * sizeof(Cambio));
+    free(cambios->ranuras);
+    cambios->ranuras = NULL;
+    cambios->capacidad = 0;
+    cambios->numCambios = 0;
+}
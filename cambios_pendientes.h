@@ -0,0 +1,74 @@
+/**
+ * @file cambios_pendientes.h
+ * @brief Registro de los IDs modificados o eliminados de una tabla desde el último guardado.
+ *
+ * Cada tabla lleva uno. Las operaciones que notifican un cambio (ver mutaciones.h)
+ * marcan el ID como sucio o eliminado; el snapshot incremental (ver snapshot_delta.h)
+ * escribe solo esos registros y después limpia la marca. Las cargas y restauraciones
+ * masivas no marcan IDs: dejan `requiereBase` en `true` para que el siguiente guardado
+ * incremental escriba la tabla completa.
+ */
+
+#ifndef CAMBIOS_PENDIENTES_H
+#define CAMBIOS_PENDIENTES_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Estado de un ID en el registro de cambios.
+ */
+typedef enum {
+    CAMBIO_LIBRE = 0,    ///< Ranura sin usar.
+    CAMBIO_SUCIO,        ///< El registro se agregó o actualizó.
+    CAMBIO_ELIMINADO     ///< El registro se eliminó.
+} EstadoCambio;
+
+/**
+ * @brief Ranura del registro de cambios.
+ */
+typedef struct {
+    int id;       ///< ID del registro.
+    int estado;   ///< EstadoCambio.
+} Cambio;
+
+/**
+ * @brief Conjunto de IDs cambiados, con direccionamiento abierto y sondeo lineal.
+ */
+typedef struct {
+    Cambio *ranuras;    ///< Arreglo de `capacidad` ranuras, o `NULL` si no hay cambios.
+    int capacidad;      ///< Número de ranuras (potencia de 2).
+    int numCambios;     ///< Ranuras ocupadas.
+    bool requiereBase;  ///< `true` si la tabla cambió sin marcar IDs y el próximo guardado debe ser completo.
+} CambiosPendientes;
+
+/**
+ * @brief Deja el registro vacío y pide un guardado completo (la tabla aún no se ha guardado).
+ * @param cambios Registro a iniciar.
+ */
+void iniciarCambios(CambiosPendientes *cambios);
+
+/**
+ * @brief Anota el estado más reciente de un ID.
+ *
+ * Si no hay memoria para ampliar el registro, se descartan los IDs anotados y se pide
+ * un guardado completo, que de todos modos incluye los cambios.
+ *
+ * @param cambios Registro de la tabla.
+ * @param id ID del registro cambiado.
+ * @param estado CAMBIO_SUCIO o CAMBIO_ELIMINADO.
+ */
+void marcarCambio(CambiosPendientes *cambios, int id, EstadoCambio estado);
+
+/**
+ * @brief Olvida los cambios anotados después de guardarlos.
+ * @param cambios Registro de la tabla.
+ */
+void limpiarCambios(CambiosPendientes *cambios);
+
+/**
+ * @brief Libera la memoria del registro.
+ * @param cambios Registro de la tabla.
+ */
+void liberarCambios(CambiosPendientes *cambios);
+
+#endif // CAMBIOS_PENDIENTES_H
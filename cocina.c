@@ -0,0 +1,438 @@
+/**
+ * @file cocina.c
+ * @brief Implementación de la cola de despacho sin candados y de los cocineros.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#define _POSIX_C_SOURCE 200809L // nanosleep con -std=c99
+#include <time.h>
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "cocina.h"
+
+/// Separación entre los índices de productores y consumidores para que no compartan línea de caché.
+#define COCINA_LINEA_CACHE 64
+
+/**
+ * @brief Celda de la cola.
+ *
+ * `secuencia` vale la posición de la celda cuando está libre para el productor de esa
+ * posición, y la posición + 1 cuando ya tiene un pedido para el consumidor de esa posición.
+ */
+typedef struct {
+    unsigned long long secuencia;
+    int idPedido;
+    double encolado;     ///< Instante en que se encoló (omp_get_wtime).
+} CeldaCocina;
+
+/**
+ * @brief Estado de la cocina.
+ *
+ * Los índices y los contadores se modifican con operaciones atómicas; `candado` solo
+ * protege el dormir y despertar de los cocineros y de quien espera en esperarCocina.
+ */
+static struct {
+    bool activa;
+    PedidosHashTable *pedidos;
+    int numCocineros;
+    int microsPorMenu;
+    pthread_t *cocineros;
+    CeldaCocina *celdas;            ///< COCINA_CAPACIDAD_COLA celdas.
+    double inicio;
+
+    char separacionCola[COCINA_LINEA_CACHE];
+    unsigned long long cola;        ///< Siguiente posición a escribir (productores).
+    char separacionCabeza[COCINA_LINEA_CACHE];
+    unsigned long long cabeza;      ///< Siguiente posición a leer (cocineros).
+    char separacionContadores[COCINA_LINEA_CACHE];
+
+    long long encolados;
+    long long rechazados;
+    long long sacados;              ///< Pedidos que un cocinero ya tomó de la cola.
+    long long procesados;           ///< Pedidos completados o descartados.
+    long long completados;
+    long long descartados;
+    long long esperaTotal;          ///< Nanosegundos acumulados de espera en la cola.
+    long long esperaMaxima;         ///< Nanosegundos.
+    int profundidadMaxima;
+    int dormidos;                   ///< Cocineros dormidos esperando pedidos.
+    bool terminar;                  ///< Los cocineros deben salir al vaciarse la cola.
+    MetricasCocina ultimas;         ///< Métricas de la última vez que se detuvo.
+
+    pthread_mutex_t candado;
+    pthread_cond_t hayPedidos;      ///< Se avisa al encolar si algún cocinero duerme.
+    pthread_cond_t terminoPedido;   ///< Se avisa al procesar el último pedido encolado.
+} cocina = { .candado = PTHREAD_MUTEX_INITIALIZER, .hayPedidos = PTHREAD_COND_INITIALIZER,
+             .terminoPedido = PTHREAD_COND_INITIALIZER };
+
+/// Candado de las tablas (ver bloquearTablasCocina).
+static pthread_mutex_t candadoTablas = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Duerme el hilo que llama.
+ */
+static void dormirMicrosegundos(long micros) {
+#ifdef _WIN32
+    Sleep((DWORD)((micros + 999) / 1000));
+#else
+    struct timespec espera = { micros / 1000000, (micros % 1000000) * 1000 };
+    nanosleep(&espera, NULL);
+#endif
+}
+
+/**
+ * @brief Sube `*maximo` a `valor` si es mayor, aunque otros hilos lo actualicen a la vez.
+ */
+static void actualizarMaximo(long long *maximo, long long valor) {
+    long long actual = __atomic_load_n(maximo, __ATOMIC_RELAXED);
+    while (valor > actual &&
+           !__atomic_compare_exchange_n(maximo, &actual, valor, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Escribe un pedido en la cola sin tomar candados.
+ * @return `false` si la cola está llena.
+ */
+static bool meterEnCola(int idPedido) {
+    unsigned long long posicion = __atomic_load_n(&cocina.cola, __ATOMIC_RELAXED);
+    CeldaCocina *celda;
+    for (;;) {
+        celda = &cocina.celdas[posicion & (COCINA_CAPACIDAD_COLA - 1)];
+        unsigned long long secuencia = __atomic_load_n(&celda->secuencia, __ATOMIC_ACQUIRE);
+        long long diferencia = (long long)(secuencia - posicion);
+        if (diferencia == 0) {
+            // La celda está libre: se reserva avanzando el índice (si otro ganó, `posicion` se actualiza)
+            if (__atomic_compare_exchange_n(&cocina.cola, &posicion, posicion + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if (diferencia < 0) {
+            return false; // La celda aún tiene el pedido de la vuelta anterior
+        } else {
+            posicion = __atomic_load_n(&cocina.cola, __ATOMIC_RELAXED);
+        }
+    }
+    celda->idPedido = idPedido;
+    celda->encolado = omp_get_wtime();
+    __atomic_store_n(&celda->secuencia, posicion + 1, __ATOMIC_RELEASE); // Publica el pedido
+    return true;
+}
+
+/**
+ * @brief Saca el pedido más antiguo de la cola sin tomar candados.
+ * @return `false` si no hay pedidos publicados en la siguiente posición.
+ */
+static bool sacarDeCola(int *idPedido, double *encolado) {
+    unsigned long long posicion = __atomic_load_n(&cocina.cabeza, __ATOMIC_RELAXED);
+    CeldaCocina *celda;
+    for (;;) {
+        celda = &cocina.celdas[posicion & (COCINA_CAPACIDAD_COLA - 1)];
+        unsigned long long secuencia = __atomic_load_n(&celda->secuencia, __ATOMIC_ACQUIRE);
+        long long diferencia = (long long)(secuencia - (posicion + 1));
+        if (diferencia == 0) {
+            if (__atomic_compare_exchange_n(&cocina.cabeza, &posicion, posicion + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if (diferencia < 0) {
+            return false; // Vacía, o el productor de esta posición aún no publica
+        } else {
+            posicion = __atomic_load_n(&cocina.cabeza, __ATOMIC_RELAXED);
+        }
+    }
+    *idPedido = celda->idPedido;
+    *encolado = celda->encolado;
+    // La celda queda libre para el productor de la siguiente vuelta
+    __atomic_store_n(&celda->secuencia, posicion + COCINA_CAPACIDAD_COLA, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Pedidos encolados que ningún cocinero ha tomado.
+ */
+static long long pedidosEnCola(void) {
+    return __atomic_load_n(&cocina.encolados, __ATOMIC_SEQ_CST) - __atomic_load_n(&cocina.sacados, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Pasa un pedido a "En Proceso", lo prepara y lo pasa a "Completado".
+ * @return `true` si se completó, `false` si se descartó.
+ */
+static bool cocinarPedido(int idPedido) {
+    bloquearTablasCocina();
+    Pedido *pedido = buscarPedido(cocina.pedidos, idPedido);
+    bool tomado = pedido && strcmp(pedido->estado, "Pendiente") == 0 &&
+                  actualizarPedido(cocina.pedidos, idPedido, "En Proceso");
+    int numMenus = tomado ? pedido->numMenus : 0;
+    desbloquearTablasCocina();
+    if (!tomado) return false;
+
+    // La preparación no toca las tablas, así que se hace sin el candado
+    if (cocina.microsPorMenu > 0 && numMenus > 0) dormirMicrosegundos((long)cocina.microsPorMenu * numMenus);
+
+    bloquearTablasCocina();
+    pedido = buscarPedido(cocina.pedidos, idPedido);
+    // Si lo cancelaron o le cambiaron el estado mientras se preparaba, se respeta el cambio
+    bool completado = pedido && strcmp(pedido->estado, "En Proceso") == 0 &&
+                      actualizarPedido(cocina.pedidos, idPedido, "Completado");
+    desbloquearTablasCocina();
+    return completado;
+}
+
+/**
+ * @brief Ciclo de un cocinero: toma pedidos de la cola y duerme cuando no hay.
+ * @param argumento No se usa.
+ * @return Siempre `NULL`.
+ */
+static void *cocinar(void *argumento) {
+    (void)argumento;
+    for (;;) {
+        int idPedido;
+        double encolado;
+        if (sacarDeCola(&idPedido, &encolado)) {
+            __atomic_add_fetch(&cocina.sacados, 1, __ATOMIC_SEQ_CST);
+            long long espera = (long long)((omp_get_wtime() - encolado) * 1e9);
+            __atomic_add_fetch(&cocina.esperaTotal, espera, __ATOMIC_RELAXED);
+            actualizarMaximo(&cocina.esperaMaxima, espera);
+
+            bool completado = cocinarPedido(idPedido);
+            __atomic_add_fetch(completado ? &cocina.completados : &cocina.descartados, 1, __ATOMIC_RELAXED);
+            long long procesados = __atomic_add_fetch(&cocina.procesados, 1, __ATOMIC_SEQ_CST);
+            // Un pedido puede terminarse antes de que su productor lo cuente, de ahí el >=
+            if (procesados >= __atomic_load_n(&cocina.encolados, __ATOMIC_SEQ_CST)) {
+                pthread_mutex_lock(&cocina.candado);
+                pthread_cond_broadcast(&cocina.terminoPedido);
+                pthread_mutex_unlock(&cocina.candado);
+            }
+            continue;
+        }
+        if (pedidosEnCola() > 0) continue; // Un productor reservó la celda pero aún no publica
+
+        pthread_mutex_lock(&cocina.candado);
+        // Se anuncia antes de revisar la cola, así quien encola después siempre lo ve
+        __atomic_add_fetch(&cocina.dormidos, 1, __ATOMIC_SEQ_CST);
+        while (pedidosEnCola() <= 0 && !cocina.terminar) {
+            pthread_cond_wait(&cocina.hayPedidos, &cocina.candado);
+        }
+        __atomic_sub_fetch(&cocina.dormidos, 1, __ATOMIC_SEQ_CST);
+        bool salir = cocina.terminar && pedidosEnCola() <= 0;
+        pthread_mutex_unlock(&cocina.candado);
+        if (salir) return NULL;
+    }
+}
+
+/**
+ * @brief Encola un pedido, contando la profundidad y despertando a un cocinero si hace falta.
+ */
+static bool encolar(int idPedido) {
+    if (!meterEnCola(idPedido)) return false;
+    long long encolados = __atomic_add_fetch(&cocina.encolados, 1, __ATOMIC_SEQ_CST);
+    long long profundidad = encolados - __atomic_load_n(&cocina.sacados, __ATOMIC_SEQ_CST);
+    int maximo = __atomic_load_n(&cocina.profundidadMaxima, __ATOMIC_RELAXED);
+    while (profundidad > maximo &&
+           !__atomic_compare_exchange_n(&cocina.profundidadMaxima, &maximo, (int)profundidad, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    if (__atomic_load_n(&cocina.dormidos, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&cocina.candado);
+        pthread_cond_signal(&cocina.hayPedidos);
+        pthread_mutex_unlock(&cocina.candado);
+    }
+    return true;
+}
+
+/**
+ * @brief Reúne los IDs de los pedidos en estado "Pendiente".
+ * @param tabla Tabla de pedidos.
+ * @param numIds Cantidad de IDs (de salida).
+ * @return Arreglo de IDs (liberar con `free`), o NULL si no hay memoria.
+ */
+static int *recogerPendientes(PedidosHashTable *tabla, int *numIds) {
+    *numIds = 0;
+    int *ids = malloc((size_t)(tabla->numPedidos > 0 ? tabla->numPedidos : 1) * sizeof(int));
+    if (!ids) return NULL;
+    for (int i = 0; i < tabla->capacidadDirecta + PEDIDOS_TABLE_SIZE; i++) {
+        bool directo = i < tabla->capacidadDirecta;
+        Pedido *pedido = directo ? tabla->directo[i] : tabla->buckets[i - tabla->capacidadDirecta];
+        for (; pedido; pedido = directo ? NULL : pedido->next) {
+            if (strcmp(pedido->estado, "Pendiente") == 0) ids[(*numIds)++] = pedido->idPedido;
+        }
+    }
+    return ids;
+}
+
+/**
+ * @brief Encola los pedidos que ya están "Pendiente" y arranca los cocineros.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param numCocineros Hilos cocineros (1 a COCINA_MAX_COCINEROS).
+ * @param microsPorMenu Tiempo de preparación simulado de cada menú del pedido (0 para ninguno).
+ * @return `true` si la cocina quedó trabajando, `false` si ya estaba activa o no se pudo iniciar.
+ */
+bool iniciarCocina(PedidosHashTable *tablaPedidos, int numCocineros, int microsPorMenu) {
+    if (cocina.activa) {
+        printf("\nError: La cocina ya está trabajando.\n");
+        return false;
+    }
+    if (numCocineros < 1 || numCocineros > COCINA_MAX_COCINEROS || microsPorMenu < 0) {
+        printf("\nError: La cocina necesita de 1 a %d cocineros.\n", COCINA_MAX_COCINEROS);
+        return false;
+    }
+
+    int numPendientes;
+    int *pendientes = recogerPendientes(tablaPedidos, &numPendientes);
+    cocina.celdas = malloc(COCINA_CAPACIDAD_COLA * sizeof(CeldaCocina));
+    cocina.cocineros = malloc((size_t)numCocineros * sizeof(pthread_t));
+    if (!pendientes || !cocina.celdas || !cocina.cocineros) {
+        printf("\nError: No hay memoria para la cola de la cocina.\n");
+        free(pendientes);
+        free(cocina.celdas);
+        free(cocina.cocineros);
+        return false;
+    }
+    for (unsigned long long i = 0; i < COCINA_CAPACIDAD_COLA; i++) cocina.celdas[i].secuencia = i;
+    cocina.pedidos = tablaPedidos;
+    cocina.microsPorMenu = microsPorMenu;
+    cocina.cola = cocina.cabeza = 0;
+    cocina.encolados = cocina.rechazados = cocina.sacados = cocina.procesados = 0;
+    cocina.completados = cocina.descartados = 0;
+    cocina.esperaTotal = cocina.esperaMaxima = 0;
+    cocina.profundidadMaxima = 0;
+    cocina.dormidos = 0;
+    cocina.terminar = false;
+    cocina.inicio = omp_get_wtime();
+
+    cocina.numCocineros = 0;
+    while (cocina.numCocineros < numCocineros &&
+           pthread_create(&cocina.cocineros[cocina.numCocineros], NULL, cocinar, NULL) == 0) {
+        cocina.numCocineros++;
+    }
+    if (cocina.numCocineros == 0) {
+        printf("\nError: No se pudo crear ningún cocinero.\n");
+        free(pendientes);
+        free(cocina.celdas);
+        free(cocina.cocineros);
+        return false;
+    }
+    if (cocina.numCocineros < numCocineros) {
+        printf("\nAdvertencia: Solo se pudieron crear %d de %d cocineros.\n", cocina.numCocineros, numCocineros);
+    }
+    __atomic_store_n(&cocina.activa, true, __ATOMIC_RELEASE);
+
+    // Los pendientes pueden ser más que la cola: se espera a que los cocineros hagan lugar
+    for (int i = 0; i < numPendientes; i++) {
+        while (!encolar(pendientes[i])) dormirMicrosegundos(50);
+    }
+    free(pendientes);
+    return true;
+}
+
+/**
+ * @brief Indica si la cocina está trabajando.
+ */
+bool cocinaActiva(void) {
+    return __atomic_load_n(&cocina.activa, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Encola un pedido nuevo para la cocina. Se puede llamar desde cualquier hilo.
+ * @param idPedido ID del pedido, ya agregado a la tabla en estado "Pendiente".
+ * @return `true` si se encoló, `false` si la cocina no está activa o la cola está llena.
+ */
+bool encolarPedidoCocina(int idPedido) {
+    if (!cocinaActiva()) return false;
+    if (encolar(idPedido)) return true;
+    __atomic_add_fetch(&cocina.rechazados, 1, __ATOMIC_RELAXED);
+    return false;
+}
+
+/**
+ * @brief Espera a que los cocineros terminen todos los pedidos encolados hasta ahora.
+ */
+void esperarCocina(void) {
+    if (!cocinaActiva()) return;
+    pthread_mutex_lock(&cocina.candado);
+    while (__atomic_load_n(&cocina.procesados, __ATOMIC_SEQ_CST) < __atomic_load_n(&cocina.encolados, __ATOMIC_SEQ_CST)) {
+        pthread_cond_wait(&cocina.terminoPedido, &cocina.candado);
+    }
+    pthread_mutex_unlock(&cocina.candado);
+}
+
+/**
+ * @brief Termina los pedidos encolados y detiene a los cocineros.
+ * @param metricas Métricas finales (de salida), o `NULL`.
+ */
+void detenerCocina(MetricasCocina *metricas) {
+    if (!cocinaActiva()) {
+        if (metricas) *metricas = cocina.ultimas;
+        return;
+    }
+    esperarCocina();
+    pthread_mutex_lock(&cocina.candado);
+    cocina.terminar = true;
+    pthread_cond_broadcast(&cocina.hayPedidos);
+    pthread_mutex_unlock(&cocina.candado);
+    for (int i = 0; i < cocina.numCocineros; i++) pthread_join(cocina.cocineros[i], NULL);
+
+    leerMetricasCocina(&cocina.ultimas);
+    __atomic_store_n(&cocina.activa, false, __ATOMIC_RELEASE);
+    free(cocina.celdas);
+    free(cocina.cocineros);
+    cocina.celdas = NULL;
+    cocina.cocineros = NULL;
+    if (metricas) *metricas = cocina.ultimas;
+}
+
+/**
+ * @brief Lee las métricas de la cocina activa, o las de la última vez que trabajó.
+ * @param metricas Métricas (de salida).
+ */
+void leerMetricasCocina(MetricasCocina *metricas) {
+    if (!cocinaActiva()) {
+        *metricas = cocina.ultimas;
+        return;
+    }
+    memset(metricas, 0, sizeof(*metricas));
+    metricas->cocineros = cocina.numCocineros;
+    metricas->encolados = __atomic_load_n(&cocina.encolados, __ATOMIC_SEQ_CST);
+    metricas->rechazados = __atomic_load_n(&cocina.rechazados, __ATOMIC_RELAXED);
+    metricas->completados = __atomic_load_n(&cocina.completados, __ATOMIC_RELAXED);
+    metricas->descartados = __atomic_load_n(&cocina.descartados, __ATOMIC_RELAXED);
+    long long sacados = __atomic_load_n(&cocina.sacados, __ATOMIC_SEQ_CST);
+    metricas->profundidad = metricas->encolados > sacados ? (int)(metricas->encolados - sacados) : 0;
+    metricas->profundidadMaxima = __atomic_load_n(&cocina.profundidadMaxima, __ATOMIC_RELAXED);
+    if (sacados > 0) metricas->esperaPromedio = __atomic_load_n(&cocina.esperaTotal, __ATOMIC_RELAXED) / 1e9 / sacados;
+    metricas->esperaMaxima = __atomic_load_n(&cocina.esperaMaxima, __ATOMIC_RELAXED) / 1e9;
+    metricas->segundos = omp_get_wtime() - cocina.inicio;
+    if (metricas->segundos > 0) metricas->pedidosPorSegundo = metricas->completados / metricas->segundos;
+}
+
+/**
+ * @brief Imprime las métricas de la cocina.
+ * @param metricas Métricas a imprimir.
+ */
+void imprimirMetricasCocina(const MetricasCocina *metricas) {
+    printf("\n--- Cocina (%d cocineros, %.3f s) ---\n", metricas->cocineros, metricas->segundos);
+    printf("Encolados: %lld (rechazados por cola llena: %lld)\n", metricas->encolados, metricas->rechazados);
+    printf("Completados: %lld (descartados: %lld), %.0f pedidos por segundo\n", metricas->completados,
+           metricas->descartados, metricas->pedidosPorSegundo);
+    printf("Profundidad de la cola: %d (máxima %d)\n", metricas->profundidad, metricas->profundidadMaxima);
+    printf("Espera en la cola: %.1f µs promedio, %.1f µs máxima\n", metricas->esperaPromedio * 1e6,
+           metricas->esperaMaxima * 1e6);
+}
+
+/**
+ * @brief Toma el candado que protege las tablas de los cocineros.
+ */
+void bloquearTablasCocina(void) {
+    pthread_mutex_lock(&candadoTablas);
+}
+
+/**
+ * @brief Libera el candado de bloquearTablasCocina.
+ */
+void desbloquearTablasCocina(void) {
+    pthread_mutex_unlock(&candadoTablas);
+}
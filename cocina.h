@@ -0,0 +1,113 @@
+/**
+ * @file cocina.h
+ * @brief Cola de despacho de la cocina: los pedidos pendientes pasan por cocineros en hilos aparte.
+ *
+ * Los pedidos nuevos en estado "Pendiente" se encolan en una cola circular acotada sin
+ * candados para varios productores y varios consumidores: cada celda lleva un número de
+ * secuencia que indica si ya se puede escribir o leer, y productores y consumidores solo
+ * compiten por avanzar su índice con una operación atómica. Los cocineros sacan pedidos de
+ * la cola y los pasan a "En Proceso" y luego a "Completado" con `actualizarPedido`, así que
+ * cada cambio llega a la bitácora como cualquier otro. Un cocinero sin pedidos duerme en
+ * una variable de condición hasta que alguien encola; no gira esperando.
+ *
+ * Las tablas no admiten acceso concurrente: quien las use mientras la cocina trabaja debe
+ * tomar el candado de `bloquearTablasCocina`. El modo por lotes y el servidor lo toman en
+ * cada comando; los cocineros, en cada cambio de estado.
+ *
+ * Si un pedido ya no está "Pendiente" cuando un cocinero lo toma (lo eliminaron o le
+ * cambiaron el estado), se descarta; lo mismo si deja de estar "En Proceso" mientras se
+ * prepara. Si la cola está llena, el pedido se rechaza y queda "Pendiente".
+ */
+
+#ifndef COCINA_H
+#define COCINA_H
+
+#include <stdbool.h>
+#include "hash_pedidos.h"
+
+/// Pedidos que caben en la cola (potencia de 2).
+#define COCINA_CAPACIDAD_COLA 65536
+
+/// Cocineros máximos.
+#define COCINA_MAX_COCINEROS 256
+
+/**
+ * @brief Métricas de la cocina desde que se inició.
+ */
+typedef struct {
+    int cocineros;               ///< Hilos cocineros.
+    long long encolados;         ///< Pedidos que entraron a la cola.
+    long long rechazados;        ///< Pedidos que no cupieron en la cola (siguen "Pendiente").
+    long long completados;       ///< Pedidos que los cocineros pasaron a "Completado".
+    long long descartados;       ///< Pedidos que cambiaron o desaparecieron antes de completarse.
+    int profundidad;             ///< Pedidos en la cola al leer las métricas.
+    int profundidadMaxima;       ///< Mayor número de pedidos que hubo en la cola.
+    double esperaPromedio;       ///< Segundos promedio entre encolar un pedido y que un cocinero lo tome.
+    double esperaMaxima;         ///< Mayor espera en la cola, en segundos.
+    double segundos;             ///< Tiempo desde iniciarCocina.
+    double pedidosPorSegundo;    ///< Pedidos completados por segundo.
+} MetricasCocina;
+
+/**
+ * @brief Encola los pedidos que ya están "Pendiente" y arranca los cocineros.
+ *
+ * Debe llamarse sin otros hilos usando las tablas.
+ *
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param numCocineros Hilos cocineros (1 a COCINA_MAX_COCINEROS).
+ * @param microsPorMenu Tiempo de preparación simulado de cada menú del pedido (0 para ninguno).
+ * @return `true` si la cocina quedó trabajando, `false` si ya estaba activa o no se pudo iniciar.
+ */
+bool iniciarCocina(PedidosHashTable *tablaPedidos, int numCocineros, int microsPorMenu);
+
+/**
+ * @brief Indica si la cocina está trabajando.
+ */
+bool cocinaActiva(void);
+
+/**
+ * @brief Encola un pedido nuevo para la cocina. Se puede llamar desde cualquier hilo.
+ * @param idPedido ID del pedido, ya agregado a la tabla en estado "Pendiente".
+ * @return `true` si se encoló, `false` si la cocina no está activa o la cola está llena.
+ */
+bool encolarPedidoCocina(int idPedido);
+
+/**
+ * @brief Espera a que los cocineros terminen todos los pedidos encolados hasta ahora.
+ *
+ * No debe llamarse con el candado de las tablas tomado.
+ */
+void esperarCocina(void);
+
+/**
+ * @brief Termina los pedidos encolados y detiene a los cocineros.
+ *
+ * No debe llamarse con el candado de las tablas tomado ni mientras otros hilos encolan.
+ *
+ * @param metricas Métricas finales (de salida), o `NULL`.
+ */
+void detenerCocina(MetricasCocina *metricas);
+
+/**
+ * @brief Lee las métricas de la cocina activa, o las de la última vez que trabajó.
+ * @param metricas Métricas (de salida).
+ */
+void leerMetricasCocina(MetricasCocina *metricas);
+
+/**
+ * @brief Imprime las métricas de la cocina.
+ * @param metricas Métricas a imprimir.
+ */
+void imprimirMetricasCocina(const MetricasCocina *metricas);
+
+/**
+ * @brief Toma el candado que protege las tablas de los cocineros.
+ */
+void bloquearTablasCocina(void);
+
+/**
+ * @brief Libera el candado de bloquearTablasCocina.
+ */
+void desbloquearTablasCocina(void);
+
+#endif // COCINA_H
@@ -0,0 +1,293 @@
+/**
+ * @file codificacion_mutaciones.c
+ * @brief Implementación de la codificación binaria de los cambios y de su aplicación sobre las tablas.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "codificacion_mutaciones.h"
+#include "totales_pedidos.h"
+
+/// Tabla del CRC-32 (polinomio reflejado 0xEDB88320), se llena en `prepararCodificacionMutaciones`.
+static uint32_t tablaCrc[256];
+
+/**
+ * @brief Llena la tabla del CRC-32 que usan la codificación y la lectura de los cambios.
+ */
+void prepararCodificacionMutaciones(void) {
+    if (tablaCrc[1] != 0) return; // Ya estaba llena
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        tablaCrc[i] = c;
+    }
+}
+
+/**
+ * @brief Continúa un CRC-32 con más datos.
+ * @param crc CRC de los datos anteriores (0 al empezar).
+ * @param datos Datos a agregar.
+ * @param longitud Número de bytes.
+ * @return CRC de todos los datos.
+ */
+static uint32_t acumularCrc(uint32_t crc, const void *datos, size_t longitud) {
+    const unsigned char *p = (const unsigned char *)datos;
+    crc = ~crc;
+    while (longitud--) {
+        crc = tablaCrc[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Calcula la suma de verificación de un cambio.
+ * @param mutacion Encabezado del cambio (se usan `tipo` e `id`).
+ * @param contenido Contenido del cambio.
+ * @return CRC-32 de `tipo`, `id` y el contenido.
+ */
+static uint32_t sumaMutacion(const EncabezadoMutacion *mutacion, const unsigned char *contenido) {
+    return acumularCrc(acumularCrc(0, &mutacion->tipo, 2 * sizeof(uint32_t)), contenido, mutacion->longitud);
+}
+
+/**
+ * @brief Copia una cadena entre arreglos de tamaño fijo, rellenando con ceros.
+ * @param destino Arreglo destino.
+ * @param tamanoDestino Tamaño del arreglo destino.
+ * @param origen Arreglo origen.
+ * @param tamanoOrigen Tamaño del arreglo origen.
+ */
+static void copiarCadena(char *destino, size_t tamanoDestino, const char *origen, size_t tamanoOrigen) {
+    size_t i = 0;
+    while (i + 1 < tamanoDestino && i < tamanoOrigen && origen[i] != '\0') {
+        destino[i] = origen[i];
+        i++;
+    }
+    memset(destino + i, 0, tamanoDestino - i);
+}
+
+/**
+ * @brief Limita una cantidad de IDs al rango que cabe en un nodo.
+ * @param cantidad Cantidad original.
+ * @return Cantidad entre 0 y 50.
+ */
+static int32_t limitarIds(int cantidad) {
+    return cantidad < 0 ? 0 : (cantidad > 50 ? 50 : cantidad);
+}
+
+/**
+ * @brief Codifica un cambio como encabezado más contenido.
+ * @param tipo Tipo de cambio.
+ * @param nodo Nodo con el contenido nuevo, o `NULL` al quitar.
+ * @param id ID del registro afectado.
+ * @param destino Espacio para TAMANO_MAXIMO_MUTACION bytes, alineado a 4.
+ * @return Bytes escritos.
+ */
+size_t codificarMutacion(TipoMutacion tipo, const void *nodo, int id, unsigned char *destino) {
+    EncabezadoMutacion *mutacion = (EncabezadoMutacion *)destino;
+    unsigned char *contenido = destino + sizeof(EncabezadoMutacion);
+    mutacion->tipo = (uint32_t)tipo;
+    mutacion->id = id;
+    mutacion->longitud = 0;
+
+    switch (tipo) {
+        case MUTACION_ALIMENTO_PONER: {
+            const Alimento *alimento = (const Alimento *)nodo;
+            RegistroAlimento *registro = (RegistroAlimento *)contenido;
+            registro->id = alimento->id;
+            registro->precio = alimento->precio;
+            registro->disponible = alimento->disponible;
+            copiarCadena(registro->nombre, sizeof(registro->nombre), textoCadena(alimento->nombre),
+                         sizeof(registro->nombre));
+            mutacion->longitud = sizeof(RegistroAlimento);
+            break;
+        }
+        case MUTACION_CLIENTE_PONER: {
+            const Cliente *cliente = (const Cliente *)nodo;
+            RegistroCliente *registro = (RegistroCliente *)contenido;
+            registro->id = cliente->idCliente;
+            copiarCadena(registro->nombre, sizeof(registro->nombre), textoCadena(cliente->nombre),
+                         sizeof(registro->nombre));
+            copiarCadena(registro->telefono, sizeof(registro->telefono), cliente->telefono, sizeof(cliente->telefono));
+            mutacion->longitud = sizeof(RegistroCliente);
+            break;
+        }
+        case MUTACION_MENU_PONER: {
+            const Menu *menu = (const Menu *)nodo;
+            RegistroMenu *registro = (RegistroMenu *)contenido;
+            registro->id = menu->idMenu;
+            registro->numAlimentos = limitarIds(menu->numAlimentos);
+            registro->primerAlimento = 0;
+            registro->fecha = menu->fecha;
+            memcpy(registro + 1, menu->alimentos, registro->numAlimentos * sizeof(int32_t));
+            mutacion->longitud = sizeof(RegistroMenu) + registro->numAlimentos * sizeof(int32_t);
+            break;
+        }
+        case MUTACION_PEDIDO_PONER: {
+            const Pedido *pedido = (const Pedido *)nodo;
+            RegistroPedido *registro = (RegistroPedido *)contenido;
+            registro->id = pedido->idPedido;
+            registro->idCliente = pedido->idCliente;
+            registro->numMenus = limitarIds(pedido->numMenus);
+            registro->primerMenu = 0;
+            registro->fecha = pedido->fecha;
+            copiarCadena(registro->estado, sizeof(registro->estado), pedido->estado, sizeof(pedido->estado));
+            memcpy(registro + 1, pedido->menus, registro->numMenus * sizeof(int32_t));
+            mutacion->longitud = sizeof(RegistroPedido) + registro->numMenus * sizeof(int32_t);
+            break;
+        }
+        default: // Los cambios *_QUITAR no tienen contenido
+            break;
+    }
+    mutacion->suma = sumaMutacion(mutacion, contenido);
+    return sizeof(EncabezadoMutacion) + mutacion->longitud;
+}
+
+/**
+ * @brief Verifica que el contenido de un cambio leído tenga la forma que indica su tipo.
+ * @param mutacion Encabezado del cambio.
+ * @param contenido Contenido del cambio (`mutacion->longitud` bytes).
+ * @return `true` si el cambio se puede aplicar.
+ */
+static bool contenidoValido(const EncabezadoMutacion *mutacion, const unsigned char *contenido) {
+    switch (mutacion->tipo) {
+        case MUTACION_ALIMENTO_PONER:
+            return mutacion->longitud == sizeof(RegistroAlimento) &&
+                   ((const RegistroAlimento *)contenido)->id == mutacion->id;
+        case MUTACION_CLIENTE_PONER:
+            return mutacion->longitud == sizeof(RegistroCliente) &&
+                   ((const RegistroCliente *)contenido)->id == mutacion->id;
+        case MUTACION_MENU_PONER: {
+            const RegistroMenu *registro = (const RegistroMenu *)contenido;
+            return mutacion->longitud >= sizeof(RegistroMenu) && registro->id == mutacion->id &&
+                   registro->numAlimentos >= 0 && registro->numAlimentos <= 50 &&
+                   mutacion->longitud == sizeof(RegistroMenu) + registro->numAlimentos * sizeof(int32_t);
+        }
+        case MUTACION_PEDIDO_PONER: {
+            const RegistroPedido *registro = (const RegistroPedido *)contenido;
+            return mutacion->longitud >= sizeof(RegistroPedido) && registro->id == mutacion->id &&
+                   registro->numMenus >= 0 && registro->numMenus <= 50 &&
+                   mutacion->longitud == sizeof(RegistroPedido) + registro->numMenus * sizeof(int32_t);
+        }
+        case MUTACION_ALIMENTO_QUITAR:
+        case MUTACION_CLIENTE_QUITAR:
+        case MUTACION_MENU_QUITAR:
+        case MUTACION_PEDIDO_QUITAR:
+            return mutacion->longitud == 0;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Verifica el cambio que empieza en `datos`.
+ * @param datos Inicio del cambio, alineado a 4.
+ * @param disponible Bytes disponibles desde `datos`.
+ * @return Tamaño total del cambio (encabezado más contenido), o 0 si está incompleto o no es válido.
+ */
+size_t leerMutacion(const unsigned char *datos, size_t disponible) {
+    if (disponible < sizeof(EncabezadoMutacion)) return 0;
+    const EncabezadoMutacion *mutacion = (const EncabezadoMutacion *)datos;
+    const unsigned char *contenido = datos + sizeof(EncabezadoMutacion);
+    if (mutacion->longitud > disponible - sizeof(EncabezadoMutacion) || mutacion->longitud % 4 != 0 ||
+        sumaMutacion(mutacion, contenido) != mutacion->suma || !contenidoValido(mutacion, contenido)) {
+        return 0;
+    }
+    return sizeof(EncabezadoMutacion) + mutacion->longitud;
+}
+
+/**
+ * @brief Aplica un cambio ya validado a las tablas.
+ *
+ * Los cambios `*_PONER` reemplazan el contenido del registro si ya existe y lo crean si
+ * no; los `*_QUITAR` ignoran los IDs que no existen. Así, aplicar de nuevo un cambio
+ * que el snapshot ya incluía no altera el resultado.
+ *
+ * @param tablas Tablas destino.
+ * @param datos Cambio validado con `leerMutacion`.
+ * @return `true` si se aplicó, `false` si no hubo memoria.
+ */
+bool aplicarMutacion(const TablasMutacion *tablas, const unsigned char *datos) {
+    const EncabezadoMutacion *mutacion = (const EncabezadoMutacion *)datos;
+    const unsigned char *contenido = datos + sizeof(EncabezadoMutacion);
+    switch (mutacion->tipo) {
+        case MUTACION_ALIMENTO_PONER: {
+            const RegistroAlimento *registro = (const RegistroAlimento *)contenido;
+            Cadena nombre;
+            if (!internarArreglo(registro->nombre, sizeof(registro->nombre), &nombre)) return false;
+            Alimento *alimento = buscarAlimento(tablas->alimentos, registro->id);
+            bool nuevo = !alimento;
+            if (nuevo && !(alimento = (Alimento *)malloc(sizeof(Alimento)))) {
+                soltarCadena(nombre);
+                return false;
+            }
+            if (!nuevo) soltarCadena(alimento->nombre);
+            alimento->id = registro->id;
+            alimento->precio = registro->precio;
+            alimento->disponible = registro->disponible;
+            alimento->nombre = nombre;
+            if (nuevo) restaurarAlimento(tablas->alimentos, alimento);
+            else invalidarTotalesAlimento(tablas->alimentos, registro->id);
+            return true;
+        }
+        case MUTACION_CLIENTE_PONER: {
+            const RegistroCliente *registro = (const RegistroCliente *)contenido;
+            Cadena nombre;
+            if (!internarArreglo(registro->nombre, sizeof(registro->nombre), &nombre)) return false;
+            Cliente *cliente = buscarCliente(tablas->clientes, registro->id);
+            bool nuevo = !cliente;
+            if (nuevo && !(cliente = (Cliente *)malloc(sizeof(Cliente)))) {
+                soltarCadena(nombre);
+                return false;
+            }
+            if (!nuevo) soltarCadena(cliente->nombre);
+            cliente->idCliente = registro->id;
+            cliente->nombre = nombre;
+            copiarCadena(cliente->telefono, sizeof(cliente->telefono), registro->telefono, sizeof(registro->telefono));
+            if (nuevo) restaurarCliente(tablas->clientes, cliente);
+            return true;
+        }
+        case MUTACION_MENU_PONER: {
+            const RegistroMenu *registro = (const RegistroMenu *)contenido;
+            Menu *menu = buscarMenuPorID(tablas->menus, registro->id);
+            bool nuevo = !menu;
+            if (nuevo && !(menu = (Menu *)malloc(sizeof(Menu)))) return false;
+            menu->idMenu = registro->id;
+            menu->numAlimentos = registro->numAlimentos;
+            memcpy(menu->alimentos, registro + 1, registro->numAlimentos * sizeof(int32_t));
+            menu->fecha = registro->fecha;
+            if (nuevo) restaurarMenu(tablas->menus, menu);
+            else invalidarTotalesMenu(tablas->menus, registro->id);
+            return true;
+        }
+        case MUTACION_PEDIDO_PONER: {
+            const RegistroPedido *registro = (const RegistroPedido *)contenido;
+            Pedido *pedido = buscarPedido(tablas->pedidos, registro->id);
+            bool nuevo = !pedido;
+            if (nuevo && !(pedido = (Pedido *)malloc(sizeof(Pedido)))) return false;
+            pedido->idPedido = registro->id;
+            pedido->idCliente = registro->idCliente;
+            pedido->numMenus = registro->numMenus;
+            memcpy(pedido->menus, registro + 1, registro->numMenus * sizeof(int32_t));
+            pedido->fecha = registro->fecha;
+            copiarCadena(pedido->estado, sizeof(pedido->estado), registro->estado, sizeof(registro->estado));
+            if (nuevo) restaurarPedido(tablas->pedidos, pedido);
+            else invalidarTotalPedido(tablas->pedidos, registro->id);
+            return true;
+        }
+        case MUTACION_ALIMENTO_QUITAR:
+            retirarAlimento(tablas->alimentos, mutacion->id);
+            return true;
+        case MUTACION_CLIENTE_QUITAR:
+            retirarCliente(tablas->clientes, mutacion->id);
+            return true;
+        case MUTACION_MENU_QUITAR:
+            retirarMenu(tablas->menus, mutacion->id);
+            return true;
+        default:
+            retirarPedido(tablas->pedidos, mutacion->id);
+            return true;
+    }
+}
+
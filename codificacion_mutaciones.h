@@ -0,0 +1,84 @@
+/**
+ * @file codificacion_mutaciones.h
+ * @brief Formato binario de un cambio (ver mutaciones.h) y su aplicación sobre las tablas.
+ *
+ * Lo comparten la bitácora (bitacora.h) y los snapshots incrementales (snapshot_delta.h).
+ * Cada cambio es un EncabezadoMutacion seguido de su contenido. El contenido de los
+ * cambios `*_PONER` es el mismo registro de tamaño fijo del snapshot (los de menús y
+ * pedidos van seguidos de su lista de IDs); el de los `*_QUITAR` está vacío.
+ */
+
+#ifndef CODIFICACION_MUTACIONES_H
+#define CODIFICACION_MUTACIONES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "mutaciones.h"
+#include "snapshot_binario.h"
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/**
+ * @brief Encabezado de cada cambio codificado.
+ */
+typedef struct {
+    uint32_t longitud;  ///< Bytes del contenido que sigue al encabezado.
+    uint32_t suma;      ///< CRC-32 de `tipo`, `id` y el contenido.
+    uint32_t tipo;      ///< TipoMutacion.
+    int32_t id;         ///< ID del registro afectado.
+} EncabezadoMutacion;
+
+/// Tamaño del cambio más grande (un pedido con 50 menús).
+#define TAMANO_MAXIMO_MUTACION (sizeof(EncabezadoMutacion) + sizeof(RegistroPedido) + 50 * sizeof(int32_t))
+
+/**
+ * @brief Las cuatro tablas sobre las que se aplican los cambios.
+ */
+typedef struct {
+    HashTable *alimentos;
+    ClientesHashTable *clientes;
+    MenuHashTable *menus;
+    PedidosHashTable *pedidos;
+} TablasMutacion;
+
+/**
+ * @brief Prepara las tablas internas de la suma de verificación.
+ *
+ * Debe llamarse una vez antes de codificar o leer cambios; llamarla de nuevo no hace nada.
+ */
+void prepararCodificacionMutaciones(void);
+
+/**
+ * @brief Codifica un cambio como encabezado más contenido.
+ * @param tipo Tipo de cambio.
+ * @param nodo Nodo con el contenido nuevo, o `NULL` al quitar.
+ * @param id ID del registro afectado.
+ * @param destino Espacio para TAMANO_MAXIMO_MUTACION bytes, alineado a 4.
+ * @return Bytes escritos (siempre múltiplo de 4).
+ */
+size_t codificarMutacion(TipoMutacion tipo, const void *nodo, int id, unsigned char *destino);
+
+/**
+ * @brief Verifica el cambio que empieza en `datos`.
+ * @param datos Inicio del cambio, alineado a 4.
+ * @param disponible Bytes disponibles desde `datos`.
+ * @return Tamaño total del cambio (encabezado más contenido), o 0 si está incompleto o no es válido.
+ */
+size_t leerMutacion(const unsigned char *datos, size_t disponible);
+
+/**
+ * @brief Aplica un cambio ya validado a las tablas, sin notificar al observador.
+ *
+ * Los cambios `*_PONER` reemplazan el contenido del registro si ya existe y lo crean si
+ * no; los `*_QUITAR` ignoran los IDs que no existen.
+ *
+ * @param tablas Tablas destino.
+ * @param datos Cambio validado con `leerMutacion`.
+ * @return `true` si se aplicó, `false` si no hubo memoria.
+ */
+bool aplicarMutacion(const TablasMutacion *tablas, const unsigned char *datos);
+
+#endif // CODIFICACION_MUTACIONES_H
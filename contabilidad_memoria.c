@@ -0,0 +1,66 @@
+/**
+ * @file contabilidad_memoria.c
+ * @brief Implementación de los contadores de memoria por subsistema.
+ */
+
+#include <stdbool.h>
+#include "contabilidad_memoria.h"
+
+/// Nombre de cada subsistema, en el orden de SubsistemaMemoria.
+const char *const nombresSubsistemaMemoria[NUM_SUBSISTEMAS_MEMORIA] = {
+    "alimentos", "clientes", "menús", "pedidos", "cambios pendientes", "índices de búsqueda",
+    "totales de pedidos", "reportes de ventas", "cadenas internadas"
+};
+
+/// Contadores de cada subsistema; se leen y escriben con operaciones atómicas relajadas.
+static ContadoresMemoria contadores[NUM_SUBSISTEMAS_MEMORIA];
+
+/**
+ * @brief Cuenta una reserva (o la parte nueva de una ampliación).
+ * @param subsistema Dueño de la memoria.
+ * @param bytes Bytes reservados.
+ */
+void contarReserva(SubsistemaMemoria subsistema, size_t bytes) {
+    ContadoresMemoria *c = &contadores[subsistema];
+    __atomic_add_fetch(&c->reservas, 1, __ATOMIC_RELAXED);
+    long long vivos = __atomic_add_fetch(&c->bytesVivos, (long long)bytes, __ATOMIC_RELAXED);
+    long long pico = __atomic_load_n(&c->bytesPico, __ATOMIC_RELAXED);
+    // Si otro hilo sube el pico al mismo tiempo, la comparación se repite con su valor
+    while (vivos > pico &&
+           !__atomic_compare_exchange_n(&c->bytesPico, &pico, vivos, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+/**
+ * @brief Cuenta una liberación.
+ * @param subsistema Dueño de la memoria.
+ * @param bytes Bytes liberados.
+ */
+void contarLiberacion(SubsistemaMemoria subsistema, size_t bytes) {
+    ContadoresMemoria *c = &contadores[subsistema];
+    __atomic_add_fetch(&c->liberaciones, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&c->bytesVivos, (long long)bytes, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Copia los contadores de todos los subsistemas.
+ * @param resultado Un elemento por subsistema (de salida).
+ */
+void leerContadoresMemoria(ContadoresMemoria resultado[NUM_SUBSISTEMAS_MEMORIA]) {
+    for (int i = 0; i < NUM_SUBSISTEMAS_MEMORIA; i++) {
+        resultado[i].reservas = __atomic_load_n(&contadores[i].reservas, __ATOMIC_RELAXED);
+        resultado[i].liberaciones = __atomic_load_n(&contadores[i].liberaciones, __ATOMIC_RELAXED);
+        resultado[i].bytesVivos = __atomic_load_n(&contadores[i].bytesVivos, __ATOMIC_RELAXED);
+        resultado[i].bytesPico = __atomic_load_n(&contadores[i].bytesPico, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Lleva el pico de cada subsistema a sus bytes vivos actuales.
+ */
+void reiniciarPicosMemoria(void) {
+    for (int i = 0; i < NUM_SUBSISTEMAS_MEMORIA; i++) {
+        __atomic_store_n(&contadores[i].bytesPico, __atomic_load_n(&contadores[i].bytesVivos, __ATOMIC_RELAXED),
+                         __ATOMIC_RELAXED);
+    }
+}
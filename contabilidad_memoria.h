@@ -0,0 +1,75 @@
+/**
+ * @file contabilidad_memoria.h
+ * @brief Bytes reservados por cada subsistema: vivos, pico y número de reservas.
+ *
+ * Las tablas cuentan su estructura, el arreglo directo, el bloque de nodos y cada nodo
+ * suelto que enlazan o liberan (ver bloque_nodos.h); el registro de cambios pendientes,
+ * los índices de búsqueda, la caché de totales de pedidos, los reportes de ventas y las
+ * cadenas internadas cuentan sus arreglos. Los contadores son atómicos y cuestan una suma
+ * por reserva, así que siempre están activos.
+ *
+ * Se cuentan los bytes pedidos, no los que gasta el asignador (encabezados, redondeo).
+ * El reporte por tabla, con la holgura y la comparación con diseños compactos, está en
+ * reporte_memoria.h.
+ */
+
+#ifndef CONTABILIDAD_MEMORIA_H
+#define CONTABILIDAD_MEMORIA_H
+
+#include <stddef.h>
+
+/**
+ * @brief Subsistemas a los que se cuenta la memoria.
+ */
+typedef enum {
+    MEMORIA_ALIMENTOS,  ///< Tablas de alimentos (todas las instancias).
+    MEMORIA_CLIENTES,   ///< Tablas de clientes.
+    MEMORIA_MENUS,      ///< Tablas de menús.
+    MEMORIA_PEDIDOS,    ///< Tablas de pedidos.
+    MEMORIA_CAMBIOS,    ///< Registros de cambios pendientes de las cuatro tablas.
+    MEMORIA_INDICES,    ///< Índices de búsqueda y sus arreglos temporales.
+    MEMORIA_TOTALES,    ///< Caché de totales de pedidos y sus dependencias.
+    MEMORIA_REPORTES,   ///< Acumulados por hilo y filas de los reportes de ventas.
+    MEMORIA_CADENAS,    ///< Arena y tabla de las cadenas internadas (nombres de alimentos y clientes).
+    NUM_SUBSISTEMAS_MEMORIA
+} SubsistemaMemoria;
+
+/// Nombre de cada subsistema, en el orden de SubsistemaMemoria.
+extern const char *const nombresSubsistemaMemoria[NUM_SUBSISTEMAS_MEMORIA];
+
+/**
+ * @brief Contadores de un subsistema.
+ */
+typedef struct {
+    long long reservas;      ///< Reservas contadas (una ampliación cuenta como reserva).
+    long long liberaciones;  ///< Liberaciones contadas.
+    long long bytesVivos;    ///< Bytes reservados y aún no liberados.
+    long long bytesPico;     ///< Mayor valor de bytesVivos desde el inicio o el último reinicio.
+} ContadoresMemoria;
+
+/**
+ * @brief Cuenta una reserva (o la parte nueva de una ampliación).
+ * @param subsistema Dueño de la memoria.
+ * @param bytes Bytes reservados.
+ */
+void contarReserva(SubsistemaMemoria subsistema, size_t bytes);
+
+/**
+ * @brief Cuenta una liberación.
+ * @param subsistema Dueño de la memoria.
+ * @param bytes Bytes liberados (los mismos que se contaron al reservar).
+ */
+void contarLiberacion(SubsistemaMemoria subsistema, size_t bytes);
+
+/**
+ * @brief Copia los contadores de todos los subsistemas.
+ * @param contadores Un elemento por subsistema (de salida).
+ */
+void leerContadoresMemoria(ContadoresMemoria contadores[NUM_SUBSISTEMAS_MEMORIA]);
+
+/**
+ * @brief Lleva el pico de cada subsistema a sus bytes vivos actuales.
+ */
+void reiniciarPicosMemoria(void);
+
+#endif // CONTABILIDAD_MEMORIA_H
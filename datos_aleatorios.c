@@ -0,0 +1,385 @@
+/**
+ * @file datos_aleatorios.c
+ * @brief Implementación de la generación reproducible de datos sintéticos.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "datos_aleatorios.h"
+#include "rango_denso.h"
+#include "fechas.h"
+#include "tareas.h"
+
+/// Registros que construye cada tarea del pool.
+#define REGISTROS_POR_TAREA 16384
+
+/// Días del año de las fechas generadas (2024 es bisiesto).
+#define DIAS_ANIO 366
+
+/// Porcentaje de los pedidos que hacen los clientes frecuentes.
+#define PORCENTAJE_PEDIDOS_FRECUENTES 30
+
+/// Uno de cada tantos clientes es frecuente.
+#define CLIENTES_POR_FRECUENTE 100
+
+/// Primer día de diciembre (base 0), desde el que los pedidos siguen abiertos.
+#define PRIMER_DIA_DICIEMBRE 335
+
+/**
+ * @brief Tabla a la que pertenece un registro; separa los generadores de cada una.
+ */
+typedef enum {
+    GENERAR_ALIMENTOS = 1,
+    GENERAR_CLIENTES,
+    GENERAR_MENUS,
+    GENERAR_PEDIDOS
+} TablaGenerada;
+
+/**
+ * @brief Estado de un generador xoshiro256**.
+ */
+typedef struct {
+    uint64_t s[4];
+} GeneradorXoshiro;
+
+/**
+ * @brief Datos compartidos por todos los hilos durante la generación (solo lectura).
+ */
+typedef struct {
+    uint64_t semilla;
+    int cantidadAlimentos;
+    int cantidadClientes;
+    int cantidadMenus;
+    double *acumuladaMenus;          ///< Pesos de Zipf acumulados de los menús (índice = ID - 1).
+    int acumuladaDias[DIAS_ANIO];    ///< Pesos acumulados de cada día del año.
+} ContextoGeneracion;
+
+/// Días de cada mes de 2024.
+static const int diasPorMes[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+/// Peso relativo de cada mes: más pedidos en mayo y en diciembre.
+static const int pesoPorMes[12] = { 8, 7, 8, 8, 11, 9, 9, 9, 8, 9, 10, 14 };
+
+static inline uint64_t rotarIzquierda(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Avanza un estado splitmix64 y devuelve el siguiente valor (solo para sembrar).
+ */
+static inline uint64_t siguienteSplitmix(uint64_t *estado) {
+    uint64_t z = (*estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Siembra el generador del registro `id` de una tabla.
+ *
+ * El contador (tabla, ID) se multiplica por una constante impar, que es una biyección,
+ * así que registros distintos parten de estados distintos.
+ */
+static void sembrarGenerador(GeneradorXoshiro *generador, uint64_t semilla, TablaGenerada tabla, int id) {
+    uint64_t contador = ((uint64_t)tabla << 32) | (uint32_t)id;
+    uint64_t estado = semilla ^ (contador * 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        generador->s[i] = siguienteSplitmix(&estado);
+    }
+}
+
+static inline uint64_t siguienteXoshiro(GeneradorXoshiro *generador) {
+    uint64_t *s = generador->s;
+    uint64_t resultado = rotarIzquierda(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotarIzquierda(s[3], 45);
+    return resultado;
+}
+
+/**
+ * @brief Entero en [0, limite) por multiplicación (sin la división de `%`).
+ */
+static inline int enteroHasta(GeneradorXoshiro *generador, int limite) {
+    return (int)(((siguienteXoshiro(generador) >> 32) * (uint64_t)limite) >> 32);
+}
+
+/**
+ * @brief Real en [0, 1) con 53 bits de precisión.
+ */
+static inline double unitario(GeneradorXoshiro *generador) {
+    return (double)(siguienteXoshiro(generador) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Fecha del día `dia` (base 0) de 2024.
+ */
+static inline Fecha fechaDe2024(int dia) {
+    return fechaDeCivil(2024, 1, 1) + dia;
+}
+
+/**
+ * @brief Elige un día del año según la temporada.
+ * @return Día de 2024, base 0.
+ */
+static int elegirDia(GeneradorXoshiro *generador, const ContextoGeneracion *contexto) {
+    int objetivo = enteroHasta(generador, contexto->acumuladaDias[DIAS_ANIO - 1]);
+    int bajo = 0, alto = DIAS_ANIO - 1;
+    while (bajo < alto) {
+        int medio = (bajo + alto) / 2;
+        if (contexto->acumuladaDias[medio] > objetivo) alto = medio;
+        else bajo = medio + 1;
+    }
+    return bajo;
+}
+
+/**
+ * @brief Elige un menú con probabilidad proporcional a 1 / rango (Zipf con exponente 1).
+ * @return ID del menú.
+ */
+static int elegirMenu(GeneradorXoshiro *generador, const ContextoGeneracion *contexto) {
+    double objetivo = unitario(generador) * contexto->acumuladaMenus[contexto->cantidadMenus - 1];
+    int bajo = 0, alto = contexto->cantidadMenus - 1;
+    while (bajo < alto) {
+        int medio = (bajo + alto) / 2;
+        if (contexto->acumuladaMenus[medio] > objetivo) alto = medio;
+        else bajo = medio + 1;
+    }
+    return bajo + 1;
+}
+
+/**
+ * @brief Elige el cliente de un pedido: los primeros IDs (1 de cada CLIENTES_POR_FRECUENTE)
+ * son clientes frecuentes y hacen PORCENTAJE_PEDIDOS_FRECUENTES de los pedidos.
+ * @return ID del cliente.
+ */
+static int elegirCliente(GeneradorXoshiro *generador, const ContextoGeneracion *contexto) {
+    int frecuentes = contexto->cantidadClientes / CLIENTES_POR_FRECUENTE;
+    if (frecuentes < 1) frecuentes = 1;
+    if (enteroHasta(generador, 100) < PORCENTAJE_PEDIDOS_FRECUENTES) {
+        return enteroHasta(generador, frecuentes) + 1;
+    }
+    return enteroHasta(generador, contexto->cantidadClientes) + 1;
+}
+
+static bool construirAlimentoGenerado(void *nodo, int id, const ContextoGeneracion *contexto) {
+    Alimento *nuevo = (Alimento *)nodo;
+    GeneradorXoshiro generador;
+    sembrarGenerador(&generador, contexto->semilla, GENERAR_ALIMENTOS, id);
+    nuevo->id = id;
+    // El producto de dos uniformes carga los precios hacia los baratos (15.00 a 250.00)
+    double precio = 15.0 + 235.0 * unitario(&generador) * unitario(&generador);
+    nuevo->precio = (float)((int)(precio * 100.0) / 100.0);
+    nuevo->disponible = enteroHasta(&generador, 10) != 0; // 90% disponibles
+    char texto[24];
+    int longitud = snprintf(texto, sizeof(texto), "Alimento%d", id);
+    return internarCadena(texto, (size_t)longitud, &nuevo->nombre);
+}
+
+static bool construirClienteGenerado(void *nodo, int id, const ContextoGeneracion *contexto) {
+    Cliente *nuevo = (Cliente *)nodo;
+    GeneradorXoshiro generador;
+    sembrarGenerador(&generador, contexto->semilla, GENERAR_CLIENTES, id);
+    nuevo->idCliente = id;
+    snprintf(nuevo->telefono, sizeof(nuevo->telefono), "55%08d", enteroHasta(&generador, 100000000));
+    char texto[24];
+    int longitud = snprintf(texto, sizeof(texto), "Cliente%d", id);
+    return internarCadena(texto, (size_t)longitud, &nuevo->nombre);
+}
+
+static bool construirMenuGenerado(void *nodo, int id, const ContextoGeneracion *contexto) {
+    Menu *nuevo = (Menu *)nodo;
+    GeneradorXoshiro generador;
+    sembrarGenerador(&generador, contexto->semilla, GENERAR_MENUS, id);
+    nuevo->idMenu = id;
+    nuevo->fecha = fechaDe2024(elegirDia(&generador, contexto));
+    nuevo->numAlimentos = enteroHasta(&generador, 5) + 1; // Entre 1 y 5 alimentos
+    for (int j = 0; j < nuevo->numAlimentos; j++) {
+        nuevo->alimentos[j] = enteroHasta(&generador, contexto->cantidadAlimentos) + 1;
+    }
+    return true;
+}
+
+static bool construirPedidoGenerado(void *nodo, int id, const ContextoGeneracion *contexto) {
+    Pedido *nuevo = (Pedido *)nodo;
+    GeneradorXoshiro generador;
+    sembrarGenerador(&generador, contexto->semilla, GENERAR_PEDIDOS, id);
+    nuevo->idPedido = id;
+    nuevo->idCliente = elegirCliente(&generador, contexto);
+    int dia = elegirDia(&generador, contexto);
+    nuevo->fecha = fechaDe2024(dia);
+
+    int tamano = enteroHasta(&generador, 100); // 55% de un menú, 30% de dos y 15% de tres
+    nuevo->numMenus = tamano < 55 ? 1 : (tamano < 85 ? 2 : 3);
+    for (int j = 0; j < nuevo->numMenus; j++) {
+        nuevo->menus[j] = elegirMenu(&generador, contexto);
+    }
+
+    // Los pedidos de diciembre son los recientes: la mitad sigue pendiente
+    int estado = enteroHasta(&generador, 100);
+    int pendientes = dia >= PRIMER_DIA_DICIEMBRE ? 50 : 1;
+    int enProceso = dia >= PRIMER_DIA_DICIEMBRE ? 30 : 2;
+    const char *texto = estado < pendientes ? "Pendiente" : (estado < pendientes + enProceso ? "En Proceso" : "Completado");
+    strcpy(nuevo->estado, texto);
+    return true;
+}
+
+/**
+ * @brief Construye el nodo del registro con el ID indicado.
+ * @return `true` si se construyó, `false` si no hubo memoria para sus textos.
+ */
+typedef bool (*ConstruirGenerado)(void *nodo, int id, const ContextoGeneracion *contexto);
+
+/**
+ * @brief Enlaza un nodo ya construido en su tabla (ver restaurarAlimento y similares).
+ */
+typedef bool (*RestaurarGenerado)(void *tabla, void *nodo);
+
+static bool restaurarAlimentoGenerado(void *tabla, void *nodo) { return restaurarAlimento(tabla, nodo); }
+static bool restaurarClienteGenerado(void *tabla, void *nodo) { return restaurarCliente(tabla, nodo); }
+static bool restaurarMenuGenerado(void *tabla, void *nodo) { return restaurarMenu(tabla, nodo); }
+static bool restaurarPedidoGenerado(void *tabla, void *nodo) { return restaurarPedido(tabla, nodo); }
+
+/**
+ * @brief Tabla cuyos nodos se construyen en paralelo dentro de su bloque.
+ */
+typedef struct {
+    char *bloque;
+    size_t tamanoNodo;
+    ConstruirGenerado construir;
+    const ContextoGeneracion *contexto;
+    bool completa;  ///< Se pone en `false` si algún nodo no se pudo construir.
+} ConstruccionGenerada;
+
+static void construirRangoGenerado(long long inicio, long long fin, void *argumento) {
+    ConstruccionGenerada *construccion = (ConstruccionGenerada *)argumento;
+    for (long long i = inicio; i < fin; i++) {
+        if (!construccion->construir(construccion->bloque + i * construccion->tamanoNodo, (int)i + 1,
+                                     construccion->contexto)) {
+            __atomic_store_n(&construccion->completa, false, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * @brief Genera los registros 1..cantidad de una tabla vacía.
+ *
+ * Los nodos se construyen en paralelo dentro del bloque de la tabla y después se
+ * enlazan en orden. Si no se pudo reservar el bloque, cada nodo se reserva con `malloc`.
+ *
+ * @param tabla Tabla a llenar (vacía).
+ * @param bloqueNodos Bloque de nodos de la tabla.
+ * @param cantidad Registros a generar.
+ * @param tamanoNodo Tamaño de cada nodo.
+ * @param construir Función que construye un nodo.
+ * @param restaurar Función que enlaza un nodo en la tabla.
+ * @param contexto Datos de la generación.
+ * @return `true` si se crearon todos los nodos, `false` si no hubo memoria.
+ */
+static bool llenarTablaGenerada(void *tabla, BloqueNodos *bloqueNodos, int cantidad, size_t tamanoNodo,
+                                ConstruirGenerado construir, RestaurarGenerado restaurar,
+                                const ContextoGeneracion *contexto) {
+    if (cantidad <= 0) return true;
+    char *bloque = (char *)reservarBloqueNodos(bloqueNodos, (size_t)cantidad, tamanoNodo);
+    if (bloque) {
+        ConstruccionGenerada construccion = { bloque, tamanoNodo, construir, contexto, true };
+        paraCadaRango(cantidad, REGISTROS_POR_TAREA, construirRangoGenerado, &construccion);
+        if (!construccion.completa) return false;
+    }
+    for (int i = 0; i < cantidad; i++) {
+        void *nuevo = bloque ? bloque + (size_t)i * tamanoNodo : malloc(tamanoNodo);
+        if (!nuevo) {
+            return false;
+        }
+        if (!bloque && !construir(nuevo, i + 1, contexto)) {
+            free(nuevo);
+            return false;
+        }
+        restaurar(tabla, nuevo); // Los IDs son consecutivos: no hay repetidos
+    }
+    return true;
+}
+
+/**
+ * @brief Reemplaza el contenido de las tablas con datos generados de IDs consecutivos desde 1.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param cantidadAlimentos Alimentos a generar.
+ * @param cantidadClientes Clientes a generar.
+ * @param cantidadMenus Menús a generar.
+ * @param cantidadPedidos Pedidos a generar.
+ * @param semilla Semilla; la misma semilla y cantidades generan los mismos datos.
+ * @return `true` si se generaron todos los registros, `false` si no hubo memoria.
+ */
+bool generarDatos(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes,
+                  PedidosHashTable *tablaPedidos, int cantidadAlimentos, int cantidadClientes, int cantidadMenus,
+                  int cantidadPedidos, unsigned long long semilla)
+{
+    // Sin alimentos no hay de dónde elegir para los menús; sin clientes o menús, para los pedidos
+    if (cantidadAlimentos < 0) cantidadAlimentos = 0;
+    if (cantidadClientes < 0) cantidadClientes = 0;
+    if (cantidadMenus < 0 || cantidadAlimentos == 0) cantidadMenus = 0;
+    if (cantidadPedidos < 0 || cantidadClientes == 0 || cantidadMenus == 0) cantidadPedidos = 0;
+
+    ContextoGeneracion *contexto = (ContextoGeneracion *)malloc(sizeof(ContextoGeneracion));
+    double *acumuladaMenus = (double *)malloc((cantidadMenus > 0 ? (size_t)cantidadMenus : 1) * sizeof(double));
+    if (!contexto || !acumuladaMenus) {
+        printf("\nError: No hay memoria suficiente para generar los datos.\n");
+        free(contexto);
+        free(acumuladaMenus);
+        return false;
+    }
+    contexto->semilla = semilla;
+    contexto->cantidadAlimentos = cantidadAlimentos;
+    contexto->cantidadClientes = cantidadClientes;
+    contexto->cantidadMenus = cantidadMenus;
+    contexto->acumuladaMenus = acumuladaMenus;
+
+    double suma = 0.0;
+    for (int i = 0; i < cantidadMenus; i++) {
+        suma += 1.0 / (i + 1);
+        acumuladaMenus[i] = suma;
+    }
+    int acumulado = 0;
+    for (int dia = 0; dia < DIAS_ANIO; dia++) {
+        int mes = 0, restante = dia;
+        while (restante >= diasPorMes[mes]) restante -= diasPorMes[mes++];
+        int diaSemana = dia % 7; // 2024-01-01 fue lunes (0)
+        acumulado += pesoPorMes[mes] * (diaSemana >= 4 ? 3 : 2); // De viernes a domingo, 50% más
+        contexto->acumuladaDias[dia] = acumulado;
+    }
+
+    vaciarTablaAlimentos(tablaAlimentos);
+    vaciarTablaClientes(tablaClientes);
+    vaciarTablaMenus(tablaMenus);
+    vaciarTablaPedidos(tablaPedidos);
+    if (convieneReservarRango(cantidadAlimentos, cantidadAlimentos)) reservarRangoDensoAlimentos(tablaAlimentos, cantidadAlimentos);
+    if (convieneReservarRango(cantidadClientes, cantidadClientes)) reservarRangoDensoClientes(tablaClientes, cantidadClientes);
+    if (convieneReservarRango(cantidadMenus, cantidadMenus)) reservarRangoDensoMenus(tablaMenus, cantidadMenus);
+    if (convieneReservarRango(cantidadPedidos, cantidadPedidos)) reservarRangoDensoPedidos(tablaPedidos, cantidadPedidos);
+
+    bool completo =
+        llenarTablaGenerada(tablaAlimentos, &tablaAlimentos->bloqueNodos, cantidadAlimentos, sizeof(Alimento),
+                            construirAlimentoGenerado, restaurarAlimentoGenerado, contexto) &&
+        llenarTablaGenerada(tablaClientes, &tablaClientes->bloqueNodos, cantidadClientes, sizeof(Cliente),
+                            construirClienteGenerado, restaurarClienteGenerado, contexto) &&
+        llenarTablaGenerada(tablaMenus, &tablaMenus->bloqueNodos, cantidadMenus, sizeof(Menu),
+                            construirMenuGenerado, restaurarMenuGenerado, contexto) &&
+        llenarTablaGenerada(tablaPedidos, &tablaPedidos->bloqueNodos, cantidadPedidos, sizeof(Pedido),
+                            construirPedidoGenerado, restaurarPedidoGenerado, contexto);
+
+    free(acumuladaMenus);
+    free(contexto);
+    if (!completo) {
+        printf("\nError: No hay memoria suficiente para generar los datos. Los datos quedaron incompletos.\n");
+    }
+    return completo;
+}
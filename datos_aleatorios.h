@@ -0,0 +1,55 @@
+/**
+ * @file datos_aleatorios.h
+ * @brief Generación reproducible de datos sintéticos para llenar las tablas.
+ *
+ * Cada registro obtiene su propio generador xoshiro256** sembrado a partir de la
+ * semilla, la tabla y el ID (un generador basado en contador), así que los datos no
+ * dependen del número de hilos ni del orden en que se construyan: la misma semilla
+ * produce exactamente los mismos registros.
+ *
+ * Los datos imitan un restaurante real en lugar de ser uniformes: unos pocos menús
+ * concentran la mayoría de los pedidos (distribución de Zipf), un 1% de clientes
+ * frecuentes hace el 30% de los pedidos y las fechas siguen la temporada (más pedidos
+ * en mayo y diciembre, y de viernes a domingo). Los pedidos de diciembre son los que
+ * siguen pendientes o en proceso.
+ *
+ * Los nodos se construyen en paralelo dentro del bloque de cada tabla (ver
+ * bloque_nodos.h), como al restaurar un snapshot, y se enlazan sin pasar por la
+ * bitácora: quien genera debe llamar después a `puntoDeControlBitacora`.
+ */
+
+#ifndef DATOS_ALEATORIOS_H
+#define DATOS_ALEATORIOS_H
+
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Semilla que se usa cuando no se indica otra.
+#define GENERACION_SEMILLA_POR_OMISION 20240601ULL
+
+/**
+ * @brief Reemplaza el contenido de las tablas con datos generados de IDs consecutivos desde 1.
+ *
+ * Las referencias son válidas por construcción: cada menú usa alimentos existentes y
+ * cada pedido, un cliente y menús existentes. Sin alimentos no se generan menús, y sin
+ * clientes o sin menús no se generan pedidos.
+ *
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param cantidadAlimentos Alimentos a generar.
+ * @param cantidadClientes Clientes a generar.
+ * @param cantidadMenus Menús a generar.
+ * @param cantidadPedidos Pedidos a generar.
+ * @param semilla Semilla; la misma semilla y cantidades generan los mismos datos.
+ * @return `true` si se generaron todos los registros, `false` si no hubo memoria.
+ */
+bool generarDatos(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes,
+                  PedidosHashTable *tablaPedidos, int cantidadAlimentos, int cantidadClientes, int cantidadMenus,
+                  int cantidadPedidos, unsigned long long semilla);
+
+#endif // DATOS_ALEATORIOS_H
@@ -1,208 +1,1151 @@
 /**
  * @file deserializar_datos.c
- * @brief Implementación de funciones para deserializar datos en formato YAML y cargarlos en tablas hash.
+ * @brief Implementación de la carga de datos en formato YAML hacia las tablas hash.
+ *
+ * El archivo se recorre una sola vez, línea por línea, directamente sobre su contenido
+ * en memoria (ver archivo_memoria.h): las claves y los valores se comparan y convierten
+ * en su lugar, sin copiarlos a cadenas intermedias, y cada registro se escribe en su
+ * nodo definitivo. Solo se acepta el subconjunto de YAML que genera `serializarDatos`:
+ *
+ *     alimentos:
+ *       - id: 1
+ *         nombre: "Tacos"
+ *         ...
+ *     menus:
+ *       - id: 1
+ *         fecha: "2024-01-01"
+ *         alimentos:
+ *           - id: 1          (los demás campos de cada alimento se ignoran)
+ *       - id: 2
+ *         alimentos: [1, 3]  (formato normalizado, ver serializarDatosNormalizados)
+ *     pedidos:
+ *       - id: 1
+ *         ...
+ *         menus: [1, 2]
+ *
+ * Los archivos grandes se leen con varios hilos (ver `leerDocumentoParalelo`).
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-//#include <yaml.h>
-#include "hash_alimentos.h"
-#include "hash_clientes.h"
-#include "hash_menus.h"
-#include "hash_pedidos.h"
+#include <limits.h>
+#include "deserializar_datos.h"
+#include "archivo_memoria.h"
+#include "rango_denso.h"
+#include "fechas.h"
+#include "mensajes.h"
+#include "tareas.h"
+#include "totales_pedidos.h"
 
+/**
+ * @brief Sección del documento que se está leyendo.
+ */
+typedef enum {
+    SECCION_NINGUNA,
+    SECCION_ALIMENTOS,
+    SECCION_CLIENTES,
+    SECCION_MENUS,
+    SECCION_PEDIDOS
+} SeccionYaml;
 
-/*
-    No pude terminar la deserialización. La dejo aqui con fines
-    propios, por lo que le pido que no la tome encuenta como parte
-    de la entrega final de mi proyecto.
-*/
+/**
+ * @brief Una línea del documento ya separada en sus partes (apuntan al archivo en memoria).
+ */
+typedef struct {
+    int sangria;          ///< Espacios al inicio de la línea (antes del guion o de la clave).
+    int columna;          ///< Columna donde empieza la clave.
+    bool guion;           ///< La línea empieza un elemento de lista ("- ").
+    const char *clave;    ///< Inicio de la clave.
+    size_t longitudClave; ///< Longitud de la clave.
+    const char *valor;    ///< Inicio del valor (sin espacios iniciales).
+    size_t longitudValor; ///< Longitud del valor (sin espacios ni '\r' finales); 0 si no hay.
+} LineaYaml;
 
+/**
+ * @brief Posición de lectura dentro del archivo.
+ */
+typedef struct {
+    const char *actual; ///< Inicio de la siguiente línea.
+    const char *fin;    ///< Fin del contenido.
+    int numLinea;       ///< Número de la última línea leída (desde 1).
+} LectorYaml;
 
 /**
  * @brief Valida y corrige el nombre del archivo para asegurar que tenga la extensión .yaml.
- * 
+ *
  * @param nombreArchivo Nombre del archivo proporcionado por el usuario.
+ * @param tamano Tamaño del arreglo `nombreArchivo`.
  */
-void validarNombreArchivo(char *nombreArchivo) {
+static void validarNombreArchivo(char *nombreArchivo, size_t tamano) {
     const char *extension = strrchr(nombreArchivo, '.');
-    if (!extension || strcmp(extension, ".yaml") != 0) {
+    if ((!extension || strcmp(extension, ".yaml") != 0) && strlen(nombreArchivo) + 5 < tamano) {
         strcat(nombreArchivo, ".yaml");
     }
 }
 
 /**
- * @brief Manejo genérico para cargar secuencias en YAML.
+ * @brief Lee la siguiente línea con contenido y la separa en columna, clave y valor.
+ *
+ * Se omiten las líneas vacías, los comentarios y los marcadores de documento (`---`, `...`).
+ *
+ * @param lector Posición de lectura.
+ * @param linea Resultado.
+ * @return 1 si se leyó una línea, 0 al llegar al final, -1 si la línea no tiene la forma `clave: valor`.
  */
-bool avanzarEnSecuencia(yaml_parser_t *parser) {
-    yaml_event_t event;
-    if (!yaml_parser_parse(parser, &event)) return false;
-    bool resultado = (event.type == YAML_SEQUENCE_START_EVENT);
-    yaml_event_delete(&event);
-    return resultado;
+static int siguienteLinea(LectorYaml *lector, LineaYaml *linea) {
+    while (lector->actual < lector->fin) {
+        const char *inicio = lector->actual;
+        const char *salto = memchr(inicio, '\n', (size_t)(lector->fin - inicio));
+        const char *finLinea = salto ? salto : lector->fin;
+        lector->actual = salto ? salto + 1 : lector->fin;
+        lector->numLinea++;
+
+        while (finLinea > inicio && (finLinea[-1] == '\r' || finLinea[-1] == ' ' || finLinea[-1] == '\t')) finLinea--;
+        const char *p = inicio;
+        while (p < finLinea && *p == ' ') p++;
+        if (p == finLinea || *p == '#') continue;
+        if (finLinea - p == 3 && (memcmp(p, "---", 3) == 0 || memcmp(p, "...", 3) == 0)) continue;
+
+        linea->sangria = (int)(p - inicio);
+        linea->guion = false;
+        if (*p == '-' && finLinea - p >= 2 && p[1] == ' ') {
+            linea->guion = true;
+            p += 2;
+            while (p < finLinea && *p == ' ') p++;
+        }
+        linea->columna = (int)(p - inicio);
+        linea->clave = p;
+        const char *dosPuntos = memchr(p, ':', (size_t)(finLinea - p));
+        if (!dosPuntos || dosPuntos == p || (dosPuntos + 1 < finLinea && dosPuntos[1] != ' ')) {
+            return -1;
+        }
+        linea->longitudClave = (size_t)(dosPuntos - p);
+        p = dosPuntos + 1;
+        while (p < finLinea && *p == ' ') p++;
+        linea->valor = p;
+        linea->longitudValor = (size_t)(finLinea - p);
+        return 1;
+    }
+    return 0;
 }
 
 /**
- * @brief Carga los alimentos desde un archivo YAML a una tabla hash.
+ * @brief Compara la clave de una línea con un texto.
+ * @param linea Línea leída.
+ * @param texto Clave esperada.
+ * @return `true` si son iguales.
  */
-void cargarAlimentos(yaml_parser_t *parser, HashTable *tablaAlimentos) {
-    yaml_event_t event;
-    int id = -1;
-    char nombre[50];
-    float precio = 0.0;
-    char disponibleStr[3] = "No";
+static bool claveEs(const LineaYaml *linea, const char *texto) {
+    size_t longitud = strlen(texto);
+    return linea->longitudClave == longitud && memcmp(linea->clave, texto, longitud) == 0;
+}
 
-    while (yaml_parser_parse(parser, &event) && event.type != YAML_SEQUENCE_END_EVENT) {
-        if (event.type == YAML_MAPPING_START_EVENT) {
-            id = -1;
-            nombre[0] = '\0';
-            precio = 0.0f;
-            strcpy(disponibleStr, "No");
-        } else if (event.type == YAML_SCALAR_EVENT) {
-            const char *clave = (char *)event.data.scalar.value;
+/**
+ * @brief Compara el valor de una línea con un texto.
+ * @param linea Línea leída.
+ * @param texto Valor esperado.
+ * @return `true` si son iguales.
+ */
+static bool valorEs(const LineaYaml *linea, const char *texto) {
+    size_t longitud = strlen(texto);
+    return linea->longitudValor == longitud && memcmp(linea->valor, texto, longitud) == 0;
+}
+
+/**
+ * @brief Convierte un ID decimal que ocupa exactamente `longitud` bytes.
+ *
+ * Los IDs negativos no se aceptan, como en la importación y el modo por lotes: las
+ * funciones hash de las tablas los convierten en índices fuera de sus buckets.
+ *
+ * @param texto Inicio del número.
+ * @param longitud Número de bytes.
+ * @param resultado Entero convertido.
+ * @return `true` si el texto es un entero no negativo dentro del rango de `int`.
+ */
+static bool leerEntero(const char *texto, size_t longitud, int *resultado) {
+    if (longitud == 0) return false;
+    long long valor = 0;
+    for (size_t i = 0; i < longitud; i++) {
+        if (texto[i] < '0' || texto[i] > '9') return false;
+        valor = valor * 10 + (texto[i] - '0');
+        if (valor > INT_MAX) return false;
+    }
+    *resultado = (int)valor;
+    return true;
+}
+
+/**
+ * @brief Convierte un número decimal (por ejemplo "12.50").
+ *
+ * El texto se copia a un arreglo local porque `strtof` necesita el terminador
+ * y el archivo en memoria es de solo lectura.
+ *
+ * @param texto Inicio del número.
+ * @param longitud Número de bytes.
+ * @param resultado Número convertido.
+ * @return `true` si todo el texto forma un número válido.
+ */
+static bool leerDecimal(const char *texto, size_t longitud, float *resultado) {
+    char copia[64];
+    if (longitud == 0 || longitud >= sizeof(copia)) return false;
+    memcpy(copia, texto, longitud);
+    copia[longitud] = '\0';
+    char *fin;
+    *resultado = strtof(copia, &fin);
+    return fin == copia + longitud;
+}
 
-            yaml_event_delete(&event);
-            yaml_parser_parse(parser, &event);
-            if (strcmp(clave, "id") == 0) {
-                id = atoi((char *)event.data.scalar.value);
-            } else if (strcmp(clave, "nombre") == 0) {
-                strcpy(nombre, (char *)event.data.scalar.value);
-            } else if (strcmp(clave, "precio") == 0) {
-                precio = atof((char *)event.data.scalar.value);
-            } else if (strcmp(clave, "disponible") == 0) {
-                strcpy(disponibleStr, (char *)event.data.scalar.value);
+/**
+ * @brief Valor de texto de una línea sin sus comillas dobles, si las tiene.
+ * @param linea Línea con el valor.
+ * @param longitud Bytes del texto (de salida).
+ * @return Inicio del texto.
+ */
+static const char *valorTexto(const LineaYaml *linea, size_t *longitud) {
+    const char *texto = linea->valor;
+    *longitud = linea->longitudValor;
+    if (*longitud >= 2 && texto[0] == '"' && texto[*longitud - 1] == '"') {
+        texto++;
+        *longitud -= 2;
+    }
+    return texto;
+}
+
+/**
+ * @brief Indica si el valor de texto (con o sin comillas dobles) es exactamente `texto`.
+ */
+static bool textoEs(const LineaYaml *linea, const char *texto) {
+    size_t longitud;
+    const char *valor = valorTexto(linea, &longitud);
+    return longitud == strlen(texto) && memcmp(valor, texto, longitud) == 0;
+}
+
+/**
+ * @brief Copia un valor de texto (con o sin comillas dobles) a un arreglo de tamaño fijo.
+ *
+ * Si el texto no cabe se trunca, dejando siempre el terminador.
+ *
+ * @param destino Arreglo destino.
+ * @param tamano Tamaño del arreglo destino.
+ * @param linea Línea cuyo valor se copia.
+ */
+static void copiarTexto(char *destino, size_t tamano, const LineaYaml *linea) {
+    size_t longitud;
+    const char *texto = valorTexto(linea, &longitud);
+    if (longitud >= tamano) longitud = tamano - 1;
+    memcpy(destino, texto, longitud);
+    destino[longitud] = '\0';
+}
+
+/**
+ * @brief Interna un valor de texto (con o sin comillas dobles) sin copiarlo antes.
+ *
+ * Si el texto tiene `tamano` bytes o más se trunca a `tamano - 1`, el mismo límite que
+ * tenían los arreglos fijos y que guardan los snapshots binarios.
+ *
+ * @param linea Línea cuyo valor se interna.
+ * @param tamano Límite del texto, contando el terminador.
+ * @param cadena Cadena del texto (de salida).
+ * @return `true` si se internó.
+ */
+static bool internarValor(const LineaYaml *linea, size_t tamano, Cadena *cadena) {
+    size_t longitud;
+    const char *texto = valorTexto(linea, &longitud);
+    if (longitud >= tamano) longitud = tamano - 1;
+    return internarCadena(texto, longitud, cadena);
+}
+
+/**
+ * @brief Convierte una fecha "AAAA-MM-DD" (con o sin comillas dobles).
+ *
+ * Un valor vacío es una fecha ausente (FECHA_NULA), como la que escribe `serializarDatos`
+ * para un registro sin fecha.
+ *
+ * @param linea Línea cuyo valor es la fecha.
+ * @param fecha Fecha convertida.
+ * @return `true` si el valor está vacío o es una fecha válida.
+ */
+static bool leerFechaYaml(const LineaYaml *linea, Fecha *fecha) {
+    const char *texto = linea->valor;
+    size_t longitud = linea->longitudValor;
+    if (longitud >= 2 && texto[0] == '"' && texto[longitud - 1] == '"') {
+        texto++;
+        longitud -= 2;
+    }
+    if (longitud == 0) {
+        *fecha = FECHA_NULA;
+        return true;
+    }
+    return leerFecha(texto, longitud, fecha);
+}
+
+/**
+ * @brief Convierte una lista en línea de enteros, por ejemplo "[1, 2, 3]".
+ * @param linea Línea cuyo valor es la lista.
+ * @param ids Arreglo destino.
+ * @param maximo Capacidad del arreglo destino.
+ * @param numIds Número de enteros leídos.
+ * @return `true` si la lista es válida y cabe en el arreglo.
+ */
+static bool leerListaEnteros(const LineaYaml *linea, int *ids, int maximo, int *numIds) {
+    const char *p = linea->valor;
+    const char *fin = linea->valor + linea->longitudValor;
+    *numIds = 0;
+    if (fin - p < 2 || p[0] != '[' || fin[-1] != ']') return false;
+    p++;
+    fin--;
+    while (p < fin && *p == ' ') p++;
+    while (p < fin) {
+        const char *coma = memchr(p, ',', (size_t)(fin - p));
+        const char *finNumero = coma ? coma : fin;
+        while (finNumero > p && finNumero[-1] == ' ') finNumero--;
+        if (*numIds == maximo || !leerEntero(p, (size_t)(finNumero - p), &ids[*numIds])) return false;
+        (*numIds)++;
+        if (!coma) break;
+        p = coma + 1;
+        while (p < fin && *p == ' ') p++;
+        if (p == fin) return false; // Coma sin elemento después
+    }
+    return true;
+}
+
+/**
+ * @brief Registro que se está leyendo; solo uno de los nodos está en uso según la sección.
+ */
+typedef struct {
+    Alimento *alimento;
+    Cliente *cliente;
+    Menu *menu;
+    Pedido *pedido;
+    bool tieneId;           ///< Ya se leyó el campo `id`.
+    bool enListaAlimentos;  ///< Se están leyendo los elementos de `alimentos:` de un menú.
+    int columnaCampos;      ///< Columna de las claves del registro, o -1 si aún no hay registros.
+} RegistroYaml;
+
+/**
+ * @brief Prepara el nodo vacío de un registro nuevo de la sección indicada.
+ * @param registro Registro en curso (no debe tener nodo).
+ * @param seccion Sección actual.
+ * @param nodo Memoria para el nodo, o `NULL` para reservarla con `malloc`.
+ * @return `true` si el nodo está listo.
+ */
+static bool iniciarRegistro(RegistroYaml *registro, SeccionYaml seccion, void *nodo) {
+    registro->tieneId = false;
+    registro->enListaAlimentos = false;
+    switch (seccion) {
+        case SECCION_ALIMENTOS:
+            registro->alimento = nodo ? (Alimento *)nodo : (Alimento *)malloc(sizeof(Alimento));
+            if (!registro->alimento) return false;
+            registro->alimento->nombre = CADENA_VACIA;
+            registro->alimento->precio = 0.0f;
+            registro->alimento->disponible = 0;
+            return true;
+        case SECCION_CLIENTES:
+            registro->cliente = nodo ? (Cliente *)nodo : (Cliente *)malloc(sizeof(Cliente));
+            if (!registro->cliente) return false;
+            registro->cliente->nombre = CADENA_VACIA;
+            registro->cliente->telefono[0] = '\0';
+            return true;
+        case SECCION_MENUS:
+            registro->menu = nodo ? (Menu *)nodo : (Menu *)malloc(sizeof(Menu));
+            if (!registro->menu) return false;
+            registro->menu->fecha = FECHA_NULA;
+            registro->menu->numAlimentos = 0;
+            return true;
+        case SECCION_PEDIDOS:
+            registro->pedido = nodo ? (Pedido *)nodo : (Pedido *)malloc(sizeof(Pedido));
+            if (!registro->pedido) return false;
+            registro->pedido->idCliente = 0;
+            registro->pedido->fecha = FECHA_NULA;
+            registro->pedido->estado[0] = '\0';
+            registro->pedido->numMenus = 0;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Libera el nodo del registro en curso sin insertarlo.
+ * @param registro Registro en curso.
+ */
+static void descartarRegistro(RegistroYaml *registro) {
+    if (registro->alimento) soltarCadena(registro->alimento->nombre);
+    if (registro->cliente) soltarCadena(registro->cliente->nombre);
+    free(registro->alimento);
+    free(registro->cliente);
+    free(registro->menu);
+    free(registro->pedido);
+    registro->alimento = NULL;
+    registro->cliente = NULL;
+    registro->menu = NULL;
+    registro->pedido = NULL;
+}
+
+/**
+ * @brief Inserta en su tabla el nodo del registro en curso.
+ * @param registro Registro en curso.
+ * @param tablaAlimentos Tabla de alimentos.
+ * @param tablaClientes Tabla de clientes.
+ * @param tablaMenus Tabla de menús.
+ * @param tablaPedidos Tabla de pedidos.
+ * @param duplicados Contador de registros omitidos por ID repetido; se incrementa.
+ * @return `false` si el registro no tenía `id`.
+ */
+static bool cerrarRegistro(RegistroYaml *registro, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                           MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, long long *duplicados) {
+    bool hayNodo = registro->alimento || registro->cliente || registro->menu || registro->pedido;
+    if (!hayNodo) return true;
+    if (!registro->tieneId) {
+        descartarRegistro(registro);
+        return false;
+    }
+    bool insertado = true;
+    if (registro->alimento) insertado = restaurarAlimento(tablaAlimentos, registro->alimento);
+    else if (registro->cliente) insertado = restaurarCliente(tablaClientes, registro->cliente);
+    else if (registro->menu) insertado = restaurarMenu(tablaMenus, registro->menu);
+    else insertado = restaurarPedido(tablaPedidos, registro->pedido);
+
+    if (insertado) {
+        registro->alimento = NULL;
+        registro->cliente = NULL;
+        registro->menu = NULL;
+        registro->pedido = NULL;
+    } else {
+        descartarRegistro(registro);
+        (*duplicados)++;
+    }
+    return true;
+}
+
+/**
+ * @brief Guarda en el nodo del registro en curso el campo de una línea.
+ *
+ * Las claves desconocidas se ignoran.
+ *
+ * @param registro Registro en curso.
+ * @param linea Línea con el campo.
+ * @return Descripción del error, o `NULL` si el valor es válido.
+ */
+static const char *leerCampo(RegistroYaml *registro, const LineaYaml *linea) {
+    registro->enListaAlimentos = false;
+    if (claveEs(linea, "id")) {
+        int id;
+        if (!leerEntero(linea->valor, linea->longitudValor, &id)) return "id no válido";
+        if (registro->alimento) registro->alimento->id = id;
+        else if (registro->cliente) registro->cliente->idCliente = id;
+        else if (registro->menu) registro->menu->idMenu = id;
+        else registro->pedido->idPedido = id;
+        registro->tieneId = true;
+    } else if (registro->alimento) {
+        Alimento *alimento = registro->alimento;
+        if (claveEs(linea, "nombre")) {
+            if (!internarValor(linea, 50, &alimento->nombre)) return "no hay memoria para el texto";
+        } else if (claveEs(linea, "precio")) {
+            if (!leerDecimal(linea->valor, linea->longitudValor, &alimento->precio)) return "precio no válido";
+        } else if (claveEs(linea, "disponible")) {
+            if (textoEs(linea, "Si")) alimento->disponible = 1;
+            else if (textoEs(linea, "No")) alimento->disponible = 0;
+            else return "disponible debe ser Si o No";
+        }
+    } else if (registro->cliente) {
+        Cliente *cliente = registro->cliente;
+        if (claveEs(linea, "nombre")) {
+            if (!internarValor(linea, 50, &cliente->nombre)) return "no hay memoria para el texto";
+        } else if (claveEs(linea, "telefono")) {
+            copiarTexto(cliente->telefono, sizeof(cliente->telefono), linea);
+        }
+    } else if (registro->menu) {
+        Menu *menu = registro->menu;
+        if (claveEs(linea, "fecha")) {
+            if (!leerFechaYaml(linea, &menu->fecha)) return "fecha no válida (use AAAA-MM-DD)";
+        } else if (claveEs(linea, "alimentos")) {
+            if (linea->longitudValor == 0) registro->enListaAlimentos = true;
+            else if (!leerListaEnteros(linea, menu->alimentos, 50, &menu->numAlimentos)) return "lista de alimentos no válida";
+        }
+    } else {
+        Pedido *pedido = registro->pedido;
+        if (claveEs(linea, "cliente_id")) {
+            if (!leerEntero(linea->valor, linea->longitudValor, &pedido->idCliente)) return "cliente_id no válido";
+        } else if (claveEs(linea, "fecha")) {
+            if (!leerFechaYaml(linea, &pedido->fecha)) return "fecha no válida (use AAAA-MM-DD)";
+        } else if (claveEs(linea, "estado")) {
+            copiarTexto(pedido->estado, sizeof(pedido->estado), linea);
+        } else if (claveEs(linea, "menus")) {
+            if (!leerListaEnteros(linea, pedido->menus, 50, &pedido->numMenus)) return "lista de menús no válida";
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Procesa una línea de la lista `alimentos:` de un menú; de cada alimento solo importa su id.
+ * @param registro Registro en curso (un menú).
+ * @param linea Línea más indentada que los campos del menú.
+ * @return Descripción del error, o `NULL` si la línea es válida.
+ */
+static const char *leerElementoAnidado(RegistroYaml *registro, const LineaYaml *linea) {
+    if (!linea->guion) return NULL;
+    Menu *menu = registro->menu;
+    if (!claveEs(linea, "id")) return "se esperaba el id del alimento";
+    if (menu->numAlimentos == 50) return "el menú tiene más de 50 alimentos";
+    if (!leerEntero(linea->valor, linea->longitudValor, &menu->alimentos[menu->numAlimentos])) return "id no válido";
+    menu->numAlimentos++;
+    return NULL;
+}
+
+/**
+ * @brief Devuelve el ID del nodo del registro en curso.
+ * @param registro Registro en curso (con nodo).
+ * @return ID del registro.
+ */
+static int idRegistro(const RegistroYaml *registro) {
+    if (registro->alimento) return registro->alimento->id;
+    if (registro->cliente) return registro->cliente->idCliente;
+    if (registro->menu) return registro->menu->idMenu;
+    return registro->pedido->idPedido;
+}
+
+/**
+ * @brief Recorre el documento y llena las tablas (vacías) con sus registros.
+ * @param archivo Contenido del archivo.
+ * @param nombreArchivo Nombre del archivo (para los mensajes de error).
+ * @param tablaAlimentos Tabla de alimentos.
+ * @param tablaClientes Tabla de clientes.
+ * @param tablaMenus Tabla de menús.
+ * @param tablaPedidos Tabla de pedidos.
+ * @param duplicados Contador de registros omitidos por ID repetido.
+ * @return `true` si el documento se leyó completo, `false` si tiene errores.
+ */
+static bool leerDocumento(const ArchivoEnMemoria *archivo, const char *nombreArchivo, HashTable *tablaAlimentos,
+                          ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos,
+                          long long *duplicados) {
+    LectorYaml lector = { (const char *)archivo->datos, (const char *)archivo->datos + archivo->tamano, 0 };
+    RegistroYaml registro = { NULL, NULL, NULL, NULL, false, false, -1 };
+    SeccionYaml seccion = SECCION_NINGUNA;
+    LineaYaml linea;
+    const char *error = NULL;
+    int resultado;
+
+    while (!error && (resultado = siguienteLinea(&lector, &linea)) != 0) {
+        if (resultado < 0) {
+            error = "se esperaba 'clave: valor'";
+        } else if (linea.columna == 0 && !linea.guion) {
+            // Encabezado de sección
+            if (!cerrarRegistro(&registro, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, duplicados)) {
+                error = "registro sin id";
+            } else if (linea.longitudValor != 0 && !valorEs(&linea, "[]")) {
+                error = "se esperaba una lista";
+            } else if (claveEs(&linea, "alimentos")) {
+                seccion = SECCION_ALIMENTOS;
+            } else if (claveEs(&linea, "clientes")) {
+                seccion = SECCION_CLIENTES;
+            } else if (claveEs(&linea, "menus")) {
+                seccion = SECCION_MENUS;
+            } else if (claveEs(&linea, "pedidos")) {
+                seccion = SECCION_PEDIDOS;
+            } else {
+                error = "sección desconocida";
             }
-        } else if (event.type == YAML_MAPPING_END_EVENT) {
-            if (!insertarAlimento(tablaAlimentos, id, nombre, precio, disponibleStr)) {
-                printf("\nError al insertar el alimento con ID=%d\n", id);
+            registro.columnaCampos = -1;
+        } else if (seccion == SECCION_NINGUNA) {
+            error = "registro fuera de una sección";
+        } else if (linea.guion && (registro.columnaCampos < 0 || linea.columna == registro.columnaCampos)) {
+            // Nuevo registro de la sección
+            if (!cerrarRegistro(&registro, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, duplicados)) {
+                error = "registro sin id";
+            } else if (!iniciarRegistro(&registro, seccion, NULL)) {
+                error = "no hay memoria suficiente";
+            } else {
+                registro.columnaCampos = linea.columna;
+                error = leerCampo(&registro, &linea);
             }
+        } else if (linea.columna == registro.columnaCampos && !linea.guion) {
+            error = leerCampo(&registro, &linea);
+        } else if (linea.columna > registro.columnaCampos && registro.enListaAlimentos) {
+            error = leerElementoAnidado(&registro, &linea);
+        } else {
+            error = "sangría inesperada";
         }
-        yaml_event_delete(&event);
     }
+    if (!error && !cerrarRegistro(&registro, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, duplicados)) {
+        error = "registro sin id";
+    }
+    if (error) {
+        descartarRegistro(&registro);
+        printf("\nError: '%s', línea %d: %s.\n", nombreArchivo, lector.numLinea, error);
+        return false;
+    }
+    return true;
 }
 
 /**
- * @brief Carga los clientes desde un archivo YAML a una tabla hash.
+ * @brief Conteo de los elementos de lista de un segmento (líneas entre dos encabezados de sección).
+ *
+ * Los registros de una sección son los elementos con la menor sangría de la sección;
+ * los elementos más indentados pertenecen a listas anidadas (los alimentos de un menú).
  */
-void cargarClientes(yaml_parser_t *parser, ClientesHashTable *tablaClientes) {
-    yaml_event_t event;
-    int id = -1;
-    char nombre[50];
-    char telefono[15];
+typedef struct {
+    int sangriaMinima;     ///< Menor sangría de las líneas con guion, o INT_MAX si no hay.
+    long long numGuiones;  ///< Líneas con guion que tienen esa sangría.
+} ConteoSegmento;
 
-    while (yaml_parser_parse(parser, &event) && event.type != YAML_SEQUENCE_END_EVENT) {
-        if (event.type == YAML_MAPPING_START_EVENT) {
-            id = -1;
-            nombre[0] = '\0';
-            telefono[0] = '\0';
-        } else if (event.type == YAML_SCALAR_EVENT) {
-            const char *clave = (char *)event.data.scalar.value;
+/**
+ * @brief Tramo del archivo que recorre un hilo en la primera pasada.
+ *
+ * Un tramo contiene las líneas que empiezan entre `inicio` y `fin`. Los encabezados
+ * de sección que aparecen en él lo dividen en `numEncabezados + 1` segmentos.
+ */
+typedef struct {
+    const char *inicio;          ///< Inicio de la primera línea del tramo.
+    const char *fin;             ///< Inicio de la primera línea del tramo siguiente.
+    int numLineas;               ///< Líneas que empiezan en el tramo.
+    int numEncabezados;          ///< Encabezados de sección encontrados.
+    int capacidad;               ///< Capacidad de los arreglos de encabezados.
+    const char **encabezados;    ///< Inicio de cada encabezado.
+    int *lineaEncabezado;        ///< Línea de cada encabezado, contada desde el inicio del tramo (desde 0).
+    ConteoSegmento *segmentos;   ///< Conteo de cada segmento (numEncabezados + 1).
+    bool sinMemoria;             ///< No se pudo ampliar la lista de encabezados.
+} TramoYaml;
 
-            yaml_event_delete(&event);
-            yaml_parser_parse(parser, &event);
-            if (strcmp(clave, "id") == 0) {
-                id = atoi((char *)event.data.scalar.value);
-            } else if (strcmp(clave, "nombre") == 0) {
-                strcpy(nombre, (char *)event.data.scalar.value);
-            } else if (strcmp(clave, "telefono") == 0) {
-                strcpy(telefono, (char *)event.data.scalar.value);
+/**
+ * @brief Porción de una sección que un hilo convierte en nodos en la segunda pasada.
+ */
+typedef struct {
+    const char *inicio;       ///< Inicio del segmento.
+    const char *fin;          ///< Fin del segmento (el último registro puede continuar después).
+    int primeraLinea;         ///< Número de la primera línea del segmento (desde 1).
+    int instancia;            ///< Encabezado de sección al que pertenece (-1 antes del primero).
+    SeccionYaml seccion;      ///< Sección del segmento.
+    bool primeroDeSeccion;    ///< Es el primer segmento después del encabezado.
+    long long numRegistros;   ///< Registros que empiezan en el segmento.
+    long long primerNodo;     ///< Posición de su primer nodo en el bloque de la tabla.
+    int idMaximo;             ///< Mayor ID leído.
+    const char *error;        ///< Error encontrado, o `NULL`.
+    int lineaError;           ///< Línea del error.
+} FragmentoYaml;
+
+/// Tramos por hilo en la primera pasada (más tramos que hilos equilibra la carga).
+#define TRAMOS_POR_HILO 4
+
+/// Tamaño mínimo del archivo para usar varios hilos; por debajo la carga secuencial es igual de rápida.
+#define TAMANO_MINIMO_PARALELO (1 << 20)
+
+/**
+ * @brief Indica si una línea es un encabezado de sección (clave en la columna 0).
+ *
+ * Usa las mismas reglas que `siguienteLinea` para omitir líneas vacías, comentarios
+ * y marcadores de documento.
+ *
+ * @param p Inicio de la línea.
+ * @param finLinea Fin de la línea (sin el salto).
+ * @return `true` si la línea es un encabezado.
+ */
+static bool esEncabezado(const char *p, const char *finLinea) {
+    while (finLinea > p && (finLinea[-1] == '\r' || finLinea[-1] == ' ' || finLinea[-1] == '\t')) finLinea--;
+    if (p == finLinea || *p == ' ' || *p == '#') return false;
+    if (*p == '-' && finLinea - p >= 2 && p[1] == ' ') return false;
+    if (finLinea - p == 3 && (memcmp(p, "---", 3) == 0 || memcmp(p, "...", 3) == 0)) return false;
+    return true;
+}
+
+/**
+ * @brief Primera pasada sobre un tramo: cuenta líneas, ubica encabezados y cuenta guiones por segmento.
+ * @param tramo Tramo a recorrer.
+ */
+static void recorrerTramo(TramoYaml *tramo) {
+    ConteoSegmento *actual = &tramo->segmentos[0];
+    actual->sangriaMinima = INT_MAX;
+    actual->numGuiones = 0;
+
+    const char *p = tramo->inicio;
+    while (p < tramo->fin) {
+        const char *salto = memchr(p, '\n', (size_t)(tramo->fin - p));
+        const char *finLinea = salto ? salto : tramo->fin;
+
+        const char *q = p;
+        while (q < finLinea && *q == ' ') q++;
+        if (q == p && esEncabezado(p, finLinea)) {
+            if (tramo->numEncabezados + 1 == tramo->capacidad) {
+                int capacidad = tramo->capacidad * 2;
+                const char **encabezados = (const char **)realloc(tramo->encabezados, capacidad * sizeof(const char *));
+                if (encabezados) tramo->encabezados = encabezados;
+                int *lineas = (int *)realloc(tramo->lineaEncabezado, capacidad * sizeof(int));
+                if (lineas) tramo->lineaEncabezado = lineas;
+                ConteoSegmento *segmentos = (ConteoSegmento *)realloc(tramo->segmentos, (capacidad + 1) * sizeof(ConteoSegmento));
+                if (segmentos) tramo->segmentos = segmentos;
+                if (!encabezados || !lineas || !segmentos) {
+                    tramo->sinMemoria = true;
+                    return;
+                }
+                tramo->capacidad = capacidad;
             }
-        } else if (event.type == YAML_MAPPING_END_EVENT) {
-            if (!agregarCliente(tablaClientes, id, nombre, telefono)) {
-                printf("\nError al insertar el cliente con ID=%d\n", id);
+            tramo->encabezados[tramo->numEncabezados] = p;
+            tramo->lineaEncabezado[tramo->numEncabezados] = tramo->numLineas;
+            tramo->numEncabezados++;
+            actual = &tramo->segmentos[tramo->numEncabezados];
+            actual->sangriaMinima = INT_MAX;
+            actual->numGuiones = 0;
+        } else if (finLinea - q >= 2 && q[0] == '-' && q[1] == ' ') {
+            int sangria = (int)(q - p);
+            if (sangria < actual->sangriaMinima) {
+                actual->sangriaMinima = sangria;
+                actual->numGuiones = 1;
+            } else if (sangria == actual->sangriaMinima) {
+                actual->numGuiones++;
             }
         }
-        yaml_event_delete(&event);
-    }
-}
-
-/**
- * @brief Carga los menús desde un archivo YAML a una tabla hash.
- */
-void cargarMenus(yaml_parser_t *parser, MenuHashTable *tablaMenus, HashTable *tablaAlimentos) {
-    yaml_event_t event;
-    int idMenu = -1;
-    char fecha[11];
-    int alimentos[50];
-    int numAlimentos = 0;
-
-    while (yaml_parser_parse(parser, &event) && event.type != YAML_SEQUENCE_END_EVENT) {
-        if (event.type == YAML_MAPPING_START_EVENT) {
-            idMenu = -1;
-            fecha[0] = '\0';
-            numAlimentos = 0;
-        } else if (event.type == YAML_SCALAR_EVENT) {
-            const char *clave = (char *)event.data.scalar.value;
-
-            yaml_event_delete(&event);
-            yaml_parser_parse(parser, &event);
-            if (strcmp(clave, "id") == 0) {
-                idMenu = atoi((char *)event.data.scalar.value);
-            } else if (strcmp(clave, "fecha") == 0) {
-                strcpy(fecha, (char *)event.data.scalar.value);
-            } else if (strcmp(clave, "alimentos") == 0) {
-                if (avanzarEnSecuencia(parser)) {
-                    numAlimentos = 0;
-                    while (yaml_parser_parse(parser, &event) && event.type != YAML_SEQUENCE_END_EVENT) {
-                        if (event.type == YAML_SCALAR_EVENT) {
-                            alimentos[numAlimentos++] = atoi((char *)event.data.scalar.value);
-                        }
-                        yaml_event_delete(&event);
-                    }
+        tramo->numLineas++;
+        p = salto ? salto + 1 : tramo->fin;
+    }
+}
+
+/**
+ * @brief Segunda pasada: convierte los registros de un fragmento en nodos consecutivos del bloque de su tabla.
+ *
+ * Las líneas antes del primer registro pertenecen al último registro del fragmento
+ * anterior y se saltan. El último registro del fragmento se lee completo aunque
+ * continúe después de `fin`.
+ *
+ * @param fragmento Fragmento a leer; aquí se guardan el ID máximo y el error.
+ * @param finArchivo Fin del contenido del archivo.
+ * @param sangriaRegistro Sangría de los guiones que empiezan un registro de la sección.
+ * @param nodos Primer nodo del fragmento.
+ * @param tamanoNodo Tamaño de un nodo de la tabla.
+ */
+static void leerFragmento(FragmentoYaml *fragmento, const char *finArchivo, int sangriaRegistro, char *nodos, size_t tamanoNodo) {
+    LectorYaml lector = { fragmento->inicio, finArchivo, fragmento->primeraLinea - 1 };
+    RegistroYaml registro = { NULL, NULL, NULL, NULL, false, false, -1 };
+    LineaYaml linea;
+    long long leidos = 0;
+    bool enRegistro = false;
+    const char *error = NULL;
+    int resultado;
+
+    fragmento->idMaximo = INT_MIN;
+    while (!error && (resultado = siguienteLinea(&lector, &linea)) != 0) {
+        if (resultado < 0) {
+            error = "se esperaba 'clave: valor'";
+            break;
+        }
+        if (linea.columna == 0 && !linea.guion) {
+            break; // Encabezado de la sección siguiente
+        }
+        bool nuevoRegistro = linea.guion && linea.sangria == sangriaRegistro;
+        if (!enRegistro && !nuevoRegistro) {
+            if (fragmento->primeroDeSeccion || fragmento->numRegistros == 0) error = "sangría inesperada";
+            continue; // Continuación del último registro del fragmento anterior
+        }
+        if (nuevoRegistro) {
+            if (enRegistro) {
+                if (!registro.tieneId) {
+                    error = "registro sin id";
+                    break;
                 }
+                if (idRegistro(&registro) > fragmento->idMaximo) fragmento->idMaximo = idRegistro(&registro);
+                leidos++;
+            }
+            if (leidos == fragmento->numRegistros) {
+                enRegistro = false;
+                break; // Primer registro del fragmento siguiente
             }
-        } else if (event.type == YAML_MAPPING_END_EVENT) {
-            if (!agregarMenu(tablaMenus, idMenu, fecha, alimentos, numAlimentos, tablaAlimentos)) {
-                printf("\nError al insertar el menú con ID=%d\n", idMenu);
+            registro.alimento = NULL;
+            registro.cliente = NULL;
+            registro.menu = NULL;
+            registro.pedido = NULL;
+            iniciarRegistro(&registro, fragmento->seccion, nodos + (size_t)leidos * tamanoNodo);
+            registro.columnaCampos = linea.columna;
+            enRegistro = true;
+            error = leerCampo(&registro, &linea);
+        } else if (linea.columna == registro.columnaCampos && !linea.guion) {
+            error = leerCampo(&registro, &linea);
+        } else if (linea.columna > registro.columnaCampos && registro.enListaAlimentos) {
+            error = leerElementoAnidado(&registro, &linea);
+        } else {
+            error = "sangría inesperada";
+        }
+    }
+    if (!error && enRegistro) {
+        if (!registro.tieneId) {
+            error = "registro sin id";
+        } else {
+            if (idRegistro(&registro) > fragmento->idMaximo) fragmento->idMaximo = idRegistro(&registro);
+            leidos++;
+        }
+    }
+    if (!error && leidos != fragmento->numRegistros) {
+        error = "estructura de lista inesperada";
+    }
+    fragmento->error = error;
+    fragmento->lineaError = lector.numLinea;
+}
+
+/**
+ * @brief Reconoce la sección de un encabezado.
+ * @param inicio Inicio de la línea del encabezado.
+ * @param finArchivo Fin del contenido del archivo.
+ * @param seccion Sección reconocida.
+ * @return Descripción del error, o `NULL` si el encabezado es válido.
+ */
+static const char *leerEncabezado(const char *inicio, const char *finArchivo, SeccionYaml *seccion) {
+    LectorYaml lector = { inicio, finArchivo, 0 };
+    LineaYaml linea;
+    if (siguienteLinea(&lector, &linea) != 1) return "se esperaba 'clave: valor'";
+    if (linea.longitudValor != 0 && !valorEs(&linea, "[]")) return "se esperaba una lista";
+    if (claveEs(&linea, "alimentos")) *seccion = SECCION_ALIMENTOS;
+    else if (claveEs(&linea, "clientes")) *seccion = SECCION_CLIENTES;
+    else if (claveEs(&linea, "menus")) *seccion = SECCION_MENUS;
+    else if (claveEs(&linea, "pedidos")) *seccion = SECCION_PEDIDOS;
+    else return "sección desconocida";
+    return NULL;
+}
+
+/**
+ * @brief Datos compartidos por las tareas de las dos pasadas de `leerDocumentoParalelo`.
+ */
+typedef struct {
+    TramoYaml *tramos;
+    FragmentoYaml *fragmentos;
+    const int *sangrias;      ///< Sangría de los registros de cada instancia de sección.
+    char *const *nodos;       ///< Bloque de nodos de cada sección.
+    const size_t *tamanos;    ///< Tamaño de un nodo de cada sección.
+    const char *finArchivo;
+} LecturaParalela;
+
+/**
+ * @brief Primera pasada sobre los tramos `[inicio, fin)` (tarea de `paraCadaRango`).
+ */
+static void recorrerTramos(long long inicio, long long fin, void *contexto) {
+    LecturaParalela *lectura = (LecturaParalela *)contexto;
+    for (long long t = inicio; t < fin; t++) recorrerTramo(&lectura->tramos[t]);
+}
+
+/**
+ * @brief Segunda pasada sobre los fragmentos `[inicio, fin)` (tarea de `paraCadaRango`).
+ */
+static void leerFragmentos(long long inicio, long long fin, void *contexto) {
+    LecturaParalela *lectura = (LecturaParalela *)contexto;
+    for (long long i = inicio; i < fin; i++) {
+        FragmentoYaml *fragmento = &lectura->fragmentos[i];
+        if (fragmento->instancia < 0) {
+            // Antes del primer encabezado solo puede haber líneas vacías o comentarios
+            LectorYaml lector = { fragmento->inicio, fragmento->fin, fragmento->primeraLinea - 1 };
+            LineaYaml linea;
+            if (siguienteLinea(&lector, &linea) != 0) {
+                fragmento->error = "registro fuera de una sección";
+                fragmento->lineaError = lector.numLinea;
             }
+        } else if (fragmento->numRegistros > 0 || fragmento->primeroDeSeccion) {
+            char *nodos = lectura->nodos[fragmento->seccion];
+            size_t tamano = lectura->tamanos[fragmento->seccion];
+            char *primerNodo = nodos ? nodos + (size_t)fragmento->primerNodo * tamano : NULL;
+            leerFragmento(fragmento, lectura->finArchivo, lectura->sangrias[fragmento->instancia], primerNodo, tamano);
         }
-        yaml_event_delete(&event);
     }
 }
 
 /**
- * @brief Deserializa los datos desde un archivo YAML y los carga en las tablas hash.
+ * @brief Recorre el documento con varios hilos y llena las tablas (vacías) con sus registros.
+ *
+ * Las dos pasadas en paralelo son tareas del pool (ver tareas.h).
+ *
+ * 1. El archivo se divide en tramos de bytes alineados a inicio de línea. Cada tarea
+ *    cuenta en su tramo las líneas, los encabezados de sección y los guiones de cada
+ *    segmento.
+ * 2. Con esos conteos se sabe cuántos registros empiezan en cada segmento, así que a
+ *    cada uno se le asigna de antemano su porción del bloque de nodos de su tabla
+ *    (ver bloque_nodos.h) y los hilos construyen los nodos directamente ahí.
+ * 3. Los nodos se enlazan en las tablas en un solo hilo y en el orden del archivo,
+ *    igual que en la lectura secuencial (si un ID se repite, se conserva el primero).
+ *
+ * @param archivo Contenido del archivo.
+ * @param nombreArchivo Nombre del archivo (para los mensajes de error).
+ * @param tablaAlimentos Tabla de alimentos.
+ * @param tablaClientes Tabla de clientes.
+ * @param tablaMenus Tabla de menús.
+ * @param tablaPedidos Tabla de pedidos.
+ * @param numHilos Hilos del pool de tareas.
+ * @param duplicados Contador de registros omitidos por ID repetido.
+ * @return `true` si el documento se leyó completo, `false` si tiene errores.
+ */
+static bool leerDocumentoParalelo(const ArchivoEnMemoria *archivo, const char *nombreArchivo, HashTable *tablaAlimentos,
+                                  ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos,
+                                  int numHilos, long long *duplicados) {
+    const char *datos = (const char *)archivo->datos;
+    const char *finArchivo = datos + archivo->tamano;
+    int numTramos = numHilos * TRAMOS_POR_HILO;
+    TramoYaml *tramos = (TramoYaml *)calloc((size_t)numTramos, sizeof(TramoYaml));
+    if (!tramos) {
+        printf("\nError: No hay memoria suficiente para cargar '%s'.\n", nombreArchivo);
+        return false;
+    }
+
+    // Tramos alineados al inicio de una línea
+    bool sinMemoria = false;
+    for (int t = 0; t < numTramos; t++) {
+        const char *inicio = datos + (size_t)((double)archivo->tamano * t / numTramos);
+        if (t > 0 && inicio > datos) {
+            const char *salto = memchr(inicio - 1, '\n', (size_t)(finArchivo - (inicio - 1)));
+            inicio = salto ? salto + 1 : finArchivo;
+        }
+        if (t > 0 && inicio < tramos[t - 1].inicio) inicio = tramos[t - 1].inicio;
+        tramos[t].inicio = inicio;
+        if (t > 0) tramos[t - 1].fin = inicio;
+        tramos[t].capacidad = 4;
+        tramos[t].encabezados = (const char **)malloc(4 * sizeof(const char *));
+        tramos[t].lineaEncabezado = (int *)malloc(4 * sizeof(int));
+        tramos[t].segmentos = (ConteoSegmento *)malloc(5 * sizeof(ConteoSegmento));
+        if (!tramos[t].encabezados || !tramos[t].lineaEncabezado || !tramos[t].segmentos) sinMemoria = true;
+    }
+    tramos[numTramos - 1].fin = finArchivo;
+
+    // Primera pasada: conteos por tramo, un tramo por tarea
+    LecturaParalela lectura = { tramos, NULL, NULL, NULL, NULL, finArchivo };
+    if (!sinMemoria) paraCadaRango(numTramos, 1, recorrerTramos, &lectura);
+
+    // Armar los fragmentos (un segmento de un tramo cada uno) y reconocer las secciones
+    int numFragmentos = 0;
+    for (int t = 0; t < numTramos; t++) {
+        sinMemoria = sinMemoria || tramos[t].sinMemoria;
+        numFragmentos += tramos[t].numEncabezados + 1;
+    }
+    FragmentoYaml *fragmentos = sinMemoria ? NULL : (FragmentoYaml *)calloc((size_t)numFragmentos, sizeof(FragmentoYaml));
+    int *sangrias = sinMemoria ? NULL : (int *)malloc(((size_t)numFragmentos + 1) * sizeof(int)); // Por instancia de sección
+    const char *error = NULL;
+    int lineaError = 0;
+    if (!fragmentos || !sangrias) sinMemoria = true;
+
+    int f = 0;
+    int instancia = -1;
+    SeccionYaml seccion = SECCION_NINGUNA;
+    int lineaBase = 1;
+    for (int t = 0; !sinMemoria && !error && t < numTramos; t++) {
+        TramoYaml *tramo = &tramos[t];
+        for (int h = 0; h <= tramo->numEncabezados; h++) {
+            FragmentoYaml *fragmento = &fragmentos[f++];
+            bool primero = (h > 0);
+            if (h > 0) {
+                const char *encabezado = tramo->encabezados[h - 1];
+                error = leerEncabezado(encabezado, finArchivo, &seccion);
+                lineaError = lineaBase + tramo->lineaEncabezado[h - 1];
+                if (error) break;
+                instancia++;
+                sangrias[instancia] = INT_MAX;
+                const char *salto = memchr(encabezado, '\n', (size_t)(finArchivo - encabezado));
+                fragmento->inicio = salto ? salto + 1 : finArchivo;
+                fragmento->primeraLinea = lineaError + 1;
+            } else {
+                fragmento->inicio = tramo->inicio;
+                fragmento->primeraLinea = lineaBase;
+            }
+            fragmento->fin = (h < tramo->numEncabezados) ? tramo->encabezados[h] : tramo->fin;
+            fragmento->instancia = instancia;
+            fragmento->seccion = seccion;
+            fragmento->primeroDeSeccion = primero || instancia < 0;
+            if (instancia >= 0 && tramo->segmentos[h].sangriaMinima < sangrias[instancia]) {
+                sangrias[instancia] = tramo->segmentos[h].sangriaMinima;
+            }
+        }
+        lineaBase += tramo->numLineas;
+    }
+
+    // Registros por fragmento y posición de cada uno en el bloque de su tabla
+    long long totales[5] = { 0, 0, 0, 0, 0 };
+    if (!sinMemoria && !error) {
+        f = 0;
+        for (int t = 0; t < numTramos; t++) {
+            for (int h = 0; h <= tramos[t].numEncabezados; h++, f++) {
+                FragmentoYaml *fragmento = &fragmentos[f];
+                const ConteoSegmento *conteo = &tramos[t].segmentos[h];
+                bool sonRegistros = fragmento->instancia >= 0 && conteo->sangriaMinima == sangrias[fragmento->instancia];
+                fragmento->numRegistros = sonRegistros ? conteo->numGuiones : 0;
+                fragmento->primerNodo = totales[fragmento->seccion];
+                totales[fragmento->seccion] += fragmento->numRegistros;
+            }
+        }
+    }
+
+    // Un bloque de nodos por tabla
+    BloqueNodos *bloques[5] = { NULL, &tablaAlimentos->bloqueNodos, &tablaClientes->bloqueNodos,
+                                &tablaMenus->bloqueNodos, &tablaPedidos->bloqueNodos };
+    const size_t tamanos[5] = { 0, sizeof(Alimento), sizeof(Cliente), sizeof(Menu), sizeof(Pedido) };
+    char *nodos[5] = { NULL, NULL, NULL, NULL, NULL };
+    for (int s = SECCION_ALIMENTOS; !sinMemoria && !error && s <= SECCION_PEDIDOS; s++) {
+        if (totales[s] > INT_MAX) {
+            error = "demasiados registros";
+            lineaError = lineaBase - 1;
+        } else if (totales[s] > 0) {
+            nodos[s] = (char *)reservarBloqueNodos(bloques[s], (size_t)totales[s], tamanos[s]);
+            if (!nodos[s]) sinMemoria = true;
+        }
+    }
+
+    // Segunda pasada: construir los nodos, un fragmento por tarea
+    if (!sinMemoria && !error) {
+        lectura.fragmentos = fragmentos;
+        lectura.sangrias = sangrias;
+        lectura.nodos = nodos;
+        lectura.tamanos = tamanos;
+        paraCadaRango(numFragmentos, 1, leerFragmentos, &lectura);
+        for (int i = 0; i < numFragmentos && !error; i++) {
+            if (fragmentos[i].error) {
+                error = fragmentos[i].error;
+                lineaError = fragmentos[i].lineaError;
+            }
+        }
+    }
+
+    // Enlazar los nodos en las tablas
+    if (!sinMemoria && !error) {
+        int idMaximo[5] = { INT_MIN, INT_MIN, INT_MIN, INT_MIN, INT_MIN };
+        for (int i = 0; i < numFragmentos; i++) {
+            if (fragmentos[i].numRegistros > 0 && fragmentos[i].idMaximo > idMaximo[fragmentos[i].seccion]) {
+                idMaximo[fragmentos[i].seccion] = fragmentos[i].idMaximo;
+            }
+        }
+        if (convieneReservarRango(idMaximo[SECCION_ALIMENTOS], totales[SECCION_ALIMENTOS])) reservarRangoDensoAlimentos(tablaAlimentos, idMaximo[SECCION_ALIMENTOS]);
+        if (convieneReservarRango(idMaximo[SECCION_CLIENTES], totales[SECCION_CLIENTES])) reservarRangoDensoClientes(tablaClientes, idMaximo[SECCION_CLIENTES]);
+        if (convieneReservarRango(idMaximo[SECCION_MENUS], totales[SECCION_MENUS])) reservarRangoDensoMenus(tablaMenus, idMaximo[SECCION_MENUS]);
+        if (convieneReservarRango(idMaximo[SECCION_PEDIDOS], totales[SECCION_PEDIDOS])) reservarRangoDensoPedidos(tablaPedidos, idMaximo[SECCION_PEDIDOS]);
+
+        Alimento *alimentos = (Alimento *)nodos[SECCION_ALIMENTOS];
+        for (long long i = 0; i < totales[SECCION_ALIMENTOS]; i++) {
+            if (!restaurarAlimento(tablaAlimentos, &alimentos[i])) {
+                soltarCadena(alimentos[i].nombre);
+                (*duplicados)++;
+            }
+        }
+        Cliente *clientes = (Cliente *)nodos[SECCION_CLIENTES];
+        for (long long i = 0; i < totales[SECCION_CLIENTES]; i++) {
+            if (!restaurarCliente(tablaClientes, &clientes[i])) {
+                soltarCadena(clientes[i].nombre);
+                (*duplicados)++;
+            }
+        }
+        Menu *menus = (Menu *)nodos[SECCION_MENUS];
+        for (long long i = 0; i < totales[SECCION_MENUS]; i++) {
+            if (!restaurarMenu(tablaMenus, &menus[i])) (*duplicados)++;
+        }
+        Pedido *pedidos = (Pedido *)nodos[SECCION_PEDIDOS];
+        for (long long i = 0; i < totales[SECCION_PEDIDOS]; i++) {
+            if (!restaurarPedido(tablaPedidos, &pedidos[i])) (*duplicados)++;
+        }
+    }
+
+    for (int t = 0; t < numTramos; t++) {
+        free(tramos[t].encabezados);
+        free(tramos[t].lineaEncabezado);
+        free(tramos[t].segmentos);
+    }
+    free(tramos);
+    free(fragmentos);
+    free(sangrias);
+
+    if (sinMemoria) {
+        printf("\nError: No hay memoria suficiente para cargar '%s'.\n", nombreArchivo);
+        return false;
+    }
+    if (error) {
+        printf("\nError: '%s', línea %d: %s.\n", nombreArchivo, lineaError, error);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Deserializa los datos desde un archivo YAML con el número de hilos indicado.
+ *
+ * Los registros se leen en tablas nuevas; solo si todo el archivo es válido su
+ * contenido se intercambia con el de las tablas recibidas y los datos anteriores
+ * se liberan. Si hay un error, las tablas conservan sus datos.
+ *
+ * @param nombreArchivoOriginal Nombre del archivo YAML (se agrega ".yaml" si no lo tiene).
+ * @param tablaAlimentos Tabla hash de alimentos.
+ * @param tablaClientes Tabla hash de clientes.
+ * @param tablaMenus Tabla hash de menús.
+ * @param tablaPedidos Tabla hash de pedidos.
+ * @param numHilos Hilos a usar; con 1 (o con archivos pequeños) se usa el lector de una sola pasada.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
  */
-void deserializarDatos(const char *nombreArchivoOriginal, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
-    char nombreArchivo[100];
+bool deserializarDatosConHilos(const char *nombreArchivoOriginal, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                               MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, int numHilos) {
+    char nombreArchivo[105];
     strncpy(nombreArchivo, nombreArchivoOriginal, sizeof(nombreArchivo) - 1);
     nombreArchivo[sizeof(nombreArchivo) - 1] = '\0';
-    validarNombreArchivo(nombreArchivo);
+    validarNombreArchivo(nombreArchivo, sizeof(nombreArchivo));
 
-    FILE *archivo = fopen(nombreArchivo, "r");
-    if (!archivo) {
+    ArchivoEnMemoria archivo;
+    if (!abrirArchivoEnMemoria(nombreArchivo, &archivo)) {
         printf("\nError: No se pudo abrir el archivo '%s'.\n", nombreArchivo);
-        return;
+        return false;
     }
 
-    yaml_parser_t parser;
-    if (!yaml_parser_initialize(&parser)) {
-        printf("\nError: No se pudo inicializar el parser de YAML.\n");
-        fclose(archivo);
-        return;
+    HashTable *nuevaAlimentos = crearTablaHash();
+    ClientesHashTable *nuevaClientes = crearTablaClientes();
+    MenuHashTable *nuevaMenus = crearTablaMenus();
+    PedidosHashTable *nuevaPedidos = crearTablaPedidos();
+    long long duplicados = 0;
+    bool paralelo = numHilos > 1 && archivo.tamano >= TAMANO_MINIMO_PARALELO;
+    bool correcto = nuevaAlimentos && nuevaClientes && nuevaMenus && nuevaPedidos;
+    if (correcto && paralelo) {
+        // El pool queda con los hilos pedidos; si no se pudieron crear, se usan los que tenga
+        iniciarPoolTareas(numHilos);
+        correcto = leerDocumentoParalelo(&archivo, nombreArchivo, nuevaAlimentos, nuevaClientes, nuevaMenus, nuevaPedidos,
+                                         hilosPoolTareas(), &duplicados);
+    } else if (correcto) {
+        correcto = leerDocumento(&archivo, nombreArchivo, nuevaAlimentos, nuevaClientes, nuevaMenus, nuevaPedidos, &duplicados);
     }
-    yaml_parser_set_input_file(&parser, archivo);
+    cerrarArchivoEnMemoria(&archivo);
 
-    yaml_event_t event;
+    if (correcto) {
+        INVERTIR_BUCKETS(nuevaAlimentos, Alimento, HASH_TABLE_SIZE)
+        INVERTIR_BUCKETS(nuevaClientes, Cliente, CLIENTES_TABLE_SIZE)
+        INVERTIR_BUCKETS(nuevaMenus, Menu, MENU_TABLE_SIZE)
+        INVERTIR_BUCKETS(nuevaPedidos, Pedido, PEDIDOS_TABLE_SIZE)
+    }
+    if (correcto) {
+        // Intercambiar contenidos: las tablas "nuevas" quedan con los datos anteriores
+        HashTable auxAlimentos = *tablaAlimentos;
+        *tablaAlimentos = *nuevaAlimentos;
+        *nuevaAlimentos = auxAlimentos;
+        ClientesHashTable auxClientes = *tablaClientes;
+        *tablaClientes = *nuevaClientes;
+        *nuevaClientes = auxClientes;
+        MenuHashTable auxMenus = *tablaMenus;
+        *tablaMenus = *nuevaMenus;
+        *nuevaMenus = auxMenus;
+        PedidosHashTable auxPedidos = *tablaPedidos;
+        *tablaPedidos = *nuevaPedidos;
+        *nuevaPedidos = auxPedidos;
+        // Los datos anteriores se vacían en las tablas "nuevas", que la caché no sigue
+        olvidarTotalesTabla(tablaAlimentos);
+    }
+    if (nuevaAlimentos) liberarTabla(nuevaAlimentos);
+    if (nuevaClientes) liberarTablaClientes(nuevaClientes);
+    if (nuevaMenus) liberarTablaMenus(nuevaMenus);
+    if (nuevaPedidos) liberarTablaPedidos(nuevaPedidos);
+    if (!correcto) return false;
 
-    while (yaml_parser_parse(&parser, &event)) {
-        if (event.type == YAML_SCALAR_EVENT) {
-            const char *clave = (char *)event.data.scalar.value;
-            if (strcmp(clave, "alimentos") == 0) {
-                cargarAlimentos(&parser, tablaAlimentos);
-            } else if (strcmp(clave, "clientes") == 0) {
-                cargarClientes(&parser, tablaClientes);
-            } else if (strcmp(clave, "menus") == 0) {
-                cargarMenus(&parser, tablaMenus, tablaAlimentos);
-            }
-        } else if (event.type == YAML_STREAM_END_EVENT) {
-            break;
-        }
-        yaml_event_delete(&event);
+    if (duplicados > 0) {
+        printf("\nAdvertencia: se omitieron %lld registros con ID repetido.\n", duplicados);
     }
+    MENSAJE("\nDeserialización finalizada con éxito.\n");
+    return true;
+}
 
-    yaml_parser_delete(&parser);
-    fclose(archivo);
-    printf("\nDeserialización finalizada con éxito.\n");
+/**
+ * @brief Deserializa los datos desde un archivo YAML y los carga en las tablas hash.
+ *
+ * Usa los hilos del pool de tareas (`hilosPoolTareas`).
+ *
+ * @param nombreArchivo Nombre del archivo YAML (se agrega ".yaml" si no lo tiene).
+ * @param tablaAlimentos Tabla hash de alimentos.
+ * @param tablaClientes Tabla hash de clientes.
+ * @param tablaMenus Tabla hash de menús.
+ * @param tablaPedidos Tabla hash de pedidos.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool deserializarDatos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    return deserializarDatosConHilos(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, hilosPoolTareas());
 }
@@ -7,25 +7,39 @@
 #include "hash_pedidos.h"
 
 
-/*
-    No pude terminar la deserialización. La dejo aqui con fines
-    propios, por lo que le pido que no la tome encuenta como parte
-    de la entrega final de mi proyecto.
-*/
-
-
 /**
  * @brief Deserializa los datos desde un archivo en formato YAML y los carga en las tablas hash correspondientes.
  *
- * Esta función lee el contenido de un archivo YAML y llena las tablas hash de alimentos,
- * clientes, menús y pedidos con los datos deserializados.
+ * Esta función lee el contenido de un archivo YAML generado por `serializarDatos` y
+ * reemplaza con él el contenido de las tablas hash de alimentos, clientes, menús y pedidos.
+ * Si el archivo tiene errores, las tablas conservan sus datos.
  *
  * @param nombreArchivo Nombre del archivo YAML que contiene los datos serializados.
  * @param tablaAlimentos Puntero a la tabla hash de alimentos que se llenará con los datos deserializados.
  * @param tablaClientes Puntero a la tabla hash de clientes que se llenará con los datos deserializados.
  * @param tablaMenus Puntero a la tabla hash de menús que se llenará con los datos deserializados.
  * @param tablaPedidos Puntero a la tabla hash de pedidos que se llenará con los datos deserializados.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool deserializarDatos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Igual que `deserializarDatos`, pero con un número de hilos fijo.
+ *
+ * Con más de un hilo el archivo se divide en fragmentos que se leen en paralelo
+ * y los registros se insertan de una vez al final; el pool de tareas se ajusta a
+ * `numHilos` con `iniciarPoolTareas`. Con un hilo (o si el archivo
+ * mide menos de 1 MB) se usa el lector secuencial de una sola pasada.
+ *
+ * @param nombreArchivo Nombre del archivo YAML que contiene los datos serializados.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param numHilos Número de hilos a usar.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
  */
-void deserializarDatos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+bool deserializarDatosConHilos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                               MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, int numHilos);
 
 #endif // DESERIALIZAR_DATOS_H
@@ -0,0 +1,144 @@
+/**
+ * @file fechas.h
+ * @brief Fechas guardadas como número de día, con lectura y escritura de "AAAA-MM-DD" sin ramas.
+ *
+ * Una Fecha es el número de días desde el 1970-01-01 (que es el día 0), así que comparar,
+ * ordenar o filtrar por rango de fechas son operaciones sobre un entero, y la diferencia
+ * entre dos fechas son los días entre ellas. El texto solo aparece en los bordes: al leer
+ * la entrada del usuario, un YAML, un CSV o un argumento del modo por lotes, y al
+ * imprimir o guardar.
+ *
+ * La conversión entre día y (año, mes, día) es la de los algoritmos `days_from_civil` y
+ * `civil_from_days` de Howard Hinnant, para el calendario gregoriano proléptico.
+ */
+
+#ifndef FECHAS_H
+#define FECHAS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/// Fecha como número de días desde el 1970-01-01.
+typedef int32_t Fecha;
+
+/// Fecha ausente (por ejemplo, un registro de un YAML sin fecha); se escribe como texto vacío.
+#define FECHA_NULA INT32_MIN
+
+/// Tamaño del texto "AAAA-MM-DD" con su terminador.
+#define FECHA_TEXTO 11
+
+/// Días de cada mes menos 28, dos bits por mes (enero en los bits 0-1).
+#define FECHA_DIAS_MES 0xEEFBB3u
+
+/**
+ * @brief Convierte una fecha del calendario a número de día.
+ * @param anio Año.
+ * @param mes Mes (1 a 12).
+ * @param dia Día del mes (1 a 31).
+ * @return Días desde el 1970-01-01.
+ */
+static inline Fecha fechaDeCivil(int anio, int mes, int dia) {
+    int a = anio - (mes <= 2);
+    int era = (a >= 0 ? a : a - 399) / 400;
+    unsigned anioEra = (unsigned)(a - era * 400);
+    unsigned diaAnio = (153u * (unsigned)(mes > 2 ? mes - 3 : mes + 9) + 2) / 5 + (unsigned)dia - 1;
+    unsigned diaEra = anioEra * 365 + anioEra / 4 - anioEra / 100 + diaAnio;
+    return (Fecha)(era * 146097 + (int)diaEra - 719468);
+}
+
+/**
+ * @brief Convierte un número de día a fecha del calendario.
+ * @param fecha Días desde el 1970-01-01 (no FECHA_NULA).
+ * @param anio Año (de salida).
+ * @param mes Mes, de 1 a 12 (de salida).
+ * @param dia Día del mes, de 1 a 31 (de salida).
+ */
+static inline void civilDeFecha(Fecha fecha, int *anio, int *mes, int *dia) {
+    int z = fecha + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned diaEra = (unsigned)(z - era * 146097);
+    unsigned anioEra = (diaEra - diaEra / 1460 + diaEra / 36524 - diaEra / 146096) / 365;
+    unsigned diaAnio = diaEra - (365 * anioEra + anioEra / 4 - anioEra / 100);
+    unsigned mesMarzo = (5 * diaAnio + 2) / 153;
+    *dia = (int)(diaAnio - (153 * mesMarzo + 2) / 5 + 1);
+    *mes = (int)(mesMarzo < 10 ? mesMarzo + 3 : mesMarzo - 9);
+    *anio = (int)anioEra + era * 400 + (*mes <= 2);
+}
+
+/**
+ * @brief Lee una fecha "AAAA-MM-DD" que ocupa exactamente `longitud` bytes.
+ *
+ * Los ocho dígitos, los guiones, el mes y el día (contando los bisiestos) se validan
+ * juntos acumulando los errores en una máscara, sin un salto por cada comprobación.
+ *
+ * @param texto Inicio del texto (no necesita terminador).
+ * @param longitud Número de bytes.
+ * @param fecha Fecha leída (de salida; no cambia si el texto no es válido).
+ * @return `true` si el texto es una fecha válida de los años 0000 a 9999.
+ */
+static inline bool leerFecha(const char *texto, size_t longitud, Fecha *fecha) {
+    if (longitud != 10) return false;
+    const unsigned char *t = (const unsigned char *)texto;
+    unsigned d0 = t[0] - (unsigned)'0', d1 = t[1] - (unsigned)'0', d2 = t[2] - (unsigned)'0';
+    unsigned d3 = t[3] - (unsigned)'0', d5 = t[5] - (unsigned)'0', d6 = t[6] - (unsigned)'0';
+    unsigned d8 = t[8] - (unsigned)'0', d9 = t[9] - (unsigned)'0';
+    unsigned malo = (d0 > 9) | (d1 > 9) | (d2 > 9) | (d3 > 9) | (d5 > 9) | (d6 > 9) | (d8 > 9) | (d9 > 9);
+    malo |= (t[4] != '-') | (t[7] != '-');
+
+    unsigned anio = ((d0 * 10 + d1) * 10 + d2) * 10 + d3;
+    unsigned mes = d5 * 10 + d6;
+    unsigned dia = d8 * 10 + d9;
+    unsigned bisiesto = ((anio % 4) == 0) & (((anio % 100) != 0) | ((anio % 400) == 0));
+    unsigned indiceMes = (mes - 1) & 15;
+    unsigned diasMes = 28 + ((FECHA_DIAS_MES >> (2 * indiceMes)) & 3) + ((indiceMes == 1) & bisiesto);
+    malo |= (mes - 1 > 11) | (dia - 1 >= diasMes);
+
+    if (malo) return false;
+    *fecha = fechaDeCivil((int)anio, (int)mes, (int)dia);
+    return true;
+}
+
+/**
+ * @brief Lee una fecha "AAAA-MM-DD" de una cadena terminada en '\0'.
+ * @param texto Cadena con la fecha.
+ * @param fecha Fecha leída (de salida; no cambia si el texto no es válido).
+ * @return `true` si la cadena es una fecha válida.
+ */
+static inline bool leerFechaTexto(const char *texto, Fecha *fecha) {
+    return leerFecha(texto, strlen(texto), fecha);
+}
+
+/**
+ * @brief Escribe una fecha como "AAAA-MM-DD" (texto vacío para FECHA_NULA).
+ *
+ * Devuelve el mismo arreglo para poder usarla como argumento de `printf`.
+ *
+ * @param fecha Fecha a escribir.
+ * @param texto Arreglo de al menos FECHA_TEXTO bytes.
+ * @return `texto`.
+ */
+static inline char *formatearFecha(Fecha fecha, char texto[FECHA_TEXTO]) {
+    if (fecha == FECHA_NULA) {
+        texto[0] = '\0';
+        return texto;
+    }
+    int anio, mes, dia;
+    civilDeFecha(fecha, &anio, &mes, &dia);
+    unsigned a = (unsigned)anio % 10000;
+    texto[0] = (char)('0' + a / 1000);
+    texto[1] = (char)('0' + a / 100 % 10);
+    texto[2] = (char)('0' + a / 10 % 10);
+    texto[3] = (char)('0' + a % 10);
+    texto[4] = '-';
+    texto[5] = (char)('0' + mes / 10);
+    texto[6] = (char)('0' + mes % 10);
+    texto[7] = '-';
+    texto[8] = (char)('0' + dia / 10);
+    texto[9] = (char)('0' + dia % 10);
+    texto[10] = '\0';
+    return texto;
+}
+
+#endif // FECHAS_H
@@ -0,0 +1,175 @@
+/**
+ * @file guardado_segundo_plano.c
+ * @brief Implementación del guardado en segundo plano con `fork` (copy-on-write).
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // fork, pipe y waitpid con -std=c99
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+#include "guardado_segundo_plano.h"
+#include "serializar_datos.h"
+#include "mensajes.h"
+#include "tareas.h"
+
+/**
+ * @brief Guardado en curso.
+ */
+static struct {
+    bool enCurso;       ///< Hay un hijo escribiendo.
+    char nombre[512];   ///< Archivo que se está escribiendo.
+    double pausa;       ///< Segundos que tardó `fork`.
+#ifndef _WIN32
+    pid_t hijo;         ///< Proceso que escribe el archivo.
+    int tuberia;        ///< Extremo de lectura de la tubería con el resultado.
+#endif
+} guardado;
+
+#ifndef _WIN32
+/**
+ * @brief Mide la memoria que el proceso no comparte con ningún otro.
+ *
+ * Se lee de `/proc/self/smaps_rollup` (Linux 4.14 o posterior).
+ *
+ * @return Bytes privados (limpios más modificados), o 0 si no se pudo medir.
+ */
+static uint64_t memoriaPrivada(void) {
+    FILE *archivo = fopen("/proc/self/smaps_rollup", "r");
+    if (!archivo) return 0;
+    char linea[256];
+    uint64_t total = 0;
+    while (fgets(linea, sizeof(linea), archivo)) {
+        unsigned long long kb;
+        if (sscanf(linea, "Private_Clean: %llu kB", &kb) == 1 || sscanf(linea, "Private_Dirty: %llu kB", &kb) == 1) {
+            total += (uint64_t)kb * 1024;
+        }
+    }
+    fclose(archivo);
+    return total;
+}
+
+/**
+ * @brief Trabajo del proceso hijo: escribe el archivo, informa el resultado y termina.
+ * @param tuberia Extremo de escritura de la tubería.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ */
+static void escribirEnHijo(int tuberia, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                           MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    mensajesActivos = false;
+    abandonarPoolTareasEnHijo(); // Los hilos del pool del proceso original no existen en el hijo
+    ResultadoGuardado resultado;
+    memset(&resultado, 0, sizeof(resultado));
+    double inicio = omp_get_wtime();
+    resultado.correcto = serializarDatos(guardado.nombre, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+    resultado.segundos = omp_get_wtime() - inicio;
+    resultado.memoriaAdicional = memoriaPrivada();
+    fflush(stdout); // Mensajes de error, si los hubo
+    if (write(tuberia, &resultado, sizeof(resultado)) != (ssize_t)sizeof(resultado)) {
+        resultado.correcto = false;
+    }
+    _exit(resultado.correcto ? 0 : 1); // Sin atexit ni buffers del proceso original
+}
+#endif
+
+/**
+ * @brief Empieza a guardar las tablas en un archivo YAML en segundo plano.
+ * @param nombreArchivo Nombre del archivo YAML.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param pausa Segundos que estuvo detenido el proceso (de salida, puede ser `NULL`).
+ * @return `true` si el guardado quedó en curso (o, en Windows, terminó bien), `false` en caso contrario.
+ */
+bool iniciarGuardadoSegundoPlano(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                 MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, double *pausa) {
+    if (guardado.enCurso) {
+        printf("\nError: Ya hay un guardado en segundo plano de '%s' en curso.\n", guardado.nombre);
+        return false;
+    }
+    if (snprintf(guardado.nombre, sizeof(guardado.nombre), "%s", nombreArchivo) >= (int)sizeof(guardado.nombre)) {
+        printf("\nError: El nombre de archivo '%s' es demasiado largo.\n", nombreArchivo);
+        return false;
+    }
+#ifdef _WIN32
+    // Sin fork: se guarda en primer plano y toda la escritura cuenta como pausa
+    double inicio = omp_get_wtime();
+    bool correcto = serializarDatos(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+    if (pausa) *pausa = omp_get_wtime() - inicio;
+    return correcto;
+#else
+    int extremos[2];
+    if (pipe(extremos) != 0) {
+        printf("\nError: No se pudo crear la tubería para el guardado en segundo plano.\n");
+        return false;
+    }
+    fflush(stdout); // Para que el hijo no herede texto pendiente de imprimir
+
+    double inicio = omp_get_wtime();
+    pid_t hijo = fork();
+    double duracion = omp_get_wtime() - inicio;
+    if (hijo == 0) {
+        close(extremos[0]);
+        escribirEnHijo(extremos[1], tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+    }
+    close(extremos[1]);
+    if (hijo < 0) {
+        close(extremos[0]);
+        printf("\nError: No se pudo iniciar el guardado en segundo plano.\n");
+        return false;
+    }
+    guardado.enCurso = true;
+    guardado.hijo = hijo;
+    guardado.tuberia = extremos[0];
+    guardado.pausa = duracion;
+    if (pausa) *pausa = duracion;
+    return true;
+#endif
+}
+
+/**
+ * @brief Revisa si terminó el guardado en curso.
+ * @param esperar `true` para esperar a que termine, `false` para solo consultar.
+ * @param resultado Resultado del guardado terminado (de salida, puede ser `NULL`).
+ * @return `true` si había un guardado y terminó en esta llamada, `false` si sigue en curso o no había ninguno.
+ */
+bool revisarGuardadoSegundoPlano(bool esperar, ResultadoGuardado *resultado) {
+#ifdef _WIN32
+    (void)esperar;
+    (void)resultado;
+    return false;
+#else
+    if (!guardado.enCurso) return false;
+    int estado;
+    pid_t terminado = waitpid(guardado.hijo, &estado, esperar ? 0 : WNOHANG);
+    if (terminado == 0) return false; // Sigue escribiendo
+
+    ResultadoGuardado leido;
+    memset(&leido, 0, sizeof(leido));
+    if (terminado < 0 || read(guardado.tuberia, &leido, sizeof(leido)) != (ssize_t)sizeof(leido) ||
+        !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+        leido.correcto = false;
+    }
+    close(guardado.tuberia);
+    guardado.enCurso = false;
+    leido.pausa = guardado.pausa;
+
+    if (leido.correcto) {
+        MENSAJE("\nGuardado en segundo plano terminado: '%s' en %.3f s (pausa de %.0f µs, memoria adicional %.1f MB).\n",
+                guardado.nombre, leido.segundos, leido.pausa * 1e6, leido.memoriaAdicional / (1024.0 * 1024.0));
+    } else {
+        printf("\nError: El guardado en segundo plano de '%s' no se completó.\n", guardado.nombre);
+    }
+    if (resultado) *resultado = leido;
+    return true;
+#endif
+}
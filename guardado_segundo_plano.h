@@ -0,0 +1,66 @@
+/**
+ * @file guardado_segundo_plano.h
+ * @brief Guardado en YAML de una vista consistente de las tablas sin detener las operaciones.
+ *
+ * En sistemas POSIX el programa se duplica con `fork`: el proceso hijo recibe una copia
+ * de la memoria en el instante del guardado (copy-on-write, el sistema solo copia las
+ * páginas que alguno de los dos procesos modifica después) y escribe el archivo con
+ * `serializarDatos`, mientras el proceso original sigue atendiendo operaciones. La pausa
+ * es solo lo que tarda `fork` en duplicar las tablas de páginas.
+ *
+ * Al terminar, el hijo informa por una tubería si el archivo quedó completo, cuánto tardó
+ * y cuánta memoria dejó de compartir con el proceso original (las páginas copiadas más
+ * sus propios buffers), que es la memoria adicional que costó el guardado.
+ *
+ * En Windows no hay `fork` y el guardado se hace en primer plano.
+ */
+
+#ifndef GUARDADO_SEGUNDO_PLANO_H
+#define GUARDADO_SEGUNDO_PLANO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/**
+ * @brief Resultado de un guardado en segundo plano.
+ */
+typedef struct {
+    bool correcto;             ///< El archivo se escribió completo.
+    double pausa;              ///< Segundos que el proceso original estuvo detenido al iniciar el guardado.
+    double segundos;           ///< Segundos que tardó el hijo en escribir el archivo.
+    uint64_t memoriaAdicional; ///< Bytes que el hijo no compartía con el proceso original al terminar (0 si no se pudo medir).
+} ResultadoGuardado;
+
+/**
+ * @brief Empieza a guardar las tablas en un archivo YAML en segundo plano.
+ *
+ * Solo puede haber un guardado en curso. Las tablas se pueden seguir modificando en
+ * cuanto la función regresa: el archivo tendrá su contenido en el momento de la llamada.
+ *
+ * @param nombreArchivo Nombre del archivo YAML.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param pausa Segundos que estuvo detenido el proceso (de salida, puede ser `NULL`).
+ * @return `true` si el guardado quedó en curso (o, en Windows, terminó bien), `false` en caso contrario.
+ */
+bool iniciarGuardadoSegundoPlano(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                 MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, double *pausa);
+
+/**
+ * @brief Revisa si terminó el guardado en curso.
+ *
+ * Cuando termina, imprime su resumen (si los mensajes están activos) y deja de estar en curso.
+ *
+ * @param esperar `true` para esperar a que termine, `false` para solo consultar.
+ * @param resultado Resultado del guardado terminado (de salida, puede ser `NULL`).
+ * @return `true` si había un guardado y terminó en esta llamada, `false` si sigue en curso o no había ninguno.
+ */
+bool revisarGuardadoSegundoPlano(bool esperar, ResultadoGuardado *resultado);
+
+#endif // GUARDADO_SEGUNDO_PLANO_H
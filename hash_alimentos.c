@@ -7,8 +7,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
-#include <omp.h>
 #include "hash_alimentos.h"
+#include "rango_denso.h"
+#include "mensajes.h"
+#include "mutaciones.h"
+#include "tareas.h"
+#include "latencias.h"
+#include "totales_pedidos.h"
 
 /**
  * @brief Crea una nueva tabla hash para almacenar alimentos.
@@ -23,6 +28,13 @@ HashTable *crearTablaHash() {
     for (int i = 0; i < HASH_TABLE_SIZE; i++) {
         tabla->buckets[i] = NULL;
     }
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    tabla->numAlimentos = 0;
+    iniciarBloqueNodos(&tabla->bloqueNodos, MEMORIA_ALIMENTOS, sizeof(Alimento));
+    iniciarCambios(&tabla->cambios);
+    tabla->indiceIds = NULL;
+    contarReserva(MEMORIA_ALIMENTOS, sizeof(HashTable));
     return tabla;
 }
 
@@ -37,13 +49,71 @@ unsigned int hashFunctionMidSquare(int id) {
     return midBits % HASH_TABLE_SIZE;
 }
 
+/**
+ * @brief Amplía el arreglo directo y mueve a él los alimentos de los buckets que caen en el nuevo rango.
+ * @param tabla Puntero a la tabla hash.
+ * @param capacidad Nueva capacidad del arreglo directo.
+ * @return true si se amplió correctamente, false si no hubo memoria.
+ */
+static bool ampliarRangoDirecto(HashTable *tabla, int capacidad) {
+    Alimento **directo = (Alimento **)realloc(tabla->directo, capacidad * sizeof(Alimento *));
+    if (!directo) {
+        return false;
+    }
+    for (int i = tabla->capacidadDirecta; i < capacidad; i++) {
+        directo[i] = NULL;
+    }
+    contarReserva(MEMORIA_ALIMENTOS, (size_t)(capacidad - tabla->capacidadDirecta) * sizeof(Alimento *));
+    tabla->directo = directo;
+    tabla->capacidadDirecta = capacidad;
+
+    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+        Alimento **enlace = &tabla->buckets[i];
+        while (*enlace) {
+            Alimento *actual = *enlace;
+            if (actual->id >= 0 && actual->id < capacidad) {
+                *enlace = actual->next;
+                actual->next = NULL;
+                directo[actual->id] = actual;
+            } else {
+                enlace = &actual->next;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return true si el rango quedó reservado, false en caso contrario.
+ */
+bool reservarRangoDensoAlimentos(HashTable *tabla, int idMaximo) {
+    if (idMaximo < 0 || idMaximo >= RANGO_DENSO_MAXIMO) {
+        return false;
+    }
+    if (idMaximo < tabla->capacidadDirecta) {
+        return true;
+    }
+    int capacidad = tabla->capacidadDirecta > 0 ? tabla->capacidadDirecta : RANGO_DENSO_MINIMO;
+    while (capacidad <= idMaximo) capacidad *= 2;
+    return ampliarRangoDirecto(tabla, capacidad);
+}
+
 /**
  * @brief Copia los alimentos desde la tabla hash a un arreglo.
  * @param tabla Puntero a la tabla hash.
  * @param alimentos Arreglo donde se copiarán los alimentos.
  */
 void copiarAlimentosDesdeTabla(HashTable *tabla, Alimento alimentos[]) {
+    MEDIR_LATENCIA(LATENCIA_COPIAR_ALIMENTOS);
     int index = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) { // Recorrido secuencial del rango denso
+        if (tabla->directo[i]) {
+            alimentos[index++] = *tabla->directo[i];
+        }
+    }
     for (int i = 0; i < HASH_TABLE_SIZE; i++) { // Recorre cada bucket
         Alimento *actual = tabla->buckets[i];
         while (actual) { // Recorre la lista enlazada en cada bucket
@@ -53,21 +123,53 @@ void copiarAlimentosDesdeTabla(HashTable *tabla, Alimento alimentos[]) {
     }
 }
 
+/**
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior.
+ *
+ * La primera llamada copia los IDs (el rango directo ya sale ordenado; los de los
+ * buckets los ordena crearIndiceBusqueda) y construye el índice; las siguientes lo
+ * reutilizan hasta que un alta, una actualización o una baja lo invalida.
+ *
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsAlimentos(HashTable *tabla) {
+    if (tabla->indiceIds) return tabla->indiceIds;
+    int *ids = (int *)malloc(((size_t)tabla->numAlimentos + 1) * sizeof(int));
+    if (!ids) {
+        printf("\nError: No se pudo crear el índice de búsqueda.\n");
+        return NULL;
+    }
+    int numIds = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) ids[numIds++] = i;
+    }
+    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+        for (Alimento *actual = tabla->buckets[i]; actual; actual = actual->next) ids[numIds++] = actual->id;
+    }
+    tabla->indiceIds = crearIndiceBusqueda(ids, numIds);
+    free(ids);
+    return tabla->indiceIds;
+}
+
 /**
  * @brief Cuenta el número de alimentos en la tabla hash.
  * @param tabla Puntero a la tabla hash.
  * @return Número total de alimentos en la tabla.
  */
 int obtenerNumeroDeAlimentos(HashTable *tabla) {
-    int contador = 0;
-    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
-        Alimento *actual = tabla->buckets[i];
-        while (actual) {
-            contador++;
-            actual = actual->next;
-        }
-    }
-    return contador;
+    return tabla->numAlimentos;
+}
+
+/**
+ * @brief Intercambia dos alimentos de un arreglo.
+ * @param a Primer alimento.
+ * @param b Segundo alimento.
+ */
+static void intercambiarAlimentos(Alimento *a, Alimento *b) {
+    Alimento temp = *a;
+    *a = *b;
+    *b = temp;
 }
 
 /**
@@ -78,6 +180,12 @@ int obtenerNumeroDeAlimentos(HashTable *tabla) {
  * @return Índice de partición.
  */
 int particionAlimentos(Alimento alimentos[], int low, int high) {
+    // Mediana de tres como pivote: evita el peor caso con arreglos ya ordenados
+    int mid = low + (high - low) / 2;
+    if (alimentos[mid].precio < alimentos[low].precio) intercambiarAlimentos(&alimentos[mid], &alimentos[low]);
+    if (alimentos[high].precio < alimentos[low].precio) intercambiarAlimentos(&alimentos[high], &alimentos[low]);
+    if (alimentos[mid].precio < alimentos[high].precio) intercambiarAlimentos(&alimentos[mid], &alimentos[high]);
+
     float pivot = alimentos[high].precio; // Puedes cambiar a alimentos[high].id para ordenar por ID
     int i = low - 1;
 
@@ -97,58 +205,109 @@ int particionAlimentos(Alimento alimentos[], int low, int high) {
     return i + 1;
 }
 
+static void ordenarAlimentos(Alimento alimentos[], int low, int high);
+
 /**
- * @brief Ordena un arreglo de alimentos en paralelo utilizando QuickSort.
- * @param alimentos Arreglo de alimentos a ordenar.
+ * @brief Rango de un arreglo de alimentos que ordena una tarea.
+ */
+typedef struct {
+    Alimento *alimentos;
+    int low;
+    int high;
+} RangoAlimentos;
+
+/**
+ * @brief Tarea que ordena un rango con ordenarAlimentos.
+ * @param argumento Puntero a un RangoAlimentos.
+ */
+static void ordenarRangoAlimentos(void *argumento) {
+    RangoAlimentos *rango = (RangoAlimentos *)argumento;
+    ordenarAlimentos(rango->alimentos, rango->low, rango->high);
+}
+
+/**
+ * @brief Ordena el rango [low, high] con QuickSort; las mitades grandes se reparten en tareas.
+ * @param alimentos Arreglo de alimentos.
  * @param low Índice inferior del rango.
  * @param high Índice superior del rango.
  */
-void quicksortAlimentosParallel(Alimento alimentos[], int low, int high) {
+static void ordenarAlimentos(Alimento alimentos[], int low, int high) {
     if (low < high) {
         int pi = particionAlimentos(alimentos, low, high);
-
-        #pragma omp parallel sections
-        {
-            #pragma omp section
-            quicksortAlimentosParallel(alimentos, low, pi - 1);
-
-            #pragma omp section
-            quicksortAlimentosParallel(alimentos, pi + 1, high);
+        if (high - low < TAREAS_UMBRAL_ORDENAMIENTO) { // Un rango chico no compensa una tarea
+            ordenarAlimentos(alimentos, low, pi - 1);
+            ordenarAlimentos(alimentos, pi + 1, high);
+            return;
         }
+
+        // La mitad izquierda queda disponible para otro hilo mientras este ordena la derecha
+        RangoAlimentos izquierda = { alimentos, low, pi - 1 };
+        Tarea tarea;
+        lanzarTarea(&tarea, ordenarRangoAlimentos, &izquierda);
+        ordenarAlimentos(alimentos, pi + 1, high);
+        esperarTarea(&tarea);
     }
 }
 
 /**
- * @brief Realiza una búsqueda binaria paralelizada para encontrar un alimento por su ID.
+ * @brief Ordena un arreglo de alimentos en paralelo utilizando QuickSort con el pool de tareas.
+ * @param alimentos Arreglo de alimentos a ordenar.
+ * @param low Índice inferior del rango.
+ * @param high Índice superior del rango.
+ */
+void quicksortAlimentosParallel(Alimento alimentos[], int low, int high) {
+    MEDIR_LATENCIA(LATENCIA_ORDENAR_ALIMENTOS);
+    ordenarAlimentos(alimentos, low, high);
+}
+
+/**
+ * @brief Realiza una búsqueda binaria para encontrar un alimento por su ID.
  * @param alimentos Arreglo de alimentos ordenados.
  * @param numAlimentos Número de alimentos en el arreglo.
  * @param idBuscado ID del alimento a buscar.
  * @return Índice del alimento encontrado, o -1 si no existe.
  */
 int busquedaBinariaAlimentosParallel(Alimento alimentos[], int numAlimentos, int idBuscado) {
-    int resultado = -1;
-
-    #pragma omp parallel
-    {
-        int low = 0, high = numAlimentos - 1;
-        while (low <= high) {
-            int mid = low + (high - low) / 2;
-
-            if (alimentos[mid].id == idBuscado) {
-                #pragma omp critical
-                {
-                    resultado = mid; // Actualizamos el resultado de forma segura
-                }
-                break; // Salimos del bucle
-            } else if (alimentos[mid].id < idBuscado) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
+    MEDIR_LATENCIA(LATENCIA_BUSQUEDA_BINARIA_ALIMENTOS);
+    // Una sola búsqueda es O(log n): abrir hilos para ella cuesta más que hacerla
+    int low = 0, high = numAlimentos - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (alimentos[mid].id == idBuscado) {
+            return mid;
+        } else if (alimentos[mid].id < idBuscado) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
         }
     }
+    return -1;
+}
 
-    return resultado; // Retornamos el índice encontrado o -1 si no existe
+/**
+ * @brief Enlaza un nodo nuevo en el arreglo directo o en su bucket y actualiza el contador.
+ *
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @param nuevo Nodo ya inicializado; no se verifica si su ID existe.
+ */
+static void enlazarAlimento(HashTable *tabla, Alimento *nuevo) {
+    int id = nuevo->id;
+    int capacidad = capacidadDensaPara(id, tabla->capacidadDirecta, tabla->numAlimentos);
+    if (capacidad > tabla->capacidadDirecta) {
+        ampliarRangoDirecto(tabla, capacidad); // Si falla, el registro va a la tabla hash
+    }
+    if (id >= 0 && id < tabla->capacidadDirecta) {
+        nuevo->next = NULL;
+        tabla->directo[id] = nuevo;
+    } else {
+        unsigned int index = hashFunctionMidSquare(id);
+        nuevo->next = tabla->buckets[index];
+        tabla->buckets[index] = nuevo;
+    }
+    tabla->numAlimentos++;
+    adoptarNodo(&tabla->bloqueNodos, nuevo);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    invalidarTotalesAlimento(tabla, id); // Los menús que lo usaban contaban 0
 }
 
 /**
@@ -161,41 +320,65 @@ int busquedaBinariaAlimentosParallel(Alimento alimentos[], int numAlimentos, int
  * @return true si se insertó correctamente, false en caso contrario.
  */
 bool insertarAlimento(HashTable *tabla, int id, const char *nombre, float precio, const char *disponibleStr) {
+    MEDIR_LATENCIA(LATENCIA_INSERTAR_ALIMENTO);
     int disponible;
     if (strcmp(disponibleStr, "Si") == 0) {
         disponible = 1;
     } else if (strcmp(disponibleStr, "No") == 0) {
         disponible = 0;
     } else {
-        printf("\nError: Entrada inválida para disponibilidad. Use estrictamente 'Si' o 'No'.\n");
+        MENSAJE("\nError: Entrada inválida para disponibilidad. Use estrictamente 'Si' o 'No'.\n");
         return false;
     }
 
     if (buscarAlimento(tabla, id)) {
-        printf("\nError: El alimento con ID=%d ya existe.\n", id);
+        MENSAJE("\nError: El alimento con ID=%d ya existe.\n", id);
         return false;
     }
 
-    unsigned int index = hashFunctionMidSquare(id);
+    Cadena cadenaNombre;
+    if (!internarTexto(nombre, &cadenaNombre)) return false;
 
     Alimento *nuevo = (Alimento *)malloc(sizeof(Alimento));
     if (!nuevo) {
-        printf("\nError: No se pudo insertar el alimento.\n");
+        soltarCadena(cadenaNombre);
+        MENSAJE("\nError: No se pudo insertar el alimento.\n");
         return false;
     }
 
     nuevo->id = id;
-    strcpy(nuevo->nombre, nombre);
+    nuevo->nombre = cadenaNombre;
     nuevo->precio = precio;
     nuevo->disponible = disponible;
-    nuevo->next = tabla->buckets[index];
-    tabla->buckets[index] = nuevo;
 
-    printf("\nAlimento insertado: ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s\n",
+    enlazarAlimento(tabla, nuevo);
+    marcarCambio(&tabla->cambios, id, CAMBIO_SUCIO);
+    notificarMutacion(MUTACION_ALIMENTO_PONER, nuevo, id);
+
+    MENSAJE("\nAlimento insertado: ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s\n",
            id, nombre, precio, disponible ? "Si" : "No");
     return true;
 }
 
+/**
+ * @brief Inserta un alimento ya construido sin validarlo ni imprimir mensajes.
+ *
+ * Se usa al restaurar datos que ya se validaron cuando se guardaron (por ejemplo, un
+ * snapshot binario). La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`.
+ *
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @param alimento Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un alimento con ese ID (el nodo no se libera).
+ */
+bool restaurarAlimento(HashTable *tabla, Alimento *alimento) {
+    MEDIR_LATENCIA(LATENCIA_RESTAURAR_ALIMENTO);
+    if (buscarAlimento(tabla, alimento->id)) {
+        return false;
+    }
+    enlazarAlimento(tabla, alimento);
+    return true;
+}
+
 /**
  * @brief Busca un alimento en la tabla hash por su ID.
  * @param tabla Puntero a la tabla hash.
@@ -203,6 +386,11 @@ bool insertarAlimento(HashTable *tabla, int id, const char *nombre, float precio
  * @return Puntero al alimento encontrado, o NULL si no existe.
  */
 Alimento *buscarAlimento(HashTable *tabla, int id) {
+    MEDIR_LATENCIA(LATENCIA_BUSCAR_ALIMENTO);
+    if (id >= 0 && id < tabla->capacidadDirecta) {
+        return tabla->directo[id];
+    }
+
     unsigned int index = hashFunctionMidSquare(id);
     Alimento *actual = tabla->buckets[index];
 
@@ -216,12 +404,29 @@ Alimento *buscarAlimento(HashTable *tabla, int id) {
 }
 
 /**
- * @brief Elimina un alimento de la tabla hash por su ID.
+ * @brief Quita un alimento de la tabla sin imprimir mensajes ni notificar el cambio.
+ *
+ * Se usa al reproducir la bitácora (ver bitacora.h).
+ *
  * @param tabla Puntero a la tabla hash.
- * @param id ID del alimento a eliminar.
- * @return true si se eliminó correctamente, false en caso contrario.
+ * @param id ID del alimento a quitar.
+ * @return `true` si se quitó, `false` si no existía.
  */
-bool eliminarAlimento(HashTable *tabla, int id) {
+bool retirarAlimento(HashTable *tabla, int id) {
+    MEDIR_LATENCIA(LATENCIA_RETIRAR_ALIMENTO);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    invalidarTotalesAlimento(tabla, id);
+    if (id >= 0 && id < tabla->capacidadDirecta) {
+        if (tabla->directo[id]) {
+            soltarCadena(tabla->directo[id]->nombre);
+            liberarNodo(&tabla->bloqueNodos, tabla->directo[id]);
+            tabla->directo[id] = NULL;
+            tabla->numAlimentos--;
+            return true;
+        }
+        return false;
+    }
+
     unsigned int index = hashFunctionMidSquare(id);
     Alimento *actual = tabla->buckets[index];
     Alimento *previo = NULL;
@@ -233,17 +438,35 @@ bool eliminarAlimento(HashTable *tabla, int id) {
             } else {
                 tabla->buckets[index] = actual->next;
             }
-            free(actual);
-            printf("\nAlimento eliminado: ID=%d\n", id);
+            soltarCadena(actual->nombre);
+            liberarNodo(&tabla->bloqueNodos, actual);
+            tabla->numAlimentos--;
             return true;
         }
         previo = actual;
         actual = actual->next;
     }
-    printf("\nError: Alimento con ID=%d no encontrado.\n", id);
     return false;
 }
 
+/**
+ * @brief Elimina un alimento de la tabla hash por su ID.
+ * @param tabla Puntero a la tabla hash.
+ * @param id ID del alimento a eliminar.
+ * @return true si se eliminó correctamente, false en caso contrario.
+ */
+bool eliminarAlimento(HashTable *tabla, int id) {
+    MEDIR_LATENCIA(LATENCIA_ELIMINAR_ALIMENTO);
+    if (!retirarAlimento(tabla, id)) {
+        MENSAJE("\nError: Alimento con ID=%d no encontrado.\n", id);
+        return false;
+    }
+    marcarCambio(&tabla->cambios, id, CAMBIO_ELIMINADO);
+    notificarMutacion(MUTACION_ALIMENTO_QUITAR, NULL, id);
+    MENSAJE("\nAlimento eliminado: ID=%d\n", id);
+    return true;
+}
+
 /**
  * @brief Actualiza un alimento en la tabla hash.
  * @param tabla Puntero a la tabla hash.
@@ -254,9 +477,10 @@ bool eliminarAlimento(HashTable *tabla, int id) {
  * @return true si se actualizó correctamente, false en caso contrario.
  */
 bool actualizarAlimento(HashTable *tabla, int idAlimento, const char *nuevoNombre, float nuevoPrecio, const char *nuevaDisponibilidadStr) {
+    MEDIR_LATENCIA(LATENCIA_ACTUALIZAR_ALIMENTO);
     Alimento *alimento = buscarAlimento(tabla, idAlimento);
     if (!alimento) {
-        printf("\nError: Alimento con ID=%d no encontrado.\n", idAlimento);
+        MENSAJE("\nError: Alimento con ID=%d no encontrado.\n", idAlimento);
         return false;
     }
 
@@ -266,16 +490,26 @@ bool actualizarAlimento(HashTable *tabla, int idAlimento, const char *nuevoNombr
     } else if (strcmp(nuevaDisponibilidadStr, "No") == 0) {
         nuevaDisponibilidad = 0;
     } else {
-        printf("\nError: Entrada inválida para disponibilidad. Use estrictamente 'Si' o 'No'.\n");
+        MENSAJE("\nError: Entrada inválida para disponibilidad. Use estrictamente 'Si' o 'No'.\n");
         return false;
     }
 
-    strcpy(alimento->nombre, nuevoNombre);
+    Cadena cadenaNombre;
+    if (!internarTexto(nuevoNombre, &cadenaNombre)) return false;
+
+    if (alimento->precio != nuevoPrecio) {
+        invalidarTotalesAlimento(tabla, idAlimento);
+    }
+    soltarCadena(alimento->nombre);
+    alimento->nombre = cadenaNombre;
     alimento->precio = nuevoPrecio;
     alimento->disponible = nuevaDisponibilidad;
+    marcarCambio(&tabla->cambios, idAlimento, CAMBIO_SUCIO);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    notificarMutacion(MUTACION_ALIMENTO_PONER, alimento, idAlimento);
 
-    printf("\nAlimento actualizado: ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s\n",
-           idAlimento, alimento->nombre, alimento->precio, alimento->disponible ? "Si" : "No");
+    MENSAJE("\nAlimento actualizado: ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s\n",
+           idAlimento, textoCadena(alimento->nombre), alimento->precio, alimento->disponible ? "Si" : "No");
     return true;
 }
 
@@ -285,13 +519,24 @@ bool actualizarAlimento(HashTable *tabla, int idAlimento, const char *nuevoNombr
  */
 void mostrarTabla(HashTable *tabla) {
     printf("\n--- Tabla Hash de Alimentos ---\n");
+    if (tabla->capacidadDirecta > 0) {
+        printf("Rango directo (IDs 0-%d): ", tabla->capacidadDirecta - 1);
+        for (int i = 0; i < tabla->capacidadDirecta; i++) {
+            Alimento *actual = tabla->directo[i];
+            if (actual) {
+                printf("[ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s] -> ",
+                       actual->id, textoCadena(actual->nombre), actual->precio, actual->disponible ? "Sí" : "No");
+            }
+        }
+        printf("NULL\n");
+    }
     for (int i = 0; i < HASH_TABLE_SIZE; i++) {
         if (tabla->buckets[i] != NULL) {
             printf("Bucket %d: ", i);
             Alimento *actual = tabla->buckets[i];
             while (actual) {
                 printf("[ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s] -> ",
-                       actual->id, actual->nombre, actual->precio, actual->disponible ? "Sí" : "No");
+                       actual->id, textoCadena(actual->nombre), actual->precio, actual->disponible ? "Sí" : "No");
                 actual = actual->next;
             }
             printf("NULL\n");
@@ -300,17 +545,46 @@ void mostrarTabla(HashTable *tabla) {
 }
 
 /**
- * @brief Libera la memoria ocupada por la tabla hash.
- * @param tabla Puntero a la tabla hash a liberar.
+ * @brief Elimina todos los alimentos de la tabla y la deja vacía y lista para usarse.
+ *
+ * @param tabla Puntero a la tabla hash de alimentos.
  */
-void liberarTabla(HashTable *tabla) {
+void vaciarTablaAlimentos(HashTable *tabla) {
+    olvidarTotalesTabla(tabla);
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (!tabla->directo[i]) continue;
+        soltarCadena(tabla->directo[i]->nombre);
+        liberarNodo(&tabla->bloqueNodos, tabla->directo[i]);
+    }
+    contarLiberacion(MEMORIA_ALIMENTOS, (size_t)tabla->capacidadDirecta * sizeof(Alimento *));
+    free(tabla->directo);
     for (int i = 0; i < HASH_TABLE_SIZE; i++) {
         Alimento *actual = tabla->buckets[i];
         while (actual) {
             Alimento *temp = actual;
             actual = actual->next;
-            free(temp);
+            soltarCadena(temp->nombre);
+            liberarNodo(&tabla->bloqueNodos, temp);
         }
     }
+    liberarBloqueNodos(&tabla->bloqueNodos);
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+        tabla->buckets[i] = NULL;
+    }
+    tabla->numAlimentos = 0;
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    liberarCambios(&tabla->cambios);
+    tabla->cambios.requiereBase = true; // Lo que se cargue después no pasa por marcarCambio
+}
+
+/**
+ * @brief Libera la memoria ocupada por la tabla hash.
+ * @param tabla Puntero a la tabla hash a liberar.
+ */
+void liberarTabla(HashTable *tabla) {
+    vaciarTablaAlimentos(tabla);
+    contarLiberacion(MEMORIA_ALIMENTOS, sizeof(HashTable));
     free(tabla);
 }
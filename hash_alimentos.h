@@ -3,6 +3,10 @@
 
 #include <stdbool.h> // Para usar el tipo bool
 #include <stdlib.h>  // Para malloc, free
+#include "bloque_nodos.h"
+#include "cadenas_internadas.h"
+#include "cambios_pendientes.h"
+#include "indice_busqueda.h"
 
 /** 
  * @def HASH_TABLE_SIZE
@@ -17,7 +21,7 @@
  * @var Alimento::id
  * ID único del alimento.
  * @var Alimento::nombre
- * Nombre del alimento.
+ * Nombre del alimento, internado (ver cadenas_internadas.h); el texto se obtiene con textoCadena.
  * @var Alimento::precio
  * Precio del alimento.
  * @var Alimento::disponible
@@ -27,7 +31,7 @@
  */
 typedef struct Alimento {
     int id;
-    char nombre[50];
+    Cadena nombre;
     float precio;
     int disponible;
     struct Alimento *next; // Encadenamiento para colisiones
@@ -39,9 +43,27 @@ typedef struct Alimento {
  * 
  * @var HashTable::buckets
  * Arreglo de punteros a los buckets de la tabla hash.
+ * @var HashTable::directo
+ * Arreglo indexado por ID para el rango denso [0, capacidadDirecta) (ver rango_denso.h).
+ * @var HashTable::capacidadDirecta
+ * Número de ranuras del arreglo directo (0 si aún no se usa).
+ * @var HashTable::numAlimentos
+ * Número total de alimentos (arreglo directo más buckets).
+ * @var HashTable::bloqueNodos
+ * Nodos reservados en un solo bloque al restaurar un snapshot (ver bloque_nodos.h).
+ * @var HashTable::cambios
+ * IDs agregados, actualizados o eliminados desde el último guardado (ver cambios_pendientes.h).
+ * @var HashTable::indiceIds
+ * Índice de los IDs construido en la última búsqueda por cota inferior (`NULL` si cambió la tabla; ver indiceIdsAlimentos).
  */
 typedef struct {
     Alimento *buckets[HASH_TABLE_SIZE];
+    Alimento **directo;
+    int capacidadDirecta;
+    int numAlimentos;
+    BloqueNodos bloqueNodos;
+    CambiosPendientes cambios;
+    IndiceBusqueda *indiceIds;
 } HashTable;
 
 /**
@@ -68,6 +90,19 @@ unsigned int hashFunctionMidSquare(int id);
  */
 bool insertarAlimento(HashTable *tabla, int id, const char *nombre, float precio, const char *disponibleStr);
 
+/**
+ * @brief Inserta un alimento ya construido sin validarlo ni imprimir mensajes.
+ *
+ * La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`,
+ * y de la referencia a su nombre (ver soltarCadena); si no se insertó, ambos siguen
+ * siendo del llamador.
+ *
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @param alimento Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un alimento con ese ID.
+ */
+bool restaurarAlimento(HashTable *tabla, Alimento *alimento);
+
 /**
  * @brief Busca un alimento en la tabla hash.
  * @param tabla Puntero a la tabla hash.
@@ -76,6 +111,14 @@ bool insertarAlimento(HashTable *tabla, int id, const char *nombre, float precio
  */
 Alimento *buscarAlimento(HashTable *tabla, int id);
 
+/**
+ * @brief Quita un alimento de la tabla sin imprimir mensajes ni notificar el cambio (ver mutaciones.h).
+ * @param tabla Puntero a la tabla hash.
+ * @param id ID del alimento a quitar.
+ * @return `true` si se quitó, `false` si no existía.
+ */
+bool retirarAlimento(HashTable *tabla, int id);
+
 /**
  * @brief Elimina un alimento de la tabla hash.
  * @param tabla Puntero a la tabla hash.
@@ -108,7 +151,13 @@ void mostrarTabla(HashTable *tabla);
 void liberarTabla(HashTable *tabla);
 
 /**
- * @brief Ordena un arreglo de alimentos en paralelo utilizando QuickSort.
+ * @brief Elimina todos los alimentos de la tabla y la deja vacía y lista para usarse.
+ * @param tabla Puntero a la tabla hash de alimentos.
+ */
+void vaciarTablaAlimentos(HashTable *tabla);
+
+/**
+ * @brief Ordena un arreglo de alimentos en paralelo utilizando QuickSort con el pool de tareas.
  * @param alimentos Arreglo de alimentos a ordenar.
  * @param low Índice inicial del arreglo.
  * @param high Índice final del arreglo.
@@ -116,7 +165,7 @@ void liberarTabla(HashTable *tabla);
 void quicksortAlimentosParallel(Alimento alimentos[], int low, int high);
 
 /**
- * @brief Realiza una búsqueda binaria en paralelo para encontrar un alimento por su ID.
+ * @brief Realiza una búsqueda binaria para encontrar un alimento por su ID.
  * @param alimentos Arreglo de alimentos ordenados.
  * @param numAlimentos Número de alimentos en el arreglo.
  * @param idBuscado ID del alimento a buscar.
@@ -131,6 +180,31 @@ int busquedaBinariaAlimentosParallel(Alimento alimentos[], int numAlimentos, int
  */
 void copiarAlimentosDesdeTabla(HashTable *tabla, Alimento alimentos[]);
 
+/**
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior (ver indice_busqueda.h).
+ *
+ * Se construye la primera vez que se pide y queda guardado en la tabla hasta que un
+ * alta, una actualización o una baja lo invalida; mientras tanto, cada búsqueda solo
+ * recorre el índice.
+ *
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsAlimentos(HashTable *tabla);
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ *
+ * Sirve para configurar la tabla cuando se sabe de antemano que los IDs son
+ * consecutivos; los alimentos ya guardados en los buckets dentro del rango se
+ * mueven al arreglo directo.
+ *
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return true si el rango quedó reservado, false si el ID está fuera del límite o no hubo memoria.
+ */
+bool reservarRangoDensoAlimentos(HashTable *tabla, int idMaximo);
+
 /**
  * @brief Obtiene el número de alimentos almacenados en la tabla hash.
  * @param tabla Puntero a la tabla hash.
@@ -4,10 +4,14 @@
  */
 
 #include "hash_clientes.h"
+#include "rango_denso.h"
+#include "mensajes.h"
+#include "mutaciones.h"
+#include "tareas.h"
+#include "latencias.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <omp.h>
 
 /**
  * @brief Crea una nueva tabla hash para almacenar clientes.
@@ -22,6 +26,13 @@ ClientesHashTable *crearTablaClientes() {
     for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
         tabla->buckets[i] = NULL;
     }
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    tabla->numClientes = 0;
+    iniciarBloqueNodos(&tabla->bloqueNodos, MEMORIA_CLIENTES, sizeof(Cliente));
+    iniciarCambios(&tabla->cambios);
+    tabla->indiceIds = NULL;
+    contarReserva(MEMORIA_CLIENTES, sizeof(ClientesHashTable));
     return tabla;
 }
 
@@ -34,13 +45,71 @@ unsigned int hashCliente(int idCliente) {
     return idCliente % CLIENTES_TABLE_SIZE;
 }
 
+/**
+ * @brief Amplía el arreglo directo y mueve a él los clientes de los buckets que caen en el nuevo rango.
+ * @param tabla Puntero a la tabla hash.
+ * @param capacidad Nueva capacidad del arreglo directo.
+ * @return `true` si se amplió correctamente, `false` si no hubo memoria.
+ */
+static bool ampliarRangoDirecto(ClientesHashTable *tabla, int capacidad) {
+    Cliente **directo = (Cliente **)realloc(tabla->directo, capacidad * sizeof(Cliente *));
+    if (!directo) {
+        return false;
+    }
+    for (int i = tabla->capacidadDirecta; i < capacidad; i++) {
+        directo[i] = NULL;
+    }
+    contarReserva(MEMORIA_CLIENTES, (size_t)(capacidad - tabla->capacidadDirecta) * sizeof(Cliente *));
+    tabla->directo = directo;
+    tabla->capacidadDirecta = capacidad;
+
+    for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
+        Cliente **enlace = &tabla->buckets[i];
+        while (*enlace) {
+            Cliente *actual = *enlace;
+            if (actual->idCliente >= 0 && actual->idCliente < capacidad) {
+                *enlace = actual->next;
+                actual->next = NULL;
+                directo[actual->idCliente] = actual;
+            } else {
+                enlace = &actual->next;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return `true` si el rango quedó reservado, `false` en caso contrario.
+ */
+bool reservarRangoDensoClientes(ClientesHashTable *tabla, int idMaximo) {
+    if (idMaximo < 0 || idMaximo >= RANGO_DENSO_MAXIMO) {
+        return false;
+    }
+    if (idMaximo < tabla->capacidadDirecta) {
+        return true;
+    }
+    int capacidad = tabla->capacidadDirecta > 0 ? tabla->capacidadDirecta : RANGO_DENSO_MINIMO;
+    while (capacidad <= idMaximo) capacidad *= 2;
+    return ampliarRangoDirecto(tabla, capacidad);
+}
+
 /**
  * @brief Copia los clientes de la tabla hash a un arreglo.
  * @param tabla Puntero a la tabla hash de clientes.
  * @param clientes Arreglo donde se almacenarán los clientes copiados.
  */
 void copiarClientesDesdeTabla(ClientesHashTable *tabla, Cliente clientes[]) {
+    MEDIR_LATENCIA(LATENCIA_COPIAR_CLIENTES);
     int index = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) { // Recorrido secuencial del rango denso
+        if (tabla->directo[i]) {
+            clientes[index++] = *tabla->directo[i];
+        }
+    }
     for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
         Cliente *actual = tabla->buckets[i];
         while (actual) {
@@ -50,21 +119,53 @@ void copiarClientesDesdeTabla(ClientesHashTable *tabla, Cliente clientes[]) {
     }
 }
 
+/**
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior.
+ *
+ * La primera llamada copia los IDs (el rango directo ya sale ordenado; los de los
+ * buckets los ordena crearIndiceBusqueda) y construye el índice; las siguientes lo
+ * reutilizan hasta que un alta, una actualización o una baja lo invalida.
+ *
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsClientes(ClientesHashTable *tabla) {
+    if (tabla->indiceIds) return tabla->indiceIds;
+    int *ids = (int *)malloc(((size_t)tabla->numClientes + 1) * sizeof(int));
+    if (!ids) {
+        printf("\nError: No se pudo crear el índice de búsqueda.\n");
+        return NULL;
+    }
+    int numIds = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) ids[numIds++] = i;
+    }
+    for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
+        for (Cliente *actual = tabla->buckets[i]; actual; actual = actual->next) ids[numIds++] = actual->idCliente;
+    }
+    tabla->indiceIds = crearIndiceBusqueda(ids, numIds);
+    free(ids);
+    return tabla->indiceIds;
+}
+
 /**
  * @brief Cuenta el número de clientes almacenados en la tabla hash.
  * @param tabla Puntero a la tabla hash de clientes.
  * @return Número de clientes en la tabla.
  */
 int obtenerNumeroDeClientes(ClientesHashTable *tabla) {
-    int contador = 0;
-    for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
-        Cliente *actual = tabla->buckets[i];
-        while (actual) {
-            contador++;
-            actual = actual->next;
-        }
-    }
-    return contador;
+    return tabla->numClientes;
+}
+
+/**
+ * @brief Intercambia dos clientes de un arreglo.
+ * @param a Primer elemento.
+ * @param b Segundo elemento.
+ */
+static void intercambiarClientes(Cliente *a, Cliente *b) {
+    Cliente temp = *a;
+    *a = *b;
+    *b = temp;
 }
 
 /**
@@ -75,6 +176,12 @@ int obtenerNumeroDeClientes(ClientesHashTable *tabla) {
  * @return Índice de partición.
  */
 int particionClientes(Cliente clientes[], int low, int high) {
+    // Mediana de tres como pivote: evita el peor caso con arreglos ya ordenados
+    int mid = low + (high - low) / 2;
+    if (clientes[mid].idCliente < clientes[low].idCliente) intercambiarClientes(&clientes[mid], &clientes[low]);
+    if (clientes[high].idCliente < clientes[low].idCliente) intercambiarClientes(&clientes[high], &clientes[low]);
+    if (clientes[mid].idCliente < clientes[high].idCliente) intercambiarClientes(&clientes[mid], &clientes[high]);
+
     int pivot = clientes[high].idCliente;
     int i = low - 1;
 
@@ -94,58 +201,108 @@ int particionClientes(Cliente clientes[], int low, int high) {
     return i + 1;
 }
 
+static void ordenarClientes(Cliente clientes[], int low, int high);
+
 /**
- * @brief Ordena un arreglo de clientes en paralelo utilizando QuickSort.
- * @param clientes Arreglo de clientes a ordenar.
+ * @brief Rango de un arreglo de clientes que ordena una tarea.
+ */
+typedef struct {
+    Cliente *clientes;
+    int low;
+    int high;
+} RangoClientes;
+
+/**
+ * @brief Tarea que ordena un rango con ordenarClientes.
+ * @param argumento Puntero a un RangoClientes.
+ */
+static void ordenarRangoClientes(void *argumento) {
+    RangoClientes *rango = (RangoClientes *)argumento;
+    ordenarClientes(rango->clientes, rango->low, rango->high);
+}
+
+/**
+ * @brief Ordena el rango [low, high] con QuickSort; las mitades grandes se reparten en tareas.
+ * @param clientes Arreglo de clientes.
  * @param low Índice inferior del rango.
  * @param high Índice superior del rango.
  */
-void quicksortClientesParallel(Cliente clientes[], int low, int high) {
+static void ordenarClientes(Cliente clientes[], int low, int high) {
     if (low < high) {
         int pi = particionClientes(clientes, low, high);
-
-        #pragma omp parallel sections
-        {
-            #pragma omp section
-            quicksortClientesParallel(clientes, low, pi - 1);
-
-            #pragma omp section
-            quicksortClientesParallel(clientes, pi + 1, high);
+        if (high - low < TAREAS_UMBRAL_ORDENAMIENTO) { // Un rango chico no compensa una tarea
+            ordenarClientes(clientes, low, pi - 1);
+            ordenarClientes(clientes, pi + 1, high);
+            return;
         }
+
+        // La mitad izquierda queda disponible para otro hilo mientras este ordena la derecha
+        RangoClientes izquierda = { clientes, low, pi - 1 };
+        Tarea tarea;
+        lanzarTarea(&tarea, ordenarRangoClientes, &izquierda);
+        ordenarClientes(clientes, pi + 1, high);
+        esperarTarea(&tarea);
     }
 }
 
 /**
- * @brief Realiza una búsqueda binaria paralelizada para encontrar un cliente por su ID.
+ * @brief Ordena un arreglo de clientes en paralelo utilizando QuickSort con el pool de tareas.
+ * @param clientes Arreglo de clientes a ordenar.
+ * @param low Índice inferior del rango.
+ * @param high Índice superior del rango.
+ */
+void quicksortClientesParallel(Cliente clientes[], int low, int high) {
+    MEDIR_LATENCIA(LATENCIA_ORDENAR_CLIENTES);
+    ordenarClientes(clientes, low, high);
+}
+
+/**
+ * @brief Realiza una búsqueda binaria para encontrar un cliente por su ID.
  * @param clientes Arreglo de clientes ordenados.
  * @param numClientes Número de clientes en el arreglo.
  * @param idBuscado ID del cliente a buscar.
  * @return Índice del cliente encontrado, o -1 si no existe.
  */
 int busquedaBinariaClientesParallel(Cliente clientes[], int numClientes, int idBuscado) {
-    int resultado = -1;
-
-    #pragma omp parallel
-    {
-        int low = 0, high = numClientes - 1;
-        while (low <= high) {
-            int mid = low + (high - low) / 2;
-
-            if (clientes[mid].idCliente == idBuscado) {
-                #pragma omp critical
-                {
-                    resultado = mid; // Actualizamos el resultado de forma segura
-                }
-                break; // Salimos del bucle
-            } else if (clientes[mid].idCliente < idBuscado) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
+    MEDIR_LATENCIA(LATENCIA_BUSQUEDA_BINARIA_CLIENTES);
+    // Una sola búsqueda es O(log n): abrir hilos para ella cuesta más que hacerla
+    int low = 0, high = numClientes - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (clientes[mid].idCliente == idBuscado) {
+            return mid;
+        } else if (clientes[mid].idCliente < idBuscado) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
         }
     }
+    return -1;
+}
 
-    return resultado;
+/**
+ * @brief Enlaza un nodo nuevo en el arreglo directo o en su bucket y actualiza el contador.
+ *
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @param nuevo Nodo ya inicializado; no se verifica si su ID existe.
+ */
+static void enlazarCliente(ClientesHashTable *tabla, Cliente *nuevo) {
+    int id = nuevo->idCliente;
+    int capacidad = capacidadDensaPara(id, tabla->capacidadDirecta, tabla->numClientes);
+    if (capacidad > tabla->capacidadDirecta) {
+        ampliarRangoDirecto(tabla, capacidad); // Si falla, el registro va a la tabla hash
+    }
+    if (id >= 0 && id < tabla->capacidadDirecta) {
+        nuevo->next = NULL;
+        tabla->directo[id] = nuevo;
+    } else {
+        unsigned int index = hashCliente(id);
+        nuevo->next = tabla->buckets[index];
+        tabla->buckets[index] = nuevo;
+    }
+    tabla->numClientes++;
+    adoptarNodo(&tabla->bloqueNodos, nuevo);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
 }
 
 /**
@@ -157,26 +314,50 @@ int busquedaBinariaClientesParallel(Cliente clientes[], int numClientes, int idB
  * @return true si el cliente fue agregado correctamente, false en caso contrario.
  */
 bool agregarCliente(ClientesHashTable *tabla, int idCliente, const char *nombre, const char *telefono) {
+    MEDIR_LATENCIA(LATENCIA_AGREGAR_CLIENTE);
     if (buscarCliente(tabla, idCliente)) { // Verificar si el ID ya existe
-        printf("\nError: El cliente con ID=%d ya existe.\n", idCliente);
+        MENSAJE("\nError: El cliente con ID=%d ya existe.\n", idCliente);
         return false;
     }
 
-    unsigned int index = hashCliente(idCliente);
+    Cadena cadenaNombre;
+    if (!internarTexto(nombre, &cadenaNombre)) return false;
 
     Cliente *nuevo = (Cliente *)malloc(sizeof(Cliente));
     if (!nuevo) {
-        printf("\nError: No se pudo agregar el cliente.\n");
+        soltarCadena(cadenaNombre);
+        MENSAJE("\nError: No se pudo agregar el cliente.\n");
         return false;
     }
 
     nuevo->idCliente = idCliente;
-    strcpy(nuevo->nombre, nombre);
+    nuevo->nombre = cadenaNombre;
     strcpy(nuevo->telefono, telefono);
-    nuevo->next = tabla->buckets[index];
-    tabla->buckets[index] = nuevo;
 
-    printf("\nCliente agregado: ID=%d, Nombre=%s, Teléfono=%s\n", idCliente, nombre, telefono);
+    enlazarCliente(tabla, nuevo);
+    marcarCambio(&tabla->cambios, idCliente, CAMBIO_SUCIO);
+    notificarMutacion(MUTACION_CLIENTE_PONER, nuevo, idCliente);
+
+    MENSAJE("\nCliente agregado: ID=%d, Nombre=%s, Teléfono=%s\n", idCliente, nombre, telefono);
+    return true;
+}
+
+/**
+ * @brief Inserta un cliente ya construido sin validarlo ni imprimir mensajes.
+ *
+ * Se usa al restaurar datos que ya se validaron cuando se guardaron (por ejemplo, un
+ * snapshot binario). La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`.
+ *
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @param cliente Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un cliente con ese ID (el nodo no se libera).
+ */
+bool restaurarCliente(ClientesHashTable *tabla, Cliente *cliente) {
+    MEDIR_LATENCIA(LATENCIA_RESTAURAR_CLIENTE);
+    if (buscarCliente(tabla, cliente->idCliente)) {
+        return false;
+    }
+    enlazarCliente(tabla, cliente);
     return true;
 }
 
@@ -187,6 +368,11 @@ bool agregarCliente(ClientesHashTable *tabla, int idCliente, const char *nombre,
  * @return Puntero al cliente encontrado, o NULL si no existe.
  */
 Cliente *buscarCliente(ClientesHashTable *tabla, int idCliente) {
+    MEDIR_LATENCIA(LATENCIA_BUSCAR_CLIENTE);
+    if (idCliente >= 0 && idCliente < tabla->capacidadDirecta) {
+        return tabla->directo[idCliente];
+    }
+
     unsigned int index = hashCliente(idCliente);
     Cliente *actual = tabla->buckets[index];
 
@@ -200,12 +386,28 @@ Cliente *buscarCliente(ClientesHashTable *tabla, int idCliente) {
 }
 
 /**
- * @brief Elimina un cliente de la tabla hash.
+ * @brief Quita un cliente de la tabla sin imprimir mensajes ni notificar el cambio.
+ *
+ * Se usa al reproducir la bitácora (ver bitacora.h).
+ *
  * @param tabla Puntero a la tabla hash.
- * @param idCliente ID del cliente a eliminar.
- * @return true si el cliente fue eliminado correctamente, false en caso contrario.
+ * @param idCliente ID del cliente a quitar.
+ * @return `true` si se quitó, `false` si no existía.
  */
-bool eliminarCliente(ClientesHashTable *tabla, int idCliente) {
+bool retirarCliente(ClientesHashTable *tabla, int idCliente) {
+    MEDIR_LATENCIA(LATENCIA_RETIRAR_CLIENTE);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    if (idCliente >= 0 && idCliente < tabla->capacidadDirecta) {
+        if (tabla->directo[idCliente]) {
+            soltarCadena(tabla->directo[idCliente]->nombre);
+            liberarNodo(&tabla->bloqueNodos, tabla->directo[idCliente]);
+            tabla->directo[idCliente] = NULL;
+            tabla->numClientes--;
+            return true;
+        }
+        return false;
+    }
+
     unsigned int index = hashCliente(idCliente);
     Cliente *actual = tabla->buckets[index];
     Cliente *previo = NULL;
@@ -217,17 +419,35 @@ bool eliminarCliente(ClientesHashTable *tabla, int idCliente) {
             } else {
                 tabla->buckets[index] = actual->next;
             }
-            free(actual);
-            printf("\nCliente eliminado: ID=%d\n", idCliente);
+            soltarCadena(actual->nombre);
+            liberarNodo(&tabla->bloqueNodos, actual);
+            tabla->numClientes--;
             return true;
         }
         previo = actual;
         actual = actual->next;
     }
-    printf("\nError: Cliente con ID=%d no encontrado.\n", idCliente);
     return false;
 }
 
+/**
+ * @brief Elimina un cliente de la tabla hash.
+ * @param tabla Puntero a la tabla hash.
+ * @param idCliente ID del cliente a eliminar.
+ * @return true si el cliente fue eliminado correctamente, false en caso contrario.
+ */
+bool eliminarCliente(ClientesHashTable *tabla, int idCliente) {
+    MEDIR_LATENCIA(LATENCIA_ELIMINAR_CLIENTE);
+    if (!retirarCliente(tabla, idCliente)) {
+        MENSAJE("\nError: Cliente con ID=%d no encontrado.\n", idCliente);
+        return false;
+    }
+    marcarCambio(&tabla->cambios, idCliente, CAMBIO_ELIMINADO);
+    notificarMutacion(MUTACION_CLIENTE_QUITAR, NULL, idCliente);
+    MENSAJE("\nCliente eliminado: ID=%d\n", idCliente);
+    return true;
+}
+
 /**
  * @brief Actualiza la información de un cliente en la tabla hash.
  * @param tabla Puntero a la tabla hash.
@@ -237,15 +457,25 @@ bool eliminarCliente(ClientesHashTable *tabla, int idCliente) {
  * @return true si la actualización fue exitosa, false en caso contrario.
  */
 bool actualizarCliente(ClientesHashTable *tabla, int idCliente, const char *nuevoNombre, const char *nuevoTelefono) {
+    MEDIR_LATENCIA(LATENCIA_ACTUALIZAR_CLIENTE);
     Cliente *cliente = buscarCliente(tabla, idCliente);
     if (!cliente) {
-        printf("\nError: Cliente con ID=%d no encontrado.\n", idCliente);
+        MENSAJE("\nError: Cliente con ID=%d no encontrado.\n", idCliente);
         return false;
     }
 
-    strcpy(cliente->nombre, nuevoNombre);
+    Cadena cadenaNombre;
+    if (!internarTexto(nuevoNombre, &cadenaNombre)) return false;
+
+    // El nombre anterior se suelta: si nadie más lo usa, su espacio en la arena se reutiliza
+    soltarCadena(cliente->nombre);
+    cliente->nombre = cadenaNombre;
     strcpy(cliente->telefono, nuevoTelefono);
-    printf("\nCliente actualizado: ID=%d, Nombre=%s, Teléfono=%s\n", idCliente, cliente->nombre, cliente->telefono);
+    marcarCambio(&tabla->cambios, idCliente, CAMBIO_SUCIO);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    notificarMutacion(MUTACION_CLIENTE_PONER, cliente, idCliente);
+    MENSAJE("\nCliente actualizado: ID=%d, Nombre=%s, Teléfono=%s\n", idCliente, textoCadena(cliente->nombre),
+            cliente->telefono);
     return true;
 }
 
@@ -255,13 +485,24 @@ bool actualizarCliente(ClientesHashTable *tabla, int idCliente, const char *nuev
  */
 void mostrarTablaClientes(ClientesHashTable *tabla) {
     printf("\n--- Tabla Hash de Clientes ---\n");
+    if (tabla->capacidadDirecta > 0) {
+        printf("Rango directo (IDs 0-%d): ", tabla->capacidadDirecta - 1);
+        for (int i = 0; i < tabla->capacidadDirecta; i++) {
+            Cliente *actual = tabla->directo[i];
+            if (actual) {
+                printf("[ID=%d, Nombre=%s, Teléfono=%s] -> ",
+                       actual->idCliente, textoCadena(actual->nombre), actual->telefono);
+            }
+        }
+        printf("NULL\n");
+    }
     for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
         if (tabla->buckets[i] != NULL) { // Verificar si el bucket tiene datos
             printf("Bucket %d: ", i);
             Cliente *actual = tabla->buckets[i];
             while (actual) {
                 printf("[ID=%d, Nombre=%s, Teléfono=%s] -> ",
-                       actual->idCliente, actual->nombre, actual->telefono);
+                       actual->idCliente, textoCadena(actual->nombre), actual->telefono);
                 actual = actual->next;
             }
             printf("NULL\n");
@@ -270,17 +511,45 @@ void mostrarTablaClientes(ClientesHashTable *tabla) {
 }
 
 /**
- * @brief Libera la memoria ocupada por la tabla hash de clientes.
- * @param tabla Puntero a la tabla hash a liberar.
+ * @brief Elimina todos los clientes de la tabla y la deja vacía y lista para usarse.
+ *
+ * @param tabla Puntero a la tabla hash de clientes.
  */
-void liberarTablaClientes(ClientesHashTable *tabla) {
+void vaciarTablaClientes(ClientesHashTable *tabla) {
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (!tabla->directo[i]) continue;
+        soltarCadena(tabla->directo[i]->nombre);
+        liberarNodo(&tabla->bloqueNodos, tabla->directo[i]);
+    }
+    contarLiberacion(MEMORIA_CLIENTES, (size_t)tabla->capacidadDirecta * sizeof(Cliente *));
+    free(tabla->directo);
     for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
         Cliente *actual = tabla->buckets[i];
         while (actual) {
             Cliente *temp = actual;
             actual = actual->next;
-            free(temp);
+            soltarCadena(temp->nombre);
+            liberarNodo(&tabla->bloqueNodos, temp);
         }
     }
+    liberarBloqueNodos(&tabla->bloqueNodos);
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
+        tabla->buckets[i] = NULL;
+    }
+    tabla->numClientes = 0;
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    liberarCambios(&tabla->cambios);
+    tabla->cambios.requiereBase = true; // Lo que se cargue después no pasa por marcarCambio
+}
+
+/**
+ * @brief Libera la memoria ocupada por la tabla hash de clientes.
+ * @param tabla Puntero a la tabla hash a liberar.
+ */
+void liberarTablaClientes(ClientesHashTable *tabla) {
+    vaciarTablaClientes(tabla);
+    contarLiberacion(MEMORIA_CLIENTES, sizeof(ClientesHashTable));
     free(tabla);
 }
@@ -7,6 +7,10 @@
 #define HASH_CLIENTES_H
 
 #include <stdbool.h>
+#include "bloque_nodos.h"
+#include "cadenas_internadas.h"
+#include "cambios_pendientes.h"
+#include "indice_busqueda.h"
 
 /// Tamaño de la tabla hash para clientes.
 #define CLIENTES_TABLE_SIZE 64
@@ -16,7 +20,7 @@
  */
 typedef struct Cliente {
     int idCliente;         ///< ID único del cliente.
-    char nombre[50];       ///< Nombre completo del cliente.
+    Cadena nombre;         ///< Nombre completo del cliente (internado, ver cadenas_internadas.h).
     char telefono[15];     ///< Número de teléfono del cliente.
     struct Cliente *next;  ///< Puntero al siguiente cliente (manejo de colisiones).
 } Cliente;
@@ -26,6 +30,12 @@ typedef struct Cliente {
  */
 typedef struct {
     Cliente *buckets[CLIENTES_TABLE_SIZE]; ///< Arreglo de buckets que almacena listas enlazadas de clientes.
+    Cliente **directo; ///< Arreglo indexado por ID para el rango denso [0, capacidadDirecta) (ver rango_denso.h).
+    int capacidadDirecta; ///< Número de ranuras del arreglo directo (0 si aún no se usa).
+    int numClientes; ///< Número total de clientes (arreglo directo más buckets).
+    BloqueNodos bloqueNodos; ///< Nodos reservados en un solo bloque al restaurar un snapshot (ver bloque_nodos.h).
+    CambiosPendientes cambios; ///< IDs agregados, actualizados o eliminados desde el último guardado (ver cambios_pendientes.h).
+    IndiceBusqueda *indiceIds; ///< Índice de los IDs construido en la última búsqueda por cota inferior (`NULL` si cambió la tabla; ver indiceIdsClientes).
 } ClientesHashTable;
 
 /**
@@ -51,6 +61,19 @@ unsigned int hashCliente(int idCliente);
  */
 bool agregarCliente(ClientesHashTable *tabla, int idCliente, const char *nombre, const char *telefono);
 
+/**
+ * @brief Inserta un cliente ya construido sin validarlo ni imprimir mensajes.
+ *
+ * La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`,
+ * y de la referencia a su nombre (ver soltarCadena); si no se insertó, ambos siguen
+ * siendo del llamador.
+ *
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @param cliente Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un cliente con ese ID.
+ */
+bool restaurarCliente(ClientesHashTable *tabla, Cliente *cliente);
+
 /**
  * @brief Busca un cliente en la tabla hash por su ID.
  * @param tabla Puntero a la tabla hash.
@@ -59,6 +82,14 @@ bool agregarCliente(ClientesHashTable *tabla, int idCliente, const char *nombre,
  */
 Cliente *buscarCliente(ClientesHashTable *tabla, int idCliente);
 
+/**
+ * @brief Quita un cliente de la tabla sin imprimir mensajes ni notificar el cambio (ver mutaciones.h).
+ * @param tabla Puntero a la tabla hash.
+ * @param idCliente ID del cliente a quitar.
+ * @return `true` si se quitó, `false` si no existía.
+ */
+bool retirarCliente(ClientesHashTable *tabla, int idCliente);
+
 /**
  * @brief Elimina un cliente de la tabla hash por su ID.
  * @param tabla Puntero a la tabla hash.
@@ -89,6 +120,25 @@ void mostrarTablaClientes(ClientesHashTable *tabla);
  */
 void liberarTablaClientes(ClientesHashTable *tabla);
 
+/**
+ * @brief Elimina todos los clientes de la tabla y la deja vacía y lista para usarse.
+ * @param tabla Puntero a la tabla hash de clientes.
+ */
+void vaciarTablaClientes(ClientesHashTable *tabla);
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ *
+ * Sirve para configurar la tabla cuando se sabe de antemano que los IDs son
+ * consecutivos; los clientes ya guardados en los buckets dentro del rango se
+ * mueven al arreglo directo.
+ *
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return `true` si el rango quedó reservado, `false` si el ID está fuera del límite o no hubo memoria.
+ */
+bool reservarRangoDensoClientes(ClientesHashTable *tabla, int idMaximo);
+
 /**
  * @brief Obtiene el número de clientes almacenados en la tabla hash.
  * @param tabla Puntero a la tabla hash.
@@ -104,7 +154,19 @@ int obtenerNumeroDeClientes(ClientesHashTable *tabla);
 void copiarClientesDesdeTabla(ClientesHashTable *tabla, Cliente clientes[]);
 
 /**
- * @brief Ordena un arreglo de clientes en paralelo utilizando QuickSort.
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior (ver indice_busqueda.h).
+ *
+ * Se construye la primera vez que se pide y queda guardado en la tabla hasta que un
+ * alta, una actualización o una baja lo invalida; mientras tanto, cada búsqueda solo
+ * recorre el índice.
+ *
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsClientes(ClientesHashTable *tabla);
+
+/**
+ * @brief Ordena un arreglo de clientes en paralelo utilizando QuickSort con el pool de tareas.
  * @param clientes Arreglo de clientes a ordenar.
  * @param low Índice inferior del rango.
  * @param high Índice superior del rango.
@@ -112,7 +174,7 @@ void copiarClientesDesdeTabla(ClientesHashTable *tabla, Cliente clientes[]);
 void quicksortClientesParallel(Cliente clientes[], int low, int high);
 
 /**
- * @brief Realiza una búsqueda binaria paralelizada en un arreglo de clientes.
+ * @brief Realiza una búsqueda binaria en un arreglo de clientes.
  * @param clientes Arreglo de clientes ordenados.
  * @param numClientes Número total de clientes en el arreglo.
  * @param idBuscado ID del cliente a buscar.
@@ -5,10 +5,15 @@
 
 #include "hash_alimentos.h"
 #include "hash_menus.h"
+#include "rango_denso.h"
+#include "mensajes.h"
+#include "mutaciones.h"
+#include "tareas.h"
+#include "latencias.h"
+#include "totales_pedidos.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <omp.h>
 
 /**
  * @brief Crea una nueva tabla hash para almacenar menús.
@@ -24,6 +29,13 @@ MenuHashTable *crearTablaMenus() {
     for (int i = 0; i < MENU_TABLE_SIZE; i++) {
         tabla->buckets[i] = NULL;
     }
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    tabla->numMenus = 0;
+    iniciarBloqueNodos(&tabla->bloqueNodos, MEMORIA_MENUS, sizeof(Menu));
+    iniciarCambios(&tabla->cambios);
+    tabla->indiceIds = NULL;
+    contarReserva(MEMORIA_MENUS, sizeof(MenuHashTable));
     return tabla;
 }
 
@@ -37,6 +49,60 @@ unsigned int hashIDMenu(int idMenu) {
     return idMenu % MENU_TABLE_SIZE;
 }
 
+/**
+ * @brief Amplía el arreglo directo y mueve a él los menús de los buckets que caen en el nuevo rango.
+ *
+ * @param tabla Puntero a la tabla hash.
+ * @param capacidad Nueva capacidad del arreglo directo.
+ * @return `true` si se amplió correctamente, `false` si no hubo memoria.
+ */
+static bool ampliarRangoDirecto(MenuHashTable *tabla, int capacidad) {
+    Menu **directo = (Menu **)realloc(tabla->directo, capacidad * sizeof(Menu *));
+    if (!directo) {
+        return false;
+    }
+    for (int i = tabla->capacidadDirecta; i < capacidad; i++) {
+        directo[i] = NULL;
+    }
+    contarReserva(MEMORIA_MENUS, (size_t)(capacidad - tabla->capacidadDirecta) * sizeof(Menu *));
+    tabla->directo = directo;
+    tabla->capacidadDirecta = capacidad;
+
+    for (int i = 0; i < MENU_TABLE_SIZE; i++) {
+        Menu **enlace = &tabla->buckets[i];
+        while (*enlace) {
+            Menu *actual = *enlace;
+            if (actual->idMenu >= 0 && actual->idMenu < capacidad) {
+                *enlace = actual->next;
+                actual->next = NULL;
+                directo[actual->idMenu] = actual;
+            } else {
+                enlace = &actual->next;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ *
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return `true` si el rango quedó reservado, `false` en caso contrario.
+ */
+bool reservarRangoDensoMenus(MenuHashTable *tabla, int idMaximo) {
+    if (idMaximo < 0 || idMaximo >= RANGO_DENSO_MAXIMO) {
+        return false;
+    }
+    if (idMaximo < tabla->capacidadDirecta) {
+        return true;
+    }
+    int capacidad = tabla->capacidadDirecta > 0 ? tabla->capacidadDirecta : RANGO_DENSO_MINIMO;
+    while (capacidad <= idMaximo) capacidad *= 2;
+    return ampliarRangoDirecto(tabla, capacidad);
+}
+
 /**
  * @brief Copia los menús desde la tabla hash a un arreglo.
  *
@@ -44,7 +110,13 @@ unsigned int hashIDMenu(int idMenu) {
  * @param menus Arreglo donde se almacenarán los menús copiados.
  */
 void copiarMenusDesdeTabla(MenuHashTable *tabla, Menu menus[]) {
+    MEDIR_LATENCIA(LATENCIA_COPIAR_MENUS);
     int index = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) { // Recorrido secuencial del rango denso
+        if (tabla->directo[i]) {
+            menus[index++] = *tabla->directo[i];
+        }
+    }
     for (int i = 0; i < MENU_TABLE_SIZE; i++) {
         Menu *actual = tabla->buckets[i];
         while (actual) {
@@ -54,6 +126,35 @@ void copiarMenusDesdeTabla(MenuHashTable *tabla, Menu menus[]) {
     }
 }
 
+/**
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior.
+ *
+ * La primera llamada copia los IDs (el rango directo ya sale ordenado; los de los
+ * buckets los ordena crearIndiceBusqueda) y construye el índice; las siguientes lo
+ * reutilizan hasta que un alta, una actualización o una baja lo invalida.
+ *
+ * @param tabla Puntero a la tabla hash de menús.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsMenus(MenuHashTable *tabla) {
+    if (tabla->indiceIds) return tabla->indiceIds;
+    int *ids = (int *)malloc(((size_t)tabla->numMenus + 1) * sizeof(int));
+    if (!ids) {
+        printf("\nError: No se pudo crear el índice de búsqueda.\n");
+        return NULL;
+    }
+    int numIds = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) ids[numIds++] = i;
+    }
+    for (int i = 0; i < MENU_TABLE_SIZE; i++) {
+        for (Menu *actual = tabla->buckets[i]; actual; actual = actual->next) ids[numIds++] = actual->idMenu;
+    }
+    tabla->indiceIds = crearIndiceBusqueda(ids, numIds);
+    free(ids);
+    return tabla->indiceIds;
+}
+
 /**
  * @brief Cuenta el número de menús almacenados en la tabla hash.
  *
@@ -61,15 +162,19 @@ void copiarMenusDesdeTabla(MenuHashTable *tabla, Menu menus[]) {
  * @return Número de menús en la tabla.
  */
 int obtenerNumeroDeMenus(MenuHashTable *tabla) {
-    int contador = 0;
-    for (int i = 0; i < MENU_TABLE_SIZE; i++) {
-        Menu *actual = tabla->buckets[i];
-        while (actual) {
-            contador++;
-            actual = actual->next;
-        }
-    }
-    return contador;
+    return tabla->numMenus;
+}
+
+/**
+ * @brief Intercambia dos menús de un arreglo.
+ *
+ * @param a Primer elemento.
+ * @param b Segundo elemento.
+ */
+static void intercambiarMenus(Menu *a, Menu *b) {
+    Menu temp = *a;
+    *a = *b;
+    *b = temp;
 }
 
 /**
@@ -81,6 +186,12 @@ int obtenerNumeroDeMenus(MenuHashTable *tabla) {
  * @return Índice del pivote.
  */
 int particionMenus(Menu menus[], int low, int high) {
+    // Mediana de tres como pivote: evita el peor caso con arreglos ya ordenados
+    int mid = low + (high - low) / 2;
+    if (menus[mid].idMenu < menus[low].idMenu) intercambiarMenus(&menus[mid], &menus[low]);
+    if (menus[high].idMenu < menus[low].idMenu) intercambiarMenus(&menus[high], &menus[low]);
+    if (menus[mid].idMenu < menus[high].idMenu) intercambiarMenus(&menus[mid], &menus[high]);
+
     int pivot = menus[high].idMenu;
     int i = low - 1;
 
@@ -100,30 +211,64 @@ int particionMenus(Menu menus[], int low, int high) {
     return i + 1;
 }
 
+static void ordenarMenus(Menu menus[], int low, int high);
+
 /**
- * @brief Ordena un arreglo de menús usando QuickSort paralelizado.
- *
+ * @brief Rango de un arreglo de menus que ordena una tarea.
+ */
+typedef struct {
+    Menu *menus;
+    int low;
+    int high;
+} RangoMenus;
+
+/**
+ * @brief Tarea que ordena un rango con ordenarMenus.
+ * @param argumento Puntero a un RangoMenus.
+ */
+static void ordenarRangoMenus(void *argumento) {
+    RangoMenus *rango = (RangoMenus *)argumento;
+    ordenarMenus(rango->menus, rango->low, rango->high);
+}
+
+/**
+ * @brief Ordena el rango [low, high] con QuickSort; las mitades grandes se reparten en tareas.
  * @param menus Arreglo de menús.
- * @param low Índice inicial.
- * @param high Índice final.
+ * @param low Índice inferior del rango.
+ * @param high Índice superior del rango.
  */
-void quicksortMenusParallel(Menu menus[], int low, int high) {
+static void ordenarMenus(Menu menus[], int low, int high) {
     if (low < high) {
         int pi = particionMenus(menus, low, high);
-
-        #pragma omp parallel sections
-        {
-            #pragma omp section
-            quicksortMenusParallel(menus, low, pi - 1);
-
-            #pragma omp section
-            quicksortMenusParallel(menus, pi + 1, high);
+        if (high - low < TAREAS_UMBRAL_ORDENAMIENTO) { // Un rango chico no compensa una tarea
+            ordenarMenus(menus, low, pi - 1);
+            ordenarMenus(menus, pi + 1, high);
+            return;
         }
+
+        // La mitad izquierda queda disponible para otro hilo mientras este ordena la derecha
+        RangoMenus izquierda = { menus, low, pi - 1 };
+        Tarea tarea;
+        lanzarTarea(&tarea, ordenarRangoMenus, &izquierda);
+        ordenarMenus(menus, pi + 1, high);
+        esperarTarea(&tarea);
     }
 }
 
 /**
- * @brief Busca un menú en un arreglo utilizando Búsqueda Binaria paralelizada.
+ * @brief Ordena un arreglo de menús en paralelo utilizando QuickSort con el pool de tareas.
+ *
+ * @param menus Arreglo de menús.
+ * @param low Índice inicial.
+ * @param high Índice final.
+ */
+void quicksortMenusParallel(Menu menus[], int low, int high) {
+    MEDIR_LATENCIA(LATENCIA_ORDENAR_MENUS);
+    ordenarMenus(menus, low, high);
+}
+
+/**
+ * @brief Busca un menú en un arreglo utilizando búsqueda binaria.
  *
  * @param menus Arreglo de menús ordenado.
  * @param numMenus Número de menús en el arreglo.
@@ -131,29 +276,46 @@ void quicksortMenusParallel(Menu menus[], int low, int high) {
  * @return Índice del menú encontrado, o -1 si no se encuentra.
  */
 int busquedaBinariaMenusParallel(Menu menus[], int numMenus, int idBuscado) {
-    int resultado = -1;
-
-    #pragma omp parallel
-    {
-        int low = 0, high = numMenus - 1;
-        while (low <= high) {
-            int mid = low + (high - low) / 2;
-
-            if (menus[mid].idMenu == idBuscado) {
-                #pragma omp critical
-                {
-                    resultado = mid;
-                }
-                break;
-            } else if (menus[mid].idMenu < idBuscado) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
+    MEDIR_LATENCIA(LATENCIA_BUSQUEDA_BINARIA_MENUS);
+    // Una sola búsqueda es O(log n): abrir hilos para ella cuesta más que hacerla
+    int low = 0, high = numMenus - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (menus[mid].idMenu == idBuscado) {
+            return mid;
+        } else if (menus[mid].idMenu < idBuscado) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
         }
     }
+    return -1;
+}
 
-    return resultado;
+/**
+ * @brief Enlaza un nodo nuevo en el arreglo directo o en su bucket y actualiza el contador.
+ *
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param nuevo Nodo ya inicializado; no se verifica si su ID existe.
+ */
+static void enlazarMenu(MenuHashTable *tabla, Menu *nuevo) {
+    int id = nuevo->idMenu;
+    int capacidad = capacidadDensaPara(id, tabla->capacidadDirecta, tabla->numMenus);
+    if (capacidad > tabla->capacidadDirecta) {
+        ampliarRangoDirecto(tabla, capacidad); // Si falla, el registro va a la tabla hash
+    }
+    if (id >= 0 && id < tabla->capacidadDirecta) {
+        nuevo->next = NULL;
+        tabla->directo[id] = nuevo;
+    } else {
+        unsigned int index = hashIDMenu(id);
+        nuevo->next = tabla->buckets[index];
+        tabla->buckets[index] = nuevo;
+    }
+    tabla->numMenus++;
+    adoptarNodo(&tabla->bloqueNodos, nuevo);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    invalidarTotalesMenu(tabla, id); // Los pedidos que lo usaban contaban 0
 }
 
 /**
@@ -161,42 +323,63 @@ int busquedaBinariaMenusParallel(Menu menus[], int numMenus, int idBuscado) {
  *
  * @param tabla Puntero a la tabla hash de menús.
  * @param idMenu ID del nuevo menú.
- * @param fecha Fecha del menú en formato "YYYY-MM-DD".
+ * @param fecha Fecha del menú.
  * @param alimentos Arreglo de IDs de alimentos.
  * @param numAlimentos Número de alimentos.
  * @param tablaAlimentos Puntero a la tabla hash de alimentos para validación.
  * @return `true` si el menú fue agregado, `false` en caso de error.
  */
-bool agregarMenu(MenuHashTable *tabla, int idMenu, const char *fecha, int *alimentos, int numAlimentos, HashTable *tablaAlimentos) {
+bool agregarMenu(MenuHashTable *tabla, int idMenu, Fecha fecha, int *alimentos, int numAlimentos, HashTable *tablaAlimentos) {
+    MEDIR_LATENCIA(LATENCIA_AGREGAR_MENU);
     if (buscarMenuPorID(tabla, idMenu)) {
-        printf("\nError: El menú con ID=%d ya existe.\n", idMenu);
+        MENSAJE("\nError: El menú con ID=%d ya existe.\n", idMenu);
         return false;
     }
 
     for (int i = 0; i < numAlimentos; i++) {
         Alimento *alimento = buscarAlimento(tablaAlimentos, alimentos[i]);
         if (!alimento || alimento->disponible == 0) {
-            printf("\nError: Alimento inválido o no disponible. ID=%d\n", alimentos[i]);
+            MENSAJE("\nError: Alimento inválido o no disponible. ID=%d\n", alimentos[i]);
             return false;
         }
     }
 
-    unsigned int index = hashIDMenu(idMenu);
-
     Menu *nuevo = (Menu *)malloc(sizeof(Menu));
     if (!nuevo) {
-        printf("\nError: No se pudo agregar el menú.\n");
+        MENSAJE("\nError: No se pudo agregar el menú.\n");
         return false;
     }
 
     nuevo->idMenu = idMenu;
-    strcpy(nuevo->fecha, fecha);
+    nuevo->fecha = fecha;
     memcpy(nuevo->alimentos, alimentos, numAlimentos * sizeof(int));
     nuevo->numAlimentos = numAlimentos;
-    nuevo->next = tabla->buckets[index];
-    tabla->buckets[index] = nuevo;
 
-    printf("\nMenú agregado: ID=%d, Fecha=%s, Número de Alimentos=%d\n", idMenu, fecha, numAlimentos);
+    enlazarMenu(tabla, nuevo);
+    marcarCambio(&tabla->cambios, idMenu, CAMBIO_SUCIO);
+    notificarMutacion(MUTACION_MENU_PONER, nuevo, idMenu);
+
+    char textoFecha[FECHA_TEXTO];
+    MENSAJE("\nMenú agregado: ID=%d, Fecha=%s, Número de Alimentos=%d\n", idMenu, formatearFecha(fecha, textoFecha), numAlimentos);
+    return true;
+}
+
+/**
+ * @brief Inserta un menú ya construido sin validar sus referencias ni imprimir mensajes.
+ *
+ * Se usa al restaurar datos que ya se validaron cuando se guardaron (por ejemplo, un
+ * snapshot binario). La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`.
+ *
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param menu Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un menú con ese ID (el nodo no se libera).
+ */
+bool restaurarMenu(MenuHashTable *tabla, Menu *menu) {
+    MEDIR_LATENCIA(LATENCIA_RESTAURAR_MENU);
+    if (buscarMenuPorID(tabla, menu->idMenu)) {
+        return false;
+    }
+    enlazarMenu(tabla, menu);
     return true;
 }
 
@@ -208,6 +391,11 @@ bool agregarMenu(MenuHashTable *tabla, int idMenu, const char *fecha, int *alime
  * @return Puntero al menú encontrado, o `NULL` si no existe.
  */
 Menu *buscarMenuPorID(MenuHashTable *tabla, int idMenu) {
+    MEDIR_LATENCIA(LATENCIA_BUSCAR_MENU);
+    if (idMenu >= 0 && idMenu < tabla->capacidadDirecta) {
+        return tabla->directo[idMenu];
+    }
+
     unsigned int index = hashIDMenu(idMenu);
     Menu *actual = tabla->buckets[index];
 
@@ -221,13 +409,28 @@ Menu *buscarMenuPorID(MenuHashTable *tabla, int idMenu) {
 }
 
 /**
- * @brief Elimina un menú de la tabla hash por su ID.
+ * @brief Quita un menú de la tabla sin imprimir mensajes ni notificar el cambio.
  *
- * @param tabla Puntero a la tabla hash de menús.
- * @param idMenu ID del menú a eliminar.
- * @return `true` si el menú fue eliminado, `false` si no se encuentra.
+ * Se usa al reproducir la bitácora (ver bitacora.h).
+ *
+ * @param tabla Puntero a la tabla hash.
+ * @param idMenu ID del menú a quitar.
+ * @return `true` si se quitó, `false` si no existía.
  */
-bool eliminarMenu(MenuHashTable *tabla, int idMenu) {
+bool retirarMenu(MenuHashTable *tabla, int idMenu) {
+    MEDIR_LATENCIA(LATENCIA_RETIRAR_MENU);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    invalidarTotalesMenu(tabla, idMenu);
+    if (idMenu >= 0 && idMenu < tabla->capacidadDirecta) {
+        if (tabla->directo[idMenu]) {
+            liberarNodo(&tabla->bloqueNodos, tabla->directo[idMenu]);
+            tabla->directo[idMenu] = NULL;
+            tabla->numMenus--;
+            return true;
+        }
+        return false;
+    }
+
     unsigned int index = hashIDMenu(idMenu);
     Menu *actual = tabla->buckets[index];
     Menu *previo = NULL;
@@ -239,17 +442,35 @@ bool eliminarMenu(MenuHashTable *tabla, int idMenu) {
             } else {
                 tabla->buckets[index] = actual->next;
             }
-            free(actual);
-            printf("\nMenú eliminado: ID=%d\n", idMenu);
+            liberarNodo(&tabla->bloqueNodos, actual);
+            tabla->numMenus--;
             return true;
         }
         previo = actual;
         actual = actual->next;
     }
-    printf("\nError: Menú con ID=%d no encontrado.\n", idMenu);
     return false;
 }
 
+/**
+ * @brief Elimina un menú de la tabla hash por su ID.
+ *
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param idMenu ID del menú a eliminar.
+ * @return `true` si el menú fue eliminado, `false` si no se encuentra.
+ */
+bool eliminarMenu(MenuHashTable *tabla, int idMenu) {
+    MEDIR_LATENCIA(LATENCIA_ELIMINAR_MENU);
+    if (!retirarMenu(tabla, idMenu)) {
+        MENSAJE("\nError: Menú con ID=%d no encontrado.\n", idMenu);
+        return false;
+    }
+    marcarCambio(&tabla->cambios, idMenu, CAMBIO_ELIMINADO);
+    notificarMutacion(MUTACION_MENU_QUITAR, NULL, idMenu);
+    MENSAJE("\nMenú eliminado: ID=%d\n", idMenu);
+    return true;
+}
+
 /**
  * @brief Actualiza la información de un menú en la tabla hash.
  *
@@ -260,20 +481,54 @@ bool eliminarMenu(MenuHashTable *tabla, int idMenu) {
  * @param numAlimentos Número de alimentos en el menú actualizado.
  * @return `true` si el menú fue actualizado correctamente, `false` si no se encuentra.
  */
-bool actualizarMenu(MenuHashTable *tabla, int idMenu, const char *nuevaFecha, int *nuevosAlimentos, int numAlimentos) {
+bool actualizarMenu(MenuHashTable *tabla, int idMenu, Fecha nuevaFecha, int *nuevosAlimentos, int numAlimentos) {
+    MEDIR_LATENCIA(LATENCIA_ACTUALIZAR_MENU);
     Menu *menu = buscarMenuPorID(tabla, idMenu);
     if (!menu) {
-        printf("\nError: Menú con ID=%d no encontrado.\n", idMenu);
+        MENSAJE("\nError: Menú con ID=%d no encontrado.\n", idMenu);
         return false;
     }
 
-    strcpy(menu->fecha, nuevaFecha);
+    if (numAlimentos != menu->numAlimentos || memcmp(menu->alimentos, nuevosAlimentos, numAlimentos * sizeof(int)) != 0) {
+        invalidarTotalesMenu(tabla, idMenu);
+    }
+    menu->fecha = nuevaFecha;
     memcpy(menu->alimentos, nuevosAlimentos, numAlimentos * sizeof(int));
     menu->numAlimentos = numAlimentos;
-    printf("\nMenú actualizado: ID=%d, Fecha=%s, Número de Alimentos=%d\n", idMenu, menu->fecha, menu->numAlimentos);
+    marcarCambio(&tabla->cambios, idMenu, CAMBIO_SUCIO);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    notificarMutacion(MUTACION_MENU_PONER, menu, idMenu);
+    char textoFecha[FECHA_TEXTO];
+    MENSAJE("\nMenú actualizado: ID=%d, Fecha=%s, Número de Alimentos=%d\n", idMenu, formatearFecha(menu->fecha, textoFecha),
+            menu->numAlimentos);
     return true;
 }
 
+/**
+ * @brief Muestra un menú junto con sus alimentos asociados.
+ *
+ * @param actual Menú a mostrar.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos para mostrar detalles.
+ */
+static void mostrarMenu(Menu *actual, HashTable *tablaAlimentos) {
+    char textoFecha[FECHA_TEXTO];
+    printf("  Menú ID=%d, Fecha=%s, Número de Alimentos=%d\n",
+           actual->idMenu, formatearFecha(actual->fecha, textoFecha), actual->numAlimentos);
+
+    // Mostrar los alimentos asociados al menú
+    printf("  Alimentos en el Menú:\n");
+    for (int j = 0; j < actual->numAlimentos; j++) {
+        Alimento *alimento = buscarAlimento(tablaAlimentos, actual->alimentos[j]);
+        if (alimento) {
+            printf("    - ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s\n",
+                   alimento->id, textoCadena(alimento->nombre), alimento->precio,
+                   alimento->disponible ? "Sí" : "No");
+        } else {
+            printf("    - Alimento con ID=%d no encontrado.\n", actual->alimentos[j]);
+        }
+    }
+}
+
 /**
  * @brief Muestra todos los menús en la tabla hash junto con sus alimentos asociados.
  *
@@ -282,27 +537,20 @@ bool actualizarMenu(MenuHashTable *tabla, int idMenu, const char *nuevaFecha, in
  */
 void mostrarTablaMenus(MenuHashTable *tablaMenus, HashTable *tablaAlimentos) {
     printf("\n--- Tabla Hash de Menús ---\n");
+    if (tablaMenus->capacidadDirecta > 0) {
+        printf("Rango directo (IDs 0-%d):\n", tablaMenus->capacidadDirecta - 1);
+        for (int i = 0; i < tablaMenus->capacidadDirecta; i++) {
+            if (tablaMenus->directo[i]) {
+                mostrarMenu(tablaMenus->directo[i], tablaAlimentos);
+            }
+        }
+    }
     for (int i = 0; i < MENU_TABLE_SIZE; i++) {
         if (tablaMenus->buckets[i] != NULL) { // Solo mostrar buckets no vacíos
             printf("Bucket %d:\n", i);
             Menu *actual = tablaMenus->buckets[i];
             while (actual) {
-                printf("  Menú ID=%d, Fecha=%s, Número de Alimentos=%d\n",
-                       actual->idMenu, actual->fecha, actual->numAlimentos);
-
-                // Mostrar los alimentos asociados al menú
-                printf("  Alimentos en el Menú:\n");
-                for (int j = 0; j < actual->numAlimentos; j++) {
-                    Alimento *alimento = buscarAlimento(tablaAlimentos, actual->alimentos[j]);
-                    if (alimento) {
-                        printf("    - ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s\n",
-                               alimento->id, alimento->nombre, alimento->precio,
-                               alimento->disponible ? "Sí" : "No");
-                    } else {
-                        printf("    - Alimento con ID=%d no encontrado.\n", actual->alimentos[j]);
-                    }
-                }
-
+                mostrarMenu(actual, tablaAlimentos);
                 actual = actual->next;
             }
         }
@@ -310,18 +558,44 @@ void mostrarTablaMenus(MenuHashTable *tablaMenus, HashTable *tablaAlimentos) {
 }
 
 /**
- * @brief Libera la memoria ocupada por la tabla hash de menús.
+ * @brief Elimina todos los menús de la tabla y la deja vacía y lista para usarse.
  *
- * @param tabla Puntero a la tabla hash de menús a liberar.
+ * @param tabla Puntero a la tabla hash de menús.
  */
-void liberarTablaMenus(MenuHashTable *tabla) {
+void vaciarTablaMenus(MenuHashTable *tabla) {
+    olvidarTotalesTabla(tabla);
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        liberarNodo(&tabla->bloqueNodos, tabla->directo[i]);
+    }
+    contarLiberacion(MEMORIA_MENUS, (size_t)tabla->capacidadDirecta * sizeof(Menu *));
+    free(tabla->directo);
     for (int i = 0; i < MENU_TABLE_SIZE; i++) {
         Menu *actual = tabla->buckets[i];
         while (actual) {
             Menu *temp = actual;
             actual = actual->next;
-            free(temp);
+            liberarNodo(&tabla->bloqueNodos, temp);
         }
     }
+    liberarBloqueNodos(&tabla->bloqueNodos);
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    for (int i = 0; i < MENU_TABLE_SIZE; i++) {
+        tabla->buckets[i] = NULL;
+    }
+    tabla->numMenus = 0;
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    liberarCambios(&tabla->cambios);
+    tabla->cambios.requiereBase = true; // Lo que se cargue después no pasa por marcarCambio
+}
+
+/**
+ * @brief Libera la memoria ocupada por la tabla hash de menús.
+ *
+ * @param tabla Puntero a la tabla hash de menús a liberar.
+ */
+void liberarTablaMenus(MenuHashTable *tabla) {
+    vaciarTablaMenus(tabla);
+    contarLiberacion(MEMORIA_MENUS, sizeof(MenuHashTable));
     free(tabla);
 }
@@ -7,6 +7,10 @@
 #define HASH_MENUS_H
 
 #include <stdbool.h>
+#include "bloque_nodos.h"
+#include "cambios_pendientes.h"
+#include "indice_busqueda.h"
+#include "fechas.h"
 #include "hash_alimentos.h"
 
 /// Tamaño de la tabla hash para menús.
@@ -17,7 +21,7 @@
  */
 typedef struct Menu {
     int idMenu;             ///< ID único del menú.
-    char fecha[11];         ///< Fecha del menú (formato YYYY-MM-DD).
+    Fecha fecha;            ///< Fecha del menú (ver fechas.h).
     int alimentos[50];      ///< IDs de alimentos disponibles en el menú.
     int numAlimentos;       ///< Número total de alimentos en el menú.
     struct Menu *next;      ///< Puntero al siguiente menú (manejo de colisiones).
@@ -28,6 +32,12 @@ typedef struct Menu {
  */
 typedef struct {
     Menu *buckets[MENU_TABLE_SIZE]; ///< Arreglo de buckets que almacena listas enlazadas de menús.
+    Menu **directo; ///< Arreglo indexado por ID para el rango denso [0, capacidadDirecta) (ver rango_denso.h).
+    int capacidadDirecta; ///< Número de ranuras del arreglo directo (0 si aún no se usa).
+    int numMenus; ///< Número total de menús (arreglo directo más buckets).
+    BloqueNodos bloqueNodos; ///< Nodos reservados en un solo bloque al restaurar un snapshot (ver bloque_nodos.h).
+    CambiosPendientes cambios; ///< IDs agregados, actualizados o eliminados desde el último guardado (ver cambios_pendientes.h).
+    IndiceBusqueda *indiceIds; ///< Índice de los IDs construido en la última búsqueda por cota inferior (`NULL` si cambió la tabla; ver indiceIdsMenus).
 } MenuHashTable;
 
 /**
@@ -55,13 +65,32 @@ Menu *buscarMenuPorID(MenuHashTable *tabla, int idMenu);
  * @brief Agrega un menú a la tabla hash.
  * @param tabla Puntero a la tabla hash.
  * @param idMenu ID único del menú.
- * @param fecha Fecha del menú (formato YYYY-MM-DD).
+ * @param fecha Fecha del menú.
  * @param alimentos Arreglo de IDs de alimentos en el menú.
  * @param numAlimentos Número de alimentos en el menú.
  * @param tablaAlimentos Puntero a la tabla hash de alimentos para validar los alimentos.
  * @return `true` si el menú se agregó correctamente, `false` si ocurrió un error o si el ID ya existe.
  */
-bool agregarMenu(MenuHashTable *tabla, int idMenu, const char *fecha, int *alimentos, int numAlimentos, HashTable *tablaAlimentos);
+bool agregarMenu(MenuHashTable *tabla, int idMenu, Fecha fecha, int *alimentos, int numAlimentos, HashTable *tablaAlimentos);
+
+/**
+ * @brief Inserta un menú ya construido sin validar sus referencias ni imprimir mensajes.
+ *
+ * La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`.
+ *
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param menu Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un menú con ese ID.
+ */
+bool restaurarMenu(MenuHashTable *tabla, Menu *menu);
+
+/**
+ * @brief Quita un menú de la tabla sin imprimir mensajes ni notificar el cambio (ver mutaciones.h).
+ * @param tabla Puntero a la tabla hash.
+ * @param idMenu ID del menú a quitar.
+ * @return `true` si se quitó, `false` si no existía.
+ */
+bool retirarMenu(MenuHashTable *tabla, int idMenu);
 
 /**
  * @brief Elimina un menú de la tabla hash por su ID.
@@ -80,7 +109,7 @@ bool eliminarMenu(MenuHashTable *tabla, int idMenu);
  * @param numAlimentos Número de alimentos en el menú.
  * @return `true` si el menú fue actualizado, `false` si no se encontró.
  */
-bool actualizarMenu(MenuHashTable *tabla, int idMenu, const char *nuevaFecha, int *nuevosAlimentos, int numAlimentos);
+bool actualizarMenu(MenuHashTable *tabla, int idMenu, Fecha nuevaFecha, int *nuevosAlimentos, int numAlimentos);
 
 /**
  * @brief Muestra el contenido de la tabla hash de menús.
@@ -95,6 +124,25 @@ void mostrarTablaMenus(MenuHashTable *tablaMenus, HashTable *tablaAlimentos);
  */
 void liberarTablaMenus(MenuHashTable *tabla);
 
+/**
+ * @brief Elimina todos los menús de la tabla y la deja vacía y lista para usarse.
+ * @param tabla Puntero a la tabla hash de menús.
+ */
+void vaciarTablaMenus(MenuHashTable *tabla);
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ *
+ * Sirve para configurar la tabla cuando se sabe de antemano que los IDs son
+ * consecutivos; los menús ya guardados en los buckets dentro del rango se
+ * mueven al arreglo directo.
+ *
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return `true` si el rango quedó reservado, `false` si el ID está fuera del límite o no hubo memoria.
+ */
+bool reservarRangoDensoMenus(MenuHashTable *tabla, int idMaximo);
+
 /**
  * @brief Obtiene el número de menús almacenados en la tabla hash.
  * @param tabla Puntero a la tabla hash.
@@ -110,7 +158,19 @@ int obtenerNumeroDeMenus(MenuHashTable *tabla);
 void copiarMenusDesdeTabla(MenuHashTable *tabla, Menu menus[]);
 
 /**
- * @brief Ordena un arreglo de menús en paralelo utilizando QuickSort.
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior (ver indice_busqueda.h).
+ *
+ * Se construye la primera vez que se pide y queda guardado en la tabla hasta que un
+ * alta, una actualización o una baja lo invalida; mientras tanto, cada búsqueda solo
+ * recorre el índice.
+ *
+ * @param tabla Puntero a la tabla hash de menús.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsMenus(MenuHashTable *tabla);
+
+/**
+ * @brief Ordena un arreglo de menús en paralelo utilizando QuickSort con el pool de tareas.
  * @param menus Arreglo de menús a ordenar.
  * @param low Índice inferior del rango.
  * @param high Índice superior del rango.
@@ -118,7 +178,7 @@ void copiarMenusDesdeTabla(MenuHashTable *tabla, Menu menus[]);
 void quicksortMenusParallel(Menu menus[], int low, int high);
 
 /**
- * @brief Realiza una búsqueda binaria paralelizada en un arreglo de menús.
+ * @brief Realiza una búsqueda binaria en un arreglo de menús.
  * @param menus Arreglo de menús ordenados.
  * @param numMenus Número total de menús en el arreglo.
  * @param idBuscado ID del menú a buscar.
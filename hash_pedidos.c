@@ -4,10 +4,15 @@
  */
 
 #include "hash_pedidos.h"
+#include "rango_denso.h"
+#include "mensajes.h"
+#include "mutaciones.h"
+#include "tareas.h"
+#include "latencias.h"
+#include "totales_pedidos.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <omp.h>
 
 /**
  * @brief Crea una nueva tabla hash para pedidos.
@@ -22,6 +27,13 @@ PedidosHashTable *crearTablaPedidos() {
     for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
         tabla->buckets[i] = NULL;
     }
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    tabla->numPedidos = 0;
+    iniciarBloqueNodos(&tabla->bloqueNodos, MEMORIA_PEDIDOS, sizeof(Pedido));
+    iniciarCambios(&tabla->cambios);
+    tabla->indiceIds = NULL;
+    contarReserva(MEMORIA_PEDIDOS, sizeof(PedidosHashTable));
     return tabla;
 }
 
@@ -34,13 +46,71 @@ unsigned int hashPedido(int idPedido) {
     return idPedido % PEDIDOS_TABLE_SIZE;
 }
 
+/**
+ * @brief Amplía el arreglo directo y mueve a él los pedidos de los buckets que caen en el nuevo rango.
+ * @param tabla Puntero a la tabla hash.
+ * @param capacidad Nueva capacidad del arreglo directo.
+ * @return `true` si se amplió correctamente, `false` si no hubo memoria.
+ */
+static bool ampliarRangoDirecto(PedidosHashTable *tabla, int capacidad) {
+    Pedido **directo = (Pedido **)realloc(tabla->directo, capacidad * sizeof(Pedido *));
+    if (!directo) {
+        return false;
+    }
+    for (int i = tabla->capacidadDirecta; i < capacidad; i++) {
+        directo[i] = NULL;
+    }
+    contarReserva(MEMORIA_PEDIDOS, (size_t)(capacidad - tabla->capacidadDirecta) * sizeof(Pedido *));
+    tabla->directo = directo;
+    tabla->capacidadDirecta = capacidad;
+
+    for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
+        Pedido **enlace = &tabla->buckets[i];
+        while (*enlace) {
+            Pedido *actual = *enlace;
+            if (actual->idPedido >= 0 && actual->idPedido < capacidad) {
+                *enlace = actual->next;
+                actual->next = NULL;
+                directo[actual->idPedido] = actual;
+            } else {
+                enlace = &actual->next;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return `true` si el rango quedó reservado, `false` en caso contrario.
+ */
+bool reservarRangoDensoPedidos(PedidosHashTable *tabla, int idMaximo) {
+    if (idMaximo < 0 || idMaximo >= RANGO_DENSO_MAXIMO) {
+        return false;
+    }
+    if (idMaximo < tabla->capacidadDirecta) {
+        return true;
+    }
+    int capacidad = tabla->capacidadDirecta > 0 ? tabla->capacidadDirecta : RANGO_DENSO_MINIMO;
+    while (capacidad <= idMaximo) capacidad *= 2;
+    return ampliarRangoDirecto(tabla, capacidad);
+}
+
 /**
  * @brief Copia los pedidos de la tabla hash a un arreglo.
  * @param tabla Puntero a la tabla hash de pedidos.
  * @param pedidos Arreglo donde se copiarán los pedidos.
  */
 void copiarPedidosDesdeTabla(PedidosHashTable *tabla, Pedido pedidos[]) {
+    MEDIR_LATENCIA(LATENCIA_COPIAR_PEDIDOS);
     int index = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) { // Recorrido secuencial del rango denso
+        if (tabla->directo[i]) {
+            pedidos[index++] = *tabla->directo[i];
+        }
+    }
     for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
         Pedido *actual = tabla->buckets[i];
         while (actual) {
@@ -50,21 +120,53 @@ void copiarPedidosDesdeTabla(PedidosHashTable *tabla, Pedido pedidos[]) {
     }
 }
 
+/**
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior.
+ *
+ * La primera llamada copia los IDs (el rango directo ya sale ordenado; los de los
+ * buckets los ordena crearIndiceBusqueda) y construye el índice; las siguientes lo
+ * reutilizan hasta que un alta, una actualización o una baja lo invalida.
+ *
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsPedidos(PedidosHashTable *tabla) {
+    if (tabla->indiceIds) return tabla->indiceIds;
+    int *ids = (int *)malloc(((size_t)tabla->numPedidos + 1) * sizeof(int));
+    if (!ids) {
+        printf("\nError: No se pudo crear el índice de búsqueda.\n");
+        return NULL;
+    }
+    int numIds = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) ids[numIds++] = i;
+    }
+    for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
+        for (Pedido *actual = tabla->buckets[i]; actual; actual = actual->next) ids[numIds++] = actual->idPedido;
+    }
+    tabla->indiceIds = crearIndiceBusqueda(ids, numIds);
+    free(ids);
+    return tabla->indiceIds;
+}
+
 /**
  * @brief Cuenta el número de pedidos en la tabla hash.
  * @param tabla Puntero a la tabla hash de pedidos.
  * @return Número total de pedidos en la tabla.
  */
 int obtenerNumeroDePedidos(PedidosHashTable *tabla) {
-    int contador = 0;
-    for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
-        Pedido *actual = tabla->buckets[i];
-        while (actual) {
-            contador++;
-            actual = actual->next;
-        }
-    }
-    return contador;
+    return tabla->numPedidos;
+}
+
+/**
+ * @brief Intercambia dos pedidos de un arreglo.
+ * @param a Primer elemento.
+ * @param b Segundo elemento.
+ */
+static void intercambiarPedidos(Pedido *a, Pedido *b) {
+    Pedido temp = *a;
+    *a = *b;
+    *b = temp;
 }
 
 /**
@@ -75,6 +177,12 @@ int obtenerNumeroDePedidos(PedidosHashTable *tabla) {
  * @return Índice del pivote.
  */
 int particionPedidos(Pedido pedidos[], int low, int high) {
+    // Mediana de tres como pivote: evita el peor caso con arreglos ya ordenados
+    int mid = low + (high - low) / 2;
+    if (pedidos[mid].idPedido < pedidos[low].idPedido) intercambiarPedidos(&pedidos[mid], &pedidos[low]);
+    if (pedidos[high].idPedido < pedidos[low].idPedido) intercambiarPedidos(&pedidos[high], &pedidos[low]);
+    if (pedidos[mid].idPedido < pedidos[high].idPedido) intercambiarPedidos(&pedidos[mid], &pedidos[high]);
+
     int pivot = pedidos[high].idPedido;
     int i = low - 1;
 
@@ -94,58 +202,108 @@ int particionPedidos(Pedido pedidos[], int low, int high) {
     return i + 1;
 }
 
+static void ordenarPedidos(Pedido pedidos[], int low, int high);
+
 /**
- * @brief Ordena un arreglo de pedidos en paralelo utilizando QuickSort.
- * @param pedidos Arreglo de pedidos a ordenar.
+ * @brief Rango de un arreglo de pedidos que ordena una tarea.
+ */
+typedef struct {
+    Pedido *pedidos;
+    int low;
+    int high;
+} RangoPedidos;
+
+/**
+ * @brief Tarea que ordena un rango con ordenarPedidos.
+ * @param argumento Puntero a un RangoPedidos.
+ */
+static void ordenarRangoPedidos(void *argumento) {
+    RangoPedidos *rango = (RangoPedidos *)argumento;
+    ordenarPedidos(rango->pedidos, rango->low, rango->high);
+}
+
+/**
+ * @brief Ordena el rango [low, high] con QuickSort; las mitades grandes se reparten en tareas.
+ * @param pedidos Arreglo de pedidos.
  * @param low Índice inferior del rango.
  * @param high Índice superior del rango.
  */
-void quicksortPedidosParallel(Pedido pedidos[], int low, int high) {
+static void ordenarPedidos(Pedido pedidos[], int low, int high) {
     if (low < high) {
         int pi = particionPedidos(pedidos, low, high);
-
-        #pragma omp parallel sections
-        {
-            #pragma omp section
-            quicksortPedidosParallel(pedidos, low, pi - 1);
-
-            #pragma omp section
-            quicksortPedidosParallel(pedidos, pi + 1, high);
+        if (high - low < TAREAS_UMBRAL_ORDENAMIENTO) { // Un rango chico no compensa una tarea
+            ordenarPedidos(pedidos, low, pi - 1);
+            ordenarPedidos(pedidos, pi + 1, high);
+            return;
         }
+
+        // La mitad izquierda queda disponible para otro hilo mientras este ordena la derecha
+        RangoPedidos izquierda = { pedidos, low, pi - 1 };
+        Tarea tarea;
+        lanzarTarea(&tarea, ordenarRangoPedidos, &izquierda);
+        ordenarPedidos(pedidos, pi + 1, high);
+        esperarTarea(&tarea);
     }
 }
 
 /**
- * @brief Realiza una búsqueda binaria paralelizada en un arreglo de pedidos.
+ * @brief Ordena un arreglo de pedidos en paralelo utilizando QuickSort con el pool de tareas.
+ * @param pedidos Arreglo de pedidos a ordenar.
+ * @param low Índice inferior del rango.
+ * @param high Índice superior del rango.
+ */
+void quicksortPedidosParallel(Pedido pedidos[], int low, int high) {
+    MEDIR_LATENCIA(LATENCIA_ORDENAR_PEDIDOS);
+    ordenarPedidos(pedidos, low, high);
+}
+
+/**
+ * @brief Realiza una búsqueda binaria en un arreglo de pedidos.
  * @param pedidos Arreglo de pedidos ordenados.
  * @param numPedidos Número total de pedidos en el arreglo.
  * @param idBuscado ID único del pedido a buscar.
  * @return Índice del pedido encontrado, o `-1` si no existe.
  */
 int busquedaBinariaPedidosParallel(Pedido pedidos[], int numPedidos, int idBuscado) {
-    int resultado = -1;
-
-    #pragma omp parallel
-    {
-        int low = 0, high = numPedidos - 1;
-        while (low <= high) {
-            int mid = low + (high - low) / 2;
-
-            if (pedidos[mid].idPedido == idBuscado) {
-                #pragma omp critical
-                {
-                    resultado = mid; // Actualizamos el resultado de forma segura
-                }
-                break;
-            } else if (pedidos[mid].idPedido < idBuscado) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
+    MEDIR_LATENCIA(LATENCIA_BUSQUEDA_BINARIA_PEDIDOS);
+    // Una sola búsqueda es O(log n): abrir hilos para ella cuesta más que hacerla
+    int low = 0, high = numPedidos - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (pedidos[mid].idPedido == idBuscado) {
+            return mid;
+        } else if (pedidos[mid].idPedido < idBuscado) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
         }
     }
+    return -1;
+}
 
-    return resultado;
+/**
+ * @brief Enlaza un nodo nuevo en el arreglo directo o en su bucket y actualiza el contador.
+ *
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @param nuevo Nodo ya inicializado; no se verifica si su ID existe.
+ */
+static void enlazarPedido(PedidosHashTable *tabla, Pedido *nuevo) {
+    int id = nuevo->idPedido;
+    int capacidad = capacidadDensaPara(id, tabla->capacidadDirecta, tabla->numPedidos);
+    if (capacidad > tabla->capacidadDirecta) {
+        ampliarRangoDirecto(tabla, capacidad); // Si falla, el registro va a la tabla hash
+    }
+    if (id >= 0 && id < tabla->capacidadDirecta) {
+        nuevo->next = NULL;
+        tabla->directo[id] = nuevo;
+    } else {
+        unsigned int index = hashPedido(id);
+        nuevo->next = tabla->buckets[index];
+        tabla->buckets[index] = nuevo;
+    }
+    tabla->numPedidos++;
+    adoptarNodo(&tabla->bloqueNodos, nuevo);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
 }
 
 /**
@@ -155,49 +313,71 @@ int busquedaBinariaPedidosParallel(Pedido pedidos[], int numPedidos, int idBusca
  * @param tablaClientes Puntero a la tabla hash de clientes para validar el cliente.
  * @param idPedido ID único del pedido.
  * @param idCliente ID del cliente que realizó el pedido.
- * @param fecha Fecha del pedido (formato YYYY-MM-DD).
+ * @param fecha Fecha del pedido.
  * @param menus Arreglo de IDs de los menús solicitados.
  * @param numMenus Número de menús en el pedido.
  * @param estado Estado inicial del pedido.
  * @return `true` si el pedido fue agregado exitosamente, `false` en caso de error.
  */
 bool agregarPedido(PedidosHashTable *tablaPedidos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes,
-                   int idPedido, int idCliente, const char *fecha, int *menus, int numMenus, const char *estado) {
+                   int idPedido, int idCliente, Fecha fecha, int *menus, int numMenus, const char *estado) {
+    MEDIR_LATENCIA(LATENCIA_AGREGAR_PEDIDO);
     if (buscarPedido(tablaPedidos, idPedido)) {
-        printf("\nError: El pedido con ID=%d ya existe.\n", idPedido);
+        MENSAJE("\nError: El pedido con ID=%d ya existe.\n", idPedido);
         return false;
     }
 
     if (!buscarCliente(tablaClientes, idCliente)) {
-        printf("\nError: El cliente con ID=%d no existe. Pedido no agregado.\n", idCliente);
+        MENSAJE("\nError: El cliente con ID=%d no existe. Pedido no agregado.\n", idCliente);
         return false;
     }
 
     for (int i = 0; i < numMenus; i++) {
         if (!buscarMenuPorID(tablaMenus, menus[i])) {
-            printf("\nError: El menú con ID=%d no existe. Pedido no agregado.\n", menus[i]);
+            MENSAJE("\nError: El menú con ID=%d no existe. Pedido no agregado.\n", menus[i]);
             return false;
         }
     }
 
-    unsigned int index = hashPedido(idPedido);
-
     Pedido *nuevo = (Pedido *)malloc(sizeof(Pedido));
     if (!nuevo) {
-        printf("\nError: No se pudo agregar el pedido.\n");
+        MENSAJE("\nError: No se pudo agregar el pedido.\n");
         return false;
     }
 
     nuevo->idPedido = idPedido;
     nuevo->idCliente = idCliente;
-    strcpy(nuevo->fecha, fecha);
+    nuevo->fecha = fecha;
     memcpy(nuevo->menus, menus, numMenus * sizeof(int));
     nuevo->numMenus = numMenus;
     strcpy(nuevo->estado, estado);
-    nuevo->next = tablaPedidos->buckets[index];
-    tablaPedidos->buckets[index] = nuevo;
 
-    printf("\nPedido agregado: ID=%d, Cliente=%d, Fecha=%s, Estado=%s\n", idPedido, idCliente, fecha, estado);
+    enlazarPedido(tablaPedidos, nuevo);
+    marcarCambio(&tablaPedidos->cambios, idPedido, CAMBIO_SUCIO);
+    notificarMutacion(MUTACION_PEDIDO_PONER, nuevo, idPedido);
+
+    char textoFecha[FECHA_TEXTO];
+    MENSAJE("\nPedido agregado: ID=%d, Cliente=%d, Fecha=%s, Estado=%s\n", idPedido, idCliente,
+            formatearFecha(fecha, textoFecha), estado);
+    return true;
+}
+
+/**
+ * @brief Inserta un pedido ya construido sin validar sus referencias ni imprimir mensajes.
+ *
+ * Se usa al restaurar datos que ya se validaron cuando se guardaron (por ejemplo, un
+ * snapshot binario). La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`.
+ *
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @param pedido Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un pedido con ese ID (el nodo no se libera).
+ */
+bool restaurarPedido(PedidosHashTable *tabla, Pedido *pedido) {
+    MEDIR_LATENCIA(LATENCIA_RESTAURAR_PEDIDO);
+    if (buscarPedido(tabla, pedido->idPedido)) {
+        return false;
+    }
+    enlazarPedido(tabla, pedido);
     return true;
 }
 
@@ -208,6 +388,11 @@ bool agregarPedido(PedidosHashTable *tablaPedidos, MenuHashTable *tablaMenus, Cl
  * @return Puntero al pedido encontrado, o `NULL` si no existe.
  */
 Pedido *buscarPedido(PedidosHashTable *tablaPedidos, int idPedido) {
+    MEDIR_LATENCIA(LATENCIA_BUSCAR_PEDIDO);
+    if (idPedido >= 0 && idPedido < tablaPedidos->capacidadDirecta) {
+        return tablaPedidos->directo[idPedido];
+    }
+
     unsigned int index = hashPedido(idPedido);
     Pedido *actual = tablaPedidos->buckets[index];
 
@@ -221,12 +406,28 @@ Pedido *buscarPedido(PedidosHashTable *tablaPedidos, int idPedido) {
 }
 
 /**
- * @brief Elimina un pedido de la tabla hash.
- * @param tablaPedidos Puntero a la tabla hash de pedidos.
- * @param idPedido ID único del pedido a eliminar.
- * @return `true` si el pedido fue eliminado exitosamente, `false` en caso contrario.
+ * @brief Quita un pedido de la tabla sin imprimir mensajes ni notificar el cambio.
+ *
+ * Se usa al reproducir la bitácora (ver bitacora.h).
+ *
+ * @param tablaPedidos Puntero a la tabla hash.
+ * @param idPedido ID del pedido a quitar.
+ * @return `true` si se quitó, `false` si no existía.
  */
-bool eliminarPedido(PedidosHashTable *tablaPedidos, int idPedido) {
+bool retirarPedido(PedidosHashTable *tablaPedidos, int idPedido) {
+    MEDIR_LATENCIA(LATENCIA_RETIRAR_PEDIDO);
+    invalidarIndiceBusqueda(&tablaPedidos->indiceIds);
+    invalidarTotalPedido(tablaPedidos, idPedido);
+    if (idPedido >= 0 && idPedido < tablaPedidos->capacidadDirecta) {
+        if (tablaPedidos->directo[idPedido]) {
+            liberarNodo(&tablaPedidos->bloqueNodos, tablaPedidos->directo[idPedido]);
+            tablaPedidos->directo[idPedido] = NULL;
+            tablaPedidos->numPedidos--;
+            return true;
+        }
+        return false;
+    }
+
     unsigned int index = hashPedido(idPedido);
     Pedido *actual = tablaPedidos->buckets[index];
     Pedido *previo = NULL;
@@ -238,17 +439,34 @@ bool eliminarPedido(PedidosHashTable *tablaPedidos, int idPedido) {
             } else {
                 tablaPedidos->buckets[index] = actual->next;
             }
-            free(actual);
-            printf("\nPedido eliminado: ID=%d\n", idPedido);
+            liberarNodo(&tablaPedidos->bloqueNodos, actual);
+            tablaPedidos->numPedidos--;
             return true;
         }
         previo = actual;
         actual = actual->next;
     }
-    printf("\nError: Pedido con ID=%d no encontrado.\n", idPedido);
     return false;
 }
 
+/**
+ * @brief Elimina un pedido de la tabla hash.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param idPedido ID único del pedido a eliminar.
+ * @return `true` si el pedido fue eliminado exitosamente, `false` en caso contrario.
+ */
+bool eliminarPedido(PedidosHashTable *tablaPedidos, int idPedido) {
+    MEDIR_LATENCIA(LATENCIA_ELIMINAR_PEDIDO);
+    if (!retirarPedido(tablaPedidos, idPedido)) {
+        MENSAJE("\nError: Pedido con ID=%d no encontrado.\n", idPedido);
+        return false;
+    }
+    marcarCambio(&tablaPedidos->cambios, idPedido, CAMBIO_ELIMINADO);
+    notificarMutacion(MUTACION_PEDIDO_QUITAR, NULL, idPedido);
+    MENSAJE("\nPedido eliminado: ID=%d\n", idPedido);
+    return true;
+}
+
 /**
  * @brief Actualiza el estado de un pedido.
  * @param tabla Puntero a la tabla hash de pedidos.
@@ -257,14 +475,18 @@ bool eliminarPedido(PedidosHashTable *tablaPedidos, int idPedido) {
  * @return `true` si el pedido fue actualizado exitosamente, `false` en caso contrario.
  */
 bool actualizarPedido(PedidosHashTable *tabla, int idPedido, const char *nuevoEstado) {
+    MEDIR_LATENCIA(LATENCIA_ACTUALIZAR_PEDIDO);
     Pedido *pedido = buscarPedido(tabla, idPedido);
     if (!pedido) {
-        printf("\nError: Pedido con ID=%d no encontrado.\n", idPedido);
+        MENSAJE("\nError: Pedido con ID=%d no encontrado.\n", idPedido);
         return false;
     }
 
     strcpy(pedido->estado, nuevoEstado);
-    printf("\nPedido actualizado: ID=%d, Nuevo Estado=%s\n", idPedido, pedido->estado);
+    marcarCambio(&tabla->cambios, idPedido, CAMBIO_SUCIO);
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    notificarMutacion(MUTACION_PEDIDO_PONER, pedido, idPedido);
+    MENSAJE("\nPedido actualizado: ID=%d, Nuevo Estado=%s\n", idPedido, pedido->estado);
     return true;
 }
 
@@ -273,14 +495,26 @@ bool actualizarPedido(PedidosHashTable *tabla, int idPedido, const char *nuevoEs
  * @param tabla Puntero a la tabla hash de pedidos.
  */
 void mostrarTablaPedidos(PedidosHashTable *tabla) {
+    char textoFecha[FECHA_TEXTO];
     printf("\n--- Tabla Hash de Pedidos ---\n");
+    if (tabla->capacidadDirecta > 0) {
+        printf("Rango directo (IDs 0-%d): ", tabla->capacidadDirecta - 1);
+        for (int i = 0; i < tabla->capacidadDirecta; i++) {
+            Pedido *actual = tabla->directo[i];
+            if (actual) {
+                printf("[ID=%d, Cliente=%d, Fecha=%s, Estado=%s] -> ",
+                       actual->idPedido, actual->idCliente, formatearFecha(actual->fecha, textoFecha), actual->estado);
+            }
+        }
+        printf("NULL\n");
+    }
     for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
         if (tabla->buckets[i] != NULL) {
             printf("Bucket %d: ", i);
             Pedido *actual = tabla->buckets[i];
             while (actual) {
                 printf("[ID=%d, Cliente=%d, Fecha=%s, Estado=%s] -> ",
-                       actual->idPedido, actual->idCliente, actual->fecha, actual->estado);
+                       actual->idPedido, actual->idCliente, formatearFecha(actual->fecha, textoFecha), actual->estado);
                 actual = actual->next;
             }
             printf("NULL\n");
@@ -289,17 +523,43 @@ void mostrarTablaPedidos(PedidosHashTable *tabla) {
 }
 
 /**
- * @brief Libera la memoria utilizada por la tabla hash de pedidos.
- * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @brief Elimina todos los pedidos de la tabla y la deja vacía y lista para usarse.
+ *
+ * @param tabla Puntero a la tabla hash de pedidos.
  */
-void liberarTablaPedidos(PedidosHashTable *tablaPedidos) {
+void vaciarTablaPedidos(PedidosHashTable *tabla) {
+    olvidarTotalesTabla(tabla);
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        liberarNodo(&tabla->bloqueNodos, tabla->directo[i]);
+    }
+    contarLiberacion(MEMORIA_PEDIDOS, (size_t)tabla->capacidadDirecta * sizeof(Pedido *));
+    free(tabla->directo);
     for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
-        Pedido *actual = tablaPedidos->buckets[i];
+        Pedido *actual = tabla->buckets[i];
         while (actual) {
             Pedido *temp = actual;
             actual = actual->next;
-            free(temp);
+            liberarNodo(&tabla->bloqueNodos, temp);
         }
     }
+    liberarBloqueNodos(&tabla->bloqueNodos);
+    tabla->directo = NULL;
+    tabla->capacidadDirecta = 0;
+    for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
+        tabla->buckets[i] = NULL;
+    }
+    tabla->numPedidos = 0;
+    invalidarIndiceBusqueda(&tabla->indiceIds);
+    liberarCambios(&tabla->cambios);
+    tabla->cambios.requiereBase = true; // Lo que se cargue después no pasa por marcarCambio
+}
+
+/**
+ * @brief Libera la memoria utilizada por la tabla hash de pedidos.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ */
+void liberarTablaPedidos(PedidosHashTable *tablaPedidos) {
+    vaciarTablaPedidos(tablaPedidos);
+    contarLiberacion(MEMORIA_PEDIDOS, sizeof(PedidosHashTable));
     free(tablaPedidos);
 }
@@ -7,6 +7,10 @@
 #define HASH_PEDIDOS_H
 
 #include <stdbool.h>
+#include "bloque_nodos.h"
+#include "cambios_pendientes.h"
+#include "indice_busqueda.h"
+#include "fechas.h"
 #include "hash_menus.h"    // Para validar menús
 #include "hash_clientes.h" // Para validar clientes
 
@@ -18,7 +22,7 @@
 typedef struct Pedido {
     int idPedido;          ///< ID único del pedido
     int idCliente;         ///< ID del cliente que realizó el pedido
-    char fecha[11];        ///< Fecha del pedido (formato YYYY-MM-DD)
+    Fecha fecha;           ///< Fecha del pedido (ver fechas.h)
     int menus[50];         ///< IDs de los menús solicitados
     int numMenus;          ///< Número de menús en el pedido
     char estado[15];       ///< Estado del pedido (Pendiente, En Proceso, Completado)
@@ -30,6 +34,12 @@ typedef struct Pedido {
  */
 typedef struct {
     Pedido *buckets[PEDIDOS_TABLE_SIZE]; ///< Arreglo de buckets para almacenar pedidos
+    Pedido **directo; ///< Arreglo indexado por ID para el rango denso [0, capacidadDirecta) (ver rango_denso.h).
+    int capacidadDirecta; ///< Número de ranuras del arreglo directo (0 si aún no se usa).
+    int numPedidos; ///< Número total de pedidos (arreglo directo más buckets).
+    BloqueNodos bloqueNodos; ///< Nodos reservados en un solo bloque al restaurar un snapshot (ver bloque_nodos.h).
+    CambiosPendientes cambios; ///< IDs agregados, actualizados o eliminados desde el último guardado (ver cambios_pendientes.h).
+    IndiceBusqueda *indiceIds; ///< Índice de los IDs construido en la última búsqueda por cota inferior (`NULL` si cambió la tabla; ver indiceIdsPedidos).
 } PedidosHashTable;
 
 /**
@@ -53,14 +63,25 @@ unsigned int hashPedido(int idPedido);
  * @param tablaClientes Puntero a la tabla hash de clientes para validar el cliente.
  * @param idPedido ID único del pedido.
  * @param idCliente ID del cliente que realizó el pedido.
- * @param fecha Fecha del pedido (formato YYYY-MM-DD).
+ * @param fecha Fecha del pedido.
  * @param menus Arreglo de IDs de los menús solicitados.
  * @param numMenus Número de menús en el pedido.
  * @param estado Estado inicial del pedido.
  * @return `true` si el pedido fue agregado exitosamente, `false` en caso de error.
  */
 bool agregarPedido(PedidosHashTable *tablaPedidos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes,
-                   int idPedido, int idCliente, const char *fecha, int *menus, int numMenus, const char *estado);
+                   int idPedido, int idCliente, Fecha fecha, int *menus, int numMenus, const char *estado);
+
+/**
+ * @brief Inserta un pedido ya construido sin validar sus referencias ni imprimir mensajes.
+ *
+ * La tabla toma posesión del nodo, que debe reservarse con `malloc` o tomarse de `bloqueNodos`.
+ *
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @param pedido Nodo a insertar.
+ * @return `true` si se insertó, `false` si ya existía un pedido con ese ID.
+ */
+bool restaurarPedido(PedidosHashTable *tabla, Pedido *pedido);
 
 /**
  * @brief Busca un pedido por su ID.
@@ -70,6 +91,14 @@ bool agregarPedido(PedidosHashTable *tablaPedidos, MenuHashTable *tablaMenus, Cl
  */
 Pedido *buscarPedido(PedidosHashTable *tablaPedidos, int idPedido);
 
+/**
+ * @brief Quita un pedido de la tabla sin imprimir mensajes ni notificar el cambio (ver mutaciones.h).
+ * @param tablaPedidos Puntero a la tabla hash.
+ * @param idPedido ID del pedido a quitar.
+ * @return `true` si se quitó, `false` si no existía.
+ */
+bool retirarPedido(PedidosHashTable *tablaPedidos, int idPedido);
+
 /**
  * @brief Elimina un pedido de la tabla hash.
  * @param tablaPedidos Puntero a la tabla hash de pedidos.
@@ -99,6 +128,25 @@ void mostrarTablaPedidos(PedidosHashTable *tablaPedidos);
  */
 void liberarTablaPedidos(PedidosHashTable *tablaPedidos);
 
+/**
+ * @brief Elimina todos los pedidos de la tabla y la deja vacía y lista para usarse.
+ * @param tabla Puntero a la tabla hash de pedidos.
+ */
+void vaciarTablaPedidos(PedidosHashTable *tabla);
+
+/**
+ * @brief Reserva el arreglo directo para IDs densos hasta un ID máximo.
+ *
+ * Sirve para configurar la tabla cuando se sabe de antemano que los IDs son
+ * consecutivos; los pedidos ya guardados en los buckets dentro del rango se
+ * mueven al arreglo directo.
+ *
+ * @param tabla Puntero a la tabla hash.
+ * @param idMaximo Mayor ID esperado.
+ * @return `true` si el rango quedó reservado, `false` si el ID está fuera del límite o no hubo memoria.
+ */
+bool reservarRangoDensoPedidos(PedidosHashTable *tabla, int idMaximo);
+
 /**
  * @brief Obtiene el número total de pedidos en la tabla hash.
  * @param tabla Puntero a la tabla hash de pedidos.
@@ -114,7 +162,19 @@ int obtenerNumeroDePedidos(PedidosHashTable *tabla);
 void copiarPedidosDesdeTabla(PedidosHashTable *tabla, Pedido pedidos[]);
 
 /**
- * @brief Ordena un arreglo de pedidos en paralelo utilizando QuickSort.
+ * @brief Índice de los IDs de la tabla para búsquedas por cota inferior (ver indice_busqueda.h).
+ *
+ * Se construye la primera vez que se pide y queda guardado en la tabla hasta que un
+ * alta, una actualización o una baja lo invalida; mientras tanto, cada búsqueda solo
+ * recorre el índice.
+ *
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @return El índice, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *indiceIdsPedidos(PedidosHashTable *tabla);
+
+/**
+ * @brief Ordena un arreglo de pedidos en paralelo utilizando QuickSort con el pool de tareas.
  * @param pedidos Arreglo de pedidos a ordenar.
  * @param low Índice inferior del rango.
  * @param high Índice superior del rango.
@@ -122,7 +182,7 @@ void copiarPedidosDesdeTabla(PedidosHashTable *tabla, Pedido pedidos[]);
 void quicksortPedidosParallel(Pedido pedidos[], int low, int high);
 
 /**
- * @brief Realiza una búsqueda binaria paralelizada en un arreglo de pedidos.
+ * @brief Realiza una búsqueda binaria en un arreglo de pedidos.
  * @param pedidos Arreglo de pedidos ordenados.
  * @param numPedidos Número total de pedidos en el arreglo.
  * @param idBuscado ID único del pedido a buscar.
@@ -0,0 +1,726 @@
+/**
+ * @file importacion.c
+ * @brief Implementación de la importación CSV / JSON Lines con un hilo lector y el hilo que inserta.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // pthread con -std=c99
+#endif
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "importacion.h"
+#include "archivo_memoria.h"
+#include "fechas.h"
+#include "mensajes.h"
+
+/// Columnas de una línea CSV a partir de las cuales se rechaza sin revisar más.
+#define IMPORTACION_MAX_CAMPOS 8
+
+/**
+ * @brief Un campo de una línea, sin copiar: apunta al contenido del archivo en memoria.
+ */
+typedef struct {
+    const char *inicio;  ///< Primer carácter del campo (sin comillas).
+    size_t longitud;     ///< Número de caracteres.
+    char escape;         ///< `"` si tiene comillas dobladas (CSV), `\` si tiene escapes JSON, 0 si no tiene.
+    bool presente;       ///< El campo apareció en la línea con un valor distinto de `null`.
+} Campo;
+
+/**
+ * @brief Registro ya convertido, listo para insertarse.
+ *
+ * Guarda los campos de cualquiera de las tres tablas; solo se usan los del tipo importado.
+ */
+typedef struct {
+    long long linea;        ///< Línea del archivo.
+    bool valido;            ///< `false` si se rechaza con `motivo` sin intentar insertarlo.
+    MotivoRechazo motivo;   ///< Motivo del rechazo cuando `valido` es `false`.
+    int id;                 ///< ID del alimento, cliente o pedido.
+    int idCliente;          ///< Cliente del pedido.
+    float precio;           ///< Precio del alimento.
+    bool disponible;        ///< Disponibilidad del alimento.
+    int numMenus;           ///< Menús del pedido.
+    int menus[50];          ///< IDs de los menús del pedido.
+    char nombre[50];        ///< Nombre del alimento o del cliente.
+    char telefono[15];      ///< Teléfono del cliente.
+    Fecha fecha;            ///< Fecha del pedido.
+    char estado[15];        ///< Estado del pedido.
+} RegistroImportado;
+
+/**
+ * @brief Grupo de registros que pasa del hilo lector al hilo que inserta.
+ */
+typedef struct {
+    RegistroImportado *registros; ///< IMPORTACION_REGISTROS_POR_LOTE registros.
+    int numRegistros;             ///< Registros llenos.
+} Lote;
+
+/**
+ * @brief Estado compartido entre el hilo lector y el hilo que inserta.
+ *
+ * Los lotes forman un anillo: el lector llena `lotes[producidos % IMPORTACION_LOTES]`
+ * y el que inserta vacía `lotes[consumidos % IMPORTACION_LOTES]`. `candado` protege los
+ * contadores y `terminado`; cada lote lo usa un solo hilo a la vez.
+ */
+typedef struct {
+    const char *datos;             ///< Contenido del archivo.
+    const char *fin;               ///< Fin del contenido.
+    TipoImportacion tipo;          ///< Tabla destino.
+    bool json;                     ///< `true` para JSON Lines, `false` para CSV.
+    Lote lotes[IMPORTACION_LOTES]; ///< Anillo de lotes.
+    long long producidos;          ///< Lotes entregados por el lector.
+    long long consumidos;          ///< Lotes ya insertados.
+    bool terminado;                ///< El lector ya no entregará más lotes.
+    pthread_mutex_t candado;
+    pthread_cond_t hayLote;        ///< Avisa que se entregó un lote o que el lector terminó.
+    pthread_cond_t hayEspacio;     ///< Avisa que se liberó un lote.
+} Tuberia;
+
+/// Claves (y orden de columnas CSV) de cada tipo de registro.
+static const char *const clavesAlimentos[] = { "id", "nombre", "precio", "disponible" };
+static const char *const clavesClientes[] = { "id", "nombre", "telefono" };
+static const char *const clavesPedidos[] = { "id", "cliente_id", "fecha", "estado", "menus" };
+
+/// Descripción de cada motivo de rechazo, en el orden de MotivoRechazo.
+static const char *const descripcionesRechazo[NUM_MOTIVOS_RECHAZO] = {
+    "formato inválido", "campo inválido o faltante", "carácter de control en un texto", "ID duplicado",
+    "cliente inexistente", "menú inexistente", "sin memoria"
+};
+
+/**
+ * @brief Avanza sobre espacios y tabuladores.
+ * @return Primer carácter que no es espacio, o `fin`.
+ */
+static const char *saltarEspacios(const char *p, const char *fin) {
+    while (p < fin && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+/**
+ * @brief Quita los espacios al inicio y al final de un campo sin escapes.
+ */
+static void recortarCampo(Campo *campo) {
+    const char *fin = campo->inicio + campo->longitud;
+    campo->inicio = saltarEspacios(campo->inicio, fin);
+    while (fin > campo->inicio && (fin[-1] == ' ' || fin[-1] == '\t')) fin--;
+    campo->longitud = (size_t)(fin - campo->inicio);
+}
+
+/**
+ * @brief Convierte un campo a ID.
+ *
+ * Los IDs negativos no se aceptan: las funciones hash de las tablas los convierten en
+ * índices fuera de sus buckets.
+ *
+ * @param campo Campo con solo dígitos.
+ * @param valor Resultado.
+ * @return `true` si el campo es un entero no negativo que cabe en `int`.
+ */
+static bool leerEntero(const Campo *campo, int *valor) {
+    const char *p = campo->inicio, *fin = campo->inicio + campo->longitud;
+    if (p == fin) return false;
+    long long acumulado = 0;
+    for (; p < fin; p++) {
+        if (*p < '0' || *p > '9') return false;
+        acumulado = acumulado * 10 + (*p - '0');
+        if (acumulado > 2147483647LL) return false;
+    }
+    *valor = (int)acumulado;
+    return true;
+}
+
+/**
+ * @brief Convierte un campo a decimal.
+ * @return `true` si todo el campo es un número.
+ */
+static bool leerDecimal(const Campo *campo, float *valor) {
+    char texto[32];
+    if (campo->longitud == 0 || campo->longitud >= sizeof(texto)) return false;
+    memcpy(texto, campo->inicio, campo->longitud);
+    texto[campo->longitud] = '\0';
+    char *fin;
+    double leido = strtod(texto, &fin);
+    if (*fin != '\0' || leido != leido) return false; // Sobra texto o es NaN
+    *valor = (float)leido;
+    return true;
+}
+
+/**
+ * @brief Lee los cuatro dígitos hexadecimales de un escape `\uXXXX`.
+ * @return El código, o -1 si no son hexadecimales.
+ */
+static long leerHexadecimal(const char *p) {
+    long codigo = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = p[i];
+        int digito = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+                     c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (digito < 0) return -1;
+        codigo = codigo * 16 + digito;
+    }
+    return codigo;
+}
+
+/**
+ * @brief Copia un campo de texto a su destino, resolviendo sus escapes.
+ *
+ * Es la única copia que se hace del texto de un campo.
+ *
+ * @param campo Campo a copiar.
+ * @param destino Arreglo destino.
+ * @param capacidad Tamaño del destino, incluyendo el terminador.
+ * @return `true` si el texto cabe y sus escapes son válidos.
+ */
+static bool copiarTexto(const Campo *campo, char *destino, size_t capacidad) {
+    if (!campo->escape) {
+        if (campo->longitud >= capacidad) return false;
+        memcpy(destino, campo->inicio, campo->longitud);
+        destino[campo->longitud] = '\0';
+        return true;
+    }
+    const char *p = campo->inicio, *fin = campo->inicio + campo->longitud;
+    size_t usados = 0;
+    while (p < fin) {
+        unsigned char bytes[3];
+        size_t numBytes = 1;
+        if (campo->escape == '"' && *p == '"') { // "" dentro de un campo CSV entre comillas
+            bytes[0] = '"';
+            p += 2;
+        } else if (campo->escape == '\\' && *p == '\\') {
+            if (p + 1 >= fin) return false;
+            char c = p[1];
+            p += 2;
+            if (c == 'n') bytes[0] = '\n';
+            else if (c == 't') bytes[0] = '\t';
+            else if (c == 'r') bytes[0] = '\r';
+            else if (c == 'b') bytes[0] = '\b';
+            else if (c == 'f') bytes[0] = '\f';
+            else if (c == '"' || c == '\\' || c == '/') bytes[0] = (unsigned char)c;
+            else if (c == 'u') {
+                long codigo = p + 4 <= fin ? leerHexadecimal(p) : -1;
+                if (codigo < 0) return false;
+                p += 4;
+                if (codigo >= 0xD800 && codigo <= 0xDFFF) {
+                    bytes[0] = '?'; // Los pares sustitutos no caben en los campos cortos de las tablas
+                } else if (codigo < 0x80) {
+                    bytes[0] = (unsigned char)codigo;
+                } else if (codigo < 0x800) {
+                    bytes[0] = (unsigned char)(0xC0 | (codigo >> 6));
+                    bytes[1] = (unsigned char)(0x80 | (codigo & 0x3F));
+                    numBytes = 2;
+                } else {
+                    bytes[0] = (unsigned char)(0xE0 | (codigo >> 12));
+                    bytes[1] = (unsigned char)(0x80 | ((codigo >> 6) & 0x3F));
+                    bytes[2] = (unsigned char)(0x80 | (codigo & 0x3F));
+                    numBytes = 3;
+                }
+            } else {
+                return false;
+            }
+        } else {
+            bytes[0] = (unsigned char)*p++;
+        }
+        if (usados + numBytes >= capacidad) return false;
+        memcpy(destino + usados, bytes, numBytes);
+        usados += numBytes;
+    }
+    destino[usados] = '\0';
+    return true;
+}
+
+/**
+ * @brief Indica si un texto ya copiado contiene un carácter de control (menor que 0x20).
+ *
+ * Los textos se guardan en el YAML y se envían por el servidor sin escapar, así que un
+ * salto de línea o un tabulador en un nombre rompería el archivo o la respuesta.
+ */
+static bool tieneControl(const char *texto) {
+    for (; *texto; texto++) {
+        if ((unsigned char)*texto < 0x20) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Convierte una lista de IDs separados por ',' o ';'.
+ * @param campo Contenido de la lista, sin corchetes.
+ * @param ids Arreglo destino de 50 posiciones.
+ * @param numIds Número de IDs leídos.
+ * @return `true` si todos son enteros y no son más de 50.
+ */
+static bool leerListaEnteros(const Campo *campo, int *ids, int *numIds) {
+    const char *p = campo->inicio, *fin = campo->inicio + campo->longitud;
+    *numIds = 0;
+    if (saltarEspacios(p, fin) == fin) return true; // Lista vacía
+    for (;;) {
+        const char *separador = p;
+        while (separador < fin && *separador != ',' && *separador != ';') separador++;
+        Campo elemento = { p, (size_t)(separador - p), 0, true };
+        recortarCampo(&elemento);
+        if (*numIds == 50 || !leerEntero(&elemento, &ids[*numIds])) return false;
+        (*numIds)++;
+        if (separador == fin) return true;
+        p = separador + 1;
+    }
+}
+
+/**
+ * @brief Separa una línea CSV en campos sin copiarla.
+ * @param p Inicio de la línea.
+ * @param fin Fin de la línea (sin el salto de línea).
+ * @param campos Campos de salida (IMPORTACION_MAX_CAMPOS).
+ * @return Número de campos, o -1 si la línea está mal formada o tiene demasiados campos.
+ */
+static int separarCSV(const char *p, const char *fin, Campo *campos) {
+    int numCampos = 0;
+    for (;;) {
+        if (numCampos == IMPORTACION_MAX_CAMPOS) return -1;
+        Campo *campo = &campos[numCampos++];
+        campo->escape = 0;
+        campo->presente = true;
+        const char *q = saltarEspacios(p, fin);
+        if (q < fin && *q == '"') {
+            campo->inicio = ++q;
+            for (;;) {
+                if (q >= fin) return -1; // Comilla sin cerrar
+                if (*q == '"') {
+                    if (q + 1 < fin && q[1] == '"') {
+                        campo->escape = '"';
+                        q += 2;
+                        continue;
+                    }
+                    break;
+                }
+                q++;
+            }
+            campo->longitud = (size_t)(q - campo->inicio);
+            q = saltarEspacios(q + 1, fin);
+            if (q < fin && *q != ',') return -1; // Texto después de la comilla de cierre
+        } else {
+            while (q < fin && *q != ',') q++;
+            campo->inicio = p;
+            campo->longitud = (size_t)(q - p);
+            recortarCampo(campo);
+        }
+        if (q >= fin) return numCampos;
+        p = q + 1;
+    }
+}
+
+/**
+ * @brief Lee una cadena JSON sin copiarla.
+ * @param p Comilla de apertura.
+ * @param fin Fin de la línea.
+ * @param campo Contenido de la cadena (de salida).
+ * @return Carácter siguiente a la comilla de cierre, o `NULL` si la cadena no termina.
+ */
+static const char *leerCadenaJSON(const char *p, const char *fin, Campo *campo) {
+    campo->inicio = ++p;
+    campo->escape = 0;
+    while (p < fin && *p != '"') {
+        if (*p == '\\') {
+            campo->escape = '\\';
+            p++;
+        }
+        p++;
+    }
+    if (p >= fin) return NULL;
+    campo->longitud = (size_t)(p - campo->inicio);
+    return p + 1;
+}
+
+/**
+ * @brief Lee un valor JSON sin copiarlo.
+ *
+ * Las cadenas quedan sin comillas y los arreglos y objetos sin corchetes ni llaves
+ * (los que no se usan solo se saltan).
+ *
+ * @param p Primer carácter del valor.
+ * @param fin Fin de la línea.
+ * @param campo Valor (de salida).
+ * @return Carácter siguiente al valor, o `NULL` si está mal formado.
+ */
+static const char *leerValorJSON(const char *p, const char *fin, Campo *campo) {
+    campo->presente = true;
+    if (*p == '"') return leerCadenaJSON(p, fin, campo);
+    campo->escape = 0;
+    if (*p == '[' || *p == '{') {
+        campo->inicio = p + 1;
+        int profundidad = 0;
+        while (p < fin) {
+            if (*p == '"') {
+                Campo cadena;
+                p = leerCadenaJSON(p, fin, &cadena);
+                if (!p) return NULL;
+                continue;
+            }
+            if (*p == '[' || *p == '{') profundidad++;
+            if ((*p == ']' || *p == '}') && --profundidad == 0) {
+                campo->longitud = (size_t)(p - campo->inicio);
+                return p + 1;
+            }
+            p++;
+        }
+        return NULL;
+    }
+    campo->inicio = p;
+    while (p < fin && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t') p++;
+    campo->longitud = (size_t)(p - campo->inicio);
+    if (campo->longitud == 0) return NULL;
+    if (campo->longitud == 4 && memcmp(campo->inicio, "null", 4) == 0) campo->presente = false;
+    return p;
+}
+
+/**
+ * @brief Separa un objeto JSON de una línea en los campos de las claves indicadas.
+ * @param p Inicio de la línea.
+ * @param fin Fin de la línea.
+ * @param claves Claves buscadas.
+ * @param numClaves Número de claves.
+ * @param campos Un campo por clave (de salida); las claves ausentes quedan sin `presente`.
+ * @return `true` si la línea es un objeto JSON bien formado.
+ */
+static bool separarJSON(const char *p, const char *fin, const char *const *claves, int numClaves, Campo *campos) {
+    p = saltarEspacios(p, fin);
+    if (p >= fin || *p != '{') return false;
+    p = saltarEspacios(p + 1, fin);
+    if (p < fin && *p == '}') return saltarEspacios(p + 1, fin) == fin;
+    for (;;) {
+        Campo clave, valor;
+        if (p >= fin || *p != '"' || !(p = leerCadenaJSON(p, fin, &clave))) return false;
+        p = saltarEspacios(p, fin);
+        if (p >= fin || *p != ':') return false;
+        p = saltarEspacios(p + 1, fin);
+        if (p >= fin || !(p = leerValorJSON(p, fin, &valor))) return false;
+        for (int i = 0; i < numClaves; i++) {
+            if (clave.longitud == strlen(claves[i]) && memcmp(clave.inicio, claves[i], clave.longitud) == 0) {
+                campos[i] = valor;
+                break;
+            }
+        }
+        p = saltarEspacios(p, fin);
+        if (p < fin && *p == ',') {
+            p = saltarEspacios(p + 1, fin);
+            continue;
+        }
+        if (p < fin && *p == '}') return saltarEspacios(p + 1, fin) == fin;
+        return false;
+    }
+}
+
+/**
+ * @brief Convierte los campos de una línea al registro del tipo importado.
+ * @param tipo Tabla destino.
+ * @param campos Campos en el orden de las claves del tipo.
+ * @param registro Registro destino; queda inválido si algún campo falta o no se puede convertir.
+ */
+static void convertirRegistro(TipoImportacion tipo, const Campo *campos, RegistroImportado *registro) {
+    registro->valido = false;
+    registro->motivo = RECHAZO_CAMPO_INVALIDO;
+    int numClaves = tipo == IMPORTAR_ALIMENTOS ? 4 : tipo == IMPORTAR_CLIENTES ? 3 : 5;
+    for (int i = 0; i < numClaves; i++) {
+        if (!campos[i].presente) return;
+    }
+    if (!leerEntero(&campos[0], &registro->id)) return;
+
+    if (tipo == IMPORTAR_ALIMENTOS) {
+        char disponible[6];
+        if (!copiarTexto(&campos[1], registro->nombre, sizeof(registro->nombre)) ||
+            !leerDecimal(&campos[2], &registro->precio) ||
+            !copiarTexto(&campos[3], disponible, sizeof(disponible))) return;
+        if (tieneControl(registro->nombre)) {
+            registro->motivo = RECHAZO_CARACTER_CONTROL;
+            return;
+        }
+        if (strcmp(disponible, "Si") == 0 || strcmp(disponible, "true") == 0) registro->disponible = true;
+        else if (strcmp(disponible, "No") == 0 || strcmp(disponible, "false") == 0) registro->disponible = false;
+        else return;
+    } else if (tipo == IMPORTAR_CLIENTES) {
+        if (!copiarTexto(&campos[1], registro->nombre, sizeof(registro->nombre)) ||
+            !copiarTexto(&campos[2], registro->telefono, sizeof(registro->telefono))) return;
+        if (tieneControl(registro->nombre) || tieneControl(registro->telefono)) {
+            registro->motivo = RECHAZO_CARACTER_CONTROL;
+            return;
+        }
+    } else {
+        if (!leerEntero(&campos[1], &registro->idCliente) ||
+            !leerFecha(campos[2].inicio, campos[2].longitud, &registro->fecha) ||
+            !copiarTexto(&campos[3], registro->estado, sizeof(registro->estado)) ||
+            !leerListaEnteros(&campos[4], registro->menus, &registro->numMenus)) return;
+        if (tieneControl(registro->estado)) {
+            registro->motivo = RECHAZO_CARACTER_CONTROL;
+            return;
+        }
+    }
+    registro->valido = true;
+}
+
+/**
+ * @brief Espera a que haya un lote libre y lo entrega vacío al lector.
+ */
+static Lote *tomarLoteLibre(Tuberia *tuberia) {
+    pthread_mutex_lock(&tuberia->candado);
+    while (tuberia->producidos - tuberia->consumidos == IMPORTACION_LOTES) {
+        pthread_cond_wait(&tuberia->hayEspacio, &tuberia->candado);
+    }
+    Lote *lote = &tuberia->lotes[tuberia->producidos % IMPORTACION_LOTES];
+    pthread_mutex_unlock(&tuberia->candado);
+    lote->numRegistros = 0;
+    return lote;
+}
+
+/**
+ * @brief Pasa el lote que llenó el lector al hilo que inserta.
+ */
+static void entregarLote(Tuberia *tuberia) {
+    pthread_mutex_lock(&tuberia->candado);
+    tuberia->producidos++;
+    pthread_cond_signal(&tuberia->hayLote);
+    pthread_mutex_unlock(&tuberia->candado);
+}
+
+/**
+ * @brief Hilo lector: separa y convierte las líneas del archivo en lotes de registros.
+ * @param argumento La Tuberia de la importación.
+ * @return `NULL`.
+ */
+static void *hiloLector(void *argumento) {
+    Tuberia *tuberia = (Tuberia *)argumento;
+    const char *const *claves = tuberia->tipo == IMPORTAR_ALIMENTOS ? clavesAlimentos :
+                                tuberia->tipo == IMPORTAR_CLIENTES ? clavesClientes : clavesPedidos;
+    int numClaves = tuberia->tipo == IMPORTAR_ALIMENTOS ? 4 : tuberia->tipo == IMPORTAR_CLIENTES ? 3 : 5;
+    const char *p = tuberia->datos;
+    long long linea = 0;
+    bool primera = true;
+    Lote *lote = NULL;
+
+    while (p < tuberia->fin) {
+        const char *finLinea = memchr(p, '\n', (size_t)(tuberia->fin - p));
+        const char *siguiente = finLinea ? finLinea + 1 : tuberia->fin;
+        if (!finLinea) finLinea = tuberia->fin;
+        if (finLinea > p && finLinea[-1] == '\r') finLinea--;
+        linea++;
+        const char *inicio = saltarEspacios(p, finLinea);
+        p = siguiente;
+        if (inicio == finLinea) continue; // Línea vacía
+
+        Campo campos[IMPORTACION_MAX_CAMPOS];
+        memset(campos, 0, sizeof(campos));
+        bool formato;
+        if (tuberia->json) {
+            formato = separarJSON(inicio, finLinea, claves, numClaves, campos);
+        } else {
+            int numCampos = separarCSV(inicio, finLinea, campos);
+            int id;
+            if (primera && numCampos > 0 && !leerEntero(&campos[0], &id)) {
+                primera = false;
+                continue; // Encabezado
+            }
+            formato = numCampos == numClaves;
+        }
+        primera = false;
+
+        if (!lote) lote = tomarLoteLibre(tuberia);
+        RegistroImportado *registro = &lote->registros[lote->numRegistros++];
+        registro->linea = linea;
+        if (formato) {
+            convertirRegistro(tuberia->tipo, campos, registro);
+        } else {
+            registro->valido = false;
+            registro->motivo = RECHAZO_FORMATO;
+        }
+        if (lote->numRegistros == IMPORTACION_REGISTROS_POR_LOTE) {
+            entregarLote(tuberia);
+            lote = NULL;
+        }
+    }
+    if (lote) entregarLote(tuberia);
+
+    pthread_mutex_lock(&tuberia->candado);
+    tuberia->terminado = true;
+    pthread_cond_signal(&tuberia->hayLote);
+    pthread_mutex_unlock(&tuberia->candado);
+    return NULL;
+}
+
+/**
+ * @brief Inserta un registro convertido con las funciones de la tabla destino.
+ *
+ * Las referencias y los duplicados se revisan antes para saber el motivo del rechazo.
+ *
+ * @param registro Registro a insertar.
+ * @param tipo Tabla destino.
+ * @param motivo Motivo del rechazo (de salida, solo si se rechaza).
+ * @return `true` si el registro quedó insertado.
+ */
+static bool insertarRegistro(RegistroImportado *registro, TipoImportacion tipo, HashTable *tablaAlimentos,
+                             ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                             PedidosHashTable *tablaPedidos, MotivoRechazo *motivo) {
+    if (!registro->valido) {
+        *motivo = registro->motivo;
+        return false;
+    }
+    *motivo = RECHAZO_DUPLICADO;
+    if (tipo == IMPORTAR_ALIMENTOS) {
+        if (buscarAlimento(tablaAlimentos, registro->id)) return false;
+        *motivo = RECHAZO_SIN_MEMORIA;
+        return insertarAlimento(tablaAlimentos, registro->id, registro->nombre, registro->precio,
+                                registro->disponible ? "Si" : "No");
+    }
+    if (tipo == IMPORTAR_CLIENTES) {
+        if (buscarCliente(tablaClientes, registro->id)) return false;
+        *motivo = RECHAZO_SIN_MEMORIA;
+        return agregarCliente(tablaClientes, registro->id, registro->nombre, registro->telefono);
+    }
+    if (buscarPedido(tablaPedidos, registro->id)) return false;
+    *motivo = RECHAZO_CLIENTE_INEXISTENTE;
+    if (!buscarCliente(tablaClientes, registro->idCliente)) return false;
+    *motivo = RECHAZO_MENU_INEXISTENTE;
+    for (int i = 0; i < registro->numMenus; i++) {
+        if (!buscarMenuPorID(tablaMenus, registro->menus[i])) return false;
+    }
+    *motivo = RECHAZO_SIN_MEMORIA;
+    return agregarPedido(tablaPedidos, tablaMenus, tablaClientes, registro->id, registro->idCliente,
+                         registro->fecha, registro->menus, registro->numMenus, registro->estado);
+}
+
+/**
+ * @brief Decide si el archivo es JSON Lines por su extensión o por su primer carácter.
+ */
+static bool esJSONLines(const char *nombreArchivo, const char *datos, const char *fin) {
+    const char *extension = strrchr(nombreArchivo, '.');
+    if (extension && strcmp(extension, ".csv") == 0) return false;
+    if (extension && (strcmp(extension, ".jsonl") == 0 || strcmp(extension, ".ndjson") == 0 ||
+                      strcmp(extension, ".json") == 0)) return true;
+    while (datos < fin && (*datos == ' ' || *datos == '\t' || *datos == '\r' || *datos == '\n')) datos++;
+    return datos < fin && *datos == '{';
+}
+
+/**
+ * @brief Importa un archivo CSV o JSON Lines a la tabla indicada.
+ * @param nombreArchivo Nombre del archivo a importar.
+ * @param tipo Tabla destino.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús (para validar los pedidos).
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param resultado Conteos de la importación (de salida).
+ * @return `true` si se leyó el archivo completo (aunque haya rechazos), `false` si no se pudo abrir.
+ */
+bool importarArchivo(const char *nombreArchivo, TipoImportacion tipo, HashTable *tablaAlimentos,
+                     ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos,
+                     ResultadoImportacion *resultado) {
+    memset(resultado, 0, sizeof(*resultado));
+    double inicio = omp_get_wtime();
+    ArchivoEnMemoria archivo;
+    if (!abrirArchivoEnMemoria(nombreArchivo, &archivo)) {
+        printf("\nError: No se pudo abrir el archivo '%s' o está vacío.\n", nombreArchivo);
+        return false;
+    }
+
+    Tuberia tuberia;
+    memset(&tuberia, 0, sizeof(tuberia));
+    tuberia.datos = (const char *)archivo.datos;
+    tuberia.fin = tuberia.datos + archivo.tamano;
+    if (archivo.tamano >= 3 && memcmp(tuberia.datos, "\xEF\xBB\xBF", 3) == 0) tuberia.datos += 3; // BOM de UTF-8
+    tuberia.tipo = tipo;
+    tuberia.json = esJSONLines(nombreArchivo, tuberia.datos, tuberia.fin);
+    resultado->json = tuberia.json;
+
+    RegistroImportado *registros = (RegistroImportado *)malloc(
+        (size_t)IMPORTACION_LOTES * IMPORTACION_REGISTROS_POR_LOTE * sizeof(RegistroImportado));
+    if (!registros) {
+        printf("\nError: No hay memoria para importar '%s'.\n", nombreArchivo);
+        cerrarArchivoEnMemoria(&archivo);
+        return false;
+    }
+    for (int i = 0; i < IMPORTACION_LOTES; i++) {
+        tuberia.lotes[i].registros = registros + (size_t)i * IMPORTACION_REGISTROS_POR_LOTE;
+    }
+    pthread_mutex_init(&tuberia.candado, NULL);
+    pthread_cond_init(&tuberia.hayLote, NULL);
+    pthread_cond_init(&tuberia.hayEspacio, NULL);
+
+    pthread_t lector;
+    bool correcto = pthread_create(&lector, NULL, hiloLector, &tuberia) == 0;
+    if (!correcto) {
+        printf("\nError: No se pudo iniciar el hilo lector para importar '%s'.\n", nombreArchivo);
+    } else {
+        bool mensajesPrevios = mensajesActivos;
+        mensajesActivos = false; // Un mensaje por registro haría de la consola el cuello de botella
+        for (;;) {
+            pthread_mutex_lock(&tuberia.candado);
+            while (tuberia.consumidos == tuberia.producidos && !tuberia.terminado) {
+                pthread_cond_wait(&tuberia.hayLote, &tuberia.candado);
+            }
+            bool quedan = tuberia.consumidos < tuberia.producidos;
+            pthread_mutex_unlock(&tuberia.candado);
+            if (!quedan) break;
+
+            Lote *lote = &tuberia.lotes[tuberia.consumidos % IMPORTACION_LOTES];
+            for (int i = 0; i < lote->numRegistros; i++) {
+                RegistroImportado *registro = &lote->registros[i];
+                MotivoRechazo motivo;
+                resultado->registros++;
+                if (insertarRegistro(registro, tipo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, &motivo)) {
+                    resultado->importados++;
+                    continue;
+                }
+                resultado->rechazados++;
+                resultado->porMotivo[motivo]++;
+                if (resultado->numEjemplos < IMPORTACION_MAX_EJEMPLOS) {
+                    resultado->ejemplos[resultado->numEjemplos].linea = registro->linea;
+                    resultado->ejemplos[resultado->numEjemplos].motivo = motivo;
+                    resultado->numEjemplos++;
+                }
+            }
+
+            pthread_mutex_lock(&tuberia.candado);
+            tuberia.consumidos++;
+            pthread_cond_signal(&tuberia.hayEspacio);
+            pthread_mutex_unlock(&tuberia.candado);
+        }
+        mensajesActivos = mensajesPrevios;
+        pthread_join(lector, NULL);
+    }
+
+    pthread_cond_destroy(&tuberia.hayEspacio);
+    pthread_cond_destroy(&tuberia.hayLote);
+    pthread_mutex_destroy(&tuberia.candado);
+    free(registros);
+    cerrarArchivoEnMemoria(&archivo);
+    resultado->segundos = omp_get_wtime() - inicio;
+    return correcto;
+}
+
+/**
+ * @brief Imprime el resumen de una importación y sus primeros rechazos.
+ * @param nombreArchivo Nombre del archivo importado.
+ * @param resultado Resultado a imprimir.
+ */
+void imprimirResultadoImportacion(const char *nombreArchivo, const ResultadoImportacion *resultado) {
+    printf("\nImportación de '%s' (%s): %lld importados y %lld rechazados de %lld registros en %.3f s",
+           nombreArchivo, resultado->json ? "JSON Lines" : "CSV", resultado->importados, resultado->rechazados,
+           resultado->registros, resultado->segundos);
+    if (resultado->segundos > 0.0) {
+        printf(" (%.0f registros por segundo)", resultado->registros / resultado->segundos);
+    }
+    printf(".\n");
+    if (resultado->rechazados == 0) return;
+
+    for (int i = 0; i < NUM_MOTIVOS_RECHAZO; i++) {
+        if (resultado->porMotivo[i] > 0) {
+            printf("  Rechazos por %s: %lld\n", descripcionesRechazo[i], resultado->porMotivo[i]);
+        }
+    }
+    for (int i = 0; i < resultado->numEjemplos; i++) {
+        printf("  - Línea %lld: %s.\n", resultado->ejemplos[i].linea, descripcionesRechazo[resultado->ejemplos[i].motivo]);
+    }
+    if (resultado->rechazados > resultado->numEjemplos) {
+        printf("  ... y %lld más.\n", resultado->rechazados - resultado->numEjemplos);
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file importacion.h
+ * @brief Importación masiva de alimentos, clientes y pedidos desde archivos CSV o JSON Lines.
+ *
+ * Formatos (una línea por registro; las líneas vacías se ignoran):
+ *
+ *     CSV         alimentos: id,nombre,precio,disponible        (disponible: Si o No)
+ *                 clientes:  id,nombre,telefono
+ *                 pedidos:   id,cliente_id,fecha,estado,menus   (menus: IDs separados por ';')
+ *
+ *     JSON Lines  {"id": 1, "nombre": "Tacos", "precio": 35.5, "disponible": "Si"}
+ *                 {"id": 7, "nombre": "Ana", "telefono": "5512345678"}
+ *                 {"id": 9, "cliente_id": 7, "fecha": "2024-05-01", "estado": "Pendiente", "menus": [1, 2]}
+ *
+ * Las claves son las mismas que las del YAML y los IDs deben ser enteros no negativos.
+ * En CSV los campos pueden ir entre comillas dobles (con `""` para una comilla) y la
+ * primera línea se toma como encabezado si su primer campo no es un número. El formato
+ * se elige por la extensión (`.csv`, o `.jsonl`, `.ndjson` y `.json`) o, si no es
+ * ninguna de esas, por el primer carácter del archivo.
+ *
+ * El archivo se lee en memoria sin copiarlo: el tokenizador solo guarda punteros a los
+ * campos y convierte cada uno directamente a su destino. Un hilo separa y convierte
+ * lotes de registros mientras el hilo que llama inserta el lote anterior con las mismas
+ * funciones que el menú (`insertarAlimento`, `agregarCliente`, `agregarPedido`), así que
+ * la bitácora y los snapshots incrementales registran lo importado.
+ *
+ * Un registro que no se puede leer o que no se puede insertar se rechaza sin detener la
+ * importación; el resultado cuenta los rechazos por motivo y guarda las primeras líneas.
+ * Los textos con caracteres de control (por ejemplo `\n` o `\u0001` en JSON) se rechazan:
+ * el YAML y las respuestas del servidor escriben los textos sin escapar.
+ */
+
+#ifndef IMPORTACION_H
+#define IMPORTACION_H
+
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Registros que el hilo lector entrega de una vez al hilo que inserta.
+#define IMPORTACION_REGISTROS_POR_LOTE 4096
+
+/// Lotes en tránsito entre los dos hilos.
+#define IMPORTACION_LOTES 4
+
+/// Rechazos que se conservan como ejemplo en el resultado.
+#define IMPORTACION_MAX_EJEMPLOS 10
+
+/**
+ * @brief Tabla destino de la importación.
+ */
+typedef enum {
+    IMPORTAR_ALIMENTOS,
+    IMPORTAR_CLIENTES,
+    IMPORTAR_PEDIDOS
+} TipoImportacion;
+
+/**
+ * @brief Motivo por el que se rechazó un registro.
+ */
+typedef enum {
+    RECHAZO_FORMATO,             ///< La línea no es CSV o JSON válido, o no tiene las columnas esperadas.
+    RECHAZO_CAMPO_INVALIDO,      ///< Falta un campo, no es un número o una fecha AAAA-MM-DD válida, o no cabe en el registro.
+    RECHAZO_CARACTER_CONTROL,    ///< Un texto contiene un carácter de control (menor que 0x20), escapado o no.
+    RECHAZO_DUPLICADO,           ///< Ya existe un registro con ese ID.
+    RECHAZO_CLIENTE_INEXISTENTE, ///< El pedido es de un cliente que no existe.
+    RECHAZO_MENU_INEXISTENTE,    ///< El pedido incluye un menú que no existe.
+    RECHAZO_SIN_MEMORIA,         ///< No se pudo reservar el nodo.
+    NUM_MOTIVOS_RECHAZO
+} MotivoRechazo;
+
+/**
+ * @brief Un registro rechazado.
+ */
+typedef struct {
+    long long linea;        ///< Número de línea en el archivo (desde 1).
+    MotivoRechazo motivo;   ///< Motivo del rechazo.
+} RechazoImportacion;
+
+/**
+ * @brief Resultado de una importación.
+ */
+typedef struct {
+    bool json;                                       ///< `true` si el archivo se leyó como JSON Lines.
+    long long registros;                             ///< Registros leídos (sin encabezado ni líneas vacías).
+    long long importados;                            ///< Registros insertados.
+    long long rechazados;                            ///< Registros rechazados.
+    long long porMotivo[NUM_MOTIVOS_RECHAZO];        ///< Rechazos por motivo.
+    int numEjemplos;                                 ///< Ejemplos guardados.
+    RechazoImportacion ejemplos[IMPORTACION_MAX_EJEMPLOS]; ///< Primeros rechazos en orden de línea.
+    double segundos;                                 ///< Duración de la importación.
+} ResultadoImportacion;
+
+/**
+ * @brief Importa un archivo CSV o JSON Lines a la tabla indicada.
+ *
+ * Los mensajes de las tablas se silencian mientras dura la importación.
+ *
+ * @param nombreArchivo Nombre del archivo a importar.
+ * @param tipo Tabla destino.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús (para validar los pedidos).
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param resultado Conteos de la importación (de salida).
+ * @return `true` si se leyó el archivo completo (aunque haya rechazos), `false` si no se pudo abrir.
+ */
+bool importarArchivo(const char *nombreArchivo, TipoImportacion tipo, HashTable *tablaAlimentos,
+                     ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos,
+                     ResultadoImportacion *resultado);
+
+/**
+ * @brief Imprime el resumen de una importación y sus primeros rechazos.
+ * @param nombreArchivo Nombre del archivo importado.
+ * @param resultado Resultado a imprimir.
+ */
+void imprimirResultadoImportacion(const char *nombreArchivo, const ResultadoImportacion *resultado);
+
+#endif // IMPORTACION_H
@@ -0,0 +1,239 @@
+/**
+ * @file indice_busqueda.c
+ * @brief Implementación del índice de búsqueda estático en orden de B-tree implícito.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "indice_busqueda.h"
+#include "contabilidad_memoria.h"
+
+/// Relleno para las posiciones vacías del último nivel; nunca es menor que una clave buscada.
+#define CLAVE_RELLENO INT_MAX
+
+/**
+ * @brief Par (clave, posición) usado para ordenar claves que no vienen ordenadas.
+ */
+typedef struct {
+    int clave;
+    int posicion;
+} ParClave;
+
+/**
+ * @brief Compara dos pares por clave y, en empate, por posición original.
+ */
+static int compararPares(const void *a, const void *b) {
+    const ParClave *x = (const ParClave *)a;
+    const ParClave *y = (const ParClave *)b;
+    if (x->clave != y->clave) return (x->clave < y->clave) ? -1 : 1;
+    return (x->posicion < y->posicion) ? -1 : (x->posicion > y->posicion);
+}
+
+/**
+ * @brief Índice del hijo `i` (0..INDICE_CLAVES_POR_NODO) del nodo `k`.
+ */
+static long long hijoDeNodo(long long k, int i) {
+    return k * (INDICE_CLAVES_POR_NODO + 1) + i + 1;
+}
+
+/**
+ * @brief Llena recursivamente el árbol con un recorrido en orden sobre las claves ordenadas.
+ *
+ * @param indice Índice en construcción.
+ * @param pares Claves ordenadas con su posición original.
+ * @param k Nodo actual.
+ * @param siguiente Siguiente clave ordenada por colocar.
+ */
+static void construirNodo(IndiceBusqueda *indice, const ParClave *pares, long long k, int *siguiente) {
+    if (k >= indice->numNodos) return;
+
+    for (int i = 0; i < INDICE_CLAVES_POR_NODO; i++) {
+        construirNodo(indice, pares, hijoDeNodo(k, i), siguiente);
+
+        long long ranura = k * INDICE_CLAVES_POR_NODO + i;
+        if (*siguiente < indice->numClaves) {
+            indice->claves[ranura] = pares[*siguiente].clave;
+            indice->posiciones[ranura] = pares[*siguiente].posicion;
+            (*siguiente)++;
+        } else {
+            indice->claves[ranura] = CLAVE_RELLENO;
+            indice->posiciones[ranura] = -1;
+        }
+    }
+    construirNodo(indice, pares, hijoDeNodo(k, INDICE_CLAVES_POR_NODO), siguiente);
+}
+
+/**
+ * @brief Cuenta cuántas claves del nodo son estrictamente menores que `clave`.
+ *
+ * Con AVX2 o SSE2 se compara el nodo completo en 2 o 4 instrucciones y se cuenta
+ * la máscara resultante; sin SIMD se usa un ciclo sin saltos equivalente.
+ *
+ * @param nodo Primer elemento del nodo (alineado a 64 bytes).
+ * @param clave Clave buscada.
+ * @return Rango de la clave dentro del nodo (0..INDICE_CLAVES_POR_NODO).
+ */
+static inline int rangoEnNodo(const int *nodo, int clave) {
+#if defined(__AVX2__)
+    __m256i x = _mm256_set1_epi32(clave);
+    __m256i a = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i *)nodo));
+    __m256i b = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i *)(nodo + 8)));
+    unsigned int mascara = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(a))
+                         | ((unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8);
+    return __builtin_popcount(mascara);
+#elif defined(__SSE2__)
+    __m128i x = _mm_set1_epi32(clave);
+    unsigned int mascara = 0;
+    for (int i = 0; i < INDICE_CLAVES_POR_NODO; i += 4) {
+        __m128i c = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)(nodo + i)));
+        mascara |= (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(c)) << i;
+    }
+    return __builtin_popcount(mascara);
+#else
+    int rango = 0;
+    for (int i = 0; i < INDICE_CLAVES_POR_NODO; i++) {
+        rango += (nodo[i] < clave);
+    }
+    return rango;
+#endif
+}
+
+/**
+ * @brief Bytes que ocupan el índice y sus arreglos (ver contabilidad_memoria.h).
+ * @param indice Índice ya construido.
+ * @return Bytes reservados para el índice.
+ */
+static size_t bytesIndice(const IndiceBusqueda *indice) {
+    size_t ranuras = (size_t)indice->numNodos * INDICE_CLAVES_POR_NODO;
+    return sizeof(IndiceBusqueda) + ranuras * sizeof(int) + 64 + (ranuras ? ranuras : 1) * sizeof(int);
+}
+
+/**
+ * @brief Construye un índice a partir de las claves de un arreglo (snapshot).
+ * @param claves Claves en el orden del arreglo original.
+ * @param numClaves Número de claves.
+ * @return Puntero al índice creado, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *crearIndiceBusqueda(const int *claves, int numClaves) {
+    if (numClaves < 0) return NULL;
+
+    IndiceBusqueda *indice = (IndiceBusqueda *)malloc(sizeof(IndiceBusqueda));
+    if (!indice) {
+        printf("\nError: No se pudo crear el índice de búsqueda.\n");
+        return NULL;
+    }
+
+    indice->numClaves = numClaves;
+    indice->numNodos = (numClaves + INDICE_CLAVES_POR_NODO - 1) / INDICE_CLAVES_POR_NODO;
+    size_t ranuras = (size_t)indice->numNodos * INDICE_CLAVES_POR_NODO;
+
+    // Las claves se alinean a 64 bytes para que cada nodo caiga en una sola línea de caché
+    indice->bloqueClaves = malloc(ranuras * sizeof(int) + 64);
+    indice->posiciones = (int *)malloc((ranuras ? ranuras : 1) * sizeof(int));
+    ParClave *pares = (ParClave *)malloc((numClaves ? numClaves : 1) * sizeof(ParClave));
+    if (!indice->bloqueClaves || !indice->posiciones || !pares) {
+        printf("\nError: No se pudo crear el índice de búsqueda.\n");
+        free(indice->bloqueClaves);
+        free(indice->posiciones);
+        free(pares);
+        free(indice);
+        return NULL;
+    }
+    indice->claves = (int *)(((uintptr_t)indice->bloqueClaves + 63) & ~(uintptr_t)63);
+    contarReserva(MEMORIA_INDICES, bytesIndice(indice));
+    contarReserva(MEMORIA_INDICES, (numClaves ? numClaves : 1) * sizeof(ParClave));
+
+    bool ordenadas = true;
+    for (int i = 0; i < numClaves; i++) {
+        pares[i].clave = claves[i];
+        pares[i].posicion = i;
+        if (i > 0 && claves[i - 1] > claves[i]) ordenadas = false;
+    }
+    if (!ordenadas) {
+        qsort(pares, numClaves, sizeof(ParClave), compararPares);
+    }
+
+    int siguiente = 0;
+    construirNodo(indice, pares, 0, &siguiente);
+
+    free(pares);
+    contarLiberacion(MEMORIA_INDICES, (numClaves ? numClaves : 1) * sizeof(ParClave));
+    return indice;
+}
+
+/**
+ * @brief Recorre el árbol y devuelve la ranura de la menor clave >= `clave`.
+ * @param indice Puntero al índice.
+ * @param clave Clave a buscar.
+ * @return Ranura encontrada en el arreglo de claves, o `-1` si no existe.
+ */
+static long long buscarRanura(const IndiceBusqueda *indice, int clave) {
+    long long resultado = -1;
+    long long k = 0;
+
+    while (k < indice->numNodos) {
+        const int *nodo = indice->claves + k * INDICE_CLAVES_POR_NODO;
+        int i = rangoEnNodo(nodo, clave);
+        if (i < INDICE_CLAVES_POR_NODO) {
+            resultado = k * INDICE_CLAVES_POR_NODO + i;
+        }
+        k = hijoDeNodo(k, i);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Busca la primera clave mayor o igual a la indicada (lower bound).
+ * @param indice Puntero al índice.
+ * @param clave Clave a buscar.
+ * @return Posición en el arreglo original, o `-1` si no existe.
+ */
+int indiceCotaInferior(const IndiceBusqueda *indice, int clave) {
+    long long ranura = buscarRanura(indice, clave);
+    return (ranura < 0) ? -1 : indice->posiciones[ranura];
+}
+
+/**
+ * @brief Busca la primera clave mayor o igual a la indicada y devuelve esa clave.
+ * @param indice Puntero al índice.
+ * @param clave Clave a buscar.
+ * @param encontrada Menor clave >= `clave` (de salida).
+ * @return `true` si existe, `false` si todas las claves son menores.
+ */
+bool indiceSiguienteClave(const IndiceBusqueda *indice, int clave, int *encontrada) {
+    long long ranura = buscarRanura(indice, clave);
+    // Las ranuras de relleno (CLAVE_RELLENO) no corresponden a ninguna clave real
+    if (ranura < 0 || indice->posiciones[ranura] < 0) return false;
+    *encontrada = indice->claves[ranura];
+    return true;
+}
+
+/**
+ * @brief Busca una clave exacta en el índice.
+ * @param indice Puntero al índice.
+ * @param clave Clave a buscar.
+ * @return Posición en el arreglo original, o `-1` si no existe.
+ */
+int indiceBuscar(const IndiceBusqueda *indice, int clave) {
+    long long ranura = buscarRanura(indice, clave);
+    if (ranura < 0 || indice->claves[ranura] != clave) return -1;
+    return indice->posiciones[ranura];
+}
+
+/**
+ * @brief Libera la memoria ocupada por el índice.
+ * @param indice Puntero al índice a liberar.
+ */
+void liberarIndiceBusqueda(IndiceBusqueda *indice) {
+    if (!indice) return;
+    contarLiberacion(MEMORIA_INDICES, bytesIndice(indice));
+    free(indice->bloqueClaves);
+    free(indice->posiciones);
+    free(indice);
+}
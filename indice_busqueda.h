@@ -0,0 +1,89 @@
+/**
+ * @file indice_busqueda.h
+ * @brief Índice de búsqueda estático de solo lectura construido a partir de un arreglo ordenado.
+ *
+ * El índice guarda únicamente las claves (IDs) en el orden de un B-tree implícito
+ * cuyos nodos ocupan exactamente una línea de caché (16 enteros de 32 bits). Cada
+ * búsqueda visita un nodo por nivel y compara la clave contra el nodo completo con
+ * instrucciones SIMD, en lugar de saltar entre estructuras grandes como lo hace la
+ * búsqueda binaria sobre el arreglo original.
+ */
+
+#ifndef INDICE_BUSQUEDA_H
+#define INDICE_BUSQUEDA_H
+
+#include <stdbool.h>
+
+/// Número de claves por nodo (16 * 4 bytes = 64 bytes, una línea de caché).
+#define INDICE_CLAVES_POR_NODO 16
+
+/**
+ * @brief Índice estático en orden de B-tree implícito.
+ */
+typedef struct {
+    int *claves;        ///< Claves en orden de B-tree (numNodos * INDICE_CLAVES_POR_NODO), alineadas a 64 bytes.
+    int *posiciones;    ///< Posición en el arreglo original de cada clave (-1 para relleno).
+    int numNodos;       ///< Número de nodos del árbol.
+    int numClaves;      ///< Número de claves reales indexadas.
+    void *bloqueClaves; ///< Bloque reservado para las claves (sin alinear), usado al liberar.
+} IndiceBusqueda;
+
+/**
+ * @brief Construye un índice a partir de las claves de un arreglo (snapshot).
+ *
+ * Si las claves no vienen ordenadas (por ejemplo, alimentos ordenados por precio),
+ * el índice las ordena internamente y conserva la posición original de cada una.
+ *
+ * @param claves Claves en el orden del arreglo original.
+ * @param numClaves Número de claves.
+ * @return Puntero al índice creado, o `NULL` si no hubo memoria.
+ */
+IndiceBusqueda *crearIndiceBusqueda(const int *claves, int numClaves);
+
+/**
+ * @brief Busca la primera clave mayor o igual a la indicada (lower bound).
+ * @param indice Puntero al índice.
+ * @param clave Clave a buscar.
+ * @return Posición en el arreglo original del elemento con la menor clave >= `clave`, o `-1` si no existe.
+ */
+int indiceCotaInferior(const IndiceBusqueda *indice, int clave);
+
+/**
+ * @brief Busca la primera clave mayor o igual a la indicada y devuelve esa clave.
+ *
+ * Sirve cuando el arreglo original ya no existe, como en el índice que guarda cada
+ * tabla (ver `indiceIdsPedidos` y similares): con la clave se busca el registro en la tabla.
+ *
+ * @param indice Puntero al índice.
+ * @param clave Clave a buscar.
+ * @param encontrada Menor clave >= `clave` (de salida).
+ * @return `true` si existe, `false` si todas las claves son menores.
+ */
+bool indiceSiguienteClave(const IndiceBusqueda *indice, int clave, int *encontrada);
+
+/**
+ * @brief Busca una clave exacta en el índice.
+ * @param indice Puntero al índice.
+ * @param clave Clave a buscar.
+ * @return Posición en el arreglo original del elemento con esa clave, o `-1` si no existe.
+ */
+int indiceBuscar(const IndiceBusqueda *indice, int clave);
+
+/**
+ * @brief Libera la memoria ocupada por el índice.
+ * @param indice Puntero al índice a liberar.
+ */
+void liberarIndiceBusqueda(IndiceBusqueda *indice);
+
+/**
+ * @brief Libera el índice guardado en una tabla para que la siguiente búsqueda lo reconstruya.
+ * @param indice Dirección del puntero al índice; queda en `NULL`.
+ */
+static inline void invalidarIndiceBusqueda(IndiceBusqueda **indice) {
+    if (*indice) {
+        liberarIndiceBusqueda(*indice);
+        *indice = NULL;
+    }
+}
+
+#endif // INDICE_BUSQUEDA_H
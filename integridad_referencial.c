@@ -0,0 +1,191 @@
+/**
+ * @file integridad_referencial.c
+ * @brief Implementación de la verificación de referencias entre tablas.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+#include "integridad_referencial.h"
+#include "mensajes.h"
+#include "tareas.h"
+
+/**
+ * @brief Compara dos violaciones por tipo, registro y ID referido.
+ * @return Negativo, cero o positivo, como `strcmp`.
+ */
+static int compararViolaciones(const ViolacionIntegridad *a, const ViolacionIntegridad *b) {
+    if (a->tipo != b->tipo) return (int)a->tipo - (int)b->tipo;
+    if (a->idRegistro != b->idRegistro) return a->idRegistro < b->idRegistro ? -1 : 1;
+    if (a->idReferido != b->idReferido) return a->idReferido < b->idReferido ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Conserva la violación si está entre las INTEGRIDAD_MAX_EJEMPLOS menores.
+ *
+ * Los ejemplos se mantienen ordenados, así que el reporte no depende del orden en que
+ * los hilos encuentran las violaciones. Se llama con el candado de la verificación tomado.
+ *
+ * @param reporte Reporte en construcción.
+ * @param violacion Violación encontrada.
+ */
+static void anotarEjemplo(ReporteIntegridad *reporte, ViolacionIntegridad violacion) {
+    int posicion = reporte->numEjemplos;
+    while (posicion > 0 && compararViolaciones(&violacion, &reporte->ejemplos[posicion - 1]) < 0) {
+        posicion--;
+    }
+    if (posicion >= INTEGRIDAD_MAX_EJEMPLOS) return;
+    int ultimo = reporte->numEjemplos < INTEGRIDAD_MAX_EJEMPLOS ? reporte->numEjemplos : INTEGRIDAD_MAX_EJEMPLOS - 1;
+    memmove(&reporte->ejemplos[posicion + 1], &reporte->ejemplos[posicion],
+            (size_t)(ultimo - posicion) * sizeof(ViolacionIntegridad));
+    reporte->ejemplos[posicion] = violacion;
+    if (reporte->numEjemplos < INTEGRIDAD_MAX_EJEMPLOS) reporte->numEjemplos++;
+}
+
+/// Ranuras (del arreglo directo o buckets) que revisa cada tarea.
+#define RANURAS_POR_TAREA 4096
+
+/**
+ * @brief Verificación en curso: tablas, conteos acumulados y ejemplos.
+ *
+ * Cada tarea cuenta en variables locales y suma al final de su bloque, con el candado
+ * tomado una sola vez; los ejemplos se anotan con el mismo candado.
+ */
+typedef struct {
+    HashTable *tablaAlimentos;
+    ClientesHashTable *tablaClientes;
+    MenuHashTable *tablaMenus;
+    PedidosHashTable *tablaPedidos;
+    ReporteIntegridad *reporte;
+    pthread_mutex_t candado;
+} VerificacionIntegridad;
+
+/**
+ * @brief Anota un ejemplo de violación con el candado de la verificación.
+ */
+static void anotarEjemploSeguro(VerificacionIntegridad *verificacion, TipoViolacion tipo, int idRegistro, int idReferido) {
+    ViolacionIntegridad violacion = {tipo, idRegistro, idReferido};
+    pthread_mutex_lock(&verificacion->candado);
+    anotarEjemplo(verificacion->reporte, violacion);
+    pthread_mutex_unlock(&verificacion->candado);
+}
+
+/**
+ * @brief Revisa los alimentos de los menús en las ranuras `[inicio, fin)`.
+ *
+ * Cada ranura es una posición del arreglo directo o un bucket completo.
+ */
+static void revisarMenus(long long inicio, long long fin, void *contexto) {
+    VerificacionIntegridad *verificacion = (VerificacionIntegridad *)contexto;
+    MenuHashTable *tablaMenus = verificacion->tablaMenus;
+    long long revisados = 0, faltantes = 0;
+    for (long long i = inicio; i < fin; i++) {
+        bool directo = i < tablaMenus->capacidadDirecta;
+        Menu *menu = directo ? tablaMenus->directo[i] : tablaMenus->buckets[i - tablaMenus->capacidadDirecta];
+        // Los nodos del arreglo directo no se encadenan; los de un bucket sí
+        for (; menu; menu = directo ? NULL : menu->next) {
+            revisados++;
+            for (int j = 0; j < menu->numAlimentos; j++) {
+                if (buscarAlimento(verificacion->tablaAlimentos, menu->alimentos[j])) continue;
+                faltantes++;
+                anotarEjemploSeguro(verificacion, VIOLACION_MENU_ALIMENTO, menu->idMenu, menu->alimentos[j]);
+            }
+        }
+    }
+    pthread_mutex_lock(&verificacion->candado);
+    verificacion->reporte->menusRevisados += revisados;
+    verificacion->reporte->alimentosFaltantes += faltantes;
+    pthread_mutex_unlock(&verificacion->candado);
+}
+
+/**
+ * @brief Revisa el cliente y los menús de los pedidos en las ranuras `[inicio, fin)`.
+ */
+static void revisarPedidos(long long inicio, long long fin, void *contexto) {
+    VerificacionIntegridad *verificacion = (VerificacionIntegridad *)contexto;
+    PedidosHashTable *tablaPedidos = verificacion->tablaPedidos;
+    long long revisados = 0, clientesFaltantes = 0, menusFaltantes = 0;
+    for (long long i = inicio; i < fin; i++) {
+        bool directo = i < tablaPedidos->capacidadDirecta;
+        Pedido *pedido = directo ? tablaPedidos->directo[i] : tablaPedidos->buckets[i - tablaPedidos->capacidadDirecta];
+        for (; pedido; pedido = directo ? NULL : pedido->next) {
+            revisados++;
+            if (!buscarCliente(verificacion->tablaClientes, pedido->idCliente)) {
+                clientesFaltantes++;
+                anotarEjemploSeguro(verificacion, VIOLACION_PEDIDO_CLIENTE, pedido->idPedido, pedido->idCliente);
+            }
+            for (int j = 0; j < pedido->numMenus; j++) {
+                if (buscarMenuPorID(verificacion->tablaMenus, pedido->menus[j])) continue;
+                menusFaltantes++;
+                anotarEjemploSeguro(verificacion, VIOLACION_PEDIDO_MENU, pedido->idPedido, pedido->menus[j]);
+            }
+        }
+    }
+    pthread_mutex_lock(&verificacion->candado);
+    verificacion->reporte->pedidosRevisados += revisados;
+    verificacion->reporte->clientesFaltantes += clientesFaltantes;
+    verificacion->reporte->menusFaltantes += menusFaltantes;
+    pthread_mutex_unlock(&verificacion->candado);
+}
+
+/**
+ * @brief Verifica en paralelo que todas las referencias de menús y pedidos existan.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param reporte Resultado (de salida).
+ * @return `true` si no hay referencias rotas.
+ */
+bool validarIntegridad(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                       PedidosHashTable *tablaPedidos, ReporteIntegridad *reporte) {
+    memset(reporte, 0, sizeof(*reporte));
+    double inicio = omp_get_wtime();
+    VerificacionIntegridad verificacion = { tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, reporte };
+    pthread_mutex_init(&verificacion.candado, NULL);
+
+    paraCadaRango(tablaMenus->capacidadDirecta + MENU_TABLE_SIZE, RANURAS_POR_TAREA, revisarMenus, &verificacion);
+    paraCadaRango(tablaPedidos->capacidadDirecta + PEDIDOS_TABLE_SIZE, RANURAS_POR_TAREA, revisarPedidos, &verificacion);
+
+    pthread_mutex_destroy(&verificacion.candado);
+    reporte->segundos = omp_get_wtime() - inicio;
+    return reporte->alimentosFaltantes + reporte->clientesFaltantes + reporte->menusFaltantes == 0;
+}
+
+/**
+ * @brief Imprime el resumen de la verificación y los ejemplos de referencias rotas.
+ * @param reporte Reporte a imprimir.
+ */
+void imprimirReporteIntegridad(const ReporteIntegridad *reporte) {
+    long long total = reporte->alimentosFaltantes + reporte->clientesFaltantes + reporte->menusFaltantes;
+    if (total == 0) {
+        MENSAJE("\nIntegridad referencial verificada en %.3f s: %lld menús y %lld pedidos sin referencias rotas.\n",
+                reporte->segundos, reporte->menusRevisados, reporte->pedidosRevisados);
+        return;
+    }
+
+    printf("\nAdvertencia: Se encontraron %lld referencias rotas (%lld menús y %lld pedidos revisados en %.3f s):\n",
+           total, reporte->menusRevisados, reporte->pedidosRevisados, reporte->segundos);
+    printf("  Alimentos inexistentes en menús: %lld\n", reporte->alimentosFaltantes);
+    printf("  Clientes inexistentes en pedidos: %lld\n", reporte->clientesFaltantes);
+    printf("  Menús inexistentes en pedidos: %lld\n", reporte->menusFaltantes);
+    for (int i = 0; i < reporte->numEjemplos; i++) {
+        const ViolacionIntegridad *violacion = &reporte->ejemplos[i];
+        switch (violacion->tipo) {
+            case VIOLACION_MENU_ALIMENTO:
+                printf("  - Menú %d: alimento %d no existe.\n", violacion->idRegistro, violacion->idReferido);
+                break;
+            case VIOLACION_PEDIDO_CLIENTE:
+                printf("  - Pedido %d: cliente %d no existe.\n", violacion->idRegistro, violacion->idReferido);
+                break;
+            case VIOLACION_PEDIDO_MENU:
+                printf("  - Pedido %d: menú %d no existe.\n", violacion->idRegistro, violacion->idReferido);
+                break;
+        }
+    }
+    if (total > reporte->numEjemplos) {
+        printf("  ... y %lld más.\n", total - reporte->numEjemplos);
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file integridad_referencial.h
+ * @brief Verificación de las referencias entre tablas después de una carga masiva.
+ *
+ * Las cargas (YAML, snapshot binario, snapshot incremental y bitácora) insertan los
+ * registros con `restaurar*`, sin comprobar uno por uno que los alimentos de cada menú
+ * ni los clientes y menús de cada pedido existan. Esa comprobación se hace al final, en
+ * una sola pasada paralela sobre menús y pedidos.
+ */
+
+#ifndef INTEGRIDAD_REFERENCIAL_H
+#define INTEGRIDAD_REFERENCIAL_H
+
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Número de referencias rotas que se conservan como ejemplo en el reporte.
+#define INTEGRIDAD_MAX_EJEMPLOS 10
+
+/**
+ * @brief Tipo de referencia rota.
+ */
+typedef enum {
+    VIOLACION_MENU_ALIMENTO,   ///< Un menú usa un alimento que no existe.
+    VIOLACION_PEDIDO_CLIENTE,  ///< Un pedido es de un cliente que no existe.
+    VIOLACION_PEDIDO_MENU      ///< Un pedido incluye un menú que no existe.
+} TipoViolacion;
+
+/**
+ * @brief Una referencia rota.
+ */
+typedef struct {
+    TipoViolacion tipo;  ///< Tipo de referencia.
+    int idRegistro;      ///< ID del menú o pedido que tiene la referencia.
+    int idReferido;      ///< ID que no se encontró.
+} ViolacionIntegridad;
+
+/**
+ * @brief Resultado de la verificación.
+ */
+typedef struct {
+    long long menusRevisados;      ///< Menús recorridos.
+    long long pedidosRevisados;    ///< Pedidos recorridos.
+    long long alimentosFaltantes;  ///< Referencias de menús a alimentos inexistentes.
+    long long clientesFaltantes;   ///< Pedidos de clientes inexistentes.
+    long long menusFaltantes;      ///< Referencias de pedidos a menús inexistentes.
+    int numEjemplos;               ///< Ejemplos guardados (a lo más INTEGRIDAD_MAX_EJEMPLOS).
+    ViolacionIntegridad ejemplos[INTEGRIDAD_MAX_EJEMPLOS]; ///< Las referencias rotas de menor tipo e ID.
+    double segundos;               ///< Duración de la verificación.
+} ReporteIntegridad;
+
+/**
+ * @brief Verifica en paralelo que todas las referencias de menús y pedidos existan.
+ *
+ * Solo lee las tablas; no corrige ni elimina nada.
+ *
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param reporte Resultado (de salida).
+ * @return `true` si no hay referencias rotas.
+ */
+bool validarIntegridad(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                       PedidosHashTable *tablaPedidos, ReporteIntegridad *reporte);
+
+/**
+ * @brief Imprime el resumen de la verificación y los ejemplos de referencias rotas.
+ *
+ * Si no hay referencias rotas, el resumen solo se imprime con los mensajes activos.
+ *
+ * @param reporte Reporte a imprimir.
+ */
+void imprimirReporteIntegridad(const ReporteIntegridad *reporte);
+
+#endif // INTEGRIDAD_REFERENCIAL_H
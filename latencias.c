@@ -0,0 +1,290 @@
+/**
+ * @file latencias.c
+ * @brief Implementación de los histogramas de latencia por hilo.
+ */
+
+#define _POSIX_C_SOURCE 200809L // clock_gettime con -std=c99
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "latencias.h"
+
+/// Nombre de la función medida, en el orden de OperacionLatencia.
+const char *const nombresOperacionLatencia[NUM_OPERACIONES_LATENCIA] = {
+    "insertarAlimento", "restaurarAlimento", "buscarAlimento", "actualizarAlimento", "retirarAlimento",
+    "eliminarAlimento", "copiarAlimentosDesdeTabla", "quicksortAlimentosParallel", "busquedaBinariaAlimentosParallel",
+    "agregarCliente", "restaurarCliente", "buscarCliente", "actualizarCliente", "retirarCliente",
+    "eliminarCliente", "copiarClientesDesdeTabla", "quicksortClientesParallel", "busquedaBinariaClientesParallel",
+    "agregarMenu", "restaurarMenu", "buscarMenuPorID", "actualizarMenu", "retirarMenu",
+    "eliminarMenu", "copiarMenusDesdeTabla", "quicksortMenusParallel", "busquedaBinariaMenusParallel",
+    "agregarPedido", "restaurarPedido", "buscarPedido", "actualizarPedido", "retirarPedido",
+    "eliminarPedido", "copiarPedidosDesdeTabla", "quicksortPedidosParallel", "busquedaBinariaPedidosParallel"
+};
+
+/**
+ * @brief Histogramas de un hilo.
+ *
+ * Solo el hilo dueño escribe; los reportes leen con cargas atómicas relajadas. Cuando el
+ * hilo termina, el registro queda libre (con sus cuentas) para el siguiente hilo nuevo.
+ */
+typedef struct RegistroLatencias {
+    HistogramaLatencia histogramas[NUM_OPERACIONES_LATENCIA];
+    bool libre;
+    struct RegistroLatencias *siguiente;
+} RegistroLatencias;
+
+/// Registros de todos los hilos que han medido algo; nunca se liberan.
+static RegistroLatencias *registros = NULL;
+
+/// Protege la lista de registros (solo al crear o liberar uno, no al medir).
+static pthread_mutex_t candadoRegistros = PTHREAD_MUTEX_INITIALIZER;
+
+/// Registro del hilo que llama.
+static pthread_key_t claveRegistro;
+static pthread_once_t claveCreada = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Marca como libre el registro de un hilo que terminó.
+ */
+static void soltarRegistro(void *registro) {
+    pthread_mutex_lock(&candadoRegistros);
+    ((RegistroLatencias *)registro)->libre = true;
+    pthread_mutex_unlock(&candadoRegistros);
+}
+
+static void crearClaveRegistro(void) {
+    pthread_key_create(&claveRegistro, soltarRegistro);
+}
+
+/**
+ * @brief Registro del hilo que llama; lo toma de los libres o lo crea la primera vez.
+ * @return Registro, o `NULL` si no hubo memoria.
+ */
+static RegistroLatencias *registroDelHilo(void) {
+    pthread_once(&claveCreada, crearClaveRegistro);
+    RegistroLatencias *registro = (RegistroLatencias *)pthread_getspecific(claveRegistro);
+    if (registro) return registro;
+
+    pthread_mutex_lock(&candadoRegistros);
+    for (registro = registros; registro && !registro->libre; registro = registro->siguiente);
+    if (registro) {
+        registro->libre = false;
+    } else {
+        registro = (RegistroLatencias *)calloc(1, sizeof(RegistroLatencias));
+        if (registro) {
+            registro->siguiente = registros;
+            registros = registro;
+        }
+    }
+    pthread_mutex_unlock(&candadoRegistros);
+    if (registro) pthread_setspecific(claveRegistro, registro);
+    return registro;
+}
+
+/**
+ * @brief Cubeta de una duración: exacta hasta LATENCIA_CUBETAS_EXACTAS ns y después
+ * LATENCIA_SUBCUBETAS cubetas por potencia de 2.
+ */
+static int cubetaLatencia(uint64_t nanosegundos) {
+    if (nanosegundos < LATENCIA_CUBETAS_EXACTAS) return (int)nanosegundos;
+    int exponente = 63 - __builtin_clzll(nanosegundos); // Al menos 5
+    if (exponente > LATENCIA_EXPONENTE_MAXIMO) return LATENCIA_CUBETAS - 1;
+    int mantisa = (int)(nanosegundos >> (exponente - 4)) & (LATENCIA_SUBCUBETAS - 1);
+    return LATENCIA_CUBETAS_EXACTAS + (exponente - 5) * LATENCIA_SUBCUBETAS + mantisa;
+}
+
+/**
+ * @brief Mayor duración que cae en una cubeta.
+ */
+static uint64_t limiteCubeta(int cubeta) {
+    if (cubeta < LATENCIA_CUBETAS_EXACTAS) return (uint64_t)cubeta;
+    int exponente = 5 + (cubeta - LATENCIA_CUBETAS_EXACTAS) / LATENCIA_SUBCUBETAS;
+    int mantisa = (cubeta - LATENCIA_CUBETAS_EXACTAS) % LATENCIA_SUBCUBETAS;
+    uint64_t ancho = 1ULL << (exponente - 4);
+    return (uint64_t)(LATENCIA_SUBCUBETAS + mantisa) * ancho + ancho - 1;
+}
+
+/**
+ * @brief Suma a un contador que solo escribe este hilo (sin lectura-modificación-escritura atómica).
+ */
+static inline void sumarContador(uint64_t *contador, uint64_t valor) {
+    __atomic_store_n(contador, __atomic_load_n(contador, __ATOMIC_RELAXED) + valor, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Indica si el programa se compiló con -DMETRICAS_LATENCIA.
+ */
+bool latenciasActivas(void) {
+#ifdef METRICAS_LATENCIA
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Lee el reloj monotónico.
+ * @return Nanosegundos desde un origen arbitrario.
+ */
+uint64_t relojLatencia(void) {
+    struct timespec ahora;
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (uint64_t)ahora.tv_sec * 1000000000ULL + (uint64_t)ahora.tv_nsec;
+}
+
+/**
+ * @brief Registra una duración en el histograma del hilo que llama.
+ * @param operacion Operación medida.
+ * @param nanosegundos Duración.
+ */
+void registrarLatencia(OperacionLatencia operacion, uint64_t nanosegundos) {
+    RegistroLatencias *registro = registroDelHilo();
+    if (!registro) return;
+    HistogramaLatencia *histograma = &registro->histogramas[operacion];
+    sumarContador(&histograma->cuentas[cubetaLatencia(nanosegundos)], 1);
+    sumarContador(&histograma->llamadas, 1);
+    sumarContador(&histograma->sumaNs, nanosegundos);
+    if (nanosegundos > __atomic_load_n(&histograma->maximoNs, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&histograma->maximoNs, nanosegundos, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Registra la duración de una medición iniciada con MEDIR_LATENCIA.
+ * @param medicion Medición en curso.
+ */
+void terminarMedicionLatencia(MedicionLatencia *medicion) {
+    registrarLatencia(medicion->operacion, relojLatencia() - medicion->inicio);
+}
+
+/**
+ * @brief Suma los histogramas de todos los hilos.
+ * @param resultado Un histograma por operación (de salida).
+ */
+void combinarLatencias(HistogramaLatencia resultado[NUM_OPERACIONES_LATENCIA]) {
+    memset(resultado, 0, NUM_OPERACIONES_LATENCIA * sizeof(HistogramaLatencia));
+    pthread_mutex_lock(&candadoRegistros);
+    for (RegistroLatencias *registro = registros; registro; registro = registro->siguiente) {
+        for (int op = 0; op < NUM_OPERACIONES_LATENCIA; op++) {
+            HistogramaLatencia *origen = &registro->histogramas[op], *destino = &resultado[op];
+            uint64_t llamadas = __atomic_load_n(&origen->llamadas, __ATOMIC_RELAXED);
+            if (llamadas == 0) continue;
+            for (int c = 0; c < LATENCIA_CUBETAS; c++) {
+                destino->cuentas[c] += __atomic_load_n(&origen->cuentas[c], __ATOMIC_RELAXED);
+            }
+            destino->llamadas += llamadas;
+            destino->sumaNs += __atomic_load_n(&origen->sumaNs, __ATOMIC_RELAXED);
+            uint64_t maximo = __atomic_load_n(&origen->maximoNs, __ATOMIC_RELAXED);
+            if (maximo > destino->maximoNs) destino->maximoNs = maximo;
+        }
+    }
+    pthread_mutex_unlock(&candadoRegistros);
+}
+
+/**
+ * @brief Calcula un percentil de un histograma.
+ * @param histograma Histograma combinado.
+ * @param percentil Percentil entre 0 y 100.
+ * @return Límite superior de la cubeta del percentil en ns (nunca mayor que el máximo), o 0 sin llamadas.
+ */
+uint64_t percentilLatencia(const HistogramaLatencia *histograma, double percentil) {
+    uint64_t total = 0;
+    for (int c = 0; c < LATENCIA_CUBETAS; c++) total += histograma->cuentas[c];
+    if (total == 0) return 0;
+
+    // Las cuentas se leyeron mientras otros hilos registraban: el rango sale de la suma de cubetas
+    uint64_t rango = (uint64_t)(percentil / 100.0 * (double)total + 0.999999);
+    if (rango < 1) rango = 1;
+    uint64_t acumulado = 0;
+    for (int c = 0; c < LATENCIA_CUBETAS; c++) {
+        acumulado += histograma->cuentas[c];
+        if (acumulado >= rango) {
+            uint64_t limite = limiteCubeta(c);
+            return limite < histograma->maximoNs ? limite : histograma->maximoNs;
+        }
+    }
+    return histograma->maximoNs;
+}
+
+/**
+ * @brief Pone en cero los histogramas de todos los hilos.
+ */
+void reiniciarLatencias(void) {
+    pthread_mutex_lock(&candadoRegistros);
+    for (RegistroLatencias *registro = registros; registro; registro = registro->siguiente) {
+        for (int op = 0; op < NUM_OPERACIONES_LATENCIA; op++) {
+            HistogramaLatencia *histograma = &registro->histogramas[op];
+            for (int c = 0; c < LATENCIA_CUBETAS; c++) __atomic_store_n(&histograma->cuentas[c], 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&histograma->llamadas, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&histograma->sumaNs, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&histograma->maximoNs, 0, __ATOMIC_RELAXED);
+        }
+    }
+    pthread_mutex_unlock(&candadoRegistros);
+}
+
+/**
+ * @brief Escribe el reporte como tabla o como CSV.
+ * @param archivo Destino.
+ * @param csv `true` para CSV.
+ */
+static void escribirLatencias(FILE *archivo, bool csv) {
+    HistogramaLatencia *histogramas = (HistogramaLatencia *)malloc(NUM_OPERACIONES_LATENCIA * sizeof(HistogramaLatencia));
+    if (!histogramas) {
+        printf("\nError: No hay memoria para el reporte de latencias.\n");
+        return;
+    }
+    combinarLatencias(histogramas);
+
+    if (csv) {
+        fprintf(archivo, "operacion,llamadas,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,promedio_ns\n");
+    } else {
+        fprintf(archivo, "\n%-33s %12s %10s %10s %10s %10s %12s %10s\n", "Operación", "Llamadas", "p50 (ns)",
+                "p90 (ns)", "p99 (ns)", "p99.9 (ns)", "Máx. (ns)", "Prom. (ns)");
+    }
+    int medidas = 0;
+    for (int op = 0; op < NUM_OPERACIONES_LATENCIA; op++) {
+        const HistogramaLatencia *h = &histogramas[op];
+        if (h->llamadas == 0) continue;
+        medidas++;
+        const char *formato = csv ? "%s,%llu,%llu,%llu,%llu,%llu,%llu,%.1f\n"
+                                  : "%-33s %12llu %10llu %10llu %10llu %10llu %12llu %10.1f\n";
+        fprintf(archivo, formato, nombresOperacionLatencia[op], (unsigned long long)h->llamadas,
+                (unsigned long long)percentilLatencia(h, 50.0), (unsigned long long)percentilLatencia(h, 90.0),
+                (unsigned long long)percentilLatencia(h, 99.0), (unsigned long long)percentilLatencia(h, 99.9),
+                (unsigned long long)h->maximoNs, (double)h->sumaNs / (double)h->llamadas);
+    }
+    if (!csv && medidas == 0) fprintf(archivo, "(ninguna operación medida todavía)\n");
+    free(histogramas);
+}
+
+/**
+ * @brief Imprime llamadas, p50, p90, p99, p99.9, máximo y promedio de cada operación llamada.
+ */
+void imprimirLatencias(void) {
+    if (!latenciasActivas()) {
+        printf("\nLa medición de latencias está desactivada: compile con -DMETRICAS_LATENCIA (make LATENCIA=1).\n");
+        return;
+    }
+    escribirLatencias(stdout, false);
+}
+
+/**
+ * @brief Guarda el mismo reporte en un archivo CSV.
+ * @param nombreArchivo Archivo a escribir.
+ * @return `true` si se escribió, `false` si no se pudo crear.
+ */
+bool guardarLatencias(const char *nombreArchivo) {
+    FILE *archivo = fopen(nombreArchivo, "w");
+    if (!archivo) {
+        printf("\nError: No se pudo crear el archivo '%s'.\n", nombreArchivo);
+        return false;
+    }
+    escribirLatencias(archivo, true);
+    bool correcto = fclose(archivo) == 0;
+    if (!correcto) printf("\nError: No se pudo escribir el archivo '%s'.\n", nombreArchivo);
+    return correcto;
+}
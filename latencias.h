@@ -0,0 +1,172 @@
+/**
+ * @file latencias.h
+ * @brief Histogramas de latencia por operación de las tablas (solo con -DMETRICAS_LATENCIA).
+ *
+ * Cada operación pública de las tablas empieza con `MEDIR_LATENCIA`, que toma el reloj
+ * monotónico al entrar y registra la duración al salir por cualquier `return`. Sin
+ * -DMETRICAS_LATENCIA la macro no genera código y las tablas quedan como antes.
+ *
+ * Cada hilo registra en sus propios histogramas, sin candados ni operaciones atómicas
+ * de lectura-modificación-escritura; `combinarLatencias` los suma cuando se pide un
+ * reporte. Los histogramas son log-lineales, como HDR Histogram: los primeros 32 ns
+ * tienen una cubeta cada uno y después cada potencia de 2 se parte en 16 cubetas, así
+ * que un percentil se informa con un error menor al 6.25 % en cualquier escala.
+ *
+ * Las operaciones que llaman a otras (por ejemplo, agregarPedido busca el cliente y los
+ * menús) registran también las llamadas internas. Medir cuesta dos lecturas del reloj
+ * por llamada (de 40 a 100 ns según la máquina), así que las operaciones de pocos ns,
+ * como buscar, se ven varias veces más lentas que sin la opción.
+ */
+
+#ifndef LATENCIAS_H
+#define LATENCIAS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Cubetas exactas de 1 ns al principio del histograma (el doble de las subcubetas).
+#define LATENCIA_CUBETAS_EXACTAS 32
+
+/// Cubetas en que se parte cada potencia de 2.
+#define LATENCIA_SUBCUBETAS 16
+
+/// Mayor potencia de 2 que se distingue (2^40 ns, unos 18 minutos); lo demás cae en la última cubeta.
+#define LATENCIA_EXPONENTE_MAXIMO 40
+
+/// Cubetas de cada histograma.
+#define LATENCIA_CUBETAS (LATENCIA_CUBETAS_EXACTAS + (LATENCIA_EXPONENTE_MAXIMO - 4) * LATENCIA_SUBCUBETAS)
+
+/**
+ * @brief Operaciones medidas, en el orden en que se informan.
+ */
+typedef enum {
+    LATENCIA_INSERTAR_ALIMENTO,
+    LATENCIA_RESTAURAR_ALIMENTO,
+    LATENCIA_BUSCAR_ALIMENTO,
+    LATENCIA_ACTUALIZAR_ALIMENTO,
+    LATENCIA_RETIRAR_ALIMENTO,
+    LATENCIA_ELIMINAR_ALIMENTO,
+    LATENCIA_COPIAR_ALIMENTOS,
+    LATENCIA_ORDENAR_ALIMENTOS,
+    LATENCIA_BUSQUEDA_BINARIA_ALIMENTOS,
+    LATENCIA_AGREGAR_CLIENTE,
+    LATENCIA_RESTAURAR_CLIENTE,
+    LATENCIA_BUSCAR_CLIENTE,
+    LATENCIA_ACTUALIZAR_CLIENTE,
+    LATENCIA_RETIRAR_CLIENTE,
+    LATENCIA_ELIMINAR_CLIENTE,
+    LATENCIA_COPIAR_CLIENTES,
+    LATENCIA_ORDENAR_CLIENTES,
+    LATENCIA_BUSQUEDA_BINARIA_CLIENTES,
+    LATENCIA_AGREGAR_MENU,
+    LATENCIA_RESTAURAR_MENU,
+    LATENCIA_BUSCAR_MENU,
+    LATENCIA_ACTUALIZAR_MENU,
+    LATENCIA_RETIRAR_MENU,
+    LATENCIA_ELIMINAR_MENU,
+    LATENCIA_COPIAR_MENUS,
+    LATENCIA_ORDENAR_MENUS,
+    LATENCIA_BUSQUEDA_BINARIA_MENUS,
+    LATENCIA_AGREGAR_PEDIDO,
+    LATENCIA_RESTAURAR_PEDIDO,
+    LATENCIA_BUSCAR_PEDIDO,
+    LATENCIA_ACTUALIZAR_PEDIDO,
+    LATENCIA_RETIRAR_PEDIDO,
+    LATENCIA_ELIMINAR_PEDIDO,
+    LATENCIA_COPIAR_PEDIDOS,
+    LATENCIA_ORDENAR_PEDIDOS,
+    LATENCIA_BUSQUEDA_BINARIA_PEDIDOS,
+    NUM_OPERACIONES_LATENCIA
+} OperacionLatencia;
+
+/// Nombre de la función medida, en el orden de OperacionLatencia.
+extern const char *const nombresOperacionLatencia[NUM_OPERACIONES_LATENCIA];
+
+/**
+ * @brief Histograma de las duraciones de una operación, en nanosegundos.
+ */
+typedef struct {
+    uint64_t cuentas[LATENCIA_CUBETAS];  ///< Llamadas que cayeron en cada cubeta.
+    uint64_t llamadas;                   ///< Total de llamadas.
+    uint64_t sumaNs;                     ///< Suma de las duraciones.
+    uint64_t maximoNs;                   ///< Duración más larga.
+} HistogramaLatencia;
+
+/**
+ * @brief Medición en curso; la cierra `terminarMedicionLatencia` al salir de la función.
+ */
+typedef struct {
+    OperacionLatencia operacion;
+    uint64_t inicio;
+} MedicionLatencia;
+
+#ifdef METRICAS_LATENCIA
+/// Mide la función desde este punto hasta cualquiera de sus `return`.
+#define MEDIR_LATENCIA(operacion) \
+    MedicionLatencia medicionLatencia __attribute__((cleanup(terminarMedicionLatencia))) = { (operacion), relojLatencia() }
+#else
+#define MEDIR_LATENCIA(operacion) ((void)0)
+#endif
+
+/**
+ * @brief Indica si el programa se compiló con -DMETRICAS_LATENCIA.
+ */
+bool latenciasActivas(void);
+
+/**
+ * @brief Lee el reloj monotónico.
+ * @return Nanosegundos desde un origen arbitrario.
+ */
+uint64_t relojLatencia(void);
+
+/**
+ * @brief Registra una duración en el histograma del hilo que llama.
+ * @param operacion Operación medida.
+ * @param nanosegundos Duración.
+ */
+void registrarLatencia(OperacionLatencia operacion, uint64_t nanosegundos);
+
+/**
+ * @brief Registra la duración de una medición iniciada con MEDIR_LATENCIA.
+ * @param medicion Medición en curso.
+ */
+void terminarMedicionLatencia(MedicionLatencia *medicion);
+
+/**
+ * @brief Suma los histogramas de todos los hilos.
+ *
+ * Se puede llamar mientras otros hilos registran; las llamadas en curso pueden quedar
+ * fuera de esta suma.
+ *
+ * @param resultado Un histograma por operación (de salida).
+ */
+void combinarLatencias(HistogramaLatencia resultado[NUM_OPERACIONES_LATENCIA]);
+
+/**
+ * @brief Calcula un percentil de un histograma.
+ * @param histograma Histograma combinado.
+ * @param percentil Percentil entre 0 y 100 (por ejemplo, 99.9).
+ * @return Límite superior de la cubeta del percentil en ns (nunca mayor que el máximo), o 0 sin llamadas.
+ */
+uint64_t percentilLatencia(const HistogramaLatencia *histograma, double percentil);
+
+/**
+ * @brief Pone en cero los histogramas de todos los hilos.
+ *
+ * Una llamada que se registre al mismo tiempo en otro hilo puede perderse.
+ */
+void reiniciarLatencias(void);
+
+/**
+ * @brief Imprime llamadas, p50, p90, p99, p99.9, máximo y promedio de cada operación llamada.
+ */
+void imprimirLatencias(void);
+
+/**
+ * @brief Guarda el mismo reporte en un archivo CSV.
+ * @param nombreArchivo Archivo a escribir.
+ * @return `true` si se escribió, `false` si no se pudo crear.
+ */
+bool guardarLatencias(const char *nombreArchivo);
+
+#endif // LATENCIAS_H
@@ -15,7 +15,7 @@
 #include <time.h>
 
 // Compilacion y ejecución pesonal
-// gcc -Wall -std=c99 -fopenmp -I "C:\Users\Angel Mijangos\vcpkg\installed\x64-windows\include" -L "C:\Users\Angel Mijangos\vcpkg\installed\x64-windows\lib" -o salidaPF.out main.c deserializar_datos.c serializar_datos.c hash_pedidos.c hash_clientes.c hash_menus.c hash_alimentos.c -lyaml 
+// gcc -Wall -std=c99 -fopenmp -o salidaPF.out main.c deserializar_datos.c serializar_datos.c hash_pedidos.c hash_clientes.c hash_menus.c hash_alimentos.c indice_busqueda.c buffer_salida.c mensajes.c snapshot_binario.c bloque_nodos.c archivo_memoria.c mutaciones.c bitacora.c codificacion_mutaciones.c cambios_pendientes.c snapshot_delta.c guardado_segundo_plano.c integridad_referencial.c importacion.c datos_aleatorios.c modo_lote.c servidor.c tareas.c cocina.c latencias.c contabilidad_memoria.c reporte_memoria.c totales_pedidos.c reportes_ventas.c cadenas_internadas.c
 // salidaPF.out
 
 // Headers personalizados
@@ -23,8 +23,29 @@
 #include "hash_menus.h"
 #include "hash_clientes.h"
 #include "hash_pedidos.h"
+#include "fechas.h"
 #include "serializar_datos.h"
 #include "deserializar_datos.h"
+#include "indice_busqueda.h"
+#include "snapshot_binario.h"
+#include "bitacora.h"
+#include "snapshot_delta.h"
+#include "guardado_segundo_plano.h"
+#include "integridad_referencial.h"
+#include "importacion.h"
+#include "datos_aleatorios.h"
+#include "modo_lote.h"
+#include "servidor.h"
+#include "tareas.h"
+#include "cocina.h"
+#include "latencias.h"
+#include "reporte_memoria.h"
+#include "totales_pedidos.h"
+#include "reportes_ventas.h"
+#include "mensajes.h"
+
+/// Nombre base del snapshot y la bitácora que guardan los cambios entre ejecuciones (ver bitacora.h).
+#define NOMBRE_BASE_DATOS "BaseDeDatos"
 
 // Declaración de las tablas hash globales
 HashTable *tablaAlimentos;
@@ -33,31 +54,45 @@ ClientesHashTable *tablaClientes;
 PedidosHashTable *tablaPedidos;
 
 // Prototipos de funciones
-void generarDatosAleatorios(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes, PedidosHashTable *tablaPedidos);
+bool generarDatosAleatorios(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes, PedidosHashTable *tablaPedidos);
 void menuGesAlimentos();
 void menuGesMenus();
 void menuGesClientes();
 void menuGesPedidos();
+void menuImportar();
+void menuLatencias();
+void menuMemoria();
+void menuReportesVentas();
 void menuAdministrador();
 void menuCliente();
+int seleccionarFormatoArchivo(bool guardar);
+void verificarIntegridadCargada();
+int ejecutarModoLote(int argc, char *argv[]);
+int ejecutarModoServidor(int argc, char *argv[]);
 
 /**
  * @brief Opciones avanzadas del menú de pedidos.
  *
  * Proporciona funciones para ordenar pedidos utilizando QuickSort paralelizado
- * y búsqueda binaria paralelizada.
+ * y búsqueda binaria paralelizada, además de búsqueda con un índice estático en orden de B-tree,
+ * despachar los pedidos pendientes a los cocineros (ver cocina.h) y consultar el total de un
+ * pedido con la caché de totales (ver totales_pedidos.h).
  *
  * @param tablaPedidos Puntero a la tabla hash de pedidos.
  */
 void menuOpcionesAvanzadasPedidos(PedidosHashTable *tablaPedidos) 
 {
     int opcion;
+    char textoFecha[FECHA_TEXTO];
     do 
     {
         printf("\n--- Opciones Avanzadas: Pedidos ---\n");
         printf("1. Ordenar Pedidos (QuickSort Paralelizado)\n");
         printf("2. Buscar Pedido (Búsqueda Binaria Paralelizada)\n");
-        printf("3. Volver\n");
+        printf("3. Buscar Pedido (Índice Estático B-tree SIMD)\n");
+        printf("4. Despachar Pedidos Pendientes a la Cocina\n");
+        printf("5. Calcular Total de un Pedido (Caché de Totales)\n");
+        printf("6. Volver\n");
         printf("Seleccione una opción: ");
         scanf("%d", &opcion);
 
@@ -75,7 +110,7 @@ void menuOpcionesAvanzadasPedidos(PedidosHashTable *tablaPedidos)
                 for(int i = 0; i < numPedidos; i++) 
                 {
                     printf("[ID=%d, Cliente=%d, Fecha=%s, Estado=%s]\n",
-                           pedidos[i].idPedido, pedidos[i].idCliente, pedidos[i].fecha, pedidos[i].estado);
+                           pedidos[i].idPedido, pedidos[i].idCliente, formatearFecha(pedidos[i].fecha, textoFecha), pedidos[i].estado);
                 }
 
                 free(pedidos);
@@ -98,7 +133,7 @@ void menuOpcionesAvanzadasPedidos(PedidosHashTable *tablaPedidos)
                 if (resultado != -1) 
                 {
                     printf("\nPedido encontrado: [ID=%d, Cliente=%d, Fecha=%s, Estado=%s]\n",
-                           pedidos[resultado].idPedido, pedidos[resultado].idCliente, pedidos[resultado].fecha, pedidos[resultado].estado);
+                           pedidos[resultado].idPedido, pedidos[resultado].idCliente, formatearFecha(pedidos[resultado].fecha, textoFecha), pedidos[resultado].estado);
                 } 
                 else 
                 {
@@ -109,6 +144,72 @@ void menuOpcionesAvanzadasPedidos(PedidosHashTable *tablaPedidos)
                 break;
             }
             case 3:
+            {
+                // El índice se construye una vez y queda en la tabla hasta el siguiente cambio
+                IndiceBusqueda *indice = indiceIdsPedidos(tablaPedidos);
+
+                int idBuscado;
+                printf("Ingrese el ID del pedido a buscar: ");
+                scanf("%d", &idBuscado);
+
+                int idEncontrado;
+                Pedido *pedido = indice && indiceSiguienteClave(indice, idBuscado, &idEncontrado)
+                                 ? buscarPedido(tablaPedidos, idEncontrado) : NULL;
+
+                if(pedido && pedido->idPedido == idBuscado)
+                {
+                    printf("\nPedido encontrado: [ID=%d, Cliente=%d, Fecha=%s, Estado=%s]\n",
+                           pedido->idPedido, pedido->idCliente, formatearFecha(pedido->fecha, textoFecha), pedido->estado);
+                }
+                else if(pedido)
+                {
+                    printf("\nPedido no encontrado. Siguiente ID mayor: [ID=%d, Cliente=%d, Fecha=%s, Estado=%s]\n",
+                           pedido->idPedido, pedido->idCliente, formatearFecha(pedido->fecha, textoFecha), pedido->estado);
+                }
+                else
+                {
+                    printf("\nPedido no encontrado.\n");
+                }
+                break;
+            }
+            case 4:
+            {
+                int numCocineros;
+                printf("Ingrese el número de cocineros: ");
+                scanf("%d", &numCocineros);
+
+                // Los cocineros actualizan los pedidos desde otros hilos: sin un mensaje por cambio
+                bool mensajesPrevios = mensajesActivos;
+                mensajesActivos = false;
+                if(iniciarCocina(tablaPedidos, numCocineros, 0))
+                {
+                    MetricasCocina metricas;
+                    detenerCocina(&metricas);
+                    printf("\nPedidos pendientes despachados a la cocina.\n");
+                    imprimirMetricasCocina(&metricas);
+                }
+                mensajesActivos = mensajesPrevios;
+                break;
+            }
+            case 5:
+            {
+                int idPedido;
+                double total;
+                printf("Ingrese el ID del Pedido: ");
+                scanf("%d", &idPedido);
+
+                if(calcularTotalPedido(idPedido, &total))
+                {
+                    printf("\nTotal del pedido %d: %.2f\n", idPedido, total);
+                }
+                else
+                {
+                    printf("\nPedido no encontrado.\n");
+                }
+                imprimirMetricasTotales();
+                break;
+            }
+            case 6:
             {
                 printf("\nVolviendo al menú anterior...\n");
                 break;
@@ -116,7 +217,7 @@ void menuOpcionesAvanzadasPedidos(PedidosHashTable *tablaPedidos)
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
-    }while(opcion!=3);
+    }while(opcion!=6);
 }
 
 /**
@@ -128,7 +229,8 @@ void menuOpcionesAvanzadasPedidos(PedidosHashTable *tablaPedidos)
 void menuGesPedidos()
 {
     int opcion, idPedido, idCliente, numMenus, menus[50];
-    char fecha[11], estado[15];
+    char textoFecha[32], estado[15];
+    Fecha fecha;
     Pedido *pedido;
 
     do{
@@ -152,7 +254,12 @@ void menuGesPedidos()
                 printf("Ingrese ID del Cliente: ");
                 scanf("%d", &idCliente);
                 printf("Ingrese la Fecha del Pedido (YYYY-MM-DD): ");
-                scanf("%s", fecha);
+                scanf("%31s", textoFecha);
+                if (!leerFechaTexto(textoFecha, &fecha))
+                {
+                    printf("\nError: Fecha no válida. Use el formato YYYY-MM-DD.\n");
+                    break;
+                }
                 printf("Ingrese el Número de Menús: ");
                 scanf("%d", &numMenus);
                 for(int i = 0; i < numMenus; i++)
@@ -173,7 +280,7 @@ void menuGesPedidos()
                 if(pedido)
                 {
                     printf("\nPedido encontrado: ID=%d, Cliente=%d, Fecha=%s, Estado=%s\n",
-                           pedido->idPedido, pedido->idCliente, pedido->fecha, pedido->estado);
+                           pedido->idPedido, pedido->idCliente, formatearFecha(pedido->fecha, textoFecha), pedido->estado);
                 } 
                 else 
                 {
@@ -221,6 +328,7 @@ void menuGesPedidos()
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
+        confirmarBitacora(); // Los cambios de esta opción quedan en disco antes de mostrar el menú otra vez
     }while(opcion!=7);
 }
 
@@ -228,7 +336,7 @@ void menuGesPedidos()
  * @brief Opciones avanzadas del menú de clientes.
  *
  * Proporciona funciones para ordenar clientes utilizando QuickSort paralelizado
- * y búsqueda binaria paralelizada.
+ * y búsqueda binaria paralelizada, además de búsqueda con un índice estático en orden de B-tree.
  *
  * @param tablaClientes Puntero a la tabla hash de clientes.
  */
@@ -240,7 +348,8 @@ void menuOpcionesAvanzadasClientes(ClientesHashTable *tablaClientes)
         printf("\n--- Opciones Avanzadas: Clientes ---\n");
         printf("1. Ordenar Clientes (QuickSort Paralelizado)\n");
         printf("2. Buscar Cliente (Búsqueda Binaria Paralelizada)\n");
-        printf("3. Volver\n");
+        printf("3. Buscar Cliente (Índice Estático B-tree SIMD)\n");
+        printf("4. Volver\n");
         printf("Seleccione una opción: ");
         scanf("%d", &opcion);
 
@@ -258,7 +367,7 @@ void menuOpcionesAvanzadasClientes(ClientesHashTable *tablaClientes)
                 for(int i = 0; i < numClientes; i++) 
                 {
                     printf("[ID=%d, Nombre=%s, Teléfono=%s]\n",
-                           clientes[i].idCliente, clientes[i].nombre, clientes[i].telefono);
+                           clientes[i].idCliente, textoCadena(clientes[i].nombre), clientes[i].telefono);
                 }
 
                 free(clientes);
@@ -281,7 +390,8 @@ void menuOpcionesAvanzadasClientes(ClientesHashTable *tablaClientes)
                 if(resultado != -1) 
                 {
                     printf("\nCliente encontrado: [ID=%d, Nombre=%s, Teléfono=%s]\n",
-                           clientes[resultado].idCliente, clientes[resultado].nombre, clientes[resultado].telefono);
+                           clientes[resultado].idCliente, textoCadena(clientes[resultado].nombre),
+                           clientes[resultado].telefono);
                 } 
                 else 
                 {
@@ -292,6 +402,37 @@ void menuOpcionesAvanzadasClientes(ClientesHashTable *tablaClientes)
                 break;
             }
             case 3:
+            {
+                // El índice se construye una vez y queda en la tabla hasta el siguiente cambio
+                IndiceBusqueda *indice = indiceIdsClientes(tablaClientes);
+
+                int idBuscado;
+                printf("Ingrese el ID del cliente a buscar: ");
+                scanf("%d", &idBuscado);
+
+                int idEncontrado;
+                Cliente *cliente = indice && indiceSiguienteClave(indice, idBuscado, &idEncontrado)
+                                   ? buscarCliente(tablaClientes, idEncontrado) : NULL;
+
+                if(cliente && cliente->idCliente == idBuscado)
+                {
+                    printf("\nCliente encontrado: [ID=%d, Nombre=%s, Teléfono=%s]\n",
+                           cliente->idCliente, textoCadena(cliente->nombre),
+                           cliente->telefono);
+                }
+                else if(cliente)
+                {
+                    printf("\nCliente no encontrado. Siguiente ID mayor: [ID=%d, Nombre=%s, Teléfono=%s]\n",
+                           cliente->idCliente, textoCadena(cliente->nombre),
+                           cliente->telefono);
+                }
+                else
+                {
+                    printf("\nCliente no encontrado.\n");
+                }
+                break;
+            }
+            case 4:
             {
                 printf("\nVolviendo al menú anterior...\n");
                 break;
@@ -299,7 +440,7 @@ void menuOpcionesAvanzadasClientes(ClientesHashTable *tablaClientes)
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
-    }while(opcion!=3);
+    }while(opcion!=4);
 }
 
 /**
@@ -347,7 +488,7 @@ void menuGesClientes()
                 if(cliente)
                 {
                     printf("\nCliente encontrado: ID=%d, Nombre=%s, Teléfono=%s\n",
-                           cliente->idCliente, cliente->nombre, cliente->telefono);
+                           cliente->idCliente, textoCadena(cliente->nombre), cliente->telefono);
                 } 
                 else 
                 {
@@ -395,6 +536,7 @@ void menuGesClientes()
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
+        confirmarBitacora(); // Los cambios de esta opción quedan en disco antes de mostrar el menú otra vez
     }while(opcion!=7);
 }
 
@@ -402,19 +544,21 @@ void menuGesClientes()
  * @brief Opciones avanzadas del menú de menús.
  *
  * Proporciona funciones para ordenar menús utilizando QuickSort paralelizado
- * y búsqueda binaria paralelizada.
+ * y búsqueda binaria paralelizada, además de búsqueda con un índice estático en orden de B-tree.
  *
  * @param tablaMenus Puntero a la tabla hash de menús.
  */
 void menuOpcionesAvanzadasMenus(MenuHashTable *tablaMenus)
 {
     int opcion;
+    char textoFecha[FECHA_TEXTO];
     do
     {
         printf("\n--- Opciones Avanzadas: Menús ---\n");
         printf("1. Ordenar Menús (QuickSort Paralelizado)\n");
         printf("2. Buscar Menú (Búsqueda Binaria Paralelizada)\n");
-        printf("3. Volver\n");
+        printf("3. Buscar Menú (Índice Estático B-tree SIMD)\n");
+        printf("4. Volver\n");
         printf("Seleccione una opción: ");
         scanf("%d", &opcion);
 
@@ -432,7 +576,7 @@ void menuOpcionesAvanzadasMenus(MenuHashTable *tablaMenus)
                 for(int i = 0; i < numMenus; i++) 
                 {
                     printf("[ID=%d, Fecha=%s, Número de Alimentos=%d]\n",
-                           menus[i].idMenu, menus[i].fecha, menus[i].numAlimentos);
+                           menus[i].idMenu, formatearFecha(menus[i].fecha, textoFecha), menus[i].numAlimentos);
                 }
 
                 free(menus);
@@ -455,7 +599,7 @@ void menuOpcionesAvanzadasMenus(MenuHashTable *tablaMenus)
                 if(resultado != -1) 
                 {
                     printf("\nMenú encontrado: [ID=%d, Fecha=%s, Número de Alimentos=%d]\n",
-                           menus[resultado].idMenu, menus[resultado].fecha, menus[resultado].numAlimentos);
+                           menus[resultado].idMenu, formatearFecha(menus[resultado].fecha, textoFecha), menus[resultado].numAlimentos);
                 } 
                 else 
                 {
@@ -466,6 +610,35 @@ void menuOpcionesAvanzadasMenus(MenuHashTable *tablaMenus)
                 break;
             }
             case 3:
+            {
+                // El índice se construye una vez y queda en la tabla hasta el siguiente cambio
+                IndiceBusqueda *indice = indiceIdsMenus(tablaMenus);
+
+                int idBuscado;
+                printf("Ingrese el ID del menú a buscar: ");
+                scanf("%d", &idBuscado);
+
+                int idEncontrado;
+                Menu *menu = indice && indiceSiguienteClave(indice, idBuscado, &idEncontrado)
+                             ? buscarMenuPorID(tablaMenus, idEncontrado) : NULL;
+
+                if(menu && menu->idMenu == idBuscado)
+                {
+                    printf("\nMenú encontrado: [ID=%d, Fecha=%s, Número de Alimentos=%d]\n",
+                           menu->idMenu, formatearFecha(menu->fecha, textoFecha), menu->numAlimentos);
+                }
+                else if(menu)
+                {
+                    printf("\nMenú no encontrado. Siguiente ID mayor: [ID=%d, Fecha=%s, Número de Alimentos=%d]\n",
+                           menu->idMenu, formatearFecha(menu->fecha, textoFecha), menu->numAlimentos);
+                }
+                else
+                {
+                    printf("\nMenú no encontrado.\n");
+                }
+                break;
+            }
+            case 4:
             {
                 printf("\nVolviendo al menú anterior...\n");
                 break;
@@ -473,7 +646,7 @@ void menuOpcionesAvanzadasMenus(MenuHashTable *tablaMenus)
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
-    }while(opcion!=3);
+    }while(opcion!=4);
 }
 
 /**
@@ -485,7 +658,8 @@ void menuOpcionesAvanzadasMenus(MenuHashTable *tablaMenus)
 void menuGesMenus()
 {
     int opcion, idMenu, numAlimentos, alimentos[50];
-    char fecha[11];
+    char textoFecha[32];
+    Fecha fecha;
     Menu *menu;
 
     do{
@@ -507,7 +681,12 @@ void menuGesMenus()
                 printf("Ingrese el ID del Menú: ");
     			scanf("%d", &idMenu);
     			printf("Ingrese la Fecha del Menú (YYYY-MM-DD): ");
-    			scanf("%s", fecha);
+    			scanf("%31s", textoFecha);
+    			if (!leerFechaTexto(textoFecha, &fecha))
+    			{
+    			    printf("\nError: Fecha no válida. Use el formato YYYY-MM-DD.\n");
+    			    break;
+    			}
     			printf("Ingrese el Número de Alimentos: ");
     			scanf("%d", &numAlimentos);
 
@@ -549,7 +728,7 @@ void menuGesMenus()
                 if(menu) 
                 {
                     printf("\nMenú encontrado: ID=%d, Fecha=%s, Número de Alimentos=%d\n",
-                           menu->idMenu, menu->fecha, menu->numAlimentos);
+                           menu->idMenu, formatearFecha(menu->fecha, textoFecha), menu->numAlimentos);
                 } 
                 else 
                 {
@@ -572,7 +751,12 @@ void menuGesMenus()
                 printf("Ingrese el ID del Menú: ");
     			scanf("%d", &idMenu);
     			printf("Ingrese la Nueva Fecha del Menú (YYYY-MM-DD): ");
-   	 			scanf("%s", fecha);
+   	 			scanf("%31s", textoFecha);
+   	 			if (!leerFechaTexto(textoFecha, &fecha))
+   	 			{
+   	 			    printf("\nError: Fecha no válida. Use el formato YYYY-MM-DD.\n");
+   	 			    break;
+   	 			}
     			printf("Ingrese el Nuevo Número de Alimentos: ");
     			scanf("%d", &numAlimentos);
     			for (int i = 0; i < numAlimentos; i++) 
@@ -605,6 +789,7 @@ void menuGesMenus()
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
+        confirmarBitacora(); // Los cambios de esta opción quedan en disco antes de mostrar el menú otra vez
     }while(opcion!=7);
 }
 
@@ -612,7 +797,7 @@ void menuGesMenus()
  * @brief Opciones avanzadas del menú de alimentos.
  *
  * Proporciona funciones para ordenar alimentos utilizando QuickSort paralelizado
- * y búsqueda binaria paralelizada.
+ * y búsqueda binaria paralelizada, además de búsqueda con un índice estático en orden de B-tree.
  *
  * @param tablaAlimentos Puntero a la tabla hash de alimentos.
  */
@@ -624,7 +809,8 @@ void menuOpcionesAvanzadasAlimentos(HashTable *tablaAlimentos)
         printf("\n--- Opciones Avanzadas: Alimentos ---\n");
         printf("1. Ordenar Alimentos (QuickSort Paralelizado)\n");
         printf("2. Buscar Alimento (Búsqueda Binaria Paralelizada)\n");
-        printf("3. Volver\n");
+        printf("3. Buscar Alimento (Índice Estático B-tree SIMD)\n");
+        printf("4. Volver\n");
         printf("Seleccione una opción: ");
         scanf("%d", &opcion);
 
@@ -642,7 +828,7 @@ void menuOpcionesAvanzadasAlimentos(HashTable *tablaAlimentos)
                 for(int i = 0; i < numAlimentos; i++) 
                 {
                     printf("[ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s]\n",
-                           alimentos[i].id, alimentos[i].nombre, alimentos[i].precio,
+                           alimentos[i].id, textoCadena(alimentos[i].nombre), alimentos[i].precio,
                            alimentos[i].disponible ? "Sí" : "No");
                 }
 
@@ -666,7 +852,7 @@ void menuOpcionesAvanzadasAlimentos(HashTable *tablaAlimentos)
                 if(resultado != -1) 
                 {
                     printf("\nAlimento encontrado: [ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s]\n",
-                           alimentos[resultado].id, alimentos[resultado].nombre, alimentos[resultado].precio,
+                           alimentos[resultado].id, textoCadena(alimentos[resultado].nombre), alimentos[resultado].precio,
                            alimentos[resultado].disponible ? "Sí" : "No");
                 } 
                 else 
@@ -678,6 +864,37 @@ void menuOpcionesAvanzadasAlimentos(HashTable *tablaAlimentos)
                 break;
             }
             case 3:
+            {
+                // El índice se construye una vez y queda en la tabla hasta el siguiente cambio
+                IndiceBusqueda *indice = indiceIdsAlimentos(tablaAlimentos);
+
+                int idBuscado;
+                printf("Ingrese el ID del alimento a buscar: ");
+                scanf("%d", &idBuscado);
+
+                int idEncontrado;
+                Alimento *alimento = indice && indiceSiguienteClave(indice, idBuscado, &idEncontrado)
+                                     ? buscarAlimento(tablaAlimentos, idEncontrado) : NULL;
+
+                if(alimento && alimento->id == idBuscado)
+                {
+                    printf("\nAlimento encontrado: [ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s]\n",
+                           alimento->id, textoCadena(alimento->nombre), alimento->precio,
+                           alimento->disponible ? "Sí" : "No");
+                }
+                else if(alimento)
+                {
+                    printf("\nAlimento no encontrado. Siguiente ID mayor: [ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s]\n",
+                           alimento->id, textoCadena(alimento->nombre), alimento->precio,
+                           alimento->disponible ? "Sí" : "No");
+                }
+                else
+                {
+                    printf("\nAlimento no encontrado.\n");
+                }
+                break;
+            }
+            case 4:
             {
                 printf("\nVolviendo al menú anterior...\n");
                 break;
@@ -685,7 +902,7 @@ void menuOpcionesAvanzadasAlimentos(HashTable *tablaAlimentos)
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
-    }while(opcion!=3);
+    }while(opcion!=4);
 }
 
 /**
@@ -741,7 +958,7 @@ void menuGesAlimentos()
                 if(alimento) 
                 {
                     printf("\nEncontrado: ID=%d, Nombre=%s, Precio=%.2f, Disponible=%s\n",
-                           alimento->id, alimento->nombre, alimento->precio, alimento->disponible ? "Sí" : "No");
+                           alimento->id, textoCadena(alimento->nombre), alimento->precio, alimento->disponible ? "Sí" : "No");
                 } 
                 else
                 {
@@ -791,9 +1008,181 @@ void menuGesAlimentos()
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
+        confirmarBitacora(); // Los cambios de esta opción quedan en disco antes de mostrar el menú otra vez
     }while(opcion!=7);
 }
 
+/**
+ * @brief Importa alimentos, clientes o pedidos desde un archivo CSV o JSON Lines.
+ *
+ * Los formatos aceptados se describen en importacion.h.
+ */
+void menuImportar()
+{
+    int tipo;
+    do
+    {
+        printf("\n¿Qué desea importar?\n");
+        printf("1. Alimentos (id, nombre, precio, disponible)\n");
+        printf("2. Clientes (id, nombre, telefono)\n");
+        printf("3. Pedidos (id, cliente_id, fecha, estado, menus)\n");
+        printf("Seleccione una opción: ");
+        if (scanf("%d", &tipo) != 1)
+        {
+            while (getchar() != '\n'); // Descartar entrada inválida
+            tipo = 0;
+        }
+    } while (tipo < 1 || tipo > 3);
+
+    char nombreArchivo[100];
+    printf("\nIngrese el nombre del archivo a importar (por ejemplo, pedidos.csv o pedidos.jsonl): ");
+    scanf("%s", nombreArchivo);
+    ResultadoImportacion resultado;
+    TipoImportacion tabla = tipo == 1 ? IMPORTAR_ALIMENTOS : tipo == 2 ? IMPORTAR_CLIENTES : IMPORTAR_PEDIDOS;
+    if (importarArchivo(nombreArchivo, tabla, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, &resultado))
+    {
+        imprimirResultadoImportacion(nombreArchivo, &resultado);
+    }
+    confirmarBitacora(); // Lo importado queda en disco antes de mostrar el menú otra vez
+}
+
+/**
+ * @brief Muestra, guarda o reinicia los histogramas de latencia de las operaciones.
+ *
+ * Solo hay mediciones si el programa se compiló con -DMETRICAS_LATENCIA (ver latencias.h).
+ */
+void menuLatencias()
+{
+    int opcion;
+    do
+    {
+        printf("\n--- Latencias de las operaciones ---\n");
+        printf("1. Mostrar percentiles\n");
+        printf("2. Guardar en archivo CSV\n");
+        printf("3. Reiniciar\n");
+        printf("4. Volver\n");
+        printf("Seleccione una opción: ");
+        if (scanf("%d", &opcion) != 1)
+        {
+            while (getchar() != '\n'); // Descartar entrada inválida
+            opcion = 0;
+        }
+
+        switch (opcion)
+        {
+            case 1:
+                imprimirLatencias();
+                break;
+            case 2:
+            {
+                char nombreArchivo[100];
+                printf("\nIngrese el nombre del archivo CSV (por ejemplo, latencias.csv): ");
+                scanf("%s", nombreArchivo);
+                if (guardarLatencias(nombreArchivo))
+                {
+                    printf("\nLatencias guardadas en %s\n", nombreArchivo);
+                }
+                break;
+            }
+            case 3:
+                reiniciarLatencias();
+                printf("\nHistogramas de latencia en cero.\n");
+                break;
+            case 4:
+                break;
+            default:
+                printf("\nOpción no válida. Intente de nuevo.\n");
+        }
+    } while (opcion != 4);
+}
+
+/**
+ * @brief Muestra cuánta memoria usan las tablas, su holgura y el ahorro de un diseño compacto.
+ *
+ * Los contadores y el reporte se describen en contabilidad_memoria.h y reporte_memoria.h.
+ */
+void menuMemoria()
+{
+    int opcion;
+    do
+    {
+        printf("\n--- Memoria de las tablas ---\n");
+        printf("1. Mostrar reporte\n");
+        printf("2. Comparar con registros compactos\n");
+        printf("3. Reiniciar picos\n");
+        printf("4. Volver\n");
+        printf("Seleccione una opción: ");
+        if (scanf("%d", &opcion) != 1)
+        {
+            while (getchar() != '\n'); // Descartar entrada inválida
+            opcion = 0;
+        }
+
+        switch (opcion)
+        {
+            case 1:
+            case 2:
+                imprimirReporteMemoria(tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, opcion == 2);
+                break;
+            case 3:
+                reiniciarPicosMemoria();
+                printf("\nPicos de memoria reiniciados a los bytes vivos actuales.\n");
+                break;
+            case 4:
+                break;
+            default:
+                printf("\nOpción no válida. Intente de nuevo.\n");
+        }
+    } while (opcion != 4);
+}
+
+/**
+ * @brief Calcula los reportes de ventas y los muestra o los guarda en CSV.
+ *
+ * Cada opción recalcula los reportes con los datos actuales (ver reportes_ventas.h).
+ */
+void menuReportesVentas()
+{
+    int opcion;
+    do
+    {
+        printf("\n--- Reportes de ventas ---\n");
+        printf("1. Mostrar reportes\n");
+        printf("2. Guardar en archivo CSV\n");
+        printf("3. Volver\n");
+        printf("Seleccione una opción: ");
+        if (scanf("%d", &opcion) != 1)
+        {
+            while (getchar() != '\n'); // Descartar entrada inválida
+            opcion = 0;
+        }
+
+        switch (opcion)
+        {
+            case 1:
+            case 2:
+            {
+                char nombreArchivo[100];
+                if (opcion == 2)
+                {
+                    printf("\nIngrese el nombre del archivo CSV (por ejemplo, ventas.csv): ");
+                    scanf("%s", nombreArchivo);
+                }
+                ReporteVentas reporte;
+                if (!calcularReportesVentas(tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, &reporte)) break;
+                if (opcion == 1) imprimirReportesVentas(&reporte, 10);
+                else guardarReportesVentas(&reporte, nombreArchivo);
+                liberarReportesVentas(&reporte);
+                break;
+            }
+            case 3:
+                break;
+            default:
+                printf("\nOpción no válida. Intente de nuevo.\n");
+        }
+    } while (opcion != 3);
+}
+
 /**
  * @brief Menú principal para el administrador.
  *
@@ -809,7 +1198,11 @@ void menuAdministrador()
         printf("2. Gestionar Menús\n");
         printf("3. Gestionar Clientes\n");
         printf("4. Gestionar Pedidos\n");
-        printf("5. Volver al menú principal\n");
+        printf("5. Importar archivo (CSV o JSON Lines)\n");
+        printf("6. Latencias de las operaciones\n");
+        printf("7. Memoria de las tablas\n");
+        printf("8. Reportes de ventas\n");
+        printf("9. Volver al menú principal\n");
         printf("Seleccione una opción: ");
         scanf("%d", &opcion);
 
@@ -840,6 +1233,30 @@ void menuAdministrador()
             	break;
             }
             case 5:
+            {
+                printf("\nUsted a seleccionado: Importar archivo\n");
+                menuImportar();
+            	break;
+            }
+            case 6:
+            {
+                printf("\nUsted a seleccionado: Latencias de las operaciones\n");
+                menuLatencias();
+            	break;
+            }
+            case 7:
+            {
+                printf("\nUsted a seleccionado: Memoria de las tablas\n");
+                menuMemoria();
+            	break;
+            }
+            case 8:
+            {
+                printf("\nUsted a seleccionado: Reportes de ventas\n");
+                menuReportesVentas();
+            	break;
+            }
+            case 9:
             {
             	printf("\nUsted a seleccionado: Volver al menú principal\n");
                 printf("Volviendo al menú principal...\n");
@@ -848,7 +1265,7 @@ void menuAdministrador()
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
-    }while(opcion!=5);
+    }while(opcion!=9);
 }
 
 /**
@@ -863,7 +1280,8 @@ void menuCliente()
     int idPedido;                  // ID del pedido
     int numMenus;                  // Número de menús en un pedido
     int menus[50];                 // IDs de menús
-    char fecha[11];                // Fecha del pedido (YYYY-MM-DD)
+    char textoFecha[32];           // Fecha del pedido como se escribe (YYYY-MM-DD)
+    Fecha fecha;                   // Fecha del pedido (ver fechas.h)
     Pedido *pedido;
 
     do{
@@ -900,7 +1318,12 @@ void menuCliente()
     			printf("Ingrese ID del Pedido: ");
     			scanf("%d", &idPedido);
     			printf("Ingrese la Fecha del Pedido (YYYY-MM-DD): ");
-    			scanf("%s", fecha);
+    			scanf("%31s", textoFecha);
+    			if (!leerFechaTexto(textoFecha, &fecha))
+    			{
+    			    printf("\nError: Fecha no válida. Use el formato YYYY-MM-DD.\n");
+    			    break;
+    			}
     			printf("Ingrese el Número de Menús que desea: ");
     			scanf("%d", &numMenus);
 
@@ -939,11 +1362,16 @@ void menuCliente()
     			if(pedido) 
     			{
         			printf("Pedido encontrado: ID=%d, Cliente=%d, Fecha=%s, Estado=%s, Número de Menús=%d\n",
-               			pedido->idPedido, pedido->idCliente, pedido->fecha, pedido->estado, pedido->numMenus);
+               			pedido->idPedido, pedido->idCliente, formatearFecha(pedido->fecha, textoFecha), pedido->estado, pedido->numMenus);
         			for(int i = 0; i < pedido->numMenus; i++)
         			{
             			printf(" - Menú ID: %d\n", pedido->menus[i]);
         			}
+        			double total;
+        			if(calcularTotalPedido(idPedido, &total))
+        			{
+            			printf("Total: %.2f\n", total);
+        			}
     			} 
     			else 
     			{
@@ -960,125 +1388,269 @@ void menuCliente()
             default:
                 printf("\nOpción no válida. Intente de nuevo.\n");
         }
+        confirmarBitacora(); // Los cambios de esta opción quedan en disco antes de mostrar el menú otra vez
     }while(opcion!=4);
 }
 
 /**
- * @brief Genera datos aleatorios para las tablas de alimentos, menús, clientes y pedidos.
+ * @brief Pide las cantidades y la semilla al usuario y reemplaza las tablas con datos generados.
+ *
+ * La misma semilla genera siempre los mismos datos (ver datos_aleatorios.h).
  *
  * @param tablaAlimentos Puntero a la tabla hash de alimentos.
  * @param tablaMenus Puntero a la tabla hash de menús.
  * @param tablaClientes Puntero a la tabla hash de clientes.
  * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si se generaron los datos, `false` si la entrada no es válida o no hubo memoria.
  */
-void generarDatosAleatorios(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes, PedidosHashTable *tablaPedidos)
+bool generarDatosAleatorios(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, ClientesHashTable *tablaClientes, PedidosHashTable *tablaPedidos)
 {
-    srand(time(NULL));
-
     int cantidadAlimentos, cantidadClientes, cantidadMenus, cantidadPedidos;
+    unsigned long long semilla;
 
-    printf("\nIngrese la cantidad de alimentos a generar: ");
-    scanf("%d", &cantidadAlimentos);
+    printf("\nLos datos actuales se reemplazarán.\n");
+    printf("Ingrese la cantidad de alimentos a generar: ");
+    bool valido = scanf("%d", &cantidadAlimentos) == 1;
 
     printf("Ingrese la cantidad de clientes a generar: ");
-    scanf("%d", &cantidadClientes);
+    valido = valido && scanf("%d", &cantidadClientes) == 1;
 
     printf("Ingrese la cantidad de menús a generar: ");
-    scanf("%d", &cantidadMenus);
+    valido = valido && scanf("%d", &cantidadMenus) == 1;
 
     printf("Ingrese la cantidad de pedidos a generar: ");
-    scanf("%d", &cantidadPedidos);
+    valido = valido && scanf("%d", &cantidadPedidos) == 1;
 
-    // Generar alimentos aleatorios
-    for (int i = 1; i <= cantidadAlimentos; i++)
-    {
-        char nombre[50];
-        sprintf(nombre, "Alimento%d", i); // Generar nombre como "Alimento1", "Alimento2", etc.
-        float precio = (rand() % 10000) / 100.0; // Precio entre 0.00 y 99.99
-        const char *disponible = (rand() % 2 == 0) ? "Si" : "Si";
-        insertarAlimento(tablaAlimentos, i, nombre, precio, disponible);
-    }
+    printf("Ingrese la semilla (la misma semilla genera los mismos datos; por ejemplo, %llu): ", GENERACION_SEMILLA_POR_OMISION);
+    valido = valido && scanf("%llu", &semilla) == 1;
 
-    // Generar clientes aleatorios
-    for (int i = 1; i <= cantidadClientes; i++)
+    if (!valido)
     {
-        char nombre[50];
-        sprintf(nombre, "Cliente%d", i); // Generar nombre como "Cliente1", "Cliente2", etc.
-        char telefono[15];
-        sprintf(telefono, "55%06d", rand() % 100000); // Teléfono como "555-1234"
-        agregarCliente(tablaClientes, i, nombre, telefono);
+        while (getchar() != '\n'); // Descartar entrada inválida
+        printf("\nError: Entrada inválida.\n");
+        return false;
     }
 
-    // Generar menús aleatorios
-    for (int i = 1; i <= cantidadMenus; i++)
+    double inicio = omp_get_wtime();
+    if (!generarDatos(tablaAlimentos, tablaMenus, tablaClientes, tablaPedidos, cantidadAlimentos, cantidadClientes,
+                      cantidadMenus, cantidadPedidos, semilla))
     {
-        char fecha[11];
-        sprintf(fecha, "2024-%02d-%02d", (rand() % 12) + 1, (rand() % 28) + 1); // Fecha aleatoria en 2024
-
-        int numAlimentos = (rand() % 3) + 1; // Entre 1 y 5 alimentos
-        int alimentos[5];
-        for(int j = 0; j < numAlimentos; j++)
-        {
-            alimentos[j] = (rand() % cantidadAlimentos) + 1; // IDs de alimentos entre 1 y la cantidad generada
-        }
-
-        agregarMenu(tablaMenus, i, fecha, alimentos, numAlimentos, tablaAlimentos);
+        return false;
     }
 
-    // Generar pedidos aleatorios
-    for(int i = 1; i <= cantidadPedidos; i++)
-    {
-        char fecha[11];
-        sprintf(fecha, "2024-%02d-%02d", (rand() % 12) + 1, (rand() % 28) + 1); // Fecha aleatoria en 2024
+    printf("\nDatos aleatorios generados exitosamente en %.3f segundos:\n", omp_get_wtime() - inicio);
+    printf("- %d alimentos\n", obtenerNumeroDeAlimentos(tablaAlimentos));
+    printf("- %d clientes\n", obtenerNumeroDeClientes(tablaClientes));
+    printf("- %d menús\n", obtenerNumeroDeMenus(tablaMenus));
+    printf("- %d pedidos\n", obtenerNumeroDePedidos(tablaPedidos));
+    return true;
+}
 
-        int idCliente = (rand() % cantidadClientes) + 1; // ID de cliente entre 1 y la cantidad generada
-        int numMenus = (rand() % 3) + 1;  // Entre 1 y 3 menús
-        int menus[3];
-        for(int j = 0; j < numMenus; j++)
+/**
+ * @brief Pregunta al usuario el formato del archivo para guardar o cargar datos.
+ * @param guardar `true` si es para guardar (ofrece además el guardado en segundo plano).
+ * @return 1 para YAML (texto), 2 para snapshot binario, 3 para snapshot incremental, 4 para YAML normalizado,
+ *         5 para YAML en segundo plano.
+ */
+int seleccionarFormatoArchivo(bool guardar)
+{
+    int formato;
+    int maximo = guardar ? 5 : 4;
+    do
+    {
+        printf("\nFormato del archivo:\n");
+        printf("1. YAML (texto legible)\n");
+        printf("2. Snapshot binario (carga rápida)\n");
+        printf("3. Snapshot incremental (solo los cambios desde el último guardado)\n");
+        printf("4. YAML normalizado (los menús solo guardan los IDs de sus alimentos)\n");
+        if (guardar) printf("5. YAML en segundo plano (las operaciones no se detienen mientras se escribe)\n");
+        printf("Seleccione una opción: ");
+        if (scanf("%d", &formato) != 1)
         {
-            menus[j] = (rand() % cantidadMenus) + 1; // IDs de menús entre 1 y la cantidad generada
+            while (getchar() != '\n'); // Descartar entrada inválida
+            formato = 0;
         }
+    } while (formato < 1 || formato > maximo);
+    return formato;
+}
 
-        const char *estado;
-        switch (rand() % 3)
-        {
-            case 0: estado = "Pendiente"; break;
-            case 1: estado = "En Proceso"; break;
-            default: estado = "Completado"; break;
-        }
+/**
+ * @brief Verifica las referencias entre tablas después de una carga e informa las rotas.
+ *
+ * Las cargas insertan sin validar cada registro; esta pasada única reemplaza esas
+ * comprobaciones (ver integridad_referencial.h).
+ */
+void verificarIntegridadCargada()
+{
+	ReporteIntegridad reporte;
+	validarIntegridad(tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, &reporte);
+	imprimirReporteIntegridad(&reporte);
+}
 
-        agregarPedido(tablaPedidos, tablaMenus, tablaClientes, i, idCliente, fecha, menus, numMenus, estado);
-    }
+/**
+ * @brief Ejecuta un guion de comandos sin menús (ver modo_lote.h).
+ *
+ * Uso: `salidaPF.out --lote [ARCHIVO] [--resumen] [--sin-bitacora]`. Sin archivo (o con `-`)
+ * el guion se lee de la entrada estándar. `--resumen` omite la línea de cada comando y
+ * `--sin-bitacora` no recupera ni registra cambios en la base de datos (para pruebas de carga).
+ *
+ * @param argc Número de argumentos del programa.
+ * @param argv Argumentos del programa; `argv[1]` es `--lote`.
+ * @return 0 si se ejecutó el guion, 1 si no se pudo abrir.
+ */
+int ejecutarModoLote(int argc, char *argv[])
+{
+	const char *nombreGuion = "-";
+	bool detalle = true, conBitacora = true;
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--resumen") == 0) detalle = false;
+		else if (strcmp(argv[i], "--sin-bitacora") == 0) conBitacora = false;
+		else nombreGuion = argv[i];
+	}
+
+	FILE *guion = strcmp(nombreGuion, "-") == 0 ? stdin : fopen(nombreGuion, "r");
+	if (!guion)
+	{
+		printf("\nError: No se pudo abrir el guion '%s'.\n", nombreGuion);
+		return 1;
+	}
+	if (conBitacora && !iniciarBitacora(NOMBRE_BASE_DATOS, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos))
+	{
+		printf("\nAdvertencia: La bitácora está desactivada; los cambios del guion no se guardarán automáticamente.\n");
+	}
+
+	ResultadoLote resultado;
+	ejecutarLote(guion, detalle, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, &resultado);
+	imprimirResumenLote(&resultado);
+
+	if (guion != stdin) fclose(guion);
+	cerrarBitacora();
+	liberarTablaMenus(tablaMenus);
+	liberarTabla(tablaAlimentos);
+	liberarTablaClientes(tablaClientes);
+	liberarTablaPedidos(tablaPedidos);
+	cerrarPoolTareas();
+	return 0;
+}
 
-    printf("\nDatos aleatorios generados exitosamente:\n");
-    printf("- %d alimentos\n", cantidadAlimentos);
-    printf("- %d clientes\n", cantidadClientes);
-    printf("- %d menús\n", cantidadMenus);
-    printf("- %d pedidos\n", cantidadPedidos);
+/**
+ * @brief Atiende peticiones por un socket en lugar de los menús (ver servidor.h).
+ *
+ * Uso: `salidaPF.out --servidor DIRECCION [--sin-bitacora] [--permitir-remoto]`, donde
+ * DIRECCION es `unix:RUTA` o `tcp:[HOST:]PUERTO`. Por TCP solo se acepta un host de
+ * loopback, salvo con `--permitir-remoto`. El servidor termina con la petición `apagar`,
+ * Ctrl+C o SIGTERM.
+ *
+ * @param argc Número de argumentos del programa.
+ * @param argv Argumentos del programa; `argv[1]` es `--servidor`.
+ * @return 0 si el servidor terminó normalmente, 1 si no se pudo escuchar en la dirección.
+ */
+int ejecutarModoServidor(int argc, char *argv[])
+{
+	const char *direccion = NULL;
+	bool conBitacora = true;
+	bool permitirRemoto = false;
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--sin-bitacora") == 0) conBitacora = false;
+		else if (strcmp(argv[i], "--permitir-remoto") == 0) permitirRemoto = true;
+		else direccion = argv[i];
+	}
+	if (!direccion)
+	{
+		printf("\nError: Falta la dirección del servidor (unix:RUTA o tcp:[HOST:]PUERTO).\n");
+		return 1;
+	}
+	if (conBitacora && !iniciarBitacora(NOMBRE_BASE_DATOS, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos))
+	{
+		printf("\nAdvertencia: La bitácora está desactivada; los cambios recibidos no se guardarán automáticamente.\n");
+	}
+	if (tablaMenus->numMenus > 0 || tablaPedidos->numPedidos > 0)
+	{
+		verificarIntegridadCargada();
+	}
+
+	printf("\nServidor escuchando en %s (termine con la petición 'apagar' o Ctrl+C).\n", direccion);
+	fflush(stdout);
+	ResultadoServidor resultado;
+	bool correcto = ejecutarServidor(direccion, permitirRemoto, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, &resultado);
+	if (correcto)
+	{
+		printf("\nServidor detenido: %lld conexiones, %lld peticiones (%lld con error) en %.3f s.\n",
+			   resultado.conexiones, resultado.peticiones, resultado.errores, resultado.segundos);
+	}
+
+	cerrarBitacora();
+	liberarTablaMenus(tablaMenus);
+	liberarTabla(tablaAlimentos);
+	liberarTablaClientes(tablaClientes);
+	liberarTablaPedidos(tablaPedidos);
+	cerrarPoolTareas();
+	return correcto ? 0 : 1;
 }
 
 /**
  * @brief Función principal del programa.
  *
  * Permite al usuario seleccionar entre varias opciones de gestión como administrador o cliente,
- * y realizar operaciones como guardar, cargar o generar datos.
+ * y realizar operaciones como guardar, cargar o generar datos. Con `--lote` ejecuta un guion
+ * de comandos en lugar de los menús (ver ejecutarModoLote), y con `--servidor` atiende
+ * peticiones por un socket (ver ejecutarModoServidor). `--hilos N`, antes de cualquier
+ * otro argumento, fija los hilos del pool de tareas y de OpenMP.
  *
+ * @param argc Número de argumentos del programa.
+ * @param argv Argumentos del programa.
  * @return int Devuelve 0 al finalizar la ejecución correctamente.
  */
-int main()
+int main(int argc, char *argv[])
 {
 	tablaAlimentos = crearTablaHash();
 	tablaMenus = crearTablaMenus();
 	tablaClientes = crearTablaClientes();
 	tablaPedidos = crearTablaPedidos();
+	usarTablasTotales(tablaAlimentos, tablaMenus, tablaPedidos);
 	int opcion;
 
+	if (argc >= 2 && strcmp(argv[1], "--hilos") == 0)
+	{
+		int numHilos = argc >= 3 ? atoi(argv[2]) : 0;
+		if (numHilos < 1)
+		{
+			printf("\nError: --hilos necesita un número de hilos mayor que cero.\n");
+			return 1;
+		}
+		omp_set_num_threads(numHilos);
+		iniciarPoolTareas(numHilos);
+		argv[2] = argv[0]; // El resto de los argumentos se lee como si --hilos no estuviera
+		argv += 2;
+		argc -= 2;
+	}
+	if (argc >= 2 && strcmp(argv[1], "--lote") == 0)
+	{
+		return ejecutarModoLote(argc, argv);
+	}
+	if (argc >= 2 && strcmp(argv[1], "--servidor") == 0)
+	{
+		return ejecutarModoServidor(argc, argv);
+	}
+
+	if (!iniciarBitacora(NOMBRE_BASE_DATOS, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos))
+	{
+		printf("\nAdvertencia: La bitácora está desactivada; los cambios de esta sesión no se guardarán automáticamente.\n");
+	}
+	if (tablaMenus->numMenus > 0 || tablaPedidos->numPedidos > 0)
+	{
+		verificarIntegridadCargada(); // La recuperación restaura registros sin validarlos
+	}
+
 	do{
+        revisarGuardadoSegundoPlano(false, NULL); // Informa si terminó un guardado en segundo plano
         printf("\n--- Sistema de Gestión de Pedidos ---\n");
         printf("1. Entrar como Administrador\n");
         printf("2. Entrar como Cliente\n");
         printf("3. Guardar todos los datos actuales (serializar)\n");
-        printf("4. Cargar datos (deserializar)\n"); //Aun no funciona
+        printf("4. Cargar datos (deserializar)\n");
         printf("5. Generar Datos Aleatorios\n");
         printf("6. Salir\n");
         printf("Seleccione una opción: ");
@@ -1101,44 +1673,104 @@ int main()
             case 3:
             {
                 printf("\nUsted a seleccionado: Guardar todos los datos actuales\n");
+                int formato = seleccionarFormatoArchivo(true);
                 char nombreArchivo[100];
+                if (formato == 5) {
+                    printf("\nIngrese el nombre del archivo para guardar los datos (incluya la extensión, por ejemplo, datos.yaml): ");
+                    scanf("%s", nombreArchivo);
+                    double pausa;
+                    if (iniciarGuardadoSegundoPlano(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, &pausa)) {
+                        printf("\nGuardado en segundo plano iniciado (pausa de %.0f µs); puede seguir trabajando.\n", pausa * 1e6);
+                    }
+                    break;
+                }
+                if (formato == 3) {
+                    printf("\nIngrese el nombre del snapshot base (incluya la extensión, por ejemplo, datos.bin): ");
+                    scanf("%s", nombreArchivo);
+                    double inicio = omp_get_wtime();
+                    if (guardarSnapshotDelta(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos)) {
+                        printf("\nTiempo de guardado: %.3f segundos\n", omp_get_wtime() - inicio);
+                    }
+                    break;
+                }
+                if (formato == 2) {
+                    printf("\nIngrese el nombre del archivo para guardar los datos (incluya la extensión, por ejemplo, datos.bin): ");
+                    scanf("%s", nombreArchivo);
+                    double inicio = omp_get_wtime();
+                    if (guardarSnapshotBinario(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos)) {
+                        printf("\nTiempo de guardado: %.3f segundos\n", omp_get_wtime() - inicio);
+                    }
+                    break;
+                }
                 printf("\nIngrese el nombre del archivo para guardar los datos (incluya la extensión, por ejemplo, datos.yaml): ");
                 scanf("%s", nombreArchivo);
-                serializarDatos(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+                if (formato == 4) {
+                    serializarDatosNormalizados(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+                } else {
+                    serializarDatos(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+                }
                 printf("\nDatos guardados en '%s'.\n", nombreArchivo);
                 break;
             }
             case 4:
             {
                 printf("\nUsted a seleccionado: Cargar datos\n");
-                printf("\nFunción aún no disponible\n");
-                /*
-                    No pude terminar la deserialización. La dejo aqui con fines
-                    propios, por lo que le pido que no la tome encuenta como parte
-                    de la entrega final de mi proyecto.
-                */
-                /*
+                int formato = seleccionarFormatoArchivo(false);
+                if (formato == 3) {
+                    char nombreArchivo[100];
+                    printf("\nIngrese el nombre del snapshot base a cargar (se aplican sus deltas; los datos actuales se reemplazarán): ");
+                    scanf("%s", nombreArchivo);
+                    double inicio = omp_get_wtime();
+                    if (cargarSnapshotDelta(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos)) {
+                        printf("\nTiempo de carga: %.3f segundos\n", omp_get_wtime() - inicio);
+                        verificarIntegridadCargada();
+                        puntoDeControlBitacora(); // La carga no pasa por la bitácora
+                    }
+                    break;
+                }
+                if (formato == 2) {
+                    char nombreArchivo[100];
+                    printf("\nIngrese el nombre del snapshot binario a cargar (los datos actuales se reemplazarán): ");
+                    scanf("%s", nombreArchivo);
+                    double inicio = omp_get_wtime();
+                    if (cargarSnapshotBinario(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos)) {
+                        printf("\nTiempo de carga: %.3f segundos\n", omp_get_wtime() - inicio);
+                        verificarIntegridadCargada();
+                        puntoDeControlBitacora(); // La carga no pasa por la bitácora
+                    }
+                    break;
+                }
                 char nombreArchivo[100];
-                printf("\nIngrese el nombre del archivo YAML a cargar (incluya la extensión, por ejemplo, datos.yaml): ");
+                printf("\nIngrese el nombre del archivo YAML a cargar (los datos actuales se reemplazarán, por ejemplo, datos.yaml): ");
                 scanf("%s", nombreArchivo);
-                deserializarDatos(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
-                printf("\nDatos cargados desde '%s'.\n", nombreArchivo);
-                */
+                double inicio = omp_get_wtime();
+                if (deserializarDatos(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos)) {
+                    printf("\nDatos cargados desde '%s'.\n", nombreArchivo);
+                    printf("\nTiempo de carga: %.3f segundos\n", omp_get_wtime() - inicio);
+                    verificarIntegridadCargada();
+                    puntoDeControlBitacora(); // La carga no pasa por la bitácora
+                }
                 break;
             }
             case 5:
             {
                 printf("\nUsted ha seleccionado: Generar Datos Aleatorios\n");
-                generarDatosAleatorios(tablaAlimentos, tablaMenus, tablaClientes, tablaPedidos);
+                if (generarDatosAleatorios(tablaAlimentos, tablaMenus, tablaClientes, tablaPedidos))
+                {
+                    puntoDeControlBitacora(); // La generación no pasa por la bitácora
+                }
                 break;
             }
             case 6:
             {
                 printf("\nSaliendo del sistema...\n");
+                revisarGuardadoSegundoPlano(true, NULL);
+                cerrarBitacora();
                 liberarTablaMenus(tablaMenus);
                 liberarTabla(tablaAlimentos);
                 liberarTablaClientes(tablaClientes);
                 liberarTablaPedidos(tablaPedidos);
+                cerrarPoolTareas();
                 break;
             }
             default:
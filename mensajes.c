@@ -0,0 +1,8 @@
+/**
+ * @file mensajes.c
+ * @brief Estado global de los mensajes de las operaciones sobre las tablas.
+ */
+
+#include "mensajes.h"
+
+bool mensajesActivos = true;
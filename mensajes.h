@@ -0,0 +1,24 @@
+/**
+ * @file mensajes.h
+ * @brief Control de los mensajes que imprimen las operaciones sobre las tablas.
+ *
+ * Las funciones de agregar, eliminar y actualizar informan cada operación en consola.
+ * Las cargas masivas y los benchmarks desactivan esos mensajes para no imprimir
+ * una línea por registro.
+ */
+
+#ifndef MENSAJES_H
+#define MENSAJES_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+/// `true` (valor inicial) si las operaciones de las tablas deben imprimir sus mensajes.
+extern bool mensajesActivos;
+
+/**
+ * @brief Imprime un mensaje de una operación solo si los mensajes están activos.
+ */
+#define MENSAJE(...) do { if (mensajesActivos) printf(__VA_ARGS__); } while (0)
+
+#endif // MENSAJES_H
@@ -0,0 +1,643 @@
+/**
+ * @file modo_lote.c
+ * @brief Implementación del intérprete de guiones de comandos.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <omp.h>
+#include "modo_lote.h"
+#include "serializar_datos.h"
+#include "deserializar_datos.h"
+#include "snapshot_binario.h"
+#include "snapshot_delta.h"
+#include "guardado_segundo_plano.h"
+#include "bitacora.h"
+#include "integridad_referencial.h"
+#include "importacion.h"
+#include "datos_aleatorios.h"
+#include "cocina.h"
+#include "latencias.h"
+#include "reporte_memoria.h"
+#include "totales_pedidos.h"
+#include "reportes_ventas.h"
+#include "fechas.h"
+#include "mensajes.h"
+
+/// Longitud máxima de una línea del guion.
+#define LOTE_MAX_LINEA 4096
+
+/// Texto de cada resultado, en el orden de ResultadoComando.
+const char *const textosResultadoLote[] = { "ok", "no encontrado", "error", "argumentos inválidos" };
+
+/// Nombre de cada comando, en el orden de ComandoLote.
+static const char *const nombresComando[NUM_COMANDOS_LOTE] = {
+    "agregar", "buscar", "eliminar", "actualizar", "ordenar", "guardar", "cargar", "generar", "importar", "confirmar",
+    "cocina", "latencias", "memoria", "total", "reporte"
+};
+
+/**
+ * @brief Tablas sobre las que trabajan los comandos (ver usarTablasLote).
+ */
+static struct {
+    HashTable *alimentos;
+    ClientesHashTable *clientes;
+    MenuHashTable *menus;
+    PedidosHashTable *pedidos;
+} tablas;
+
+/**
+ * @brief Reconoce el nombre de una tabla en singular o plural.
+ * @param nombre Nombre escrito en el comando.
+ * @return La tabla, o TABLA_DESCONOCIDA.
+ */
+TablaLote leerTablaLote(const char *nombre) {
+    if (strcmp(nombre, "alimento") == 0 || strcmp(nombre, "alimentos") == 0) return TABLA_ALIMENTOS;
+    if (strcmp(nombre, "cliente") == 0 || strcmp(nombre, "clientes") == 0) return TABLA_CLIENTES;
+    if (strcmp(nombre, "menu") == 0 || strcmp(nombre, "menus") == 0 ||
+        strcmp(nombre, "menú") == 0 || strcmp(nombre, "menús") == 0) return TABLA_MENUS;
+    if (strcmp(nombre, "pedido") == 0 || strcmp(nombre, "pedidos") == 0) return TABLA_PEDIDOS;
+    return TABLA_DESCONOCIDA;
+}
+
+/**
+ * @brief Separa una línea en argumentos, en el mismo arreglo.
+ * @param linea Línea a separar (se modifica).
+ * @param argumentos Punteros a cada argumento (de salida).
+ * @return Número de argumentos, o -1 si sobran argumentos o falta cerrar una comilla.
+ */
+int separarArgumentosLote(char *linea, char **argumentos) {
+    int numArgumentos = 0;
+    char *p = linea;
+    for (;;) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        if (*p == '\0') return numArgumentos;
+        if (numArgumentos == LOTE_MAX_ARGUMENTOS) return -1;
+        if (*p == '"') {
+            argumentos[numArgumentos++] = ++p;
+            while (*p && *p != '"') p++;
+            if (*p != '"') return -1;
+        } else {
+            argumentos[numArgumentos++] = p;
+            while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') p++;
+            if (*p == '\0') return numArgumentos;
+        }
+        *p++ = '\0';
+    }
+}
+
+/**
+ * @brief Convierte un argumento a ID (entero no negativo, como en la importación).
+ * @param texto Argumento.
+ * @param id Resultado.
+ * @return `true` si el argumento es un ID válido.
+ */
+bool leerIdLote(const char *texto, int *id) {
+    char *fin;
+    long valor = strtol(texto, &fin, 10);
+    if (fin == texto || *fin != '\0' || texto[0] == '-' || valor > 2147483647L) return false;
+    *id = (int)valor;
+    return true;
+}
+
+/**
+ * @brief Convierte un argumento a precio.
+ */
+static bool leerPrecio(const char *texto, float *precio) {
+    char *fin;
+    double valor = strtod(texto, &fin);
+    if (fin == texto || *fin != '\0' || valor != valor) return false;
+    *precio = (float)valor;
+    return true;
+}
+
+/**
+ * @brief Convierte una lista de IDs separados por comas.
+ * @param texto Lista (por ejemplo "1,2,3").
+ * @param ids Arreglo destino de 50 posiciones.
+ * @param numIds Número de IDs leídos (de salida).
+ */
+static bool leerListaIds(const char *texto, int *ids, int *numIds) {
+    char copia[LOTE_MAX_LINEA];
+    if (strlen(texto) >= sizeof(copia)) return false;
+    strcpy(copia, texto);
+    *numIds = 0;
+    for (char *elemento = strtok(copia, ","); elemento; elemento = strtok(NULL, ",")) {
+        if (*numIds == 50 || !leerIdLote(elemento, &ids[*numIds])) return false;
+        (*numIds)++;
+    }
+    return *numIds > 0;
+}
+
+/**
+ * @brief Comprueba que un texto quepa en un campo de `capacidad` bytes (con terminador).
+ */
+static bool cabe(const char *texto, size_t capacidad) {
+    return strlen(texto) < capacidad;
+}
+
+/**
+ * @brief agregar TABLA ...
+ */
+static ResultadoComando comandoAgregar(char **argumentos, int numArgumentos) {
+    int id, ids[50], numIds;
+    float precio;
+    Fecha fecha;
+    switch (numArgumentos > 2 ? leerTablaLote(argumentos[1]) : TABLA_DESCONOCIDA) {
+        case TABLA_ALIMENTOS:
+            if (numArgumentos != 6 || !leerIdLote(argumentos[2], &id) || !cabe(argumentos[3], 50) ||
+                !leerPrecio(argumentos[4], &precio)) return RESULTADO_INVALIDO;
+            return insertarAlimento(tablas.alimentos, id, argumentos[3], precio, argumentos[5]) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_CLIENTES:
+            if (numArgumentos != 5 || !leerIdLote(argumentos[2], &id) || !cabe(argumentos[3], 50) ||
+                !cabe(argumentos[4], 15)) return RESULTADO_INVALIDO;
+            return agregarCliente(tablas.clientes, id, argumentos[3], argumentos[4]) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_MENUS:
+            if (numArgumentos != 5 || !leerIdLote(argumentos[2], &id) || !leerFechaTexto(argumentos[3], &fecha) ||
+                !leerListaIds(argumentos[4], ids, &numIds)) return RESULTADO_INVALIDO;
+            return agregarMenu(tablas.menus, id, fecha, ids, numIds, tablas.alimentos) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_PEDIDOS: {
+            int idCliente;
+            if (numArgumentos != 7 || !leerIdLote(argumentos[2], &id) || !leerIdLote(argumentos[3], &idCliente) ||
+                !leerFechaTexto(argumentos[4], &fecha) || !cabe(argumentos[5], 15) ||
+                !leerListaIds(argumentos[6], ids, &numIds)) return RESULTADO_INVALIDO;
+            if (!agregarPedido(tablas.pedidos, tablas.menus, tablas.clientes, id, idCliente, fecha, ids, numIds,
+                               argumentos[5])) return RESULTADO_ERROR;
+            if (strcmp(argumentos[5], "Pendiente") == 0) encolarPedidoCocina(id); // Sin cocina activa no hace nada
+            return RESULTADO_OK;
+        }
+        default:
+            return RESULTADO_INVALIDO;
+    }
+}
+
+/**
+ * @brief buscar TABLA ID
+ */
+static ResultadoComando comandoBuscar(char **argumentos, int numArgumentos) {
+    int id;
+    if (numArgumentos != 3 || !leerIdLote(argumentos[2], &id)) return RESULTADO_INVALIDO;
+    bool encontrado;
+    switch (leerTablaLote(argumentos[1])) {
+        case TABLA_ALIMENTOS: encontrado = buscarAlimento(tablas.alimentos, id) != NULL; break;
+        case TABLA_CLIENTES: encontrado = buscarCliente(tablas.clientes, id) != NULL; break;
+        case TABLA_MENUS: encontrado = buscarMenuPorID(tablas.menus, id) != NULL; break;
+        case TABLA_PEDIDOS: encontrado = buscarPedido(tablas.pedidos, id) != NULL; break;
+        default: return RESULTADO_INVALIDO;
+    }
+    return encontrado ? RESULTADO_OK : RESULTADO_NO_ENCONTRADO;
+}
+
+/**
+ * @brief eliminar TABLA ID
+ */
+static ResultadoComando comandoEliminar(char **argumentos, int numArgumentos) {
+    int id;
+    if (numArgumentos != 3 || !leerIdLote(argumentos[2], &id)) return RESULTADO_INVALIDO;
+    switch (leerTablaLote(argumentos[1])) {
+        case TABLA_ALIMENTOS:
+            if (!buscarAlimento(tablas.alimentos, id)) return RESULTADO_NO_ENCONTRADO;
+            return eliminarAlimento(tablas.alimentos, id) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_CLIENTES:
+            if (!buscarCliente(tablas.clientes, id)) return RESULTADO_NO_ENCONTRADO;
+            return eliminarCliente(tablas.clientes, id) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_MENUS:
+            if (!buscarMenuPorID(tablas.menus, id)) return RESULTADO_NO_ENCONTRADO;
+            return eliminarMenu(tablas.menus, id) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_PEDIDOS:
+            if (!buscarPedido(tablas.pedidos, id)) return RESULTADO_NO_ENCONTRADO;
+            return eliminarPedido(tablas.pedidos, id) ? RESULTADO_OK : RESULTADO_ERROR;
+        default:
+            return RESULTADO_INVALIDO;
+    }
+}
+
+/**
+ * @brief actualizar TABLA ID ...
+ */
+static ResultadoComando comandoActualizar(char **argumentos, int numArgumentos) {
+    int id, ids[50], numIds;
+    float precio;
+    Fecha fecha;
+    if (numArgumentos < 4 || !leerIdLote(argumentos[2], &id)) return RESULTADO_INVALIDO;
+    switch (leerTablaLote(argumentos[1])) {
+        case TABLA_ALIMENTOS:
+            if (numArgumentos != 6 || !cabe(argumentos[3], 50) || !leerPrecio(argumentos[4], &precio)) return RESULTADO_INVALIDO;
+            if (!buscarAlimento(tablas.alimentos, id)) return RESULTADO_NO_ENCONTRADO;
+            return actualizarAlimento(tablas.alimentos, id, argumentos[3], precio, argumentos[5]) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_CLIENTES:
+            if (numArgumentos != 5 || !cabe(argumentos[3], 50) || !cabe(argumentos[4], 15)) return RESULTADO_INVALIDO;
+            if (!buscarCliente(tablas.clientes, id)) return RESULTADO_NO_ENCONTRADO;
+            return actualizarCliente(tablas.clientes, id, argumentos[3], argumentos[4]) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_MENUS:
+            if (numArgumentos != 5 || !leerFechaTexto(argumentos[3], &fecha) || !leerListaIds(argumentos[4], ids, &numIds)) {
+                return RESULTADO_INVALIDO;
+            }
+            if (!buscarMenuPorID(tablas.menus, id)) return RESULTADO_NO_ENCONTRADO;
+            return actualizarMenu(tablas.menus, id, fecha, ids, numIds) ? RESULTADO_OK : RESULTADO_ERROR;
+        case TABLA_PEDIDOS:
+            if (numArgumentos != 4 || !cabe(argumentos[3], 15)) return RESULTADO_INVALIDO;
+            if (!buscarPedido(tablas.pedidos, id)) return RESULTADO_NO_ENCONTRADO;
+            return actualizarPedido(tablas.pedidos, id, argumentos[3]) ? RESULTADO_OK : RESULTADO_ERROR;
+        default:
+            return RESULTADO_INVALIDO;
+    }
+}
+
+/**
+ * @brief ordenar TABLA: copia la tabla a un arreglo y lo ordena con el QuickSort paralelo.
+ */
+static ResultadoComando comandoOrdenar(char **argumentos, int numArgumentos) {
+    if (numArgumentos != 2) return RESULTADO_INVALIDO;
+    switch (leerTablaLote(argumentos[1])) {
+        case TABLA_ALIMENTOS: {
+            int n = obtenerNumeroDeAlimentos(tablas.alimentos);
+            Alimento *copia = malloc((n > 0 ? n : 1) * sizeof(Alimento));
+            if (!copia) return RESULTADO_ERROR;
+            copiarAlimentosDesdeTabla(tablas.alimentos, copia);
+            quicksortAlimentosParallel(copia, 0, n - 1);
+            free(copia);
+            return RESULTADO_OK;
+        }
+        case TABLA_CLIENTES: {
+            int n = obtenerNumeroDeClientes(tablas.clientes);
+            Cliente *copia = malloc((n > 0 ? n : 1) * sizeof(Cliente));
+            if (!copia) return RESULTADO_ERROR;
+            copiarClientesDesdeTabla(tablas.clientes, copia);
+            quicksortClientesParallel(copia, 0, n - 1);
+            free(copia);
+            return RESULTADO_OK;
+        }
+        case TABLA_MENUS: {
+            int n = obtenerNumeroDeMenus(tablas.menus);
+            Menu *copia = malloc((n > 0 ? n : 1) * sizeof(Menu));
+            if (!copia) return RESULTADO_ERROR;
+            copiarMenusDesdeTabla(tablas.menus, copia);
+            quicksortMenusParallel(copia, 0, n - 1);
+            free(copia);
+            return RESULTADO_OK;
+        }
+        case TABLA_PEDIDOS: {
+            int n = obtenerNumeroDePedidos(tablas.pedidos);
+            Pedido *copia = malloc((n > 0 ? n : 1) * sizeof(Pedido));
+            if (!copia) return RESULTADO_ERROR;
+            copiarPedidosDesdeTabla(tablas.pedidos, copia);
+            quicksortPedidosParallel(copia, 0, n - 1);
+            free(copia);
+            return RESULTADO_OK;
+        }
+        default:
+            return RESULTADO_INVALIDO;
+    }
+}
+
+/**
+ * @brief guardar FORMATO ARCHIVO
+ */
+static ResultadoComando comandoGuardar(char **argumentos, int numArgumentos) {
+    if (numArgumentos != 3) return RESULTADO_INVALIDO;
+    const char *formato = argumentos[1], *nombre = argumentos[2];
+    bool correcto;
+    if (strcmp(formato, "yaml") == 0) {
+        correcto = serializarDatos(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos);
+    } else if (strcmp(formato, "normalizado") == 0) {
+        correcto = serializarDatosNormalizados(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos);
+    } else if (strcmp(formato, "binario") == 0) {
+        correcto = guardarSnapshotBinario(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos);
+    } else if (strcmp(formato, "incremental") == 0) {
+        correcto = guardarSnapshotDelta(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos);
+    } else if (strcmp(formato, "fondo") == 0) {
+        correcto = iniciarGuardadoSegundoPlano(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos, NULL);
+    } else {
+        return RESULTADO_INVALIDO;
+    }
+    return correcto ? RESULTADO_OK : RESULTADO_ERROR;
+}
+
+/**
+ * @brief cargar FORMATO ARCHIVO: reemplaza las tablas y verifica sus referencias.
+ */
+static ResultadoComando comandoCargar(char **argumentos, int numArgumentos) {
+    if (numArgumentos != 3) return RESULTADO_INVALIDO;
+    const char *formato = argumentos[1], *nombre = argumentos[2];
+    bool correcto;
+    if (strcmp(formato, "yaml") == 0 || strcmp(formato, "normalizado") == 0) {
+        correcto = deserializarDatos(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos);
+    } else if (strcmp(formato, "binario") == 0) {
+        correcto = cargarSnapshotBinario(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos);
+    } else if (strcmp(formato, "incremental") == 0) {
+        correcto = cargarSnapshotDelta(nombre, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos);
+    } else {
+        return RESULTADO_INVALIDO;
+    }
+    if (!correcto) return RESULTADO_ERROR;
+    ReporteIntegridad reporte;
+    if (!validarIntegridad(tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos, &reporte)) {
+        imprimirReporteIntegridad(&reporte);
+    }
+    puntoDeControlBitacora(); // La carga no pasa por la bitácora
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief generar ALIMENTOS CLIENTES MENUS PEDIDOS [SEMILLA]
+ */
+static ResultadoComando comandoGenerar(char **argumentos, int numArgumentos) {
+    int cantidades[4], semilla;
+    if (numArgumentos != 5 && numArgumentos != 6) return RESULTADO_INVALIDO;
+    for (int i = 0; i < 4; i++) {
+        if (!leerIdLote(argumentos[i + 1], &cantidades[i])) return RESULTADO_INVALIDO;
+    }
+    if (numArgumentos == 6 && !leerIdLote(argumentos[5], &semilla)) return RESULTADO_INVALIDO;
+    if (!generarDatos(tablas.alimentos, tablas.menus, tablas.clientes, tablas.pedidos, cantidades[0], cantidades[1],
+                      cantidades[2], cantidades[3],
+                      numArgumentos == 6 ? (unsigned long long)semilla : GENERACION_SEMILLA_POR_OMISION)) {
+        return RESULTADO_ERROR;
+    }
+    puntoDeControlBitacora(); // La generación no pasa por la bitácora
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief importar TABLA ARCHIVO
+ */
+static ResultadoComando comandoImportar(char **argumentos, int numArgumentos, bool detalle) {
+    if (numArgumentos != 3) return RESULTADO_INVALIDO;
+    TipoImportacion tipo;
+    switch (leerTablaLote(argumentos[1])) {
+        case TABLA_ALIMENTOS: tipo = IMPORTAR_ALIMENTOS; break;
+        case TABLA_CLIENTES: tipo = IMPORTAR_CLIENTES; break;
+        case TABLA_PEDIDOS: tipo = IMPORTAR_PEDIDOS; break;
+        default: return RESULTADO_INVALIDO;
+    }
+    ResultadoImportacion resultado;
+    if (!importarArchivo(argumentos[2], tipo, tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos, &resultado)) {
+        return RESULTADO_ERROR;
+    }
+    if (detalle) imprimirResultadoImportacion(argumentos[2], &resultado);
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief cocina iniciar COCINEROS [MICROS_POR_MENU] | cocina esperar|detener|metricas
+ */
+static ResultadoComando comandoCocina(char **argumentos, int numArgumentos, bool detalle) {
+    if (numArgumentos >= 3 && numArgumentos <= 4 && strcmp(argumentos[1], "iniciar") == 0) {
+        int cocineros, microsPorMenu = 0;
+        if (!leerIdLote(argumentos[2], &cocineros) ||
+            (numArgumentos == 4 && !leerIdLote(argumentos[3], &microsPorMenu))) return RESULTADO_INVALIDO;
+        return iniciarCocina(tablas.pedidos, cocineros, microsPorMenu) ? RESULTADO_OK : RESULTADO_ERROR;
+    }
+    if (numArgumentos != 2) return RESULTADO_INVALIDO;
+
+    MetricasCocina metricas;
+    if (strcmp(argumentos[1], "esperar") == 0) {
+        if (!cocinaActiva()) return RESULTADO_ERROR;
+        esperarCocina();
+        return RESULTADO_OK;
+    }
+    if (strcmp(argumentos[1], "detener") == 0) {
+        if (!cocinaActiva()) return RESULTADO_ERROR;
+        detenerCocina(&metricas);
+    } else if (strcmp(argumentos[1], "metricas") == 0) {
+        leerMetricasCocina(&metricas);
+    } else {
+        return RESULTADO_INVALIDO;
+    }
+    if (detalle) imprimirMetricasCocina(&metricas);
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief latencias [reiniciar|ARCHIVO]
+ *
+ * Sin argumentos imprime los percentiles (con detalle); con `reiniciar` pone los
+ * histogramas en cero y con un nombre de archivo los guarda en CSV.
+ */
+static ResultadoComando comandoLatencias(char **argumentos, int numArgumentos, bool detalle) {
+    if (numArgumentos == 1) {
+        if (detalle) imprimirLatencias();
+        return RESULTADO_OK;
+    }
+    if (numArgumentos != 2) return RESULTADO_INVALIDO;
+    if (strcmp(argumentos[1], "reiniciar") == 0) {
+        reiniciarLatencias();
+        return RESULTADO_OK;
+    }
+    return guardarLatencias(argumentos[1]) ? RESULTADO_OK : RESULTADO_ERROR;
+}
+
+/**
+ * @brief memoria [comparar|reiniciar]
+ *
+ * Sin argumentos imprime el reporte de memoria (con detalle); con `comparar` agrega la
+ * estimación con registros compactos y con `reiniciar` lleva los picos a los bytes vivos.
+ */
+static ResultadoComando comandoMemoria(char **argumentos, int numArgumentos, bool detalle) {
+    bool comparar = false;
+    if (numArgumentos == 2 && strcmp(argumentos[1], "reiniciar") == 0) {
+        reiniciarPicosMemoria();
+        return RESULTADO_OK;
+    }
+    if (numArgumentos == 2 && strcmp(argumentos[1], "comparar") == 0) {
+        comparar = true;
+    } else if (numArgumentos != 1) {
+        return RESULTADO_INVALIDO;
+    }
+    if (detalle) imprimirReporteMemoria(tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos, comparar);
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief total ID|metricas
+ *
+ * Con un ID calcula el total del pedido (ver totales_pedidos.h) y, con detalle, lo
+ * imprime; con `metricas` imprime los contadores de la caché.
+ */
+static ResultadoComando comandoTotal(char **argumentos, int numArgumentos, bool detalle) {
+    if (numArgumentos != 2) return RESULTADO_INVALIDO;
+    if (strcmp(argumentos[1], "metricas") == 0) {
+        if (detalle) imprimirMetricasTotales();
+        return RESULTADO_OK;
+    }
+    int id;
+    double total;
+    if (!leerIdLote(argumentos[1], &id)) return RESULTADO_INVALIDO;
+    if (!calcularTotalPedido(id, &total)) return RESULTADO_NO_ENCONTRADO;
+    if (detalle) printf("Total del pedido %d: %.2f\n", id, total);
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief reporte [ARCHIVO]
+ *
+ * Calcula los reportes de ventas (ver reportes_ventas.h); sin argumentos los imprime
+ * (con detalle) y con un nombre de archivo los guarda en CSV.
+ */
+static ResultadoComando comandoReporte(char **argumentos, int numArgumentos, bool detalle) {
+    if (numArgumentos > 2) return RESULTADO_INVALIDO;
+    ReporteVentas reporte;
+    if (!calcularReportesVentas(tablas.alimentos, tablas.clientes, tablas.menus, tablas.pedidos, &reporte)) {
+        return RESULTADO_ERROR;
+    }
+    bool correcto = true;
+    if (numArgumentos == 2) correcto = guardarReportesVentas(&reporte, argumentos[1]);
+    else if (detalle) imprimirReportesVentas(&reporte, 10);
+    liberarReportesVentas(&reporte);
+    return correcto ? RESULTADO_OK : RESULTADO_ERROR;
+}
+
+/**
+ * @brief Reconoce el nombre de un comando.
+ * @param nombre Primer argumento de la línea.
+ * @return El tipo de comando, o NUM_COMANDOS_LOTE si es desconocido.
+ */
+ComandoLote reconocerComandoLote(const char *nombre) {
+    for (int i = 0; i < NUM_COMANDOS_LOTE; i++) {
+        if (strcmp(nombre, nombresComando[i]) == 0) return (ComandoLote)i;
+    }
+    return NUM_COMANDOS_LOTE;
+}
+
+/**
+ * @brief Ejecuta un comando ya separado en argumentos.
+ * @param comando Tipo de comando.
+ * @param argumentos Argumentos; el primero es el comando.
+ * @param numArgumentos Número de argumentos (al menos 1).
+ * @param detalle `true` si se imprime el detalle de cada comando.
+ * @return Resultado del comando.
+ */
+ResultadoComando ejecutarComandoLote(ComandoLote comando, char **argumentos, int numArgumentos, bool detalle) {
+    // Esperar a la cocina o a la bitácora con el candado tomado detendría a los cocineros
+    if (comando == COMANDO_COCINA) return comandoCocina(argumentos, numArgumentos, detalle);
+    // Los histogramas son de cada hilo y no dependen de las tablas
+    if (comando == COMANDO_LATENCIAS) return comandoLatencias(argumentos, numArgumentos, detalle);
+    if (comando == COMANDO_CONFIRMAR) {
+        if (numArgumentos != 1) return RESULTADO_INVALIDO;
+        return confirmarBitacora() ? RESULTADO_OK : RESULTADO_ERROR;
+    }
+
+    bloquearTablasCocina();
+    ResultadoComando resultado;
+    switch (comando) {
+        case COMANDO_AGREGAR: resultado = comandoAgregar(argumentos, numArgumentos); break;
+        case COMANDO_BUSCAR: resultado = comandoBuscar(argumentos, numArgumentos); break;
+        case COMANDO_ELIMINAR: resultado = comandoEliminar(argumentos, numArgumentos); break;
+        case COMANDO_ACTUALIZAR: resultado = comandoActualizar(argumentos, numArgumentos); break;
+        case COMANDO_ORDENAR: resultado = comandoOrdenar(argumentos, numArgumentos); break;
+        case COMANDO_GUARDAR: resultado = comandoGuardar(argumentos, numArgumentos); break;
+        case COMANDO_CARGAR: resultado = comandoCargar(argumentos, numArgumentos); break;
+        case COMANDO_GENERAR: resultado = comandoGenerar(argumentos, numArgumentos); break;
+        case COMANDO_IMPORTAR: resultado = comandoImportar(argumentos, numArgumentos, detalle); break;
+        case COMANDO_MEMORIA: resultado = comandoMemoria(argumentos, numArgumentos, detalle); break;
+        case COMANDO_TOTAL: resultado = comandoTotal(argumentos, numArgumentos, detalle); break;
+        case COMANDO_REPORTE: resultado = comandoReporte(argumentos, numArgumentos, detalle); break;
+        default: resultado = RESULTADO_INVALIDO; break;
+    }
+    desbloquearTablasCocina();
+    return resultado;
+}
+
+/**
+ * @brief Indica las tablas sobre las que trabajan los comandos.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ */
+void usarTablasLote(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                    PedidosHashTable *tablaPedidos) {
+    tablas.alimentos = tablaAlimentos;
+    tablas.clientes = tablaClientes;
+    tablas.menus = tablaMenus;
+    tablas.pedidos = tablaPedidos;
+}
+
+/**
+ * @brief Ejecuta un guion de comandos hasta el fin de la entrada.
+ * @param entrada Guion (un archivo o `stdin`).
+ * @param detalle `true` para imprimir una línea por comando, `false` para solo acumular tiempos.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param resultado Conteos y tiempos (de salida).
+ */
+void ejecutarLote(FILE *entrada, bool detalle, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                  MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, ResultadoLote *resultado) {
+    memset(resultado, 0, sizeof(*resultado));
+    usarTablasLote(tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+    bool mensajesPrevios = mensajesActivos;
+    mensajesActivos = false; // El guion informa cada comando en una sola línea
+    double inicioLote = omp_get_wtime();
+
+    char linea[LOTE_MAX_LINEA];
+    long long numeroLinea = 0;
+    while (fgets(linea, sizeof(linea), entrada)) {
+        numeroLinea++;
+        size_t longitud = strlen(linea);
+        bool completa = longitud < sizeof(linea) - 1 || linea[longitud - 1] == '\n';
+        if (!completa) { // Se descarta el resto de una línea demasiado larga
+            int c;
+            while ((c = fgetc(entrada)) != EOF && c != '\n');
+        }
+
+        char *argumentos[LOTE_MAX_ARGUMENTOS];
+        int numArgumentos = separarArgumentosLote(linea, argumentos);
+        if (numArgumentos == 0 || argumentos[0][0] == '#') continue;
+        revisarGuardadoSegundoPlano(false, NULL);
+
+        ComandoLote comando = reconocerComandoLote(argumentos[0]);
+        ResultadoComando estado = RESULTADO_INVALIDO;
+        double inicio = omp_get_wtime();
+        if (completa && numArgumentos > 0) {
+            estado = ejecutarComandoLote(comando, argumentos, numArgumentos, detalle);
+        }
+        double duracion = omp_get_wtime() - inicio;
+
+        bool error = estado == RESULTADO_ERROR || estado == RESULTADO_INVALIDO;
+        resultado->comandos++;
+        if (error) resultado->errores++;
+        if (comando < NUM_COMANDOS_LOTE) {
+            EstadisticaComando *estadistica = &resultado->porComando[comando];
+            estadistica->ejecutados++;
+            if (error) estadistica->errores++;
+            estadistica->segundos += duracion;
+            if (duracion > estadistica->maximo) estadistica->maximo = duracion;
+        }
+        if (detalle) {
+            bool conObjeto = numArgumentos > 1 && comando != COMANDO_GENERAR && comando < NUM_COMANDOS_LOTE;
+            printf("%lld\t%s%s%s\t%s\t%.1f\n", numeroLinea, argumentos[0],
+                   conObjeto ? " " : "", conObjeto ? argumentos[1] : "",
+                   comando < NUM_COMANDOS_LOTE ? textosResultadoLote[estado] : "comando desconocido", duracion * 1e6);
+        }
+    }
+
+    detenerCocina(NULL); // Los pedidos encolados se terminan antes de confirmar la bitácora
+    revisarGuardadoSegundoPlano(true, NULL);
+    confirmarBitacora();
+    resultado->segundos = omp_get_wtime() - inicioLote;
+    mensajesActivos = mensajesPrevios;
+}
+
+/**
+ * @brief Imprime la tabla de tiempos por tipo de comando y el total del guion.
+ * @param resultado Resultado a imprimir.
+ */
+void imprimirResumenLote(const ResultadoLote *resultado) {
+    printf("\n%-12s %12s %10s %12s %15s %15s\n", "Comando", "Ejecutados", "Errores", "Total (s)", "Promedio (µs)",
+           "Máximo (µs)");
+    for (int i = 0; i < NUM_COMANDOS_LOTE; i++) {
+        const EstadisticaComando *estadistica = &resultado->porComando[i];
+        if (estadistica->ejecutados == 0) continue;
+        printf("%-12s %12lld %10lld %12.3f %15.2f %15.1f\n", nombresComando[i], estadistica->ejecutados,
+               estadistica->errores, estadistica->segundos, estadistica->segundos * 1e6 / estadistica->ejecutados,
+               estadistica->maximo * 1e6);
+    }
+    printf("\nTotal: %lld comandos (%lld con error) en %.3f s", resultado->comandos, resultado->errores,
+           resultado->segundos);
+    if (resultado->segundos > 0.0) printf(", %.0f comandos por segundo", resultado->comandos / resultado->segundos);
+    printf(".\n");
+}
@@ -0,0 +1,186 @@
+/**
+ * @file modo_lote.h
+ * @brief Ejecución no interactiva de un guion de comandos sobre las tablas.
+ *
+ * Cada línea del guion es un comando; las líneas vacías y las que empiezan con `#` se
+ * ignoran. Los argumentos se separan con espacios (los que llevan espacios van entre
+ * comillas dobles), las listas de IDs se separan con comas y las fechas se escriben
+ * AAAA-MM-DD (ver fechas.h):
+ *
+ *     agregar alimento ID NOMBRE PRECIO Si|No
+ *     agregar cliente ID NOMBRE TELEFONO
+ *     agregar menu ID FECHA ALIMENTOS            (por ejemplo 1,2,3)
+ *     agregar pedido ID CLIENTE FECHA ESTADO MENUS
+ *     buscar alimento|cliente|menu|pedido ID
+ *     eliminar alimento|cliente|menu|pedido ID
+ *     actualizar alimento ID NOMBRE PRECIO Si|No
+ *     actualizar cliente ID NOMBRE TELEFONO
+ *     actualizar menu ID FECHA ALIMENTOS
+ *     actualizar pedido ID ESTADO
+ *     ordenar alimentos|clientes|menus|pedidos
+ *     guardar yaml|normalizado|binario|incremental|fondo ARCHIVO
+ *     cargar yaml|normalizado|binario|incremental ARCHIVO
+ *     generar ALIMENTOS CLIENTES MENUS PEDIDOS [SEMILLA] (reemplaza las tablas; ver datos_aleatorios.h)
+ *     importar alimentos|clientes|pedidos ARCHIVO
+ *     confirmar                                  (espera a que la bitácora llegue al disco)
+ *     cocina iniciar COCINEROS [MICROS_POR_MENU] (ver cocina.h)
+ *     cocina esperar|detener|metricas
+ *     latencias [reiniciar|ARCHIVO]              (percentiles por operación; ver latencias.h)
+ *     memoria [comparar|reiniciar]               (huella y holgura de las tablas; ver reporte_memoria.h)
+ *     total ID|metricas                          (total de un pedido o métricas de la caché; ver totales_pedidos.h)
+ *     reporte [ARCHIVO]                          (reportes de ventas, o en CSV; ver reportes_ventas.h)
+ *
+ * Con la cocina trabajando, cada pedido agregado en estado "Pendiente" se encola para los
+ * cocineros, y cada comando toma el candado de las tablas mientras se ejecuta.
+ *
+ * Los mensajes de las tablas se silencian. Por cada comando se imprime una línea con
+ * campos separados por tabuladores (número de línea, comando, resultado y microsegundos),
+ * y al final una tabla con el tiempo acumulado de cada tipo de comando.
+ */
+
+#ifndef MODO_LOTE_H
+#define MODO_LOTE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Argumentos máximos de un comando (incluido el comando).
+#define LOTE_MAX_ARGUMENTOS 8
+
+/**
+ * @brief Tipos de comando del guion.
+ */
+typedef enum {
+    COMANDO_AGREGAR,
+    COMANDO_BUSCAR,
+    COMANDO_ELIMINAR,
+    COMANDO_ACTUALIZAR,
+    COMANDO_ORDENAR,
+    COMANDO_GUARDAR,
+    COMANDO_CARGAR,
+    COMANDO_GENERAR,
+    COMANDO_IMPORTAR,
+    COMANDO_CONFIRMAR,
+    COMANDO_COCINA,
+    COMANDO_LATENCIAS,
+    COMANDO_MEMORIA,
+    COMANDO_TOTAL,
+    COMANDO_REPORTE,
+    NUM_COMANDOS_LOTE
+} ComandoLote;
+
+/**
+ * @brief Resultado de un comando.
+ */
+typedef enum {
+    RESULTADO_OK,
+    RESULTADO_NO_ENCONTRADO,  ///< El ID no existe (no cuenta como error).
+    RESULTADO_ERROR,          ///< La operación falló.
+    RESULTADO_INVALIDO        ///< Faltan argumentos o no tienen el formato esperado.
+} ResultadoComando;
+
+/// Texto de cada resultado, en el orden de ResultadoComando.
+extern const char *const textosResultadoLote[];
+
+/**
+ * @brief Tabla a la que se refiere un comando.
+ */
+typedef enum { TABLA_ALIMENTOS, TABLA_CLIENTES, TABLA_MENUS, TABLA_PEDIDOS, TABLA_DESCONOCIDA } TablaLote;
+
+/**
+ * @brief Tiempos acumulados de un tipo de comando.
+ */
+typedef struct {
+    long long ejecutados;  ///< Comandos ejecutados.
+    long long errores;     ///< Comandos que fallaron o tenían argumentos inválidos.
+    double segundos;       ///< Tiempo total.
+    double maximo;         ///< Comando más lento, en segundos.
+} EstadisticaComando;
+
+/**
+ * @brief Resultado de un guion.
+ */
+typedef struct {
+    long long comandos;                                  ///< Comandos leídos (incluye los desconocidos).
+    long long errores;                                   ///< Comandos desconocidos, inválidos o fallidos.
+    EstadisticaComando porComando[NUM_COMANDOS_LOTE];    ///< Tiempos por tipo de comando.
+    double segundos;                                     ///< Duración del guion completo.
+} ResultadoLote;
+
+/**
+ * @brief Separa una línea en argumentos, en el mismo arreglo.
+ * @param linea Línea a separar (se modifica).
+ * @param argumentos Punteros a cada argumento (de salida, LOTE_MAX_ARGUMENTOS).
+ * @return Número de argumentos, o -1 si sobran argumentos o falta cerrar una comilla.
+ */
+int separarArgumentosLote(char *linea, char **argumentos);
+
+/**
+ * @brief Reconoce el nombre de un comando.
+ * @param nombre Primer argumento de la línea.
+ * @return El tipo de comando, o NUM_COMANDOS_LOTE si es desconocido.
+ */
+ComandoLote reconocerComandoLote(const char *nombre);
+
+/**
+ * @brief Reconoce el nombre de una tabla en singular o plural.
+ * @param nombre Nombre escrito en el comando.
+ * @return La tabla, o TABLA_DESCONOCIDA.
+ */
+TablaLote leerTablaLote(const char *nombre);
+
+/**
+ * @brief Convierte un argumento a ID (entero no negativo, como en la importación).
+ * @param texto Argumento.
+ * @param id Resultado.
+ * @return `true` si el argumento es un ID válido.
+ */
+bool leerIdLote(const char *texto, int *id);
+
+/**
+ * @brief Indica las tablas sobre las que trabajan los comandos.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ */
+void usarTablasLote(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                    PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Ejecuta un comando ya separado en argumentos sobre las tablas de usarTablasLote.
+ * @param comando Tipo de comando.
+ * @param argumentos Argumentos; el primero es el comando.
+ * @param numArgumentos Número de argumentos (al menos 1).
+ * @param detalle `true` para imprimir el resumen de los comandos que lo tienen (importar).
+ * @return Resultado del comando.
+ */
+ResultadoComando ejecutarComandoLote(ComandoLote comando, char **argumentos, int numArgumentos, bool detalle);
+
+/**
+ * @brief Ejecuta un guion de comandos hasta el fin de la entrada.
+ *
+ * Un comando que falla no detiene el guion.
+ *
+ * @param entrada Guion (un archivo o `stdin`).
+ * @param detalle `true` para imprimir una línea por comando, `false` para solo acumular tiempos.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param resultado Conteos y tiempos (de salida).
+ */
+void ejecutarLote(FILE *entrada, bool detalle, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                  MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, ResultadoLote *resultado);
+
+/**
+ * @brief Imprime la tabla de tiempos por tipo de comando y el total del guion.
+ * @param resultado Resultado a imprimir.
+ */
+void imprimirResumenLote(const ResultadoLote *resultado);
+
+#endif // MODO_LOTE_H
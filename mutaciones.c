@@ -0,0 +1,8 @@
+/**
+ * @file mutaciones.c
+ * @brief Estado global del observador de cambios de las tablas.
+ */
+
+#include "mutaciones.h"
+
+ObservadorMutaciones observadorMutaciones = NULL;
@@ -0,0 +1,55 @@
+/**
+ * @file mutaciones.h
+ * @brief Aviso de los cambios hechos por las operaciones de agregar, actualizar y eliminar.
+ *
+ * Las tablas notifican cada cambio exitoso a un observador global (la bitácora lo usa
+ * para registrarlos en disco). Las funciones `restaurar*` y `retirar*`, que usan los
+ * cargadores y la reproducción de la bitácora, no notifican nada.
+ */
+
+#ifndef MUTACIONES_H
+#define MUTACIONES_H
+
+#include <stddef.h>
+
+/**
+ * @brief Tipo de cambio notificado.
+ *
+ * Los cambios `*_PONER` indican que el registro quedó con el contenido del nodo
+ * notificado (se agregó o se actualizó); los `*_QUITAR` indican que se eliminó el ID.
+ */
+typedef enum {
+    MUTACION_ALIMENTO_PONER = 1,
+    MUTACION_ALIMENTO_QUITAR,
+    MUTACION_CLIENTE_PONER,
+    MUTACION_CLIENTE_QUITAR,
+    MUTACION_MENU_PONER,
+    MUTACION_MENU_QUITAR,
+    MUTACION_PEDIDO_PONER,
+    MUTACION_PEDIDO_QUITAR
+} TipoMutacion;
+
+/**
+ * @brief Función que recibe los cambios.
+ * @param tipo Tipo de cambio.
+ * @param nodo Nodo con el contenido nuevo (`Alimento`, `Cliente`, `Menu` o `Pedido`), o `NULL` al quitar.
+ * @param id ID del registro afectado.
+ */
+typedef void (*ObservadorMutaciones)(TipoMutacion tipo, const void *nodo, int id);
+
+/// Observador actual, o `NULL` (valor inicial) si nadie escucha los cambios.
+extern ObservadorMutaciones observadorMutaciones;
+
+/**
+ * @brief Notifica un cambio al observador, si hay uno.
+ * @param tipo Tipo de cambio.
+ * @param nodo Nodo con el contenido nuevo, o `NULL` al quitar.
+ * @param id ID del registro afectado.
+ */
+static inline void notificarMutacion(TipoMutacion tipo, const void *nodo, int id) {
+    if (observadorMutaciones) {
+        observadorMutaciones(tipo, nodo, id);
+    }
+}
+
+#endif // MUTACIONES_H
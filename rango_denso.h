@@ -0,0 +1,85 @@
+/**
+ * @file rango_denso.h
+ * @brief Política compartida del modo de direccionamiento directo para IDs densos.
+ *
+ * Cuando los IDs son consecutivos (1..N, como los que asigna `generarDatosAleatorios`
+ * o un autoincremento), cada tabla guarda sus registros en un arreglo indexado por ID
+ * en lugar de en las listas de los buckets. Los IDs fuera del rango (muy dispersos)
+ * siguen yendo a la tabla hash. Los negativos no llegan a las tablas: el modo por lotes,
+ * la importación, el YAML y los snapshots binarios los rechazan al leerlos.
+ */
+
+#ifndef RANGO_DENSO_H
+#define RANGO_DENSO_H
+
+#include <stdbool.h>
+
+/// Capacidad que siempre se concede al arreglo directo, sin importar la densidad.
+#define RANGO_DENSO_MINIMO 1024
+
+/// El arreglo solo crece si al menos 1 de cada RANGO_DENSO_FACTOR ranuras quedará ocupada.
+#define RANGO_DENSO_FACTOR 4
+
+/// Límite superior del arreglo directo (IDs mayores siempre usan la tabla hash).
+#define RANGO_DENSO_MAXIMO (1 << 28)
+
+/**
+ * @brief Calcula la capacidad que debe tener el arreglo directo para alojar un ID.
+ *
+ * @param id ID que se quiere insertar.
+ * @param capacidadActual Capacidad actual del arreglo directo.
+ * @param numRegistros Número de registros que ya tiene la tabla.
+ * @return Nueva capacidad (potencia de 2) si el ID debe ir al arreglo directo,
+ *         o 0 si debe ir a la tabla hash por ser un ID atípico.
+ */
+static inline int capacidadDensaPara(int id, int capacidadActual, int numRegistros) {
+    if (id < 0 || id >= RANGO_DENSO_MAXIMO) return 0;
+    if (id < capacidadActual) return capacidadActual;
+
+    long long nueva = capacidadActual > 0 ? capacidadActual : RANGO_DENSO_MINIMO;
+    while (nueva <= id) nueva *= 2;
+
+    if (nueva <= RANGO_DENSO_MINIMO || (long long)(numRegistros + 1) * RANGO_DENSO_FACTOR >= nueva) {
+        return (int)nueva;
+    }
+    return 0;
+}
+
+/**
+ * @brief Indica si conviene reservar de una vez el arreglo directo al cargar muchos registros.
+ *
+ * Aplica la misma regla de densidad que `capacidadDensaPara`, pero de una vez para
+ * todos los registros, así la carga no tiene que ampliar el arreglo repetidamente.
+ *
+ * @param idMaximo Mayor ID de los registros.
+ * @param numRegistros Número de registros.
+ * @return `true` si conviene reservar el rango [0, idMaximo].
+ */
+static inline bool convieneReservarRango(long long idMaximo, long long numRegistros) {
+    return idMaximo >= 0 && idMaximo < RANGO_DENSO_MAXIMO &&
+           (idMaximo < RANGO_DENSO_MINIMO || idMaximo < numRegistros * RANGO_DENSO_FACTOR);
+}
+
+/**
+ * @brief Invierte la lista de cada bucket de una tabla.
+ *
+ * `restaurar*` inserta al inicio del bucket, así que al leer los registros en orden
+ * cada lista queda al revés; invertirla devuelve el orden que tenía al guardarse. Los
+ * cargadores (YAML y snapshot binario) enlazan en el orden del archivo y luego invierten:
+ * así el arreglo directo crece con los IDs en el mismo orden en ambos, y guardar lo
+ * cargado da el mismo archivo sin importar de qué formato vino.
+ */
+#define INVERTIR_BUCKETS(tabla, Tipo, numBuckets)              \
+    for (int b = 0; b < (numBuckets); b++) {                   \
+        Tipo *anterior = NULL;                                 \
+        Tipo *actual = (tabla)->buckets[b];                    \
+        while (actual) {                                       \
+            Tipo *siguiente = actual->next;                    \
+            actual->next = anterior;                           \
+            anterior = actual;                                 \
+            actual = siguiente;                                \
+        }                                                      \
+        (tabla)->buckets[b] = anterior;                        \
+    }
+
+#endif // RANGO_DENSO_H
@@ -0,0 +1,390 @@
+/**
+ * @file reporte_memoria.c
+ * @brief Implementación del reporte de huella y holgura de las tablas.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include "reporte_memoria.h"
+#include "cadenas_internadas.h"
+#include "contabilidad_memoria.h"
+#include "tareas.h"
+
+/// Ranuras (del arreglo directo o buckets) que recorre cada tarea.
+#define RANURAS_POR_TAREA 4096
+
+/// Bytes fijos de un alimento compacto: ID, precio, disponible (1 byte), referencia al nombre y siguiente.
+#define COMPACTO_ALIMENTO 24
+
+/// Bytes fijos de un cliente compacto: ID, referencia al nombre y siguiente (el teléfono se suma con su largo).
+#define COMPACTO_CLIENTE 16
+
+/// Bytes fijos de un menú compacto: ID, fecha, número y referencia de la lista, y siguiente.
+#define COMPACTO_MENU 24
+
+/// Bytes fijos de un pedido compacto: ID, cliente, fecha, estado (1 byte), número y referencia de la lista, y siguiente.
+#define COMPACTO_PEDIDO 32
+
+/// Tamaño de un campo de una estructura.
+#define TAMANO_CAMPO(tipo, campo) sizeof(((tipo *)0)->campo)
+
+/**
+ * @brief Sumas de un recorrido, antes de agregar la estructura, el arreglo directo y los cambios.
+ */
+typedef struct {
+    long long registros;
+    long long enDirecto;   ///< Registros en el arreglo directo.
+    long long enBloque;    ///< Nodos tomados del bloque.
+    long long listas;      ///< Holgura de listas de IDs.
+    long long cadenas;     ///< Holgura de cadenas.
+    long long compactos;   ///< Bytes de los registros con el diseño compacto.
+} ParcialHuella;
+
+/**
+ * @brief Recorrido en curso: tabla, sumas y candado para agregar las de cada tarea.
+ */
+typedef struct {
+    void *tabla;
+    ParcialHuella total;
+    pthread_mutex_t candado;
+} RecorridoHuella;
+
+/**
+ * @brief Bytes de una cadena después de su '\0' (0 si ocupa todo el arreglo).
+ * @param cadena Arreglo de la cadena.
+ * @param capacidad Tamaño del arreglo.
+ */
+static long long holguraCadena(const char *cadena, size_t capacidad) {
+    const char *fin = (const char *)memchr(cadena, '\0', capacidad);
+    return fin ? (long long)(capacidad - (size_t)(fin - cadena) - 1) : 0;
+}
+
+/**
+ * @brief Bytes que ocupa una cadena con su largo exacto y su '\0'.
+ */
+static long long largoCompacto(const char *cadena, size_t capacidad) {
+    return (long long)capacidad - holguraCadena(cadena, capacidad);
+}
+
+/**
+ * @brief Suma el parcial de una tarea al total del recorrido.
+ */
+static void agregarParcial(RecorridoHuella *recorrido, const ParcialHuella *parcial) {
+    pthread_mutex_lock(&recorrido->candado);
+    recorrido->total.registros += parcial->registros;
+    recorrido->total.enDirecto += parcial->enDirecto;
+    recorrido->total.enBloque += parcial->enBloque;
+    recorrido->total.listas += parcial->listas;
+    recorrido->total.cadenas += parcial->cadenas;
+    recorrido->total.compactos += parcial->compactos;
+    pthread_mutex_unlock(&recorrido->candado);
+}
+
+/**
+ * @brief Mide los alimentos de las ranuras `[inicio, fin)`.
+ *
+ * Cada ranura es una posición del arreglo directo o un bucket completo.
+ */
+static void medirRangoAlimentos(long long inicio, long long fin, void *contexto) {
+    RecorridoHuella *recorrido = (RecorridoHuella *)contexto;
+    HashTable *tabla = (HashTable *)recorrido->tabla;
+    ParcialHuella parcial = {0};
+    for (long long i = inicio; i < fin; i++) {
+        bool directo = i < tabla->capacidadDirecta;
+        Alimento *alimento = directo ? tabla->directo[i] : tabla->buckets[i - tabla->capacidadDirecta];
+        // Los nodos del arreglo directo no se encadenan; los de un bucket sí
+        for (; alimento; alimento = directo ? NULL : alimento->next) {
+            parcial.registros++;
+            parcial.enDirecto += directo;
+            parcial.enBloque += nodoEnBloque(&tabla->bloqueNodos, alimento);
+            parcial.compactos += COMPACTO_ALIMENTO;
+        }
+    }
+    agregarParcial(recorrido, &parcial);
+}
+
+/**
+ * @brief Mide los clientes de las ranuras `[inicio, fin)`.
+ */
+static void medirRangoClientes(long long inicio, long long fin, void *contexto) {
+    RecorridoHuella *recorrido = (RecorridoHuella *)contexto;
+    ClientesHashTable *tabla = (ClientesHashTable *)recorrido->tabla;
+    ParcialHuella parcial = {0};
+    for (long long i = inicio; i < fin; i++) {
+        bool directo = i < tabla->capacidadDirecta;
+        Cliente *cliente = directo ? tabla->directo[i] : tabla->buckets[i - tabla->capacidadDirecta];
+        for (; cliente; cliente = directo ? NULL : cliente->next) {
+            parcial.registros++;
+            parcial.enDirecto += directo;
+            parcial.enBloque += nodoEnBloque(&tabla->bloqueNodos, cliente);
+            parcial.cadenas += holguraCadena(cliente->telefono, sizeof(cliente->telefono));
+            parcial.compactos += COMPACTO_CLIENTE + largoCompacto(cliente->telefono, sizeof(cliente->telefono));
+        }
+    }
+    agregarParcial(recorrido, &parcial);
+}
+
+/**
+ * @brief Mide los menús de las ranuras `[inicio, fin)`.
+ */
+static void medirRangoMenus(long long inicio, long long fin, void *contexto) {
+    RecorridoHuella *recorrido = (RecorridoHuella *)contexto;
+    MenuHashTable *tabla = (MenuHashTable *)recorrido->tabla;
+    ParcialHuella parcial = {0};
+    for (long long i = inicio; i < fin; i++) {
+        bool directo = i < tabla->capacidadDirecta;
+        Menu *menu = directo ? tabla->directo[i] : tabla->buckets[i - tabla->capacidadDirecta];
+        for (; menu; menu = directo ? NULL : menu->next) {
+            parcial.registros++;
+            parcial.enDirecto += directo;
+            parcial.enBloque += nodoEnBloque(&tabla->bloqueNodos, menu);
+            parcial.listas += (long long)(sizeof(menu->alimentos) - (size_t)menu->numAlimentos * sizeof(int));
+            parcial.compactos += COMPACTO_MENU + (long long)menu->numAlimentos * (long long)sizeof(int);
+        }
+    }
+    agregarParcial(recorrido, &parcial);
+}
+
+/**
+ * @brief Mide los pedidos de las ranuras `[inicio, fin)`.
+ */
+static void medirRangoPedidos(long long inicio, long long fin, void *contexto) {
+    RecorridoHuella *recorrido = (RecorridoHuella *)contexto;
+    PedidosHashTable *tabla = (PedidosHashTable *)recorrido->tabla;
+    ParcialHuella parcial = {0};
+    for (long long i = inicio; i < fin; i++) {
+        bool directo = i < tabla->capacidadDirecta;
+        Pedido *pedido = directo ? tabla->directo[i] : tabla->buckets[i - tabla->capacidadDirecta];
+        for (; pedido; pedido = directo ? NULL : pedido->next) {
+            parcial.registros++;
+            parcial.enDirecto += directo;
+            parcial.enBloque += nodoEnBloque(&tabla->bloqueNodos, pedido);
+            parcial.listas += (long long)(sizeof(pedido->menus) - (size_t)pedido->numMenus * sizeof(int));
+            parcial.cadenas += holguraCadena(pedido->estado, sizeof(pedido->estado));
+            parcial.compactos += COMPACTO_PEDIDO + (long long)pedido->numMenus * (long long)sizeof(int);
+        }
+    }
+    agregarParcial(recorrido, &parcial);
+}
+
+/**
+ * @brief Recorre las ranuras de una tabla en paralelo.
+ * @param tabla Tabla a recorrer.
+ * @param numRanuras Posiciones del arreglo directo más buckets.
+ * @param funcion Función que mide cada rango de ranuras.
+ * @param total Sumas del recorrido (de salida).
+ */
+static void recorrerTabla(void *tabla, long long numRanuras, FuncionRango funcion, ParcialHuella *total) {
+    RecorridoHuella recorrido = { .tabla = tabla };
+    pthread_mutex_init(&recorrido.candado, NULL);
+    paraCadaRango(numRanuras, RANURAS_POR_TAREA, funcion, &recorrido);
+    pthread_mutex_destroy(&recorrido.candado);
+    *total = recorrido.total;
+}
+
+/**
+ * @brief Completa la huella con las partes que no dependen de cada registro.
+ * @param huella Huella a completar (de salida).
+ * @param total Sumas del recorrido.
+ * @param tamanoTabla Tamaño de la estructura de la tabla.
+ * @param capacidadDirecta Ranuras del arreglo directo.
+ * @param bloque Bloque de nodos de la tabla.
+ * @param cambios Registro de cambios de la tabla.
+ * @param rellenoNodo Bytes de relleno de cada nodo.
+ */
+static void completarHuella(HuellaTabla *huella, const ParcialHuella *total, size_t tamanoTabla, int capacidadDirecta,
+                            const BloqueNodos *bloque, const CambiosPendientes *cambios, size_t rellenoNodo) {
+    long long tamanoNodo = (long long)bloque->tamanoNodo;
+    huella->registros = total->registros;
+    huella->bytesEstructura = (long long)tamanoTabla;
+    huella->bytesDirecto = (long long)capacidadDirecta * (long long)sizeof(void *);
+    huella->bytesNodos = (total->registros - total->enBloque) * tamanoNodo + (long long)bloque->tamano;
+    huella->bytesCambios = (long long)cambios->capacidad * (long long)sizeof(Cambio);
+    huella->bytesVivos = huella->bytesEstructura + huella->bytesDirecto + huella->bytesNodos + huella->bytesCambios;
+
+    huella->holguraListas = total->listas;
+    huella->holguraCadenas = total->cadenas;
+    huella->holguraRelleno = total->registros * (long long)rellenoNodo;
+    huella->holguraDirecto = ((long long)capacidadDirecta - total->enDirecto) * (long long)sizeof(void *);
+    huella->holguraBloque = (long long)bloque->tamano - total->enBloque * tamanoNodo;
+    huella->holgura = huella->holguraListas + huella->holguraCadenas + huella->holguraRelleno +
+                      huella->holguraDirecto + huella->holguraBloque;
+
+    huella->bytesCompactos = huella->bytesEstructura + huella->bytesDirecto + huella->bytesCambios + total->compactos;
+}
+
+/**
+ * @brief Mide la huella de la tabla de alimentos.
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaAlimentos(HashTable *tabla, HuellaTabla *huella) {
+    ParcialHuella total;
+    recorrerTabla(tabla, (long long)tabla->capacidadDirecta + HASH_TABLE_SIZE, medirRangoAlimentos, &total);
+    size_t relleno = sizeof(Alimento) - TAMANO_CAMPO(Alimento, id) - TAMANO_CAMPO(Alimento, nombre) -
+                     TAMANO_CAMPO(Alimento, precio) - TAMANO_CAMPO(Alimento, disponible) - TAMANO_CAMPO(Alimento, next);
+    completarHuella(huella, &total, sizeof(HashTable), tabla->capacidadDirecta, &tabla->bloqueNodos, &tabla->cambios,
+                    relleno);
+}
+
+/**
+ * @brief Mide la huella de la tabla de clientes.
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaClientes(ClientesHashTable *tabla, HuellaTabla *huella) {
+    ParcialHuella total;
+    recorrerTabla(tabla, (long long)tabla->capacidadDirecta + CLIENTES_TABLE_SIZE, medirRangoClientes, &total);
+    size_t relleno = sizeof(Cliente) - TAMANO_CAMPO(Cliente, idCliente) - TAMANO_CAMPO(Cliente, nombre) -
+                     TAMANO_CAMPO(Cliente, telefono) - TAMANO_CAMPO(Cliente, next);
+    completarHuella(huella, &total, sizeof(ClientesHashTable), tabla->capacidadDirecta, &tabla->bloqueNodos,
+                    &tabla->cambios, relleno);
+}
+
+/**
+ * @brief Mide la huella de la tabla de menús.
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaMenus(MenuHashTable *tabla, HuellaTabla *huella) {
+    ParcialHuella total;
+    recorrerTabla(tabla, (long long)tabla->capacidadDirecta + MENU_TABLE_SIZE, medirRangoMenus, &total);
+    size_t relleno = sizeof(Menu) - TAMANO_CAMPO(Menu, idMenu) - TAMANO_CAMPO(Menu, fecha) -
+                     TAMANO_CAMPO(Menu, alimentos) - TAMANO_CAMPO(Menu, numAlimentos) - TAMANO_CAMPO(Menu, next);
+    completarHuella(huella, &total, sizeof(MenuHashTable), tabla->capacidadDirecta, &tabla->bloqueNodos,
+                    &tabla->cambios, relleno);
+}
+
+/**
+ * @brief Mide la huella de la tabla de pedidos.
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaPedidos(PedidosHashTable *tabla, HuellaTabla *huella) {
+    ParcialHuella total;
+    recorrerTabla(tabla, (long long)tabla->capacidadDirecta + PEDIDOS_TABLE_SIZE, medirRangoPedidos, &total);
+    size_t relleno = sizeof(Pedido) - TAMANO_CAMPO(Pedido, idPedido) - TAMANO_CAMPO(Pedido, idCliente) -
+                     TAMANO_CAMPO(Pedido, fecha) - TAMANO_CAMPO(Pedido, menus) - TAMANO_CAMPO(Pedido, numMenus) -
+                     TAMANO_CAMPO(Pedido, estado) - TAMANO_CAMPO(Pedido, next);
+    completarHuella(huella, &total, sizeof(PedidosHashTable), tabla->capacidadDirecta, &tabla->bloqueNodos,
+                    &tabla->cambios, relleno);
+}
+
+/**
+ * @brief Porcentaje de `parte` sobre `total` (0 si el total es 0).
+ */
+static double porcentaje(long long parte, long long total) {
+    return total > 0 ? 100.0 * (double)parte / (double)total : 0.0;
+}
+
+/**
+ * @brief Bytes por registro (0 sin registros).
+ */
+static double porRegistro(long long bytes, long long registros) {
+    return registros > 0 ? (double)bytes / (double)registros : 0.0;
+}
+
+/**
+ * @brief Imprime un nombre alineado a la izquierda en `ancho` columnas, contando caracteres UTF-8 y no bytes.
+ */
+static void imprimirNombre(const char *nombre, int ancho) {
+    int caracteres = 0;
+    for (const char *c = nombre; *c; c++) {
+        if ((*c & 0xC0) != 0x80) caracteres++;
+    }
+    printf("%s%*s", nombre, ancho > caracteres ? ancho - caracteres : 0, "");
+}
+
+/**
+ * @brief Imprime los contadores por subsistema y la huella y holgura de cada tabla.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param comparar `true` para agregar la estimación con diseños compactos.
+ */
+void imprimirReporteMemoria(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                            PedidosHashTable *tablaPedidos, bool comparar) {
+    ContadoresMemoria contadores[NUM_SUBSISTEMAS_MEMORIA];
+    leerContadoresMemoria(contadores);
+    printf("\n--- Memoria por subsistema (bytes pedidos al reservar) ---\n");
+    printf("%-20s %12s %12s %16s %16s\n", "Subsistema", "Reservas", "Liberaciones", "Vivos (B)", "Pico (B)");
+    ContadoresMemoria suma = {0};
+    for (int i = 0; i < NUM_SUBSISTEMAS_MEMORIA; i++) {
+        const ContadoresMemoria *c = &contadores[i];
+        imprimirNombre(nombresSubsistemaMemoria[i], 20);
+        printf(" %12lld %12lld %16lld %16lld\n", c->reservas, c->liberaciones, c->bytesVivos, c->bytesPico);
+        suma.reservas += c->reservas;
+        suma.liberaciones += c->liberaciones;
+        suma.bytesVivos += c->bytesVivos;
+        suma.bytesPico += c->bytesPico; // Los picos pueden ser de momentos distintos: es una cota
+    }
+    printf("%-20s %12lld %12lld %16lld %16lld\n", "Total", suma.reservas, suma.liberaciones, suma.bytesVivos,
+           suma.bytesPico);
+
+    MetricasCadenas cadenas;
+    leerMetricasCadenas(&cadenas);
+    printf("\nCadenas internadas: %lld textos distintos, %lld B de texto y %lld B libres en %lld B de arena\n"
+           "y %lld B de índice; %lld de %lld textos internados ya estaban guardados (%.1f%%);\n"
+           "%lld textos liberados, %lld guardados en el espacio de uno liberado.\n",
+           cadenas.cadenas, cadenas.bytesTexto, cadenas.bytesLibres, cadenas.bytesArena, cadenas.bytesIndice,
+           cadenas.aciertos, cadenas.internados, porcentaje(cadenas.aciertos, cadenas.internados),
+           cadenas.liberadas, cadenas.reutilizadas);
+
+    const char *nombres[4] = { "alimentos", "clientes", "menús", "pedidos" };
+    HuellaTabla huellas[4], total = {0};
+    medirHuellaAlimentos(tablaAlimentos, &huellas[0]);
+    medirHuellaClientes(tablaClientes, &huellas[1]);
+    medirHuellaMenus(tablaMenus, &huellas[2]);
+    medirHuellaPedidos(tablaPedidos, &huellas[3]);
+    for (int i = 0; i < 4; i++) {
+        const HuellaTabla *h = &huellas[i];
+        total.registros += h->registros;
+        total.bytesEstructura += h->bytesEstructura;
+        total.bytesDirecto += h->bytesDirecto;
+        total.bytesNodos += h->bytesNodos;
+        total.bytesCambios += h->bytesCambios;
+        total.bytesVivos += h->bytesVivos;
+        total.holguraListas += h->holguraListas;
+        total.holguraCadenas += h->holguraCadenas;
+        total.holguraRelleno += h->holguraRelleno;
+        total.holguraDirecto += h->holguraDirecto;
+        total.holguraBloque += h->holguraBloque;
+        total.holgura += h->holgura;
+        total.bytesCompactos += h->bytesCompactos;
+    }
+
+    printf("\n--- Huella de las tablas actuales (B) ---\n");
+    printf("%-10s %11s %14s %11s %10s %12s %14s %10s\n", "Tabla", "Registros", "Vivos", "B/registro", "Estructura",
+           "Directo", "Nodos", "Cambios");
+    for (int i = 0; i <= 4; i++) {
+        const HuellaTabla *h = i < 4 ? &huellas[i] : &total;
+        imprimirNombre(i < 4 ? nombres[i] : "Total", 10);
+        printf(" %11lld %14lld %11.1f %10lld %12lld %14lld %10lld\n", h->registros, h->bytesVivos,
+               porRegistro(h->bytesVivos, h->registros), h->bytesEstructura, h->bytesDirecto, h->bytesNodos,
+               h->bytesCambios);
+    }
+
+    printf("\n--- Holgura: bytes reservados que no guardan datos (B) ---\n");
+    printf("%-10s %14s %12s %12s %12s %12s %14s %7s\n", "Tabla", "Listas", "Cadenas", "Relleno", "Directo",
+           "Bloque", "Total", "%");
+    for (int i = 0; i <= 4; i++) {
+        const HuellaTabla *h = i < 4 ? &huellas[i] : &total;
+        imprimirNombre(i < 4 ? nombres[i] : "Total", 10);
+        printf(" %14lld %12lld %12lld %12lld %12lld %14lld %6.1f%%\n", h->holguraListas, h->holguraCadenas,
+               h->holguraRelleno, h->holguraDirecto, h->holguraBloque, h->holgura, porcentaje(h->holgura, h->bytesVivos));
+    }
+
+    if (!comparar) return;
+    printf("\n--- Estimación con registros compactos (B) ---\n");
+    printf("(teléfono de largo exacto, estado en 1 byte, listas de largo exacto)\n");
+    printf("%-10s %14s %14s %11s %14s %7s\n", "Tabla", "Actual", "Compacto", "B/registro", "Ahorro", "%");
+    for (int i = 0; i <= 4; i++) {
+        const HuellaTabla *h = i < 4 ? &huellas[i] : &total;
+        long long ahorro = h->bytesVivos - h->bytesCompactos;
+        imprimirNombre(i < 4 ? nombres[i] : "Total", 10);
+        printf(" %14lld %14lld %11.1f %14lld %6.1f%%\n", h->bytesVivos, h->bytesCompactos,
+               porRegistro(h->bytesCompactos, h->registros), ahorro, porcentaje(ahorro, h->bytesVivos));
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file reporte_memoria.h
+ * @brief Huella de memoria de cada tabla, su holgura y lo que ocuparía con un diseño compacto.
+ *
+ * Junto con los contadores de contabilidad_memoria.h (bytes vivos y pico por subsistema),
+ * el reporte recorre las tablas y separa lo que ocupan la estructura, el arreglo directo,
+ * los nodos y el registro de cambios, y cuánto de eso no guarda datos:
+ *
+ * - listas: ranuras sin usar de `alimentos[50]` (menús) y `menus[50]` (pedidos);
+ * - cadenas: bytes después del `'\0'` en el teléfono de los clientes y el estado de los
+ *   pedidos (los nombres están internados, ver cadenas_internadas.h, y no tienen holgura
+ *   en el nodo);
+ * - relleno: bytes que el compilador agrega entre campos para alinearlos;
+ * - directo vacío: ranuras del arreglo directo sin registro;
+ * - bloque sin usar: nodos del bloque que ya se eliminaron.
+ *
+ * La comparación estima, con los datos actuales, cuánto ocuparían los registros si el
+ * teléfono se guardara con su largo exacto, el estado en 1 byte y las listas de IDs con
+ * su largo exacto (las fechas ya ocupan 4 bytes, ver fechas.h, y los nombres son
+ * referencias de 4 bytes a la arena de cadenas internadas, que se reporta aparte).
+ * Las estructuras de acceso (buckets, arreglo directo, cambios) se suponen iguales.
+ */
+
+#ifndef REPORTE_MEMORIA_H
+#define REPORTE_MEMORIA_H
+
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/**
+ * @brief Bytes que ocupa una tabla, medidos al recorrerla.
+ */
+typedef struct {
+    long long registros;         ///< Registros de la tabla.
+    long long bytesEstructura;   ///< Estructura de la tabla, con sus buckets.
+    long long bytesDirecto;      ///< Arreglo directo.
+    long long bytesNodos;        ///< Nodos sueltos más el bloque completo.
+    long long bytesCambios;      ///< Registro de cambios pendientes.
+    long long bytesVivos;        ///< Suma de los cuatro anteriores.
+    long long holguraListas;     ///< Ranuras de listas de IDs sin usar.
+    long long holguraCadenas;    ///< Bytes de cadenas después del '\0'.
+    long long holguraRelleno;    ///< Relleno de alineación de los nodos.
+    long long holguraDirecto;    ///< Ranuras vacías del arreglo directo.
+    long long holguraBloque;     ///< Nodos del bloque que ya no están en la tabla.
+    long long holgura;           ///< Suma de las cinco holguras.
+    long long bytesCompactos;    ///< Estimación de bytesVivos con registros compactos y sin holgura.
+} HuellaTabla;
+
+/**
+ * @brief Mide la huella de la tabla de alimentos.
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaAlimentos(HashTable *tabla, HuellaTabla *huella);
+
+/**
+ * @brief Mide la huella de la tabla de clientes.
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaClientes(ClientesHashTable *tabla, HuellaTabla *huella);
+
+/**
+ * @brief Mide la huella de la tabla de menús.
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaMenus(MenuHashTable *tabla, HuellaTabla *huella);
+
+/**
+ * @brief Mide la huella de la tabla de pedidos.
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @param huella Resultado (de salida).
+ */
+void medirHuellaPedidos(PedidosHashTable *tabla, HuellaTabla *huella);
+
+/**
+ * @brief Imprime los contadores por subsistema y la huella y holgura de cada tabla.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param comparar `true` para agregar la estimación con diseños compactos.
+ */
+void imprimirReporteMemoria(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                            PedidosHashTable *tablaPedidos, bool comparar);
+
+#endif // REPORTE_MEMORIA_H
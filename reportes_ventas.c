@@ -0,0 +1,710 @@
+/**
+ * @file reportes_ventas.c
+ * @brief Implementación de los reportes de ventas.
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "reportes_ventas.h"
+#include "contabilidad_memoria.h"
+#include "mensajes.h"
+#include "tareas.h"
+
+/// Nombre de cada reporte, en el orden de TipoReporteVentas.
+const char *const nombresReporteVentas[NUM_REPORTES_VENTAS] = { "dia", "alimento", "menu", "cliente", "estado" };
+
+/// Ranuras (del arreglo directo o buckets) que recorre cada tarea.
+#define RANURAS_POR_TAREA 4096
+
+/// Primer día del reporte por día.
+#define REPORTE_PRIMER_DIA fechaDeCivil(REPORTE_ANIO_MINIMO, 1, 1)
+
+/// Días que cubre el reporte por día.
+#define REPORTE_NUM_DIAS (fechaDeCivil(REPORTE_ANIO_MAXIMO + 1, 1, 1) - REPORTE_PRIMER_DIA)
+
+/**
+ * @brief Pedidos, unidades e ingresos acumulados de una clave.
+ */
+typedef struct {
+    long long pedidos;
+    long long unidades;
+    double ingresos;
+} Acumulado;
+
+/**
+ * @brief Posición de cada ID de una tabla en los arreglos de acumulados.
+ *
+ * Los IDs del rango denso `[0, capacidadDirecta)` ocupan su propia posición; los de los
+ * buckets, ordenados, van a continuación.
+ */
+typedef struct {
+    int capacidadDirecta;
+    int *dispersos;     ///< IDs de los buckets, ordenados.
+    int numDispersos;
+    int numPosiciones;  ///< capacidadDirecta + numDispersos.
+} IndiceIds;
+
+/**
+ * @brief Acumulados de un hilo.
+ *
+ * Un bloque toma un parcial libre al empezar y lo devuelve al terminar, así que hay a lo
+ * más tantos parciales como bloques corren a la vez (uno por hilo) y nunca se comparten.
+ */
+typedef struct ParcialVentas {
+    Acumulado *dias;        ///< REPORTE_NUM_DIAS posiciones.
+    Acumulado *clientes;    ///< Una posición por cliente (ver IndiceIds).
+    Acumulado *menus;       ///< Una posición por menú; los ingresos se calculan al final.
+    Acumulado estados[REPORTE_MAX_ESTADOS + 1];
+    char nombresEstado[REPORTE_MAX_ESTADOS + 1][16];
+    int numEstados;
+    Acumulado total;
+    long long menusFaltantes, clientesFaltantes, fechasInvalidas;
+    struct ParcialVentas *siguiente;      ///< Siguiente de la lista de todos los parciales.
+    struct ParcialVentas *siguienteLibre; ///< Siguiente de la pila de libres.
+} ParcialVentas;
+
+/**
+ * @brief Cálculo en curso: tablas, índices, totales de menús y parciales.
+ */
+typedef struct {
+    HashTable *tablaAlimentos;
+    ClientesHashTable *tablaClientes;
+    MenuHashTable *tablaMenus;
+    PedidosHashTable *tablaPedidos;
+    IndiceIds clientes, menus, alimentos;
+    double *totalesMenus;     ///< Total de cada menú por posición; NAN si el menú no existe.
+    ParcialVentas *parciales; ///< Todos los parciales creados.
+    ParcialVentas *libres;    ///< Parciales que ningún bloque está usando.
+    int numParciales;
+    bool sinMemoria;
+    pthread_mutex_t candado;
+} CalculoVentas;
+
+/**
+ * @brief Reserva un arreglo en cero y lo cuenta.
+ * @return El arreglo, o NULL si no hay memoria.
+ */
+static void *reservarContado(size_t elementos, size_t tamano) {
+    void *arreglo = calloc(elementos > 0 ? elementos : 1, tamano);
+    if (arreglo) contarReserva(MEMORIA_REPORTES, elementos * tamano);
+    return arreglo;
+}
+
+/**
+ * @brief Libera un arreglo reservado con reservarContado.
+ */
+static void liberarContado(void *arreglo, size_t elementos, size_t tamano) {
+    if (!arreglo) return;
+    contarLiberacion(MEMORIA_REPORTES, elementos * tamano);
+    free(arreglo);
+}
+
+/**
+ * @brief Suma una venta (o un acumulado) a un acumulado.
+ */
+static inline void sumarAcumulado(Acumulado *destino, long long pedidos, long long unidades, double ingresos) {
+    destino->pedidos += pedidos;
+    destino->unidades += unidades;
+    destino->ingresos += ingresos;
+}
+
+static int compararIds(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Reserva los IDs dispersos de un índice, que el llamador llena y luego ordena con cerrarIndice.
+ * @return `true` si hubo memoria.
+ */
+static bool abrirIndice(IndiceIds *indice, int capacidadDirecta, int numDispersos) {
+    indice->capacidadDirecta = capacidadDirecta;
+    indice->numDispersos = numDispersos;
+    indice->numPosiciones = capacidadDirecta + numDispersos;
+    indice->dispersos = (int *)reservarContado((size_t)numDispersos, sizeof(int));
+    return indice->dispersos != NULL;
+}
+
+static void cerrarIndice(IndiceIds *indice) {
+    qsort(indice->dispersos, (size_t)indice->numDispersos, sizeof(int), compararIds);
+}
+
+static void liberarIndice(IndiceIds *indice) {
+    liberarContado(indice->dispersos, (size_t)indice->numDispersos, sizeof(int));
+    indice->dispersos = NULL;
+}
+
+/**
+ * @brief Posición de un ID en los arreglos de acumulados.
+ * @return La posición, o -1 si el ID no está en el índice.
+ */
+static inline int posicionId(const IndiceIds *indice, int id) {
+    if (id >= 0 && id < indice->capacidadDirecta) return id;
+    int izquierda = 0, derecha = indice->numDispersos - 1;
+    while (izquierda <= derecha) {
+        int medio = izquierda + (derecha - izquierda) / 2;
+        if (indice->dispersos[medio] == id) return indice->capacidadDirecta + medio;
+        if (indice->dispersos[medio] < id) izquierda = medio + 1;
+        else derecha = medio - 1;
+    }
+    return -1;
+}
+
+/**
+ * @brief ID que ocupa una posición del índice.
+ */
+static inline int idEnPosicion(const IndiceIds *indice, int posicion) {
+    return posicion < indice->capacidadDirecta ? posicion : indice->dispersos[posicion - indice->capacidadDirecta];
+}
+
+static bool indexarAlimentos(HashTable *tabla, IndiceIds *indice) {
+    int numDispersos = 0;
+    for (int b = 0; b < HASH_TABLE_SIZE; b++) {
+        for (Alimento *a = tabla->buckets[b]; a; a = a->next) numDispersos++;
+    }
+    if (!abrirIndice(indice, tabla->capacidadDirecta, numDispersos)) return false;
+    numDispersos = 0;
+    for (int b = 0; b < HASH_TABLE_SIZE; b++) {
+        for (Alimento *a = tabla->buckets[b]; a; a = a->next) indice->dispersos[numDispersos++] = a->id;
+    }
+    cerrarIndice(indice);
+    return true;
+}
+
+static bool indexarClientes(ClientesHashTable *tabla, IndiceIds *indice) {
+    int numDispersos = 0;
+    for (int b = 0; b < CLIENTES_TABLE_SIZE; b++) {
+        for (Cliente *c = tabla->buckets[b]; c; c = c->next) numDispersos++;
+    }
+    if (!abrirIndice(indice, tabla->capacidadDirecta, numDispersos)) return false;
+    numDispersos = 0;
+    for (int b = 0; b < CLIENTES_TABLE_SIZE; b++) {
+        for (Cliente *c = tabla->buckets[b]; c; c = c->next) indice->dispersos[numDispersos++] = c->idCliente;
+    }
+    cerrarIndice(indice);
+    return true;
+}
+
+static bool indexarMenus(MenuHashTable *tabla, IndiceIds *indice) {
+    int numDispersos = 0;
+    for (int b = 0; b < MENU_TABLE_SIZE; b++) {
+        for (Menu *m = tabla->buckets[b]; m; m = m->next) numDispersos++;
+    }
+    if (!abrirIndice(indice, tabla->capacidadDirecta, numDispersos)) return false;
+    numDispersos = 0;
+    for (int b = 0; b < MENU_TABLE_SIZE; b++) {
+        for (Menu *m = tabla->buckets[b]; m; m = m->next) indice->dispersos[numDispersos++] = m->idMenu;
+    }
+    cerrarIndice(indice);
+    return true;
+}
+
+/**
+ * @brief Menú que ocupa una posición del índice de menús, o NULL si no existe.
+ */
+static Menu *menuEnPosicion(const CalculoVentas *calculo, int posicion) {
+    if (posicion < calculo->menus.capacidadDirecta) return calculo->tablaMenus->directo[posicion];
+    return buscarMenuPorID(calculo->tablaMenus, idEnPosicion(&calculo->menus, posicion));
+}
+
+/**
+ * @brief Calcula el total de los menús en las posiciones `[inicio, fin)`.
+ */
+static void calcularTotalesMenus(long long inicio, long long fin, void *contexto) {
+    CalculoVentas *calculo = (CalculoVentas *)contexto;
+    for (long long i = inicio; i < fin; i++) {
+        Menu *menu = menuEnPosicion(calculo, (int)i);
+        double total = menu ? 0.0 : NAN;
+        for (int j = 0; menu && j < menu->numAlimentos; j++) {
+            Alimento *alimento = buscarAlimento(calculo->tablaAlimentos, menu->alimentos[j]);
+            if (alimento) total += alimento->precio;
+        }
+        calculo->totalesMenus[i] = total;
+    }
+}
+
+static void liberarParcial(const CalculoVentas *calculo, ParcialVentas *parcial) {
+    liberarContado(parcial->dias, REPORTE_NUM_DIAS, sizeof(Acumulado));
+    liberarContado(parcial->clientes, (size_t)calculo->clientes.numPosiciones, sizeof(Acumulado));
+    liberarContado(parcial->menus, (size_t)calculo->menus.numPosiciones, sizeof(Acumulado));
+    liberarContado(parcial, 1, sizeof(ParcialVentas));
+}
+
+/**
+ * @brief Toma un parcial libre o crea uno nuevo.
+ * @return El parcial, o NULL si no hay memoria (el cálculo queda marcado).
+ */
+static ParcialVentas *tomarParcial(CalculoVentas *calculo) {
+    pthread_mutex_lock(&calculo->candado);
+    ParcialVentas *parcial = calculo->libres;
+    if (parcial) {
+        calculo->libres = parcial->siguienteLibre;
+    } else if (!calculo->sinMemoria) {
+        parcial = (ParcialVentas *)reservarContado(1, sizeof(ParcialVentas));
+        if (parcial) {
+            parcial->dias = (Acumulado *)reservarContado(REPORTE_NUM_DIAS, sizeof(Acumulado));
+            parcial->clientes = (Acumulado *)reservarContado((size_t)calculo->clientes.numPosiciones, sizeof(Acumulado));
+            parcial->menus = (Acumulado *)reservarContado((size_t)calculo->menus.numPosiciones, sizeof(Acumulado));
+            if (!parcial->dias || !parcial->clientes || !parcial->menus) {
+                liberarParcial(calculo, parcial);
+                parcial = NULL;
+            }
+        }
+        if (parcial) {
+            parcial->siguiente = calculo->parciales;
+            calculo->parciales = parcial;
+            calculo->numParciales++;
+        } else {
+            calculo->sinMemoria = true;
+        }
+    }
+    pthread_mutex_unlock(&calculo->candado);
+    return parcial;
+}
+
+static void devolverParcial(CalculoVentas *calculo, ParcialVentas *parcial) {
+    pthread_mutex_lock(&calculo->candado);
+    parcial->siguienteLibre = calculo->libres;
+    calculo->libres = parcial;
+    pthread_mutex_unlock(&calculo->candado);
+}
+
+/**
+ * @brief Posición de una fecha en el reporte por día.
+ * @return La posición, o -1 si no hay fecha o está fuera de los años del reporte.
+ */
+static int posicionDia(Fecha fecha) {
+    unsigned posicion = (unsigned)fecha - (unsigned)REPORTE_PRIMER_DIA;
+    return posicion < (unsigned)REPORTE_NUM_DIAS ? (int)posicion : -1;
+}
+
+/**
+ * @brief Acumulado del estado de un pedido en un parcial, agregándolo si es nuevo.
+ */
+static Acumulado *acumuladoEstado(ParcialVentas *parcial, const char *estado) {
+    for (int i = 0; i < parcial->numEstados; i++) {
+        if (strcmp(parcial->nombresEstado[i], estado) == 0) return &parcial->estados[i];
+    }
+    if (parcial->numEstados == REPORTE_MAX_ESTADOS) return &parcial->estados[REPORTE_MAX_ESTADOS];
+    strcpy(parcial->nombresEstado[parcial->numEstados], estado);
+    return &parcial->estados[parcial->numEstados++];
+}
+
+/**
+ * @brief Suma un pedido a un parcial.
+ */
+static void sumarPedido(const CalculoVentas *calculo, ParcialVentas *parcial, const Pedido *pedido) {
+    double total = 0.0;
+    long long unidades = 0;
+    for (int j = 0; j < pedido->numMenus; j++) {
+        int posicion = posicionId(&calculo->menus, pedido->menus[j]);
+        if (posicion < 0 || isnan(calculo->totalesMenus[posicion])) {
+            parcial->menusFaltantes++;
+            continue;
+        }
+        total += calculo->totalesMenus[posicion];
+        unidades++;
+        Acumulado *menu = &parcial->menus[posicion];
+        menu->unidades++;
+        // Un pedido cuenta una vez por menú aunque lo incluya varias veces
+        int k = 0;
+        while (k < j && pedido->menus[k] != pedido->menus[j]) k++;
+        if (k == j) menu->pedidos++;
+    }
+
+    sumarAcumulado(&parcial->total, 1, unidades, total);
+    sumarAcumulado(acumuladoEstado(parcial, pedido->estado), 1, unidades, total);
+    int posicion = posicionDia(pedido->fecha);
+    if (posicion >= 0) sumarAcumulado(&parcial->dias[posicion], 1, unidades, total);
+    else parcial->fechasInvalidas++;
+    posicion = posicionId(&calculo->clientes, pedido->idCliente);
+    if (posicion >= 0) sumarAcumulado(&parcial->clientes[posicion], 1, unidades, total);
+    else parcial->clientesFaltantes++;
+}
+
+/**
+ * @brief Suma los pedidos de las ranuras `[inicio, fin)` al parcial del hilo.
+ *
+ * Cada ranura es una posición del arreglo directo o un bucket completo.
+ */
+static void sumarPedidos(long long inicio, long long fin, void *contexto) {
+    CalculoVentas *calculo = (CalculoVentas *)contexto;
+    ParcialVentas *parcial = tomarParcial(calculo);
+    if (!parcial) return;
+    PedidosHashTable *tabla = calculo->tablaPedidos;
+    for (long long i = inicio; i < fin; i++) {
+        bool directo = i < tabla->capacidadDirecta;
+        Pedido *pedido = directo ? tabla->directo[i] : tabla->buckets[i - tabla->capacidadDirecta];
+        // Los nodos del arreglo directo no se encadenan; los de un bucket sí
+        for (; pedido; pedido = directo ? NULL : pedido->next) sumarPedido(calculo, parcial, pedido);
+    }
+    devolverParcial(calculo, parcial);
+}
+
+/**
+ * @brief Suma de arreglos de acumulados: los de todos los parciales sobre el primero.
+ */
+typedef struct {
+    Acumulado **arreglos;
+    int numArreglos;
+} MezclaAcumulados;
+
+static void mezclarAcumulados(long long inicio, long long fin, void *contexto) {
+    MezclaAcumulados *mezcla = (MezclaAcumulados *)contexto;
+    Acumulado *destino = mezcla->arreglos[0];
+    for (int p = 1; p < mezcla->numArreglos; p++) {
+        const Acumulado *origen = mezcla->arreglos[p];
+        for (long long i = inicio; i < fin; i++) {
+            sumarAcumulado(&destino[i], origen[i].pedidos, origen[i].unidades, origen[i].ingresos);
+        }
+    }
+}
+
+/**
+ * @brief Suma en paralelo los arreglos de todos los parciales sobre el del primero.
+ * @param arreglos Un arreglo por parcial.
+ * @param numArreglos Número de parciales.
+ * @param numPosiciones Largo de los arreglos.
+ */
+static void mezclarArreglos(Acumulado **arreglos, int numArreglos, int numPosiciones) {
+    MezclaAcumulados mezcla = { arreglos, numArreglos };
+    if (numArreglos > 1) paraCadaRango(numPosiciones, 0, mezclarAcumulados, &mezcla);
+}
+
+/**
+ * @brief Suma los contadores y estados de todos los parciales sobre el primero.
+ */
+static void mezclarEstados(CalculoVentas *calculo) {
+    ParcialVentas *destino = calculo->parciales;
+    for (ParcialVentas *p = destino->siguiente; p; p = p->siguiente) {
+        sumarAcumulado(&destino->total, p->total.pedidos, p->total.unidades, p->total.ingresos);
+        destino->menusFaltantes += p->menusFaltantes;
+        destino->clientesFaltantes += p->clientesFaltantes;
+        destino->fechasInvalidas += p->fechasInvalidas;
+        for (int i = 0; i <= REPORTE_MAX_ESTADOS; i++) {
+            if (i >= p->numEstados && i < REPORTE_MAX_ESTADOS) continue;
+            Acumulado *estado = i < REPORTE_MAX_ESTADOS ? acumuladoEstado(destino, p->nombresEstado[i])
+                                                        : &destino->estados[REPORTE_MAX_ESTADOS];
+            sumarAcumulado(estado, p->estados[i].pedidos, p->estados[i].unidades, p->estados[i].ingresos);
+        }
+    }
+}
+
+/**
+ * @brief Copia a un reporte las posiciones con pedidos (o unidades) de un arreglo de acumulados.
+ * @param claves Clave de cada posición, o NULL para usar la posición misma.
+ * @return `true` si hubo memoria.
+ */
+static bool llenarFilas(ReporteVentas *reporte, TipoReporteVentas tipo, const Acumulado *acumulados, int numPosiciones,
+                        int (*clave)(const void *datos, int posicion), const void *datos) {
+    int numFilas = 0;
+    for (int i = 0; i < numPosiciones; i++) {
+        if (acumulados[i].unidades > 0 || acumulados[i].pedidos > 0) numFilas++;
+    }
+    FilaReporteVentas *filas = (FilaReporteVentas *)reservarContado((size_t)numFilas, sizeof(FilaReporteVentas));
+    if (!filas) return false;
+    numFilas = 0;
+    for (int i = 0; i < numPosiciones; i++) {
+        if (acumulados[i].unidades == 0 && acumulados[i].pedidos == 0) continue;
+        FilaReporteVentas *fila = &filas[numFilas++];
+        fila->clave = clave ? clave(datos, i) : i;
+        fila->pedidos = acumulados[i].pedidos;
+        fila->unidades = acumulados[i].unidades;
+        fila->ingresos = acumulados[i].ingresos;
+    }
+    reporte->filas[tipo] = filas;
+    reporte->numFilas[tipo] = numFilas;
+    return true;
+}
+
+static int claveDia(const void *datos, int posicion) {
+    (void)datos;
+    return REPORTE_PRIMER_DIA + posicion;
+}
+
+static int claveId(const void *datos, int posicion) {
+    return idEnPosicion((const IndiceIds *)datos, posicion);
+}
+
+/**
+ * @brief Arma las filas de los cinco reportes con los acumulados del primer parcial.
+ * @return `true` si hubo memoria.
+ */
+static bool armarReportes(CalculoVentas *calculo, ReporteVentas *reporte) {
+    ParcialVentas *suma = calculo->parciales;
+    reporte->pedidos = suma->total.pedidos;
+    reporte->unidades = suma->total.unidades;
+    reporte->ingresos = suma->total.ingresos;
+    reporte->menusFaltantes = suma->menusFaltantes;
+    reporte->clientesFaltantes = suma->clientesFaltantes;
+    reporte->fechasInvalidas = suma->fechasInvalidas;
+
+    // Un cliente del rango denso puede faltar: su posición existe aunque no haya registro
+    for (int i = 0; i < calculo->clientes.capacidadDirecta; i++) {
+        if (suma->clientes[i].pedidos == 0 || calculo->tablaClientes->directo[i]) continue;
+        reporte->clientesFaltantes += suma->clientes[i].pedidos;
+        memset(&suma->clientes[i], 0, sizeof(Acumulado));
+    }
+
+    // Ingresos por menú y, repartiendo cada menú vendido entre sus alimentos, por alimento
+    Acumulado *alimentos = (Acumulado *)reservarContado((size_t)calculo->alimentos.numPosiciones, sizeof(Acumulado));
+    if (!alimentos) return false;
+    for (int i = 0; i < calculo->menus.numPosiciones; i++) {
+        Acumulado *menu = &suma->menus[i];
+        if (menu->unidades == 0) continue;
+        menu->ingresos = menu->unidades * calculo->totalesMenus[i];
+        Menu *registro = menuEnPosicion(calculo, i);
+        for (int j = 0; j < registro->numAlimentos; j++) {
+            int posicion = posicionId(&calculo->alimentos, registro->alimentos[j]);
+            Alimento *alimento = posicion < 0 ? NULL : buscarAlimento(calculo->tablaAlimentos, registro->alimentos[j]);
+            if (!alimento) continue;
+            alimentos[posicion].pedidos = -1;
+            sumarAcumulado(&alimentos[posicion], 0, menu->unidades, menu->unidades * (double)alimento->precio);
+        }
+    }
+
+    bool correcto = llenarFilas(reporte, REPORTE_DIAS, suma->dias, REPORTE_NUM_DIAS, claveDia, NULL) &&
+                    llenarFilas(reporte, REPORTE_ALIMENTOS, alimentos, calculo->alimentos.numPosiciones, claveId,
+                                &calculo->alimentos) &&
+                    llenarFilas(reporte, REPORTE_MENUS, suma->menus, calculo->menus.numPosiciones, claveId,
+                                &calculo->menus) &&
+                    llenarFilas(reporte, REPORTE_CLIENTES, suma->clientes, calculo->clientes.numPosiciones, claveId,
+                                &calculo->clientes);
+    liberarContado(alimentos, (size_t)calculo->alimentos.numPosiciones, sizeof(Acumulado));
+    if (!correcto) return false;
+
+    int numEstados = suma->numEstados;
+    if (suma->estados[REPORTE_MAX_ESTADOS].pedidos > 0) {
+        strcpy(suma->nombresEstado[numEstados], "(otros)");
+        suma->estados[numEstados++] = suma->estados[REPORTE_MAX_ESTADOS];
+    }
+    memcpy(reporte->estados, suma->nombresEstado, sizeof(reporte->estados));
+    return llenarFilas(reporte, REPORTE_ESTADOS, suma->estados, numEstados, NULL, NULL);
+}
+
+/**
+ * @brief Calcula todos los reportes en una pasada paralela sobre los pedidos.
+ *
+ * Pasos: índices de clientes, menús y alimentos; total de cada menú (en paralelo);
+ * pasada sobre los pedidos con un parcial por hilo; suma de los parciales (en paralelo)
+ * y filas de cada reporte.
+ *
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param reporte Resultado (de salida); se libera con liberarReportesVentas.
+ * @return `true` si se calculó, `false` si no hubo memoria (el reporte queda vacío).
+ */
+bool calcularReportesVentas(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                            PedidosHashTable *tablaPedidos, ReporteVentas *reporte) {
+    memset(reporte, 0, sizeof(*reporte));
+    double inicio = omp_get_wtime();
+    CalculoVentas calculo;
+    memset(&calculo, 0, sizeof(calculo));
+    calculo.tablaAlimentos = tablaAlimentos;
+    calculo.tablaClientes = tablaClientes;
+    calculo.tablaMenus = tablaMenus;
+    calculo.tablaPedidos = tablaPedidos;
+    pthread_mutex_init(&calculo.candado, NULL);
+
+    bool correcto = indexarClientes(tablaClientes, &calculo.clientes) && indexarMenus(tablaMenus, &calculo.menus) &&
+                    indexarAlimentos(tablaAlimentos, &calculo.alimentos);
+    if (correcto) {
+        calculo.totalesMenus = (double *)reservarContado((size_t)calculo.menus.numPosiciones, sizeof(double));
+        correcto = calculo.totalesMenus != NULL;
+    }
+    if (correcto) {
+        paraCadaRango(calculo.menus.numPosiciones, RANURAS_POR_TAREA, calcularTotalesMenus, &calculo);
+        paraCadaRango(tablaPedidos->capacidadDirecta + PEDIDOS_TABLE_SIZE, RANURAS_POR_TAREA, sumarPedidos, &calculo);
+        correcto = !calculo.sinMemoria && calculo.parciales;
+    }
+    Acumulado **arreglos = NULL;
+    if (correcto) {
+        arreglos = (Acumulado **)malloc(3 * (size_t)calculo.numParciales * sizeof(Acumulado *));
+        correcto = arreglos != NULL;
+    }
+    if (correcto) {
+        Acumulado **dias = arreglos, **clientes = arreglos + calculo.numParciales;
+        Acumulado **menus = arreglos + 2 * calculo.numParciales;
+        int n = 0;
+        for (ParcialVentas *p = calculo.parciales; p; p = p->siguiente, n++) {
+            dias[n] = p->dias;
+            clientes[n] = p->clientes;
+            menus[n] = p->menus;
+        }
+        mezclarArreglos(dias, n, REPORTE_NUM_DIAS);
+        mezclarArreglos(clientes, n, calculo.clientes.numPosiciones);
+        mezclarArreglos(menus, n, calculo.menus.numPosiciones);
+        mezclarEstados(&calculo);
+        correcto = armarReportes(&calculo, reporte);
+    }
+    free(arreglos);
+
+    while (calculo.parciales) {
+        ParcialVentas *siguiente = calculo.parciales->siguiente;
+        liberarParcial(&calculo, calculo.parciales);
+        calculo.parciales = siguiente;
+    }
+    liberarContado(calculo.totalesMenus, (size_t)calculo.menus.numPosiciones, sizeof(double));
+    liberarIndice(&calculo.alimentos);
+    liberarIndice(&calculo.menus);
+    liberarIndice(&calculo.clientes);
+    pthread_mutex_destroy(&calculo.candado);
+
+    if (!correcto) {
+        liberarReportesVentas(reporte);
+        printf("\nError: No hay memoria suficiente para calcular los reportes de ventas.\n");
+        return false;
+    }
+    reporte->segundos = omp_get_wtime() - inicio;
+    return true;
+}
+
+/**
+ * @brief Escribe la clave de una fila como texto.
+ * @param tipo Reporte de la fila.
+ * @param reporte Reporte (para los nombres de los estados).
+ * @param fila Fila.
+ * @param texto Destino, de al menos 16 caracteres.
+ */
+static void textoClave(TipoReporteVentas tipo, const ReporteVentas *reporte, const FilaReporteVentas *fila, char *texto) {
+    if (tipo == REPORTE_DIAS) {
+        formatearFecha(fila->clave, texto);
+    } else if (tipo == REPORTE_ESTADOS) {
+        strcpy(texto, reporte->estados[fila->clave]);
+    } else {
+        sprintf(texto, "%d", fila->clave);
+    }
+}
+
+/**
+ * @brief Elige las filas con más ingresos (a igualdad, la primera).
+ * @param posiciones Posiciones elegidas, de mayor a menor ingreso (de salida).
+ * @return Número de filas elegidas (a lo más maxFilas).
+ */
+static int elegirMayores(const FilaReporteVentas *filas, int numFilas, int maxFilas, int *posiciones) {
+    int elegidas = 0;
+    for (int i = 0; i < numFilas; i++) {
+        int posicion = elegidas;
+        while (posicion > 0 && filas[i].ingresos > filas[posiciones[posicion - 1]].ingresos) posicion--;
+        if (posicion >= maxFilas) continue;
+        int ultimo = elegidas < maxFilas ? elegidas : maxFilas - 1;
+        memmove(&posiciones[posicion + 1], &posiciones[posicion], (size_t)(ultimo - posicion) * sizeof(int));
+        posiciones[posicion] = i;
+        if (elegidas < maxFilas) elegidas++;
+    }
+    return elegidas;
+}
+
+static int compararPosiciones(const void *a, const void *b) {
+    return compararIds(a, b);
+}
+
+/**
+ * @brief Imprime el resumen y, de cada reporte, las filas con más ingresos.
+ *
+ * Los días elegidos se imprimen en orden de fecha, y el reporte por estado, completo.
+ *
+ * @param reporte Reporte a imprimir.
+ * @param maxFilas Filas por reporte.
+ */
+void imprimirReportesVentas(const ReporteVentas *reporte, int maxFilas) {
+    static const char *const titulos[NUM_REPORTES_VENTAS] = {
+        "Días con más ingresos", "Alimentos con más ingresos", "Menús con más ingresos",
+        "Clientes con más ingresos", "Pedidos por estado"
+    };
+    static const char *const columnas[NUM_REPORTES_VENTAS] = { "Fecha", "ID", "ID", "ID", "Estado" };
+    if (maxFilas < 1) maxFilas = 1;
+    int *posiciones = (int *)malloc((size_t)(maxFilas > REPORTE_MAX_ESTADOS + 1 ? maxFilas : REPORTE_MAX_ESTADOS + 1) *
+                                    sizeof(int));
+    if (!posiciones) return;
+
+    printf("\nReportes de ventas calculados en %.3f s: %lld pedidos, %lld menús vendidos, ingresos %.2f\n",
+           reporte->segundos, reporte->pedidos, reporte->unidades, reporte->ingresos);
+    if (reporte->menusFaltantes + reporte->clientesFaltantes + reporte->fechasInvalidas > 0) {
+        printf("Advertencia: %lld referencias a menús inexistentes, %lld pedidos de clientes inexistentes y "
+               "%lld pedidos sin fecha o fuera de %d-%d.\n", reporte->menusFaltantes, reporte->clientesFaltantes, reporte->fechasInvalidas,
+               REPORTE_ANIO_MINIMO, REPORTE_ANIO_MAXIMO);
+    }
+    for (int tipo = 0; tipo < NUM_REPORTES_VENTAS; tipo++) {
+        const FilaReporteVentas *filas = reporte->filas[tipo];
+        int limite = tipo == REPORTE_ESTADOS ? REPORTE_MAX_ESTADOS + 1 : maxFilas;
+        int elegidas = elegirMayores(filas, reporte->numFilas[tipo], limite, posiciones);
+        if (tipo == REPORTE_DIAS) qsort(posiciones, (size_t)elegidas, sizeof(int), compararPosiciones);
+
+        printf("\n%s (%d en total):\n", titulos[tipo], reporte->numFilas[tipo]);
+        printf("  %-12s %12s %12s %16s\n", columnas[tipo], "Pedidos", "Unidades", "Ingresos");
+        for (int i = 0; i < elegidas; i++) {
+            const FilaReporteVentas *fila = &filas[posiciones[i]];
+            char clave[16], pedidos[24];
+            textoClave((TipoReporteVentas)tipo, reporte, fila, clave);
+            if (fila->pedidos < 0) strcpy(pedidos, "-");
+            else sprintf(pedidos, "%lld", fila->pedidos);
+            printf("  %-12s %12s %12lld %16.2f\n", clave, pedidos, fila->unidades, fila->ingresos);
+        }
+    }
+    free(posiciones);
+}
+
+/**
+ * @brief Escribe un campo de texto en CSV, entre comillas si lleva comas, comillas o saltos.
+ */
+static void escribirCampoCSV(FILE *archivo, const char *texto) {
+    if (!strpbrk(texto, ",\"\r\n")) {
+        fputs(texto, archivo);
+        return;
+    }
+    fputc('"', archivo);
+    for (const char *c = texto; *c; c++) {
+        if (*c == '"') fputc('"', archivo);
+        fputc(*c, archivo);
+    }
+    fputc('"', archivo);
+}
+
+/**
+ * @brief Guarda todas las filas de los reportes en un CSV.
+ * @param reporte Reporte a guardar.
+ * @param nombreArchivo Archivo destino.
+ * @return `true` si se escribió completo.
+ */
+bool guardarReportesVentas(const ReporteVentas *reporte, const char *nombreArchivo) {
+    FILE *archivo = fopen(nombreArchivo, "w");
+    if (!archivo) {
+        printf("\nError: No se pudo crear el archivo '%s'.\n", nombreArchivo);
+        return false;
+    }
+    fprintf(archivo, "reporte,clave,pedidos,unidades,ingresos\n");
+    for (int tipo = 0; tipo < NUM_REPORTES_VENTAS; tipo++) {
+        for (int i = 0; i < reporte->numFilas[tipo]; i++) {
+            const FilaReporteVentas *fila = &reporte->filas[tipo][i];
+            char clave[16];
+            textoClave((TipoReporteVentas)tipo, reporte, fila, clave);
+            fprintf(archivo, "%s,", nombresReporteVentas[tipo]);
+            escribirCampoCSV(archivo, clave);
+            if (fila->pedidos < 0) fprintf(archivo, ",,%lld,%.2f\n", fila->unidades, fila->ingresos);
+            else fprintf(archivo, ",%lld,%lld,%.2f\n", fila->pedidos, fila->unidades, fila->ingresos);
+        }
+    }
+    bool correcto = !ferror(archivo);
+    correcto = fclose(archivo) == 0 && correcto;
+    if (!correcto) printf("\nError: No se pudo escribir el archivo '%s'.\n", nombreArchivo);
+    else MENSAJE("\nReportes de ventas guardados en '%s'.\n", nombreArchivo);
+    return correcto;
+}
+
+/**
+ * @brief Libera las filas de un reporte y lo deja vacío.
+ * @param reporte Reporte a liberar.
+ */
+void liberarReportesVentas(ReporteVentas *reporte) {
+    for (int tipo = 0; tipo < NUM_REPORTES_VENTAS; tipo++) {
+        liberarContado(reporte->filas[tipo], (size_t)reporte->numFilas[tipo], sizeof(FilaReporteVentas));
+    }
+    memset(reporte, 0, sizeof(*reporte));
+}
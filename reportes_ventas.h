@@ -0,0 +1,126 @@
+/**
+ * @file reportes_ventas.h
+ * @brief Reportes de ventas: ingresos por día, por alimento, por menú y por cliente, y pedidos por estado.
+ *
+ * Los reportes salen de una sola pasada paralela sobre la tabla de pedidos. Antes de
+ * recorrerla se calcula el total de cada menú (la suma de los precios de sus alimentos)
+ * en un arreglo indexado igual que la tabla de menús, de modo que sumar un pedido no
+ * busca nada en las tablas de menús ni de alimentos.
+ *
+ * Cada hilo acumula en sus propios arreglos (uno por día, cliente y menú) y los arreglos
+ * se suman al final, también en paralelo; los ingresos por alimento se obtienen después,
+ * repartiendo las unidades vendidas de cada menú entre sus alimentos. El total de un
+ * pedido es el mismo que el de totales_pedidos.h: un menú que no existe no suma, y un
+ * alimento que no existe suma 0.
+ *
+ * Los reportes solo leen las tablas; se calculan con el candado de las tablas tomado.
+ */
+
+#ifndef REPORTES_VENTAS_H
+#define REPORTES_VENTAS_H
+
+#include <stdbool.h>
+#include "fechas.h"
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Primer año del reporte por día; las fechas fuera de [REPORTE_ANIO_MINIMO, REPORTE_ANIO_MAXIMO] no entran.
+#define REPORTE_ANIO_MINIMO 1970
+
+/// Último año del reporte por día.
+#define REPORTE_ANIO_MAXIMO 2099
+
+/// Estados distintos que se separan; los demás se suman en "(otros)".
+#define REPORTE_MAX_ESTADOS 16
+
+/**
+ * @brief Reportes que se calculan.
+ */
+typedef enum {
+    REPORTE_DIAS,       ///< Por fecha del pedido.
+    REPORTE_ALIMENTOS,  ///< Por alimento (según los menús vendidos).
+    REPORTE_MENUS,      ///< Por menú.
+    REPORTE_CLIENTES,   ///< Por cliente.
+    REPORTE_ESTADOS,    ///< Por estado del pedido.
+    NUM_REPORTES_VENTAS
+} TipoReporteVentas;
+
+/// Nombre de cada reporte, en el orden de TipoReporteVentas (es la primera columna del CSV).
+extern const char *const nombresReporteVentas[NUM_REPORTES_VENTAS];
+
+/**
+ * @brief Una fila de un reporte.
+ *
+ * La clave depende del reporte: la fecha (una Fecha, ver fechas.h), el ID del alimento,
+ * menú o cliente, o la posición del estado en ReporteVentas::estados.
+ */
+typedef struct {
+    int clave;           ///< Fecha, ID o posición del estado.
+    long long pedidos;   ///< Pedidos (con el menú, para el reporte por menú; -1 en el de alimentos).
+    long long unidades;  ///< Menús vendidos (alimentos servidos, en el reporte por alimento).
+    double ingresos;     ///< Suma de los precios de lo vendido.
+} FilaReporteVentas;
+
+/**
+ * @brief Resultado de calcularReportesVentas.
+ *
+ * Las filas van en el orden de su clave: por fecha, por ID (los IDs fuera del rango
+ * denso de su tabla, al final) o por estado en el orden en que aparecen. Solo hay filas
+ * para las claves con alguna venta.
+ */
+typedef struct {
+    FilaReporteVentas *filas[NUM_REPORTES_VENTAS]; ///< Filas de cada reporte.
+    int numFilas[NUM_REPORTES_VENTAS];             ///< Número de filas de cada reporte.
+    char estados[REPORTE_MAX_ESTADOS + 1][16];     ///< Nombre de cada estado (claves del reporte por estado).
+    long long pedidos;           ///< Pedidos recorridos.
+    long long unidades;          ///< Menús vendidos.
+    double ingresos;             ///< Suma de los totales de todos los pedidos.
+    long long menusFaltantes;    ///< Referencias a menús que no existen (no suman).
+    long long clientesFaltantes; ///< Pedidos de clientes que no existen (fuera del reporte por cliente).
+    long long fechasInvalidas;   ///< Pedidos sin fecha o fuera de los años del reporte (fuera del reporte por día).
+    double segundos;             ///< Duración del cálculo.
+} ReporteVentas;
+
+/**
+ * @brief Calcula todos los reportes en una pasada paralela sobre los pedidos.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param reporte Resultado (de salida); se libera con liberarReportesVentas.
+ * @return `true` si se calculó, `false` si no hubo memoria (el reporte queda vacío).
+ */
+bool calcularReportesVentas(HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus,
+                            PedidosHashTable *tablaPedidos, ReporteVentas *reporte);
+
+/**
+ * @brief Imprime el resumen y, de cada reporte, las filas con más ingresos.
+ *
+ * Los días elegidos se imprimen en orden de fecha, y el reporte por estado, completo.
+ *
+ * @param reporte Reporte a imprimir.
+ * @param maxFilas Filas por reporte.
+ */
+void imprimirReportesVentas(const ReporteVentas *reporte, int maxFilas);
+
+/**
+ * @brief Guarda todas las filas de los reportes en un CSV.
+ *
+ * Columnas: `reporte,clave,pedidos,unidades,ingresos`, con la fecha como AAAA-MM-DD y
+ * `pedidos` vacío en el reporte por alimento.
+ *
+ * @param reporte Reporte a guardar.
+ * @param nombreArchivo Archivo destino.
+ * @return `true` si se escribió completo.
+ */
+bool guardarReportesVentas(const ReporteVentas *reporte, const char *nombreArchivo);
+
+/**
+ * @brief Libera las filas de un reporte y lo deja vacío.
+ * @param reporte Reporte a liberar.
+ */
+void liberarReportesVentas(ReporteVentas *reporte);
+
+#endif // REPORTES_VENTAS_H
@@ -5,143 +5,467 @@
 #include "hash_clientes.h"
 #include "hash_menus.h"
 #include "hash_pedidos.h"
+#include "fechas.h"
+#include "buffer_salida.h"
+#include "mensajes.h"
+#include "tareas.h"
+
+/// Ranuras del arreglo directo que formatea cada fragmento.
+#define RANURAS_POR_FRAGMENTO (1 << 16)
+
+/// Buckets de la tabla hash que formatea cada fragmento.
+#define BUCKETS_POR_FRAGMENTO 8
+
+/// Fragmentos por hilo que se formatean antes de escribir al archivo (limita la memoria usada).
+#define FRAGMENTOS_POR_HILO 4
+
+/**
+ * @brief Sección del archivo YAML a la que pertenece un fragmento.
+ */
+typedef enum {
+    SECCION_TEXTO,     ///< Texto fijo (inicio del documento o encabezado de sección).
+    SECCION_ALIMENTOS,
+    SECCION_CLIENTES,
+    SECCION_MENUS,
+    SECCION_PEDIDOS
+} Seccion;
 
 /**
- * @brief Guarda los alimentos en un archivo en formato YAML.
+ * @brief Porción del archivo que un hilo puede formatear de forma independiente.
  *
- * Esta función recorre la tabla hash de alimentos y escribe su contenido
- * en un archivo en formato YAML.
+ * Los fragmentos se listan en el mismo orden en que aparecen en el archivo, de modo
+ * que concatenarlos produce exactamente la salida secuencial.
+ */
+typedef struct {
+    Seccion seccion;    ///< Tabla que se recorre (o SECCION_TEXTO).
+    const char *texto;  ///< Texto fijo a escribir (solo para SECCION_TEXTO).
+    bool buckets;       ///< `true` si [inicio, fin) son buckets, `false` si son ranuras del arreglo directo.
+    int inicio;         ///< Primera ranura o bucket del fragmento.
+    int fin;            ///< Ranura o bucket siguiente al último del fragmento.
+} Fragmento;
+
+/**
+ * @brief Escribe un alimento como elemento de la secuencia YAML de alimentos.
+ *
+ * @param salida Buffer de salida hacia el archivo donde se guardarán los datos.
+ * @param actual Alimento a escribir.
+ */
+static void guardarAlimento(BufferSalida *salida, Alimento *actual) {
+    bufferEscribirLiteral(salida, "  - id: ");
+    bufferEscribirEntero(salida, actual->id);
+    bufferEscribirLiteral(salida, "\n    nombre: \"");
+    bufferEscribirCadena(salida, textoCadena(actual->nombre));
+    bufferEscribirLiteral(salida, "\"\n    precio: ");
+    bufferEscribirDecimal2(salida, actual->precio);
+    if (actual->disponible) {
+        bufferEscribirLiteral(salida, "\n    disponible: Si\n");
+    } else {
+        bufferEscribirLiteral(salida, "\n    disponible: No\n");
+    }
+}
+
+/**
+ * @brief Escribe los alimentos de un rango del arreglo directo o de los buckets.
  *
- * @param archivo Puntero al archivo donde se guardarán los datos.
+ * @param salida Buffer donde se escribe el texto.
  * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param buckets `true` si el rango es de buckets, `false` si es del arreglo directo.
+ * @param inicio Primera ranura o bucket del rango.
+ * @param fin Ranura o bucket siguiente al último del rango.
  */
-void guardarAlimentos(FILE *archivo, HashTable *tablaAlimentos) {
-    fprintf(archivo, "alimentos:\n");
-    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+static void guardarAlimentos(BufferSalida *salida, HashTable *tablaAlimentos, bool buckets, int inicio, int fin) {
+    if (!buckets) { // Rango denso en orden de ID
+        for (int i = inicio; i < fin; i++) {
+            if (tablaAlimentos->directo[i]) {
+                guardarAlimento(salida, tablaAlimentos->directo[i]);
+            }
+        }
+        return;
+    }
+    for (int i = inicio; i < fin; i++) {
         Alimento *actual = tablaAlimentos->buckets[i];
         while (actual) {
-            fprintf(archivo, "  - id: %d\n", actual->id);
-            fprintf(archivo, "    nombre: \"%s\"\n", actual->nombre);
-            fprintf(archivo, "    precio: %.2f\n", actual->precio);
-            fprintf(archivo, "    disponible: %s\n", actual->disponible ? "Si" : "No");
+            guardarAlimento(salida, actual);
             actual = actual->next;
         }
     }
 }
 
 /**
- * @brief Guarda los clientes en un archivo en formato YAML.
+ * @brief Escribe un cliente como elemento de la secuencia YAML de clientes.
  *
- * Esta función recorre la tabla hash de clientes y escribe su contenido
- * en un archivo en formato YAML.
+ * @param salida Buffer de salida hacia el archivo donde se guardarán los datos.
+ * @param actual Cliente a escribir.
+ */
+static void guardarCliente(BufferSalida *salida, Cliente *actual) {
+    bufferEscribirLiteral(salida, "  - id: ");
+    bufferEscribirEntero(salida, actual->idCliente);
+    bufferEscribirLiteral(salida, "\n    nombre: \"");
+    bufferEscribirCadena(salida, textoCadena(actual->nombre));
+    bufferEscribirLiteral(salida, "\"\n    telefono: \"");
+    bufferEscribirCadena(salida, actual->telefono);
+    bufferEscribirLiteral(salida, "\"\n");
+}
+
+/**
+ * @brief Escribe los clientes de un rango del arreglo directo o de los buckets.
  *
- * @param archivo Puntero al archivo donde se guardarán los datos.
+ * @param salida Buffer donde se escribe el texto.
  * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param buckets `true` si el rango es de buckets, `false` si es del arreglo directo.
+ * @param inicio Primera ranura o bucket del rango.
+ * @param fin Ranura o bucket siguiente al último del rango.
  */
-void guardarClientes(FILE *archivo, ClientesHashTable *tablaClientes) {
-    fprintf(archivo, "clientes:\n");
-    for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
+static void guardarClientes(BufferSalida *salida, ClientesHashTable *tablaClientes, bool buckets, int inicio, int fin) {
+    if (!buckets) { // Rango denso en orden de ID
+        for (int i = inicio; i < fin; i++) {
+            if (tablaClientes->directo[i]) {
+                guardarCliente(salida, tablaClientes->directo[i]);
+            }
+        }
+        return;
+    }
+    for (int i = inicio; i < fin; i++) {
         Cliente *actual = tablaClientes->buckets[i];
         while (actual) {
-            fprintf(archivo, "  - id: %d\n", actual->idCliente);
-            fprintf(archivo, "    nombre: \"%s\"\n", actual->nombre);
-            fprintf(archivo, "    telefono: \"%s\"\n", actual->telefono);
+            guardarCliente(salida, actual);
             actual = actual->next;
         }
     }
 }
 
 /**
- * @brief Guarda los menús en un archivo en formato YAML.
+ * @brief Escribe un menú y sus alimentos como elemento de la secuencia YAML de menús.
  *
- * Esta función recorre la tabla hash de menús y escribe su contenido,
- * incluyendo los alimentos asociados, en un archivo en formato YAML.
+ * En modo normalizado los alimentos se escriben solo como lista de IDs, igual que los
+ * menús de un pedido (`alimentos: [1, 2]`), sin buscar cada alimento en su tabla.
+ *
+ * @param salida Buffer de salida hacia el archivo donde se guardarán los datos.
+ * @param actual Menú a escribir.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param normalizado `true` para escribir solo los IDs de los alimentos.
+ */
+static void guardarMenu(BufferSalida *salida, Menu *actual, HashTable *tablaAlimentos, bool normalizado) {
+    char textoFecha[FECHA_TEXTO];
+    bufferEscribirLiteral(salida, "  - id: ");
+    bufferEscribirEntero(salida, actual->idMenu);
+    bufferEscribirLiteral(salida, "\n    fecha: \"");
+    bufferEscribirCadena(salida, formatearFecha(actual->fecha, textoFecha));
+    if (normalizado) {
+        bufferEscribirLiteral(salida, "\"\n    alimentos: [");
+        for (int j = 0; j < actual->numAlimentos; j++) {
+            bufferEscribirEntero(salida, actual->alimentos[j]);
+            if (j < actual->numAlimentos - 1) bufferEscribirLiteral(salida, ", ");
+        }
+        bufferEscribirLiteral(salida, "]\n");
+        return;
+    }
+    bufferEscribirLiteral(salida, "\"\n    alimentos:\n");
+    for (int j = 0; j < actual->numAlimentos; j++) {
+        Alimento *alimento = buscarAlimento(tablaAlimentos, actual->alimentos[j]);
+        if (alimento) {
+            bufferEscribirLiteral(salida, "      - id: ");
+            bufferEscribirEntero(salida, alimento->id);
+            bufferEscribirLiteral(salida, "\n        nombre: \"");
+            bufferEscribirCadena(salida, textoCadena(alimento->nombre));
+            bufferEscribirLiteral(salida, "\"\n        precio: ");
+            bufferEscribirDecimal2(salida, alimento->precio);
+            if (alimento->disponible) {
+                bufferEscribirLiteral(salida, "\n        disponible: Si\n");
+            } else {
+                bufferEscribirLiteral(salida, "\n        disponible: No\n");
+            }
+        } else {
+            bufferEscribirLiteral(salida, "      - id: ");
+            bufferEscribirEntero(salida, actual->alimentos[j]);
+            bufferEscribirLiteral(salida, "\n        error: \"No encontrado\"\n");
+        }
+    }
+}
+
+/**
+ * @brief Escribe los menús de un rango del arreglo directo o de los buckets.
  *
- * @param archivo Puntero al archivo donde se guardarán los datos.
+ * @param salida Buffer donde se escribe el texto.
  * @param tablaMenus Puntero a la tabla hash de menús.
  * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param normalizado `true` para escribir solo los IDs de los alimentos.
+ * @param buckets `true` si el rango es de buckets, `false` si es del arreglo directo.
+ * @param inicio Primera ranura o bucket del rango.
+ * @param fin Ranura o bucket siguiente al último del rango.
  */
-void guardarMenus(FILE *archivo, MenuHashTable *tablaMenus, HashTable *tablaAlimentos) {
-    fprintf(archivo, "menus:\n");
-    for (int i = 0; i < MENU_TABLE_SIZE; i++) {
+static void guardarMenus(BufferSalida *salida, MenuHashTable *tablaMenus, HashTable *tablaAlimentos, bool normalizado,
+                         bool buckets, int inicio, int fin) {
+    if (!buckets) { // Rango denso en orden de ID
+        for (int i = inicio; i < fin; i++) {
+            if (tablaMenus->directo[i]) {
+                guardarMenu(salida, tablaMenus->directo[i], tablaAlimentos, normalizado);
+            }
+        }
+        return;
+    }
+    for (int i = inicio; i < fin; i++) {
         Menu *actual = tablaMenus->buckets[i];
         while (actual) {
-            fprintf(archivo, "  - id: %d\n", actual->idMenu);
-            fprintf(archivo, "    fecha: \"%s\"\n", actual->fecha);
-            fprintf(archivo, "    alimentos:\n");
-            for (int j = 0; j < actual->numAlimentos; j++) {
-                Alimento *alimento = buscarAlimento(tablaAlimentos, actual->alimentos[j]);
-                if (alimento) {
-                    fprintf(archivo, "      - id: %d\n", alimento->id);
-                    fprintf(archivo, "        nombre: \"%s\"\n", alimento->nombre);
-                    fprintf(archivo, "        precio: %.2f\n", alimento->precio);
-                    fprintf(archivo, "        disponible: %s\n", alimento->disponible ? "Si" : "No");
-                } else {
-                    fprintf(archivo, "      - id: %d\n", actual->alimentos[j]);
-                    fprintf(archivo, "        error: \"No encontrado\"\n");
-                }
-            }
+            guardarMenu(salida, actual, tablaAlimentos, normalizado);
             actual = actual->next;
         }
     }
 }
 
 /**
- * @brief Guarda los pedidos en un archivo en formato YAML.
+ * @brief Escribe un pedido como elemento de la secuencia YAML de pedidos.
  *
- * Esta función recorre la tabla hash de pedidos y escribe su contenido
- * en un archivo en formato YAML.
+ * @param salida Buffer de salida hacia el archivo donde se guardarán los datos.
+ * @param actual Pedido a escribir.
+ */
+static void guardarPedido(BufferSalida *salida, Pedido *actual) {
+    char textoFecha[FECHA_TEXTO];
+    bufferEscribirLiteral(salida, "  - id: ");
+    bufferEscribirEntero(salida, actual->idPedido);
+    bufferEscribirLiteral(salida, "\n    cliente_id: ");
+    bufferEscribirEntero(salida, actual->idCliente);
+    bufferEscribirLiteral(salida, "\n    fecha: \"");
+    bufferEscribirCadena(salida, formatearFecha(actual->fecha, textoFecha));
+    bufferEscribirLiteral(salida, "\"\n    estado: \"");
+    bufferEscribirCadena(salida, actual->estado);
+    bufferEscribirLiteral(salida, "\"\n    menus: [");
+    for (int j = 0; j < actual->numMenus; j++) {
+        bufferEscribirEntero(salida, actual->menus[j]);
+        if (j < actual->numMenus - 1) bufferEscribirLiteral(salida, ", ");
+    }
+    bufferEscribirLiteral(salida, "]\n");
+}
+
+/**
+ * @brief Escribe los pedidos de un rango del arreglo directo o de los buckets.
  *
- * @param archivo Puntero al archivo donde se guardarán los datos.
+ * @param salida Buffer donde se escribe el texto.
  * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param buckets `true` si el rango es de buckets, `false` si es del arreglo directo.
+ * @param inicio Primera ranura o bucket del rango.
+ * @param fin Ranura o bucket siguiente al último del rango.
  */
-void guardarPedidos(FILE *archivo, PedidosHashTable *tablaPedidos) {
-    fprintf(archivo, "pedidos:\n");
-    for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
+static void guardarPedidos(BufferSalida *salida, PedidosHashTable *tablaPedidos, bool buckets, int inicio, int fin) {
+    if (!buckets) { // Rango denso en orden de ID
+        for (int i = inicio; i < fin; i++) {
+            if (tablaPedidos->directo[i]) {
+                guardarPedido(salida, tablaPedidos->directo[i]);
+            }
+        }
+        return;
+    }
+    for (int i = inicio; i < fin; i++) {
         Pedido *actual = tablaPedidos->buckets[i];
         while (actual) {
-            fprintf(archivo, "  - id: %d\n", actual->idPedido);
-            fprintf(archivo, "    cliente_id: %d\n", actual->idCliente);
-            fprintf(archivo, "    fecha: \"%s\"\n", actual->fecha);
-            fprintf(archivo, "    estado: \"%s\"\n", actual->estado);
-            fprintf(archivo, "    menus: [");
-            for (int j = 0; j < actual->numMenus; j++) {
-                fprintf(archivo, "%d", actual->menus[j]);
-                if (j < actual->numMenus - 1) fprintf(archivo, ", ");
-            }
-            fprintf(archivo, "]\n");
+            guardarPedido(salida, actual);
             actual = actual->next;
         }
     }
 }
 
 /**
- * @brief Serializa todos los datos de las tablas hash en un archivo.
+ * @brief Agrega a la lista los fragmentos de una sección: su encabezado, el arreglo directo y los buckets.
  *
- * Esta función coordina la serialización de alimentos, clientes, menús y pedidos,
- * y los guarda en un archivo en formato YAML.
+ * @param fragmentos Lista de fragmentos (con espacio suficiente).
+ * @param numFragmentos Número de fragmentos en la lista; se actualiza.
+ * @param seccion Tabla de la sección.
+ * @param encabezado Encabezado YAML de la sección.
+ * @param capacidadDirecta Ranuras del arreglo directo de la tabla.
+ * @param numBuckets Número de buckets de la tabla.
+ */
+static void agregarFragmentosSeccion(Fragmento *fragmentos, int *numFragmentos, Seccion seccion,
+                                     const char *encabezado, int capacidadDirecta, int numBuckets) {
+    fragmentos[(*numFragmentos)++] = (Fragmento){ SECCION_TEXTO, encabezado, false, 0, 0 };
+    for (int i = 0; i < capacidadDirecta; i += RANURAS_POR_FRAGMENTO) {
+        int fin = capacidadDirecta - i > RANURAS_POR_FRAGMENTO ? i + RANURAS_POR_FRAGMENTO : capacidadDirecta;
+        fragmentos[(*numFragmentos)++] = (Fragmento){ seccion, NULL, false, i, fin };
+    }
+    for (int i = 0; i < numBuckets; i += BUCKETS_POR_FRAGMENTO) {
+        int fin = numBuckets - i > BUCKETS_POR_FRAGMENTO ? i + BUCKETS_POR_FRAGMENTO : numBuckets;
+        fragmentos[(*numFragmentos)++] = (Fragmento){ seccion, NULL, true, i, fin };
+    }
+}
+
+/**
+ * @brief Formatea un fragmento en su buffer.
+ *
+ * @param salida Buffer donde se escribe el texto.
+ * @param fragmento Fragmento a formatear.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param normalizado `true` para escribir los menús solo con los IDs de sus alimentos.
+ */
+static void formatearFragmento(BufferSalida *salida, const Fragmento *fragmento, HashTable *tablaAlimentos,
+                               ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos,
+                               bool normalizado) {
+    switch (fragmento->seccion) {
+        case SECCION_TEXTO:
+            bufferEscribirCadena(salida, fragmento->texto);
+            break;
+        case SECCION_ALIMENTOS:
+            guardarAlimentos(salida, tablaAlimentos, fragmento->buckets, fragmento->inicio, fragmento->fin);
+            break;
+        case SECCION_CLIENTES:
+            guardarClientes(salida, tablaClientes, fragmento->buckets, fragmento->inicio, fragmento->fin);
+            break;
+        case SECCION_MENUS:
+            guardarMenus(salida, tablaMenus, tablaAlimentos, normalizado, fragmento->buckets, fragmento->inicio, fragmento->fin);
+            break;
+        case SECCION_PEDIDOS:
+            guardarPedidos(salida, tablaPedidos, fragmento->buckets, fragmento->inicio, fragmento->fin);
+            break;
+    }
+}
+
+/**
+ * @brief Fragmentos de una tanda y las tablas de las que se formatean.
+ */
+typedef struct {
+    BufferSalida *buffers;        ///< Un buffer por fragmento de la tanda.
+    const Fragmento *fragmentos;  ///< Primer fragmento de la tanda.
+    HashTable *tablaAlimentos;
+    ClientesHashTable *tablaClientes;
+    MenuHashTable *tablaMenus;
+    PedidosHashTable *tablaPedidos;
+    bool normalizado;
+} TandaFragmentos;
+
+/**
+ * @brief Formatea los fragmentos `[inicio, fin)` de una tanda, cada uno en su buffer.
+ * @param inicio Primer fragmento.
+ * @param fin Fragmento siguiente al último.
+ * @param contexto Puntero a la TandaFragmentos.
+ */
+static void formatearTanda(long long inicio, long long fin, void *contexto) {
+    TandaFragmentos *tanda = (TandaFragmentos *)contexto;
+    for (long long i = inicio; i < fin; i++) {
+        tanda->buffers[i].longitud = 0;
+        formatearFragmento(&tanda->buffers[i], &tanda->fragmentos[i], tanda->tablaAlimentos, tanda->tablaClientes,
+                           tanda->tablaMenus, tanda->tablaPedidos, tanda->normalizado);
+    }
+}
+
+/**
+ * @brief Serializa todos los datos de las tablas hash en un archivo YAML.
+ *
+ * El archivo se divide en fragmentos (encabezados, rangos del arreglo directo y
+ * grupos de buckets) que se formatean en paralelo en el pool de tareas (ver tareas.h),
+ * cada uno en su propio buffer.
+ * Los buffers se escriben después en el orden del archivo, por lo que el resultado
+ * es idéntico al de una escritura secuencial. Para acotar la memoria, los fragmentos
+ * se procesan por tandas de `FRAGMENTOS_POR_HILO` por hilo.
  *
  * @param nombreArchivo Nombre del archivo donde se guardarán los datos serializados.
  * @param tablaAlimentos Puntero a la tabla hash de alimentos.
  * @param tablaClientes Puntero a la tabla hash de clientes.
  * @param tablaMenus Puntero a la tabla hash de menús.
  * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param normalizado `true` para escribir los menús solo con los IDs de sus alimentos.
+ * @return `true` si el archivo se escribió completo, `false` en caso contrario.
  */
-void serializarDatos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+static bool serializar(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                       MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, bool normalizado) {
+    // Inicio del documento, más encabezado, rangos directos y grupos de buckets por tabla
+    int capacidades[4] = { tablaAlimentos->capacidadDirecta, tablaClientes->capacidadDirecta,
+                           tablaMenus->capacidadDirecta, tablaPedidos->capacidadDirecta };
+    int numBuckets[4] = { HASH_TABLE_SIZE, CLIENTES_TABLE_SIZE, MENU_TABLE_SIZE, PEDIDOS_TABLE_SIZE };
+    int maxFragmentos = 1;
+    for (int i = 0; i < 4; i++) {
+        maxFragmentos += 1 + (capacidades[i] + RANURAS_POR_FRAGMENTO - 1) / RANURAS_POR_FRAGMENTO
+                           + (numBuckets[i] + BUCKETS_POR_FRAGMENTO - 1) / BUCKETS_POR_FRAGMENTO;
+    }
+
+    int porTanda = hilosPoolTareas() * FRAGMENTOS_POR_HILO;
+    Fragmento *fragmentos = (Fragmento *)malloc(maxFragmentos * sizeof(Fragmento));
+    BufferSalida *buffers = (BufferSalida *)calloc(porTanda, sizeof(BufferSalida));
+    bool correcto = (fragmentos != NULL && buffers != NULL);
+    for (int i = 0; correcto && i < porTanda; i++) {
+        correcto = iniciarBufferSalida(&buffers[i], NULL, BUFFER_SALIDA_TAMANO);
+    }
+    if (!correcto) {
+        printf("\nError: No hay memoria para el buffer de escritura.\n");
+        for (int i = 0; buffers && i < porTanda; i++) free(buffers[i].datos);
+        free(buffers);
+        free(fragmentos);
+        return false;
+    }
+
+    int numFragmentos = 0;
+    // Agregar el indicador de inicio del documento YAML
+    fragmentos[numFragmentos++] = (Fragmento){ SECCION_TEXTO, "---\n", false, 0, 0 };
+    agregarFragmentosSeccion(fragmentos, &numFragmentos, SECCION_ALIMENTOS, "alimentos:\n", capacidades[0], numBuckets[0]);
+    agregarFragmentosSeccion(fragmentos, &numFragmentos, SECCION_CLIENTES, "clientes:\n", capacidades[1], numBuckets[1]);
+    agregarFragmentosSeccion(fragmentos, &numFragmentos, SECCION_MENUS, "menus:\n", capacidades[2], numBuckets[2]);
+    agregarFragmentosSeccion(fragmentos, &numFragmentos, SECCION_PEDIDOS, "pedidos:\n", capacidades[3], numBuckets[3]);
+
     FILE *archivo = fopen(nombreArchivo, "w");
     if (!archivo) {
         printf("\nError: No se pudo abrir el archivo '%s' para escritura.\n", nombreArchivo);
-        return;
+        correcto = false;
     }
 
-    // Agregar el indicador de inicio del documento YAML
-    fprintf(archivo, "---\n");
+    for (int base = 0; correcto && base < numFragmentos; base += porTanda) {
+        int enTanda = numFragmentos - base < porTanda ? numFragmentos - base : porTanda;
 
-    guardarAlimentos(archivo, tablaAlimentos);
-    guardarClientes(archivo, tablaClientes);
-    guardarMenus(archivo, tablaMenus, tablaAlimentos);
-    guardarPedidos(archivo, tablaPedidos);
+        TandaFragmentos tanda = { buffers, fragmentos + base, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos,
+                                  normalizado };
+        paraCadaRango(enTanda, 1, formatearTanda, &tanda); // Un fragmento por tarea
 
-    fclose(archivo);
-    printf("\nDatos guardados exitosamente en '%s'.\n", nombreArchivo);
+        for (int i = 0; i < enTanda; i++) {
+            if (buffers[i].error) correcto = false;
+        }
+        if (correcto && !escribirBuffersEnOrden(archivo, buffers, enTanda)) correcto = false;
+        if (!correcto) {
+            printf("\nError: No se pudieron escribir todos los datos en '%s'.\n", nombreArchivo);
+        }
+    }
+
+    for (int i = 0; i < porTanda; i++) liberarBufferSalida(&buffers[i]);
+    free(buffers);
+    free(fragmentos);
+    if (!archivo) return false;
+    if (fclose(archivo) != 0 && correcto) {
+        printf("\nError: No se pudieron escribir todos los datos en '%s'.\n", nombreArchivo);
+        correcto = false;
+    }
+    if (correcto) {
+        MENSAJE("\nDatos guardados exitosamente en '%s'.\n", nombreArchivo);
+    }
+    return correcto;
+}
+
+/**
+ * @brief Serializa todos los datos de las tablas hash en un archivo.
+ *
+ * Esta función coordina la serialización de alimentos, clientes, menús y pedidos,
+ * y los guarda en un archivo en formato YAML. Cada menú repite el nombre, precio y
+ * disponibilidad de sus alimentos.
+ *
+ * @param nombreArchivo Nombre del archivo donde se guardarán los datos serializados.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si el archivo se escribió completo, `false` en caso contrario.
+ */
+bool serializarDatos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    return serializar(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, false);
+}
+
+/**
+ * @brief Serializa los datos como `serializarDatos`, pero cada menú guarda solo los IDs de sus alimentos.
+ *
+ * @param nombreArchivo Nombre del archivo donde se guardarán los datos serializados.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si el archivo se escribió completo, `false` en caso contrario.
+ */
+bool serializarDatosNormalizados(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                 MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    return serializar(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, true);
 }
@@ -1,6 +1,7 @@
 #ifndef SERIALIZAR_DATOS_H
 #define SERIALIZAR_DATOS_H
 
+#include <stdbool.h>
 #include "hash_alimentos.h"
 #include "hash_clientes.h"
 #include "hash_menus.h"
@@ -17,7 +18,26 @@
  * @param tablaClientes Puntero a la tabla hash de clientes.
  * @param tablaMenus Puntero a la tabla hash de menús.
  * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si el archivo se escribió completo, `false` en caso contrario.
  */
-void serializarDatos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+bool serializarDatos(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Serializa los datos en formato YAML normalizado: cada menú guarda solo los IDs de sus alimentos.
+ *
+ * Los menús se escriben con una lista en línea (`alimentos: [1, 2]`), como los menús de
+ * un pedido, en lugar de repetir el nombre, precio y disponibilidad de cada alimento.
+ * El archivo es más pequeño, se guarda sin buscar cada alimento en su tabla y se carga
+ * con `deserializarDatos` igual que el formato completo.
+ *
+ * @param nombreArchivo Nombre del archivo donde se guardarán los datos serializados.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si el archivo se escribió completo, `false` en caso contrario.
+ */
+bool serializarDatosNormalizados(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                 MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
 
 #endif // SERIALIZAR_DATOS_H
@@ -0,0 +1,746 @@
+/**
+ * @file servidor.c
+ * @brief Implementación del servidor de pedidos con epoll.
+ */
+
+#ifdef __linux__
+#define _POSIX_C_SOURCE 200809L // getaddrinfo y sigaction con -std=c99
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <signal.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "servidor.h"
+#include "modo_lote.h"
+#include "bitacora.h"
+#include "guardado_segundo_plano.h"
+#include "cocina.h"
+#include "latencias.h"
+#include "totales_pedidos.h"
+#include "fechas.h"
+#include "mensajes.h"
+
+#ifdef __linux__
+
+/// Bytes que se leen como máximo de una conexión por iteración, para no acaparar el ciclo.
+#define SERVIDOR_LECTURA_POR_ITERACION (256u << 10)
+
+/// Capacidad inicial de los buffers de cada conexión.
+#define SERVIDOR_BUFFER_INICIAL 4096
+
+/// Eventos que se toman de epoll por iteración.
+#define SERVIDOR_EVENTOS 256
+
+/// Espera máxima de epoll, para revisar las señales y los guardados en segundo plano.
+#define SERVIDOR_ESPERA_MS 100
+
+/// Texto de cada resultado en el protocolo, en el orden de ResultadoComando.
+static const char *const estadosProtocolo[] = { "OK", "NO_ENCONTRADO", "ERROR", "INVALIDO" };
+
+/**
+ * @brief Buffer de bytes que crece según se necesita.
+ */
+typedef struct {
+    char *datos;
+    size_t longitud;
+    size_t capacidad;
+} BufferServidor;
+
+/**
+ * @brief Estado de una conexión.
+ */
+typedef struct {
+    int descriptor;
+    BufferServidor entrada;   ///< Bytes recibidos que aún no forman una petición completa o no se atendieron.
+    BufferServidor salida;    ///< Respuestas pendientes de enviar.
+    size_t enviado;           ///< Bytes de `salida` ya enviados.
+    unsigned int eventos;     ///< Eventos registrados en epoll.
+    bool finEntrada;          ///< El cliente cerró su lado de escritura.
+    bool error;               ///< Falló la conexión; se cierra sin enviar lo pendiente.
+    bool enLista;             ///< Está en la lista de conexiones por atender.
+    int posicion;             ///< Posición en `servidor.conexiones`.
+} Conexion;
+
+/**
+ * @brief Estado del servidor en ejecución.
+ */
+static struct {
+    HashTable *alimentos;
+    ClientesHashTable *clientes;
+    MenuHashTable *menus;
+    PedidosHashTable *pedidos;
+    int epoll;
+    Conexion *conexiones[SERVIDOR_MAX_CONEXIONES]; ///< Conexiones abiertas.
+    int numConexiones;
+    bool apagar;
+    ResultadoServidor resultado;
+} servidor;
+
+/// Se pone en 1 al recibir SIGINT o SIGTERM.
+static volatile sig_atomic_t senalDetener = 0;
+
+/**
+ * @brief Manejador de SIGINT y SIGTERM.
+ */
+static void detenerPorSenal(int senal) {
+    (void)senal;
+    senalDetener = 1;
+}
+
+/**
+ * @brief Asegura que quepan `adicional` bytes más en el buffer.
+ */
+static bool reservarBuffer(BufferServidor *buffer, size_t adicional) {
+    if (buffer->longitud + adicional <= buffer->capacidad) return true;
+    size_t capacidad = buffer->capacidad ? buffer->capacidad : SERVIDOR_BUFFER_INICIAL;
+    while (capacidad < buffer->longitud + adicional) capacidad *= 2;
+    char *datos = realloc(buffer->datos, capacidad);
+    if (!datos) return false;
+    buffer->datos = datos;
+    buffer->capacidad = capacidad;
+    return true;
+}
+
+/**
+ * @brief Agrega texto con formato al final del buffer.
+ */
+static bool escribir(BufferServidor *buffer, const char *formato, ...) {
+    for (;;) {
+        size_t libre = buffer->capacidad - buffer->longitud;
+        va_list argumentos;
+        va_start(argumentos, formato);
+        int escritos = vsnprintf(buffer->datos + buffer->longitud, libre, formato, argumentos);
+        va_end(argumentos);
+        if (escritos < 0) return false;
+        if ((size_t)escritos < libre) {
+            buffer->longitud += (size_t)escritos;
+            return true;
+        }
+        if (!reservarBuffer(buffer, (size_t)escritos + 1)) return false;
+    }
+}
+
+/**
+ * @brief Escribe una lista de IDs separados por comas.
+ */
+static void escribirIds(BufferServidor *salida, const int *ids, int numIds) {
+    for (int i = 0; i < numIds; i++) escribir(salida, i ? ",%d" : "%d", ids[i]);
+}
+
+static void escribirAlimento(BufferServidor *salida, const Alimento *alimento) {
+    escribir(salida, "%d\t%s\t%.2f\t%s\n", alimento->id, textoCadena(alimento->nombre), alimento->precio,
+             alimento->disponible ? "Si" : "No");
+}
+
+static void escribirCliente(BufferServidor *salida, const Cliente *cliente) {
+    escribir(salida, "%d\t%s\t%s\n", cliente->idCliente, textoCadena(cliente->nombre), cliente->telefono);
+}
+
+static void escribirMenu(BufferServidor *salida, const Menu *menu) {
+    char textoFecha[FECHA_TEXTO];
+    escribir(salida, "%d\t%s\t", menu->idMenu, formatearFecha(menu->fecha, textoFecha));
+    escribirIds(salida, menu->alimentos, menu->numAlimentos);
+    escribir(salida, "\n");
+}
+
+static void escribirPedido(BufferServidor *salida, const Pedido *pedido) {
+    char textoFecha[FECHA_TEXTO];
+    escribir(salida, "%d\t%d\t%s\t%s\t", pedido->idPedido, pedido->idCliente, formatearFecha(pedido->fecha, textoFecha),
+             pedido->estado);
+    escribirIds(salida, pedido->menus, pedido->numMenus);
+    escribir(salida, "\n");
+}
+
+/**
+ * @brief buscar TABLA ID: responde el registro encontrado.
+ */
+static ResultadoComando peticionBuscar(BufferServidor *salida, char **argumentos, int numArgumentos) {
+    int id;
+    if (numArgumentos != 3 || !leerIdLote(argumentos[2], &id)) return RESULTADO_INVALIDO;
+    switch (leerTablaLote(argumentos[1])) {
+        case TABLA_ALIMENTOS: {
+            Alimento *alimento = buscarAlimento(servidor.alimentos, id);
+            if (!alimento) return RESULTADO_NO_ENCONTRADO;
+            escribir(salida, "OK 1\n");
+            escribirAlimento(salida, alimento);
+            return RESULTADO_OK;
+        }
+        case TABLA_CLIENTES: {
+            Cliente *cliente = buscarCliente(servidor.clientes, id);
+            if (!cliente) return RESULTADO_NO_ENCONTRADO;
+            escribir(salida, "OK 1\n");
+            escribirCliente(salida, cliente);
+            return RESULTADO_OK;
+        }
+        case TABLA_MENUS: {
+            Menu *menu = buscarMenuPorID(servidor.menus, id);
+            if (!menu) return RESULTADO_NO_ENCONTRADO;
+            escribir(salida, "OK 1\n");
+            escribirMenu(salida, menu);
+            return RESULTADO_OK;
+        }
+        case TABLA_PEDIDOS: {
+            Pedido *pedido = buscarPedido(servidor.pedidos, id);
+            if (!pedido) return RESULTADO_NO_ENCONTRADO;
+            escribir(salida, "OK 1\n");
+            escribirPedido(salida, pedido);
+            return RESULTADO_OK;
+        }
+        default:
+            return RESULTADO_INVALIDO;
+    }
+}
+
+/**
+ * @brief listar TABLA: responde todos los registros de la tabla.
+ *
+ * Recorre el arreglo directo y luego los buckets, como la verificación de integridad.
+ */
+static ResultadoComando peticionListar(BufferServidor *salida, char **argumentos, int numArgumentos) {
+    if (numArgumentos != 2) return RESULTADO_INVALIDO;
+    switch (leerTablaLote(argumentos[1])) {
+        case TABLA_ALIMENTOS: {
+            HashTable *tabla = servidor.alimentos;
+            escribir(salida, "OK %d\n", tabla->numAlimentos);
+            for (int i = 0; i < tabla->capacidadDirecta; i++) {
+                if (tabla->directo[i]) escribirAlimento(salida, tabla->directo[i]);
+            }
+            for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+                for (Alimento *alimento = tabla->buckets[i]; alimento; alimento = alimento->next) {
+                    escribirAlimento(salida, alimento);
+                }
+            }
+            return RESULTADO_OK;
+        }
+        case TABLA_CLIENTES: {
+            ClientesHashTable *tabla = servidor.clientes;
+            escribir(salida, "OK %d\n", tabla->numClientes);
+            for (int i = 0; i < tabla->capacidadDirecta; i++) {
+                if (tabla->directo[i]) escribirCliente(salida, tabla->directo[i]);
+            }
+            for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
+                for (Cliente *cliente = tabla->buckets[i]; cliente; cliente = cliente->next) {
+                    escribirCliente(salida, cliente);
+                }
+            }
+            return RESULTADO_OK;
+        }
+        case TABLA_MENUS: {
+            MenuHashTable *tabla = servidor.menus;
+            escribir(salida, "OK %d\n", tabla->numMenus);
+            for (int i = 0; i < tabla->capacidadDirecta; i++) {
+                if (tabla->directo[i]) escribirMenu(salida, tabla->directo[i]);
+            }
+            for (int i = 0; i < MENU_TABLE_SIZE; i++) {
+                for (Menu *menu = tabla->buckets[i]; menu; menu = menu->next) escribirMenu(salida, menu);
+            }
+            return RESULTADO_OK;
+        }
+        case TABLA_PEDIDOS: {
+            PedidosHashTable *tabla = servidor.pedidos;
+            escribir(salida, "OK %d\n", tabla->numPedidos);
+            for (int i = 0; i < tabla->capacidadDirecta; i++) {
+                if (tabla->directo[i]) escribirPedido(salida, tabla->directo[i]);
+            }
+            for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
+                for (Pedido *pedido = tabla->buckets[i]; pedido; pedido = pedido->next) escribirPedido(salida, pedido);
+            }
+            return RESULTADO_OK;
+        }
+        default:
+            return RESULTADO_INVALIDO;
+    }
+}
+
+/**
+ * @brief cocina metricas: responde las métricas de la cocina en una línea.
+ */
+static ResultadoComando peticionMetricasCocina(BufferServidor *salida) {
+    MetricasCocina metricas;
+    leerMetricasCocina(&metricas);
+    escribir(salida, "%s 1\n%d\t%lld\t%lld\t%lld\t%lld\t%d\t%d\t%.1f\t%.1f\t%.1f\n", estadosProtocolo[RESULTADO_OK],
+             metricas.cocineros, metricas.encolados, metricas.rechazados, metricas.completados, metricas.descartados,
+             metricas.profundidad, metricas.profundidadMaxima, metricas.esperaPromedio * 1e6,
+             metricas.esperaMaxima * 1e6, metricas.pedidosPorSegundo);
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief latencias: responde una línea por cada operación que se llamó (ver latencias.h).
+ */
+static ResultadoComando peticionLatencias(BufferServidor *salida) {
+    static HistogramaLatencia histogramas[NUM_OPERACIONES_LATENCIA];
+    combinarLatencias(histogramas);
+    int lineas = 0;
+    for (int i = 0; i < NUM_OPERACIONES_LATENCIA; i++) {
+        if (histogramas[i].llamadas > 0) lineas++;
+    }
+    escribir(salida, "%s %d\n", estadosProtocolo[RESULTADO_OK], lineas);
+    for (int i = 0; i < NUM_OPERACIONES_LATENCIA; i++) {
+        const HistogramaLatencia *h = &histogramas[i];
+        if (h->llamadas == 0) continue;
+        escribir(salida, "%s\t%llu\t%llu\t%llu\t%llu\t%llu\t%llu\t%llu\n", nombresOperacionLatencia[i],
+                 (unsigned long long)h->llamadas, (unsigned long long)percentilLatencia(h, 50),
+                 (unsigned long long)percentilLatencia(h, 90), (unsigned long long)percentilLatencia(h, 99),
+                 (unsigned long long)percentilLatencia(h, 99.9), (unsigned long long)h->maximoNs,
+                 (unsigned long long)(h->sumaNs / h->llamadas));
+    }
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief total ID: responde el total del pedido (ver totales_pedidos.h).
+ */
+static ResultadoComando peticionTotal(BufferServidor *salida, char **argumentos, int numArgumentos) {
+    int id;
+    double total;
+    if (numArgumentos != 2 || !leerIdLote(argumentos[1], &id)) return RESULTADO_INVALIDO;
+    if (!calcularTotalPedido(id, &total)) return RESULTADO_NO_ENCONTRADO;
+    escribir(salida, "%s 1\n%d\t%.2f\n", estadosProtocolo[RESULTADO_OK], id, total);
+    return RESULTADO_OK;
+}
+
+/**
+ * @brief Indica si un comando del modo por lotes se puede pedir por el socket.
+ *
+ * Solo los cambios de registros. Los comandos que reciben una ruta
+ * (guardar, cargar, importar, latencias ARCHIVO, reporte ARCHIVO), los que reemplazan o
+ * reordenan las tablas y los que controlan la cocina o la bitácora quedan para el modo
+ * por lotes y los menús, que corren con los permisos de quien los usa en la máquina.
+ */
+static bool comandoPermitido(ComandoLote comando) {
+    return comando == COMANDO_AGREGAR || comando == COMANDO_ACTUALIZAR || comando == COMANDO_ELIMINAR;
+}
+
+/**
+ * @brief Atiende una petición y escribe su respuesta.
+ * @param conexion Conexión que la envió.
+ * @param linea Petición sin el salto de línea (se modifica).
+ */
+static void atenderPeticion(Conexion *conexion, char *linea) {
+    char *argumentos[LOTE_MAX_ARGUMENTOS];
+    int numArgumentos = separarArgumentosLote(linea, argumentos);
+    if (numArgumentos == 0 || (numArgumentos > 0 && argumentos[0][0] == '#')) return;
+
+    ResultadoComando estado;
+    size_t inicio = conexion->salida.longitud;
+    if (numArgumentos < 0) {
+        estado = RESULTADO_INVALIDO;
+    } else if (strcmp(argumentos[0], "buscar") == 0) {
+        bloquearTablasCocina();
+        estado = peticionBuscar(&conexion->salida, argumentos, numArgumentos);
+        desbloquearTablasCocina();
+    } else if (strcmp(argumentos[0], "listar") == 0) {
+        bloquearTablasCocina();
+        estado = peticionListar(&conexion->salida, argumentos, numArgumentos);
+        desbloquearTablasCocina();
+    } else if (numArgumentos == 2 && strcmp(argumentos[0], "cocina") == 0 && strcmp(argumentos[1], "metricas") == 0) {
+        estado = peticionMetricasCocina(&conexion->salida);
+    } else if (numArgumentos == 1 && strcmp(argumentos[0], "latencias") == 0) {
+        estado = peticionLatencias(&conexion->salida);
+    } else if (strcmp(argumentos[0], "total") == 0 && !(numArgumentos == 2 && strcmp(argumentos[1], "metricas") == 0)) {
+        bloquearTablasCocina();
+        estado = peticionTotal(&conexion->salida, argumentos, numArgumentos);
+        desbloquearTablasCocina();
+    } else if (strcmp(argumentos[0], "apagar") == 0) {
+        estado = numArgumentos == 1 ? RESULTADO_OK : RESULTADO_INVALIDO;
+        if (estado == RESULTADO_OK) servidor.apagar = true;
+    } else {
+        ComandoLote comando = reconocerComandoLote(argumentos[0]);
+        estado = comandoPermitido(comando)
+                     ? ejecutarComandoLote(comando, argumentos, numArgumentos, false)
+                     : RESULTADO_INVALIDO;
+    }
+    // Las peticiones con datos ya escribieron su encabezado
+    if (conexion->salida.longitud == inicio) escribir(&conexion->salida, "%s 0\n", estadosProtocolo[estado]);
+
+    servidor.resultado.peticiones++;
+    if (estado == RESULTADO_ERROR || estado == RESULTADO_INVALIDO) servidor.resultado.errores++;
+}
+
+/**
+ * @brief Bytes de respuestas que faltan por enviar.
+ */
+static size_t salidaPendiente(const Conexion *conexion) {
+    return conexion->salida.longitud - conexion->enviado;
+}
+
+/**
+ * @brief Indica si la entrada tiene al menos una petición completa sin atender.
+ */
+static bool hayPeticionCompleta(const Conexion *conexion) {
+    return conexion->entrada.longitud > 0 && memchr(conexion->entrada.datos, '\n', conexion->entrada.longitud);
+}
+
+/**
+ * @brief Atiende en orden las peticiones completas de la entrada.
+ *
+ * Se detiene si las respuestas pendientes superan SERVIDOR_LIMITE_SALIDA; el resto se
+ * atiende cuando el cliente las consuma.
+ */
+static void atenderPeticiones(Conexion *conexion) {
+    char *datos = conexion->entrada.datos;
+    size_t consumido = 0, longitud = conexion->entrada.longitud;
+    while (consumido < longitud && salidaPendiente(conexion) < SERVIDOR_LIMITE_SALIDA && !servidor.apagar) {
+        char *fin = memchr(datos + consumido, '\n', longitud - consumido);
+        if (!fin) break;
+        *fin = '\0';
+        atenderPeticion(conexion, datos + consumido);
+        consumido = (size_t)(fin - datos) + 1;
+    }
+    if (consumido > 0) {
+        memmove(datos, datos + consumido, longitud - consumido);
+        conexion->entrada.longitud = longitud - consumido;
+    }
+    if (conexion->entrada.longitud > SERVIDOR_MAX_LINEA && !hayPeticionCompleta(conexion)) {
+        escribir(&conexion->salida, "%s 0\n", estadosProtocolo[RESULTADO_INVALIDO]);
+        servidor.resultado.errores++;
+        conexion->entrada.longitud = 0;
+        conexion->finEntrada = true; // Se cierra al enviar la respuesta
+    }
+}
+
+/**
+ * @brief Lee lo disponible en el socket hasta SERVIDOR_LECTURA_POR_ITERACION bytes.
+ */
+static void leerConexion(Conexion *conexion) {
+    size_t leidos = 0;
+    while (leidos < SERVIDOR_LECTURA_POR_ITERACION) {
+        if (!reservarBuffer(&conexion->entrada, 65536)) {
+            conexion->error = true;
+            return;
+        }
+        ssize_t n = read(conexion->descriptor, conexion->entrada.datos + conexion->entrada.longitud,
+                         conexion->entrada.capacidad - conexion->entrada.longitud);
+        if (n > 0) {
+            conexion->entrada.longitud += (size_t)n;
+            leidos += (size_t)n;
+        } else if (n == 0) {
+            conexion->finEntrada = true;
+            return;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) conexion->error = true;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Envía lo que el socket acepte de las respuestas pendientes.
+ */
+static void enviarRespuestas(Conexion *conexion) {
+    while (salidaPendiente(conexion) > 0) {
+        ssize_t n = send(conexion->descriptor, conexion->salida.datos + conexion->enviado, salidaPendiente(conexion),
+                         MSG_NOSIGNAL);
+        if (n >= 0) {
+            conexion->enviado += (size_t)n;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) conexion->error = true;
+            return;
+        }
+    }
+    conexion->salida.longitud = 0;
+    conexion->enviado = 0;
+}
+
+/**
+ * @brief Cambia los eventos que epoll vigila para la conexión, si hace falta.
+ */
+static void vigilarConexion(Conexion *conexion, unsigned int eventos) {
+    if (eventos == conexion->eventos) return;
+    struct epoll_event evento = { .events = eventos, .data.ptr = conexion };
+    if (epoll_ctl(servidor.epoll, EPOLL_CTL_MOD, conexion->descriptor, &evento) != 0) conexion->error = true;
+    conexion->eventos = eventos;
+}
+
+static void cerrarConexion(Conexion *conexion) {
+    epoll_ctl(servidor.epoll, EPOLL_CTL_DEL, conexion->descriptor, NULL);
+    close(conexion->descriptor);
+    free(conexion->entrada.datos);
+    free(conexion->salida.datos);
+    // La última conexión ocupa el lugar de la que se cierra
+    Conexion *ultima = servidor.conexiones[--servidor.numConexiones];
+    servidor.conexiones[conexion->posicion] = ultima;
+    ultima->posicion = conexion->posicion;
+    free(conexion);
+}
+
+/**
+ * @brief Acepta todas las conexiones en espera.
+ */
+static void aceptarConexiones(int escucha, bool tcp) {
+    for (;;) {
+        int descriptor = accept(escucha, NULL, NULL);
+        if (descriptor < 0) {
+            if (errno == EINTR) continue;
+            return; // EAGAIN, o un error de esa conexión en particular
+        }
+        Conexion *conexion = servidor.numConexiones < SERVIDOR_MAX_CONEXIONES ? calloc(1, sizeof(Conexion)) : NULL;
+        if (!conexion || fcntl(descriptor, F_SETFL, O_NONBLOCK) != 0) {
+            free(conexion);
+            close(descriptor);
+            continue;
+        }
+        if (tcp) {
+            int activo = 1;
+            setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &activo, sizeof(activo));
+        }
+        conexion->descriptor = descriptor;
+        conexion->eventos = EPOLLIN;
+        struct epoll_event evento = { .events = EPOLLIN, .data.ptr = conexion };
+        if (!reservarBuffer(&conexion->salida, SERVIDOR_BUFFER_INICIAL) ||
+            epoll_ctl(servidor.epoll, EPOLL_CTL_ADD, descriptor, &evento) != 0) {
+            free(conexion->salida.datos);
+            free(conexion);
+            close(descriptor);
+            continue;
+        }
+        conexion->posicion = servidor.numConexiones;
+        servidor.conexiones[servidor.numConexiones++] = conexion;
+        servidor.resultado.conexiones++;
+    }
+}
+
+/**
+ * @brief Indica si una dirección resuelta es de loopback (127.0.0.0/8 o ::1).
+ */
+static bool esLoopback(const struct sockaddr *dir) {
+    if (dir->sa_family == AF_INET) {
+        const struct sockaddr_in *ipv4 = (const struct sockaddr_in *)dir;
+        return (ntohl(ipv4->sin_addr.s_addr) >> 24) == 127;
+    }
+    if (dir->sa_family == AF_INET6) {
+        const struct in6_addr *ipv6 = &((const struct sockaddr_in6 *)dir)->sin6_addr;
+        if (IN6_IS_ADDR_LOOPBACK(ipv6)) return true;
+        return IN6_IS_ADDR_V4MAPPED(ipv6) && ipv6->s6_addr[12] == 127;
+    }
+    return false;
+}
+
+/**
+ * @brief Abre el socket de escucha para `unix:RUTA` o `tcp:[HOST:]PUERTO`.
+ * @param direccion Dirección a escuchar.
+ * @param permitirRemoto Si es `false`, un host TCP que no sea de loopback se rechaza.
+ * @param tcp `true` si es TCP (de salida).
+ * @return El descriptor, -1 si la dirección no es válida o no se pudo escuchar, o -2 si
+ *         el host no es de loopback y no se permitió escuchar en otras interfaces.
+ */
+static int abrirEscucha(const char *direccion, bool permitirRemoto, bool *tcp) {
+    int escucha = -1;
+    if (strncmp(direccion, "unix:", 5) == 0) {
+        const char *ruta = direccion + 5;
+        struct sockaddr_un dir = { .sun_family = AF_UNIX };
+        if (ruta[0] == '\0' || strlen(ruta) >= sizeof(dir.sun_path)) return -1;
+        strcpy(dir.sun_path, ruta);
+        struct stat info;
+        if (stat(ruta, &info) == 0 && S_ISSOCK(info.st_mode)) unlink(ruta); // Socket de una ejecución anterior
+        escucha = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (escucha < 0) return -1;
+        if (bind(escucha, (struct sockaddr *)&dir, sizeof(dir)) != 0) {
+            close(escucha);
+            return -1;
+        }
+        *tcp = false;
+    } else if (strncmp(direccion, "tcp:", 4) == 0) {
+        char host[256] = "127.0.0.1";
+        const char *puerto = direccion + 4;
+        const char *separador = strrchr(puerto, ':');
+        if (separador) {
+            size_t longitud = (size_t)(separador - puerto);
+            if (longitud == 0 || longitud >= sizeof(host)) return -1;
+            memcpy(host, puerto, longitud);
+            host[longitud] = '\0';
+            puerto = separador + 1;
+        }
+        struct addrinfo pistas = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM, .ai_flags = AI_PASSIVE };
+        struct addrinfo *lista;
+        if (puerto[0] == '\0' || getaddrinfo(host, puerto, &pistas, &lista) != 0) return -1;
+        for (struct addrinfo *opcion = lista; opcion && !permitirRemoto; opcion = opcion->ai_next) {
+            if (!esLoopback(opcion->ai_addr)) {
+                freeaddrinfo(lista);
+                return -2;
+            }
+        }
+        for (struct addrinfo *opcion = lista; opcion && escucha < 0; opcion = opcion->ai_next) {
+            escucha = socket(opcion->ai_family, opcion->ai_socktype, opcion->ai_protocol);
+            if (escucha < 0) continue;
+            int activo = 1;
+            setsockopt(escucha, SOL_SOCKET, SO_REUSEADDR, &activo, sizeof(activo));
+            if (bind(escucha, opcion->ai_addr, opcion->ai_addrlen) != 0) {
+                close(escucha);
+                escucha = -1;
+            }
+        }
+        freeaddrinfo(lista);
+        if (escucha < 0) return -1;
+        *tcp = true;
+    } else {
+        return -1;
+    }
+    if (listen(escucha, 128) != 0 || fcntl(escucha, F_SETFL, O_NONBLOCK) != 0) {
+        close(escucha);
+        return -1;
+    }
+    return escucha;
+}
+
+/**
+ * @brief Atiende peticiones hasta recibir `apagar`, SIGINT o SIGTERM.
+ * @param direccion `unix:RUTA` o `tcp:[HOST:]PUERTO`.
+ * @param permitirRemoto Permite escuchar por TCP en un host que no sea de loopback.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param resultado Conteos de la ejecución (de salida, puede ser NULL).
+ * @return `true` si el servidor terminó normalmente, `false` si no se pudo escuchar en la dirección.
+ */
+bool ejecutarServidor(const char *direccion, bool permitirRemoto, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                      MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, ResultadoServidor *resultado) {
+    bool tcp;
+    int escucha = abrirEscucha(direccion, permitirRemoto, &tcp);
+    if (escucha == -2) {
+        printf("\nError: '%s' no es una dirección de loopback (use --permitir-remoto para escuchar en otras interfaces).\n",
+               direccion);
+        return false;
+    }
+    if (escucha < 0) {
+        printf("\nError: No se pudo escuchar en '%s' (use unix:RUTA o tcp:[HOST:]PUERTO).\n", direccion);
+        return false;
+    }
+    memset(&servidor, 0, sizeof(servidor));
+    servidor.alimentos = tablaAlimentos;
+    servidor.clientes = tablaClientes;
+    servidor.menus = tablaMenus;
+    servidor.pedidos = tablaPedidos;
+    servidor.epoll = epoll_create1(0);
+    struct epoll_event eventoEscucha = { .events = EPOLLIN, .data.ptr = NULL };
+    Conexion **lista = malloc(SERVIDOR_MAX_CONEXIONES * sizeof(Conexion *));
+    if (servidor.epoll < 0 || epoll_ctl(servidor.epoll, EPOLL_CTL_ADD, escucha, &eventoEscucha) != 0 || !lista) {
+        printf("\nError: No se pudo crear el ciclo de eventos del servidor.\n");
+        if (servidor.epoll >= 0) close(servidor.epoll);
+        close(escucha);
+        free(lista);
+        return false;
+    }
+    usarTablasLote(tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos);
+
+    struct sigaction accion, anteriorInt, anteriorTerm;
+    memset(&accion, 0, sizeof(accion));
+    accion.sa_handler = detenerPorSenal;
+    sigemptyset(&accion.sa_mask);
+    senalDetener = 0;
+    sigaction(SIGINT, &accion, &anteriorInt);
+    sigaction(SIGTERM, &accion, &anteriorTerm);
+
+    bool mensajesPrevios = mensajesActivos;
+    mensajesActivos = false;
+    double inicio = omp_get_wtime();
+
+    // `lista` guarda las conexiones con peticiones o respuestas por atender en la iteración actual
+    int numLista = 0;
+    struct epoll_event eventos[SERVIDOR_EVENTOS];
+
+    while (!servidor.apagar && !senalDetener) {
+        // Si quedaron peticiones retenidas por el límite de salida, no se espera
+        int numEventos = epoll_wait(servidor.epoll, eventos, SERVIDOR_EVENTOS, numLista > 0 ? 0 : SERVIDOR_ESPERA_MS);
+        if (numEventos < 0 && errno != EINTR) break;
+        revisarGuardadoSegundoPlano(false, NULL);
+
+        for (int i = 0; i < numEventos; i++) {
+            Conexion *conexion = eventos[i].data.ptr;
+            if (!conexion) {
+                aceptarConexiones(escucha, tcp);
+                continue;
+            }
+            if (eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                if (conexion->eventos & EPOLLIN) leerConexion(conexion);
+                else if (eventos[i].events & EPOLLERR) conexion->error = true;
+            }
+            if (!conexion->enLista) {
+                conexion->enLista = true;
+                lista[numLista++] = conexion;
+            }
+        }
+        if (numLista == 0) continue;
+        servidor.resultado.iteraciones++;
+
+        for (int i = 0; i < numLista; i++) {
+            if (!lista[i]->error) atenderPeticiones(lista[i]);
+        }
+
+        // Una sola espera por todos los cambios de la iteración (group commit)
+        if (!confirmarBitacora()) {
+            printf("\nError: La bitácora no pudo escribir los cambios; el servidor se detiene.\n");
+            servidor.apagar = true;
+        }
+
+        int quedan = 0;
+        for (int i = 0; i < numLista; i++) {
+            Conexion *conexion = lista[i];
+            if (!conexion->error) enviarRespuestas(conexion);
+            bool pendientes = hayPeticionCompleta(conexion);
+            if (conexion->error || (conexion->finEntrada && !pendientes && salidaPendiente(conexion) == 0)) {
+                cerrarConexion(conexion);
+                continue;
+            }
+            bool leer = !conexion->finEntrada && salidaPendiente(conexion) < SERVIDOR_LIMITE_SALIDA;
+            vigilarConexion(conexion, (leer ? EPOLLIN : 0u) | (salidaPendiente(conexion) > 0 ? EPOLLOUT : 0u));
+            if (pendientes && salidaPendiente(conexion) < SERVIDOR_LIMITE_SALIDA) {
+                lista[quedan++] = conexion; // Peticiones retenidas: se atienden en la siguiente iteración
+            } else {
+                conexion->enLista = false;
+            }
+        }
+        numLista = quedan;
+    }
+
+    // Se envía lo que quede (la respuesta a `apagar`, por ejemplo) antes de cerrar
+    detenerCocina(NULL);
+    confirmarBitacora();
+    while (servidor.numConexiones > 0) {
+        Conexion *conexion = servidor.conexiones[servidor.numConexiones - 1];
+        if (!conexion->error) enviarRespuestas(conexion);
+        cerrarConexion(conexion);
+    }
+    servidor.resultado.segundos = omp_get_wtime() - inicio;
+
+    free(lista);
+    revisarGuardadoSegundoPlano(true, NULL);
+    close(servidor.epoll);
+    close(escucha);
+    if (!tcp) unlink(direccion + 5);
+    sigaction(SIGINT, &anteriorInt, NULL);
+    sigaction(SIGTERM, &anteriorTerm, NULL);
+    mensajesActivos = mensajesPrevios;
+    if (resultado) *resultado = servidor.resultado;
+    return true;
+}
+
+#else
+
+bool ejecutarServidor(const char *direccion, bool permitirRemoto, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                      MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, ResultadoServidor *resultado) {
+    (void)direccion; (void)permitirRemoto; (void)tablaAlimentos; (void)tablaClientes; (void)tablaMenus; (void)tablaPedidos; (void)resultado;
+    printf("\nError: El modo servidor solo está disponible en Linux.\n");
+    return false;
+}
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file servidor.h
+ * @brief Servidor local de pedidos sobre un socket Unix o TCP, con un ciclo de eventos epoll.
+ *
+ * Cada petición es una línea con la misma gramática que el modo por lotes (ver
+ * modo_lote.h), pero de sus comandos solo se aceptan los que cambian registros
+ * (`agregar`, `actualizar` y `eliminar`), más los propios del servidor:
+ *
+ *     buscar alimento|cliente|menu|pedido ID     (responde el registro encontrado)
+ *     listar alimentos|clientes|menus|pedidos    (responde todos los registros de la tabla)
+ *     apagar                                     (detiene el servidor al terminar la iteración)
+ *     cocina metricas                            (responde las métricas de la cocina)
+ *     latencias                                  (responde los percentiles de cada operación medida)
+ *     total ID                                   (responde el total del pedido; ver totales_pedidos.h)
+ *
+ * Los demás comandos del modo por lotes (guardar, cargar, importar, generar, ordenar,
+ * confirmar, memoria, reporte, `total metricas`, `cocina iniciar|esperar|detener` y
+ * `latencias ARCHIVO|reiniciar`) responden `INVALIDO`: los que reciben una ruta leerían
+ * o escribirían archivos con los permisos del servidor a pedido de cualquier cliente.
+ *
+ * Cada respuesta empieza con una línea `ESTADO N`, donde ESTADO es `OK`, `NO_ENCONTRADO`,
+ * `ERROR` o `INVALIDO`, seguida de N líneas de datos con los campos del registro
+ * separados por tabuladores:
+ *
+ *     alimento  ID  NOMBRE  PRECIO  Si|No
+ *     cliente   ID  NOMBRE  TELEFONO
+ *     menu      ID  FECHA   ALIMENTOS          (IDs separados por comas)
+ *     pedido    ID  CLIENTE FECHA ESTADO MENUS
+ *     cocina    COCINEROS ENCOLADOS RECHAZADOS COMPLETADOS DESCARTADOS PROFUNDIDAD
+ *               PROFUNDIDAD_MAXIMA ESPERA_PROMEDIO_US ESPERA_MAXIMA_US PEDIDOS_POR_SEGUNDO
+ *     latencia  OPERACION LLAMADAS P50_NS P90_NS P99_NS P999_NS MAXIMO_NS PROMEDIO_NS
+ *     total     ID  TOTAL
+ *
+ * Un cliente puede enviar varias peticiones sin esperar las respuestas (pipelining);
+ * las respuestas llegan en el mismo orden. El servidor atiende las peticiones en un solo
+ * hilo, y cada petición toma el candado de las tablas de la cocina (ver cocina.h). En cada iteración
+ * atiende todas las conexiones listas, espera una sola vez a que la bitácora llegue al
+ * disco (group commit) y solo entonces envía las respuestas, de modo que un `OK` a un
+ * cambio significa que el cambio ya es durable.
+ *
+ * Un servidor de larga vida puede recibir actualizaciones sin fin; los nombres que dejan
+ * de usarse liberan su espacio en la arena de cadenas internadas (ver
+ * cadenas_internadas.h), que así crece con los nombres vivos y no con las peticiones.
+ *
+ * Por TCP solo se escucha en direcciones de loopback (127.0.0.0/8, ::1), salvo que se
+ * pida lo contrario con `permitirRemoto` (opción `--permitir-remoto` del programa).
+ *
+ * Si una conexión acumula más de SERVIDOR_LIMITE_SALIDA bytes sin leer, el servidor deja
+ * de leer sus peticiones hasta que el cliente consuma las respuestas.
+ *
+ * Solo está disponible en Linux.
+ */
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Longitud máxima de una petición; una línea más larga cierra la conexión.
+#define SERVIDOR_MAX_LINEA 4096
+
+/// Bytes de respuestas pendientes a partir de los cuales se deja de leer una conexión.
+#define SERVIDOR_LIMITE_SALIDA (1u << 20)
+
+/// Conexiones simultáneas máximas.
+#define SERVIDOR_MAX_CONEXIONES 1024
+
+/**
+ * @brief Conteos de una ejecución del servidor.
+ */
+typedef struct {
+    long long conexiones;   ///< Conexiones aceptadas.
+    long long peticiones;   ///< Peticiones atendidas.
+    long long errores;      ///< Peticiones con resultado ERROR o INVALIDO.
+    long long iteraciones;  ///< Iteraciones del ciclo de eventos con actividad.
+    double segundos;        ///< Tiempo que estuvo escuchando.
+} ResultadoServidor;
+
+/**
+ * @brief Atiende peticiones hasta recibir `apagar`, SIGINT o SIGTERM.
+ *
+ * Los mensajes de las tablas se silencian mientras el servidor está activo.
+ *
+ * @param direccion `unix:RUTA` o `tcp:[HOST:]PUERTO` (el host por omisión es 127.0.0.1).
+ * @param permitirRemoto Permite escuchar por TCP en un host que no sea de loopback.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param resultado Conteos de la ejecución (de salida, puede ser NULL).
+ * @return `true` si el servidor terminó normalmente, `false` si no se pudo escuchar en la dirección.
+ */
+bool ejecutarServidor(const char *direccion, bool permitirRemoto, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                      MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, ResultadoServidor *resultado);
+
+#endif // SERVIDOR_H
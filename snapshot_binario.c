@@ -0,0 +1,799 @@
+/**
+ * @file snapshot_binario.c
+ * @brief Implementación del snapshot binario: escritura por buffer y carga con `mmap` (ver archivo_memoria.h).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snapshot_binario.h"
+#include "buffer_salida.h"
+#include "archivo_memoria.h"
+#include "rango_denso.h"
+#include "mensajes.h"
+#include "tareas.h"
+
+/// Nodos que construye cada tarea al cargar una sección.
+#define NODOS_POR_TAREA 16384
+
+/// Tamaño de registro esperado para cada sección.
+static const uint32_t TAMANO_REGISTRO[SNAPSHOT_NUM_SECCIONES] = {
+    sizeof(RegistroAlimento), sizeof(RegistroCliente), sizeof(RegistroMenu),
+    sizeof(int32_t), sizeof(RegistroPedido), sizeof(int32_t)
+};
+
+/**
+ * @brief Copia una cadena entre arreglos de tamaño fijo, rellenando con ceros.
+ *
+ * Siempre deja el destino terminado en '\0' aunque el origen no lo esté, y no copia
+ * la basura que pueda haber después del terminador (el archivo queda determinista).
+ *
+ * @param destino Arreglo destino.
+ * @param tamanoDestino Tamaño del arreglo destino.
+ * @param origen Arreglo origen.
+ * @param tamanoOrigen Tamaño del arreglo origen.
+ */
+static void copiarCadena(char *destino, size_t tamanoDestino, const char *origen, size_t tamanoOrigen) {
+    size_t i = 0;
+    while (i + 1 < tamanoDestino && i < tamanoOrigen && origen[i] != '\0') {
+        destino[i] = origen[i];
+        i++;
+    }
+    memset(destino + i, 0, tamanoDestino - i);
+}
+
+/**
+ * @brief Cierra una sección: registra su descriptor y rellena con ceros hasta un múltiplo de 8.
+ *
+ * @param salida Buffer de salida.
+ * @param encabezado Encabezado donde se anota la sección.
+ * @param seccion Sección que se cierra.
+ * @param numRegistros Registros escritos en la sección.
+ * @param posicion Desplazamiento donde empezó la sección; se actualiza al inicio de la siguiente.
+ */
+static void cerrarSeccion(BufferSalida *salida, EncabezadoSnapshot *encabezado, SeccionSnapshot seccion,
+                          uint32_t numRegistros, uint64_t *posicion) {
+    static const char ceros[8] = { 0 };
+    DescriptorSeccion *descriptor = &encabezado->secciones[seccion];
+    descriptor->desplazamiento = *posicion;
+    descriptor->numRegistros = numRegistros;
+    descriptor->tamanoRegistro = TAMANO_REGISTRO[seccion];
+
+    *posicion += (uint64_t)numRegistros * TAMANO_REGISTRO[seccion];
+    size_t relleno = (size_t)((8 - *posicion % 8) % 8);
+    bufferEscribir(salida, ceros, relleno);
+    *posicion += relleno;
+}
+
+/**
+ * @brief Escribe el registro de un alimento.
+ * @param salida Buffer de salida.
+ * @param alimento Alimento a escribir.
+ */
+static void escribirAlimento(BufferSalida *salida, const Alimento *alimento) {
+    RegistroAlimento registro;
+    registro.id = alimento->id;
+    registro.precio = alimento->precio;
+    registro.disponible = alimento->disponible;
+    copiarCadena(registro.nombre, sizeof(registro.nombre), textoCadena(alimento->nombre), sizeof(registro.nombre));
+    bufferEscribir(salida, (const char *)&registro, sizeof(registro));
+}
+
+/**
+ * @brief Escribe la sección de alimentos.
+ * @param salida Buffer de salida.
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @return Número de registros escritos.
+ */
+static uint32_t escribirAlimentos(BufferSalida *salida, HashTable *tabla) {
+    uint32_t escritos = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) {
+            escribirAlimento(salida, tabla->directo[i]);
+            escritos++;
+        }
+    }
+    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+        for (Alimento *actual = tabla->buckets[i]; actual; actual = actual->next) {
+            escribirAlimento(salida, actual);
+            escritos++;
+        }
+    }
+    return escritos;
+}
+
+/**
+ * @brief Escribe el registro de un cliente.
+ * @param salida Buffer de salida.
+ * @param cliente Cliente a escribir.
+ */
+static void escribirCliente(BufferSalida *salida, const Cliente *cliente) {
+    RegistroCliente registro;
+    registro.id = cliente->idCliente;
+    copiarCadena(registro.nombre, sizeof(registro.nombre), textoCadena(cliente->nombre), sizeof(registro.nombre));
+    copiarCadena(registro.telefono, sizeof(registro.telefono), cliente->telefono, sizeof(cliente->telefono));
+    bufferEscribir(salida, (const char *)&registro, sizeof(registro));
+}
+
+/**
+ * @brief Escribe la sección de clientes.
+ * @param salida Buffer de salida.
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @return Número de registros escritos.
+ */
+static uint32_t escribirClientes(BufferSalida *salida, ClientesHashTable *tabla) {
+    uint32_t escritos = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) {
+            escribirCliente(salida, tabla->directo[i]);
+            escritos++;
+        }
+    }
+    for (int i = 0; i < CLIENTES_TABLE_SIZE; i++) {
+        for (Cliente *actual = tabla->buckets[i]; actual; actual = actual->next) {
+            escribirCliente(salida, actual);
+            escritos++;
+        }
+    }
+    return escritos;
+}
+
+/**
+ * @brief Escribe el registro de un menú y avanza la posición de su lista de alimentos.
+ * @param salida Buffer de salida.
+ * @param menu Menú a escribir.
+ * @param siguienteId Posición en SNAPSHOT_MENUS_ALIMENTOS del primer ID del menú; se actualiza.
+ */
+static void escribirMenu(BufferSalida *salida, const Menu *menu, uint64_t *siguienteId) {
+    RegistroMenu registro;
+    registro.id = menu->idMenu;
+    registro.numAlimentos = menu->numAlimentos;
+    registro.primerAlimento = (uint32_t)*siguienteId;
+    registro.fecha = menu->fecha;
+    bufferEscribir(salida, (const char *)&registro, sizeof(registro));
+    *siguienteId += (uint64_t)menu->numAlimentos;
+}
+
+/**
+ * @brief Escribe el registro de un menú o, si `soloIds` es `true`, su lista de IDs.
+ * @param salida Buffer de salida.
+ * @param menu Menú a escribir.
+ * @param soloIds `true` para escribir solo la lista de IDs.
+ * @param siguienteId Posición del primer ID del menú; se actualiza.
+ */
+static void escribirMenuOIds(BufferSalida *salida, const Menu *menu, bool soloIds, uint64_t *siguienteId) {
+    if (soloIds) {
+        bufferEscribir(salida, (const char *)menu->alimentos, menu->numAlimentos * sizeof(int32_t));
+    } else {
+        escribirMenu(salida, menu, siguienteId);
+    }
+}
+
+/**
+ * @brief Escribe la sección de menús (registros) o la de sus alimentos (IDs).
+ * @param salida Buffer de salida.
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param soloIds `false` para escribir los registros, `true` para escribir las listas de IDs.
+ * @param numIds Total de IDs de alimentos (de salida cuando `soloIds` es `false`).
+ * @return Número de registros escritos.
+ */
+static uint32_t escribirMenus(BufferSalida *salida, MenuHashTable *tabla, bool soloIds, uint64_t *numIds) {
+    uint32_t escritos = 0;
+    uint64_t siguienteId = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) {
+            escribirMenuOIds(salida, tabla->directo[i], soloIds, &siguienteId);
+            escritos++;
+        }
+    }
+    for (int i = 0; i < MENU_TABLE_SIZE; i++) {
+        for (Menu *actual = tabla->buckets[i]; actual; actual = actual->next) {
+            escribirMenuOIds(salida, actual, soloIds, &siguienteId);
+            escritos++;
+        }
+    }
+    if (!soloIds) *numIds = siguienteId;
+    return escritos;
+}
+
+/**
+ * @brief Escribe el registro de un pedido y avanza la posición de su lista de menús.
+ * @param salida Buffer de salida.
+ * @param pedido Pedido a escribir.
+ * @param siguienteId Posición en SNAPSHOT_PEDIDOS_MENUS del primer ID del pedido; se actualiza.
+ */
+static void escribirPedido(BufferSalida *salida, const Pedido *pedido, uint64_t *siguienteId) {
+    RegistroPedido registro;
+    registro.id = pedido->idPedido;
+    registro.idCliente = pedido->idCliente;
+    registro.numMenus = pedido->numMenus;
+    registro.primerMenu = (uint32_t)*siguienteId;
+    registro.fecha = pedido->fecha;
+    copiarCadena(registro.estado, sizeof(registro.estado), pedido->estado, sizeof(pedido->estado));
+    bufferEscribir(salida, (const char *)&registro, sizeof(registro));
+    *siguienteId += (uint64_t)pedido->numMenus;
+}
+
+/**
+ * @brief Escribe el registro de un pedido o, si `soloIds` es `true`, su lista de IDs.
+ * @param salida Buffer de salida.
+ * @param pedido Pedido a escribir.
+ * @param soloIds `true` para escribir solo la lista de IDs.
+ * @param siguienteId Posición del primer ID del pedido; se actualiza.
+ */
+static void escribirPedidoOIds(BufferSalida *salida, const Pedido *pedido, bool soloIds, uint64_t *siguienteId) {
+    if (soloIds) {
+        bufferEscribir(salida, (const char *)pedido->menus, pedido->numMenus * sizeof(int32_t));
+    } else {
+        escribirPedido(salida, pedido, siguienteId);
+    }
+}
+
+/**
+ * @brief Escribe la sección de pedidos (registros) o la de sus menús (IDs).
+ * @param salida Buffer de salida.
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @param soloIds `false` para escribir los registros, `true` para escribir las listas de IDs.
+ * @param numIds Total de IDs de menús (de salida cuando `soloIds` es `false`).
+ * @return Número de registros escritos.
+ */
+static uint32_t escribirPedidos(BufferSalida *salida, PedidosHashTable *tabla, bool soloIds, uint64_t *numIds) {
+    uint32_t escritos = 0;
+    uint64_t siguienteId = 0;
+    for (int i = 0; i < tabla->capacidadDirecta; i++) {
+        if (tabla->directo[i]) {
+            escribirPedidoOIds(salida, tabla->directo[i], soloIds, &siguienteId);
+            escritos++;
+        }
+    }
+    for (int i = 0; i < PEDIDOS_TABLE_SIZE; i++) {
+        for (Pedido *actual = tabla->buckets[i]; actual; actual = actual->next) {
+            escribirPedidoOIds(salida, actual, soloIds, &siguienteId);
+            escritos++;
+        }
+    }
+    if (!soloIds) *numIds = siguienteId;
+    return escritos;
+}
+
+/**
+ * @brief Escribe el snapshot completo en un archivo abierto para escritura.
+ *
+ * Las secciones se escriben en una sola pasada por un buffer de 1 MiB; el encabezado
+ * se escribe primero vacío y se reescribe al final, cuando ya se conocen las secciones.
+ *
+ * @param archivo Archivo destino (sin buffer de `stdio`); no se cierra.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param generacion Generación que se anota en el encabezado.
+ * @param tamano Tamaño total escrito (de salida).
+ * @return `true` si se escribió todo, `false` en caso contrario.
+ */
+static bool escribirSnapshot(FILE *archivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                             MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, uint64_t generacion, uint64_t *tamano) {
+    BufferSalida salida;
+    if (!iniciarBufferSalida(&salida, archivo, BUFFER_SALIDA_TAMANO)) {
+        printf("\nError: No hay memoria para el buffer de escritura.\n");
+        return false;
+    }
+
+    EncabezadoSnapshot encabezado;
+    memset(&encabezado, 0, sizeof(encabezado));
+    bufferEscribir(&salida, (const char *)&encabezado, sizeof(encabezado)); // Se reescribe al final
+    uint64_t posicion = sizeof(encabezado);
+    uint64_t numIdsMenus = 0, numIdsPedidos = 0;
+
+    cerrarSeccion(&salida, &encabezado, SNAPSHOT_ALIMENTOS, escribirAlimentos(&salida, tablaAlimentos), &posicion);
+    cerrarSeccion(&salida, &encabezado, SNAPSHOT_CLIENTES, escribirClientes(&salida, tablaClientes), &posicion);
+    cerrarSeccion(&salida, &encabezado, SNAPSHOT_MENUS, escribirMenus(&salida, tablaMenus, false, &numIdsMenus), &posicion);
+    escribirMenus(&salida, tablaMenus, true, NULL);
+    cerrarSeccion(&salida, &encabezado, SNAPSHOT_MENUS_ALIMENTOS, (uint32_t)numIdsMenus, &posicion);
+    cerrarSeccion(&salida, &encabezado, SNAPSHOT_PEDIDOS, escribirPedidos(&salida, tablaPedidos, false, &numIdsPedidos), &posicion);
+    escribirPedidos(&salida, tablaPedidos, true, NULL);
+    cerrarSeccion(&salida, &encabezado, SNAPSHOT_PEDIDOS_MENUS, (uint32_t)numIdsPedidos, &posicion);
+
+    memcpy(encabezado.magia, SNAPSHOT_MAGIA, sizeof(encabezado.magia));
+    encabezado.version = SNAPSHOT_VERSION;
+    encabezado.marcaOrden = SNAPSHOT_MARCA_ORDEN;
+    encabezado.tamanoArchivo = posicion;
+    encabezado.generacion = generacion;
+
+    bool correcto = numIdsMenus <= UINT32_MAX && numIdsPedidos <= UINT32_MAX;
+    if (!liberarBufferSalida(&salida)) correcto = false;
+    if (correcto && (fseek(archivo, 0, SEEK_SET) != 0 || fwrite(&encabezado, sizeof(encabezado), 1, archivo) != 1)) {
+        correcto = false;
+    }
+    *tamano = posicion;
+    return correcto;
+}
+
+/**
+ * @brief Guarda las cuatro tablas en un archivo con el formato binario de snapshot.
+ * @param nombreArchivo Nombre del archivo a escribir.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si el archivo se escribió completo, `false` en caso contrario.
+ */
+bool guardarSnapshotBinario(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                            MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    FILE *archivo = fopen(nombreArchivo, "wb");
+    if (!archivo) {
+        printf("\nError: No se pudo abrir el archivo '%s' para escritura.\n", nombreArchivo);
+        return false;
+    }
+    setvbuf(archivo, NULL, _IONBF, 0);
+    uint64_t tamano = 0;
+    bool correcto = escribirSnapshot(archivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, 0, &tamano);
+    if (fclose(archivo) != 0) correcto = false;
+    if (!correcto) {
+        printf("\nError: No se pudieron escribir todos los datos en '%s'.\n", nombreArchivo);
+        return false;
+    }
+    MENSAJE("\nSnapshot binario guardado en '%s' (%llu bytes).\n", nombreArchivo, (unsigned long long)tamano);
+    return true;
+}
+
+/**
+ * @brief Guarda las cuatro tablas como snapshot de una generación, reemplazando el archivo de forma atómica.
+ * @param nombreArchivo Nombre del archivo a escribir.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param generacion Generación que se anota en el encabezado.
+ * @return `true` si el archivo quedó reemplazado, `false` en caso contrario.
+ */
+bool guardarSnapshotBinarioGeneracion(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                      MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, uint64_t generacion) {
+    char temporal[512];
+    if (snprintf(temporal, sizeof(temporal), "%s.tmp", nombreArchivo) >= (int)sizeof(temporal)) {
+        printf("\nError: El nombre de archivo '%s' es demasiado largo.\n", nombreArchivo);
+        return false;
+    }
+    FILE *archivo = fopen(temporal, "wb");
+    if (!archivo) {
+        printf("\nError: No se pudo abrir el archivo '%s' para escritura.\n", temporal);
+        return false;
+    }
+    setvbuf(archivo, NULL, _IONBF, 0);
+    uint64_t tamano = 0;
+    bool correcto = escribirSnapshot(archivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, generacion, &tamano) &&
+                    sincronizarArchivo(archivo);
+    if (fclose(archivo) != 0) correcto = false;
+    if (!correcto || !reemplazarArchivo(temporal, nombreArchivo)) {
+        printf("\nError: No se pudieron escribir todos los datos en '%s'.\n", nombreArchivo);
+        remove(temporal);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Verifica el encabezado y que todas las secciones estén dentro del archivo.
+ * @param archivo Archivo en memoria.
+ * @return Puntero al encabezado si es válido, o `NULL` en caso contrario.
+ */
+static const EncabezadoSnapshot *validarEncabezado(const ArchivoEnMemoria *archivo) {
+    if (archivo->tamano < sizeof(EncabezadoSnapshot)) return NULL;
+    const EncabezadoSnapshot *encabezado = (const EncabezadoSnapshot *)archivo->datos;
+    if (memcmp(encabezado->magia, SNAPSHOT_MAGIA, sizeof(encabezado->magia)) != 0 ||
+        encabezado->version != SNAPSHOT_VERSION || encabezado->marcaOrden != SNAPSHOT_MARCA_ORDEN ||
+        encabezado->tamanoArchivo != archivo->tamano) {
+        return NULL;
+    }
+    for (int s = 0; s < SNAPSHOT_NUM_SECCIONES; s++) {
+        const DescriptorSeccion *d = &encabezado->secciones[s];
+        if (d->tamanoRegistro != TAMANO_REGISTRO[s] || d->desplazamiento % 8 != 0 ||
+            d->desplazamiento < sizeof(EncabezadoSnapshot) || d->desplazamiento > archivo->tamano ||
+            (uint64_t)d->numRegistros * d->tamanoRegistro > archivo->tamano - d->desplazamiento) {
+            return NULL;
+        }
+    }
+    return encabezado;
+}
+
+/**
+ * @brief Obtiene el inicio de una sección.
+ * @param archivo Archivo en memoria.
+ * @param encabezado Encabezado validado.
+ * @param seccion Sección buscada.
+ * @return Puntero al primer registro de la sección.
+ */
+static const void *inicioSeccion(const ArchivoEnMemoria *archivo, const EncabezadoSnapshot *encabezado, SeccionSnapshot seccion) {
+    return archivo->datos + encabezado->secciones[seccion].desplazamiento;
+}
+
+/**
+ * @brief Copia un registro de alimento a un nodo.
+ * @param nuevo Nodo destino.
+ * @param registro Registro del snapshot.
+ * @return `true` si se internó el nombre, `false` si no hubo memoria.
+ */
+static bool construirAlimento(Alimento *nuevo, const RegistroAlimento *registro) {
+    nuevo->id = registro->id;
+    nuevo->precio = registro->precio;
+    nuevo->disponible = registro->disponible;
+    return internarArreglo(registro->nombre, sizeof(registro->nombre), &nuevo->nombre);
+}
+
+/**
+ * @brief Copia un registro de cliente a un nodo.
+ * @param nuevo Nodo destino.
+ * @param registro Registro del snapshot.
+ * @return `true` si se internó el nombre, `false` si no hubo memoria.
+ */
+static bool construirCliente(Cliente *nuevo, const RegistroCliente *registro) {
+    nuevo->idCliente = registro->id;
+    copiarCadena(nuevo->telefono, sizeof(nuevo->telefono), registro->telefono, sizeof(registro->telefono));
+    return internarArreglo(registro->nombre, sizeof(registro->nombre), &nuevo->nombre);
+}
+
+/**
+ * @brief Copia un registro de menú y su lista de alimentos a un nodo.
+ * @param nuevo Nodo destino.
+ * @param registro Registro del snapshot.
+ * @param ids Sección SNAPSHOT_MENUS_ALIMENTOS.
+ */
+static void construirMenu(Menu *nuevo, const RegistroMenu *registro, const int32_t *ids) {
+    nuevo->idMenu = registro->id;
+    nuevo->numAlimentos = registro->numAlimentos;
+    memcpy(nuevo->alimentos, ids + registro->primerAlimento, registro->numAlimentos * sizeof(int32_t));
+    nuevo->fecha = registro->fecha;
+}
+
+/**
+ * @brief Copia un registro de pedido y su lista de menús a un nodo.
+ * @param nuevo Nodo destino.
+ * @param registro Registro del snapshot.
+ * @param ids Sección SNAPSHOT_PEDIDOS_MENUS.
+ */
+static void construirPedido(Pedido *nuevo, const RegistroPedido *registro, const int32_t *ids) {
+    nuevo->idPedido = registro->id;
+    nuevo->idCliente = registro->idCliente;
+    nuevo->numMenus = registro->numMenus;
+    memcpy(nuevo->menus, ids + registro->primerMenu, registro->numMenus * sizeof(int32_t));
+    nuevo->fecha = registro->fecha;
+    copiarCadena(nuevo->estado, sizeof(nuevo->estado), registro->estado, sizeof(registro->estado));
+}
+
+/**
+ * @brief Sección cuyos nodos se construyen en paralelo dentro del bloque de su tabla.
+ */
+typedef struct {
+    void *bloque;           ///< Bloque de nodos de la tabla.
+    const void *registros;  ///< Registros de la sección.
+    const int32_t *ids;     ///< Listas de IDs (solo menús y pedidos).
+    bool completa;          ///< Se pone en `false` si no hubo memoria para internar un texto.
+} ConstruccionNodos;
+
+static void construirAlimentos(long long inicio, long long fin, void *contexto) {
+    ConstruccionNodos *construccion = (ConstruccionNodos *)contexto;
+    for (long long i = inicio; i < fin; i++) {
+        if (!construirAlimento((Alimento *)construccion->bloque + i,
+                               (const RegistroAlimento *)construccion->registros + i)) {
+            __atomic_store_n(&construccion->completa, false, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void construirClientes(long long inicio, long long fin, void *contexto) {
+    ConstruccionNodos *construccion = (ConstruccionNodos *)contexto;
+    for (long long i = inicio; i < fin; i++) {
+        if (!construirCliente((Cliente *)construccion->bloque + i,
+                              (const RegistroCliente *)construccion->registros + i)) {
+            __atomic_store_n(&construccion->completa, false, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void construirMenus(long long inicio, long long fin, void *contexto) {
+    ConstruccionNodos *construccion = (ConstruccionNodos *)contexto;
+    for (long long i = inicio; i < fin; i++) {
+        construirMenu((Menu *)construccion->bloque + i, (const RegistroMenu *)construccion->registros + i,
+                      construccion->ids);
+    }
+}
+
+static void construirPedidos(long long inicio, long long fin, void *contexto) {
+    ConstruccionNodos *construccion = (ConstruccionNodos *)contexto;
+    for (long long i = inicio; i < fin; i++) {
+        construirPedido((Pedido *)construccion->bloque + i, (const RegistroPedido *)construccion->registros + i,
+                        construccion->ids);
+    }
+}
+
+/**
+ * @brief Crea los nodos de la sección de alimentos y los inserta en su tabla (que debe estar vacía).
+ *
+ * Los nodos se construyen en paralelo dentro del bloque de la tabla (así los fallos
+ * de página se reparten entre los hilos) y después se enlazan en el orden del archivo,
+ * como al cargar el YAML, e INVERTIR_BUCKETS devuelve a cada bucket su orden. Si no se
+ * pudo reservar el bloque, cada nodo se reserva con `malloc`.
+ *
+ * @param tabla Puntero a la tabla hash de alimentos.
+ * @param registros Registros del snapshot.
+ * @param numRegistros Número de registros.
+ * @param duplicados Contador de registros omitidos por ID repetido; se incrementa.
+ * @return `true` si se crearon todos los nodos, `false` si no hubo memoria.
+ */
+static bool restaurarSeccionAlimentos(HashTable *tabla, const RegistroAlimento *registros, uint32_t numRegistros, uint64_t *duplicados) {
+    Alimento *bloque = (Alimento *)reservarBloqueNodos(&tabla->bloqueNodos, numRegistros, sizeof(Alimento));
+    if (bloque) {
+        ConstruccionNodos construccion = { bloque, registros, NULL, true };
+        paraCadaRango(numRegistros, NODOS_POR_TAREA, construirAlimentos, &construccion);
+        if (!construccion.completa) return false;
+    }
+    for (uint32_t i = 0; i < numRegistros; i++) {
+        Alimento *nuevo = bloque ? &bloque[i] : (Alimento *)malloc(sizeof(Alimento));
+        if (!nuevo) {
+            return false;
+        }
+        if (!bloque && !construirAlimento(nuevo, &registros[i])) {
+            free(nuevo);
+            return false;
+        }
+        if (!restaurarAlimento(tabla, nuevo)) {
+            soltarCadena(nuevo->nombre);
+            liberarNodo(&tabla->bloqueNodos, nuevo);
+            (*duplicados)++;
+        }
+    }
+    INVERTIR_BUCKETS(tabla, Alimento, HASH_TABLE_SIZE)
+    return true;
+}
+
+/**
+ * @brief Crea los nodos de la sección de clientes y los inserta en su tabla (que debe estar vacía).
+ *
+ * Los nodos se construyen en paralelo dentro del bloque de la tabla (así los fallos
+ * de página se reparten entre los hilos) y después se enlazan en el orden del archivo,
+ * como al cargar el YAML, e INVERTIR_BUCKETS devuelve a cada bucket su orden. Si no se
+ * pudo reservar el bloque, cada nodo se reserva con `malloc`.
+ *
+ * @param tabla Puntero a la tabla hash de clientes.
+ * @param registros Registros del snapshot.
+ * @param numRegistros Número de registros.
+ * @param duplicados Contador de registros omitidos por ID repetido; se incrementa.
+ * @return `true` si se crearon todos los nodos, `false` si no hubo memoria.
+ */
+static bool restaurarSeccionClientes(ClientesHashTable *tabla, const RegistroCliente *registros, uint32_t numRegistros, uint64_t *duplicados) {
+    Cliente *bloque = (Cliente *)reservarBloqueNodos(&tabla->bloqueNodos, numRegistros, sizeof(Cliente));
+    if (bloque) {
+        ConstruccionNodos construccion = { bloque, registros, NULL, true };
+        paraCadaRango(numRegistros, NODOS_POR_TAREA, construirClientes, &construccion);
+        if (!construccion.completa) return false;
+    }
+    for (uint32_t i = 0; i < numRegistros; i++) {
+        Cliente *nuevo = bloque ? &bloque[i] : (Cliente *)malloc(sizeof(Cliente));
+        if (!nuevo) {
+            return false;
+        }
+        if (!bloque && !construirCliente(nuevo, &registros[i])) {
+            free(nuevo);
+            return false;
+        }
+        if (!restaurarCliente(tabla, nuevo)) {
+            soltarCadena(nuevo->nombre);
+            liberarNodo(&tabla->bloqueNodos, nuevo);
+            (*duplicados)++;
+        }
+    }
+    INVERTIR_BUCKETS(tabla, Cliente, CLIENTES_TABLE_SIZE)
+    return true;
+}
+
+/**
+ * @brief Crea los nodos de la sección de menús y los inserta en su tabla (que debe estar vacía).
+ *
+ * Los nodos se construyen en paralelo dentro del bloque de la tabla (así los fallos
+ * de página se reparten entre los hilos) y después se enlazan en el orden del archivo,
+ * como al cargar el YAML, e INVERTIR_BUCKETS devuelve a cada bucket su orden. Si no se
+ * pudo reservar el bloque, cada nodo se reserva con `malloc`.
+ *
+ * @param tabla Puntero a la tabla hash de menús.
+ * @param registros Registros del snapshot.
+ * @param numRegistros Número de registros.
+ * @param ids Sección SNAPSHOT_MENUS_ALIMENTOS.
+ * @param duplicados Contador de registros omitidos por ID repetido; se incrementa.
+ * @return `true` si se crearon todos los nodos, `false` si no hubo memoria.
+ */
+static bool restaurarSeccionMenus(MenuHashTable *tabla, const RegistroMenu *registros, uint32_t numRegistros, const int32_t *ids, uint64_t *duplicados) {
+    Menu *bloque = (Menu *)reservarBloqueNodos(&tabla->bloqueNodos, numRegistros, sizeof(Menu));
+    if (bloque) {
+        ConstruccionNodos construccion = { bloque, registros, ids, true };
+        paraCadaRango(numRegistros, NODOS_POR_TAREA, construirMenus, &construccion);
+    }
+    for (uint32_t i = 0; i < numRegistros; i++) {
+        Menu *nuevo = bloque ? &bloque[i] : (Menu *)malloc(sizeof(Menu));
+        if (!nuevo) {
+            return false;
+        }
+        if (!bloque) {
+            construirMenu(nuevo, &registros[i], ids);
+        }
+        if (!restaurarMenu(tabla, nuevo)) {
+            liberarNodo(&tabla->bloqueNodos, nuevo);
+            (*duplicados)++;
+        }
+    }
+    INVERTIR_BUCKETS(tabla, Menu, MENU_TABLE_SIZE)
+    return true;
+}
+
+/**
+ * @brief Crea los nodos de la sección de pedidos y los inserta en su tabla (que debe estar vacía).
+ *
+ * Los nodos se construyen en paralelo dentro del bloque de la tabla (así los fallos
+ * de página se reparten entre los hilos) y después se enlazan en el orden del archivo,
+ * como al cargar el YAML, e INVERTIR_BUCKETS devuelve a cada bucket su orden. Si no se
+ * pudo reservar el bloque, cada nodo se reserva con `malloc`.
+ *
+ * @param tabla Puntero a la tabla hash de pedidos.
+ * @param registros Registros del snapshot.
+ * @param numRegistros Número de registros.
+ * @param ids Sección SNAPSHOT_PEDIDOS_MENUS.
+ * @param duplicados Contador de registros omitidos por ID repetido; se incrementa.
+ * @return `true` si se crearon todos los nodos, `false` si no hubo memoria.
+ */
+static bool restaurarSeccionPedidos(PedidosHashTable *tabla, const RegistroPedido *registros, uint32_t numRegistros, const int32_t *ids, uint64_t *duplicados) {
+    Pedido *bloque = (Pedido *)reservarBloqueNodos(&tabla->bloqueNodos, numRegistros, sizeof(Pedido));
+    if (bloque) {
+        ConstruccionNodos construccion = { bloque, registros, ids, true };
+        paraCadaRango(numRegistros, NODOS_POR_TAREA, construirPedidos, &construccion);
+    }
+    for (uint32_t i = 0; i < numRegistros; i++) {
+        Pedido *nuevo = bloque ? &bloque[i] : (Pedido *)malloc(sizeof(Pedido));
+        if (!nuevo) {
+            return false;
+        }
+        if (!bloque) {
+            construirPedido(nuevo, &registros[i], ids);
+        }
+        if (!restaurarPedido(tabla, nuevo)) {
+            liberarNodo(&tabla->bloqueNodos, nuevo);
+            (*duplicados)++;
+        }
+    }
+    INVERTIR_BUCKETS(tabla, Pedido, PEDIDOS_TABLE_SIZE)
+    return true;
+}
+
+/**
+ * @brief Carga un snapshot binario y reemplaza con él el contenido de las cuatro tablas.
+ *
+ * Primero se valida el archivo completo (encabezado, límites de las secciones y de
+ * cada lista de IDs); solo entonces se vacían las tablas y se crean los nodos copiando
+ * cada registro de tamaño fijo, sin convertir texto. Los nodos de cada tabla se toman
+ * de un solo bloque (ver bloque_nodos.h) en lugar de un `malloc` por registro.
+ *
+ * @param nombreArchivo Nombre del archivo a leer.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param generacion Generación anotada en el encabezado (de salida, puede ser `NULL`).
+ * @param informar `true` para imprimir el resumen de lo cargado.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+static bool cargarSnapshot(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                           MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, uint64_t *generacion, bool informar) {
+    ArchivoEnMemoria archivo;
+    if (!abrirArchivoEnMemoria(nombreArchivo, &archivo)) {
+        printf("\nError: No se pudo abrir el archivo '%s'.\n", nombreArchivo);
+        return false;
+    }
+    const EncabezadoSnapshot *encabezado = validarEncabezado(&archivo);
+    if (!encabezado) {
+        printf("\nError: '%s' no es un snapshot binario válido de esta versión.\n", nombreArchivo);
+        cerrarArchivoEnMemoria(&archivo);
+        return false;
+    }
+
+    if (generacion) *generacion = encabezado->generacion;
+    const RegistroAlimento *alimentos = inicioSeccion(&archivo, encabezado, SNAPSHOT_ALIMENTOS);
+    const RegistroCliente *clientes = inicioSeccion(&archivo, encabezado, SNAPSHOT_CLIENTES);
+    const RegistroMenu *menus = inicioSeccion(&archivo, encabezado, SNAPSHOT_MENUS);
+    const int32_t *idsMenus = inicioSeccion(&archivo, encabezado, SNAPSHOT_MENUS_ALIMENTOS);
+    const RegistroPedido *pedidos = inicioSeccion(&archivo, encabezado, SNAPSHOT_PEDIDOS);
+    const int32_t *idsPedidos = inicioSeccion(&archivo, encabezado, SNAPSHOT_PEDIDOS_MENUS);
+    uint32_t numAlimentos = encabezado->secciones[SNAPSHOT_ALIMENTOS].numRegistros;
+    uint32_t numClientes = encabezado->secciones[SNAPSHOT_CLIENTES].numRegistros;
+    uint32_t numMenus = encabezado->secciones[SNAPSHOT_MENUS].numRegistros;
+    uint32_t numPedidos = encabezado->secciones[SNAPSHOT_PEDIDOS].numRegistros;
+    uint64_t numIdsMenus = encabezado->secciones[SNAPSHOT_MENUS_ALIMENTOS].numRegistros;
+    uint64_t numIdsPedidos = encabezado->secciones[SNAPSHOT_PEDIDOS_MENUS].numRegistros;
+
+    // Validar las listas de IDs y obtener el mayor ID de cada tabla antes de modificar nada
+    int32_t maxIds[4] = { -1, -1, -1, -1 };
+    bool valido = true;
+    // Los IDs negativos se rechazan como al leer el YAML: las funciones hash no los admiten
+    for (uint32_t i = 0; valido && i < numAlimentos; i++) {
+        valido = alimentos[i].id >= 0;
+        if (alimentos[i].id > maxIds[0]) maxIds[0] = alimentos[i].id;
+    }
+    for (uint32_t i = 0; valido && i < numClientes; i++) {
+        valido = clientes[i].id >= 0;
+        if (clientes[i].id > maxIds[1]) maxIds[1] = clientes[i].id;
+    }
+    for (uint32_t i = 0; valido && i < numMenus; i++) {
+        const RegistroMenu *m = &menus[i];
+        valido = m->id >= 0 && m->numAlimentos >= 0 && m->numAlimentos <= 50 &&
+                 (uint64_t)m->primerAlimento + m->numAlimentos <= numIdsMenus;
+        if (m->id > maxIds[2]) maxIds[2] = m->id;
+    }
+    for (uint32_t i = 0; valido && i < numPedidos; i++) {
+        const RegistroPedido *p = &pedidos[i];
+        valido = p->id >= 0 && p->idCliente >= 0 && p->numMenus >= 0 && p->numMenus <= 50 &&
+                 (uint64_t)p->primerMenu + p->numMenus <= numIdsPedidos;
+        if (p->id > maxIds[3]) maxIds[3] = p->id;
+    }
+    for (uint64_t i = 0; valido && i < numIdsMenus; i++) valido = idsMenus[i] >= 0;
+    for (uint64_t i = 0; valido && i < numIdsPedidos; i++) valido = idsPedidos[i] >= 0;
+    if (!valido) {
+        printf("\nError: '%s' no es un snapshot binario válido de esta versión.\n", nombreArchivo);
+        cerrarArchivoEnMemoria(&archivo);
+        return false;
+    }
+
+    vaciarTablaAlimentos(tablaAlimentos);
+    vaciarTablaClientes(tablaClientes);
+    vaciarTablaMenus(tablaMenus);
+    vaciarTablaPedidos(tablaPedidos);
+    if (convieneReservarRango(maxIds[0], numAlimentos)) reservarRangoDensoAlimentos(tablaAlimentos, maxIds[0]);
+    if (convieneReservarRango(maxIds[1], numClientes)) reservarRangoDensoClientes(tablaClientes, maxIds[1]);
+    if (convieneReservarRango(maxIds[2], numMenus)) reservarRangoDensoMenus(tablaMenus, maxIds[2]);
+    if (convieneReservarRango(maxIds[3], numPedidos)) reservarRangoDensoPedidos(tablaPedidos, maxIds[3]);
+
+    uint64_t duplicados = 0;
+    bool sinMemoria = !restaurarSeccionAlimentos(tablaAlimentos, alimentos, numAlimentos, &duplicados) ||
+                      !restaurarSeccionClientes(tablaClientes, clientes, numClientes, &duplicados) ||
+                      !restaurarSeccionMenus(tablaMenus, menus, numMenus, idsMenus, &duplicados) ||
+                      !restaurarSeccionPedidos(tablaPedidos, pedidos, numPedidos, idsPedidos, &duplicados);
+    cerrarArchivoEnMemoria(&archivo);
+
+    if (sinMemoria) {
+        printf("\nError: No hay memoria suficiente para cargar '%s'. Los datos quedaron incompletos.\n", nombreArchivo);
+        return false;
+    }
+    if (duplicados > 0) {
+        printf("\nAdvertencia: Se omitieron %llu registros con ID repetido.\n", (unsigned long long)duplicados);
+    }
+    if (informar) {
+        MENSAJE("\nSnapshot cargado desde '%s': %d alimentos, %d clientes, %d menús y %d pedidos.\n", nombreArchivo,
+                tablaAlimentos->numAlimentos, tablaClientes->numClientes, tablaMenus->numMenus, tablaPedidos->numPedidos);
+    }
+    return true;
+}
+
+/**
+ * @brief Carga un snapshot binario y reemplaza con él el contenido de las cuatro tablas.
+ * @param nombreArchivo Nombre del archivo a leer.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool cargarSnapshotBinario(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                           MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    return cargarSnapshot(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, NULL, true);
+}
+
+/**
+ * @brief Carga un snapshot binario sin mensajes de éxito y devuelve su generación.
+ * @param nombreArchivo Nombre del archivo a leer.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param generacion Generación anotada en el encabezado (de salida).
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool cargarSnapshotBinarioGeneracion(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                     MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, uint64_t *generacion) {
+    return cargarSnapshot(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos, generacion, false);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file snapshot_binario.h
+ * @brief Formato binario de snapshot para guardar y restaurar las cuatro tablas sin parsear texto.
+ *
+ * Estructura del archivo (todos los enteros en el orden de bytes de la máquina que lo generó):
+ *
+ *     EncabezadoSnapshot
+ *     sección de alimentos          (RegistroAlimento[])
+ *     sección de clientes           (RegistroCliente[])
+ *     sección de menús              (RegistroMenu[])
+ *     sección de alimentos por menú (int32_t[])
+ *     sección de pedidos            (RegistroPedido[])
+ *     sección de menús por pedido   (int32_t[])
+ *
+ * Cada sección empieza en un desplazamiento múltiplo de 8 indicado en el encabezado.
+ * Los registros son de tamaño fijo y, en lugar de punteros, los menús y pedidos guardan
+ * la posición de su lista de IDs dentro de la sección correspondiente. Así el archivo
+ * puede mapearse a memoria y leerse directamente como arreglos.
+ */
+
+#ifndef SNAPSHOT_BINARIO_H
+#define SNAPSHOT_BINARIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Firma de los primeros 8 bytes del archivo.
+#define SNAPSHOT_MAGIA "EDAIISNP"
+
+/// Versión actual del formato; los archivos con otra versión se rechazan.
+#define SNAPSHOT_VERSION 3
+
+/// Valor escrito en el encabezado para detectar archivos generados con otro orden de bytes.
+#define SNAPSHOT_MARCA_ORDEN 0x01020304u
+
+/**
+ * @brief Secciones del snapshot, en el orden en que aparecen en el archivo.
+ */
+typedef enum {
+    SNAPSHOT_ALIMENTOS,
+    SNAPSHOT_CLIENTES,
+    SNAPSHOT_MENUS,
+    SNAPSHOT_MENUS_ALIMENTOS, ///< IDs de alimentos de todos los menús, uno tras otro.
+    SNAPSHOT_PEDIDOS,
+    SNAPSHOT_PEDIDOS_MENUS,   ///< IDs de menús de todos los pedidos, uno tras otro.
+    SNAPSHOT_NUM_SECCIONES
+} SeccionSnapshot;
+
+/**
+ * @brief Ubicación y tamaño de una sección dentro del archivo.
+ */
+typedef struct {
+    uint64_t desplazamiento;  ///< Posición del primer registro desde el inicio del archivo.
+    uint32_t numRegistros;    ///< Número de registros de la sección.
+    uint32_t tamanoRegistro;  ///< Tamaño en bytes de cada registro.
+} DescriptorSeccion;
+
+/**
+ * @brief Encabezado al inicio del archivo.
+ */
+typedef struct {
+    char magia[8];                                      ///< SNAPSHOT_MAGIA (sin terminador).
+    uint32_t version;                                   ///< SNAPSHOT_VERSION.
+    uint32_t marcaOrden;                                ///< SNAPSHOT_MARCA_ORDEN.
+    uint64_t tamanoArchivo;                             ///< Tamaño total esperado del archivo.
+    uint64_t generacion;                                ///< Generación de la bitácora que ya incluye (ver bitacora.h).
+    DescriptorSeccion secciones[SNAPSHOT_NUM_SECCIONES]; ///< Secciones del archivo.
+} EncabezadoSnapshot;
+
+/**
+ * @brief Registro de tamaño fijo de un alimento.
+ */
+typedef struct {
+    int32_t id;          ///< ID del alimento.
+    float precio;        ///< Precio del alimento.
+    int32_t disponible;  ///< 1 si está disponible, 0 si no.
+    char nombre[52];     ///< Nombre terminado en '\0' (50 caracteres útiles más relleno).
+} RegistroAlimento;
+
+/**
+ * @brief Registro de tamaño fijo de un cliente.
+ */
+typedef struct {
+    int32_t id;          ///< ID del cliente.
+    char nombre[52];     ///< Nombre terminado en '\0'.
+    char telefono[16];   ///< Teléfono terminado en '\0'.
+} RegistroCliente;
+
+/**
+ * @brief Registro de tamaño fijo de un menú.
+ */
+typedef struct {
+    int32_t id;              ///< ID del menú.
+    int32_t numAlimentos;    ///< Número de alimentos del menú.
+    uint32_t primerAlimento; ///< Posición de su primer ID en SNAPSHOT_MENUS_ALIMENTOS.
+    int32_t fecha;           ///< Fecha como número de día (ver fechas.h).
+} RegistroMenu;
+
+/**
+ * @brief Registro de tamaño fijo de un pedido.
+ */
+typedef struct {
+    int32_t id;          ///< ID del pedido.
+    int32_t idCliente;   ///< ID del cliente.
+    int32_t numMenus;    ///< Número de menús del pedido.
+    uint32_t primerMenu; ///< Posición de su primer ID en SNAPSHOT_PEDIDOS_MENUS.
+    int32_t fecha;       ///< Fecha como número de día (ver fechas.h).
+    char estado[16];     ///< Estado terminado en '\0'.
+} RegistroPedido;
+
+/**
+ * @brief Guarda las cuatro tablas en un archivo con el formato binario de snapshot.
+ *
+ * @param nombreArchivo Nombre del archivo a escribir.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si el archivo se escribió completo, `false` en caso contrario.
+ */
+bool guardarSnapshotBinario(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                            MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Carga un snapshot binario y reemplaza con él el contenido de las cuatro tablas.
+ *
+ * El archivo se valida por completo antes de tocar las tablas: si es inválido o está
+ * truncado, los datos actuales se conservan.
+ *
+ * @param nombreArchivo Nombre del archivo a leer.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool cargarSnapshotBinario(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                           MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Guarda las cuatro tablas como snapshot de una generación, reemplazando el archivo de forma atómica.
+ *
+ * El snapshot se escribe en `<nombreArchivo>.tmp`, se sincroniza con el disco y solo
+ * entonces se renombra sobre `nombreArchivo`: si el programa se interrumpe, queda el
+ * snapshot anterior completo. No imprime mensajes de éxito.
+ *
+ * @param nombreArchivo Nombre del archivo a escribir.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param generacion Generación que se anota en el encabezado.
+ * @return `true` si el archivo quedó reemplazado, `false` en caso contrario.
+ */
+bool guardarSnapshotBinarioGeneracion(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                      MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, uint64_t generacion);
+
+/**
+ * @brief Carga un snapshot binario como `cargarSnapshotBinario`, sin mensajes de éxito, y devuelve su generación.
+ *
+ * @param nombreArchivo Nombre del archivo a leer.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @param generacion Generación anotada en el encabezado (de salida).
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool cargarSnapshotBinarioGeneracion(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                                     MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos, uint64_t *generacion);
+
+#endif // SNAPSHOT_BINARIO_H
@@ -0,0 +1,354 @@
+/**
+ * @file snapshot_delta.c
+ * @brief Implementación de los snapshots incrementales (base más deltas).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "snapshot_delta.h"
+#include "snapshot_binario.h"
+#include "codificacion_mutaciones.h"
+#include "archivo_memoria.h"
+#include "mensajes.h"
+
+/// Tamaño del cambio `*_PONER` más pequeño (un cliente), para estimar el tamaño de un delta.
+#define TAMANO_MINIMO_PONER (sizeof(EncabezadoMutacion) + sizeof(RegistroCliente))
+
+/**
+ * @brief Cadena de la última base guardada o cargada en esta ejecución.
+ */
+static struct {
+    char nombre[512];         ///< Nombre del snapshot base ("" si aún no hay cadena).
+    uint64_t generacionBase;  ///< Identificador de la base.
+    uint32_t numDeltas;       ///< Deltas escritos desde la base.
+    uint64_t tamanoBase;      ///< Tamaño de la base en bytes.
+    uint64_t tamanoDeltas;    ///< Suma de los tamaños de los deltas.
+} cadena;
+
+/**
+ * @brief Arma el nombre de un delta.
+ * @param destino Arreglo destino.
+ * @param tamanoDestino Tamaño del arreglo destino.
+ * @param nombreArchivo Nombre del snapshot base.
+ * @param numero Posición del delta en la cadena.
+ * @return `true` si el nombre cupo en el arreglo.
+ */
+static bool nombreDelta(char *destino, size_t tamanoDestino, const char *nombreArchivo, uint32_t numero) {
+    int longitud = snprintf(destino, tamanoDestino, "%s.delta.%u", nombreArchivo, (unsigned)numero);
+    return longitud > 0 && (size_t)longitud < tamanoDestino;
+}
+
+/**
+ * @brief Lee el identificador y el tamaño anotados en el encabezado de una base.
+ * @param nombreArchivo Nombre del snapshot base.
+ * @param generacion Identificador de la base (de salida).
+ * @param tamano Tamaño de la base (de salida).
+ * @return `true` si el archivo existe y tiene un encabezado de snapshot válido.
+ */
+static bool leerEncabezadoBase(const char *nombreArchivo, uint64_t *generacion, uint64_t *tamano) {
+    FILE *archivo = fopen(nombreArchivo, "rb");
+    if (!archivo) return false;
+    EncabezadoSnapshot encabezado;
+    bool correcto = fread(&encabezado, sizeof(encabezado), 1, archivo) == 1 &&
+                    memcmp(encabezado.magia, SNAPSHOT_MAGIA, sizeof(encabezado.magia)) == 0 &&
+                    encabezado.version == SNAPSHOT_VERSION && encabezado.marcaOrden == SNAPSHOT_MARCA_ORDEN;
+    fclose(archivo);
+    if (correcto) {
+        *generacion = encabezado.generacion;
+        *tamano = encabezado.tamanoArchivo;
+    }
+    return correcto;
+}
+
+/**
+ * @brief Genera el identificador de una base nueva, distinto del de la base anterior.
+ * @param anterior Identificador de la base anterior (0 si no hay).
+ * @return Identificador nuevo, nunca 0.
+ */
+static uint64_t nuevaGeneracionBase(uint64_t anterior) {
+    static uint32_t contador = 0;
+    uint64_t generacion = ((uint64_t)time(NULL) << 16) | (contador++ & 0xFFFFu);
+    if (generacion == anterior || generacion == 0) generacion = anterior + 1;
+    return generacion;
+}
+
+/**
+ * @brief Escribe un archivo completo en `.tmp`, lo sincroniza y lo renombra sobre el destino.
+ * @param nombreArchivo Archivo destino.
+ * @param datos Contenido.
+ * @param tamano Bytes del contenido.
+ * @return `true` si el archivo quedó reemplazado.
+ */
+static bool escribirArchivoCompleto(const char *nombreArchivo, const void *datos, size_t tamano) {
+    char temporal[540];
+    if (snprintf(temporal, sizeof(temporal), "%s.tmp", nombreArchivo) >= (int)sizeof(temporal)) return false;
+    FILE *archivo = fopen(temporal, "wb");
+    if (!archivo) return false;
+    bool correcto = fwrite(datos, 1, tamano, archivo) == tamano && sincronizarArchivo(archivo);
+    if (fclose(archivo) != 0) correcto = false;
+    if (!correcto || !reemplazarArchivo(temporal, nombreArchivo)) {
+        remove(temporal);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Borra los deltas de una base, desde el primero hasta el primero que no exista.
+ * @param nombreArchivo Nombre del snapshot base.
+ */
+static void borrarDeltas(const char *nombreArchivo) {
+    char nombre[540];
+    uint32_t numero = 1;
+    while (nombreDelta(nombre, sizeof(nombre), nombreArchivo, numero) && remove(nombre) == 0) {
+        numero++;
+    }
+}
+
+/**
+ * @brief Busca el nodo actual de un registro marcado como sucio.
+ * @param tablas Tablas en uso.
+ * @param poner Tipo de cambio `*_PONER` de la tabla.
+ * @param id ID del registro.
+ * @return Nodo del registro, o `NULL` si ya no existe.
+ */
+static const void *buscarNodo(const TablasMutacion *tablas, TipoMutacion poner, int id) {
+    switch (poner) {
+        case MUTACION_ALIMENTO_PONER: return buscarAlimento(tablas->alimentos, id);
+        case MUTACION_CLIENTE_PONER: return buscarCliente(tablas->clientes, id);
+        case MUTACION_MENU_PONER: return buscarMenuPorID(tablas->menus, id);
+        default: return buscarPedido(tablas->pedidos, id);
+    }
+}
+
+/**
+ * @brief Codifica los cambios pendientes de las cuatro tablas, uno tras otro.
+ * @param tablas Tablas en uso.
+ * @param cambios Cambios pendientes de cada tabla, en el orden alimentos, clientes, menús y pedidos.
+ * @param destino Espacio para TAMANO_MAXIMO_MUTACION bytes por cambio, alineado a 4.
+ * @return Bytes escritos.
+ */
+static size_t codificarCambios(const TablasMutacion *tablas, CambiosPendientes *const cambios[4], unsigned char *destino) {
+    static const TipoMutacion poner[4] = { MUTACION_ALIMENTO_PONER, MUTACION_CLIENTE_PONER,
+                                           MUTACION_MENU_PONER, MUTACION_PEDIDO_PONER };
+    size_t posicion = 0;
+    for (int t = 0; t < 4; t++) {
+        for (int i = 0; i < cambios[t]->capacidad; i++) {
+            const Cambio *cambio = &cambios[t]->ranuras[i];
+            if (cambio->estado == CAMBIO_LIBRE) continue;
+            const void *nodo = cambio->estado == CAMBIO_SUCIO ? buscarNodo(tablas, poner[t], cambio->id) : NULL;
+            // Los *_QUITAR siguen a su *_PONER en TipoMutacion
+            TipoMutacion tipo = nodo ? poner[t] : (TipoMutacion)(poner[t] + 1);
+            posicion += codificarMutacion(tipo, nodo, cambio->id, destino + posicion);
+        }
+    }
+    return posicion;
+}
+
+/**
+ * @brief Escribe una base nueva con el contenido completo de las tablas y descarta los deltas anteriores.
+ * @param nombreArchivo Nombre del snapshot base.
+ * @param tablas Tablas en uso.
+ * @return `true` si la base quedó guardada.
+ */
+static bool guardarBase(const char *nombreArchivo, const TablasMutacion *tablas) {
+    uint64_t generacion = nuevaGeneracionBase(cadena.generacionBase);
+    if (!guardarSnapshotBinarioGeneracion(nombreArchivo, tablas->alimentos, tablas->clientes, tablas->menus,
+                                          tablas->pedidos, generacion)) {
+        cadena.nombre[0] = '\0';
+        return false;
+    }
+    // Los deltas anteriores ya no se aplican (tienen otro identificador); se borran para no ocupar espacio
+    borrarDeltas(nombreArchivo);
+    uint64_t tamano = 0;
+    leerEncabezadoBase(nombreArchivo, &generacion, &tamano);
+    snprintf(cadena.nombre, sizeof(cadena.nombre), "%s", nombreArchivo);
+    cadena.generacionBase = generacion;
+    cadena.numDeltas = 0;
+    cadena.tamanoBase = tamano;
+    cadena.tamanoDeltas = 0;
+    MENSAJE("\nSnapshot base guardado en '%s' (%llu bytes).\n", nombreArchivo, (unsigned long long)tamano);
+    return true;
+}
+
+/**
+ * @brief Guarda las tablas como delta de la última base, o como base nueva si conviene.
+ * @param nombreArchivo Nombre del snapshot base.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si los datos quedaron guardados, `false` en caso contrario.
+ */
+bool guardarSnapshotDelta(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                          MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    prepararCodificacionMutaciones();
+    TablasMutacion tablas = { tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos };
+    CambiosPendientes *const cambios[4] = { &tablaAlimentos->cambios, &tablaClientes->cambios,
+                                            &tablaMenus->cambios, &tablaPedidos->cambios };
+    size_t numCambios = 0;
+    bool base = false;
+    for (int t = 0; t < 4; t++) {
+        numCambios += (size_t)cambios[t]->numCambios;
+        base = base || cambios[t]->requiereBase;
+    }
+
+    // La cadena se continúa solo si la base en disco sigue siendo la que se escribió o cargó
+    uint64_t generacion, tamano;
+    base = base || strcmp(cadena.nombre, nombreArchivo) != 0 ||
+           !leerEncabezadoBase(nombreArchivo, &generacion, &tamano) || generacion != cadena.generacionBase ||
+           cadena.numDeltas >= SNAPSHOT_DELTAS_POR_BASE ||
+           cadena.tamanoDeltas + numCambios * TAMANO_MINIMO_PONER > cadena.tamanoBase / 2;
+
+    unsigned char *delta = NULL;
+    size_t tamanoDelta = 0;
+    if (!base && numCambios == 0) {
+        MENSAJE("\nNo hay cambios desde el último guardado de '%s'.\n", nombreArchivo);
+        return true;
+    }
+    if (!base) {
+        delta = (unsigned char *)malloc(sizeof(EncabezadoDelta) + numCambios * TAMANO_MAXIMO_MUTACION);
+        if (delta) {
+            tamanoDelta = sizeof(EncabezadoDelta) + codificarCambios(&tablas, cambios, delta + sizeof(EncabezadoDelta));
+        }
+        // Sin memoria para el delta, o si la cadena crecería demasiado, se fusiona todo en una base nueva
+        base = !delta || cadena.tamanoDeltas + tamanoDelta > cadena.tamanoBase / 2;
+    }
+
+    bool correcto;
+    if (base) {
+        correcto = guardarBase(nombreArchivo, &tablas);
+    } else {
+        EncabezadoDelta *encabezado = (EncabezadoDelta *)delta;
+        memset(encabezado, 0, sizeof(*encabezado));
+        memcpy(encabezado->magia, SNAPSHOT_DELTA_MAGIA, sizeof(encabezado->magia));
+        encabezado->version = SNAPSHOT_DELTA_VERSION;
+        encabezado->marcaOrden = SNAPSHOT_MARCA_ORDEN;
+        encabezado->generacionBase = cadena.generacionBase;
+        encabezado->tamanoArchivo = tamanoDelta;
+        encabezado->numeroDelta = cadena.numDeltas + 1;
+        encabezado->numCambios = (uint32_t)numCambios;
+
+        char nombre[540];
+        correcto = nombreDelta(nombre, sizeof(nombre), nombreArchivo, encabezado->numeroDelta) &&
+                   escribirArchivoCompleto(nombre, delta, tamanoDelta);
+        if (correcto) {
+            cadena.numDeltas++;
+            cadena.tamanoDeltas += tamanoDelta;
+            MENSAJE("\nSnapshot incremental guardado en '%s' (%llu cambios, %llu bytes).\n", nombre,
+                    (unsigned long long)numCambios, (unsigned long long)tamanoDelta);
+        } else {
+            printf("\nError: No se pudieron escribir todos los datos en '%s'.\n", nombre);
+        }
+    }
+    free(delta);
+
+    if (correcto) {
+        for (int t = 0; t < 4; t++) {
+            limpiarCambios(cambios[t]);
+        }
+    }
+    return correcto;
+}
+
+/**
+ * @brief Verifica el encabezado y todos los cambios de un delta.
+ * @param archivo Delta en memoria.
+ * @param generacionBase Identificador de la base cargada.
+ * @param numero Posición esperada en la cadena.
+ * @return `true` si el delta es válido y pertenece a la cadena.
+ */
+static bool validarDelta(const ArchivoEnMemoria *archivo, uint64_t generacionBase, uint32_t numero) {
+    if (archivo->tamano < sizeof(EncabezadoDelta)) return false;
+    const EncabezadoDelta *encabezado = (const EncabezadoDelta *)archivo->datos;
+    if (memcmp(encabezado->magia, SNAPSHOT_DELTA_MAGIA, sizeof(encabezado->magia)) != 0 ||
+        encabezado->version != SNAPSHOT_DELTA_VERSION || encabezado->marcaOrden != SNAPSHOT_MARCA_ORDEN ||
+        encabezado->generacionBase != generacionBase || encabezado->numeroDelta != numero ||
+        encabezado->tamanoArchivo != archivo->tamano) {
+        return false;
+    }
+    size_t posicion = sizeof(EncabezadoDelta);
+    for (uint32_t i = 0; i < encabezado->numCambios; i++) {
+        size_t longitud = leerMutacion(archivo->datos + posicion, archivo->tamano - posicion);
+        if (longitud == 0) return false;
+        posicion += longitud;
+    }
+    return posicion == archivo->tamano;
+}
+
+/**
+ * @brief Carga un snapshot base y le aplica sus deltas en orden.
+ * @param nombreArchivo Nombre del snapshot base.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool cargarSnapshotDelta(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                         MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    prepararCodificacionMutaciones();
+    uint64_t generacion, tamanoBase;
+    if (!leerEncabezadoBase(nombreArchivo, &generacion, &tamanoBase)) {
+        printf("\nError: '%s' no es un snapshot binario válido de esta versión.\n", nombreArchivo);
+        return false;
+    }
+
+    // Validar toda la cadena antes de reemplazar las tablas. Un snapshot con generación 0
+    // se guardó como snapshot binario normal y no tiene deltas.
+    ArchivoEnMemoria deltas[SNAPSHOT_DELTAS_POR_BASE];
+    uint32_t numDeltas = 0;
+    uint64_t tamanoDeltas = 0;
+    char nombre[540];
+    while (generacion != 0 && numDeltas < SNAPSHOT_DELTAS_POR_BASE &&
+           nombreDelta(nombre, sizeof(nombre), nombreArchivo, numDeltas + 1) && abrirArchivoEnMemoria(nombre, &deltas[numDeltas])) {
+        if (!validarDelta(&deltas[numDeltas], generacion, numDeltas + 1)) {
+            cerrarArchivoEnMemoria(&deltas[numDeltas]);
+            printf("\nAdvertencia: '%s' no pertenece a '%s' o está incompleto; se ignora junto con los deltas siguientes.\n",
+                   nombre, nombreArchivo);
+            break;
+        }
+        tamanoDeltas += deltas[numDeltas].tamano;
+        numDeltas++;
+    }
+
+    TablasMutacion tablas = { tablaAlimentos, tablaClientes, tablaMenus, tablaPedidos };
+    bool baseCargada = cargarSnapshotBinarioGeneracion(nombreArchivo, tablaAlimentos, tablaClientes, tablaMenus,
+                                                       tablaPedidos, &generacion);
+    bool correcto = baseCargada;
+    for (uint32_t d = 0; d < numDeltas; d++) {
+        size_t posicion = sizeof(EncabezadoDelta);
+        while (correcto && posicion < deltas[d].tamano) {
+            correcto = aplicarMutacion(&tablas, deltas[d].datos + posicion);
+            posicion += leerMutacion(deltas[d].datos + posicion, deltas[d].tamano - posicion);
+        }
+        cerrarArchivoEnMemoria(&deltas[d]);
+    }
+    cadena.nombre[0] = '\0';
+    if (!correcto) {
+        if (baseCargada) {
+            printf("\nError: No hay memoria suficiente para aplicar los deltas de '%s'. Los datos quedaron incompletos.\n",
+                   nombreArchivo);
+        }
+        return false;
+    }
+    MENSAJE("\nSnapshot incremental cargado desde '%s' (base y %u deltas): %d alimentos, %d clientes, %d menús y %d pedidos.\n",
+            nombreArchivo, (unsigned)numDeltas, tablaAlimentos->numAlimentos, tablaClientes->numClientes,
+            tablaMenus->numMenus, tablaPedidos->numPedidos);
+    if (generacion == 0) {
+        return true; // El próximo guardado incremental escribe una base nueva
+    }
+
+    snprintf(cadena.nombre, sizeof(cadena.nombre), "%s", nombreArchivo);
+    cadena.generacionBase = generacion;
+    cadena.numDeltas = numDeltas;
+    cadena.tamanoBase = tamanoBase;
+    cadena.tamanoDeltas = tamanoDeltas;
+    limpiarCambios(&tablaAlimentos->cambios);
+    limpiarCambios(&tablaClientes->cambios);
+    limpiarCambios(&tablaMenus->cambios);
+    limpiarCambios(&tablaPedidos->cambios);
+    return true;
+}
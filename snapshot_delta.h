@@ -0,0 +1,95 @@
+/**
+ * @file snapshot_delta.h
+ * @brief Snapshots incrementales: un snapshot base más archivos con solo lo que cambió.
+ *
+ * Archivos usados, todos con el nombre que da el usuario:
+ *
+ *     <nombre>          snapshot base (formato de snapshot_binario.h)
+ *     <nombre>.delta.1  cambios desde la base
+ *     <nombre>.delta.2  cambios desde el delta 1
+ *     ...
+ *
+ * Cada base recibe un identificador nuevo, que se anota en el campo `generacion` de su
+ * encabezado y en cada delta que depende de ella. Un delta con otro identificador o
+ * fuera de secuencia se ignora, así que los deltas de una base anterior no se aplican.
+ *
+ * Al guardar se escriben solo los registros marcados en los CambiosPendientes de cada
+ * tabla. Se escribe una base completa en su lugar (y se borran los deltas) cuando alguna
+ * tabla se reemplazó sin marcar cambios (por ejemplo, al cargar un archivo), cuando la
+ * cadena ya tiene SNAPSHOT_DELTAS_POR_BASE deltas o cuando los deltas ya ocupan más de
+ * la mitad de la base: así la carga nunca aplica más que unos pocos deltas pequeños.
+ *
+ * Formato de un delta (enteros en el orden de bytes de la máquina que lo generó):
+ *
+ *     EncabezadoDelta
+ *     EncabezadoMutacion + contenido   (ver codificacion_mutaciones.h)
+ *     ...
+ */
+
+#ifndef SNAPSHOT_DELTA_H
+#define SNAPSHOT_DELTA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_clientes.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/// Firma de los primeros 8 bytes de un delta.
+#define SNAPSHOT_DELTA_MAGIA "EDAIIDLT"
+
+/// Versión actual del formato; los deltas con otra versión se ignoran.
+#define SNAPSHOT_DELTA_VERSION 2
+
+/// Número de deltas a partir del cual el siguiente guardado escribe una base nueva.
+#define SNAPSHOT_DELTAS_POR_BASE 8
+
+/**
+ * @brief Encabezado al inicio de cada delta.
+ */
+typedef struct {
+    char magia[8];            ///< SNAPSHOT_DELTA_MAGIA (sin terminador).
+    uint32_t version;         ///< SNAPSHOT_DELTA_VERSION.
+    uint32_t marcaOrden;      ///< SNAPSHOT_MARCA_ORDEN.
+    uint64_t generacionBase;  ///< Identificador de la base de la que depende.
+    uint64_t tamanoArchivo;   ///< Tamaño total esperado del archivo.
+    uint32_t numeroDelta;     ///< Posición en la cadena (1 para el primero).
+    uint32_t numCambios;      ///< Número de cambios que siguen al encabezado.
+} EncabezadoDelta;
+
+/**
+ * @brief Guarda las tablas como delta de la última base, o como base nueva si conviene.
+ *
+ * Cada archivo se escribe en `.tmp`, se sincroniza y se renombra: si el programa se
+ * interrumpe, la cadena en disco queda como estaba antes del guardado. Si termina bien,
+ * se limpian los cambios pendientes de las tablas.
+ *
+ * @param nombreArchivo Nombre del snapshot base.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si los datos quedaron guardados, `false` en caso contrario.
+ */
+bool guardarSnapshotDelta(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                          MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Carga un snapshot base y le aplica sus deltas en orden.
+ *
+ * Los deltas se validan antes de tocar las tablas; la cadena se corta en el primero que
+ * falte o no sea válido. Después de cargar, los siguientes guardados incrementales con el
+ * mismo nombre continúan esta cadena.
+ *
+ * @param nombreArchivo Nombre del snapshot base.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaClientes Puntero a la tabla hash de clientes.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ * @return `true` si se cargaron los datos, `false` en caso contrario.
+ */
+bool cargarSnapshotDelta(const char *nombreArchivo, HashTable *tablaAlimentos, ClientesHashTable *tablaClientes,
+                         MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+#endif // SNAPSHOT_DELTA_H
@@ -0,0 +1,366 @@
+/**
+ * @file tareas.c
+ * @brief Implementación del pool de hilos con robo de trabajo.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "tareas.h"
+
+/// La tarea terminó.
+#define TAREA_TERMINADA 1
+
+/// Un hilo duerme esperando la tarea y hay que despertarlo al terminar.
+#define TAREA_CON_ESPERA 2
+
+/**
+ * @brief Cola doble de tareas de un hilo.
+ *
+ * El dueño agrega y toma por el final; los demás roban por el principio. Un candado por
+ * cola basta: el dueño casi nunca compite con un ladrón y las tareas son de miles de
+ * elementos, no de unos cuantos.
+ */
+typedef struct {
+    pthread_mutex_t candado;
+    Tarea *tareas[TAREAS_CAPACIDAD_COLA];
+    unsigned int primera;   ///< Posición de la tarea más antigua.
+    unsigned int cantidad;  ///< Tareas en la cola.
+} ColaTareas;
+
+/**
+ * @brief Estado del pool.
+ *
+ * La cola 0 es de los hilos que no son del pool; la cola i (i > 0) es del hilo i.
+ */
+static struct {
+    bool activo;                  ///< El pool está listo (se lee sin candado).
+    int numHilos;                 ///< Hilos del pool más el que lanza las tareas.
+    ColaTareas *colas;            ///< `numHilos` colas.
+    pthread_t *hilos;             ///< `numHilos - 1` hilos.
+    pthread_mutex_t candado;      ///< Protege el dormir y despertar de los hilos.
+    pthread_cond_t hayTareas;     ///< Se avisa al publicar una tarea si alguien duerme.
+    pthread_cond_t terminoTarea;  ///< Se avisa al terminar una tarea que alguien espera.
+    int encoladas;                ///< Tareas publicadas que nadie ha tomado.
+    int dormidos;                 ///< Hilos dormidos esperando tareas.
+    bool terminar;                ///< Los hilos deben salir al vaciarse las colas.
+} pool = { .candado = PTHREAD_MUTEX_INITIALIZER, .hayTareas = PTHREAD_COND_INITIALIZER,
+           .terminoTarea = PTHREAD_COND_INITIALIZER };
+
+/// Serializa la creación y el cierre del pool.
+static pthread_mutex_t configuracion = PTHREAD_MUTEX_INITIALIZER;
+
+/// Índice de cola de cada hilo del pool (los demás hilos no lo tienen y usan la cola 0).
+static pthread_key_t claveIndice;
+static pthread_once_t claveCreada = PTHREAD_ONCE_INIT;
+
+static void crearClaveIndice(void) {
+    pthread_key_create(&claveIndice, NULL);
+}
+
+/**
+ * @brief Cola del hilo que llama.
+ */
+static int indiceHilo(void) {
+    return (int)(intptr_t)pthread_getspecific(claveIndice);
+}
+
+static bool encolar(ColaTareas *cola, Tarea *tarea) {
+    pthread_mutex_lock(&cola->candado);
+    bool cabe = cola->cantidad < TAREAS_CAPACIDAD_COLA;
+    if (cabe) {
+        cola->tareas[(cola->primera + cola->cantidad) % TAREAS_CAPACIDAD_COLA] = tarea;
+        cola->cantidad++;
+    }
+    pthread_mutex_unlock(&cola->candado);
+    return cabe;
+}
+
+/**
+ * @brief Toma la tarea más reciente (la del dueño) o la más antigua (la de un ladrón).
+ */
+static Tarea *desencolar(ColaTareas *cola, bool robar) {
+    Tarea *tarea = NULL;
+    pthread_mutex_lock(&cola->candado);
+    if (cola->cantidad > 0) {
+        cola->cantidad--;
+        if (robar) {
+            tarea = cola->tareas[cola->primera];
+            cola->primera = (cola->primera + 1) % TAREAS_CAPACIDAD_COLA;
+        } else {
+            tarea = cola->tareas[(cola->primera + cola->cantidad) % TAREAS_CAPACIDAD_COLA];
+        }
+    }
+    pthread_mutex_unlock(&cola->candado);
+    return tarea;
+}
+
+/**
+ * @brief Toma una tarea de la cola propia o, si está vacía, la roba de otra.
+ * @param yo Cola del hilo que llama.
+ * @return La tarea, o NULL si todas las colas están vacías.
+ */
+static Tarea *tomarTarea(int yo) {
+    Tarea *tarea = desencolar(&pool.colas[yo], false);
+    for (int i = 1; !tarea && i < pool.numHilos; i++) {
+        tarea = desencolar(&pool.colas[(yo + i) % pool.numHilos], true);
+    }
+    if (tarea) __atomic_sub_fetch(&pool.encoladas, 1, __ATOMIC_SEQ_CST);
+    return tarea;
+}
+
+/**
+ * @brief Ejecuta una tarea y despierta a quien la espere.
+ */
+static void ejecutarTarea(Tarea *tarea) {
+    tarea->funcion(tarea->argumento);
+    // Después de marcarla terminada la tarea puede dejar de existir (vive en la pila de quien espera)
+    int previo = __atomic_fetch_or(&tarea->estado, TAREA_TERMINADA, __ATOMIC_ACQ_REL);
+    if (previo & TAREA_CON_ESPERA) {
+        pthread_mutex_lock(&pool.candado);
+        pthread_cond_broadcast(&pool.terminoTarea);
+        pthread_mutex_unlock(&pool.candado);
+    }
+}
+
+/**
+ * @brief Ciclo de un hilo del pool: ejecuta tareas y duerme cuando no hay.
+ * @param argumento Índice de la cola del hilo.
+ */
+static void *trabajar(void *argumento) {
+    int yo = (int)(intptr_t)argumento;
+    pthread_setspecific(claveIndice, argumento);
+    for (;;) {
+        Tarea *tarea = tomarTarea(yo);
+        if (tarea) {
+            ejecutarTarea(tarea);
+            continue;
+        }
+        pthread_mutex_lock(&pool.candado);
+        // Se anuncia antes de revisar el contador, así quien publica después siempre lo ve
+        __atomic_add_fetch(&pool.dormidos, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&pool.encoladas, __ATOMIC_SEQ_CST) <= 0 && !pool.terminar) {
+            pthread_cond_wait(&pool.hayTareas, &pool.candado);
+        }
+        __atomic_sub_fetch(&pool.dormidos, 1, __ATOMIC_SEQ_CST);
+        bool salir = pool.terminar && __atomic_load_n(&pool.encoladas, __ATOMIC_SEQ_CST) <= 0;
+        pthread_mutex_unlock(&pool.candado);
+        if (salir) return NULL;
+    }
+}
+
+/**
+ * @brief Crea las colas y los hilos. Se llama con `configuracion` tomado.
+ */
+static bool crearPool(int numHilos) {
+    pthread_once(&claveCreada, crearClaveIndice);
+    if (numHilos <= 0) numHilos = omp_get_max_threads();
+    if (numHilos < 1) numHilos = 1;
+    pool.colas = (ColaTareas *)calloc((size_t)numHilos, sizeof(ColaTareas));
+    pool.hilos = numHilos > 1 ? (pthread_t *)malloc((size_t)(numHilos - 1) * sizeof(pthread_t)) : NULL;
+    pool.encoladas = 0;
+    pool.dormidos = 0;
+    pool.terminar = false;
+    bool correcto = pool.colas && (numHilos == 1 || pool.hilos);
+    int creados = 0;
+    if (correcto) {
+        for (int i = 0; i < numHilos; i++) pthread_mutex_init(&pool.colas[i].candado, NULL);
+        pool.numHilos = numHilos; // Los hilos recorren todas las colas desde que arrancan
+        while (creados < numHilos - 1 &&
+               pthread_create(&pool.hilos[creados], NULL, trabajar, (void *)(intptr_t)(creados + 1)) == 0) {
+            creados++;
+        }
+        correcto = creados == numHilos - 1;
+    }
+    if (!correcto) {
+        printf("\nAdvertencia: Solo se pudieron crear %d de %d hilos de trabajo.\n", creados + 1, numHilos);
+    }
+    // Con menos hilos de los pedidos, el pool trabaja con los que sí se crearon
+    pool.numHilos = pool.colas ? creados + 1 : 1;
+    __atomic_store_n(&pool.activo, true, __ATOMIC_RELEASE);
+    return correcto;
+}
+
+/**
+ * @brief Detiene los hilos y libera las colas. Se llama con `configuracion` tomado.
+ */
+static void destruirPool(void) {
+    if (!pool.activo) return;
+    pthread_mutex_lock(&pool.candado);
+    pool.terminar = true;
+    pthread_cond_broadcast(&pool.hayTareas);
+    pthread_mutex_unlock(&pool.candado);
+    for (int i = 0; i < pool.numHilos - 1; i++) pthread_join(pool.hilos[i], NULL);
+    if (pool.colas) {
+        for (int i = 0; i < pool.numHilos; i++) pthread_mutex_destroy(&pool.colas[i].candado);
+    }
+    free(pool.colas);
+    free(pool.hilos);
+    pool.colas = NULL;
+    pool.hilos = NULL;
+    pool.numHilos = 0;
+    __atomic_store_n(&pool.activo, false, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Crea el pool con los hilos por omisión si aún no existe.
+ */
+static void asegurarPool(void) {
+    if (__atomic_load_n(&pool.activo, __ATOMIC_ACQUIRE)) return;
+    pthread_mutex_lock(&configuracion);
+    if (!pool.activo) crearPool(0);
+    pthread_mutex_unlock(&configuracion);
+}
+
+/**
+ * @brief Crea el pool con el número de hilos indicado, o lo rehace si ya existía con otro.
+ * @param numHilos Hilos del pool, contando al que lanza las tareas (0 para `omp_get_max_threads()`).
+ * @return `true` si el pool quedó listo, `false` si no se pudieron crear los hilos.
+ */
+bool iniciarPoolTareas(int numHilos) {
+    if (numHilos <= 0) numHilos = omp_get_max_threads();
+    pthread_mutex_lock(&configuracion);
+    bool correcto = true;
+    if (!pool.activo || pool.numHilos != numHilos) {
+        destruirPool();
+        correcto = crearPool(numHilos);
+    }
+    pthread_mutex_unlock(&configuracion);
+    return correcto;
+}
+
+/**
+ * @brief Detiene y espera a los hilos del pool.
+ */
+void cerrarPoolTareas(void) {
+    pthread_mutex_lock(&configuracion);
+    destruirPool();
+    pthread_mutex_unlock(&configuracion);
+}
+
+/**
+ * @brief Olvida el pool heredado en un proceso hijo creado con `fork`.
+ *
+ * Los candados pudieron quedar tomados por hilos que no existen en el hijo, así que se
+ * inicializan de nuevo y el pool queda con un solo hilo (sin colas).
+ */
+void abandonarPoolTareasEnHijo(void) {
+    pthread_mutex_init(&configuracion, NULL);
+    pthread_mutex_init(&pool.candado, NULL);
+    pthread_cond_init(&pool.hayTareas, NULL);
+    pthread_cond_init(&pool.terminoTarea, NULL);
+    pool.colas = NULL; // Memoria del padre; el hijo termina sin liberarla
+    pool.hilos = NULL;
+    pool.numHilos = 1;
+    pool.encoladas = 0;
+    pool.dormidos = 0;
+    pool.terminar = false;
+    pool.activo = true;
+}
+
+/**
+ * @brief Hilos con los que trabaja el pool (lo crea si aún no existe).
+ * @return Número de hilos, al menos 1.
+ */
+int hilosPoolTareas(void) {
+    asegurarPool();
+    return pool.numHilos;
+}
+
+/**
+ * @brief Publica una tarea para que la ejecute cualquier hilo del pool.
+ * @param tarea Tarea a lanzar (memoria del llamador).
+ * @param funcion Función a ejecutar.
+ * @param argumento Argumento de la función.
+ */
+void lanzarTarea(Tarea *tarea, FuncionTarea funcion, void *argumento) {
+    tarea->funcion = funcion;
+    tarea->argumento = argumento;
+    tarea->estado = 0;
+    asegurarPool();
+    if (pool.numHilos == 1 || !encolar(&pool.colas[indiceHilo()], tarea)) {
+        ejecutarTarea(tarea); // Sin otros hilos, o con la cola llena
+        return;
+    }
+    __atomic_add_fetch(&pool.encoladas, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool.dormidos, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool.candado);
+        pthread_cond_signal(&pool.hayTareas);
+        pthread_mutex_unlock(&pool.candado);
+    }
+}
+
+/**
+ * @brief Espera a que termine una tarea, ejecutando otras tareas pendientes mientras tanto.
+ *
+ * Si no hay nada más que hacer, la tarea ya la tomó otro hilo (las tareas solo salen de
+ * las colas), así que se duerme hasta que ese hilo avise que terminó.
+ *
+ * @param tarea Tarea lanzada con `lanzarTarea`.
+ */
+void esperarTarea(Tarea *tarea) {
+    int yo = indiceHilo();
+    while (!(__atomic_load_n(&tarea->estado, __ATOMIC_ACQUIRE) & TAREA_TERMINADA)) {
+        Tarea *otra = tomarTarea(yo);
+        if (otra) {
+            ejecutarTarea(otra);
+            continue;
+        }
+        pthread_mutex_lock(&pool.candado);
+        __atomic_fetch_or(&tarea->estado, TAREA_CON_ESPERA, __ATOMIC_ACQ_REL);
+        while (!(__atomic_load_n(&tarea->estado, __ATOMIC_ACQUIRE) & TAREA_TERMINADA)) {
+            pthread_cond_wait(&pool.terminoTarea, &pool.candado);
+        }
+        pthread_mutex_unlock(&pool.candado);
+    }
+}
+
+/**
+ * @brief Subrango pendiente de paraCadaRango.
+ */
+typedef struct {
+    long long inicio;
+    long long fin;
+    long long tamanoBloque;
+    FuncionRango funcion;
+    void *contexto;
+} RangoTareas;
+
+/**
+ * @brief Parte el rango por la mitad (en múltiplos del bloque) hasta que quede un bloque.
+ */
+static void procesarRango(void *argumento) {
+    RangoTareas *rango = (RangoTareas *)argumento;
+    long long bloques = (rango->fin - rango->inicio + rango->tamanoBloque - 1) / rango->tamanoBloque;
+    if (bloques <= 1) {
+        rango->funcion(rango->inicio, rango->fin, rango->contexto);
+        return;
+    }
+    long long mitad = rango->inicio + bloques / 2 * rango->tamanoBloque;
+    RangoTareas derecha = *rango, izquierda = *rango;
+    derecha.inicio = mitad;
+    izquierda.fin = mitad;
+    Tarea tarea;
+    lanzarTarea(&tarea, procesarRango, &derecha);
+    procesarRango(&izquierda);
+    esperarTarea(&tarea);
+}
+
+/**
+ * @brief Procesa `[0, numElementos)` en paralelo, en bloques de `tamanoBloque` elementos.
+ * @param numElementos Número de elementos.
+ * @param tamanoBloque Elementos por bloque (0 para repartir unos 8 bloques por hilo).
+ * @param funcion Función que procesa cada bloque.
+ * @param contexto Argumento de la función.
+ */
+void paraCadaRango(long long numElementos, long long tamanoBloque, FuncionRango funcion, void *contexto) {
+    if (numElementos <= 0) return;
+    if (tamanoBloque <= 0) {
+        tamanoBloque = numElementos / ((long long)hilosPoolTareas() * 8);
+        if (tamanoBloque < 1) tamanoBloque = 1;
+    }
+    RangoTareas rango = { 0, numElementos, tamanoBloque, funcion, contexto };
+    procesarRango(&rango);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file tareas.h
+ * @brief Pool de hilos compartido con robo de trabajo para ordenar, verificar y serializar.
+ *
+ * El pool se crea una sola vez y lo usan todas las operaciones paralelas, en lugar de
+ * que cada llamada abra su propio equipo de hilos. Cada hilo tiene una cola doble de
+ * tareas: agrega y toma las suyas por un extremo (la más reciente primero, que es la
+ * que tiene sus datos en caché) y, cuando se queda sin trabajo, roba la más antigua
+ * de otro hilo, que suele ser la más grande. Un hilo sin trabajo duerme en una variable
+ * de condición hasta que alguien publica una tarea; no gira esperando.
+ *
+ * Una tarea es un futuro: quien la lanza la espera con `esperarTarea`. Mientras espera,
+ * el hilo ejecuta otras tareas pendientes, así que lanzar tareas desde dentro de otra
+ * tarea (por ejemplo, las dos mitades de un quicksort) no agota los hilos ni se bloquea.
+ * Los hilos que no son del pool (el hilo principal, por ejemplo) comparten una cola
+ * propia y también ayudan mientras esperan.
+ *
+ * El número de hilos es el de OpenMP (`OMP_NUM_THREADS` u `omp_get_max_threads`) salvo
+ * que se indique otro con `iniciarPoolTareas`. Con un solo hilo las tareas se ejecutan
+ * en el momento en que se lanzan.
+ */
+
+#ifndef TAREAS_H
+#define TAREAS_H
+
+#include <stdbool.h>
+
+/// Tareas que caben en la cola de cada hilo; si está llena, la tarea se ejecuta en el momento.
+#define TAREAS_CAPACIDAD_COLA 1024
+
+/// Elementos por debajo de los cuales un quicksort ya no se divide en tareas.
+#define TAREAS_UMBRAL_ORDENAMIENTO 4096
+
+/**
+ * @brief Función que ejecuta una tarea.
+ */
+typedef void (*FuncionTarea)(void *argumento);
+
+/**
+ * @brief Función que procesa los elementos `[inicio, fin)` de un rango (ver paraCadaRango).
+ */
+typedef void (*FuncionRango)(long long inicio, long long fin, void *contexto);
+
+/**
+ * @brief Tarea lanzada al pool. La memoria es de quien la lanza (normalmente su pila) y
+ * debe seguir válida hasta que `esperarTarea` regrese.
+ */
+typedef struct {
+    FuncionTarea funcion;
+    void *argumento;
+    int estado;           ///< Banderas internas (terminada, alguien espera); solo las usa el pool.
+} Tarea;
+
+/**
+ * @brief Crea el pool con el número de hilos indicado, o lo rehace si ya existía con otro.
+ *
+ * No debe llamarse mientras haya tareas en curso. Si no se llama, el pool se crea con
+ * `omp_get_max_threads()` hilos la primera vez que se lanza una tarea.
+ *
+ * @param numHilos Hilos del pool, contando al que lanza las tareas (0 para `omp_get_max_threads()`).
+ * @return `true` si el pool quedó listo, `false` si no se pudieron crear los hilos
+ *         (en ese caso las tareas se ejecutan en el hilo que las lanza).
+ */
+bool iniciarPoolTareas(int numHilos);
+
+/**
+ * @brief Detiene y espera a los hilos del pool. Una tarea lanzada después lo vuelve a crear.
+ */
+void cerrarPoolTareas(void);
+
+/**
+ * @brief Olvida el pool heredado en un proceso hijo creado con `fork` (sus hilos no existen ahí).
+ *
+ * Después de llamarla, las tareas del hijo se ejecutan en el hilo que las lanza.
+ */
+void abandonarPoolTareasEnHijo(void);
+
+/**
+ * @brief Hilos con los que trabaja el pool (lo crea si aún no existe).
+ * @return Número de hilos, al menos 1.
+ */
+int hilosPoolTareas(void);
+
+/**
+ * @brief Publica una tarea para que la ejecute cualquier hilo del pool.
+ * @param tarea Tarea a lanzar (memoria del llamador).
+ * @param funcion Función a ejecutar.
+ * @param argumento Argumento de la función.
+ */
+void lanzarTarea(Tarea *tarea, FuncionTarea funcion, void *argumento);
+
+/**
+ * @brief Espera a que termine una tarea, ejecutando otras tareas pendientes mientras tanto.
+ * @param tarea Tarea lanzada con `lanzarTarea`.
+ */
+void esperarTarea(Tarea *tarea);
+
+/**
+ * @brief Procesa `[0, numElementos)` en paralelo, en bloques de `tamanoBloque` elementos.
+ *
+ * El rango se parte por mitades en tareas hasta llegar al tamaño de bloque, de modo que
+ * los hilos que terminan antes roban las mitades grandes que quedan. Regresa cuando se
+ * procesaron todos los bloques.
+ *
+ * @param numElementos Número de elementos.
+ * @param tamanoBloque Elementos por bloque (0 para repartir unos 8 bloques por hilo).
+ * @param funcion Función que procesa cada bloque.
+ * @param contexto Argumento de la función.
+ */
+void paraCadaRango(long long numElementos, long long tamanoBloque, FuncionRango funcion, void *contexto);
+
+#endif // TAREAS_H
@@ -0,0 +1,534 @@
+/**
+ * @file totales_pedidos.c
+ * @brief Implementación de la caché de totales de pedidos y de sus dependencias.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "totales_pedidos.h"
+#include "rango_denso.h"
+#include "contabilidad_memoria.h"
+
+/// Capacidad inicial de cada mapa de totales (potencia de 2).
+#define TOTALES_CAPACIDAD_INICIAL 64
+
+/// Capacidad inicial de la lista de dependientes de una entrada.
+#define DEPENDIENTES_CAPACIDAD_INICIAL 4
+
+/**
+ * @brief Total (menú o pedido) que usó un valor, con la generación que tenía al calcularse.
+ */
+typedef struct {
+    int id;
+    int generacion;
+} Dependiente;
+
+/**
+ * @brief Ranura de un mapa de totales.
+ *
+ * En el mapa de alimentos solo se usan la lista de dependientes (menús); en el de menús,
+ * el total y la lista de dependientes (pedidos); en el de pedidos, solo el total.
+ */
+typedef struct {
+    int id;                      ///< ID del alimento, menú o pedido.
+    bool ocupada;                ///< `false` si la ranura está libre.
+    bool valido;                 ///< `true` si `total` está al día.
+    int generacion;              ///< Sube cada vez que el total se invalida.
+    double total;                ///< Total guardado (válido solo si `valido`).
+    Dependiente *dependientes;   ///< Totales que se calcularon con este valor.
+    int numDependientes;
+    int capacidadDependientes;
+} EntradaTotal;
+
+/**
+ * @brief Mapa de ID a entrada.
+ *
+ * Como las tablas, guarda los IDs densos en un arreglo indexado por ID (ver
+ * rango_denso.h), así los totales de pedidos consecutivos quedan juntos en memoria; los
+ * demás van a un arreglo con direccionamiento abierto y sondeo lineal, como el registro
+ * de cambios. Las entradas no se borran: al invalidarse quedan con `valido` en `false`
+ * para conservar su generación.
+ */
+typedef struct {
+    EntradaTotal *directo;  ///< Entradas de los IDs en [0, capacidadDirecta), o `NULL`.
+    int capacidadDirecta;   ///< Tamaño del arreglo directo.
+    EntradaTotal *ranuras;  ///< Arreglo de `capacidad` ranuras para los demás IDs, o `NULL`.
+    int capacidad;          ///< Número de ranuras (potencia de 2).
+    int numDispersas;       ///< Ranuras ocupadas.
+    int numEntradas;        ///< Entradas en total (directas y dispersas).
+} MapaTotales;
+
+/**
+ * @brief Estado de la caché (ver usarTablasTotales).
+ */
+static struct {
+    HashTable *alimentos;
+    MenuHashTable *menus;
+    PedidosHashTable *pedidos;
+    MapaTotales porAlimento;   ///< Menús que usan cada alimento.
+    MapaTotales porMenu;       ///< Total de cada menú y pedidos que lo usan.
+    MapaTotales porPedido;     ///< Total de cada pedido.
+    MetricasTotales metricas;
+} cache;
+
+/**
+ * @brief Mezcla los bits del ID para repartir los IDs consecutivos en las ranuras.
+ * @param id ID del registro.
+ * @return Valor de dispersión.
+ */
+static unsigned int dispersarId(int id) {
+    unsigned int x = (unsigned int)id;
+    x ^= x >> 16;
+    x *= 0x45D9F3Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Busca la ranura de un ID, o la ranura libre donde iría.
+ * @param ranuras Arreglo de ranuras.
+ * @param capacidad Número de ranuras (potencia de 2).
+ * @param id ID buscado.
+ * @return Ranura del ID o ranura libre.
+ */
+static EntradaTotal *ubicarEntrada(EntradaTotal *ranuras, int capacidad, int id) {
+    unsigned int mascara = (unsigned int)capacidad - 1;
+    unsigned int i = dispersarId(id) & mascara;
+    while (ranuras[i].ocupada && ranuras[i].id != id) {
+        i = (i + 1) & mascara;
+    }
+    return &ranuras[i];
+}
+
+/**
+ * @brief Busca la entrada de un ID.
+ * @param mapa Mapa donde buscar.
+ * @param id ID buscado.
+ * @return La entrada, o `NULL` si el ID no tiene entrada.
+ */
+static EntradaTotal *buscarEntrada(MapaTotales *mapa, int id) {
+    EntradaTotal *entrada;
+    if (id >= 0 && id < mapa->capacidadDirecta) {
+        entrada = &mapa->directo[id];
+    } else if (mapa->numDispersas > 0) {
+        entrada = ubicarEntrada(mapa->ranuras, mapa->capacidad, id);
+    } else {
+        return NULL;
+    }
+    return entrada->ocupada ? entrada : NULL;
+}
+
+/**
+ * @brief Recoloca las entradas dispersas en un arreglo nuevo de ranuras.
+ *
+ * Las que ya caben en el arreglo directo se mueven a él.
+ *
+ * @param mapa Mapa a recolocar.
+ * @param ranuras Arreglo nuevo, en cero.
+ * @param capacidad Número de ranuras del arreglo nuevo (potencia de 2).
+ */
+static void recolocarDispersas(MapaTotales *mapa, EntradaTotal *ranuras, int capacidad) {
+    int numDispersas = 0;
+    for (int i = 0; i < mapa->capacidad; i++) {
+        EntradaTotal *entrada = &mapa->ranuras[i];
+        if (!entrada->ocupada) continue;
+        if (entrada->id >= 0 && entrada->id < mapa->capacidadDirecta) {
+            mapa->directo[entrada->id] = *entrada;
+        } else {
+            *ubicarEntrada(ranuras, capacidad, entrada->id) = *entrada;
+            numDispersas++;
+        }
+    }
+    contarReserva(MEMORIA_TOTALES, (size_t)capacidad * sizeof(EntradaTotal));
+    if (mapa->ranuras) contarLiberacion(MEMORIA_TOTALES, (size_t)mapa->capacidad * sizeof(EntradaTotal));
+    free(mapa->ranuras);
+    mapa->ranuras = ranuras;
+    mapa->capacidad = capacidad;
+    mapa->numDispersas = numDispersas;
+}
+
+/**
+ * @brief Duplica la capacidad de las ranuras dispersas (o las crea).
+ * @param mapa Mapa a ampliar.
+ * @return `true` si se amplió, `false` si no hubo memoria.
+ */
+static bool ampliarMapa(MapaTotales *mapa) {
+    int capacidad = mapa->capacidad ? mapa->capacidad * 2 : TOTALES_CAPACIDAD_INICIAL;
+    EntradaTotal *ranuras = (EntradaTotal *)calloc((size_t)capacidad, sizeof(EntradaTotal));
+    if (!ranuras) {
+        return false;
+    }
+    recolocarDispersas(mapa, ranuras, capacidad);
+    return true;
+}
+
+/**
+ * @brief Amplía el arreglo directo y mueve a él las entradas dispersas que ya caben.
+ * @param mapa Mapa a ampliar.
+ * @param capacidad Nueva capacidad del arreglo directo.
+ * @return `true` si se amplió, `false` si no hubo memoria.
+ */
+static bool ampliarDirecto(MapaTotales *mapa, int capacidad) {
+    EntradaTotal *ranuras = NULL;
+    if (mapa->capacidad > 0 && !(ranuras = (EntradaTotal *)calloc((size_t)mapa->capacidad, sizeof(EntradaTotal)))) {
+        return false;
+    }
+    EntradaTotal *directo = (EntradaTotal *)realloc(mapa->directo, (size_t)capacidad * sizeof(EntradaTotal));
+    if (!directo) {
+        free(ranuras);
+        return false;
+    }
+    memset(directo + mapa->capacidadDirecta, 0, (size_t)(capacidad - mapa->capacidadDirecta) * sizeof(EntradaTotal));
+    contarReserva(MEMORIA_TOTALES, (size_t)(capacidad - mapa->capacidadDirecta) * sizeof(EntradaTotal));
+    mapa->directo = directo;
+    mapa->capacidadDirecta = capacidad;
+    if (ranuras) {
+        recolocarDispersas(mapa, ranuras, mapa->capacidad);
+    }
+    return true;
+}
+
+/**
+ * @brief Busca la entrada de un ID y la crea (sin total válido) si no existe.
+ *
+ * Crear una entrada puede mover las demás entradas del mismo mapa.
+ *
+ * @param mapa Mapa donde buscar.
+ * @param id ID buscado.
+ * @return La entrada, o `NULL` si no hubo memoria para crearla.
+ */
+static EntradaTotal *obtenerEntrada(MapaTotales *mapa, int id) {
+    EntradaTotal *entrada = buscarEntrada(mapa, id);
+    if (entrada) {
+        return entrada;
+    }
+    int capacidad = capacidadDensaPara(id, mapa->capacidadDirecta, mapa->numEntradas);
+    if (capacidad > mapa->capacidadDirecta) {
+        ampliarDirecto(mapa, capacidad); // Si falla, la entrada va a las ranuras dispersas
+    }
+    if (id >= 0 && id < mapa->capacidadDirecta) {
+        entrada = &mapa->directo[id];
+    } else {
+        // Se amplía al llegar a 3/4 de ocupación para que el sondeo siga siendo corto
+        if ((mapa->numDispersas + 1) * 4 > mapa->capacidad * 3 && !ampliarMapa(mapa)) {
+            return NULL;
+        }
+        entrada = ubicarEntrada(mapa->ranuras, mapa->capacidad, id);
+        mapa->numDispersas++;
+    }
+    entrada->id = id;
+    entrada->ocupada = true;
+    mapa->numEntradas++;
+    return entrada;
+}
+
+/**
+ * @brief Libera las listas de dependientes de un arreglo de entradas.
+ * @param entradas Arreglo de entradas (directo o ranuras).
+ * @param num Tamaño del arreglo.
+ */
+static void liberarDependientes(EntradaTotal *entradas, int num) {
+    for (int i = 0; i < num; i++) {
+        if (entradas[i].dependientes) {
+            contarLiberacion(MEMORIA_TOTALES, (size_t)entradas[i].capacidadDependientes * sizeof(Dependiente));
+            free(entradas[i].dependientes);
+        }
+    }
+}
+
+/**
+ * @brief Libera las listas de dependientes, el arreglo directo y las ranuras de un mapa.
+ * @param mapa Mapa a vaciar.
+ */
+static void vaciarMapa(MapaTotales *mapa) {
+    liberarDependientes(mapa->directo, mapa->capacidadDirecta);
+    liberarDependientes(mapa->ranuras, mapa->capacidad);
+    contarLiberacion(MEMORIA_TOTALES, (size_t)(mapa->capacidadDirecta + mapa->capacidad) * sizeof(EntradaTotal));
+    free(mapa->directo);
+    free(mapa->ranuras);
+    memset(mapa, 0, sizeof(*mapa));
+}
+
+/**
+ * @brief Indica si una dependencia aún apunta a un total válido de la misma generación.
+ * @param mapa Mapa de los dependientes (menús o pedidos).
+ * @param dependiente Dependencia anotada.
+ */
+static bool dependienteVigente(MapaTotales *mapa, Dependiente dependiente) {
+    EntradaTotal *entrada = buscarEntrada(mapa, dependiente.id);
+    return entrada && entrada->valido && entrada->generacion == dependiente.generacion;
+}
+
+/**
+ * @brief Duplica la lista de dependientes de una entrada (o la crea).
+ * @param entrada Entrada del alimento o menú.
+ * @return `true` si se amplió, `false` si no hubo memoria.
+ */
+static bool ampliarDependientes(EntradaTotal *entrada) {
+    int capacidad = entrada->capacidadDependientes ? entrada->capacidadDependientes * 2 : DEPENDIENTES_CAPACIDAD_INICIAL;
+    Dependiente *lista = (Dependiente *)realloc(entrada->dependientes, (size_t)capacidad * sizeof(Dependiente));
+    if (!lista) {
+        return false;
+    }
+    contarReserva(MEMORIA_TOTALES, (size_t)(capacidad - entrada->capacidadDependientes) * sizeof(Dependiente));
+    entrada->dependientes = lista;
+    entrada->capacidadDependientes = capacidad;
+    return true;
+}
+
+/**
+ * @brief Anota que el total `id` (de la generación indicada) usó el valor de `entrada`.
+ *
+ * Con la lista llena, primero se descartan las dependencias que ya no están vigentes y
+ * solo se amplía si sigue al menos medio llena.
+ *
+ * @param entrada Entrada del alimento o menú usado.
+ * @param dependientes Mapa de los dependientes (menús o pedidos).
+ * @param id ID del menú o pedido que se está calculando.
+ * @param generacion Generación de ese total.
+ * @return `true` si se anotó, `false` si no hubo memoria.
+ */
+static bool anotarDependiente(EntradaTotal *entrada, MapaTotales *dependientes, int id, int generacion) {
+    int num = entrada->numDependientes;
+    if (num > 0 && entrada->dependientes[num - 1].id == id && entrada->dependientes[num - 1].generacion == generacion) {
+        return true; // El mismo ID repetido en la lista del menú o pedido
+    }
+    if (num == entrada->capacidadDependientes) {
+        int vigentes = 0;
+        for (int i = 0; i < num; i++) {
+            if (dependienteVigente(dependientes, entrada->dependientes[i])) {
+                entrada->dependientes[vigentes++] = entrada->dependientes[i];
+            }
+        }
+        entrada->numDependientes = num = vigentes;
+        if (num * 2 >= entrada->capacidadDependientes && !ampliarDependientes(entrada)) {
+            return false;
+        }
+    }
+    entrada->dependientes[num] = (Dependiente){ id, generacion };
+    entrada->numDependientes = num + 1;
+    return true;
+}
+
+/**
+ * @brief Invalida el total de un pedido.
+ * @param entrada Entrada válida del pedido.
+ */
+static void invalidarEntradaPedido(EntradaTotal *entrada) {
+    entrada->valido = false;
+    entrada->generacion++;
+    cache.metricas.pedidosInvalidados++;
+    cache.metricas.totalesGuardados--;
+}
+
+/**
+ * @brief Invalida el total de un menú y el de los pedidos que lo usaron.
+ * @param entrada Entrada válida del menú.
+ */
+static void invalidarEntradaMenu(EntradaTotal *entrada) {
+    entrada->valido = false;
+    entrada->generacion++;
+    cache.metricas.menusInvalidados++;
+    for (int i = 0; i < entrada->numDependientes; i++) {
+        if (dependienteVigente(&cache.porPedido, entrada->dependientes[i])) {
+            invalidarEntradaPedido(buscarEntrada(&cache.porPedido, entrada->dependientes[i].id));
+        }
+    }
+    entrada->numDependientes = 0;
+}
+
+/**
+ * @brief Devuelve el total de un menú, calculándolo si no está guardado.
+ *
+ * Al calcularlo anota el menú como dependiente de cada uno de sus alimentos.
+ *
+ * @param idMenu ID del menú (si no existe, su total es 0).
+ * @param total Suma de los precios de sus alimentos (de salida).
+ * @return La entrada válida del menú, o `NULL` si no hubo memoria para guardar el total.
+ */
+static EntradaTotal *calcularTotalMenu(int idMenu, double *total) {
+    EntradaTotal *entrada = buscarEntrada(&cache.porMenu, idMenu);
+    if (entrada && entrada->valido) {
+        *total = entrada->total;
+        return entrada;
+    }
+    if (!entrada) {
+        entrada = obtenerEntrada(&cache.porMenu, idMenu);
+    }
+
+    double suma = 0.0;
+    bool guardar = entrada != NULL;
+    Menu *menu = buscarMenuPorID(cache.menus, idMenu);
+    for (int i = 0; menu && i < menu->numAlimentos; i++) {
+        int idAlimento = menu->alimentos[i];
+        Alimento *alimento = buscarAlimento(cache.alimentos, idAlimento);
+        if (alimento) suma += alimento->precio;
+        // Un alimento que falta también se anota: si después se agrega, el total cambia
+        if (guardar) {
+            EntradaTotal *usado = obtenerEntrada(&cache.porAlimento, idAlimento);
+            guardar = usado && anotarDependiente(usado, &cache.porMenu, idMenu, entrada->generacion);
+        }
+    }
+    cache.metricas.menusCalculados++;
+    *total = suma;
+    if (!guardar) {
+        return NULL;
+    }
+    entrada->total = suma;
+    entrada->valido = true;
+    return entrada;
+}
+
+/**
+ * @brief Indica las tablas cuyos totales se guardan y olvida los totales anteriores.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ */
+void usarTablasTotales(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos) {
+    olvidarTotales();
+    cache.alimentos = tablaAlimentos;
+    cache.menus = tablaMenus;
+    cache.pedidos = tablaPedidos;
+}
+
+/**
+ * @brief Devuelve el total de un pedido, calculándolo si no está guardado.
+ * @param idPedido ID del pedido.
+ * @param total Suma de los precios de los alimentos de sus menús (de salida).
+ * @return `true` si el pedido existe, `false` si no.
+ */
+bool calcularTotalPedido(int idPedido, double *total) {
+    // Un total válido implica que el pedido existe: retirarlo lo invalida
+    EntradaTotal *entrada = buscarEntrada(&cache.porPedido, idPedido);
+    if (entrada && entrada->valido) {
+        cache.metricas.consultas++;
+        cache.metricas.aciertos++;
+        *total = entrada->total;
+        return true;
+    }
+    Pedido *pedido = cache.pedidos ? buscarPedido(cache.pedidos, idPedido) : NULL;
+    if (!pedido) {
+        return false;
+    }
+    cache.metricas.consultas++;
+    if (!entrada) {
+        entrada = obtenerEntrada(&cache.porPedido, idPedido);
+    }
+
+    double suma = 0.0;
+    bool guardar = entrada != NULL;
+    for (int i = 0; i < pedido->numMenus; i++) {
+        double totalMenu;
+        EntradaTotal *menu = calcularTotalMenu(pedido->menus[i], &totalMenu);
+        suma += totalMenu;
+        if (guardar) {
+            guardar = menu && anotarDependiente(menu, &cache.porPedido, idPedido, entrada->generacion);
+        }
+    }
+    cache.metricas.pedidosCalculados++;
+    *total = suma;
+    if (guardar) {
+        entrada->total = suma;
+        entrada->valido = true;
+        cache.metricas.totalesGuardados++;
+    }
+    return true;
+}
+
+/**
+ * @brief Avisa que un alimento se agregó, se quitó o cambió de precio.
+ * @param tabla Tabla del alimento.
+ * @param idAlimento ID del alimento.
+ */
+void invalidarTotalesAlimento(HashTable *tabla, int idAlimento) {
+    if (tabla != cache.alimentos) {
+        return;
+    }
+    EntradaTotal *entrada = buscarEntrada(&cache.porAlimento, idAlimento);
+    if (!entrada) {
+        return;
+    }
+    for (int i = 0; i < entrada->numDependientes; i++) {
+        if (dependienteVigente(&cache.porMenu, entrada->dependientes[i])) {
+            invalidarEntradaMenu(buscarEntrada(&cache.porMenu, entrada->dependientes[i].id));
+        }
+    }
+    entrada->numDependientes = 0;
+}
+
+/**
+ * @brief Avisa que un menú se agregó, se quitó o cambió sus alimentos.
+ * @param tabla Tabla del menú.
+ * @param idMenu ID del menú.
+ */
+void invalidarTotalesMenu(MenuHashTable *tabla, int idMenu) {
+    if (tabla != cache.menus) {
+        return;
+    }
+    EntradaTotal *entrada = buscarEntrada(&cache.porMenu, idMenu);
+    if (entrada && entrada->valido) {
+        invalidarEntradaMenu(entrada);
+    }
+}
+
+/**
+ * @brief Avisa que un pedido se quitó o cambió sus menús.
+ * @param tabla Tabla del pedido.
+ * @param idPedido ID del pedido.
+ */
+void invalidarTotalPedido(PedidosHashTable *tabla, int idPedido) {
+    if (tabla != cache.pedidos) {
+        return;
+    }
+    EntradaTotal *entrada = buscarEntrada(&cache.porPedido, idPedido);
+    if (entrada && entrada->valido) {
+        invalidarEntradaPedido(entrada);
+    }
+}
+
+/**
+ * @brief Olvida todos los totales y dependencias y libera su memoria.
+ */
+void olvidarTotales(void) {
+    vaciarMapa(&cache.porAlimento);
+    vaciarMapa(&cache.porMenu);
+    vaciarMapa(&cache.porPedido);
+    cache.metricas.totalesGuardados = 0;
+}
+
+/**
+ * @brief Avisa que una tabla se vació o cambió todo su contenido.
+ * @param tabla Tabla de alimentos, menús o pedidos.
+ */
+void olvidarTotalesTabla(const void *tabla) {
+    if (tabla != cache.alimentos && tabla != cache.menus && tabla != cache.pedidos) {
+        return;
+    }
+    olvidarTotales();
+}
+
+/**
+ * @brief Copia los contadores de la caché.
+ * @param metricas Resultado (de salida).
+ */
+void leerMetricasTotales(MetricasTotales *metricas) {
+    *metricas = cache.metricas;
+}
+
+/**
+ * @brief Imprime los contadores de la caché.
+ */
+void imprimirMetricasTotales(void) {
+    const MetricasTotales *m = &cache.metricas;
+    printf("\n--- Caché de totales de pedidos ---\n");
+    printf("Consultas:            %lld (%lld respondidas con el total guardado", m->consultas, m->aciertos);
+    if (m->consultas > 0) printf(", %.1f %%", 100.0 * m->aciertos / m->consultas);
+    printf(")\n");
+    printf("Pedidos calculados:   %lld\n", m->pedidosCalculados);
+    printf("Menús calculados:     %lld\n", m->menusCalculados);
+    printf("Pedidos invalidados:  %lld\n", m->pedidosInvalidados);
+    printf("Menús invalidados:    %lld\n", m->menusInvalidados);
+    printf("Totales guardados:    %d\n", m->totalesGuardados);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file totales_pedidos.h
+ * @brief Total de cada pedido, calculado al pedirlo y guardado hasta que cambie un precio o un menú.
+ *
+ * El total de un pedido es la suma de los totales de sus menús, y el de un menú es la
+ * suma de los precios de sus alimentos (un menú o alimento que no existe suma 0).
+ * Calcularlo recorre pedido → menús → alimentos con una búsqueda por cada ID; la caché
+ * guarda el total de cada menú y de cada pedido ya calculado, de modo que la siguiente
+ * consulta es una sola búsqueda.
+ *
+ * Cada total guardado anota de qué depende: cada alimento lleva la lista de menús cuyo
+ * total usó su precio, y cada menú la de pedidos cuyo total usó el del menú. Cuando las
+ * tablas cambian, las propias tablas avisan a la caché:
+ *
+ * - enlazar, retirar o cambiar el precio de un alimento invalida los menús que lo usan;
+ * - enlazar, retirar o actualizar un menú invalida su total y los pedidos que lo usan;
+ * - retirar un pedido o reemplazar sus menús invalida su total;
+ * - vaciar una de las tablas seguidas (cargas, generación) olvida toda la caché.
+ *
+ * Así, cambiar el precio de un alimento invalida solo los pedidos que lo incluyen. Cada
+ * total lleva una generación que sube al invalidarlo; las dependencias anotan la
+ * generación que vieron, y las que quedaron viejas se descartan al llenarse la lista.
+ *
+ * Solo se siguen las tablas indicadas con usarTablasTotales; los avisos de otras tablas
+ * (por ejemplo, las temporales de una carga) se ignoran. La caché no tiene candado
+ * propio: se usa con el candado de las tablas tomado, como las tablas mismas.
+ */
+
+#ifndef TOTALES_PEDIDOS_H
+#define TOTALES_PEDIDOS_H
+
+#include <stdbool.h>
+#include "hash_alimentos.h"
+#include "hash_menus.h"
+#include "hash_pedidos.h"
+
+/**
+ * @brief Contadores de la caché desde el inicio del programa.
+ */
+typedef struct {
+    long long consultas;            ///< Llamadas a calcularTotalPedido con un pedido existente.
+    long long aciertos;             ///< Consultas respondidas con el total guardado.
+    long long pedidosCalculados;    ///< Totales de pedidos calculados.
+    long long menusCalculados;      ///< Totales de menús calculados (recorriendo sus alimentos).
+    long long pedidosInvalidados;   ///< Totales de pedidos invalidados por un cambio.
+    long long menusInvalidados;     ///< Totales de menús invalidados por un cambio.
+    int totalesGuardados;           ///< Pedidos con un total válido en este momento.
+} MetricasTotales;
+
+/**
+ * @brief Indica las tablas cuyos totales se guardan y olvida los totales anteriores.
+ * @param tablaAlimentos Puntero a la tabla hash de alimentos.
+ * @param tablaMenus Puntero a la tabla hash de menús.
+ * @param tablaPedidos Puntero a la tabla hash de pedidos.
+ */
+void usarTablasTotales(HashTable *tablaAlimentos, MenuHashTable *tablaMenus, PedidosHashTable *tablaPedidos);
+
+/**
+ * @brief Devuelve el total de un pedido, calculándolo si no está guardado.
+ *
+ * Si no hay memoria para guardar el total, se calcula igual sin guardarlo.
+ *
+ * @param idPedido ID del pedido.
+ * @param total Suma de los precios de los alimentos de sus menús (de salida).
+ * @return `true` si el pedido existe, `false` si no (o si no se llamó a usarTablasTotales).
+ */
+bool calcularTotalPedido(int idPedido, double *total);
+
+/**
+ * @brief Avisa que un alimento se agregó, se quitó o cambió de precio.
+ * @param tabla Tabla del alimento; si no es la de usarTablasTotales, no hace nada.
+ * @param idAlimento ID del alimento.
+ */
+void invalidarTotalesAlimento(HashTable *tabla, int idAlimento);
+
+/**
+ * @brief Avisa que un menú se agregó, se quitó o cambió sus alimentos.
+ * @param tabla Tabla del menú; si no es la de usarTablasTotales, no hace nada.
+ * @param idMenu ID del menú.
+ */
+void invalidarTotalesMenu(MenuHashTable *tabla, int idMenu);
+
+/**
+ * @brief Avisa que un pedido se quitó o cambió sus menús.
+ * @param tabla Tabla del pedido; si no es la de usarTablasTotales, no hace nada.
+ * @param idPedido ID del pedido.
+ */
+void invalidarTotalPedido(PedidosHashTable *tabla, int idPedido);
+
+/**
+ * @brief Olvida todos los totales y dependencias y libera su memoria (las métricas se conservan).
+ */
+void olvidarTotales(void);
+
+/**
+ * @brief Avisa que una tabla se vació o cambió todo su contenido.
+ *
+ * Las tablas propias de otro hilo (por ejemplo, las del compactor de la bitácora) se
+ * vacían sin el candado de las tablas, así que no deben tocar la caché.
+ *
+ * @param tabla Tabla de alimentos, menús o pedidos; si no es una de las de usarTablasTotales,
+ *              no hace nada.
+ */
+void olvidarTotalesTabla(const void *tabla);
+
+/**
+ * @brief Copia los contadores de la caché.
+ * @param metricas Resultado (de salida).
+ */
+void leerMetricasTotales(MetricasTotales *metricas);
+
+/**
+ * @brief Imprime los contadores de la caché.
+ */
+void imprimirMetricasTotales(void);
+
+#endif // TOTALES_PEDIDOS_H